@@ -0,0 +1,40 @@
+{
+  "targets": [
+    {
+      "target_name": "devtrack_core",
+      "sources": [
+        "src/native/bindings/init.cpp",
+        "src/native/bindings/task_bindings.cpp",
+        "src/native/bindings/project_bindings.cpp",
+        "src/native/database/sqlite_connection.cpp",
+        "src/native/database/task_repository.cpp",
+        "src/native/database/project_repository.cpp"
+      ],
+      "include_dirs": ["src/native"],
+      "cflags_cc!": ["-fno-exceptions", "-std=gnu++17"],
+      "cflags_cc": ["-std=c++2b", "-fexceptions"],
+      "conditions": [
+        ["OS=='linux'", {
+          "libraries": ["-lsqlite3"]
+        }],
+        ["OS=='mac'", {
+          "libraries": ["-lsqlite3"],
+          "xcode_settings": {
+            "CLANG_CXX_LANGUAGE_STANDARD": "c++2b",
+            "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+            "MACOSX_DEPLOYMENT_TARGET": "11.0"
+          }
+        }],
+        ["OS=='win'", {
+          "libraries": ["sqlite3.lib"],
+          "msvs_settings": {
+            "VCCLCompilerTool": {
+              "ExceptionHandling": 1,
+              "AdditionalOptions": ["/std:c++latest"]
+            }
+          }
+        }]
+      ]
+    }
+  ]
+}
@@ -17,10 +17,23 @@ import { UserRepository } from './repositories/UserRepository';
 import { NotificationRepository } from './repositories/NotificationRepository';
 import { TimeEntryRepository } from './repositories/TimeEntryRepository';
 import { AutomationRuleRepository } from './repositories/AutomationRuleRepository';
+import { DependencyGraphIndex } from './services/DependencyGraphIndex';
+import { SearchService } from './services/SearchService';
+import { SearchEntityType } from './models/Search';
+import { IntegrationManager } from './services/IntegrationManager';
+import { SecurityManager } from './services/SecurityManager';
+import { APIKeyScope, apiKeyHasScope } from './models/Security';
+import { PermissionCache } from './services/PermissionCache';
+import { MetricsRegistry } from './services/MetricsRegistry';
+import { openExportConnection } from './utils/streamingExport';
 import { Request, Response, NextFunction } from 'express';
+import { performance } from 'perf_hooks';
 
 const JWT_SECRET = process.env.JWT_SECRET || 'devtrack-secret-key-change-in-production';
 const API_PORT = process.env.API_PORT || 3000;
+const API_KEY_PREFIX = 'devtrack_'; // see SecurityManager.generateAPIKey
+// Audit logs stay in-app (search:query IPC); they were never exposed over REST
+const REST_SEARCH_TYPES: SearchEntityType[] = ['task', 'comment'];
 
 export class ApiServer {
   private app: express.Application;
@@ -35,10 +48,30 @@ export class ApiServer {
   private notificationRepo: NotificationRepository;
   private timeEntryRepo: TimeEntryRepository;
   private automationRuleRepo: AutomationRuleRepository;
+  private dependencyGraph?: DependencyGraphIndex;
+  private searchService: SearchService;
+  private integrationManager?: IntegrationManager;
+  private securityManager?: SecurityManager;
+  private permissionCache: PermissionCache;
+  private metrics: MetricsRegistry;
 
-  constructor(db: Database.Database) {
+  constructor(
+    db: Database.Database,
+    dependencyGraph?: DependencyGraphIndex,
+    searchService?: SearchService,
+    integrationManager?: IntegrationManager,
+    securityManager?: SecurityManager,
+    permissionCache?: PermissionCache,
+    metrics?: MetricsRegistry
+  ) {
     this.app = express();
     this.db = db;
+    this.dependencyGraph = dependencyGraph;
+    this.searchService = searchService || new SearchService(db);
+    this.integrationManager = integrationManager;
+    this.securityManager = securityManager;
+    this.permissionCache = permissionCache || new PermissionCache(db);
+    this.metrics = metrics || new MetricsRegistry();
     
     // Initialize repositories
     this.projectRepo = new ProjectRepository(db);
@@ -58,6 +91,20 @@ export class ApiServer {
   }
 
   private setupMiddleware() {
+    // Latency per matched route, first so it covers every other middleware
+    this.app.use((req, res, next) => {
+      if (!this.metrics.sampleRequest()) return next();
+      const started = performance.now();
+      res.once('finish', () => {
+        // Unmatched paths share one series so probes cannot blow up cardinality
+        const route = req.route ? `${req.method} ${req.baseUrl}${req.route.path}` : `${req.method} (unmatched)`;
+        this.metrics.observe('http', route, started, performance.now() - started, res.statusCode >= 500, {
+          status: res.statusCode,
+        });
+      });
+      next();
+    });
+
     // Security
     this.app.use(helmet());
     this.app.use(cors());
@@ -123,13 +170,44 @@ export class ApiServer {
       return res.status(401).json({ error: 'Access token required' });
     }
 
-    try {
-      const user = jwt.verify(token, JWT_SECRET);
-      (req as any).user = user;
-      next();
-    } catch (error) {
-      return res.status(403).json({ error: 'Invalid or expired token' });
+    let principal: { userId?: number; apiKeyId?: number };
+    if (token.startsWith(API_KEY_PREFIX) && this.securityManager) {
+      const apiKey = this.securityManager.verifyAPIKey(token);
+      if (!apiKey) {
+        return res.status(403).json({ error: 'Invalid, revoked or expired API key' });
+      }
+      // Reads need the read scope, anything that can change data needs write
+      const required = req.method === 'GET' || req.method === 'HEAD' ? APIKeyScope.Read : APIKeyScope.Write;
+      if (!apiKeyHasScope(apiKey.scopes, required)) {
+        return res.status(403).json({ error: `API key lacks the ${required} scope` });
+      }
+      (req as any).user = { userId: apiKey.userId, apiKeyId: apiKey.id, scopes: apiKey.scopes };
+      principal = { userId: apiKey.userId, apiKeyId: apiKey.id };
+    } else {
+      try {
+        const user = jwt.verify(token, JWT_SECRET) as any;
+        (req as any).user = user;
+        principal = { userId: typeof user?.userId === 'number' ? user.userId : undefined };
+      } catch (error) {
+        return res.status(403).json({ error: 'Invalid or expired token' });
+      }
+    }
+
+    // Per-key/per-user limits configured in rate_limit_configs, checked in memory
+    if (this.integrationManager) {
+      const limit = this.integrationManager.checkRequestRateLimit(principal);
+      if (limit.limit >= 0) {
+        res.setHeader('X-RateLimit-Limit', String(limit.limit));
+        res.setHeader('X-RateLimit-Remaining', String(limit.remaining));
+        res.setHeader('X-RateLimit-Reset', String(Math.ceil(limit.resetAt.getTime() / 1000)));
+      }
+      if (!limit.allowed) {
+        res.setHeader('Retry-After', String(Math.max(1, Math.ceil((limit.resetAt.getTime() - Date.now()) / 1000))));
+        return res.status(429).json({ error: 'Rate limit exceeded' });
+      }
     }
+
+    next();
   }
 
   private setupRoutes() {
@@ -138,6 +216,43 @@ export class ApiServer {
       res.json({ status: 'ok', timestamp: new Date().toISOString() });
     });
 
+    /**
+     * @swagger
+     * /metrics:
+     *   get:
+     *     summary: IPC, API, SQL and event loop metrics in Prometheus text format
+     *     tags: [Diagnostics]
+     *     security:
+     *       - bearerAuth: []
+     *     responses:
+     *       200:
+     *         description: Metrics (counts cover sampled calls; see devtrack_metrics_sample_rate)
+     *         content:
+     *           text/plain:
+     *             schema:
+     *               type: string
+     */
+    this.app.get('/metrics', this.authenticateToken.bind(this), (req, res) => {
+      res.type('text/plain; version=0.0.4').send(this.metrics.toPrometheus());
+    });
+
+    /**
+     * @swagger
+     * /api/diagnostics/trace:
+     *   get:
+     *     summary: Recent sampled spans as a Chrome trace (chrome://tracing, Perfetto)
+     *     tags: [Diagnostics]
+     *     security:
+     *       - bearerAuth: []
+     *     responses:
+     *       200:
+     *         description: Trace in the Chrome trace event JSON object format
+     */
+    this.app.get('/api/diagnostics/trace', this.authenticateToken.bind(this), (req, res) => {
+      res.setHeader('Content-Disposition', 'attachment; filename="devtrack-trace.json"');
+      res.json(this.metrics.getTrace());
+    });
+
     // Authentication routes
     /**
      * @swagger
@@ -220,6 +335,31 @@ export class ApiServer {
       }
     });
 
+    /**
+     * @swagger
+     * /api/projects/{id}/permissions:
+     *   get:
+     *     summary: Get the caller's effective permissions in a project
+     *     tags: [Projects]
+     *     security:
+     *       - bearerAuth: []
+     *     responses:
+     *       200:
+     *         description: Permission names granted by the caller's project role
+     */
+    this.app.get('/api/projects/:id/permissions', this.authenticateToken.bind(this), async (req, res) => {
+      try {
+        const projectId = parseInt(req.params.id);
+        const userId = (req as any).user.userId;
+        if (isNaN(projectId) || typeof userId !== 'number') {
+          return res.status(400).json({ error: 'Project ID and a user token are required' });
+        }
+        res.json({ projectId, userId, permissions: this.permissionCache.getPermissions(userId, projectId) });
+      } catch (error: any) {
+        res.status(500).json({ error: error.message });
+      }
+    });
+
     this.app.post('/api/projects', this.authenticateToken.bind(this), async (req, res) => {
       try {
         const project = await Promise.resolve(this.projectRepo.create(req.body));
@@ -247,6 +387,8 @@ export class ApiServer {
         if (!success) {
           return res.status(404).json({ error: 'Project not found' });
         }
+        this.dependencyGraph?.removeProject(parseInt(req.params.id));
+        this.permissionCache.invalidateProject(parseInt(req.params.id));
         res.status(204).send();
       } catch (error: any) {
         res.status(500).json({ error: error.message });
@@ -254,9 +396,55 @@ export class ApiServer {
     });
 
     // Task routes
+    /**
+     * @swagger
+     * /api/tasks:
+     *   get:
+     *     summary: Get tasks for a project
+     *     description: Returns a plain array, or a keyset-paginated page when limit or after is given
+     *     tags: [Tasks]
+     *     security:
+     *       - bearerAuth: []
+     *     parameters:
+     *       - in: query
+     *         name: projectId
+     *         schema:
+     *           type: integer
+     *       - in: query
+     *         name: limit
+     *         schema:
+     *           type: integer
+     *           maximum: 1000
+     *       - in: query
+     *         name: after
+     *         description: nextCursor from the previous page
+     *         schema:
+     *           type: string
+     *     responses:
+     *       200:
+     *         description: List of tasks, or { tasks, nextCursor } when paginated
+     */
     this.app.get('/api/tasks', this.authenticateToken.bind(this), async (req, res) => {
       try {
         const projectId = req.query.projectId ? parseInt(req.query.projectId as string) : undefined;
+        const limit = req.query.limit ? parseInt(req.query.limit as string) : undefined;
+        const after = typeof req.query.after === 'string' ? req.query.after : undefined;
+
+        if (limit !== undefined || after !== undefined) {
+          if (limit !== undefined && isNaN(limit)) {
+            return res.status(400).json({ error: 'limit must be a number' });
+          }
+          if (!projectId) {
+            return res.json({ tasks: [], nextCursor: null });
+          }
+          try {
+            res.json(this.taskRepo.findPageByProjectId(projectId, { limit, after }));
+          } catch (error: any) {
+            res.status(400).json({ error: error.message });
+          }
+          return;
+        }
+
         const tasks = projectId
           ? await Promise.resolve(this.taskRepo.findByProjectId(projectId))
           : [];
@@ -281,6 +469,7 @@ export class ApiServer {
     this.app.post('/api/tasks', this.authenticateToken.bind(this), async (req, res) => {
       try {
         const task = await Promise.resolve(this.taskRepo.create(req.body));
+        this.dependencyGraph?.upsertTask(task);
         res.status(201).json(task);
       } catch (error: any) {
         res.status(400).json({ error: error.message });
@@ -293,6 +482,7 @@ export class ApiServer {
         if (!task) {
           return res.status(404).json({ error: 'Task not found' });
         }
+        this.dependencyGraph?.upsertTask(task);
         res.json(task);
       } catch (error: any) {
         res.status(400).json({ error: error.message });
@@ -305,6 +495,7 @@ export class ApiServer {
         if (!success) {
           return res.status(404).json({ error: 'Task not found' });
         }
+        this.dependencyGraph?.removeTask(parseInt(req.params.id));
         res.status(204).send();
       } catch (error: any) {
         res.status(500).json({ error: error.message });
@@ -333,6 +524,67 @@ export class ApiServer {
       }
     });
 
+    // Search routes
+    /**
+     * @swagger
+     * /api/search:
+     *   get:
+     *     summary: Full-text search across tasks and comments
+     *     tags: [Search]
+     *     security:
+     *       - bearerAuth: []
+     *     parameters:
+     *       - in: query
+     *         name: q
+     *         required: true
+     *         schema:
+     *           type: string
+     *       - in: query
+     *         name: types
+     *         description: Comma-separated subset of task, comment
+     *         schema:
+     *           type: string
+     *       - in: query
+     *         name: projectId
+     *         schema:
+     *           type: integer
+     *       - in: query
+     *         name: limit
+     *         schema:
+     *           type: integer
+     *           maximum: 200
+     *       - in: query
+     *         name: offset
+     *         schema:
+     *           type: integer
+     *     responses:
+     *       200:
+     *         description: Ranked results as { results, nextOffset }
+     */
+    this.app.get('/api/search', this.authenticateToken.bind(this), async (req, res) => {
+      try {
+        if (typeof req.query.q !== 'string') {
+          return res.status(400).json({ error: 'q is required' });
+        }
+        const projectId = req.query.projectId ? parseInt(req.query.projectId as string) : undefined;
+        const limit = req.query.limit ? parseInt(req.query.limit as string) : undefined;
+        const offset = req.query.offset ? parseInt(req.query.offset as string) : undefined;
+        if ([projectId, limit, offset].some(value => value !== undefined && isNaN(value))) {
+          return res.status(400).json({ error: 'projectId, limit and offset must be numbers' });
+        }
+        const types = typeof req.query.types === 'string'
+          ? req.query.types.split(',').map(type => type.trim()) as SearchEntityType[]
+          : REST_SEARCH_TYPES;
+        if (types.some(type => !REST_SEARCH_TYPES.includes(type))) {
+          return res.status(400).json({ error: `types must be a subset of ${REST_SEARCH_TYPES.join(', ')}` });
+        }
+
+        res.json(this.searchService.search({ query: req.query.q, types, projectId, limit, offset }));
+      } catch (error: any) {
+        res.status(500).json({ error: error.message });
+      }
+    });
+
     // User routes
     this.app.get('/api/users', this.authenticateToken.bind(this), async (req, res) => {
       try {
@@ -367,6 +619,79 @@ export class ApiServer {
       }
     });
 
+    /**
+     * @swagger
+     * /api/time-entries/export:
+     *   get:
+     *     summary: Stream time entries as CSV or JSON (gzipped when the client accepts it)
+     *     tags: [Time Entries]
+     *     security:
+     *       - bearerAuth: []
+     *     parameters:
+     *       - in: query
+     *         name: format
+     *         schema:
+     *           type: string
+     *           enum: [csv, json]
+     *       - in: query
+     *         name: startDate
+     *         schema:
+     *           type: string
+     *       - in: query
+     *         name: endDate
+     *         schema:
+     *           type: string
+     *       - in: query
+     *         name: userId
+     *         schema:
+     *           type: integer
+     *       - in: query
+     *         name: projectId
+     *         schema:
+     *           type: integer
+     *     responses:
+     *       200:
+     *         description: Time entries, newest first
+     */
+    this.app.get('/api/time-entries/export', this.authenticateToken.bind(this), async (req, res) => {
+      const format = req.query.format ?? 'csv';
+      if (format !== 'csv' && format !== 'json') {
+        return res.status(400).json({ error: 'format must be csv or json' });
+      }
+      const userId = req.query.userId ? parseInt(req.query.userId as string) : undefined;
+      const projectId = req.query.projectId ? parseInt(req.query.projectId as string) : undefined;
+      if ([userId, projectId].some(value => value !== undefined && isNaN(value))) {
+        return res.status(400).json({ error: 'userId and projectId must be numbers' });
+      }
+      const filters = {
+        startDate: typeof req.query.startDate === 'string' ? req.query.startDate : undefined,
+        endDate: typeof req.query.endDate === 'string' ? req.query.endDate : undefined,
+        userId,
+        projectId,
+      };
+
+      const gzip = /\bgzip\b/.test(req.headers['accept-encoding'] ?? '');
+      res.setHeader('Content-Type', format === 'csv' ? 'text/csv; charset=utf-8' : 'application/json; charset=utf-8');
+      res.setHeader('Content-Disposition', `attachment; filename="time-entries.${format}"`);
+      if (gzip) res.setHeader('Content-Encoding', 'gzip');
+
+      // Stop reading rows when the client goes away
+      const controller = new AbortController();
+      res.on('close', () => {
+        if (!res.writableFinished) controller.abort();
+      });
+
+      const conn = openExportConnection(this.db.name);
+      try {
+        await this.timeEntryRepo.exportStream(conn, filters, res, { format, gzip, signal: controller.signal });
+      } catch (error: any) {
+        // A failed export destroys the response, so the client sees a reset
+        if (error.name !== 'ExportCancelledError') console.error('Time entry export failed:', error);
+      } finally {
+        conn.close();
+      }
+    });
+
     this.app.post('/api/time-entries', this.authenticateToken.bind(this), async (req, res) => {
       try {
         const entry = await Promise.resolve(this.timeEntryRepo.create(req.body));
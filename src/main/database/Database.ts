@@ -1,41 +1,118 @@
 import Database from 'better-sqlite3';
 import path from 'path';
 import { app } from 'electron';
+import { StorageSettings, DEFAULT_SETTINGS } from '../models/AppSettings';
+import { getStatementCache, StatementCacheStats } from './StatementCache';
+import { migrateCoreSchema } from './migrations';
+
+/**
+ * Version of the core schema built by initialize(). Bump it whenever
+ * createTables, createIndexes, the aggregates, the search index or the
+ * change log change, or existing databases will not pick the change up.
+ */
+const SCHEMA_VERSION = 3;
+
+/**
+ * Integer epoch mirrors of the ISO timestamp columns on time_entries.
+ * Virtual generated columns cost no storage and cannot drift from the
+ * text columns; indexed, they keep range predicates sargable without
+ * wrapping the column in date().
+ */
+const TIME_ENTRY_EPOCH_COLUMNS = [
+  { name: 'start_ts', definition: "start_ts INTEGER GENERATED ALWAYS AS (CAST(strftime('%s', start_time) AS INTEGER)) VIRTUAL" },
+  { name: 'end_ts', definition: "end_ts INTEGER GENERATED ALWAYS AS (CAST(strftime('%s', end_time) AS INTEGER)) VIRTUAL" },
+];
+
+/**
+ * Time rollup tables and the bucket each entry's start time falls in.
+ * Weeks start on Monday ('weekday 0' is the following Sunday).
+ */
+const TIME_ROLLUPS = [
+  { table: 'agg_time_daily', bucket: 'day', expr: (col: string) => `date(${col})` },
+  { table: 'agg_time_weekly', bucket: 'week', expr: (col: string) => `date(${col}, 'weekday 0', '-6 days')` },
+];
 
 /**
  * DevTrack database manager using better-sqlite3
  * Handles connection, initialization, and schema creation
+ *
+ * A single writer connection owns all writes and DDL. In WAL mode a small
+ * pool of read-only connections serves repository reads, so long reports
+ * read a stable snapshot without holding locks against the writer.
  */
 export class DevTrackDatabase {
   private db: Database.Database | null = null;
+  private readers: Database.Database[] = [];
+  private nextReader = 0;
   private readonly dbPath: string;
 
-  constructor() {
-    const userDataPath = app.getPath('userData');
-    this.dbPath = path.join(userDataPath, 'devtrack.db');
+  /**
+   * @param dbPath Database file; defaults to devtrack.db in the app's
+   * userData directory. Scripts running outside Electron must pass one.
+   */
+  constructor(dbPath?: string) {
+    this.dbPath = dbPath ?? path.join(app.getPath('userData'), 'devtrack.db');
   }
 
   /**
    * Initialize database connection and create tables
    */
-  public initialize(): void {
+  public initialize(storageSettings?: Partial<StorageSettings>): void {
+    const storage: StorageSettings = { ...DEFAULT_SETTINGS.storage, ...storageSettings };
     console.log('[Database] Initializing database at:', this.dbPath);
     this.db = new Database(this.dbPath);
     
     // Enable foreign keys
     this.db.pragma('foreign_keys = ON');
     console.log('[Database] Foreign keys enabled');
+
+    this.applyStoragePragmas(this.db, storage);
+    getStatementCache(this.db, storage.statementCacheSize);
+    console.log(`[Database] Storage mode: journal=${storage.journalMode}, synchronous=${storage.synchronous}`);
     
-    // Create schema
-    console.log('[Database] Creating tables...');
-    this.createTables();
-    console.log('[Database] Creating indexes...');
-    this.createIndexes();
+    // Create or upgrade the schema; a current database skips all DDL
+    const migrated = migrateCoreSchema(this.db, SCHEMA_VERSION, () => {
+      console.log('[Database] Creating tables...');
+      this.createTables();
+      console.log('[Database] Creating indexes...');
+      this.createIndexes();
+      console.log('[Database] Creating analytics aggregates...');
+      // Before createAggregates, whose first-run backfill rebuilds the rollups too
+      this.createTimeRollups();
+      this.createAggregates();
+      console.log('[Database] Creating search index...');
+      this.createSearchIndex();
+      console.log('[Database] Creating change log...');
+      this.createChangeLog();
+    });
+    if (!migrated) {
+      console.log(`[Database] Schema is current (version ${SCHEMA_VERSION})`);
+    }
+
+    // Readers are opened after the schema exists; rollback-journal mode
+    // gains nothing from extra connections, so the pool stays empty there.
+    if (storage.journalMode === 'wal') {
+      for (let i = 0; i < storage.readPoolSize; i++) {
+        const reader = new Database(this.dbPath, { readonly: true, fileMustExist: true });
+        this.applyStoragePragmas(reader, storage);
+        getStatementCache(reader, storage.statementCacheSize);
+        this.readers.push(reader);
+      }
+      console.log(`[Database] Opened ${this.readers.length} read-only connection(s)`);
+    }
     console.log('[Database] Database initialization complete');
   }
 
   /**
-   * Get database instance
+   * Path of the database file, for connections opened elsewhere
+   * (e.g. query worker threads)
+   */
+  public getPath(): string {
+    return this.dbPath;
+  }
+
+  /**
+   * Get database instance (the single writer connection)
    */
   public getDb(): Database.Database {
     if (!this.db) {
@@ -45,15 +122,103 @@ export class DevTrackDatabase {
   }
 
   /**
-   * Close database connection
+   * Get a read-only connection from the pool (round-robin).
+   * Falls back to the writer when no read pool is configured.
+   *
+   * Readers do not see uncommitted writes, so code that reads back its own
+   * writes (e.g. inside db.transaction) must use getDb() instead.
+   */
+  public getReadDb(): Database.Database {
+    if (this.readers.length === 0) {
+      return this.getDb();
+    }
+    const reader = this.readers[this.nextReader];
+    this.nextReader = (this.nextReader + 1) % this.readers.length;
+    return reader;
+  }
+
+  /**
+   * Get prepared-statement cache counters for the writer and each reader
+   */
+  public getStatementCacheStats(): { writer: StatementCacheStats | null; readers: StatementCacheStats[] } {
+    return {
+      writer: this.db ? getStatementCache(this.db).getStats() : null,
+      readers: this.readers.map(reader => getStatementCache(reader).getStats()),
+    };
+  }
+
+  /**
+   * Close database connections
    */
   public close(): void {
+    for (const reader of this.readers) {
+      getStatementCache(reader).clear();
+      reader.close();
+    }
+    this.readers = [];
+    this.nextReader = 0;
+
     if (this.db) {
+      getStatementCache(this.db).clear();
       this.db.close();
       this.db = null;
     }
   }
 
+  /**
+   * Recompute all analytics aggregate tables from the base tables.
+   * Triggers keep them current afterwards; this is for first-run backfill
+   * and manual repair.
+   */
+  public rebuildAnalyticsAggregates(): void {
+    const db = this.getDb();
+    db.transaction(() => {
+      db.exec(`
+        DELETE FROM agg_project_task_counts;
+        INSERT INTO agg_project_task_counts (project_id, status, priority, task_count, completed_count, completion_days)
+        SELECT
+          project_id, status, priority, COUNT(*),
+          SUM(CASE WHEN completed_at IS NOT NULL THEN 1 ELSE 0 END),
+          COALESCE(SUM(julianday(completed_at) - julianday(created_at)), 0)
+        FROM tasks
+        GROUP BY project_id, status, priority;
+
+        DELETE FROM agg_assignee_task_counts;
+        INSERT INTO agg_assignee_task_counts (assigned_to, status, task_count)
+        SELECT assigned_to, status, COUNT(*)
+        FROM tasks
+        WHERE assigned_to IS NOT NULL
+        GROUP BY assigned_to, status;
+
+        DELETE FROM agg_time_task_totals;
+        INSERT INTO agg_time_task_totals (user_id, task_id, entries_count, total_seconds, billable_seconds, earnings)
+        SELECT
+          user_id, task_id, COUNT(*),
+          COALESCE(SUM(duration), 0),
+          COALESCE(SUM(CASE WHEN is_billable = 1 THEN duration ELSE 0 END), 0),
+          COALESCE(SUM(CASE WHEN is_billable = 1 THEN (duration / 3600.0) * COALESCE(hourly_rate, 0) ELSE 0 END), 0)
+        FROM time_entries
+        WHERE end_time IS NOT NULL
+        GROUP BY user_id, task_id;
+      `);
+      this.rebuildTimeRollups();
+    })();
+  }
+
+  /**
+   * Apply journal and cache pragmas to a connection.
+   * journal_mode is persistent in the file, so only the writer sets it.
+   */
+  private applyStoragePragmas(conn: Database.Database, storage: StorageSettings): void {
+    if (!conn.readonly) {
+      conn.pragma(`journal_mode = ${storage.journalMode === 'wal' ? 'WAL' : 'DELETE'}`);
+      conn.pragma(`synchronous = ${storage.synchronous.toUpperCase()}`);
+    }
+    // Negative cache_size is interpreted by SQLite as KiB
+    conn.pragma(`cache_size = -${Math.max(0, Math.floor(storage.cacheSizeMb * 1024))}`);
+    conn.pragma(`mmap_size = ${Math.max(0, Math.floor(storage.mmapSizeMb * 1024 * 1024))}`);
+  }
+
   /**
    * Create all database tables
    */
@@ -299,6 +464,41 @@ export class DevTrackDatabase {
       )
     `);
 
+    // Labels a project template gives the projects created from it
+    this.db.exec(`
+      CREATE TABLE IF NOT EXISTS template_labels (
+        id INTEGER PRIMARY KEY AUTOINCREMENT,
+        project_template_id INTEGER NOT NULL,
+        name TEXT NOT NULL,
+        color TEXT NOT NULL,
+        description TEXT,
+        FOREIGN KEY (project_template_id) REFERENCES project_templates(id) ON DELETE CASCADE
+      )
+    `);
+
+    // Task template-label junction table
+    this.db.exec(`
+      CREATE TABLE IF NOT EXISTS task_template_labels (
+        task_template_id INTEGER NOT NULL,
+        template_label_id INTEGER NOT NULL,
+        PRIMARY KEY (task_template_id, template_label_id),
+        FOREIGN KEY (task_template_id) REFERENCES task_templates(id) ON DELETE CASCADE,
+        FOREIGN KEY (template_label_id) REFERENCES template_labels(id) ON DELETE CASCADE
+      )
+    `);
+
+    // Dependencies between task templates of the same project template
+    this.db.exec(`
+      CREATE TABLE IF NOT EXISTS task_template_dependencies (
+        task_template_id INTEGER NOT NULL,
+        depends_on_task_template_id INTEGER NOT NULL,
+        dependency_type TEXT NOT NULL DEFAULT 'blocks',
+        PRIMARY KEY (task_template_id, depends_on_task_template_id),
+        FOREIGN KEY (task_template_id) REFERENCES task_templates(id) ON DELETE CASCADE,
+        FOREIGN KEY (depends_on_task_template_id) REFERENCES task_templates(id) ON DELETE CASCADE
+      )
+    `);
+
     // Notifications table
     this.db.exec(`
       CREATE TABLE IF NOT EXISTS notifications (
@@ -333,10 +533,12 @@ export class DevTrackDatabase {
         hourly_rate REAL,
         created_at TEXT NOT NULL,
         updated_at TEXT NOT NULL,
+        ${TIME_ENTRY_EPOCH_COLUMNS.map(column => column.definition).join(',\n        ')},
         FOREIGN KEY (task_id) REFERENCES tasks(id) ON DELETE CASCADE,
         FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
       )
     `);
+    this.addTimeEntryEpochColumns();
 
     // Automation rules table
     this.db.exec(`
@@ -376,36 +578,550 @@ export class DevTrackDatabase {
   }
 
   /**
-   * Create indexes for performance
+   * Create indexes for performance.
+   *
+   * Listings that filter and then sort get one composite index whose
+   * columns follow the WHERE equalities and then the ORDER BY, so SQLite
+   * walks the index in order instead of sorting in a temp B-tree. Such an
+   * index also serves lookups (and FK cascades) on its leading column, so
+   * the single-column indexes it supersedes are dropped. The listings are
+   * checked against these indexes by database/queryPlanCheck.ts.
    */
   private createIndexes(): void {
     if (!this.db) return;
 
     this.db.exec(`
-      CREATE INDEX IF NOT EXISTS idx_tasks_project_id ON tasks(project_id);
-      CREATE INDEX IF NOT EXISTS idx_comments_task_id ON comments(task_id);
       CREATE INDEX IF NOT EXISTS idx_attachments_task_id ON attachments(task_id);
-      CREATE INDEX IF NOT EXISTS idx_labels_project_id ON labels(project_id);
       CREATE INDEX IF NOT EXISTS idx_task_dependencies_task_id ON task_dependencies(task_id);
       CREATE INDEX IF NOT EXISTS idx_task_dependencies_depends_on ON task_dependencies(depends_on_task_id);
       CREATE INDEX IF NOT EXISTS idx_project_members_project_id ON project_members(project_id);
       CREATE INDEX IF NOT EXISTS idx_project_members_user_id ON project_members(user_id);
       CREATE INDEX IF NOT EXISTS idx_users_username ON users(username);
       CREATE INDEX IF NOT EXISTS idx_users_email ON users(email);
-      CREATE INDEX IF NOT EXISTS idx_notifications_user_id ON notifications(user_id);
       CREATE INDEX IF NOT EXISTS idx_notifications_is_read ON notifications(is_read);
       CREATE INDEX IF NOT EXISTS idx_notifications_created_at ON notifications(created_at);
       CREATE INDEX IF NOT EXISTS idx_project_templates_category ON project_templates(category);
       CREATE INDEX IF NOT EXISTS idx_project_templates_is_public ON project_templates(is_public);
       CREATE INDEX IF NOT EXISTS idx_task_templates_project_template_id ON task_templates(project_template_id);
-      CREATE INDEX IF NOT EXISTS idx_time_entries_task_id ON time_entries(task_id);
-      CREATE INDEX IF NOT EXISTS idx_time_entries_user_id ON time_entries(user_id);
+      CREATE INDEX IF NOT EXISTS idx_template_labels_project_template_id ON template_labels(project_template_id);
+      CREATE INDEX IF NOT EXISTS idx_task_template_labels_label_id ON task_template_labels(template_label_id);
+      CREATE INDEX IF NOT EXISTS idx_task_template_dependencies_depends_on ON task_template_dependencies(depends_on_task_template_id);
       CREATE INDEX IF NOT EXISTS idx_time_entries_start_time ON time_entries(start_time);
-      CREATE INDEX IF NOT EXISTS idx_automation_rules_project_id ON automation_rules(project_id);
+      CREATE INDEX IF NOT EXISTS idx_time_entries_user_start_ts ON time_entries(user_id, start_ts);
+      CREATE INDEX IF NOT EXISTS idx_time_entries_start_ts ON time_entries(start_ts);
       CREATE INDEX IF NOT EXISTS idx_automation_rules_is_active ON automation_rules(is_active);
       CREATE INDEX IF NOT EXISTS idx_automation_rules_trigger_type ON automation_rules(trigger_type);
-      CREATE INDEX IF NOT EXISTS idx_automation_logs_rule_id ON automation_logs(rule_id);
       CREATE INDEX IF NOT EXISTS idx_automation_logs_executed_at ON automation_logs(executed_at);
+      CREATE INDEX IF NOT EXISTS idx_tasks_due_date ON tasks(due_date);
+      CREATE INDEX IF NOT EXISTS idx_tasks_completed_at ON tasks(completed_at);
+      CREATE INDEX IF NOT EXISTS idx_tasks_assigned_due ON tasks(assigned_to, due_date);
+
+      -- Filtered, ordered listings
+      CREATE INDEX IF NOT EXISTS idx_tasks_project_order ON tasks(project_id, position, created_at);
+      CREATE INDEX IF NOT EXISTS idx_tasks_status_order ON tasks(status, position, created_at);
+      CREATE INDEX IF NOT EXISTS idx_tasks_project_status_order ON tasks(project_id, status, position, created_at);
+      CREATE INDEX IF NOT EXISTS idx_comments_task_created ON comments(task_id, created_at);
+      CREATE INDEX IF NOT EXISTS idx_labels_project_name ON labels(project_id, name);
+      CREATE INDEX IF NOT EXISTS idx_projects_updated_at ON projects(updated_at);
+      CREATE INDEX IF NOT EXISTS idx_projects_status_updated ON projects(status, updated_at);
+      CREATE INDEX IF NOT EXISTS idx_notifications_user_created ON notifications(user_id, created_at);
+      CREATE INDEX IF NOT EXISTS idx_notifications_user_unread ON notifications(user_id, is_read, created_at);
+      CREATE INDEX IF NOT EXISTS idx_time_entries_user_start ON time_entries(user_id, start_time);
+      CREATE INDEX IF NOT EXISTS idx_time_entries_task_start ON time_entries(task_id, start_time);
+      CREATE INDEX IF NOT EXISTS idx_time_entries_running ON time_entries(user_id, start_time) WHERE end_time IS NULL;
+      CREATE INDEX IF NOT EXISTS idx_automation_rules_created_at ON automation_rules(created_at);
+      CREATE INDEX IF NOT EXISTS idx_automation_rules_project_created ON automation_rules(project_id, created_at);
+      CREATE INDEX IF NOT EXISTS idx_automation_logs_rule_executed ON automation_logs(rule_id, executed_at);
+
+      -- Superseded by the composite indexes above
+      DROP INDEX IF EXISTS idx_tasks_project_id;
+      DROP INDEX IF EXISTS idx_comments_task_id;
+      DROP INDEX IF EXISTS idx_labels_project_id;
+      DROP INDEX IF EXISTS idx_notifications_user_id;
+      DROP INDEX IF EXISTS idx_time_entries_task_id;
+      DROP INDEX IF EXISTS idx_time_entries_user_id;
+      DROP INDEX IF EXISTS idx_automation_rules_project_id;
+      DROP INDEX IF EXISTS idx_automation_logs_rule_id;
+    `);
+  }
+
+  /**
+   * Create materialized analytics aggregates and the triggers that keep
+   * them in sync with tasks and time_entries. Reports read these small
+   * tables instead of grouping over the full base tables.
+   *
+   * Trigger contributions are additive (old row subtracted, new row added),
+   * so FK cascades and multi-row updates stay consistent.
+   */
+  private createAggregates(): void {
+    if (!this.db) return;
+
+    const needsBackfill = !this.db
+      .prepare("SELECT 1 FROM sqlite_master WHERE type = 'trigger' AND name = 'trg_tasks_agg_insert'")
+      .get();
+
+    this.db.exec(`
+      CREATE TABLE IF NOT EXISTS agg_project_task_counts (
+        project_id INTEGER NOT NULL,
+        status TEXT NOT NULL,
+        priority TEXT NOT NULL,
+        task_count INTEGER NOT NULL DEFAULT 0,
+        completed_count INTEGER NOT NULL DEFAULT 0,
+        completion_days REAL NOT NULL DEFAULT 0,
+        PRIMARY KEY (project_id, status, priority)
+      ) WITHOUT ROWID;
+
+      CREATE TABLE IF NOT EXISTS agg_assignee_task_counts (
+        assigned_to TEXT NOT NULL,
+        status TEXT NOT NULL,
+        task_count INTEGER NOT NULL DEFAULT 0,
+        PRIMARY KEY (assigned_to, status)
+      ) WITHOUT ROWID;
+
+      -- Keyed by task rather than project so moving a task between projects
+      -- or cascading a task delete needs no lookup inside the trigger
+      CREATE TABLE IF NOT EXISTS agg_time_task_totals (
+        user_id INTEGER NOT NULL,
+        task_id INTEGER NOT NULL,
+        entries_count INTEGER NOT NULL DEFAULT 0,
+        total_seconds INTEGER NOT NULL DEFAULT 0,
+        billable_seconds INTEGER NOT NULL DEFAULT 0,
+        earnings REAL NOT NULL DEFAULT 0,
+        PRIMARY KEY (user_id, task_id)
+      ) WITHOUT ROWID;
+
+      CREATE INDEX IF NOT EXISTS idx_agg_time_task_totals_task_id ON agg_time_task_totals(task_id);
+
+      CREATE TRIGGER IF NOT EXISTS trg_tasks_agg_insert AFTER INSERT ON tasks BEGIN
+        INSERT INTO agg_project_task_counts (project_id, status, priority, task_count, completed_count, completion_days)
+        VALUES (
+          NEW.project_id, NEW.status, NEW.priority, 1,
+          CASE WHEN NEW.completed_at IS NOT NULL THEN 1 ELSE 0 END,
+          COALESCE(julianday(NEW.completed_at) - julianday(NEW.created_at), 0)
+        )
+        ON CONFLICT(project_id, status, priority) DO UPDATE SET
+          task_count = task_count + excluded.task_count,
+          completed_count = completed_count + excluded.completed_count,
+          completion_days = completion_days + excluded.completion_days;
+
+        INSERT INTO agg_assignee_task_counts (assigned_to, status, task_count)
+        SELECT NEW.assigned_to, NEW.status, 1 WHERE NEW.assigned_to IS NOT NULL
+        ON CONFLICT(assigned_to, status) DO UPDATE SET task_count = task_count + 1;
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_tasks_agg_delete AFTER DELETE ON tasks BEGIN
+        INSERT INTO agg_project_task_counts (project_id, status, priority, task_count, completed_count, completion_days)
+        VALUES (
+          OLD.project_id, OLD.status, OLD.priority, -1,
+          CASE WHEN OLD.completed_at IS NOT NULL THEN -1 ELSE 0 END,
+          -COALESCE(julianday(OLD.completed_at) - julianday(OLD.created_at), 0)
+        )
+        ON CONFLICT(project_id, status, priority) DO UPDATE SET
+          task_count = task_count + excluded.task_count,
+          completed_count = completed_count + excluded.completed_count,
+          completion_days = completion_days + excluded.completion_days;
+        DELETE FROM agg_project_task_counts
+        WHERE project_id = OLD.project_id AND status = OLD.status AND priority = OLD.priority AND task_count <= 0;
+
+        UPDATE agg_assignee_task_counts SET task_count = task_count - 1
+        WHERE assigned_to = OLD.assigned_to AND status = OLD.status;
+        DELETE FROM agg_assignee_task_counts
+        WHERE assigned_to = OLD.assigned_to AND status = OLD.status AND task_count <= 0;
+
+        DELETE FROM agg_time_task_totals WHERE task_id = OLD.id;
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_tasks_agg_update
+      AFTER UPDATE OF project_id, status, priority, assigned_to, completed_at, created_at ON tasks BEGIN
+        INSERT INTO agg_project_task_counts (project_id, status, priority, task_count, completed_count, completion_days)
+        VALUES (
+          OLD.project_id, OLD.status, OLD.priority, -1,
+          CASE WHEN OLD.completed_at IS NOT NULL THEN -1 ELSE 0 END,
+          -COALESCE(julianday(OLD.completed_at) - julianday(OLD.created_at), 0)
+        )
+        ON CONFLICT(project_id, status, priority) DO UPDATE SET
+          task_count = task_count + excluded.task_count,
+          completed_count = completed_count + excluded.completed_count,
+          completion_days = completion_days + excluded.completion_days;
+        INSERT INTO agg_project_task_counts (project_id, status, priority, task_count, completed_count, completion_days)
+        VALUES (
+          NEW.project_id, NEW.status, NEW.priority, 1,
+          CASE WHEN NEW.completed_at IS NOT NULL THEN 1 ELSE 0 END,
+          COALESCE(julianday(NEW.completed_at) - julianday(NEW.created_at), 0)
+        )
+        ON CONFLICT(project_id, status, priority) DO UPDATE SET
+          task_count = task_count + excluded.task_count,
+          completed_count = completed_count + excluded.completed_count,
+          completion_days = completion_days + excluded.completion_days;
+        DELETE FROM agg_project_task_counts
+        WHERE project_id = OLD.project_id AND status = OLD.status AND priority = OLD.priority AND task_count <= 0;
+
+        UPDATE agg_assignee_task_counts SET task_count = task_count - 1
+        WHERE assigned_to = OLD.assigned_to AND status = OLD.status;
+        DELETE FROM agg_assignee_task_counts
+        WHERE assigned_to = OLD.assigned_to AND status = OLD.status AND task_count <= 0;
+        INSERT INTO agg_assignee_task_counts (assigned_to, status, task_count)
+        SELECT NEW.assigned_to, NEW.status, 1 WHERE NEW.assigned_to IS NOT NULL
+        ON CONFLICT(assigned_to, status) DO UPDATE SET task_count = task_count + 1;
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_time_entries_agg_insert AFTER INSERT ON time_entries
+      WHEN NEW.end_time IS NOT NULL BEGIN
+        INSERT INTO agg_time_task_totals (user_id, task_id, entries_count, total_seconds, billable_seconds, earnings)
+        VALUES (
+          NEW.user_id, NEW.task_id, 1,
+          COALESCE(NEW.duration, 0),
+          CASE WHEN NEW.is_billable = 1 THEN COALESCE(NEW.duration, 0) ELSE 0 END,
+          CASE WHEN NEW.is_billable = 1 THEN (COALESCE(NEW.duration, 0) / 3600.0) * COALESCE(NEW.hourly_rate, 0) ELSE 0 END
+        )
+        ON CONFLICT(user_id, task_id) DO UPDATE SET
+          entries_count = entries_count + excluded.entries_count,
+          total_seconds = total_seconds + excluded.total_seconds,
+          billable_seconds = billable_seconds + excluded.billable_seconds,
+          earnings = earnings + excluded.earnings;
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_time_entries_agg_delete AFTER DELETE ON time_entries
+      WHEN OLD.end_time IS NOT NULL BEGIN
+        INSERT INTO agg_time_task_totals (user_id, task_id, entries_count, total_seconds, billable_seconds, earnings)
+        VALUES (
+          OLD.user_id, OLD.task_id, -1,
+          -COALESCE(OLD.duration, 0),
+          CASE WHEN OLD.is_billable = 1 THEN -COALESCE(OLD.duration, 0) ELSE 0 END,
+          CASE WHEN OLD.is_billable = 1 THEN -(COALESCE(OLD.duration, 0) / 3600.0) * COALESCE(OLD.hourly_rate, 0) ELSE 0 END
+        )
+        ON CONFLICT(user_id, task_id) DO UPDATE SET
+          entries_count = entries_count + excluded.entries_count,
+          total_seconds = total_seconds + excluded.total_seconds,
+          billable_seconds = billable_seconds + excluded.billable_seconds,
+          earnings = earnings + excluded.earnings;
+        DELETE FROM agg_time_task_totals
+        WHERE user_id = OLD.user_id AND task_id = OLD.task_id AND entries_count <= 0;
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_time_entries_agg_update AFTER UPDATE ON time_entries BEGIN
+        INSERT INTO agg_time_task_totals (user_id, task_id, entries_count, total_seconds, billable_seconds, earnings)
+        SELECT
+          OLD.user_id, OLD.task_id, -1,
+          -COALESCE(OLD.duration, 0),
+          CASE WHEN OLD.is_billable = 1 THEN -COALESCE(OLD.duration, 0) ELSE 0 END,
+          CASE WHEN OLD.is_billable = 1 THEN -(COALESCE(OLD.duration, 0) / 3600.0) * COALESCE(OLD.hourly_rate, 0) ELSE 0 END
+        WHERE OLD.end_time IS NOT NULL
+        ON CONFLICT(user_id, task_id) DO UPDATE SET
+          entries_count = entries_count + excluded.entries_count,
+          total_seconds = total_seconds + excluded.total_seconds,
+          billable_seconds = billable_seconds + excluded.billable_seconds,
+          earnings = earnings + excluded.earnings;
+        INSERT INTO agg_time_task_totals (user_id, task_id, entries_count, total_seconds, billable_seconds, earnings)
+        SELECT
+          NEW.user_id, NEW.task_id, 1,
+          COALESCE(NEW.duration, 0),
+          CASE WHEN NEW.is_billable = 1 THEN COALESCE(NEW.duration, 0) ELSE 0 END,
+          CASE WHEN NEW.is_billable = 1 THEN (COALESCE(NEW.duration, 0) / 3600.0) * COALESCE(NEW.hourly_rate, 0) ELSE 0 END
+        WHERE NEW.end_time IS NOT NULL
+        ON CONFLICT(user_id, task_id) DO UPDATE SET
+          entries_count = entries_count + excluded.entries_count,
+          total_seconds = total_seconds + excluded.total_seconds,
+          billable_seconds = billable_seconds + excluded.billable_seconds,
+          earnings = earnings + excluded.earnings;
+        DELETE FROM agg_time_task_totals
+        WHERE user_id = OLD.user_id AND task_id = OLD.task_id AND entries_count <= 0;
+      END;
+    `);
+
+    if (needsBackfill) {
+      console.log('[Database] Backfilling analytics aggregates...');
+      this.rebuildAnalyticsAggregates();
+    }
+  }
+
+  /**
+   * Add the epoch columns to time_entries tables created before they existed
+   */
+  private addTimeEntryEpochColumns(): void {
+    if (!this.db) return;
+
+    // table_xinfo (unlike table_info) lists generated columns
+    const existing = new Set(
+      (this.db.prepare('PRAGMA table_xinfo(time_entries)').all() as Array<{ name: string }>).map(column => column.name)
+    );
+    for (const column of TIME_ENTRY_EPOCH_COLUMNS) {
+      if (!existing.has(column.name)) {
+        this.db.exec(`ALTER TABLE time_entries ADD COLUMN ${column.definition}`);
+      }
+    }
+  }
+
+  /**
+   * Create daily and weekly time rollups per (bucket, user, task) and the
+   * triggers that maintain them as entries are stopped, edited or deleted.
+   * Running entries (no end_time) are not counted until they stop.
+   *
+   * Like agg_time_task_totals the rollups are keyed by task, and reports
+   * join tasks for the project, so moving a task needs no rollup update.
+   * Range reports read whole weeks from agg_time_weekly and the partial
+   * weeks at either edge from agg_time_daily.
+   */
+  private createTimeRollups(): void {
+    if (!this.db) return;
+
+    const needsBackfill = !this.db
+      .prepare("SELECT 1 FROM sqlite_master WHERE type = 'trigger' AND name = 'trg_time_entries_rollup_insert'")
+      .get();
+
+    const insertSql: string[] = [];
+    const deleteSql: string[] = [];
+    const updateSql: string[] = [];
+    for (const rollup of TIME_ROLLUPS) {
+      this.db.exec(`
+        CREATE TABLE IF NOT EXISTS ${rollup.table} (
+          ${rollup.bucket} TEXT NOT NULL,
+          user_id INTEGER NOT NULL,
+          task_id INTEGER NOT NULL,
+          entries_count INTEGER NOT NULL DEFAULT 0,
+          total_seconds INTEGER NOT NULL DEFAULT 0,
+          billable_seconds INTEGER NOT NULL DEFAULT 0,
+          earnings REAL NOT NULL DEFAULT 0,
+          PRIMARY KEY (${rollup.bucket}, user_id, task_id)
+        ) WITHOUT ROWID;
+
+        CREATE INDEX IF NOT EXISTS idx_${rollup.table}_task_id ON ${rollup.table}(task_id);
+      `);
+
+      const oldBucket = rollup.expr('OLD.start_time');
+      const prune = `
+        DELETE FROM ${rollup.table}
+        WHERE ${rollup.bucket} = ${oldBucket} AND user_id = OLD.user_id AND task_id = OLD.task_id AND entries_count <= 0;`;
+      insertSql.push(this.timeRollupContribution(rollup.table, rollup.bucket, rollup.expr('NEW.start_time'), 'NEW', 1));
+      deleteSql.push(this.timeRollupContribution(rollup.table, rollup.bucket, oldBucket, 'OLD', -1), prune);
+      updateSql.push(
+        this.timeRollupContribution(rollup.table, rollup.bucket, oldBucket, 'OLD', -1),
+        this.timeRollupContribution(rollup.table, rollup.bucket, rollup.expr('NEW.start_time'), 'NEW', 1),
+        prune
+      );
+    }
+
+    this.db.exec(`
+      CREATE TRIGGER IF NOT EXISTS trg_time_entries_rollup_insert AFTER INSERT ON time_entries BEGIN
+        ${insertSql.join('\n')}
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_time_entries_rollup_delete AFTER DELETE ON time_entries BEGIN
+        ${deleteSql.join('\n')}
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_time_entries_rollup_update AFTER UPDATE ON time_entries BEGIN
+        ${updateSql.join('\n')}
+      END;
+    `);
+
+    if (needsBackfill) {
+      console.log('[Database] Backfilling time rollups...');
+      this.getDb().transaction(() => this.rebuildTimeRollups())();
+    }
+  }
+
+  /**
+   * Trigger statement adding (sign 1) or removing (sign -1) one entry's
+   * contribution to its rollup bucket; a no-op for running entries
+   */
+  private timeRollupContribution(table: string, bucket: string, bucketExpr: string, row: 'NEW' | 'OLD', sign: 1 | -1): string {
+    const seconds = `${sign} * COALESCE(${row}.duration, 0)`;
+    return `
+        INSERT INTO ${table} (${bucket}, user_id, task_id, entries_count, total_seconds, billable_seconds, earnings)
+        SELECT
+          ${bucketExpr}, ${row}.user_id, ${row}.task_id, ${sign},
+          ${seconds},
+          CASE WHEN ${row}.is_billable = 1 THEN ${seconds} ELSE 0 END,
+          CASE WHEN ${row}.is_billable = 1 THEN (${seconds} / 3600.0) * COALESCE(${row}.hourly_rate, 0) ELSE 0 END
+        WHERE ${row}.end_time IS NOT NULL
+        ON CONFLICT(${bucket}, user_id, task_id) DO UPDATE SET
+          entries_count = entries_count + excluded.entries_count,
+          total_seconds = total_seconds + excluded.total_seconds,
+          billable_seconds = billable_seconds + excluded.billable_seconds,
+          earnings = earnings + excluded.earnings;`;
+  }
+
+  /**
+   * Recompute the time rollups from time_entries (caller owns the transaction)
+   */
+  private rebuildTimeRollups(): void {
+    const db = this.getDb();
+    for (const rollup of TIME_ROLLUPS) {
+      db.exec(`
+        DELETE FROM ${rollup.table};
+        INSERT INTO ${rollup.table} (${rollup.bucket}, user_id, task_id, entries_count, total_seconds, billable_seconds, earnings)
+        SELECT
+          ${rollup.expr('start_time')}, user_id, task_id, COUNT(*),
+          COALESCE(SUM(duration), 0),
+          COALESCE(SUM(CASE WHEN is_billable = 1 THEN duration ELSE 0 END), 0),
+          COALESCE(SUM(CASE WHEN is_billable = 1 THEN (duration / 3600.0) * COALESCE(hourly_rate, 0) ELSE 0 END), 0)
+        FROM time_entries
+        WHERE end_time IS NOT NULL
+        GROUP BY 1, user_id, task_id;
+      `);
+    }
+  }
+
+  /**
+   * Rebuild the full-text search index for tasks and comments from the
+   * base tables (audit_logs_fts is owned by AuditLogger)
+   */
+  public rebuildSearchIndex(): void {
+    const db = this.getDb();
+    db.transaction(() => {
+      db.exec(`
+        INSERT INTO tasks_fts(tasks_fts) VALUES ('rebuild');
+        INSERT INTO comments_fts(comments_fts) VALUES ('rebuild');
+      `);
+    })();
+  }
+
+  /**
+   * Create FTS5 external-content indexes over tasks and comments. The index
+   * stores only tokens; text is read from the base tables, and triggers
+   * keep the two in step.
+   */
+  private createSearchIndex(): void {
+    if (!this.db) return;
+
+    const needsBackfill = !this.db
+      .prepare("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'tasks_fts'")
+      .get();
+
+    this.db.exec(`
+      CREATE VIRTUAL TABLE IF NOT EXISTS tasks_fts USING fts5(
+        title, description,
+        content = 'tasks', content_rowid = 'id',
+        tokenize = 'unicode61 remove_diacritics 2'
+      );
+
+      CREATE VIRTUAL TABLE IF NOT EXISTS comments_fts USING fts5(
+        content,
+        content = 'comments', content_rowid = 'id',
+        tokenize = 'unicode61 remove_diacritics 2'
+      );
+
+      CREATE TRIGGER IF NOT EXISTS trg_tasks_fts_insert AFTER INSERT ON tasks BEGIN
+        INSERT INTO tasks_fts(rowid, title, description) VALUES (NEW.id, NEW.title, NEW.description);
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_tasks_fts_delete AFTER DELETE ON tasks BEGIN
+        INSERT INTO tasks_fts(tasks_fts, rowid, title, description) VALUES ('delete', OLD.id, OLD.title, OLD.description);
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_tasks_fts_update AFTER UPDATE OF title, description ON tasks BEGIN
+        INSERT INTO tasks_fts(tasks_fts, rowid, title, description) VALUES ('delete', OLD.id, OLD.title, OLD.description);
+        INSERT INTO tasks_fts(rowid, title, description) VALUES (NEW.id, NEW.title, NEW.description);
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_comments_fts_insert AFTER INSERT ON comments BEGIN
+        INSERT INTO comments_fts(rowid, content) VALUES (NEW.id, NEW.content);
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_comments_fts_delete AFTER DELETE ON comments BEGIN
+        INSERT INTO comments_fts(comments_fts, rowid, content) VALUES ('delete', OLD.id, OLD.content);
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_comments_fts_update AFTER UPDATE OF content ON comments BEGIN
+        INSERT INTO comments_fts(comments_fts, rowid, content) VALUES ('delete', OLD.id, OLD.content);
+        INSERT INTO comments_fts(rowid, content) VALUES (NEW.id, NEW.content);
+      END;
+    `);
+
+    if (needsBackfill) {
+      console.log('[Database] Building search index...');
+      this.rebuildSearchIndex();
+    }
+  }
+
+  /**
+   * Record every mutation of renderer-visible entities in change_log. The
+   * AUTOINCREMENT key is the change-feed version, so versions never repeat
+   * even after old entries are pruned. Triggers also see cascaded deletes
+   * and writes made outside IPC handlers (automation, API server).
+   */
+  private createChangeLog(): void {
+    if (!this.db) return;
+
+    this.db.exec(`
+      CREATE TABLE IF NOT EXISTS change_log (
+        version INTEGER PRIMARY KEY AUTOINCREMENT,
+        entity TEXT NOT NULL,
+        entity_id INTEGER NOT NULL,
+        project_id INTEGER,
+        op TEXT NOT NULL
+      );
+
+      CREATE TRIGGER IF NOT EXISTS trg_projects_changes_insert AFTER INSERT ON projects BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('project', NEW.id, NEW.id, 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_projects_changes_update AFTER UPDATE ON projects BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('project', NEW.id, NEW.id, 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_projects_changes_delete AFTER DELETE ON projects BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('project', OLD.id, OLD.id, 'delete');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_tasks_changes_insert AFTER INSERT ON tasks BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('task', NEW.id, NEW.project_id, 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_tasks_changes_update AFTER UPDATE ON tasks BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('task', NEW.id, NEW.project_id, 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_tasks_changes_delete AFTER DELETE ON tasks BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('task', OLD.id, OLD.project_id, 'delete');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_labels_changes_insert AFTER INSERT ON labels BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('label', NEW.id, NEW.project_id, 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_labels_changes_update AFTER UPDATE ON labels BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('label', NEW.id, NEW.project_id, 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_labels_changes_delete AFTER DELETE ON labels BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('label', OLD.id, OLD.project_id, 'delete');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_comments_changes_insert AFTER INSERT ON comments BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('comment', NEW.id, (SELECT project_id FROM tasks WHERE id = NEW.task_id), 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_comments_changes_update AFTER UPDATE ON comments BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('comment', NEW.id, (SELECT project_id FROM tasks WHERE id = NEW.task_id), 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_comments_changes_delete AFTER DELETE ON comments BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('comment', OLD.id, (SELECT project_id FROM tasks WHERE id = OLD.task_id), 'delete');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_project_members_changes_insert AFTER INSERT ON project_members BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('projectMember', NEW.id, NEW.project_id, 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_project_members_changes_update AFTER UPDATE ON project_members BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('projectMember', NEW.id, NEW.project_id, 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_project_members_changes_delete AFTER DELETE ON project_members BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op) VALUES ('projectMember', OLD.id, OLD.project_id, 'delete');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_task_labels_changes_insert AFTER INSERT ON task_labels BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op)
+        VALUES ('taskLabels', NEW.task_id, (SELECT project_id FROM tasks WHERE id = NEW.task_id), 'upsert');
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_task_labels_changes_delete AFTER DELETE ON task_labels BEGIN
+        INSERT INTO change_log (entity, entity_id, project_id, op)
+        VALUES ('taskLabels', OLD.task_id, (SELECT project_id FROM tasks WHERE id = OLD.task_id), 'upsert');
+      END;
     `);
   }
 }
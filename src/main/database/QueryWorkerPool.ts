@@ -0,0 +1,328 @@
+import * as fs from 'fs';
+import * as path from 'path';
+import { Worker } from 'worker_threads';
+import { ReportPriority } from '../models/Report';
+import { QueryJobName, QueryJobs } from './queryJobs';
+import type { QueryWorkerData, QueryWorkerReply } from './queryWorker';
+
+export interface QueryRunOptions {
+  priority?: ReportPriority;
+  requestId?: string; // lets the caller cancel the job with cancel()
+}
+
+export interface QueryWorkerPoolOptions {
+  dbPath: string;
+  size: number; // worker threads; 0 runs every job on the calling thread
+  cacheSizeMb: number;
+  mmapSizeMb: number;
+  fallbackJobs: QueryJobs; // main-thread jobs used when workers are unavailable
+}
+
+export interface QueryWorkerPoolStats {
+  workers: number;
+  busy: number;
+  queued: number;
+  completed: number;
+  failed: number;
+  cancelled: number;
+  inProcess: boolean;
+}
+
+interface QueuedJob {
+  id: number;
+  job: QueryJobName;
+  args: unknown[];
+  priority: number;
+  requestId?: string;
+  resolve: (value: any) => void;
+  reject: (error: Error) => void;
+}
+
+interface PoolWorker {
+  worker: Worker;
+  current: QueuedJob | null;
+  ready: boolean; // connection opened; only ready workers are given jobs
+  startupFailures: number; // consecutive workers in this slot that died before ready
+}
+
+const PRIORITY_ORDER: Record<ReportPriority, number> = { high: 0, normal: 1, low: 2 };
+
+// A slot whose workers keep dying before they are ready is respawned with
+// exponential backoff; after MAX_STARTUP_FAILURES the pool runs in-process
+const MAX_STARTUP_FAILURES = 5;
+const RESPAWN_BASE_DELAY_MS = 100;
+const RESPAWN_MAX_DELAY_MS = 10 * 1000;
+
+/**
+ * Error raised for jobs removed with cancel() or by close()
+ */
+export class QueryCancelledError extends Error {
+  constructor(job: string) {
+    super(`Query cancelled: ${job}`);
+    this.name = 'QueryCancelledError';
+  }
+}
+
+/**
+ * QueryWorkerPool - Runs long read-only report queries on worker threads,
+ * each with its own read-only WAL connection, so the main process stays
+ * responsive to IPC while a report is computed. Writes never go through
+ * the pool.
+ *
+ * Jobs are dispatched by priority and then in submission order. A queued
+ * job is cancelled by dropping it; a running one by terminating its
+ * worker, which is then replaced. Workers that cannot start (e.g. the
+ * database cannot be opened) are retried with backoff, then the pool
+ * falls back to running jobs in-process.
+ */
+export class QueryWorkerPool {
+  private workers: PoolWorker[] = [];
+  private queue: QueuedJob[] = [];
+  private nextId = 1;
+  private inProcess: boolean;
+  private closed = false;
+  private completed = 0;
+  private failed = 0;
+  private cancelled = 0;
+  private respawnTimers = new Set<NodeJS.Timeout>();
+
+  constructor(private options: QueryWorkerPoolOptions) {
+    // Worker script is only present in compiled output (not under ts-node)
+    const script = this.workerScript();
+    this.inProcess = options.size <= 0 || !fs.existsSync(script) || fs.statSync(script).size === 0;
+
+    if (!this.inProcess) {
+      for (let i = 0; i < options.size; i++) {
+        this.workers.push(this.spawn());
+      }
+    }
+    console.log(`[QueryWorkerPool] ${this.inProcess ? 'Running queries in-process' : `Started ${options.size} query workers`}`);
+  }
+
+  /**
+   * Run a query job, resolving with its result
+   */
+  run<K extends QueryJobName>(
+    job: K,
+    args: Parameters<QueryJobs[K]>,
+    options: QueryRunOptions = {}
+  ): Promise<ReturnType<QueryJobs[K]>> {
+    if (this.closed) {
+      return Promise.reject(new Error('Query pool is closed'));
+    }
+
+    if (this.inProcess) {
+      return this.runInProcess(job, args);
+    }
+
+    return new Promise((resolve, reject) => {
+      const queued: QueuedJob = {
+        id: this.nextId++,
+        job,
+        args,
+        priority: PRIORITY_ORDER[options.priority ?? 'normal'] ?? PRIORITY_ORDER.normal,
+        requestId: options.requestId,
+        resolve,
+        reject,
+      };
+
+      // Keep the queue sorted by priority; ids preserve submission order within one
+      let index = this.queue.length;
+      while (index > 0 && this.queue[index - 1].priority > queued.priority) index--;
+      this.queue.splice(index, 0, queued);
+      this.dispatch();
+    });
+  }
+
+  /**
+   * Cancel every queued or running job submitted with `requestId`.
+   * Returns the number of jobs cancelled.
+   */
+  cancel(requestId: string): number {
+    let count = 0;
+
+    this.queue = this.queue.filter(queued => {
+      if (queued.requestId !== requestId) return true;
+      queued.reject(new QueryCancelledError(queued.job));
+      count++;
+      return false;
+    });
+
+    for (let i = 0; i < this.workers.length; i++) {
+      const entry = this.workers[i];
+      if (entry.current?.requestId !== requestId) continue;
+      const running = entry.current;
+      entry.current = null;
+      running.reject(new QueryCancelledError(running.job));
+      count++;
+      // SQLite cannot be interrupted from another thread; drop the worker instead
+      entry.worker.removeAllListeners();
+      entry.worker.terminate();
+      this.workers[i] = this.spawn();
+    }
+
+    this.cancelled += count;
+    this.dispatch();
+    return count;
+  }
+
+  getStats(): QueryWorkerPoolStats {
+    return {
+      workers: this.workers.length,
+      busy: this.workers.filter(entry => entry.current).length,
+      queued: this.queue.length,
+      completed: this.completed,
+      failed: this.failed,
+      cancelled: this.cancelled,
+      inProcess: this.inProcess,
+    };
+  }
+
+  /**
+   * Reject outstanding jobs and stop all workers
+   */
+  async close(): Promise<void> {
+    this.closed = true;
+    this.respawnTimers.forEach(timer => clearTimeout(timer));
+    this.respawnTimers.clear();
+    for (const queued of this.queue) {
+      queued.reject(new QueryCancelledError(queued.job));
+    }
+    this.queue = [];
+
+    const workers = this.workers;
+    this.workers = [];
+    await Promise.all(workers.map(entry => {
+      entry.current?.reject(new QueryCancelledError(entry.current.job));
+      entry.worker.removeAllListeners();
+      return entry.worker.terminate();
+    }));
+  }
+
+  private workerScript(): string {
+    return path.join(__dirname, 'queryWorker.js');
+  }
+
+  private runInProcess(job: QueryJobName, args: unknown[]): Promise<any> {
+    try {
+      const fn = this.options.fallbackJobs[job] as (...jobArgs: unknown[]) => unknown;
+      const result = fn(...args);
+      this.completed++;
+      return Promise.resolve(result);
+    } catch (error) {
+      this.failed++;
+      return Promise.reject(error);
+    }
+  }
+
+  private spawn(startupFailures = 0): PoolWorker {
+    const workerData: QueryWorkerData = {
+      dbPath: this.options.dbPath,
+      cacheSizeMb: this.options.cacheSizeMb,
+      mmapSizeMb: this.options.mmapSizeMb,
+    };
+    const entry: PoolWorker = {
+      worker: new Worker(this.workerScript(), { workerData }),
+      current: null,
+      ready: false,
+      startupFailures,
+    };
+
+    entry.worker.on('message', (reply: QueryWorkerReply) => {
+      if (reply.ready) {
+        entry.ready = true;
+        entry.startupFailures = 0;
+        this.dispatch();
+        return;
+      }
+      const running = entry.current;
+      if (!running || running.id !== reply.id) return;
+      entry.current = null;
+      if (reply.error !== undefined) {
+        this.failed++;
+        running.reject(new Error(reply.error));
+      } else {
+        this.completed++;
+        running.resolve(reply.result);
+      }
+      this.dispatch();
+    });
+
+    const replace = (error: Error) => {
+      console.error('[QueryWorkerPool] Query worker exited:', error);
+      const running = entry.current;
+      entry.current = null;
+      if (running) {
+        this.failed++;
+        running.reject(error);
+      }
+      entry.worker.removeAllListeners();
+      const index = this.workers.indexOf(entry);
+      if (index === -1 || this.closed) return;
+
+      if (entry.ready) {
+        this.workers[index] = this.spawn();
+        this.dispatch();
+        return;
+      }
+
+      // Died before opening its connection; the dead entry keeps the slot
+      // (never ready, so never dispatched to) until the backoff elapses
+      const failures = entry.startupFailures + 1;
+      if (failures >= MAX_STARTUP_FAILURES) {
+        this.fallBackInProcess();
+        return;
+      }
+      entry.startupFailures = failures;
+      const delay = Math.min(RESPAWN_BASE_DELAY_MS * 2 ** (failures - 1), RESPAWN_MAX_DELAY_MS);
+      const timer = setTimeout(() => {
+        this.respawnTimers.delete(timer);
+        const slot = this.workers.indexOf(entry);
+        if (slot !== -1 && !this.closed && !this.inProcess) {
+          this.workers[slot] = this.spawn(failures);
+        }
+      }, delay);
+      timer.unref();
+      this.respawnTimers.add(timer);
+    };
+    entry.worker.on('error', replace);
+    entry.worker.on('exit', code => replace(new Error(`Query worker exited with code ${code}`)));
+
+    return entry;
+  }
+
+  /**
+   * Stop every worker and run queued and future jobs on this thread
+   */
+  private fallBackInProcess(): void {
+    console.error(`[QueryWorkerPool] Query workers failed to start ${MAX_STARTUP_FAILURES} times; running queries in-process`);
+    this.inProcess = true;
+    this.respawnTimers.forEach(timer => clearTimeout(timer));
+    this.respawnTimers.clear();
+
+    const workers = this.workers;
+    this.workers = [];
+    for (const entry of workers) {
+      entry.worker.removeAllListeners();
+      entry.worker.terminate();
+      // A job on a worker still running is lost with it; rerun it here
+      if (entry.current) this.queue.unshift(entry.current);
+    }
+
+    const queued = this.queue;
+    this.queue = [];
+    for (const job of queued) {
+      this.runInProcess(job.job, job.args).then(job.resolve, job.reject);
+    }
+  }
+
+  private dispatch(): void {
+    for (const entry of this.workers) {
+      if (this.queue.length === 0) return;
+      if (entry.current || !entry.ready) continue;
+      const queued = this.queue.shift()!;
+      entry.current = queued;
+      entry.worker.postMessage({ id: queued.id, job: queued.job, args: queued.args });
+    }
+  }
+}
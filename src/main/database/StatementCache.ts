@@ -0,0 +1,190 @@
+import Database from 'better-sqlite3';
+import { performance } from 'perf_hooks';
+
+/**
+ * Statement cache counters, exposed for diagnostics
+ */
+export interface StatementCacheStats {
+  size: number;
+  maxSize: number;
+  hits: number;
+  misses: number;
+  evictions: number;
+}
+
+export const DEFAULT_STATEMENT_CACHE_SIZE = 256;
+
+/**
+ * Receives timings of statements served by prepareCached while installed
+ * (see setStatementObserver). sample() decides per execution whether to time it.
+ */
+export interface StatementObserver {
+  sample(): boolean;
+  record(sql: string, startedAt: number, durationMs: number, rows: number): void;
+}
+
+let observer: StatementObserver | null = null;
+
+/**
+ * Install (or with null, remove) the statement observer. Without one,
+ * prepareCached hands out the plain compiled statements.
+ */
+export function setStatementObserver(next: StatementObserver | null): void {
+  observer = next;
+}
+
+interface CachedStatement {
+  stmt: Database.Statement;
+  observed?: Database.Statement; // timing wrapper, built on first use with an observer
+}
+
+/**
+ * LRU cache of compiled statements for one connection, keyed by SQL text.
+ * Map iteration order is insertion order, so the first key is always the
+ * least recently used one.
+ */
+export class StatementCache {
+  private statements = new Map<string, CachedStatement>();
+  private hits = 0;
+  private misses = 0;
+  private evictions = 0;
+
+  constructor(private conn: Database.Database, private maxSize = DEFAULT_STATEMENT_CACHE_SIZE) {}
+
+  /**
+   * Get a compiled statement, preparing and caching it on first use
+   */
+  get(sql: string): Database.Statement {
+    const cached = this.statements.get(sql);
+    if (cached) {
+      this.hits++;
+      // Re-insert to mark as most recently used
+      this.statements.delete(sql);
+      this.statements.set(sql, cached);
+      return observer ? (cached.observed ??= observeStatement(cached.stmt, sql)) : cached.stmt;
+    }
+
+    this.misses++;
+    const stmt = this.conn.prepare(sql);
+    if (this.maxSize <= 0) {
+      return observer ? observeStatement(stmt, sql) : stmt;
+    }
+
+    const entry: CachedStatement = { stmt };
+    this.statements.set(sql, entry);
+    if (this.statements.size > this.maxSize) {
+      const oldest = this.statements.keys().next().value as string;
+      this.statements.delete(oldest);
+      this.evictions++;
+    }
+    return observer ? (entry.observed = observeStatement(stmt, sql)) : stmt;
+  }
+
+  /**
+   * Change the LRU bound, evicting immediately if the cache shrinks
+   */
+  resize(maxSize: number): void {
+    this.maxSize = maxSize;
+    while (this.statements.size > Math.max(0, maxSize)) {
+      const oldest = this.statements.keys().next().value as string;
+      this.statements.delete(oldest);
+      this.evictions++;
+    }
+  }
+
+  /**
+   * Drop all cached statements (e.g. before closing the connection)
+   */
+  clear(): void {
+    this.statements.clear();
+  }
+
+  getStats(): StatementCacheStats {
+    return {
+      size: this.statements.size,
+      maxSize: this.maxSize,
+      hits: this.hits,
+      misses: this.misses,
+      evictions: this.evictions,
+    };
+  }
+}
+
+// One cache per connection. Keyed weakly so closed connections are collected.
+const caches = new WeakMap<Database.Database, StatementCache>();
+
+/**
+ * Get (or lazily create) the statement cache for a connection
+ */
+export function getStatementCache(conn: Database.Database, maxSize?: number): StatementCache {
+  let cache = caches.get(conn);
+  if (!cache) {
+    cache = new StatementCache(conn, maxSize);
+    caches.set(conn, cache);
+  } else if (maxSize !== undefined) {
+    cache.resize(maxSize);
+  }
+  return cache;
+}
+
+/**
+ * Wrap a statement so run/get/all/iterate report to the current observer.
+ * Other members pass through to the compiled statement. An iterate() span
+ * lasts until the caller finishes iterating.
+ */
+function observeStatement(stmt: Database.Statement, sql: string): Database.Statement {
+  const timed = (method: 'run' | 'get' | 'all', rows: (result: any) => number) =>
+    (...params: unknown[]) => {
+      const current = observer;
+      if (!current || !current.sample()) return (stmt[method] as Function).apply(stmt, params);
+      const started = performance.now();
+      const result = (stmt[method] as Function).apply(stmt, params);
+      current.record(sql, started, performance.now() - started, rows(result));
+      return result;
+    };
+
+  const wrappers: Record<string, unknown> = {
+    run: timed('run', (result: Database.RunResult) => result.changes),
+    get: timed('get', result => (result === undefined ? 0 : 1)),
+    all: timed('all', (result: unknown[]) => result.length),
+    iterate: (...params: unknown[]) => {
+      const current = observer;
+      const iterator = stmt.iterate(...params);
+      if (!current || !current.sample()) return iterator;
+      return observeIterator(iterator, current, sql);
+    },
+  };
+
+  return new Proxy(stmt, {
+    get(target, prop) {
+      if (typeof prop === 'string' && prop in wrappers) return wrappers[prop];
+      const value = Reflect.get(target, prop, target);
+      return typeof value === 'function' ? value.bind(target) : value;
+    },
+  });
+}
+
+function* observeIterator(
+  iterator: IterableIterator<unknown>, current: StatementObserver, sql: string
+): IterableIterator<unknown> {
+  const started = performance.now();
+  let rows = 0;
+  try {
+    for (const row of iterator) {
+      rows++;
+      yield row;
+    }
+  } finally {
+    current.record(sql, started, performance.now() - started, rows);
+  }
+}
+
+/**
+ * Drop-in replacement for conn.prepare(sql) that reuses compiled statements.
+ *
+ * Cached statements are shared, so callers must not switch them into
+ * pluck/raw/expand mode or hold an iterator open across calls.
+ */
+export function prepareCached(conn: Database.Database, sql: string): Database.Statement {
+  return getStatementCache(conn).get(sql);
+}
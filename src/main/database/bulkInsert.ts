@@ -0,0 +1,55 @@
+import Database from 'better-sqlite3';
+import { prepareCached } from './StatementCache';
+
+// Rows per multi-row INSERT; also capped so rows * columns stays under
+// SQLite's default limit of 32766 bound parameters
+const MAX_ROWS_PER_INSERT = 500;
+const MAX_PARAMETERS = 32766;
+
+/**
+ * Multi-row INSERT helpers for bulk writes. Callers run them inside a
+ * transaction; SQL identifiers are trusted, values are always bound.
+ */
+
+/**
+ * First id an AUTOINCREMENT table will hand out next. Inside an immediate
+ * transaction the caller can assign ids nextRowId .. nextRowId + n - 1
+ * itself and remap references without reading rows back; inserting an
+ * explicit id advances sqlite_sequence as usual.
+ */
+export function nextRowId(db: Database.Database, table: string): number {
+  const row = prepareCached(db, `
+    SELECT MAX(
+      COALESCE((SELECT seq FROM sqlite_sequence WHERE name = ?), 0),
+      COALESCE((SELECT MAX(id) FROM ${table}), 0)
+    ) + 1 AS next
+  `).get(table) as { next: number };
+  return row.next;
+}
+
+/**
+ * Insert `rows` (values in `columns` order) with as few statements as the
+ * parameter limit allows. Returns the number of rows inserted.
+ */
+export function insertRows(
+  db: Database.Database,
+  table: string,
+  columns: string[],
+  rows: unknown[][],
+  conflict: 'ABORT' | 'IGNORE' = 'ABORT'
+): number {
+  const perInsert = Math.max(1, Math.min(MAX_ROWS_PER_INSERT, Math.floor(MAX_PARAMETERS / columns.length)));
+  const tuple = `(${columns.map(() => '?').join(', ')})`;
+  let inserted = 0;
+
+  for (let start = 0; start < rows.length; start += perInsert) {
+    const chunk = rows.slice(start, start + perInsert);
+    // Full chunks share one cached statement; only the tail differs
+    const stmt = prepareCached(db, `
+      INSERT OR ${conflict} INTO ${table} (${columns.join(', ')})
+      VALUES ${chunk.map(() => tuple).join(', ')}
+    `);
+    inserted += stmt.run(...chunk.flat()).changes;
+  }
+  return inserted;
+}
@@ -0,0 +1,66 @@
+import Database from 'better-sqlite3';
+
+/**
+ * Brings a schema from `fromVersion` (0 for a database that predates
+ * versioning or lacks the schema) to the current version
+ */
+export type Migration = (fromVersion: number) => void;
+
+/**
+ * Schema versioning.
+ *
+ * The core schema (DevTrackDatabase) is versioned with PRAGMA user_version,
+ * so a current database costs one pragma read at startup instead of
+ * re-running every CREATE ... IF NOT EXISTS. Feature modules that own tables
+ * (security, audit, integrations, ...) are created lazily and independently,
+ * so each records its own version in schema_versions.
+ *
+ * Schema steps in this codebase are idempotent (IF NOT EXISTS, column checks
+ * before ALTER), so a migration may simply re-run its module's DDL; the
+ * version it comes from is passed for changes that are not. Bump a version
+ * whenever the matching DDL changes.
+ */
+export function migrateCoreSchema(db: Database.Database, version: number, migrate: Migration): boolean {
+  const current = db.pragma('user_version', { simple: true }) as number;
+  if (current >= version) return false;
+
+  const started = Date.now();
+  db.transaction(() => {
+    migrate(current);
+    db.exec(`
+      CREATE TABLE IF NOT EXISTS schema_versions (
+        module TEXT PRIMARY KEY,
+        version INTEGER NOT NULL,
+        migrated_at DATETIME NOT NULL DEFAULT CURRENT_TIMESTAMP
+      );
+    `);
+    db.pragma(`user_version = ${version}`);
+  })();
+  console.log(`[Migrations] Core schema ${current} -> ${version} in ${Date.now() - started}ms`);
+  return true;
+}
+
+/**
+ * Run `migrate` unless `module` is already at `version`. Read-only
+ * connections (query workers) rely on the writer's schema and are skipped.
+ */
+export function migrateModuleSchema(db: Database.Database, module: string, version: number, migrate: Migration): boolean {
+  if (db.readonly) return false;
+
+  const row = db.prepare('SELECT version FROM schema_versions WHERE module = ?').get(module) as
+    | { version: number }
+    | undefined;
+  const current = row?.version ?? 0;
+  if (current >= version) return false;
+
+  const started = Date.now();
+  db.transaction(() => {
+    migrate(current);
+    db.prepare(`
+      INSERT INTO schema_versions (module, version) VALUES (?, ?)
+      ON CONFLICT(module) DO UPDATE SET version = excluded.version, migrated_at = CURRENT_TIMESTAMP
+    `).run(module, version);
+  })();
+  console.log(`[Migrations] ${module} schema ${current} -> ${version} in ${Date.now() - started}ms`);
+  return true;
+}
@@ -0,0 +1,54 @@
+import * as path from 'path';
+import { TaskColumns, TASK_STATUS_VALUES, TASK_PRIORITY_VALUES } from '../models/Task';
+import { ProjectColumns } from '../models/Project';
+
+// Must match kApiVersion in src/native/bindings/init.cpp
+const NATIVE_API_VERSION = 1;
+
+// node-gyp output, relative to dist/main/database
+const ADDON_PATH = path.join(__dirname, '..', '..', '..', 'build', 'Release', 'devtrack_core.node');
+
+/**
+ * Read paths served by the devtrack_core addon (src/native). Results have
+ * exactly the layout of the TypeScript columnar methods.
+ */
+export interface NativeCore {
+  findTasksByProjectIdColumnar(projectId: number): TaskColumns;
+  findAllProjectsColumnar(): ProjectColumns;
+  close(): void;
+}
+
+interface DevtrackCoreAddon extends NativeCore {
+  apiVersion: number;
+  open(dbPath: string, options: { taskStatuses: string[]; taskPriorities: string[] }): void;
+}
+
+/**
+ * Load devtrack_core and open its read-only connection to `dbPath`.
+ * Returns null when the addon is not built, was built for another API
+ * version or cannot open the database; callers then keep using the
+ * TypeScript repositories.
+ */
+export function openNativeCore(dbPath: string): NativeCore | null {
+  let addon: DevtrackCoreAddon;
+  try {
+    addon = require(ADDON_PATH);
+  } catch {
+    console.log('[NativeCore] devtrack_core is not built; using TypeScript repositories');
+    return null;
+  }
+
+  if (addon.apiVersion !== NATIVE_API_VERSION) {
+    console.warn(`[NativeCore] devtrack_core API ${addon.apiVersion} does not match ${NATIVE_API_VERSION}; rebuild it with npm run build:native`);
+    return null;
+  }
+
+  try {
+    addon.open(dbPath, { taskStatuses: TASK_STATUS_VALUES, taskPriorities: TASK_PRIORITY_VALUES });
+  } catch (error) {
+    console.error('[NativeCore] Failed to open devtrack_core:', error);
+    return null;
+  }
+  console.log('[NativeCore] devtrack_core loaded');
+  return addon;
+}
@@ -0,0 +1,59 @@
+import Database from 'better-sqlite3';
+import { AnalyticsService } from '../services/AnalyticsService';
+import { AuditLogger } from '../services/AuditLogger';
+import { ComplianceManager } from '../services/ComplianceManager';
+import { DateRange, ReportFilters } from '../models/Report';
+import { AuditFilters } from '../models/AuditLog';
+
+/**
+ * Read-only services a query job may use
+ */
+export interface QueryJobServices {
+  analytics: AnalyticsService;
+  audit: AuditLogger;
+  compliance: ComplianceManager;
+}
+
+/**
+ * Long-running, read-only service methods that can run off the main
+ * thread. The same table backs the worker threads and the in-process
+ * fallback, so both always expose identical jobs. Services are looked up
+ * per call, so the main process can pass lazily created ones.
+ */
+export function createQueryJobs(services: QueryJobServices) {
+  return {
+    'analytics.getTaskStatusReport': (filters?: ReportFilters) => services.analytics.getTaskStatusReport(filters),
+    'analytics.getTaskPriorityReport': (filters?: ReportFilters) => services.analytics.getTaskPriorityReport(filters),
+    'analytics.getProjectProgressReport': (projectIds?: number[]) => services.analytics.getProjectProgressReport(projectIds),
+    'analytics.getUserWorkloadReport': (userIds?: number[]) => services.analytics.getUserWorkloadReport(userIds),
+    'analytics.getTimeTrackingReport': (dateRange?: DateRange, filters?: ReportFilters) =>
+      services.analytics.getTimeTrackingReport(dateRange, filters),
+    'analytics.getTaskCompletionTrend': (dateRange?: DateRange, projectId?: number) =>
+      services.analytics.getTaskCompletionTrend(dateRange, projectId),
+    'analytics.getProjectStatistics': () => services.analytics.getProjectStatistics(),
+    'analytics.getUserStatistics': () => services.analytics.getUserStatistics(),
+    'analytics.getTimeStatistics': (dateRange?: DateRange) => services.analytics.getTimeStatistics(dateRange),
+    'audit.query': (filters?: AuditFilters) => services.audit.query(filters),
+    'audit.generateReport': (filters?: { startDate?: string; endDate?: string }) => services.audit.generateReport(filters),
+    'audit.generateComplianceReport': (period?: { start?: string; end?: string }) =>
+      services.audit.generateComplianceReport(period),
+    'audit.exportToJson': (filters?: AuditFilters) => services.audit.exportToJson(filters),
+    'audit.exportToCsv': (filters?: AuditFilters) => services.audit.exportToCsv(filters),
+    'compliance.getComplianceDashboardStats': () => services.compliance.getComplianceDashboardStats(),
+  };
+}
+
+export type QueryJobs = ReturnType<typeof createQueryJobs>;
+export type QueryJobName = keyof QueryJobs;
+
+/**
+ * Services over a read-only connection, as used inside a query worker.
+ * Table creation is skipped for read-only connections by each service.
+ */
+export function createReadOnlyServices(conn: Database.Database): QueryJobServices {
+  return {
+    analytics: new AnalyticsService(conn),
+    audit: new AuditLogger(conn, conn, { mode: 'immediate' }),
+    compliance: new ComplianceManager(conn),
+  };
+}
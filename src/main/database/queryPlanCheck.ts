@@ -0,0 +1,156 @@
+import Database from 'better-sqlite3';
+import { AuditCategory, AuditFilters } from '../models/AuditLog';
+import { COLUMNAR_TASK_SQL, TASKS_BY_PROJECT_SQL, taskPageSql, tasksByStatusSql } from '../repositories/TaskRepository';
+import { COLUMNAR_PROJECT_SQL, PROJECTS_SQL, PROJECTS_BY_STATUS_SQL } from '../repositories/ProjectRepository';
+import { COMMENTS_BY_TASK_SQL } from '../repositories/CommentRepository';
+import { LABELS_BY_PROJECT_SQL } from '../repositories/LabelRepository';
+import { notificationsByUserSql, UNREAD_NOTIFICATION_COUNT_SQL } from '../repositories/NotificationRepository';
+import {
+  ACTIVE_TIME_ENTRY_SQL, TIME_ENTRIES_BY_TASK_SQL, TIME_ENTRIES_BY_USER_SQL, timeEntriesByDateRangeSql
+} from '../repositories/TimeEntryRepository';
+import { AUTOMATION_LOGS_BY_RULE_SQL, AUTOMATION_RULES_BY_PROJECT_SQL } from '../repositories/AutomationRuleRepository';
+import {
+  AUDIT_ENTITY_HISTORY_SQL, AUDIT_USER_ACTIVITY_SQL, auditCountBySql, buildAuditQuery
+} from '../services/AuditLogger';
+
+/**
+ * Plan shapes a case may legitimately use
+ */
+export type QueryPlanAllowance = 'scan' | 'temp-b-tree';
+
+/**
+ * One canonical repository query and sample parameters to plan it with
+ */
+export interface QueryPlanCase {
+  name: string;
+  sql: string;
+  params: unknown[];
+  allow?: QueryPlanAllowance[];
+}
+
+export interface QueryPlanFinding {
+  case: string;
+  kind: 'full-scan' | 'temp-b-tree';
+  detail: string;
+}
+
+export interface QueryPlanReport {
+  checked: number;
+  skipped: string[]; // cases whose tables do not exist (modules not created yet)
+  findings: QueryPlanFinding[];
+  plans: Record<string, string[]>;
+}
+
+const TIME_RANGE = ['2024-01-01T00:00:00.000Z', '2024-12-31T23:59:59.999Z'];
+const AUDIT_RANGE = { startDate: TIME_RANGE[0], endDate: TIME_RANGE[1] };
+
+/**
+ * The hot listing queries. SQL comes from the constants and builders the
+ * repositories and services prepare, so a case cannot drift from its source.
+ */
+export const QUERY_PLAN_CASES: QueryPlanCase[] = [
+  // TaskRepository
+  { name: 'tasks.findByProjectId', sql: TASKS_BY_PROJECT_SQL, params: [1] },
+  { name: 'tasks.findByProjectIdColumnar', sql: COLUMNAR_TASK_SQL, params: [1] },
+  {
+    name: 'tasks.findPageByProjectId',
+    sql: taskPageSql({ status: true, after: true }),
+    params: [1, 'todo', 0, TIME_RANGE[0], 1, 201],
+  },
+  { name: 'tasks.findByStatus', sql: tasksByStatusSql(false), params: ['todo'] },
+  { name: 'tasks.findByStatus(project)', sql: tasksByStatusSql(true), params: ['todo', 1] },
+  // ProjectRepository
+  { name: 'projects.findAll', sql: PROJECTS_SQL, params: [] },
+  { name: 'projects.findAllColumnar', sql: COLUMNAR_PROJECT_SQL, params: [] },
+  { name: 'projects.findByStatus', sql: PROJECTS_BY_STATUS_SQL, params: ['active'] },
+  // CommentRepository, LabelRepository
+  { name: 'comments.findByTaskId', sql: COMMENTS_BY_TASK_SQL, params: [1] },
+  { name: 'labels.findByProjectId', sql: LABELS_BY_PROJECT_SQL, params: [1] },
+  // NotificationRepository
+  { name: 'notifications.findByUserId', sql: notificationsByUserSql(false, 50), params: [1] },
+  { name: 'notifications.findUnreadByUserId', sql: notificationsByUserSql(true, 50), params: [1] },
+  { name: 'notifications.getUnreadCount', sql: UNREAD_NOTIFICATION_COUNT_SQL, params: [1] },
+  // TimeEntryRepository
+  { name: 'timeEntries.findByTaskId', sql: TIME_ENTRIES_BY_TASK_SQL, params: [1] },
+  { name: 'timeEntries.findByUserId', sql: TIME_ENTRIES_BY_USER_SQL, params: [1] },
+  { name: 'timeEntries.findActiveByUserId', sql: ACTIVE_TIME_ENTRY_SQL, params: [1] },
+  { name: 'timeEntries.findByDateRange(user)', sql: timeEntriesByDateRangeSql(true), params: [...TIME_RANGE, 1] },
+  // AutomationRuleRepository
+  { name: 'automationRules.findByProjectId', sql: AUTOMATION_RULES_BY_PROJECT_SQL, params: [1] },
+  { name: 'automationLogs.findByRuleId', sql: AUTOMATION_LOGS_BY_RULE_SQL, params: [1, 50] },
+  // AuditLogger
+  auditQueryCase('audit.query(category, range)', { category: AuditCategory.Security, ...AUDIT_RANGE }),
+  auditQueryCase('audit.query(range)', AUDIT_RANGE),
+  { name: 'audit.getEntityHistory', sql: AUDIT_ENTITY_HISTORY_SQL, params: ['task', 1, 50] },
+  { name: 'audit.getUserActivity', sql: AUDIT_USER_ACTIVITY_SQL, params: [1, 100] },
+  {
+    // Grouping a date range by category sorts the (few) groups; the range
+    // itself is read from a covering index
+    name: 'audit.generateReport(byCategory)',
+    sql: auditCountBySql('category', AUDIT_RANGE),
+    params: TIME_RANGE,
+    allow: ['temp-b-tree'],
+  },
+];
+
+/**
+ * A page of AuditLogger.query(), which appends LIMIT to buildAuditQuery
+ */
+function auditQueryCase(name: string, filters: AuditFilters): QueryPlanCase {
+  const { query, params } = buildAuditQuery(filters);
+  return { name, sql: `${query} LIMIT ?`, params: [...params, 100] };
+}
+
+// "SCAN tasks" or "SCAN tasks AS t"; index scans and virtual tables
+// (json_each, FTS) report more after the name
+const FULL_SCAN = /^SCAN (\S+)(?: AS \S+)?$/;
+const TEMP_B_TREE = /USE TEMP B-TREE/;
+
+/**
+ * Run EXPLAIN QUERY PLAN for each case and flag full-table scans and temp
+ * B-tree sorts the case does not allow. Cases over tables the database does
+ * not have are skipped.
+ */
+export function checkQueryPlans(db: Database.Database, cases: QueryPlanCase[] = QUERY_PLAN_CASES): QueryPlanReport {
+  const report: QueryPlanReport = { checked: 0, skipped: [], findings: [], plans: {} };
+
+  for (const planCase of cases) {
+    let details: string[];
+    try {
+      const rows = db.prepare(`EXPLAIN QUERY PLAN ${planCase.sql}`).all(...planCase.params) as Array<{ detail: string }>;
+      details = rows.map(row => row.detail);
+    } catch (error) {
+      if (error instanceof Error && /no such table/.test(error.message)) {
+        report.skipped.push(planCase.name);
+        continue;
+      }
+      throw error;
+    }
+
+    report.checked++;
+    report.plans[planCase.name] = details;
+    const allow = new Set(planCase.allow ?? []);
+    for (const detail of details) {
+      if (FULL_SCAN.test(detail) && !allow.has('scan')) {
+        report.findings.push({ case: planCase.name, kind: 'full-scan', detail });
+      } else if (TEMP_B_TREE.test(detail) && !allow.has('temp-b-tree')) {
+        report.findings.push({ case: planCase.name, kind: 'temp-b-tree', detail });
+      }
+    }
+  }
+
+  return report;
+}
+
+/**
+ * One line per finding, for logs and the CLI
+ */
+export function formatQueryPlanReport(report: QueryPlanReport): string {
+  const lines = [
+    `${report.checked} queries checked, ${report.skipped.length} skipped, ${report.findings.length} finding(s)`,
+  ];
+  for (const finding of report.findings) {
+    lines.push(`  ${finding.kind.padEnd(11)} ${finding.case}: ${finding.detail}`);
+  }
+  return lines.join('\n');
+}
@@ -0,0 +1,55 @@
+/**
+ * queryWorker.ts
+ *
+ * worker_threads entry point for QueryWorkerPool. Opens its own read-only
+ * connection and runs one query job at a time. Deliberately avoids
+ * Database.ts, which depends on Electron's main-process APIs.
+ */
+
+import { parentPort, workerData } from 'worker_threads';
+import Database from 'better-sqlite3';
+import { createQueryJobs, createReadOnlyServices, QueryJobName } from './queryJobs';
+
+export interface QueryWorkerData {
+  dbPath: string;
+  cacheSizeMb: number;
+  mmapSizeMb: number;
+}
+
+export interface QueryWorkerRequest {
+  id: number;
+  job: QueryJobName;
+  args: unknown[];
+}
+
+export interface QueryWorkerReply {
+  id: number; // 0 for the ready message
+  result?: unknown;
+  error?: string;
+  ready?: boolean; // sent once the connection is open and jobs can run
+}
+
+if (parentPort) {
+  const port = parentPort;
+  const { dbPath, cacheSizeMb, mmapSizeMb } = workerData as QueryWorkerData;
+
+  const conn = new Database(dbPath, { readonly: true, fileMustExist: true });
+  // Negative cache_size is interpreted by SQLite as KiB
+  conn.pragma(`cache_size = -${Math.max(0, Math.floor(cacheSizeMb * 1024))}`);
+  conn.pragma(`mmap_size = ${Math.max(0, Math.floor(mmapSizeMb * 1024 * 1024))}`);
+
+  const jobs = createQueryJobs(createReadOnlyServices(conn));
+  port.postMessage({ id: 0, ready: true } as QueryWorkerReply);
+
+  port.on('message', ({ id, job, args }: QueryWorkerRequest) => {
+    try {
+      const fn = jobs[job] as (...jobArgs: unknown[]) => unknown;
+      if (!fn) {
+        throw new Error(`Unknown query job: ${job}`);
+      }
+      port.postMessage({ id, result: fn(...args) } as QueryWorkerReply);
+    } catch (error) {
+      port.postMessage({ id, error: error instanceof Error ? error.message : String(error) } as QueryWorkerReply);
+    }
+  });
+}
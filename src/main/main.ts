@@ -1,9 +1,14 @@
-import { app, BrowserWindow, ipcMain, dialog } from 'electron';
+import { app, BrowserWindow, ipcMain, dialog, WebContents } from 'electron';
 import * as path from 'path';
 import * as fs from 'fs';
+import { Writable } from 'stream';
+import Database from 'better-sqlite3';
 import { getDatabase } from './database/Database';
 import { ProjectRepository } from './repositories/ProjectRepository';
 import { TaskRepository } from './repositories/TaskRepository';
+import {
+  TaskChange, TaskStatus, TaskPageOptions, TaskBulkUpdate, TaskMoveOptions, TaskLabelChanges, toTaskBulkResult
+} from './models/Task';
 import { CommentRepository } from './repositories/CommentRepository';
 import { LabelRepository } from './repositories/LabelRepository';
 import { AttachmentRepository } from './repositories/AttachmentRepository';
@@ -29,22 +34,38 @@ import { IntegrationManager } from './services/IntegrationManager';
 import { WhiteLabelManager } from './services/WhiteLabelManager';
 import { ComplianceManager } from './services/ComplianceManager';
 import { VisionBoardManager } from './services/VisionBoardManager';
+import { SearchService } from './services/SearchService';
+import { PermissionCache } from './services/PermissionCache';
+import { MetricsRegistry, instrumentIpcMain } from './services/MetricsRegistry';
+import { NotificationPipeline } from './services/NotificationPipeline';
+import { ChangeFeed } from './services/ChangeFeed';
+import { WebhookDispatcher } from './services/WebhookDispatcher';
+import { SearchOptions } from './models/Search';
+import { NotificationDelta } from './models/Notification';
+import { ReportRequestOptions } from './models/Report';
+import { ExportOptions, ExportRequest, ExportResult } from './models/Export';
+import { DiagnosticsSettings } from './models/Diagnostics';
+import { WebhookEvent } from './models/Integration';
+import { QueryWorkerPool } from './database/QueryWorkerPool';
+import { createQueryJobs, QueryJobName, QueryJobs } from './database/queryJobs';
+import { checkQueryPlans, formatQueryPlanReport } from './database/queryPlanCheck';
+import { openNativeCore, NativeCore } from './database/nativeCore';
 import { ApiServer } from './ApiServer';
 import { seedDatabase } from './utils/seed';
 import { seedRolesAndPermissions } from './utils/seedRolesAndPermissions';
 import { seedDefaultUser } from './utils/seedUser';
+import { lazy } from './utils/lazy';
+import { StreamExportOptions, exportToFile, openExportConnection } from './utils/streamingExport';
 import './utils/seed'; // Import to register IPC handlers
 
 let mainWindow: BrowserWindow | null = null;
 let apiServer: ApiServer | null = null;
 let settingsManager: SettingsManager;
-let securityManager: SecurityManager;
-let auditLogger: AuditLogger;
-let adminManager: AdminManager;
-let integrationManager: IntegrationManager;
-let whiteLabelManager: WhiteLabelManager;
-let complianceManager: ComplianceManager;
-let visionBoardManager: VisionBoardManager;
+
+// Created before any handler is registered so every ipcMain.handle below is
+// timed per channel; configured from settings once they are loaded
+const metrics = new MetricsRegistry();
+instrumentIpcMain(ipcMain, metrics);
 
 // Helper function to validate numeric IPC parameters
 function validateId(id: any, paramName = 'ID'): number {
@@ -54,8 +75,63 @@ function validateId(id: any, paramName = 'ID'): number {
   return id;
 }
 
+// Helper function to validate arrays of IDs passed to bulk handlers
+function validateIdList(ids: any, paramName = 'ID'): number[] {
+  if (!Array.isArray(ids)) {
+    throw new Error(`Invalid ${paramName} list: must be an array`);
+  }
+  return ids.map(id => validateId(id, paramName));
+}
+
+// Run a read-only report on the query pool. The owning module is created
+// first, since workers rely on the writer for its tables, and buffered
+// audit entries are flushed so worker connections see them. Audit compliance
+// reports also count failed logins from security_events, which
+// SecurityManager creates.
+function runReport<K extends QueryJobName>(
+  job: K,
+  args: Parameters<QueryJobs[K]>,
+  options?: ReportRequestOptions
+): Promise<ReturnType<QueryJobs[K]>> {
+  if (job.startsWith('audit.')) {
+    if (job === 'audit.generateComplianceReport') securityManager();
+    auditLogger().flush();
+  } else if (job.startsWith('compliance.')) {
+    complianceManager();
+  }
+  return queryPool.run(job, args, { priority: options?.priority, requestId: options?.requestId });
+}
+
+// Queue task webhooks for a batch of changes in one write; delivery happens
+// off the IPC path
+function publishTaskChanges(changes: TaskChange[]): void {
+  const events: { event: WebhookEvent; data: Record<string, any> }[] = [];
+  for (const { before, after } of changes) {
+    events.push({ event: WebhookEvent.TaskUpdated, data: { task: after } });
+    if (after.status === TaskStatus.Done && before.status !== TaskStatus.Done) {
+      events.push({ event: WebhookEvent.TaskCompleted, data: { task: after } });
+    }
+  }
+  if (events.length > 0) webhookDispatcher().publishMany(events);
+}
+
 // Initialize database and repositories
 const database = getDatabase();
+
+// Enterprise modules: their tables and state are set up on first use, not at startup
+const securityManager = lazy('Security manager', () => new SecurityManager(database.getDb()));
+const auditLogger = lazy('Audit logger', () =>
+  new AuditLogger(database.getDb(), database.getReadDb(), settingsManager.get('audit'), settingsManager.get('auditArchive')));
+const adminManager = lazy('Admin manager', () => new AdminManager(database.getDb()));
+const integrationManager = lazy('Integration manager', () => new IntegrationManager(database.getDb()));
+const webhookDispatcher = lazy('Webhook dispatcher', () => new WebhookDispatcher(database.getDb(), integrationManager()));
+const whiteLabelManager = lazy('White label manager', () => new WhiteLabelManager(database.getDb()));
+const complianceManager = lazy('Compliance manager', () => new ComplianceManager(database.getDb()));
+const visionBoardManager = lazy('Vision board manager', () => {
+  const manager = new VisionBoardManager(database.getDb());
+  manager.initializeTables();
+  return manager;
+});
 let projectRepo: ProjectRepository;
 let taskRepo: TaskRepository;
 let commentRepo: CommentRepository;
@@ -67,7 +143,11 @@ let userRepo: UserRepository;
 let roleRepo: RoleRepository;
 let permissionRepo: PermissionRepository;
 let projectMemberRepo: ProjectMemberRepository;
+let permissionCache: PermissionCache;
+let nativeCore: NativeCore | null = null;
 let notificationRepo: NotificationRepository;
+let notificationPipeline: NotificationPipeline;
+let changeFeed: ChangeFeed;
 let projectTemplateRepo: ProjectTemplateRepository;
 let taskTemplateRepo: TaskTemplateRepository;
 let timeEntryRepo: TimeEntryRepository;
@@ -75,6 +155,31 @@ let automationRuleRepo: AutomationRuleRepository;
 let templateService: TemplateService;
 let automationEngine: AutomationEngine;
 let analyticsService: AnalyticsService;
+let searchService: SearchService;
+let queryPool: QueryWorkerPool;
+
+// Renderers subscribed to notification deltas, keyed by webContents ID
+const notificationSubscribers = new Map<number, { sender: WebContents; userId: number }>();
+
+function sendNotificationDelta(delta: NotificationDelta): void {
+  for (const [id, subscriber] of notificationSubscribers) {
+    if (subscriber.sender.isDestroyed()) {
+      notificationSubscribers.delete(id);
+    } else if (subscriber.userId === delta.userId) {
+      subscriber.sender.send('notification:delta', delta);
+    }
+  }
+}
+
+// Renderers subscribed to the change feed, keyed by webContents ID
+const changeFeedSubscribers = new Map<number, { sender: WebContents; unsubscribe: () => void }>();
+
+// Task streams in flight, keyed by renderer-chosen stream ID
+const TASK_STREAM_CHUNK_SIZE = 500;
+const activeTaskStreams = new Set<string>();
+
+// Streaming exports in flight, keyed by caller-chosen export ID
+const activeExports = new Map<string, AbortController>();
 
 function createWindow() {
   mainWindow = new BrowserWindow({
@@ -105,14 +210,25 @@ function createWindow() {
 }
 
 app.whenReady().then(() => {
+  // Settings are loaded first so the storage mode can be applied on open
+  settingsManager = new SettingsManager();
+  metrics.configure(settingsManager.get('diagnostics'));
+
   // Initialize database
   console.log('Initializing DevTrack database...');
-  database.initialize();
+  database.initialize(settingsManager.get('storage'));
 
   // Create repository instances
   const db = database.getDb();
-  projectRepo = new ProjectRepository(db);
-  taskRepo = new TaskRepository(db);
+  projectRepo = new ProjectRepository(db, database.getReadDb());
+  taskRepo = new TaskRepository(db, database.getReadDb());
+  // Columnar listings are served by devtrack_core when it is built (npm run
+  // build:native); settings saved before the flag existed count as enabled
+  if (settingsManager.get('storage').nativeCore !== false) {
+    nativeCore = openNativeCore(database.getPath());
+    projectRepo.useNativeCore(nativeCore);
+    taskRepo.useNativeCore(nativeCore);
+  }
   commentRepo = new CommentRepository(db);
   labelRepo = new LabelRepository(db);
   attachmentRepo = new AttachmentRepository(db);
@@ -122,31 +238,43 @@ app.whenReady().then(() => {
   roleRepo = new RoleRepository(db);
   permissionRepo = new PermissionRepository(db);
   projectMemberRepo = new ProjectMemberRepository(db);
+  permissionCache = new PermissionCache(db);
+  roleRepo.onRolesChanged(() => permissionCache.invalidateAll());
+  permissionRepo.onPermissionsChanged(() => permissionCache.invalidateAll());
+  projectMemberRepo.onMembersChanged((projectId, userId) => permissionCache.invalidateMember(projectId, userId));
+  // Covers IPC handlers and automation actions; other repositories report to the graph themselves
+  taskRepo.onTasksWritten(tasks => tasks.forEach(task => dependencyRepo.getGraph().upsertTask(task)));
   notificationRepo = new NotificationRepository(db);
+  notificationPipeline = new NotificationPipeline(notificationRepo);
+  notificationPipeline.subscribe(sendNotificationDelta);
   projectTemplateRepo = new ProjectTemplateRepository(db);
   taskTemplateRepo = new TaskTemplateRepository(db);
   timeEntryRepo = new TimeEntryRepository(db);
   automationRuleRepo = new AutomationRuleRepository(db);
   templateService = new TemplateService(db);
-  automationEngine = new AutomationEngine(db, automationRuleRepo, taskRepo, notificationRepo, commentRepo, labelRepo);
-  analyticsService = new AnalyticsService(db);
-  settingsManager = new SettingsManager();
-  securityManager = new SecurityManager(db);
-  auditLogger = new AuditLogger(db);
-  adminManager = new AdminManager(db);
-  integrationManager = new IntegrationManager(db);
-  whiteLabelManager = new WhiteLabelManager(db);
-  complianceManager = new ComplianceManager(db);
-  visionBoardManager = new VisionBoardManager(db);
-  visionBoardManager.initializeTables(); // Initialize vision board tables after main database
+  automationEngine = new AutomationEngine(
+    db, automationRuleRepo, taskRepo, notificationPipeline, commentRepo, labelRepo,
+    settingsManager.get('automation')
+  );
+  analyticsService = new AnalyticsService(database.getReadDb());
+  searchService = new SearchService(database.getReadDb(), () => auditLogger.peek()?.flush());
+  changeFeed = new ChangeFeed(db, { projectRepo, taskRepo, labelRepo, commentRepo, projectMemberRepo });
+
+  // Long reports run on worker threads with their own read-only connections
+  const storage = settingsManager.get('storage');
+  queryPool = new QueryWorkerPool({
+    dbPath: database.getPath(),
+    size: storage.queryWorkers,
+    cacheSizeMb: storage.cacheSizeMb,
+    mmapSizeMb: storage.mmapSizeMb,
+    fallbackJobs: createQueryJobs({
+      analytics: analyticsService,
+      get audit() { return auditLogger(); },
+      get compliance() { return complianceManager(); },
+    }),
+  });
 
   console.log('Database initialized successfully');
-  console.log('Security manager initialized');
-  console.log('Audit logger initialized');
-  console.log('Admin manager initialized');
-  console.log('Integration manager initialized');
-  console.log('White label manager initialized');
-  console.log('Compliance manager initialized');
 
   // Seed roles and permissions on first run
   seedRolesAndPermissions(db);
@@ -154,21 +282,32 @@ app.whenReady().then(() => {
   // Seed default user on first run
   seedDefaultUser(db);
 
-  // Seed database with sample data on first run
-  const projects = projectRepo.findAll();
-  if (projects.length === 0) {
-    // seedDatabase(); // Disabled to allow for empty database
+  // Catch index regressions while developing
+  if (process.env.NODE_ENV === 'development') {
+    const planReport = checkQueryPlans(db);
+    const log = planReport.findings.length > 0 ? console.warn : console.log;
+    log(`[Database] Query plans: ${formatQueryPlanReport(planReport)}`);
   }
 
+  // Seed database with sample data on first run
+  // seedDatabase(); // Disabled to allow for empty database
+
   // Start REST API server if enabled
   const enableApi = process.env.ENABLE_API === 'true';
   if (enableApi) {
-    apiServer = new ApiServer(db);
+    apiServer = new ApiServer(db, dependencyRepo.getGraph(), searchService, integrationManager(), securityManager(), permissionCache, metrics);
     apiServer.start();
   }
 
   createWindow();
 
+  // Enterprise modules are created on first use. The webhook queue is
+  // started once the window has loaded so deliveries left from the last
+  // run go out without delaying the first paint.
+  mainWindow?.webContents.once('did-finish-load', () => {
+    setTimeout(() => webhookDispatcher(), 0);
+  });
+
   app.on('activate', () => {
     if (BrowserWindow.getAllWindows().length === 0) {
       createWindow();
@@ -177,6 +316,17 @@ app.whenReady().then(() => {
 });
 
 app.on('window-all-closed', () => {
+  queryPool?.close();
+  changeFeed?.close();
+  notificationPipeline?.close();
+  webhookDispatcher.peek()?.close();
+  integrationManager.peek()?.close();
+  for (const controller of activeExports.values()) controller.abort();
+  securityManager.peek()?.close();
+  visionBoardManager.peek()?.close();
+  auditLogger.peek()?.close();
+  metrics.close();
+  nativeCore?.close();
   database.close();
   if (process.platform !== 'darwin') {
     app.quit();
@@ -184,6 +334,17 @@ app.on('window-all-closed', () => {
 });
 
 app.on('will-quit', () => {
+  queryPool?.close();
+  changeFeed?.close();
+  notificationPipeline?.close();
+  webhookDispatcher.peek()?.close();
+  integrationManager.peek()?.close();
+  for (const controller of activeExports.values()) controller.abort();
+  securityManager.peek()?.close();
+  visionBoardManager.peek()?.close();
+  auditLogger.peek()?.close();
+  metrics.close();
+  nativeCore?.close();
   database.close();
 });
 
@@ -206,7 +367,9 @@ ipcMain.handle('window-close', () => {
 
 // Project IPC handlers
 ipcMain.handle('project:create', async (_, data) => {
-  return projectRepo.create(data);
+  const project = projectRepo.create(data);
+  webhookDispatcher().publish(WebhookEvent.ProjectCreated, { project });
+  return project;
 });
 
 ipcMain.handle('project:findById', async (_, id: number) => {
@@ -214,23 +377,35 @@ ipcMain.handle('project:findById', async (_, id: number) => {
   return projectRepo.findById(id);
 });
 
-ipcMain.handle('project:findAll', async () => {
-  return projectRepo.findAll();
+// { columnar: true } returns a ProjectColumns batch instead of objects
+ipcMain.handle('project:findAll', async (_, options?: { columnar?: boolean }) => {
+  return options?.columnar ? projectRepo.findAllColumnar() : projectRepo.findAll();
 });
 
 ipcMain.handle('project:update', async (_, id: number, data) => {
   validateId(id, 'Project ID');
-  return projectRepo.update(id, data);
+  const project = projectRepo.update(id, data);
+  if (project) webhookDispatcher().publish(WebhookEvent.ProjectUpdated, { project });
+  return project;
 });
 
 ipcMain.handle('project:delete', async (_, id: number) => {
   validateId(id, 'Project ID');
-  return projectRepo.delete(id);
+  const deleted = projectRepo.delete(id);
+  if (deleted) {
+    dependencyRepo.getGraph().removeProject(id);
+    automationEngine.invalidateRuleCache(); // project rules were cascaded
+    permissionCache.invalidateProject(id); // and so were its members
+    webhookDispatcher().publish(WebhookEvent.ProjectDeleted, { projectId: id });
+  }
+  return deleted;
 });
 
 // Task IPC handlers
 ipcMain.handle('task:create', async (_, data) => {
-  return taskRepo.create(data);
+  const task = taskRepo.create(data);
+  webhookDispatcher().publish(WebhookEvent.TaskCreated, { task });
+  return task;
 });
 
 ipcMain.handle('task:findById', async (_, id: number) => {
@@ -238,19 +413,106 @@ ipcMain.handle('task:findById', async (_, id: number) => {
   return taskRepo.findById(id);
 });
 
-ipcMain.handle('task:findByProjectId', async (_, projectId: number) => {
+// { columnar: true } returns a TaskColumns batch; used for large lists
+ipcMain.handle('task:findByProjectId', async (_, projectId: number, options?: { columnar?: boolean }) => {
   validateId(projectId, 'Project ID');
-  return taskRepo.findByProjectId(projectId);
+  return options?.columnar ? taskRepo.findByProjectIdColumnar(projectId) : taskRepo.findByProjectId(projectId);
+});
+
+ipcMain.handle('task:findPageByProjectId', async (_, projectId: number, options?: TaskPageOptions) => {
+  validateId(projectId, 'Project ID');
+  return taskRepo.findPageByProjectId(projectId, options);
+});
+
+// Streams a project's tasks to the renderer as 'task:streamChunk' events,
+// yielding to the event loop between pages so the main process stays responsive.
+// Resolves with the number of tasks sent.
+ipcMain.handle('task:streamByProjectId', async (event, streamId: string, projectId: number, chunkSize?: number) => {
+  validateId(projectId, 'Project ID');
+  activeTaskStreams.add(streamId);
+
+  let after: string | null = null;
+  let sent = 0;
+  try {
+    do {
+      if (!activeTaskStreams.has(streamId)) {
+        // Cancelled: let the renderer drop its listener
+        event.sender.send('task:streamChunk', { streamId, tasks: [], done: true });
+        break;
+      }
+      if (event.sender.isDestroyed()) break;
+
+      const page = taskRepo.findPageByProjectId(projectId, { limit: chunkSize ?? TASK_STREAM_CHUNK_SIZE, after });
+      after = page.nextCursor;
+      sent += page.tasks.length;
+      event.sender.send('task:streamChunk', { streamId, tasks: page.tasks, done: after === null });
+
+      if (after) {
+        await new Promise(resolve => setImmediate(resolve));
+      }
+    } while (after);
+  } finally {
+    activeTaskStreams.delete(streamId);
+  }
+
+  return sent;
+});
+
+ipcMain.handle('task:cancelStream', async (_, streamId: string) => {
+  return activeTaskStreams.delete(streamId);
 });
 
 ipcMain.handle('task:update', async (_, id: number, data) => {
   validateId(id, 'Task ID');
-  return taskRepo.update(id, data);
+  const completing = data?.status === TaskStatus.Done && webhookDispatcher().hasSubscribers(WebhookEvent.TaskCompleted)
+    ? taskRepo.findById(id)?.status !== TaskStatus.Done
+    : false;
+  const task = taskRepo.update(id, data);
+  if (task) {
+    webhookDispatcher().publish(WebhookEvent.TaskUpdated, { task });
+    if (completing) webhookDispatcher().publish(WebhookEvent.TaskCompleted, { task });
+  }
+  return task;
+});
+
+// Bulk task mutations: one transaction per call, automation hooks fired once
+// for the whole batch, and a compact diff of what changed in return.
+ipcMain.handle('task:bulkUpdate', async (_, items: TaskBulkUpdate[]) => {
+  if (!Array.isArray(items)) {
+    throw new Error('Invalid bulk update: must be an array');
+  }
+  items.forEach(item => validateId(item?.id, 'Task ID'));
+  const { changes, missing } = taskRepo.bulkUpdate(items);
+  publishTaskChanges(changes);
+  await automationEngine.onTasksChanged(changes);
+  return toTaskBulkResult(changes, missing);
+});
+
+ipcMain.handle('task:bulkMove', async (_, taskIds: number[], options?: TaskMoveOptions) => {
+  validateIdList(taskIds, 'Task ID');
+  const { changes, missing } = taskRepo.bulkMove(taskIds, options);
+  publishTaskChanges(changes);
+  await automationEngine.onTasksChanged(changes);
+  return toTaskBulkResult(changes, missing);
+});
+
+ipcMain.handle('task:bulkLabel', async (_, taskIds: number[], labels: TaskLabelChanges) => {
+  validateIdList(taskIds, 'Task ID');
+  validateIdList(labels?.add ?? [], 'Label ID');
+  validateIdList(labels?.remove ?? [], 'Label ID');
+  const { addedPairs, ...result } = taskRepo.bulkLabel(taskIds, labels);
+  await automationEngine.onLabelsAdded(addedPairs);
+  return result;
 });
 
 ipcMain.handle('task:delete', async (_, id: number) => {
   validateId(id, 'Task ID');
-  return taskRepo.delete(id);
+  const deleted = taskRepo.delete(id);
+  if (deleted) {
+    dependencyRepo.getGraph().removeTask(id);
+    webhookDispatcher().publish(WebhookEvent.TaskDeleted, { taskId: id });
+  }
+  return deleted;
 });
 
 ipcMain.handle('task:addLabel', async (_, taskId: number, labelId: number) => {
@@ -272,7 +534,9 @@ ipcMain.handle('task:getLabelIds', async (_, taskId: number) => {
 
 // Comment IPC handlers
 ipcMain.handle('comment:create', async (_, data) => {
-  return commentRepo.create(data);
+  const comment = commentRepo.create(data);
+  webhookDispatcher().publish(WebhookEvent.CommentCreated, { comment });
+  return comment;
 });
 
 ipcMain.handle('comment:findByTaskId', async (_, taskId: number) => {
@@ -577,7 +841,9 @@ ipcMain.handle('dependency:delete', async (_, id: number) => {
 // ============================================================================
 
 ipcMain.handle('user:create', async (_, data) => {
-  return userRepo.create(data);
+  const user = userRepo.create(data);
+  webhookDispatcher().publish(WebhookEvent.UserCreated, { user });
+  return user;
 });
 
 ipcMain.handle('user:findById', async (_, id: number) => {
@@ -603,12 +869,19 @@ ipcMain.handle('user:findActive', async () => {
 
 ipcMain.handle('user:update', async (_, id: number, data) => {
   validateId(id, 'User ID');
-  return userRepo.update(id, data);
+  const user = userRepo.update(id, data);
+  if (user) webhookDispatcher().publish(WebhookEvent.UserUpdated, { user });
+  return user;
 });
 
 ipcMain.handle('user:delete', async (_, id: number) => {
   validateId(id, 'User ID');
-  return userRepo.delete(id);
+  const deleted = userRepo.delete(id);
+  if (deleted) {
+    permissionCache.invalidateUser(id); // memberships were cascaded
+    webhookDispatcher().publish(WebhookEvent.UserDeleted, { userId: id });
+  }
+  return deleted;
 });
 
 // ============================================================================
@@ -689,6 +962,26 @@ ipcMain.handle('permission:delete', async (_, id: number) => {
   return permissionRepo.delete(id);
 });
 
+// Effective permissions of a user in a project, from the permission cache
+ipcMain.handle('permission:getEffective', async (_, userId: number, projectId: number) => {
+  validateId(userId, 'User ID');
+  validateId(projectId, 'Project ID');
+  return permissionCache.getPermissions(userId, projectId);
+});
+
+ipcMain.handle('permission:check', async (_, userId: number, projectId: number, permission: string) => {
+  validateId(userId, 'User ID');
+  validateId(projectId, 'Project ID');
+  if (typeof permission !== 'string' || permission.length === 0) {
+    throw new Error('Invalid permission: must be a non-empty string');
+  }
+  return permissionCache.can(userId, projectId, permission);
+});
+
+ipcMain.handle('permission:getCacheStats', async () => {
+  return permissionCache.getStats();
+});
+
 // ============================================================================
 // Project Member IPC Handlers
 // ============================================================================
@@ -773,16 +1066,45 @@ ipcMain.handle('dependency:hasBlockingDependencies', async (_, taskId: number) =
   return dependencyRepo.hasBlockingDependencies(taskId);
 });
 
+ipcMain.handle('dependency:getTransitiveBlockers', async (_, taskId: number) => {
+  validateId(taskId, 'Task ID');
+  return dependencyRepo.getTransitiveBlockers(taskId);
+});
+
+ipcMain.handle('dependency:getTopologicalOrder', async (_, projectId: number) => {
+  validateId(projectId, 'Project ID');
+  return dependencyRepo.getTopologicalOrder(projectId);
+});
+
+ipcMain.handle('dependency:getCriticalPath', async (_, projectId: number) => {
+  validateId(projectId, 'Project ID');
+  return dependencyRepo.getCriticalPath(projectId);
+});
+
 // ============================================================================
 // Notification IPC Handlers
 // ============================================================================
 
 ipcMain.handle('notification:create', async (_, data) => {
-  return notificationRepo.create(data);
+  return notificationPipeline.deliver([data])[0];
 });
 
 ipcMain.handle('notification:createBulk', async (_, notifications) => {
-  return notificationRepo.createBulk(notifications);
+  return notificationPipeline.deliver(notifications).length;
+});
+
+// Push this renderer's user's notification changes as 'notification:delta' events
+ipcMain.handle('notification:subscribe', async (event, userId: number) => {
+  validateId(userId, 'User ID');
+  const sender = event.sender;
+  if (!notificationSubscribers.has(sender.id)) {
+    sender.once('destroyed', () => notificationSubscribers.delete(sender.id));
+  }
+  notificationSubscribers.set(sender.id, { sender, userId });
+});
+
+ipcMain.handle('notification:unsubscribe', async (event) => {
+  notificationSubscribers.delete(event.sender.id);
 });
 
 ipcMain.handle('notification:findById', async (_, id: number) => {
@@ -807,22 +1129,22 @@ ipcMain.handle('notification:getUnreadCount', async (_, userId: number) => {
 
 ipcMain.handle('notification:markAsRead', async (_, id: number) => {
   validateId(id, 'Notification ID');
-  return notificationRepo.markAsRead(id);
+  return notificationPipeline.markAsRead(id);
 });
 
 ipcMain.handle('notification:markAllAsRead', async (_, userId: number) => {
   validateId(userId, 'User ID');
-  return notificationRepo.markAllAsRead(userId);
+  return notificationPipeline.markAllAsRead(userId);
 });
 
 ipcMain.handle('notification:markAsUnread', async (_, id: number) => {
   validateId(id, 'Notification ID');
-  return notificationRepo.markAsUnread(id);
+  return notificationPipeline.markAsUnread(id);
 });
 
 ipcMain.handle('notification:delete', async (_, id: number) => {
   validateId(id, 'Notification ID');
-  return notificationRepo.delete(id);
+  return notificationPipeline.delete(id);
 });
 
 ipcMain.handle('notification:deleteAllByUserId', async (_, userId: number) => {
@@ -934,13 +1256,19 @@ ipcMain.handle('taskTemplate:reorder', async (_, taskIds: number[]) => {
 // Template Service IPC Handlers
 ipcMain.handle('template:createProjectFromTemplate', async (_, templateId: number, customName?: string, customDescription?: string) => {
   validateId(templateId, 'Template ID');
-  return templateService.createProjectFromTemplate(templateId, customName, customDescription);
+  // One transaction for the whole project; hooks fire once for the batch
+  const { project, tasks, labelPairs } = templateService.instantiateTemplate(templateId, customName, customDescription);
+  webhookDispatcher().publish(WebhookEvent.ProjectCreated, { project, templateId, taskCount: tasks.length });
+  await automationEngine.onTasksCreated(tasks, labelPairs);
+  return project;
 });
 
 ipcMain.handle('template:createTaskFromTemplate', async (_, templateId: number, projectId: number, customTitle?: string) => {
   validateId(templateId, 'Template ID');
   validateId(projectId, 'Project ID');
-  return templateService.createTaskFromTemplate(templateId, projectId, customTitle);
+  const task = templateService.createTaskFromTemplate(templateId, projectId, customTitle);
+  dependencyRepo.getGraph().upsertTask(task);
+  return task;
 });
 
 ipcMain.handle('template:saveProjectAsTemplate', async (_, projectId: number, templateName: string, category?: string, isPublic = false, createdBy?: number) => {
@@ -1095,40 +1423,111 @@ ipcMain.handle('automationRule:getRuleStats', async (_, ruleId: number) => {
 
 // ===== ANALYTICS IPC HANDLERS =====
 
-ipcMain.handle('analytics:getTaskStatusReport', async (_, filters) => {
-  return analyticsService.getTaskStatusReport(filters);
+ipcMain.handle('analytics:getTaskStatusReport', async (_, filters, options?: ReportRequestOptions) => {
+  return runReport('analytics.getTaskStatusReport', [filters], options);
 });
 
-ipcMain.handle('analytics:getTaskPriorityReport', async (_, filters) => {
-  return analyticsService.getTaskPriorityReport(filters);
+ipcMain.handle('analytics:getTaskPriorityReport', async (_, filters, options?: ReportRequestOptions) => {
+  return runReport('analytics.getTaskPriorityReport', [filters], options);
 });
 
-ipcMain.handle('analytics:getProjectProgressReport', async (_, projectIds) => {
-  return analyticsService.getProjectProgressReport(projectIds);
+ipcMain.handle('analytics:getProjectProgressReport', async (_, projectIds, options?: ReportRequestOptions) => {
+  return runReport('analytics.getProjectProgressReport', [projectIds], options);
 });
 
-ipcMain.handle('analytics:getUserWorkloadReport', async (_, userIds) => {
-  return analyticsService.getUserWorkloadReport(userIds);
+ipcMain.handle('analytics:getUserWorkloadReport', async (_, userIds, options?: ReportRequestOptions) => {
+  return runReport('analytics.getUserWorkloadReport', [userIds], options);
 });
 
-ipcMain.handle('analytics:getTimeTrackingReport', async (_, dateRange, filters) => {
-  return analyticsService.getTimeTrackingReport(dateRange, filters);
+ipcMain.handle('analytics:getTimeTrackingReport', async (_, dateRange, filters, options?: ReportRequestOptions) => {
+  return runReport('analytics.getTimeTrackingReport', [dateRange, filters], options);
 });
 
-ipcMain.handle('analytics:getTaskCompletionTrend', async (_, dateRange, projectId) => {
-  return analyticsService.getTaskCompletionTrend(dateRange, projectId);
+ipcMain.handle('analytics:getTaskCompletionTrend', async (_, dateRange, projectId, options?: ReportRequestOptions) => {
+  return runReport('analytics.getTaskCompletionTrend', [dateRange, projectId], options);
 });
 
-ipcMain.handle('analytics:getProjectStatistics', async () => {
-  return analyticsService.getProjectStatistics();
+ipcMain.handle('analytics:getProjectStatistics', async (_, options?: ReportRequestOptions) => {
+  return runReport('analytics.getProjectStatistics', [], options);
 });
 
-ipcMain.handle('analytics:getUserStatistics', async () => {
-  return analyticsService.getUserStatistics();
+ipcMain.handle('analytics:getUserStatistics', async (_, options?: ReportRequestOptions) => {
+  return runReport('analytics.getUserStatistics', [], options);
 });
 
-ipcMain.handle('analytics:getTimeStatistics', async (_, dateRange) => {
-  return analyticsService.getTimeStatistics(dateRange);
+ipcMain.handle('analytics:getTimeStatistics', async (_, dateRange, options?: ReportRequestOptions) => {
+  return runReport('analytics.getTimeStatistics', [dateRange], options);
+});
+
+ipcMain.handle('analytics:rebuildAggregates', async () => {
+  database.rebuildAnalyticsAggregates();
+});
+
+// Cancel report requests started with options.requestId
+ipcMain.handle('report:cancel', async (_, requestId: string) => {
+  if (typeof requestId !== 'string' || requestId.length === 0) {
+    throw new Error('Invalid request ID: must be a non-empty string');
+  }
+  return queryPool.cancel(requestId);
+});
+
+ipcMain.handle('report:getPoolStats', async () => {
+  return queryPool.getStats();
+});
+
+// ===== CHANGE FEED IPC HANDLERS =====
+
+// Push entity changes to this renderer as 'changes:batch' events.
+// Resolves with the current version, the point batches continue from.
+ipcMain.handle('changes:subscribe', async (event) => {
+  const sender = event.sender;
+  if (!changeFeedSubscribers.has(sender.id)) {
+    const unsubscribe = changeFeed.subscribe(batch => {
+      if (!sender.isDestroyed()) sender.send('changes:batch', batch);
+    });
+    changeFeedSubscribers.set(sender.id, { sender, unsubscribe });
+    sender.once('destroyed', () => {
+      changeFeedSubscribers.get(sender.id)?.unsubscribe();
+      changeFeedSubscribers.delete(sender.id);
+    });
+  }
+  return changeFeed.getLatestVersion();
+});
+
+ipcMain.handle('changes:unsubscribe', async (event) => {
+  changeFeedSubscribers.get(event.sender.id)?.unsubscribe();
+  changeFeedSubscribers.delete(event.sender.id);
+});
+
+ipcMain.handle('changes:since', async (_, version: number, projectId?: number) => {
+  if (typeof version !== 'number' || !Number.isInteger(version) || version < 0) {
+    throw new Error('Invalid version: must be a non-negative integer');
+  }
+  if (projectId !== undefined) validateId(projectId, 'Project ID');
+  return changeFeed.since(version, projectId);
+});
+
+// ===== SEARCH IPC HANDLERS =====
+
+ipcMain.handle('search:query', async (_, options: SearchOptions) => {
+  if (!options || typeof options.query !== 'string') {
+    throw new Error('Invalid search options: query must be a string');
+  }
+  if (options.projectId !== undefined) {
+    validateId(options.projectId, 'Project ID');
+  }
+  return searchService.search(options);
+});
+
+ipcMain.handle('search:rebuildIndex', async () => {
+  database.rebuildSearchIndex();
+});
+
+// Database diagnostics
+ipcMain.handle('database:checkQueryPlans', async () => {
+  // Audit queries are only planned once the module's tables exist
+  auditLogger();
+  return checkQueryPlans(database.getDb());
 });
 
 // Settings handlers
@@ -1140,23 +1539,28 @@ ipcMain.handle('settings:get', async (_, key) => {
   return settingsManager.get(key);
 });
 
+// Diagnostics settings are live, so re-apply them after any settings write
 ipcMain.handle('settings:set', async (_, key, value) => {
   settingsManager.set(key, value);
+  metrics.configure(settingsManager.get('diagnostics'));
   return settingsManager.getAll();
 });
 
 ipcMain.handle('settings:setMany', async (_, settings) => {
   settingsManager.setMany(settings);
+  metrics.configure(settingsManager.get('diagnostics'));
   return settingsManager.getAll();
 });
 
 ipcMain.handle('settings:reset', async () => {
   settingsManager.reset();
+  metrics.configure(settingsManager.get('diagnostics'));
   return settingsManager.getAll();
 });
 
 ipcMain.handle('settings:resetSection', async (_, key) => {
   settingsManager.resetSection(key);
+  metrics.configure(settingsManager.get('diagnostics'));
   return settingsManager.getAll();
 });
 
@@ -1166,914 +1570,1104 @@ ipcMain.handle('settings:export', async () => {
 
 ipcMain.handle('settings:import', async (_, settingsJson) => {
   settingsManager.import(settingsJson);
+  metrics.configure(settingsManager.get('diagnostics'));
   return settingsManager.getAll();
 });
 
 // ==================== Security IPC Handlers ====================
 
 ipcMain.handle('security:setPassword', async (_, userId, password) => {
-  await securityManager.setPassword(userId, password);
+  await securityManager().setPassword(userId, password);
 });
 
 ipcMain.handle('security:verifyPassword', async (_, userId, password) => {
-  return await securityManager.verifyPassword(userId, password);
+  return await securityManager().verifyPassword(userId, password);
 });
 
 ipcMain.handle('security:getPasswordPolicy', async () => {
-  return securityManager.getPasswordPolicy();
+  return securityManager().getPasswordPolicy();
 });
 
 ipcMain.handle('security:getSecurityEvents', async (_, filters) => {
-  return securityManager.getSecurityEvents(filters);
+  return securityManager().getSecurityEvents(filters);
 });
 
 ipcMain.handle('security:generateAPIKey', async (_, userId, name, scopes) => {
-  return securityManager.generateAPIKey(userId, name, scopes);
+  return securityManager().generateAPIKey(userId, name, scopes);
 });
 
 ipcMain.handle('security:verifyAPIKey', async (_, key) => {
-  return securityManager.verifyAPIKey(key);
+  return securityManager().verifyAPIKey(key);
 });
 
 ipcMain.handle('security:revokeAPIKey', async (_, keyId, revokedBy) => {
-  securityManager.revokeAPIKey(keyId, revokedBy);
+  securityManager().revokeAPIKey(keyId, revokedBy);
 });
 
 ipcMain.handle('security:cleanupExpiredSessions', async () => {
-  return securityManager.cleanupExpiredSessions();
+  return securityManager().cleanupExpiredSessions();
 });
 
 ipcMain.handle('security:cleanupOldSecurityEvents', async (_, retentionDays) => {
-  return securityManager.cleanupOldSecurityEvents(retentionDays);
+  return securityManager().cleanupOldSecurityEvents(retentionDays);
 });
 
 // ==================== Audit Log IPC Handlers ====================
 
 ipcMain.handle('audit:log', async (_, entry) => {
-  auditLogger.log(entry);
+  auditLogger().log(entry);
 });
 
 ipcMain.handle('audit:logAction', async (_, action, description, options) => {
-  auditLogger.logAction(action, description, options);
+  auditLogger().logAction(action, description, options);
 });
 
 ipcMain.handle('audit:logChange', async (_, action, entityType, entityId, entityName, changes, options) => {
-  auditLogger.logChange(action, entityType, entityId, entityName, changes, options);
+  auditLogger().logChange(action, entityType, entityId, entityName, changes, options);
 });
 
 ipcMain.handle('audit:query', async (_, filters) => {
-  return auditLogger.query(filters);
+  return auditLogger().query(filters);
 });
 
 ipcMain.handle('audit:getById', async (_, id) => {
   validateId(id, 'Audit Log ID');
-  return auditLogger.getById(id);
+  return auditLogger().getById(id);
 });
 
 ipcMain.handle('audit:getEntityHistory', async (_, entityType, entityId, limit) => {
   validateId(entityId, 'Entity ID');
-  return auditLogger.getEntityHistory(entityType, entityId, limit);
+  return auditLogger().getEntityHistory(entityType, entityId, limit);
 });
 
 ipcMain.handle('audit:getUserActivity', async (_, userId, limit) => {
   validateId(userId, 'User ID');
-  return auditLogger.getUserActivity(userId, limit);
+  return auditLogger().getUserActivity(userId, limit);
 });
 
-ipcMain.handle('audit:generateReport', async (_, filters) => {
-  return auditLogger.generateReport(filters);
+ipcMain.handle('audit:generateReport', async (_, filters, options?: ReportRequestOptions) => {
+  return runReport('audit.generateReport', [filters], options);
 });
 
-ipcMain.handle('audit:generateComplianceReport', async (_, period) => {
-  return auditLogger.generateComplianceReport(period);
+ipcMain.handle('audit:generateComplianceReport', async (_, period, options?: ReportRequestOptions) => {
+  return runReport('audit.generateComplianceReport', [period], options);
 });
 
 ipcMain.handle('audit:deleteOldLogs', async (_, retentionDays) => {
-  return auditLogger.deleteOldLogs(retentionDays);
+  return auditLogger().deleteOldLogs(retentionDays);
+});
+
+ipcMain.handle('audit:exportToJson', async (_, filters, options?: ReportRequestOptions) => {
+  return runReport('audit.exportToJson', [filters], options);
+});
+
+ipcMain.handle('audit:exportToCsv', async (_, filters, options?: ReportRequestOptions) => {
+  return runReport('audit.exportToCsv', [filters], options);
+});
+
+ipcMain.handle('audit:flush', async () => {
+  return auditLogger().flush();
+});
+
+ipcMain.handle('audit:getWriterStats', async () => {
+  return auditLogger().getWriterStats();
 });
 
-ipcMain.handle('audit:exportToJson', async (_, filters) => {
-  return auditLogger.exportToJson(filters);
+ipcMain.handle('audit:getArchiveStats', async () => {
+  return auditLogger().getArchiveStats();
 });
 
-ipcMain.handle('audit:exportToCsv', async (_, filters) => {
-  return auditLogger.exportToCsv(filters);
+ipcMain.handle('audit:archiveNow', async () => {
+  return auditLogger().archiveNow();
+});
+
+// ==================== Export IPC Handlers ====================
+
+function runExport(
+  conn: Database.Database,
+  request: ExportRequest,
+  destination: Writable,
+  options: StreamExportOptions
+): Promise<ExportResult> {
+  switch (request.kind) {
+    case 'audit':
+      return auditLogger().exportStream(conn, request.filters, destination, options);
+    case 'timeEntries':
+      return timeEntryRepo.exportStream(conn, request.filters, destination, options);
+    case 'compliance':
+      return complianceManager().exportStream(conn, request.dataset, destination, options);
+    case 'visionBoard':
+      return visionBoardManager().exportBoardStream(conn, request.boardId, destination, options).then(result => {
+        if (!result) throw new Error(`Vision board not found: ${request.boardId}`);
+        return result;
+      });
+    default:
+      throw new Error(`Unknown export kind: ${(request as { kind: unknown }).kind}`);
+  }
+}
+
+// Streams an export to a file chosen with a save dialog, reading rows one at
+// a time on a dedicated connection. With options.exportId, progress is sent
+// as 'export:progress' events and export:cancel stops it. Resolves with null
+// if the dialog is dismissed.
+ipcMain.handle('export:toFile', async (event, request: ExportRequest, options: ExportOptions) => {
+  if (options?.format !== 'csv' && options?.format !== 'json') {
+    throw new Error("Invalid export format: must be 'csv' or 'json'");
+  }
+  if (request?.kind === 'visionBoard') {
+    validateId(request.boardId, 'Vision Board ID');
+    if (options.format !== 'json') throw new Error('Vision boards export as JSON only');
+  }
+  const exportId = options.exportId;
+  if (exportId !== undefined && (typeof exportId !== 'string' || exportId.length === 0)) {
+    throw new Error('Invalid export ID: must be a non-empty string');
+  }
+  if (exportId && activeExports.has(exportId)) {
+    throw new Error(`Export already running: ${exportId}`);
+  }
+
+  const extension = options.gzip ? `${options.format}.gz` : options.format;
+  const choice = await dialog.showSaveDialog({
+    defaultPath: `${request.kind}-${new Date().toISOString().slice(0, 10)}.${extension}`,
+    filters: [{ name: options.format.toUpperCase(), extensions: [options.gzip ? 'gz' : options.format] }],
+  });
+  if (choice.canceled || !choice.filePath) return null;
+
+  const controller = new AbortController();
+  if (exportId) activeExports.set(exportId, controller);
+  const abort = () => controller.abort();
+  event.sender.once('destroyed', abort);
+
+  let progress = { rows: 0, bytes: 0 };
+  const sendProgress = (done: boolean) => {
+    if (exportId && !event.sender.isDestroyed()) {
+      event.sender.send('export:progress', { exportId, ...progress, done });
+    }
+  };
+
+  const conn = openExportConnection(database.getPath());
+  try {
+    const result = await exportToFile(choice.filePath, destination => runExport(conn, request, destination, {
+      format: options.format,
+      gzip: options.gzip,
+      signal: controller.signal,
+      onProgress: update => {
+        progress = update;
+        sendProgress(false);
+      },
+    }));
+    console.log(`[Export] ${request.kind}: ${result.rows} rows, ${result.bytes} bytes in ${result.durationMs}ms`);
+    return result;
+  } finally {
+    conn.close();
+    event.sender.removeListener('destroyed', abort);
+    if (exportId) activeExports.delete(exportId);
+    sendProgress(true);
+  }
+});
+
+ipcMain.handle('export:cancel', async (_, exportId: string) => {
+  if (typeof exportId !== 'string' || exportId.length === 0) {
+    throw new Error('Invalid export ID: must be a non-empty string');
+  }
+  const controller = activeExports.get(exportId);
+  if (!controller) return false;
+  controller.abort();
+  return true;
+});
+
+// ==================== Diagnostics IPC Handlers ====================
+
+ipcMain.handle('diagnostics:getSnapshot', async (_, limit?: number) => {
+  if (limit !== undefined && (!Number.isInteger(limit) || limit <= 0)) {
+    throw new Error('Invalid limit: must be a positive integer');
+  }
+  return metrics.getSnapshot(limit);
+});
+
+// Applied immediately and saved, so sampling can be changed without a restart
+ipcMain.handle('diagnostics:configure', async (_, changes: Partial<DiagnosticsSettings>) => {
+  const next: Partial<DiagnosticsSettings> = {};
+  if (changes?.enabled !== undefined) {
+    if (typeof changes.enabled !== 'boolean') throw new Error('Invalid enabled: must be a boolean');
+    next.enabled = changes.enabled;
+  }
+  for (const key of ['sampleRate', 'sqlSampleRate'] as const) {
+    const rate = changes?.[key];
+    if (rate === undefined) continue;
+    if (typeof rate !== 'number' || !(rate >= 0 && rate <= 1)) {
+      throw new Error(`Invalid ${key}: must be a number between 0 and 1`);
+    }
+    next[key] = rate;
+  }
+  for (const key of ['traceBufferSize', 'eventLoopResolutionMs'] as const) {
+    const value = changes?.[key];
+    if (value === undefined) continue;
+    if (!Number.isInteger(value) || value < 0) {
+      throw new Error(`Invalid ${key}: must be a non-negative integer`);
+    }
+    next[key] = value;
+  }
+  metrics.configure(next);
+  settingsManager.set('diagnostics', metrics.getSettings());
+  return metrics.getSettings();
+});
+
+ipcMain.handle('diagnostics:reset', async () => {
+  metrics.reset();
+});
+
+ipcMain.handle('diagnostics:getPrometheus', async () => {
+  return metrics.toPrometheus();
+});
+
+// Buffered spans as a Chrome trace (open in chrome://tracing or Perfetto)
+ipcMain.handle('diagnostics:exportTrace', async () => {
+  const choice = await dialog.showSaveDialog({
+    defaultPath: `devtrack-trace-${new Date().toISOString().replace(/[:.]/g, '-')}.json`,
+    filters: [{ name: 'Chrome trace', extensions: ['json'] }],
+  });
+  if (choice.canceled || !choice.filePath) return null;
+
+  const trace = metrics.getTrace();
+  await fs.promises.writeFile(choice.filePath, JSON.stringify(trace));
+  console.log(`[Diagnostics] Wrote ${trace.traceEvents.length} trace events to ${choice.filePath}`);
+  return { filePath: choice.filePath, events: trace.traceEvents.length };
 });
 
 // ==================== Admin IPC Handlers ====================
 
 // User Provisioning
 ipcMain.handle('admin:createProvisioningRequest', async (_, data, createdBy) => {
-  return adminManager.createProvisioningRequest(data, createdBy);
+  return adminManager().createProvisioningRequest(data, createdBy);
 });
 
 ipcMain.handle('admin:getProvisioningRequest', async (_, id) => {
   validateId(id, 'Provisioning Request ID');
-  return adminManager.getProvisioningRequest(id);
+  return adminManager().getProvisioningRequest(id);
 });
 
 ipcMain.handle('admin:getAllProvisioningRequests', async (_, status) => {
-  return adminManager.getAllProvisioningRequests(status);
+  return adminManager().getAllProvisioningRequests(status);
 });
 
 ipcMain.handle('admin:updateProvisioningStatus', async (_, id, status) => {
   validateId(id, 'Provisioning Request ID');
-  adminManager.updateProvisioningStatus(id, status);
+  adminManager().updateProvisioningStatus(id, status);
 });
 
 ipcMain.handle('admin:sendInvitation', async (_, id) => {
   validateId(id, 'Provisioning Request ID');
-  adminManager.sendInvitation(id);
+  adminManager().sendInvitation(id);
 });
 
 ipcMain.handle('admin:deleteProvisioningRequest', async (_, id) => {
   validateId(id, 'Provisioning Request ID');
-  return adminManager.deleteProvisioningRequest(id);
+  return adminManager().deleteProvisioningRequest(id);
 });
 
 // Bulk Operations
 ipcMain.handle('admin:createBulkOperation', async (_, data, createdBy) => {
-  return adminManager.createBulkOperation(data, createdBy);
+  return adminManager().createBulkOperation(data, createdBy);
 });
 
 ipcMain.handle('admin:getBulkOperation', async (_, id) => {
   validateId(id, 'Bulk Operation ID');
-  return adminManager.getBulkOperation(id);
+  return adminManager().getBulkOperation(id);
 });
 
 ipcMain.handle('admin:updateBulkOperationProgress', async (_, id, processed, succeeded, failed) => {
   validateId(id, 'Bulk Operation ID');
-  adminManager.updateBulkOperationProgress(id, processed, succeeded, failed);
+  adminManager().updateBulkOperationProgress(id, processed, succeeded, failed);
 });
 
 ipcMain.handle('admin:startBulkOperation', async (_, id) => {
   validateId(id, 'Bulk Operation ID');
-  adminManager.startBulkOperation(id);
+  adminManager().startBulkOperation(id);
 });
 
 ipcMain.handle('admin:completeBulkOperation', async (_, id, errors) => {
   validateId(id, 'Bulk Operation ID');
-  adminManager.completeBulkOperation(id, errors);
+  adminManager().completeBulkOperation(id, errors);
 });
 
 // License Management
 ipcMain.handle('admin:createLicense', async (_, data) => {
-  return adminManager.createLicense(data);
+  return adminManager().createLicense(data);
 });
 
 ipcMain.handle('admin:getLicense', async (_, id) => {
   validateId(id, 'License ID');
-  return adminManager.getLicense(id);
+  return adminManager().getLicense(id);
 });
 
 ipcMain.handle('admin:getActiveLicenseByOrganization', async (_, organizationId) => {
   validateId(organizationId, 'Organization ID');
-  return adminManager.getActiveLicenseByOrganization(organizationId);
+  return adminManager().getActiveLicenseByOrganization(organizationId);
 });
 
 ipcMain.handle('admin:updateLicense', async (_, id, data) => {
   validateId(id, 'License ID');
-  return adminManager.updateLicense(id, data);
+  return adminManager().updateLicense(id, data);
 });
 
 ipcMain.handle('admin:checkExpiringLicenses', async (_, daysThreshold) => {
-  return adminManager.checkExpiringLicenses(daysThreshold);
+  return adminManager().checkExpiringLicenses(daysThreshold);
 });
 
 // Workspace Quotas
 ipcMain.handle('admin:initializeQuotasForOrganization', async (_, organizationId, licenseType) => {
   validateId(organizationId, 'Organization ID');
-  adminManager.initializeQuotasForOrganization(organizationId, licenseType);
+  adminManager().initializeQuotasForOrganization(organizationId, licenseType);
 });
 
 ipcMain.handle('admin:getQuotaUsage', async (_, organizationId, quotaType) => {
   validateId(organizationId, 'Organization ID');
-  return adminManager.getQuotaUsage(organizationId, quotaType);
+  return adminManager().getQuotaUsage(organizationId, quotaType);
 });
 
 ipcMain.handle('admin:getAllQuotaUsages', async (_, organizationId) => {
   validateId(organizationId, 'Organization ID');
-  return adminManager.getAllQuotaUsages(organizationId);
+  return adminManager().getAllQuotaUsages(organizationId);
 });
 
 ipcMain.handle('admin:updateQuotaUsage', async (_, organizationId, quotaType, used) => {
   validateId(organizationId, 'Organization ID');
-  adminManager.updateQuotaUsage(organizationId, quotaType, used);
+  adminManager().updateQuotaUsage(organizationId, quotaType, used);
 });
 
 ipcMain.handle('admin:incrementQuotaUsage', async (_, organizationId, quotaType, increment) => {
   validateId(organizationId, 'Organization ID');
-  adminManager.incrementQuotaUsage(organizationId, quotaType, increment);
+  adminManager().incrementQuotaUsage(organizationId, quotaType, increment);
 });
 
 ipcMain.handle('admin:decrementQuotaUsage', async (_, organizationId, quotaType, decrement) => {
   validateId(organizationId, 'Organization ID');
-  adminManager.decrementQuotaUsage(organizationId, quotaType, decrement);
+  adminManager().decrementQuotaUsage(organizationId, quotaType, decrement);
 });
 
 // System Health
 ipcMain.handle('admin:recordHealthMetric', async (_, metric) => {
-  adminManager.recordHealthMetric(metric);
+  adminManager().recordHealthMetric(metric);
 });
 
 ipcMain.handle('admin:getSystemHealth', async () => {
-  return adminManager.getSystemHealth();
+  return adminManager().getSystemHealth();
 });
 
 ipcMain.handle('admin:getHealthMetricHistory', async (_, metricName, hours) => {
-  return adminManager.getHealthMetricHistory(metricName, hours);
+  return adminManager().getHealthMetricHistory(metricName, hours);
 });
 
 ipcMain.handle('admin:cleanupOldHealthMetrics', async (_, retentionDays) => {
-  return adminManager.cleanupOldHealthMetrics(retentionDays);
+  return adminManager().cleanupOldHealthMetrics(retentionDays);
 });
 
 // Dashboard
 ipcMain.handle('admin:getDashboardStats', async (_, organizationId) => {
   validateId(organizationId, 'Organization ID');
-  return adminManager.getDashboardStats(organizationId);
+  // Stats read audit_logs: create it on first use and include buffered entries
+  auditLogger().flush();
+  return adminManager().getDashboardStats(organizationId);
 });
 
 // System Settings
 ipcMain.handle('admin:getSystemSetting', async (_, key) => {
-  return adminManager.getSystemSetting(key);
+  return adminManager().getSystemSetting(key);
 });
 
 ipcMain.handle('admin:getAllSystemSettings', async (_, category, publicOnly) => {
-  return adminManager.getAllSystemSettings(category, publicOnly);
+  return adminManager().getAllSystemSettings(category, publicOnly);
 });
 
 ipcMain.handle('admin:updateSystemSetting', async (_, key, data) => {
-  return adminManager.updateSystemSetting(key, data);
+  return adminManager().updateSystemSetting(key, data);
 });
 
 // Admin Activity Log
 ipcMain.handle('admin:logAdminActivity', async (_, adminUserId, action, description, options) => {
   validateId(adminUserId, 'Admin User ID');
-  adminManager.logAdminActivity(adminUserId, action, description, options);
+  adminManager().logAdminActivity(adminUserId, action, description, options);
 });
 
 ipcMain.handle('admin:getAdminActivityLog', async (_, adminUserId, limit) => {
   validateId(adminUserId, 'Admin User ID');
-  return adminManager.getAdminActivityLog(adminUserId, limit);
+  return adminManager().getAdminActivityLog(adminUserId, limit);
 });
 
 // ==================== Integration IPC Handlers ====================
 
 // Integrations
 ipcMain.handle('integration:create', async (_, data, createdBy) => {
-  return integrationManager.createIntegration(data, createdBy);
+  return integrationManager().createIntegration(data, createdBy);
 });
 
 ipcMain.handle('integration:get', async (_, id) => {
   validateId(id, 'Integration ID');
-  return integrationManager.getIntegration(id);
+  return integrationManager().getIntegration(id);
 });
 
 ipcMain.handle('integration:getAll', async (_, type, status) => {
-  return integrationManager.getAllIntegrations(type, status);
+  return integrationManager().getAllIntegrations(type, status);
 });
 
 ipcMain.handle('integration:update', async (_, id, data) => {
   validateId(id, 'Integration ID');
-  return integrationManager.updateIntegration(id, data);
+  return integrationManager().updateIntegration(id, data);
 });
 
 ipcMain.handle('integration:delete', async (_, id) => {
   validateId(id, 'Integration ID');
-  return integrationManager.deleteIntegration(id);
+  return integrationManager().deleteIntegration(id);
 });
 
 ipcMain.handle('integration:updateLastSync', async (_, id) => {
   validateId(id, 'Integration ID');
-  integrationManager.updateLastSync(id);
+  integrationManager().updateLastSync(id);
 });
 
 // Webhooks
 ipcMain.handle('webhook:create', async (_, data, createdBy) => {
-  return integrationManager.createWebhook(data, createdBy);
+  return integrationManager().createWebhook(data, createdBy);
 });
 
 ipcMain.handle('webhook:get', async (_, id) => {
   validateId(id, 'Webhook ID');
-  return integrationManager.getWebhook(id);
+  return integrationManager().getWebhook(id);
 });
 
 ipcMain.handle('webhook:getAll', async (_, activeOnly) => {
-  return integrationManager.getAllWebhooks(activeOnly);
+  return integrationManager().getAllWebhooks(activeOnly);
 });
 
 ipcMain.handle('webhook:getByEvent', async (_, event) => {
-  return integrationManager.getWebhooksByEvent(event);
+  return integrationManager().getWebhooksByEvent(event);
 });
 
 ipcMain.handle('webhook:update', async (_, id, data) => {
   validateId(id, 'Webhook ID');
-  return integrationManager.updateWebhook(id, data);
+  return integrationManager().updateWebhook(id, data);
 });
 
 ipcMain.handle('webhook:delete', async (_, id) => {
   validateId(id, 'Webhook ID');
-  return integrationManager.deleteWebhook(id);
+  return integrationManager().deleteWebhook(id);
 });
 
 ipcMain.handle('webhook:recordDelivery', async (_, delivery) => {
-  integrationManager.recordWebhookDelivery(delivery);
+  integrationManager().recordWebhookDelivery(delivery);
+});
+
+ipcMain.handle('webhook:getQueueStats', async () => {
+  return webhookDispatcher().getStats();
 });
 
 ipcMain.handle('webhook:getDeliveries', async (_, webhookId, limit) => {
   validateId(webhookId, 'Webhook ID');
-  return integrationManager.getWebhookDeliveries(webhookId, limit);
+  return integrationManager().getWebhookDeliveries(webhookId, limit);
 });
 
 // Sync Jobs
 ipcMain.handle('sync:createJob', async (_, integrationId, direction) => {
   validateId(integrationId, 'Integration ID');
-  return integrationManager.createSyncJob(integrationId, direction);
+  return integrationManager().createSyncJob(integrationId, direction);
 });
 
 ipcMain.handle('sync:getJob', async (_, id) => {
   validateId(id, 'Sync Job ID');
-  return integrationManager.getSyncJob(id);
+  return integrationManager().getSyncJob(id);
 });
 
 ipcMain.handle('sync:queryJobs', async (_, filters) => {
-  return integrationManager.querySyncJobs(filters);
+  return integrationManager().querySyncJobs(filters);
 });
 
 ipcMain.handle('sync:updateProgress', async (_, id, processed, created, updated, failed) => {
   validateId(id, 'Sync Job ID');
-  integrationManager.updateSyncJobProgress(id, processed, created, updated, failed);
+  integrationManager().updateSyncJobProgress(id, processed, created, updated, failed);
 });
 
 ipcMain.handle('sync:completeJob', async (_, id, status, errors, summary) => {
   validateId(id, 'Sync Job ID');
-  integrationManager.completeSyncJob(id, status, errors, summary);
+  integrationManager().completeSyncJob(id, status, errors, summary);
 });
 
 // Rate Limiting
 ipcMain.handle('rateLimit:createConfig', async (_, data) => {
-  return integrationManager.createRateLimitConfig(data);
+  return integrationManager().createRateLimitConfig(data);
 });
 
 ipcMain.handle('rateLimit:getConfig', async (_, id) => {
   validateId(id, 'Rate Limit Config ID');
-  return integrationManager.getRateLimitConfig(id);
+  return integrationManager().getRateLimitConfig(id);
 });
 
 ipcMain.handle('rateLimit:getByApiKey', async (_, apiKeyId) => {
   validateId(apiKeyId, 'API Key ID');
-  return integrationManager.getRateLimitByApiKey(apiKeyId);
+  return integrationManager().getRateLimitByApiKey(apiKeyId);
 });
 
 ipcMain.handle('rateLimit:check', async (_, configId) => {
   validateId(configId, 'Rate Limit Config ID');
-  return integrationManager.checkRateLimit(configId);
+  return integrationManager().checkRateLimit(configId);
 });
 
 // Import/Export
 ipcMain.handle('importExport:createJob', async (_, data, createdBy) => {
-  return integrationManager.createImportExportJob(data, createdBy);
+  return integrationManager().createImportExportJob(data, createdBy);
 });
 
 ipcMain.handle('importExport:getJob', async (_, id) => {
   validateId(id, 'Import/Export Job ID');
-  return integrationManager.getImportExportJob(id);
+  return integrationManager().getImportExportJob(id);
 });
 
 ipcMain.handle('importExport:startJob', async (_, id, totalRecords) => {
   validateId(id, 'Import/Export Job ID');
-  integrationManager.startImportExportJob(id, totalRecords);
+  integrationManager().startImportExportJob(id, totalRecords);
 });
 
 ipcMain.handle('importExport:updateProgress', async (_, id, processed, succeeded, failed) => {
   validateId(id, 'Import/Export Job ID');
-  integrationManager.updateImportExportProgress(id, processed, succeeded, failed);
+  integrationManager().updateImportExportProgress(id, processed, succeeded, failed);
 });
 
 ipcMain.handle('importExport:completeJob', async (_, id, errors) => {
   validateId(id, 'Import/Export Job ID');
-  integrationManager.completeImportExportJob(id, errors);
+  integrationManager().completeImportExportJob(id, errors);
 });
 
 // Integration Events
 ipcMain.handle('integration:logEvent', async (_, integrationId, eventType, eventData, status, message) => {
   validateId(integrationId, 'Integration ID');
-  integrationManager.logIntegrationEvent(integrationId, eventType, eventData, status, message);
+  integrationManager().logIntegrationEvent(integrationId, eventType, eventData, status, message);
 });
 
 ipcMain.handle('integration:getEvents', async (_, integrationId, limit) => {
   validateId(integrationId, 'Integration ID');
-  return integrationManager.getIntegrationEvents(integrationId, limit);
+  return integrationManager().getIntegrationEvents(integrationId, limit);
 });
 
 // ==================== White Label IPC Handlers ====================
 
 // Tenants
 ipcMain.handle('tenant:create', async (_, data) => {
-  return whiteLabelManager.createTenant(data);
+  return whiteLabelManager().createTenant(data);
 });
 
 ipcMain.handle('tenant:get', async (_, id) => {
   validateId(id, 'Tenant ID');
-  return whiteLabelManager.getTenant(id);
+  return whiteLabelManager().getTenant(id);
 });
 
 ipcMain.handle('tenant:getBySlug', async (_, slug) => {
-  return whiteLabelManager.getTenantBySlug(slug);
+  return whiteLabelManager().getTenantBySlug(slug);
 });
 
 ipcMain.handle('tenant:getByDomain', async (_, domain) => {
-  return whiteLabelManager.getTenantByDomain(domain);
+  return whiteLabelManager().getTenantByDomain(domain);
 });
 
 ipcMain.handle('tenant:getAll', async (_, status) => {
-  return whiteLabelManager.getAllTenants(status);
+  return whiteLabelManager().getAllTenants(status);
 });
 
 ipcMain.handle('tenant:update', async (_, id, data) => {
   validateId(id, 'Tenant ID');
-  return whiteLabelManager.updateTenant(id, data);
+  return whiteLabelManager().updateTenant(id, data);
 });
 
 ipcMain.handle('tenant:delete', async (_, id) => {
   validateId(id, 'Tenant ID');
-  return whiteLabelManager.deleteTenant(id);
+  return whiteLabelManager().deleteTenant(id);
 });
 
 // Custom Domains
 ipcMain.handle('customDomain:create', async (_, data) => {
-  return whiteLabelManager.createCustomDomain(data);
+  return whiteLabelManager().createCustomDomain(data);
 });
 
 ipcMain.handle('customDomain:get', async (_, id) => {
   validateId(id, 'Custom Domain ID');
-  return whiteLabelManager.getCustomDomain(id);
+  return whiteLabelManager().getCustomDomain(id);
 });
 
 ipcMain.handle('customDomain:getByDomain', async (_, domain) => {
-  return whiteLabelManager.getCustomDomainByDomain(domain);
+  return whiteLabelManager().getCustomDomainByDomain(domain);
 });
 
 ipcMain.handle('customDomain:getTenantDomains', async (_, tenantId) => {
   validateId(tenantId, 'Tenant ID');
-  return whiteLabelManager.getTenantCustomDomains(tenantId);
+  return whiteLabelManager().getTenantCustomDomains(tenantId);
 });
 
 ipcMain.handle('customDomain:update', async (_, id, data) => {
   validateId(id, 'Custom Domain ID');
-  return whiteLabelManager.updateCustomDomain(id, data);
+  return whiteLabelManager().updateCustomDomain(id, data);
 });
 
 ipcMain.handle('customDomain:verify', async (_, id) => {
   validateId(id, 'Custom Domain ID');
-  return whiteLabelManager.verifyCustomDomain(id);
+  return whiteLabelManager().verifyCustomDomain(id);
 });
 
 ipcMain.handle('customDomain:delete', async (_, id) => {
   validateId(id, 'Custom Domain ID');
-  return whiteLabelManager.deleteCustomDomain(id);
+  return whiteLabelManager().deleteCustomDomain(id);
 });
 
 // Email Templates
 ipcMain.handle('emailTemplate:create', async (_, data, createdBy) => {
-  return whiteLabelManager.createEmailTemplate(data, createdBy);
+  return whiteLabelManager().createEmailTemplate(data, createdBy);
 });
 
 ipcMain.handle('emailTemplate:get', async (_, id) => {
   validateId(id, 'Email Template ID');
-  return whiteLabelManager.getEmailTemplate(id);
+  return whiteLabelManager().getEmailTemplate(id);
 });
 
 ipcMain.handle('emailTemplate:getByType', async (_, tenantId, type) => {
   validateId(tenantId, 'Tenant ID');
-  return whiteLabelManager.getEmailTemplateByType(tenantId, type);
+  return whiteLabelManager().getEmailTemplateByType(tenantId, type);
 });
 
 ipcMain.handle('emailTemplate:getTenantTemplates', async (_, tenantId) => {
   validateId(tenantId, 'Tenant ID');
-  return whiteLabelManager.getTenantEmailTemplates(tenantId);
+  return whiteLabelManager().getTenantEmailTemplates(tenantId);
 });
 
 ipcMain.handle('emailTemplate:update', async (_, id, data) => {
   validateId(id, 'Email Template ID');
-  return whiteLabelManager.updateEmailTemplate(id, data);
+  return whiteLabelManager().updateEmailTemplate(id, data);
 });
 
 ipcMain.handle('emailTemplate:delete', async (_, id) => {
   validateId(id, 'Email Template ID');
-  return whiteLabelManager.deleteEmailTemplate(id);
+  return whiteLabelManager().deleteEmailTemplate(id);
 });
 
 // Login Page Configuration
 ipcMain.handle('loginPageConfig:create', async (_, data) => {
-  return whiteLabelManager.createLoginPageConfig(data);
+  return whiteLabelManager().createLoginPageConfig(data);
 });
 
 ipcMain.handle('loginPageConfig:get', async (_, id) => {
   validateId(id, 'Login Page Config ID');
-  return whiteLabelManager.getLoginPageConfig(id);
+  return whiteLabelManager().getLoginPageConfig(id);
 });
 
 ipcMain.handle('loginPageConfig:getByTenant', async (_, tenantId) => {
   validateId(tenantId, 'Tenant ID');
-  return whiteLabelManager.getLoginPageConfigByTenant(tenantId);
+  return whiteLabelManager().getLoginPageConfigByTenant(tenantId);
 });
 
 ipcMain.handle('loginPageConfig:update', async (_, id, data) => {
   validateId(id, 'Login Page Config ID');
-  return whiteLabelManager.updateLoginPageConfig(id, data);
+  return whiteLabelManager().updateLoginPageConfig(id, data);
 });
 
 ipcMain.handle('loginPageConfig:delete', async (_, id) => {
   validateId(id, 'Login Page Config ID');
-  return whiteLabelManager.deleteLoginPageConfig(id);
+  return whiteLabelManager().deleteLoginPageConfig(id);
 });
 
 // Tenant Settings
 ipcMain.handle('tenantSetting:create', async (_, data) => {
-  return whiteLabelManager.createTenantSetting(data);
+  return whiteLabelManager().createTenantSetting(data);
 });
 
 ipcMain.handle('tenantSetting:get', async (_, id) => {
   validateId(id, 'Tenant Setting ID');
-  return whiteLabelManager.getTenantSetting(id);
+  return whiteLabelManager().getTenantSetting(id);
 });
 
 ipcMain.handle('tenantSetting:getByKey', async (_, tenantId, key) => {
   validateId(tenantId, 'Tenant ID');
-  return whiteLabelManager.getTenantSettingByKey(tenantId, key);
+  return whiteLabelManager().getTenantSettingByKey(tenantId, key);
 });
 
 ipcMain.handle('tenantSetting:getAll', async (_, tenantId, category) => {
   validateId(tenantId, 'Tenant ID');
-  return whiteLabelManager.getAllTenantSettings(tenantId, category);
+  return whiteLabelManager().getAllTenantSettings(tenantId, category);
 });
 
 ipcMain.handle('tenantSetting:update', async (_, id, data) => {
   validateId(id, 'Tenant Setting ID');
-  return whiteLabelManager.updateTenantSetting(id, data);
+  return whiteLabelManager().updateTenantSetting(id, data);
 });
 
 ipcMain.handle('tenantSetting:delete', async (_, id) => {
   validateId(id, 'Tenant Setting ID');
-  return whiteLabelManager.deleteTenantSetting(id);
+  return whiteLabelManager().deleteTenantSetting(id);
 });
 
 // Tenant Assets
 ipcMain.handle('tenantAsset:create', async (_, data, uploadedBy) => {
-  return whiteLabelManager.createTenantAsset(data, uploadedBy);
+  return whiteLabelManager().createTenantAsset(data, uploadedBy);
 });
 
 ipcMain.handle('tenantAsset:get', async (_, id) => {
   validateId(id, 'Tenant Asset ID');
-  return whiteLabelManager.getTenantAsset(id);
+  return whiteLabelManager().getTenantAsset(id);
 });
 
 ipcMain.handle('tenantAsset:getTenantAssets', async (_, tenantId, assetType) => {
   validateId(tenantId, 'Tenant ID');
-  return whiteLabelManager.getTenantAssets(tenantId, assetType);
+  return whiteLabelManager().getTenantAssets(tenantId, assetType);
 });
 
 ipcMain.handle('tenantAsset:delete', async (_, id) => {
   validateId(id, 'Tenant Asset ID');
-  return whiteLabelManager.deleteTenantAsset(id);
+  return whiteLabelManager().deleteTenantAsset(id);
 });
 
 // ==================== Compliance IPC Handlers ====================
 
 // Data Subject Requests (GDPR)
 ipcMain.handle('compliance:createDSR', async (_, data) => {
-  return complianceManager.createDataSubjectRequest(data);
+  return complianceManager().createDataSubjectRequest(data);
 });
 
 ipcMain.handle('compliance:getDSR', async (_, id) => {
   validateId(id, 'Data Subject Request ID');
-  return complianceManager.getDataSubjectRequest(id);
+  return complianceManager().getDataSubjectRequest(id);
 });
 
 ipcMain.handle('compliance:getUserDSRs', async (_, userId) => {
   validateId(userId, 'User ID');
-  return complianceManager.getUserDataSubjectRequests(userId);
+  return complianceManager().getUserDataSubjectRequests(userId);
 });
 
 ipcMain.handle('compliance:getAllDSRs', async (_, status) => {
-  return complianceManager.getAllDataSubjectRequests(status);
+  return complianceManager().getAllDataSubjectRequests(status);
 });
 
 ipcMain.handle('compliance:updateDSR', async (_, id, data) => {
   validateId(id, 'Data Subject Request ID');
-  return complianceManager.updateDataSubjectRequest(id, data);
+  return complianceManager().updateDataSubjectRequest(id, data);
 });
 
 ipcMain.handle('compliance:verifyDSR', async (_, id, token) => {
   validateId(id, 'Data Subject Request ID');
-  return complianceManager.verifyDataSubjectRequest(id, token);
+  return complianceManager().verifyDataSubjectRequest(id, token);
 });
 
 // Data Retention Policies
 ipcMain.handle('compliance:createRetentionPolicy', async (_, data, createdBy) => {
-  return complianceManager.createDataRetentionPolicy(data, createdBy);
+  return complianceManager().createDataRetentionPolicy(data, createdBy);
 });
 
 ipcMain.handle('compliance:getRetentionPolicy', async (_, id) => {
   validateId(id, 'Data Retention Policy ID');
-  return complianceManager.getDataRetentionPolicy(id);
+  return complianceManager().getDataRetentionPolicy(id);
 });
 
 ipcMain.handle('compliance:getAllRetentionPolicies', async (_, status) => {
-  return complianceManager.getAllDataRetentionPolicies(status);
+  return complianceManager().getAllDataRetentionPolicies(status);
 });
 
 ipcMain.handle('compliance:updateRetentionPolicy', async (_, id, data) => {
   validateId(id, 'Data Retention Policy ID');
-  return complianceManager.updateDataRetentionPolicy(id, data);
+  return complianceManager().updateDataRetentionPolicy(id, data);
 });
 
 ipcMain.handle('compliance:deleteRetentionPolicy', async (_, id) => {
   validateId(id, 'Data Retention Policy ID');
-  return complianceManager.deleteDataRetentionPolicy(id);
+  return complianceManager().deleteDataRetentionPolicy(id);
 });
 
 ipcMain.handle('compliance:logRetentionExecution', async (_, policyId, itemsProcessed, itemsDeleted, itemsArchived, itemsAnonymized, errors, summary) => {
   validateId(policyId, 'Data Retention Policy ID');
-  return complianceManager.logRetentionExecution(policyId, itemsProcessed, itemsDeleted, itemsArchived, itemsAnonymized, errors, summary);
+  return complianceManager().logRetentionExecution(policyId, itemsProcessed, itemsDeleted, itemsArchived, itemsAnonymized, errors, summary);
 });
 
 ipcMain.handle('compliance:getRetentionLogs', async (_, policyId, limit) => {
   validateId(policyId, 'Data Retention Policy ID');
-  return complianceManager.getRetentionExecutionLogs(policyId, limit);
+  return complianceManager().getRetentionExecutionLogs(policyId, limit);
 });
 
 // User Consents
 ipcMain.handle('compliance:createConsent', async (_, data) => {
-  return complianceManager.createUserConsent(data);
+  return complianceManager().createUserConsent(data);
 });
 
 ipcMain.handle('compliance:getConsent', async (_, id) => {
   validateId(id, 'User Consent ID');
-  return complianceManager.getUserConsent(id);
+  return complianceManager().getUserConsent(id);
 });
 
 ipcMain.handle('compliance:getUserConsents', async (_, userId, consentType) => {
   validateId(userId, 'User ID');
-  return complianceManager.getUserConsents(userId, consentType);
+  return complianceManager().getUserConsents(userId, consentType);
 });
 
 ipcMain.handle('compliance:updateConsent', async (_, id, data) => {
   validateId(id, 'User Consent ID');
-  return complianceManager.updateUserConsent(id, data);
+  return complianceManager().updateUserConsent(id, data);
 });
 
 ipcMain.handle('compliance:withdrawConsent', async (_, userId, consentType) => {
   validateId(userId, 'User ID');
-  return complianceManager.withdrawUserConsent(userId, consentType);
+  return complianceManager().withdrawUserConsent(userId, consentType);
 });
 
 // Legal Holds
 ipcMain.handle('compliance:createLegalHold', async (_, data, createdBy) => {
-  return complianceManager.createLegalHold(data, createdBy);
+  return complianceManager().createLegalHold(data, createdBy);
 });
 
 ipcMain.handle('compliance:getLegalHold', async (_, id) => {
   validateId(id, 'Legal Hold ID');
-  return complianceManager.getLegalHold(id);
+  return complianceManager().getLegalHold(id);
 });
 
 ipcMain.handle('compliance:getAllLegalHolds', async (_, status) => {
-  return complianceManager.getAllLegalHolds(status);
+  return complianceManager().getAllLegalHolds(status);
 });
 
 ipcMain.handle('compliance:updateLegalHold', async (_, id, data) => {
   validateId(id, 'Legal Hold ID');
-  return complianceManager.updateLegalHold(id, data);
+  return complianceManager().updateLegalHold(id, data);
 });
 
 ipcMain.handle('compliance:releaseLegalHold', async (_, id, releasedBy) => {
   validateId(id, 'Legal Hold ID');
-  return complianceManager.releaseLegalHold(id, releasedBy);
+  return complianceManager().releaseLegalHold(id, releasedBy);
 });
 
 ipcMain.handle('compliance:isEntityUnderHold', async (_, entityType, entityId) => {
   validateId(entityId, 'Entity ID');
-  return complianceManager.isEntityUnderHold(entityType, entityId);
+  return complianceManager().isEntityUnderHold(entityType, entityId);
 });
 
 // Compliance Controls
 ipcMain.handle('compliance:createControl', async (_, data) => {
-  return complianceManager.createComplianceControl(data);
+  return complianceManager().createComplianceControl(data);
 });
 
 ipcMain.handle('compliance:getControl', async (_, id) => {
   validateId(id, 'Compliance Control ID');
-  return complianceManager.getComplianceControl(id);
+  return complianceManager().getComplianceControl(id);
 });
 
 ipcMain.handle('compliance:getControlsByFramework', async (_, framework) => {
-  return complianceManager.getComplianceControlsByFramework(framework);
+  return complianceManager().getComplianceControlsByFramework(framework);
 });
 
 ipcMain.handle('compliance:getAllControls', async () => {
-  return complianceManager.getAllComplianceControls();
+  return complianceManager().getAllComplianceControls();
 });
 
 ipcMain.handle('compliance:updateControl', async (_, id, data) => {
   validateId(id, 'Compliance Control ID');
-  return complianceManager.updateComplianceControl(id, data);
+  return complianceManager().updateComplianceControl(id, data);
 });
 
 ipcMain.handle('compliance:deleteControl', async (_, id) => {
   validateId(id, 'Compliance Control ID');
-  return complianceManager.deleteComplianceControl(id);
+  return complianceManager().deleteComplianceControl(id);
 });
 
 // Compliance Assessments
 ipcMain.handle('compliance:createAssessment', async (_, data, createdBy) => {
-  return complianceManager.createComplianceAssessment(data, createdBy);
+  return complianceManager().createComplianceAssessment(data, createdBy);
 });
 
 ipcMain.handle('compliance:getAssessment', async (_, id) => {
   validateId(id, 'Compliance Assessment ID');
-  return complianceManager.getComplianceAssessment(id);
+  return complianceManager().getComplianceAssessment(id);
 });
 
 ipcMain.handle('compliance:getAllAssessments', async (_, framework) => {
-  return complianceManager.getAllComplianceAssessments(framework);
+  return complianceManager().getAllComplianceAssessments(framework);
 });
 
 ipcMain.handle('compliance:updateAssessment', async (_, id, data) => {
   validateId(id, 'Compliance Assessment ID');
-  return complianceManager.updateComplianceAssessment(id, data);
+  return complianceManager().updateComplianceAssessment(id, data);
 });
 
 ipcMain.handle('compliance:deleteAssessment', async (_, id) => {
   validateId(id, 'Compliance Assessment ID');
-  return complianceManager.deleteComplianceAssessment(id);
+  return complianceManager().deleteComplianceAssessment(id);
 });
 
 // Data Processing Activities
 ipcMain.handle('compliance:createProcessingActivity', async (_, data, createdBy) => {
-  return complianceManager.createDataProcessingActivity(data, createdBy);
+  return complianceManager().createDataProcessingActivity(data, createdBy);
 });
 
 ipcMain.handle('compliance:getProcessingActivity', async (_, id) => {
   validateId(id, 'Data Processing Activity ID');
-  return complianceManager.getDataProcessingActivity(id);
+  return complianceManager().getDataProcessingActivity(id);
 });
 
 ipcMain.handle('compliance:getAllProcessingActivities', async () => {
-  return complianceManager.getAllDataProcessingActivities();
+  return complianceManager().getAllDataProcessingActivities();
 });
 
 ipcMain.handle('compliance:updateProcessingActivity', async (_, id, data) => {
   validateId(id, 'Data Processing Activity ID');
-  return complianceManager.updateDataProcessingActivity(id, data);
+  return complianceManager().updateDataProcessingActivity(id, data);
 });
 
 ipcMain.handle('compliance:deleteProcessingActivity', async (_, id) => {
   validateId(id, 'Data Processing Activity ID');
-  return complianceManager.deleteDataProcessingActivity(id);
+  return complianceManager().deleteDataProcessingActivity(id);
 });
 
 // Compliance Dashboard
-ipcMain.handle('compliance:getDashboardStats', async () => {
-  return complianceManager.getComplianceDashboardStats();
+ipcMain.handle('compliance:getDashboardStats', async (_, options?: ReportRequestOptions) => {
+  return runReport('compliance.getComplianceDashboardStats', [], options);
 });
 
 // ==================== VISION BOARDS ====================
 
 // Vision Board CRUD
 ipcMain.handle('visionBoard:create', async (_, data, userId) => {
-  return visionBoardManager.createBoard(data, userId);
+  return visionBoardManager().createBoard(data, userId);
 });
 
 ipcMain.handle('visionBoard:createFromTemplate', async (_, template, name, userId, projectId) => {
-  return visionBoardManager.createBoardFromTemplate(template, name, userId, projectId);
+  return visionBoardManager().createBoardFromTemplate(template, name, userId, projectId);
 });
 
 ipcMain.handle('visionBoard:getById', async (_, id) => {
   validateId(id, 'Vision Board ID');
-  return visionBoardManager.getBoardById(id);
+  return visionBoardManager().getBoardById(id);
 });
 
 ipcMain.handle('visionBoard:getAll', async (_, filters) => {
-  return visionBoardManager.getAllBoards(filters);
+  return visionBoardManager().getAllBoards(filters);
 });
 
 ipcMain.handle('visionBoard:getByProject', async (_, projectId) => {
   validateId(projectId, 'Project ID');
-  return visionBoardManager.getBoardsByProject(projectId);
+  return visionBoardManager().getBoardsByProject(projectId);
 });
 
 ipcMain.handle('visionBoard:update', async (_, id, data) => {
   validateId(id, 'Vision Board ID');
-  return visionBoardManager.updateBoard(id, data);
+  return visionBoardManager().updateBoard(id, data);
 });
 
 ipcMain.handle('visionBoard:delete', async (_, id) => {
   validateId(id, 'Vision Board ID');
-  return visionBoardManager.deleteBoard(id);
+  return visionBoardManager().deleteBoard(id);
 });
 
 ipcMain.handle('visionBoard:duplicate', async (_, id, newName, userId) => {
   validateId(id, 'Vision Board ID');
   validateId(userId, 'User ID');
-  return visionBoardManager.duplicateBoard(id, newName, userId);
+  return visionBoardManager().duplicateBoard(id, newName, userId);
 });
 
 // Vision Board Nodes
 ipcMain.handle('visionBoard:createNode', async (_, data) => {
-  return visionBoardManager.createNode(data);
+  return visionBoardManager().createNode(data);
 });
 
 ipcMain.handle('visionBoard:getNode', async (_, id) => {
   validateId(id, 'Vision Board Node ID');
-  return visionBoardManager.getNodeById(id);
+  return visionBoardManager().getNodeById(id);
 });
 
 ipcMain.handle('visionBoard:getNodesByBoard', async (_, boardId) => {
   validateId(boardId, 'Vision Board ID');
-  return visionBoardManager.getNodesByBoard(boardId);
+  return visionBoardManager().getNodesByBoard(boardId);
 });
 
 ipcMain.handle('visionBoard:updateNode', async (_, id, data) => {
   validateId(id, 'Vision Board Node ID');
-  return visionBoardManager.updateNode(id, data);
+  return visionBoardManager().updateNode(id, data);
 });
 
 ipcMain.handle('visionBoard:deleteNode', async (_, id) => {
   validateId(id, 'Vision Board Node ID');
-  return visionBoardManager.deleteNode(id);
+  return visionBoardManager().deleteNode(id);
 });
 
 ipcMain.handle('visionBoard:bulkUpdateNodePositions', async (_, updates) => {
-  return visionBoardManager.bulkUpdateNodePositions(updates);
+  return visionBoardManager().bulkUpdateNodePositions(updates);
+});
+
+ipcMain.handle('visionBoard:applyOperations', async (_, boardId, ops) => {
+  validateId(boardId, 'Vision Board ID');
+  return visionBoardManager().applyOperations(boardId, ops);
 });
 
 // Vision Board Connections
 ipcMain.handle('visionBoard:createConnection', async (_, data) => {
-  return visionBoardManager.createConnection(data);
+  return visionBoardManager().createConnection(data);
 });
 
 ipcMain.handle('visionBoard:getConnection', async (_, id) => {
   validateId(id, 'Vision Board Connection ID');
-  return visionBoardManager.getConnectionById(id);
+  return visionBoardManager().getConnectionById(id);
 });
 
 ipcMain.handle('visionBoard:getConnectionsByBoard', async (_, boardId) => {
   validateId(boardId, 'Vision Board ID');
-  return visionBoardManager.getConnectionsByBoard(boardId);
+  return visionBoardManager().getConnectionsByBoard(boardId);
 });
 
 ipcMain.handle('visionBoard:updateConnection', async (_, id, data) => {
   validateId(id, 'Vision Board Connection ID');
-  return visionBoardManager.updateConnection(id, data);
+  return visionBoardManager().updateConnection(id, data);
 });
 
 ipcMain.handle('visionBoard:deleteConnection', async (_, id) => {
   validateId(id, 'Vision Board Connection ID');
-  return visionBoardManager.deleteConnection(id);
+  return visionBoardManager().deleteConnection(id);
 });
 
 // Vision Board Groups
 ipcMain.handle('visionBoard:createGroup', async (_, data) => {
-  return visionBoardManager.createGroup(data);
+  return visionBoardManager().createGroup(data);
 });
 
 ipcMain.handle('visionBoard:getGroup', async (_, id) => {
   validateId(id, 'Vision Board Group ID');
-  return visionBoardManager.getGroupById(id);
+  return visionBoardManager().getGroupById(id);
 });
 
 ipcMain.handle('visionBoard:getGroupsByBoard', async (_, boardId) => {
   validateId(boardId, 'Vision Board ID');
-  return visionBoardManager.getGroupsByBoard(boardId);
+  return visionBoardManager().getGroupsByBoard(boardId);
 });
 
 ipcMain.handle('visionBoard:updateGroup', async (_, id, data) => {
   validateId(id, 'Vision Board Group ID');
-  return visionBoardManager.updateGroup(id, data);
+  return visionBoardManager().updateGroup(id, data);
 });
 
 ipcMain.handle('visionBoard:deleteGroup', async (_, id) => {
   validateId(id, 'Vision Board Group ID');
-  return visionBoardManager.deleteGroup(id);
+  return visionBoardManager().deleteGroup(id);
 });
 
 // Vision Board Helpers
 ipcMain.handle('visionBoard:getBoardData', async (_, boardId) => {
   validateId(boardId, 'Vision Board ID');
-  return visionBoardManager.getBoardData(boardId);
+  return visionBoardManager().getBoardData(boardId);
+});
+
+ipcMain.handle('visionBoard:getViewport', async (_, boardId, viewport, margin) => {
+  validateId(boardId, 'Vision Board ID');
+  if (!viewport || ![viewport.x, viewport.y, viewport.width, viewport.height].every(Number.isFinite)) {
+    throw new Error('Invalid viewport: x, y, width and height must be numbers');
+  }
+  return visionBoardManager().getBoardViewport(boardId, viewport, margin);
 });
 
 ipcMain.handle('visionBoard:exportToJSON', async (_, boardId) => {
   validateId(boardId, 'Vision Board ID');
-  return visionBoardManager.exportBoardToJSON(boardId);
+  return visionBoardManager().exportBoardToJSON(boardId);
 });
 
 ipcMain.handle('visionBoard:importFromJSON', async (_, json, userId, newName) => {
   validateId(userId, 'User ID');
-  return visionBoardManager.importBoardFromJSON(json, userId, newName);
+  return visionBoardManager().importBoardFromJSON(json, userId, newName);
 });
 
 
@@ -2,6 +2,15 @@
  * Application Settings Model
  */
 
+import {
+  AuditWriterSettings,
+  AuditArchiveSettings,
+  DEFAULT_AUDIT_WRITER_SETTINGS,
+  DEFAULT_AUDIT_ARCHIVE_SETTINGS,
+} from './AuditLog';
+import { AutomationEngineSettings, DEFAULT_AUTOMATION_ENGINE_SETTINGS } from './AutomationRule';
+import { DiagnosticsSettings, DEFAULT_DIAGNOSTICS_SETTINGS } from './Diagnostics';
+
 export interface ThemeSettings {
   mode: 'light' | 'dark' | 'custom';
   primaryColor?: string;
@@ -35,11 +44,27 @@ export interface WorkspaceSettings {
   soundEnabled: boolean;
 }
 
+export interface StorageSettings {
+  journalMode: 'wal' | 'delete';
+  synchronous: 'off' | 'normal' | 'full';
+  cacheSizeMb: number;
+  mmapSizeMb: number;
+  readPoolSize: number; // read-only connections, only used in WAL mode
+  statementCacheSize: number; // prepared statements kept per connection
+  queryWorkers: number; // worker threads for long read-only reports (0 = run on the main thread)
+  nativeCore: boolean; // serve columnar listings from the devtrack_core addon when it is built
+}
+
 export interface AppSettings {
   theme: ThemeSettings;
   branding: BrandingSettings;
   keyboardShortcuts: KeyboardShortcut[];
   workspace: WorkspaceSettings;
+  storage: StorageSettings;
+  audit: AuditWriterSettings;
+  auditArchive: AuditArchiveSettings;
+  automation: AutomationEngineSettings;
+  diagnostics: DiagnosticsSettings;
   version: string;
   lastUpdated: string;
 }
@@ -81,6 +106,20 @@ export const DEFAULT_SETTINGS: AppSettings = {
     notificationsEnabled: true,
     soundEnabled: false,
   },
+  storage: {
+    journalMode: 'wal',
+    synchronous: 'normal',
+    cacheSizeMb: 64,
+    mmapSizeMb: 256,
+    readPoolSize: 2,
+    statementCacheSize: 256,
+    queryWorkers: 2,
+    nativeCore: true,
+  },
+  audit: DEFAULT_AUDIT_WRITER_SETTINGS,
+  auditArchive: DEFAULT_AUDIT_ARCHIVE_SETTINGS,
+  automation: DEFAULT_AUTOMATION_ENGINE_SETTINGS,
+  diagnostics: DEFAULT_DIAGNOSTICS_SETTINGS,
   version: '1.0.0',
   lastUpdated: new Date().toISOString(),
 };
@@ -150,6 +150,75 @@ export interface AuditFilters {
   offset?: number;
 }
 
+export type AuditWriteMode = 'immediate' | 'buffered';
+
+export interface AuditWriterSettings {
+  mode: AuditWriteMode;
+  bufferSize: number; // ring buffer capacity; a full buffer forces a flush
+  flushIntervalMs: number; // time threshold for background flushes
+  flushOnSeverity: AuditSeverity | null; // durability policy: entries at or above this severity are written immediately
+}
+
+export interface AuditWriterStats {
+  mode: AuditWriteMode;
+  buffered: number;
+  flushes: number;
+  entriesWritten: number;
+  backPressureFlushes: number; // flushes forced because the buffer was full
+  failedFlushes: number; // flushes that did not commit; their entries stay buffered
+  lastFlushAt: string | null;
+}
+
+export const DEFAULT_AUDIT_WRITER_SETTINGS: AuditWriterSettings = {
+  mode: 'buffered',
+  bufferSize: 256,
+  flushIntervalMs: 1000,
+  flushOnSeverity: AuditSeverity.Critical,
+};
+
+export interface AuditArchiveSettings {
+  enabled: boolean;
+  archiveAfterDays: number; // entries older than this move to compressed segments
+  segmentSize: number; // entries per segment file; only full segments are written
+  maxSegmentsPerRun: number; // chunks moved per background run
+  intervalMs: number; // time between background runs
+}
+
+export interface AuditArchiveStats {
+  enabled: boolean;
+  directory: string | null;
+  segments: number;
+  entries: number;
+  bytes: number; // compressed size on disk
+  oldestTimestamp: string | null;
+  newestTimestamp: string | null;
+  lastRunAt: string | null;
+  lastRunArchived: number;
+}
+
+export const DEFAULT_AUDIT_ARCHIVE_SETTINGS: AuditArchiveSettings = {
+  enabled: true,
+  archiveAfterDays: 90,
+  segmentSize: 5000,
+  maxSegmentsPerRun: 20,
+  intervalMs: 10 * 60 * 1000,
+};
+
+/**
+ * Per-tier counts behind AuditReport and ComplianceReport. The archive
+ * keeps one per segment so reports over archived history need not
+ * decompress it.
+ */
+export interface AuditSummary {
+  total: number;
+  failures: number;
+  byCategory: Record<string, number>;
+  byAction: Record<string, number>;
+  bySeverity: Record<string, number>;
+  byUser: Record<string, { userId: number; username: string | null; count: number }>; // keyed by user id and username
+  byHour: Record<string, number>; // UTC hour of day
+}
+
 export interface AuditReport {
   totalEntries: number;
   dateRange: { start: string; end: string };
@@ -194,6 +263,18 @@ export function getActionCategory(action: AuditAction): AuditCategory {
   return AuditCategory.System;
 }
 
+const SEVERITY_RANK: Record<AuditSeverity, number> = {
+  [AuditSeverity.Info]: 0,
+  [AuditSeverity.Warning]: 1,
+  [AuditSeverity.Error]: 2,
+  [AuditSeverity.Critical]: 3,
+};
+
+// Helper function to compare severities
+export function isSeverityAtLeast(severity: AuditSeverity, threshold: AuditSeverity): boolean {
+  return SEVERITY_RANK[severity] >= SEVERITY_RANK[threshold];
+}
+
 // Helper function to determine severity
 export function getActionSeverity(action: AuditAction): AuditSeverity {
   const criticalActions = [
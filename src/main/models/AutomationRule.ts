@@ -187,6 +187,15 @@ export interface CreateAutomationLogData {
   errorMessage?: string;
 }
 
+// Automation engine dispatch settings
+export interface AutomationEngineSettings {
+  logSkipped: boolean; // write a 'skipped' log row for every non-matching rule
+}
+
+export const DEFAULT_AUTOMATION_ENGINE_SETTINGS: AutomationEngineSettings = {
+  logSkipped: false,
+};
+
 // Extended automation rule with project details
 export interface AutomationRuleWithDetails extends AutomationRule {
   projectName: string | null;
@@ -0,0 +1,65 @@
+/**
+ * Change Feed Models - Versioned entity mutations pushed to the renderer
+ */
+
+import type { Project } from './Project';
+import type { Task } from './Task';
+import type { Label } from './Label';
+import type { Comment } from './Comment';
+import type { ProjectMemberWithDetails } from './ProjectMember';
+
+/**
+ * Entity payloads carried by the feed. 'taskLabels' is keyed by task id
+ * and carries the task's full label id list.
+ */
+export interface ChangeEntityMap {
+  project: Project;
+  task: Task;
+  label: Label;
+  comment: Comment;
+  projectMember: ProjectMemberWithDetails;
+  taskLabels: number[];
+}
+
+export type ChangeEntityType = keyof ChangeEntityMap;
+
+export const CHANGE_ENTITY_TYPES: ChangeEntityType[] = ['project', 'task', 'label', 'comment', 'projectMember', 'taskLabels'];
+
+export type EntityChange = {
+  [K in ChangeEntityType]: {
+    version: number;
+    entity: K;
+    id: number;
+    projectId: number | null;
+    op: 'upsert' | 'delete';
+    data?: ChangeEntityMap[K]; // current row for upserts
+  };
+}[ChangeEntityType];
+
+/**
+ * Changes with versions in (fromVersion, toVersion]. Each entity appears
+ * at most once, with its latest state.
+ */
+export interface ChangeBatch {
+  fromVersion: number;
+  toVersion: number;
+  changes: EntityChange[];
+}
+
+/**
+ * Result of catching up from a version. `reset` means the log no longer
+ * reaches back that far and the caller must reload its data.
+ */
+export interface ChangesSinceResult extends ChangeBatch {
+  reset: boolean;
+}
+
+export interface ChangeFeedSettings {
+  pollMs: number; // how often the log is checked while someone is subscribed
+  retainVersions: number; // log entries kept for catch-up
+}
+
+export const DEFAULT_CHANGE_FEED_SETTINGS: ChangeFeedSettings = {
+  pollMs: 100,
+  retainVersions: 20000,
+};
@@ -0,0 +1,67 @@
+/**
+ * Diagnostics model: instrumentation settings and metric snapshots
+ */
+
+export interface DiagnosticsSettings {
+  enabled: boolean;
+  sampleRate: number; // fraction of IPC calls and API requests timed, 0..1
+  sqlSampleRate: number; // fraction of SQL statement executions timed, 0..1
+  traceBufferSize: number; // most recent spans kept for the Chrome trace dump
+  eventLoopResolutionMs: number; // event loop delay sampling interval
+}
+
+export const DEFAULT_DIAGNOSTICS_SETTINGS: DiagnosticsSettings = {
+  enabled: true,
+  sampleRate: 1,
+  sqlSampleRate: 0.05,
+  traceBufferSize: 10000,
+  eventLoopResolutionMs: 20,
+};
+
+/**
+ * Latency summary for one IPC channel, API route or SQL statement. Counts
+ * cover sampled calls only; divide by the sample rate for totals.
+ */
+export interface MetricSummary {
+  name: string;
+  count: number;
+  errors: number;
+  rows?: number; // SQL only: rows returned or changed
+  totalMs: number;
+  meanMs: number;
+  p50Ms: number; // estimated from histogram buckets
+  p95Ms: number;
+  maxMs: number;
+}
+
+export interface EventLoopSummary {
+  meanMs: number;
+  p50Ms: number;
+  p99Ms: number;
+  maxMs: number;
+}
+
+export interface DiagnosticsSnapshot {
+  settings: DiagnosticsSettings;
+  since: string; // when counters were last reset
+  eventLoop: EventLoopSummary | null;
+  ipc: MetricSummary[];
+  http: MetricSummary[];
+  sql: MetricSummary[];
+  traceEvents: number;
+}
+
+/**
+ * One complete ('X') event in the Chrome trace event format, viewable in
+ * chrome://tracing or Perfetto. Times are in microseconds.
+ */
+export interface TraceEvent {
+  name: string;
+  cat: 'ipc' | 'http' | 'sql';
+  ph: 'X';
+  ts: number;
+  dur: number;
+  pid: number;
+  tid: number;
+  args?: Record<string, unknown>;
+}
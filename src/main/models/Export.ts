@@ -0,0 +1,47 @@
+import { AuditFilters } from './AuditLog';
+
+export type ExportFormat = 'csv' | 'json';
+
+/**
+ * Compliance tables that can be exported
+ */
+export type ComplianceExportDataset = 'dataSubjectRequests' | 'userConsents' | 'retentionLogs' | 'legalHolds';
+
+export interface TimeEntryExportFilters {
+  startDate?: string;
+  endDate?: string;
+  userId?: number;
+  projectId?: number;
+}
+
+/**
+ * What to export. Vision boards are nested documents and export as JSON only.
+ */
+export type ExportRequest =
+  | { kind: 'audit'; filters?: AuditFilters }
+  | { kind: 'timeEntries'; filters?: TimeEntryExportFilters }
+  | { kind: 'compliance'; dataset: ComplianceExportDataset }
+  | { kind: 'visionBoard'; boardId: number };
+
+export interface ExportOptions {
+  format: ExportFormat;
+  gzip?: boolean;
+  exportId?: string; // caller-chosen, for progress events and export:cancel
+}
+
+/**
+ * Sent as 'export:progress' events while an export runs
+ */
+export interface ExportProgress {
+  exportId: string;
+  rows: number;
+  bytes: number; // written to the destination, after compression
+  done: boolean;
+}
+
+export interface ExportResult {
+  rows: number;
+  bytes: number;
+  durationMs: number;
+  filePath?: string;
+}
@@ -213,6 +213,25 @@ export interface WebhookDelivery {
   deliveredAt: Date;
 }
 
+/**
+ * Outbound webhook queue
+ */
+export interface WebhookQueueSettings {
+  pollMs: number; // minimum delay between queue scans while deliveries wait
+  batchSize: number; // deliveries claimed per endpoint at a time
+  maxConcurrentPerEndpoint: number; // requests in flight per webhook
+  maxBackoffSeconds: number; // cap on the exponential retry delay
+}
+
+export interface WebhookQueueStats {
+  queued: number;
+  due: number;
+  inFlight: number;
+  delivered: number;
+  failed: number; // attempts that failed (retried or dropped)
+  dropped: number; // deliveries that ran out of attempts
+}
+
 /**
  * Sync Job
  * Tracks synchronization operations with external systems
@@ -276,6 +295,18 @@ export interface RateLimitState {
   lastRefill: Date | null; // for token bucket
 }
 
+export interface RateLimitResult {
+  allowed: boolean;
+  resetAt: Date; // when the next request is allowed (denied) or the limit fully recovers
+  remaining: number; // -1 when no limit applies
+  limit: number;
+}
+
+export interface RateLimiterSettings {
+  checkpointMs: number; // how often in-memory state is written to rate_limit_state
+  configCacheMs: number; // how long a looked-up config (or its absence) is trusted
+}
+
 /**
  * Data Import/Export
  */
@@ -377,6 +408,13 @@ export const DEFAULT_WEBHOOK_CONFIG = {
   timeout: 30 // seconds
 };
 
+export const DEFAULT_WEBHOOK_QUEUE_SETTINGS: WebhookQueueSettings = {
+  pollMs: 1000,
+  batchSize: 20,
+  maxConcurrentPerEndpoint: 2,
+  maxBackoffSeconds: 3600
+};
+
 export const DEFAULT_RATE_LIMIT_CONFIG = {
   strategy: RateLimitStrategy.FixedWindow,
   maxRequests: 1000,
@@ -385,6 +423,11 @@ export const DEFAULT_RATE_LIMIT_CONFIG = {
   refillRate: null
 };
 
+export const DEFAULT_RATE_LIMITER_SETTINGS: RateLimiterSettings = {
+  checkpointMs: 5000,
+  configCacheMs: 60 * 1000
+};
+
 export const DEFAULT_SYNC_FREQUENCY = 60; // minutes
 
 /**
@@ -25,6 +25,40 @@ export interface CreateNotificationData {
   relatedTaskId?: number;
 }
 
+/**
+ * Changes to one user's notifications, pushed to subscribed renderers so
+ * they can patch their list instead of reloading it
+ */
+export interface NotificationDelta {
+  userId: number;
+  upserted: Notification[]; // new notifications, or coalesced ones moved to the top
+  readIds: number[];
+  unreadIds: number[];
+  removedIds: number[];
+  allRead: boolean; // every notification of the user was marked read
+  unreadCount: number;
+}
+
+/**
+ * Batching and coalescing policy for NotificationPipeline
+ */
+export interface NotificationPipelineSettings {
+  batchMs: number; // queued notifications are written together after this delay
+  coalesceWindowMs: number; // an unread duplicate newer than this is refreshed instead of repeated
+}
+
+export const DEFAULT_NOTIFICATION_PIPELINE_SETTINGS: NotificationPipelineSettings = {
+  batchMs: 50,
+  coalesceWindowMs: 5 * 60 * 1000,
+};
+
+/**
+ * Notifications with the same key are duplicates for coalescing
+ */
+export function notificationCoalesceKey(data: CreateNotificationData): string {
+  return [data.userId, data.type, data.relatedProjectId ?? '', data.relatedTaskId ?? '', data.title].join('|');
+}
+
 /**
  * Notification types
  */
@@ -63,3 +63,79 @@ export interface UpdateProjectData {
   conceptWhen?: string;
   conceptWhy?: string;
 }
+
+/**
+ * Column-oriented batch of projects; see TaskColumns
+ */
+export interface ProjectColumns {
+  length: number;
+  id: Int32Array;
+  name: string[];
+  description: (string | null)[];
+  status: ProjectStatus[];
+  color: (string | null)[];
+  icon: (string | null)[];
+  createdAt: string[];
+  updatedAt: string[];
+  conceptWhat: (string | null)[];
+  conceptHow: (string | null)[];
+  conceptWhere: (string | null)[];
+  conceptWithWhat: (string | null)[];
+  conceptWhen: (string | null)[];
+  conceptWhy: (string | null)[];
+}
+
+/**
+ * Materialize a single row of a ProjectColumns batch
+ */
+export function projectFromColumns(columns: ProjectColumns, index: number): Project {
+  return {
+    id: columns.id[index],
+    name: columns.name[index],
+    description: columns.description[index],
+    status: columns.status[index],
+    color: columns.color[index],
+    icon: columns.icon[index],
+    createdAt: columns.createdAt[index],
+    updatedAt: columns.updatedAt[index],
+    conceptWhat: columns.conceptWhat[index],
+    conceptHow: columns.conceptHow[index],
+    conceptWhere: columns.conceptWhere[index],
+    conceptWithWhat: columns.conceptWithWhat[index],
+    conceptWhen: columns.conceptWhen[index],
+    conceptWhy: columns.conceptWhy[index]
+  };
+}
+
+/**
+ * Read-only Project over one row of a ProjectColumns batch; see TaskRowView
+ */
+export class ProjectRowView implements Project {
+  constructor(private readonly columns: ProjectColumns, private readonly index: number) {}
+
+  get id(): number { return this.columns.id[this.index]; }
+  get name(): string { return this.columns.name[this.index]; }
+  get description(): string | null { return this.columns.description[this.index]; }
+  get status(): ProjectStatus { return this.columns.status[this.index]; }
+  get color(): string | null { return this.columns.color[this.index]; }
+  get icon(): string | null { return this.columns.icon[this.index]; }
+  get createdAt(): string { return this.columns.createdAt[this.index]; }
+  get updatedAt(): string { return this.columns.updatedAt[this.index]; }
+  get conceptWhat(): string | null { return this.columns.conceptWhat[this.index]; }
+  get conceptHow(): string | null { return this.columns.conceptHow[this.index]; }
+  get conceptWhere(): string | null { return this.columns.conceptWhere[this.index]; }
+  get conceptWithWhat(): string | null { return this.columns.conceptWithWhat[this.index]; }
+  get conceptWhen(): string | null { return this.columns.conceptWhen[this.index]; }
+  get conceptWhy(): string | null { return this.columns.conceptWhy[this.index]; }
+
+  toProject(): Project {
+    return projectFromColumns(this.columns, this.index);
+  }
+}
+
+/**
+ * Row views over every row of a ProjectColumns batch, in order
+ */
+export function projectRows(columns: ProjectColumns): Project[] {
+  return Array.from({ length: columns.length }, (_, index) => new ProjectRowView(columns, index));
+}
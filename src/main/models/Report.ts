@@ -216,3 +216,11 @@ export interface ReportExportData {
   data: any;
   summary?: Record<string, any>;
 }
+
+// Scheduling of report queries on the background query pool
+export type ReportPriority = 'high' | 'normal' | 'low';
+
+export interface ReportRequestOptions {
+  requestId?: string; // caller-chosen id, used to cancel the request
+  priority?: ReportPriority;
+}
@@ -0,0 +1,89 @@
+/**
+ * Search Models - Full-text search over tasks, comments and audit logs
+ */
+
+export type SearchEntityType = 'task' | 'comment' | 'audit_log';
+
+export const SEARCH_ENTITY_TYPES: SearchEntityType[] = ['task', 'comment', 'audit_log'];
+
+export interface SearchOptions {
+  query: string;
+  types?: SearchEntityType[]; // Defaults to all types
+  projectId?: number; // Restrict to one project's tasks and comments (excludes audit logs)
+  limit?: number;
+  offset?: number;
+}
+
+export interface SearchResult {
+  type: SearchEntityType;
+  id: number;
+  taskId: number | null; // The task itself, or the task a comment belongs to
+  projectId: number | null;
+  title: string;
+  snippet: string; // Matched text with hits wrapped in [ ]
+  rank: number; // bm25 score; lower is better
+  timestamp: string;
+}
+
+export interface SearchResultPage {
+  results: SearchResult[];
+  nextOffset: number | null;
+}
+
+export const DEFAULT_SEARCH_LIMIT = 50;
+export const MAX_SEARCH_LIMIT = 200;
+
+/**
+ * Split text into tokens the way the FTS tables' `unicode61
+ * remove_diacritics 2` tokenizer does: letters, digits and marks form
+ * tokens, everything else separates them, and tokens are case-folded with
+ * Latin diacritics removed. Used for search over rows without an FTS index.
+ */
+export function ftsTokens(text: string): string[] {
+  return text
+    .normalize('NFD')
+    .replace(/[\u0300-\u036f]/g, '')
+    .toLowerCase()
+    .split(/[^\p{L}\p{N}\p{M}\p{Co}]+/u)
+    .filter(token => token.length > 0);
+}
+
+/**
+ * Free-form user input as search terms: each whitespace-separated word is
+ * the token sequence FTS5 would make of it. Words without letters or
+ * digits tokenize to nothing and are dropped.
+ */
+export function toSearchTerms(input: string): string[][] {
+  return input
+    .split(/\s+/)
+    .map(ftsTokens)
+    .filter(tokens => tokens.length > 0);
+}
+
+/**
+ * Turn free-form user input into a safe FTS5 MATCH expression.
+ * Every word becomes a quoted prefix term, so operators and punctuation in
+ * the input are matched literally and "auth lo" finds "authentication login".
+ * Returns null when the input has no searchable words.
+ */
+export function toFtsMatchQuery(input: string): string | null {
+  const terms = toSearchTerms(input);
+  if (terms.length === 0) return null;
+  return terms.map(tokens => `"${tokens.join(' ')}"*`).join(' ');
+}
+
+/**
+ * Whether a term from toSearchTerms matches a column's tokens with FTS5
+ * phrase-prefix semantics: consecutive tokens, the last one as a prefix
+ */
+export function matchesSearchTerm(columnTokens: string[], term: string[]): boolean {
+  const last = term.length - 1;
+  for (let start = 0; start + last < columnTokens.length; start++) {
+    let matched = true;
+    for (let i = 0; i < last && matched; i++) {
+      matched = columnTokens[start + i] === term[i];
+    }
+    if (matched && columnTokens[start + last].startsWith(term[last])) return true;
+  }
+  return false;
+}
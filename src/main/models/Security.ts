@@ -38,7 +38,7 @@ export interface UserCredentials {
   id: number;
   userId: number;
   authProvider: AuthProvider;
-  passwordHash?: string; // bcrypt hash for local auth
+  passwordHash?: string; // scrypt (or legacy bcrypt) hash for local auth
   passwordSalt?: string;
   lastPasswordChange?: string;
   passwordExpiresAt?: string;
@@ -163,6 +163,21 @@ export interface APIKey {
   revokedBy?: number;
 }
 
+/**
+ * Scopes understood by the REST API. `write` implies `read`; `*` grants both.
+ */
+export enum APIKeyScope {
+  Read = 'read',
+  Write = 'write',
+  All = '*',
+}
+
+export function apiKeyHasScope(scopes: string[], required: APIKeyScope): boolean {
+  return scopes.includes(APIKeyScope.All)
+    || scopes.includes(required)
+    || (required === APIKeyScope.Read && scopes.includes(APIKeyScope.Write));
+}
+
 export interface SecuritySettings {
   passwordPolicy: PasswordPolicy;
   sessionTimeout: number; // Minutes
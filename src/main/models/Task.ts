@@ -69,3 +69,219 @@ export interface UpdateTaskData {
   position?: number;
   tags?: string; // JSON array of tag strings
 }
+
+/**
+ * Dictionaries for the dictionary-encoded status/priority columns of TaskColumns
+ */
+export const TASK_STATUS_VALUES: TaskStatus[] = Object.values(TaskStatus);
+export const TASK_PRIORITY_VALUES: TaskPriority[] = Object.values(TaskPriority);
+
+/**
+ * Column-oriented batch of tasks.
+ * Numeric and enum columns are typed arrays so they cross IPC as flat
+ * buffers; status/priority hold indexes into TASK_STATUS_VALUES and
+ * TASK_PRIORITY_VALUES.
+ */
+export interface TaskColumns {
+  length: number;
+  id: Int32Array;
+  projectId: Int32Array;
+  position: Float64Array;
+  status: Uint8Array;
+  priority: Uint8Array;
+  title: string[];
+  description: (string | null)[];
+  assignedTo: (string | null)[];
+  startDate: (string | null)[];
+  dueDate: (string | null)[];
+  createdAt: string[];
+  updatedAt: string[];
+  completedAt: (string | null)[];
+  tags: (string | null)[];
+}
+
+/**
+ * Materialize a single row of a TaskColumns batch
+ */
+export function taskFromColumns(columns: TaskColumns, index: number): Task {
+  return {
+    id: columns.id[index],
+    projectId: columns.projectId[index],
+    title: columns.title[index],
+    description: columns.description[index],
+    status: TASK_STATUS_VALUES[columns.status[index]],
+    priority: TASK_PRIORITY_VALUES[columns.priority[index]],
+    assignedTo: columns.assignedTo[index],
+    startDate: columns.startDate[index],
+    dueDate: columns.dueDate[index],
+    createdAt: columns.createdAt[index],
+    updatedAt: columns.updatedAt[index],
+    completedAt: columns.completedAt[index],
+    position: columns.position[index],
+    tags: columns.tags[index]
+  };
+}
+
+/**
+ * Read-only Task over one row of a TaskColumns batch. Fields are read from
+ * the columns on access, so listing a batch allocates one small view per
+ * row rather than decoding a copy of every field. The fields are getters,
+ * so spreading a view copies nothing: use toTask() for an editable copy.
+ */
+export class TaskRowView implements Task {
+  constructor(private readonly columns: TaskColumns, private readonly index: number) {}
+
+  get id(): number { return this.columns.id[this.index]; }
+  get projectId(): number { return this.columns.projectId[this.index]; }
+  get title(): string { return this.columns.title[this.index]; }
+  get description(): string | null { return this.columns.description[this.index]; }
+  get status(): TaskStatus { return TASK_STATUS_VALUES[this.columns.status[this.index]]; }
+  get priority(): TaskPriority { return TASK_PRIORITY_VALUES[this.columns.priority[this.index]]; }
+  get assignedTo(): string | null { return this.columns.assignedTo[this.index]; }
+  get startDate(): string | null { return this.columns.startDate[this.index]; }
+  get dueDate(): string | null { return this.columns.dueDate[this.index]; }
+  get createdAt(): string { return this.columns.createdAt[this.index]; }
+  get updatedAt(): string { return this.columns.updatedAt[this.index]; }
+  get completedAt(): string | null { return this.columns.completedAt[this.index]; }
+  get position(): number { return this.columns.position[this.index]; }
+  get tags(): string | null { return this.columns.tags[this.index]; }
+
+  toTask(): Task {
+    return taskFromColumns(this.columns, this.index);
+  }
+}
+
+/**
+ * Row views over every row of a TaskColumns batch, in order
+ */
+export function taskRows(columns: TaskColumns): Task[] {
+  return Array.from({ length: columns.length }, (_, index) => new TaskRowView(columns, index));
+}
+
+/**
+ * Plain, editable copy of a task, whether it is a row view or an object
+ */
+export function toTask(task: Task): Task {
+  return task instanceof TaskRowView ? task.toTask() : { ...task };
+}
+
+/**
+ * Options for keyset-paginated task listing
+ */
+export interface TaskPageOptions {
+  limit?: number;
+  after?: string | null; // opaque cursor from a previous TaskPage
+  status?: TaskStatus;
+}
+
+/**
+ * One page of tasks ordered by (position, createdAt, id)
+ */
+export interface TaskPage {
+  tasks: Task[];
+  nextCursor: string | null;
+}
+
+/**
+ * Chunk pushed to the renderer while streaming a task listing
+ */
+export interface TaskStreamChunk {
+  streamId: string;
+  tasks: Task[];
+  done: boolean;
+}
+
+/**
+ * A started task stream. The id is known before any chunk arrives, so the
+ * stream can be cancelled at any point; `done` resolves with the task count.
+ */
+export interface TaskStreamHandle {
+  streamId: string;
+  done: Promise<number>;
+}
+
+/**
+ * One entry of a bulk update: the same fields as a single update
+ */
+export interface TaskBulkUpdate {
+  id: number;
+  data: UpdateTaskData;
+}
+
+/**
+ * Target of a bulk move. Moved tasks get consecutive positions from
+ * startPosition in the order given, e.g. a Kanban column after a drop.
+ */
+export interface TaskMoveOptions {
+  status?: TaskStatus;
+  startPosition?: number;
+}
+
+export interface TaskLabelChanges {
+  add?: number[];
+  remove?: number[];
+}
+
+/**
+ * Fields of one task that changed, plus its new updatedAt
+ */
+export interface TaskDiff {
+  id: number;
+  changes: Partial<Task>;
+}
+
+/**
+ * Compact result of a bulk mutation: only tasks that actually changed are
+ * listed; ids that don't exist are reported in `missing`
+ */
+export interface TaskBulkResult {
+  diffs: TaskDiff[];
+  missing: number[];
+}
+
+/**
+ * Before/after pair recorded by a bulk mutation, used for hooks
+ */
+export interface TaskChange {
+  before: Task;
+  after: Task;
+}
+
+export interface TaskBulkLabelResult {
+  added: number;
+  removed: number;
+  missing: number[];
+}
+
+const TASK_DIFF_FIELDS: Array<keyof Task> = [
+  'title', 'description', 'status', 'priority', 'assignedTo', 'startDate',
+  'dueDate', 'updatedAt', 'completedAt', 'position', 'tags',
+];
+
+/**
+ * Fields that differ between two versions of the same task
+ */
+export function diffTask(before: Task, after: Task): Partial<Task> {
+  const changes: Partial<Task> = {};
+  for (const field of TASK_DIFF_FIELDS) {
+    if (before[field] !== after[field]) {
+      (changes as Record<string, unknown>)[field] = after[field];
+    }
+  }
+  return changes;
+}
+
+/**
+ * Reduce before/after pairs to the compact wire format. A task counts as
+ * changed when anything other than updatedAt differs.
+ */
+export function toTaskBulkResult(changes: TaskChange[], missing: number[]): TaskBulkResult {
+  const diffs: TaskDiff[] = [];
+  for (const { before, after } of changes) {
+    const diff = diffTask(before, after);
+    if (Object.keys(diff).some(field => field !== 'updatedAt')) {
+      diffs.push({ id: after.id, changes: diff });
+    }
+  }
+  return { diffs, missing };
+}
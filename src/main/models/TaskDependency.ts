@@ -36,3 +36,12 @@ export interface TaskDependencyWithDetails extends TaskDependency {
   taskTitle?: string;
   taskStatus?: string;
 }
+
+/**
+ * Longest chain of blocking dependencies in a project, ordered from the
+ * first task to start to the last one to finish
+ */
+export interface CriticalPath {
+  taskIds: number[];
+  durationDays: number;
+}
@@ -1,3 +1,6 @@
+import { Project } from './Project';
+import { Task } from './Task';
+
 /**
  * Project Template Model
  * Represents a reusable project template with predefined structure
@@ -116,3 +119,58 @@ export enum TemplateCategory {
 export interface ProjectTemplateWithTasks extends ProjectTemplate {
   tasks: TaskTemplate[];
 }
+
+/**
+ * Label defined by a project template; projects created from the template
+ * get a copy of it
+ */
+export interface TemplateLabel {
+  id: number;
+  projectTemplateId: number;
+  name: string;
+  color: string;
+  description: string | null;
+}
+
+export interface TaskTemplateLabel {
+  taskTemplateId: number;
+  templateLabelId: number;
+}
+
+export interface TaskTemplateDependency {
+  taskTemplateId: number;
+  dependsOnTaskTemplateId: number;
+  dependencyType: string;
+}
+
+/**
+ * Everything needed to instantiate a project template
+ */
+export interface ProjectTemplateBlueprint extends ProjectTemplateWithTasks {
+  labels: TemplateLabel[];
+  taskLabels: TaskTemplateLabel[];
+  dependencies: TaskTemplateDependency[];
+}
+
+/**
+ * Template content to be written in one go. Ids in `tasks` and `labels` are
+ * the caller's own keys, referenced by `taskLabels` and `dependencies`; the
+ * stored rows get fresh ids.
+ */
+export interface TemplateContent {
+  tasks: Array<Omit<TaskTemplate, 'projectTemplateId'>>;
+  labels: Array<Omit<TemplateLabel, 'projectTemplateId'>>;
+  taskLabels: TaskTemplateLabel[];
+  dependencies: TaskTemplateDependency[];
+}
+
+/**
+ * What instantiating a project template created, for firing hooks once
+ * after the transaction commits
+ */
+export interface TemplateInstantiation {
+  project: Project;
+  tasks: Task[];
+  labelPairs: Array<{ task: Task; labelId: number }>;
+  dependencyCount: number;
+}
@@ -292,6 +292,37 @@ export interface UpdateVisionBoardGroupData {
   collapsed?: boolean;
 }
 
+/**
+ * Rectangle in board coordinates
+ */
+export interface VisionBoardViewport {
+  x: number;
+  y: number;
+  width: number;
+  height: number;
+}
+
+/**
+ * The part of a board around a viewport: nodes whose bounds intersect
+ * `region`, the connections touching them and all groups
+ */
+export interface VisionBoardViewportData {
+  board: VisionBoard;
+  region: VisionBoardViewport;
+  extent: VisionBoardViewport | null; // bounds of every node on the board
+  nodes: VisionBoardNode[];
+  connections: VisionBoardConnection[];
+  groups: VisionBoardGroup[];
+}
+
+/**
+ * Delta applied to one node through the board's operation log
+ */
+export type VisionBoardOperation =
+  | { type: 'move'; nodeId: number; x: number; y: number }
+  | { type: 'update'; nodeId: number; changes: UpdateVisionBoardNodeData }
+  | { type: 'delete'; nodeId: number };
+
 /**
  * Default values
  */
@@ -308,6 +339,13 @@ export const DEFAULT_FONT_FAMILY = 'Inter, sans-serif';
 export const DEFAULT_BORDER_WIDTH = 2;
 export const DEFAULT_BORDER_RADIUS = 8;
 
+// Extra area loaded around the visible viewport, as a fraction of its size per side
+export const VIEWPORT_MARGIN = 0.5;
+// Pending operation log entries are folded into the node rows after this long
+export const OP_LOG_COMPACT_MS = 2000;
+// ...or once this many nodes of one board have pending deltas
+export const OP_LOG_COMPACT_NODES = 500;
+
 export const SHAPE_PRESETS: Record<ShapeType, Partial<VisionBoardNode>> = {
   [ShapeType.Rectangle]: {
     borderRadius: 8,
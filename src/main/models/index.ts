@@ -23,3 +23,7 @@ export * from './Integration';
 export * from './WhiteLabel';
 export * from './Compliance';
 export * from './VisionBoard';
+export * from './Search';
+export * from './ChangeFeed';
+export * from './Export';
+export * from './Diagnostics';
@@ -1,5 +1,6 @@
 import Database from 'better-sqlite3';
 import { Attachment, CreateAttachmentData } from '../models/Attachment';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for attachments table
@@ -31,7 +32,7 @@ export class AttachmentRepository {
   create(data: CreateAttachmentData): Attachment {
     const now = new Date().toISOString();
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO attachments (
         task_id, file_name, file_path, file_size,
         mime_type, uploaded_by, uploaded_at
@@ -59,7 +60,7 @@ export class AttachmentRepository {
    * Find attachment by ID
    */
   findById(id: number): Attachment | undefined {
-    const stmt = this.db.prepare('SELECT * FROM attachments WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM attachments WHERE id = ?');
     const row = stmt.get(id) as AttachmentRow | undefined;
     return row ? this.mapRowToAttachment(row) : undefined;
   }
@@ -68,7 +69,7 @@ export class AttachmentRepository {
    * Find all attachments for a task
    */
   findByTaskId(taskId: number): Attachment[] {
-    const stmt = this.db.prepare('SELECT * FROM attachments WHERE task_id = ? ORDER BY uploaded_at DESC');
+    const stmt = prepareCached(this.db, 'SELECT * FROM attachments WHERE task_id = ? ORDER BY uploaded_at DESC');
     const rows = stmt.all(taskId) as AttachmentRow[];
     return rows.map(row => this.mapRowToAttachment(row));
   }
@@ -77,7 +78,7 @@ export class AttachmentRepository {
    * Delete an attachment
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM attachments WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM attachments WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
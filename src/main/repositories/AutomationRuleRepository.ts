@@ -11,6 +11,7 @@ import {
   TriggerConfig,
   ActionConfig
 } from '../models/AutomationRule';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for automation_rules table
@@ -64,18 +65,38 @@ interface RuleStatsRow {
   last_executed: string | null;
 }
 
+// Listing queries below are also planned by database/queryPlanCheck.ts
+export const AUTOMATION_RULES_BY_PROJECT_SQL = 'SELECT * FROM automation_rules WHERE project_id = ? ORDER BY created_at DESC';
+
+export const AUTOMATION_LOGS_BY_RULE_SQL = 'SELECT * FROM automation_logs WHERE rule_id = ? ORDER BY executed_at DESC LIMIT ?';
+
 /**
  * Repository for automation rules and logs
  */
 export class AutomationRuleRepository {
+  private changeListeners: Array<() => void> = [];
+
   constructor(private db: Database.Database) {}
 
+  /**
+   * Subscribe to rule create/update/delete, e.g. to invalidate a rule cache
+   */
+  onRulesChanged(listener: () => void): void {
+    this.changeListeners.push(listener);
+  }
+
+  private notifyRulesChanged(): void {
+    for (const listener of this.changeListeners) {
+      listener();
+    }
+  }
+
   /**
    * Create a new automation rule
    */
   create(data: CreateAutomationRuleData): AutomationRule {
     const now = new Date().toISOString();
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO automation_rules (
         name, description, project_id, is_active, trigger_type, trigger_config,
         action_type, action_config, created_by, created_at, updated_at, execution_count
@@ -95,6 +116,7 @@ export class AutomationRuleRepository {
       now,
       now
     );
+    this.notifyRulesChanged();
 
     const created = this.findById(result.lastInsertRowid as number);
     if (!created) {
@@ -107,7 +129,7 @@ export class AutomationRuleRepository {
    * Find automation rule by ID
    */
   findById(id: number): AutomationRule | null {
-    const stmt = this.db.prepare('SELECT * FROM automation_rules WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM automation_rules WHERE id = ?');
     const row = stmt.get(id) as AutomationRuleRow | undefined;
     return row ? this.mapRowToAutomationRule(row) : null;
   }
@@ -116,7 +138,7 @@ export class AutomationRuleRepository {
    * Find all automation rules
    */
   findAll(): AutomationRule[] {
-    const stmt = this.db.prepare('SELECT * FROM automation_rules ORDER BY created_at DESC');
+    const stmt = prepareCached(this.db, 'SELECT * FROM automation_rules ORDER BY created_at DESC');
     const rows = stmt.all() as AutomationRuleRow[];
     return rows.map(row => this.mapRowToAutomationRule(row));
   }
@@ -125,7 +147,7 @@ export class AutomationRuleRepository {
    * Find automation rules by project ID
    */
   findByProjectId(projectId: number): AutomationRule[] {
-    const stmt = this.db.prepare('SELECT * FROM automation_rules WHERE project_id = ? ORDER BY created_at DESC');
+    const stmt = prepareCached(this.db, AUTOMATION_RULES_BY_PROJECT_SQL);
     const rows = stmt.all(projectId) as AutomationRuleRow[];
     return rows.map(row => this.mapRowToAutomationRule(row));
   }
@@ -134,7 +156,7 @@ export class AutomationRuleRepository {
    * Find global automation rules (no specific project)
    */
   findGlobalRules(): AutomationRule[] {
-    const stmt = this.db.prepare('SELECT * FROM automation_rules WHERE project_id IS NULL ORDER BY created_at DESC');
+    const stmt = prepareCached(this.db, 'SELECT * FROM automation_rules WHERE project_id IS NULL ORDER BY created_at DESC');
     const rows = stmt.all() as AutomationRuleRow[];
     return rows.map(row => this.mapRowToAutomationRule(row));
   }
@@ -153,7 +175,7 @@ export class AutomationRuleRepository {
 
     query += ' ORDER BY created_at DESC';
 
-    const stmt = this.db.prepare(query);
+    const stmt = prepareCached(this.db, query);
     const rows = stmt.all(...params) as AutomationRuleRow[];
     return rows.map(row => this.mapRowToAutomationRule(row));
   }
@@ -162,7 +184,7 @@ export class AutomationRuleRepository {
    * Find automation rule with project and creator details
    */
   findByIdWithDetails(id: number): AutomationRuleWithDetails | null {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         ar.*,
         p.name as project_name,
@@ -181,7 +203,7 @@ export class AutomationRuleRepository {
    * Find all automation rules with details
    */
   findAllWithDetails(): AutomationRuleWithDetails[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         ar.*,
         p.name as project_name,
@@ -200,7 +222,7 @@ export class AutomationRuleRepository {
    * Find automation rules by project with details
    */
   findByProjectIdWithDetails(projectId: number): AutomationRuleWithDetails[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         ar.*,
         p.name as project_name,
@@ -260,10 +282,11 @@ export class AutomationRuleRepository {
     values.push(new Date().toISOString());
     values.push(id);
 
-    const stmt = this.db.prepare(
+    const stmt = prepareCached(this.db,
       `UPDATE automation_rules SET ${updates.join(', ')} WHERE id = ?`
     );
     stmt.run(...values);
+    this.notifyRulesChanged();
 
     return this.findById(id);
   }
@@ -282,7 +305,7 @@ export class AutomationRuleRepository {
    * Record rule execution
    */
   recordExecution(id: number): void {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE automation_rules 
       SET last_executed_at = ?, execution_count = execution_count + 1, updated_at = ?
       WHERE id = ?
@@ -295,18 +318,39 @@ export class AutomationRuleRepository {
    * Delete automation rule
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM automation_rules WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM automation_rules WHERE id = ?');
     const result = stmt.run(id);
+    if (result.changes > 0) {
+      this.notifyRulesChanged();
+    }
     return result.changes > 0;
   }
 
+  /**
+   * Record one execution for each rule id in a single transaction
+   */
+  recordExecutions(ids: number[]): void {
+    if (ids.length === 0) return;
+    const stmt = prepareCached(this.db, `
+      UPDATE automation_rules 
+      SET last_executed_at = ?, execution_count = execution_count + 1, updated_at = ?
+      WHERE id = ?
+    `);
+    const now = new Date().toISOString();
+    this.db.transaction(() => {
+      for (const id of ids) {
+        stmt.run(now, now, id);
+      }
+    })();
+  }
+
   // ===== AUTOMATION LOGS =====
 
   /**
    * Create automation log entry
    */
   createLog(data: CreateAutomationLogData): AutomationLog {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO automation_logs (
         rule_id, trigger_data, action_data, status, error_message, executed_at
       ) VALUES (?, ?, ?, ?, ?, ?)
@@ -328,11 +372,37 @@ export class AutomationRuleRepository {
     return created;
   }
 
+  /**
+   * Insert several log entries in a single transaction without reading
+   * them back
+   */
+  createLogs(entries: CreateAutomationLogData[]): void {
+    if (entries.length === 0) return;
+    const stmt = prepareCached(this.db, `
+      INSERT INTO automation_logs (
+        rule_id, trigger_data, action_data, status, error_message, executed_at
+      ) VALUES (?, ?, ?, ?, ?, ?)
+    `);
+    const now = new Date().toISOString();
+    this.db.transaction(() => {
+      for (const data of entries) {
+        stmt.run(
+          data.ruleId,
+          JSON.stringify(data.triggerData),
+          JSON.stringify(data.actionData),
+          data.status,
+          data.errorMessage || null,
+          now
+        );
+      }
+    })();
+  }
+
   /**
    * Find log by ID
    */
   findLogById(id: number): AutomationLog | null {
-    const stmt = this.db.prepare('SELECT * FROM automation_logs WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM automation_logs WHERE id = ?');
     const row = stmt.get(id) as AutomationLogRow | undefined;
     return row ? this.mapRowToAutomationLog(row) : null;
   }
@@ -341,12 +411,7 @@ export class AutomationRuleRepository {
    * Find logs by rule ID
    */
   findLogsByRuleId(ruleId: number, limit: number = 100): AutomationLog[] {
-    const stmt = this.db.prepare(`
-      SELECT * FROM automation_logs
-      WHERE rule_id = ?
-      ORDER BY executed_at DESC
-      LIMIT ?
-    `);
+    const stmt = prepareCached(this.db, AUTOMATION_LOGS_BY_RULE_SQL);
     const rows = stmt.all(ruleId, limit) as AutomationLogRow[];
     return rows.map(row => this.mapRowToAutomationLog(row));
   }
@@ -355,7 +420,7 @@ export class AutomationRuleRepository {
    * Find recent logs
    */
   findRecentLogs(limit: number = 100): AutomationLog[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT * FROM automation_logs
       ORDER BY executed_at DESC
       LIMIT ?
@@ -374,7 +439,7 @@ export class AutomationRuleRepository {
     skippedCount: number;
     lastExecutedAt: string | null;
   } {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         COUNT(*) as total,
         SUM(CASE WHEN status = 'success' THEN 1 ELSE 0 END) as success,
@@ -403,7 +468,7 @@ export class AutomationRuleRepository {
     const cutoffDate = new Date();
     cutoffDate.setDate(cutoffDate.getDate() - daysOld);
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       DELETE FROM automation_logs 
       WHERE executed_at < ?
     `);
@@ -1,5 +1,6 @@
 import Database from 'better-sqlite3';
 import { Comment, CreateCommentData, UpdateCommentData } from '../models/Comment';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for comments table
@@ -13,6 +14,9 @@ interface CommentRow {
   updated_at: string;
 }
 
+// Also planned by database/queryPlanCheck.ts
+export const COMMENTS_BY_TASK_SQL = 'SELECT * FROM comments WHERE task_id = ? ORDER BY created_at DESC';
+
 /**
  * Repository for Comment CRUD operations
  */
@@ -29,7 +33,7 @@ export class CommentRepository {
   create(data: CreateCommentData): Comment {
     const now = new Date().toISOString();
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO comments (task_id, author, content, created_at, updated_at)
       VALUES (?, ?, ?, ?, ?)
     `);
@@ -53,7 +57,7 @@ export class CommentRepository {
    * Find comment by ID
    */
   findById(id: number): Comment | undefined {
-    const stmt = this.db.prepare('SELECT * FROM comments WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM comments WHERE id = ?');
     const row = stmt.get(id) as CommentRow | undefined;
     return row ? this.mapRowToComment(row) : undefined;
   }
@@ -62,7 +66,7 @@ export class CommentRepository {
    * Find all comments for a task
    */
   findByTaskId(taskId: number): Comment[] {
-    const stmt = this.db.prepare('SELECT * FROM comments WHERE task_id = ? ORDER BY created_at DESC');
+    const stmt = prepareCached(this.db, COMMENTS_BY_TASK_SQL);
     const rows = stmt.all(taskId) as CommentRow[];
     return rows.map(row => this.mapRowToComment(row));
   }
@@ -73,7 +77,7 @@ export class CommentRepository {
   update(id: number, data: UpdateCommentData): Comment | undefined {
     const now = new Date().toISOString();
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE comments SET content = ?, updated_at = ? WHERE id = ?
     `);
     stmt.run(data.content, now, id);
@@ -85,7 +89,7 @@ export class CommentRepository {
    * Delete a comment
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM comments WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM comments WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
@@ -6,6 +6,7 @@ import {
   TaskCustomValue,
   CustomFieldType
 } from '../models/CustomField';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for custom_fields table
@@ -45,7 +46,7 @@ export class CustomFieldRepository {
   create(data: CreateCustomFieldData): CustomField {
     const now = new Date().toISOString();
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO custom_fields (
         project_id, name, field_type, options, required, created_at
       ) VALUES (?, ?, ?, ?, ?, ?)
@@ -71,7 +72,7 @@ export class CustomFieldRepository {
    * Find custom field by ID
    */
   findById(id: number): CustomField | undefined {
-    const stmt = this.db.prepare('SELECT * FROM custom_fields WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM custom_fields WHERE id = ?');
     const row = stmt.get(id) as CustomFieldRow | undefined;
     return row ? this.mapRowToCustomField(row) : undefined;
   }
@@ -80,7 +81,7 @@ export class CustomFieldRepository {
    * Find all custom fields for a project
    */
   findByProjectId(projectId: number): CustomField[] {
-    const stmt = this.db.prepare('SELECT * FROM custom_fields WHERE project_id = ? ORDER BY name');
+    const stmt = prepareCached(this.db, 'SELECT * FROM custom_fields WHERE project_id = ? ORDER BY name');
     const rows = stmt.all(projectId) as CustomFieldRow[];
     return rows.map(row => this.mapRowToCustomField(row));
   }
@@ -111,7 +112,7 @@ export class CustomFieldRepository {
 
     values.push(id);
 
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE custom_fields SET ${updates.join(', ')} WHERE id = ?
     `);
     stmt.run(...values);
@@ -123,7 +124,7 @@ export class CustomFieldRepository {
    * Delete a custom field
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM custom_fields WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM custom_fields WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
@@ -132,7 +133,7 @@ export class CustomFieldRepository {
    * Set custom field value for a task
    */
   setTaskValue(taskId: number, customFieldId: number, value: string): void {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT OR REPLACE INTO task_custom_values (task_id, custom_field_id, value)
       VALUES (?, ?, ?)
     `);
@@ -143,7 +144,7 @@ export class CustomFieldRepository {
    * Get custom field value for a task
    */
   getTaskValue(taskId: number, customFieldId: number): string | undefined {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT value FROM task_custom_values WHERE task_id = ? AND custom_field_id = ?
     `);
     const row = stmt.get(taskId, customFieldId) as { value: string } | undefined;
@@ -154,7 +155,7 @@ export class CustomFieldRepository {
    * Get all custom field values for a task
    */
   getTaskValues(taskId: number): TaskCustomValue[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT task_id, custom_field_id, value
       FROM task_custom_values
       WHERE task_id = ?
@@ -171,7 +172,7 @@ export class CustomFieldRepository {
    * Delete custom field value for a task
    */
   deleteTaskValue(taskId: number, customFieldId: number): void {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       DELETE FROM task_custom_values WHERE task_id = ? AND custom_field_id = ?
     `);
     stmt.run(taskId, customFieldId);
@@ -1,5 +1,6 @@
 import Database from 'better-sqlite3';
 import { Label, CreateLabelData, UpdateLabelData } from '../models/Label';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for labels table
@@ -13,6 +14,9 @@ interface LabelRow {
   created_at: string;
 }
 
+// Also planned by database/queryPlanCheck.ts
+export const LABELS_BY_PROJECT_SQL = 'SELECT * FROM labels WHERE project_id = ? ORDER BY name';
+
 /**
  * Repository for Label CRUD operations
  */
@@ -29,7 +33,7 @@ export class LabelRepository {
   create(data: CreateLabelData): Label {
     const now = new Date().toISOString();
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO labels (project_id, name, color, description, created_at)
       VALUES (?, ?, ?, ?, ?)
     `);
@@ -53,7 +57,7 @@ export class LabelRepository {
    * Find label by ID
    */
   findById(id: number): Label | undefined {
-    const stmt = this.db.prepare('SELECT * FROM labels WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM labels WHERE id = ?');
     const row = stmt.get(id) as LabelRow | undefined;
     return row ? this.mapRowToLabel(row) : undefined;
   }
@@ -62,7 +66,7 @@ export class LabelRepository {
    * Find all labels for a project
    */
   findByProjectId(projectId: number): Label[] {
-    const stmt = this.db.prepare('SELECT * FROM labels WHERE project_id = ? ORDER BY name');
+    const stmt = prepareCached(this.db, LABELS_BY_PROJECT_SQL);
     const rows = stmt.all(projectId) as LabelRow[];
     return rows.map(row => this.mapRowToLabel(row));
   }
@@ -93,7 +97,7 @@ export class LabelRepository {
 
     values.push(id);
 
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE labels SET ${updates.join(', ')} WHERE id = ?
     `);
     stmt.run(...values);
@@ -105,7 +109,7 @@ export class LabelRepository {
    * Delete a label
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM labels WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM labels WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
@@ -115,7 +119,7 @@ export class LabelRepository {
    */
   addToTask(taskId: number, labelId: number): boolean {
     try {
-      const stmt = this.db.prepare(`
+      const stmt = prepareCached(this.db, `
         INSERT INTO task_labels (task_id, label_id)
         VALUES (?, ?)
       `);
@@ -131,7 +135,7 @@ export class LabelRepository {
    * Remove a label from a task
    */
   removeFromTask(taskId: number, labelId: number): boolean {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       DELETE FROM task_labels
       WHERE task_id = ? AND label_id = ?
     `);
@@ -143,7 +147,7 @@ export class LabelRepository {
    * Get all labels for a task
    */
   findByTaskId(taskId: number): Label[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT l.* FROM labels l
       INNER JOIN task_labels tl ON l.id = tl.label_id
       WHERE tl.task_id = ?
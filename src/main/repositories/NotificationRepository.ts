@@ -1,5 +1,6 @@
 import Database from 'better-sqlite3';
 import { Notification, CreateNotificationData, NotificationType } from '../models/Notification';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for notifications table
@@ -18,6 +19,21 @@ interface NotificationRow {
   read_at: string | null;
 }
 
+// Rows per multi-row INSERT; 8 parameters each stays well under SQLite's variable limit
+const INSERT_BATCH_ROWS = 200;
+
+// Listing queries below are also planned by database/queryPlanCheck.ts
+
+/**
+ * findByUserId / findUnreadByUserId query; `limit` must already be validated
+ */
+export function notificationsByUserSql(unreadOnly: boolean, limit?: number): string {
+  return `SELECT * FROM notifications WHERE user_id = ?${unreadOnly ? ' AND is_read = 0' : ''}`
+    + ` ORDER BY created_at DESC${limit ? ` LIMIT ${limit}` : ''}`;
+}
+
+export const UNREAD_NOTIFICATION_COUNT_SQL = 'SELECT COUNT(*) as count FROM notifications WHERE user_id = ? AND is_read = 0';
+
 /**
  * Repository for managing notifications
  */
@@ -43,7 +59,7 @@ export class NotificationRepository {
    */
   create(data: CreateNotificationData): Notification {
     const now = new Date().toISOString();
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO notifications (
         user_id, type, title, message, link, 
         related_project_id, related_task_id, is_read, created_at
@@ -74,7 +90,7 @@ export class NotificationRepository {
    */
   createBulk(notifications: CreateNotificationData[]): number {
     const now = new Date().toISOString();
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO notifications (
         user_id, type, title, message, link, 
         related_project_id, related_task_id, is_read, created_at
@@ -101,11 +117,92 @@ export class NotificationRepository {
     return notifications.length;
   }
 
+  /**
+   * Write a batch in one transaction: `inserts` become new rows with
+   * multi-row INSERTs, and each of `refreshes` moves an existing unread row
+   * to the top with a new message. Refreshes whose row was read or deleted
+   * in the meantime are inserted as new rows instead.
+   * Returns the written notifications in input order (refreshes first).
+   */
+  writeBatch(
+    inserts: CreateNotificationData[],
+    refreshes: Array<{ id: number; data: CreateNotificationData }> = []
+  ): Notification[] {
+    const now = new Date().toISOString();
+    const refresh = prepareCached(this.db, `
+      UPDATE notifications SET message = ?, link = ?, created_at = ?
+      WHERE id = ? AND is_read = 0
+      RETURNING *
+    `);
+
+    return this.db.transaction(() => {
+      const written: Notification[] = [];
+      const pending = [...inserts];
+
+      for (const { id, data } of refreshes) {
+        const row = refresh.get(data.message, data.link || null, now, id) as NotificationRow | undefined;
+        if (row) {
+          written.push(this.mapRowToNotification(row));
+        } else {
+          pending.push(data);
+        }
+      }
+
+      for (let start = 0; start < pending.length; start += INSERT_BATCH_ROWS) {
+        const chunk = pending.slice(start, start + INSERT_BATCH_ROWS);
+        const params: any[] = [];
+        for (const data of chunk) {
+          params.push(
+            data.userId,
+            data.type,
+            data.title,
+            data.message,
+            data.link || null,
+            data.relatedProjectId || null,
+            data.relatedTaskId || null,
+            now
+          );
+        }
+        // Full chunks share one cached statement; only the tail differs
+        const rows = prepareCached(this.db, `
+          INSERT INTO notifications (
+            user_id, type, title, message, link,
+            related_project_id, related_task_id, is_read, created_at
+          )
+          VALUES ${chunk.map(() => '(?, ?, ?, ?, ?, ?, ?, 0, ?)').join(', ')}
+          RETURNING *
+        `).all(...params) as NotificationRow[];
+        written.push(...rows.map(row => this.mapRowToNotification(row)));
+      }
+
+      return written;
+    })();
+  }
+
+  /**
+   * Unread counts for several users in one query
+   */
+  getUnreadCounts(userIds: number[]): Map<number, number> {
+    const counts = new Map<number, number>(userIds.map(userId => [userId, 0]));
+    if (userIds.length === 0) return counts;
+
+    const rows = prepareCached(this.db, `
+      SELECT user_id, COUNT(*) AS count FROM notifications
+      WHERE is_read = 0 AND user_id IN (SELECT value FROM json_each(?))
+      GROUP BY user_id
+    `).all(JSON.stringify(userIds)) as Array<{ user_id: number; count: number }>;
+
+    for (const row of rows) {
+      counts.set(row.user_id, row.count);
+    }
+    return counts;
+  }
+
   /**
    * Find notification by ID
    */
   findById(id: number): Notification | undefined {
-    const stmt = this.db.prepare('SELECT * FROM notifications WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM notifications WHERE id = ?');
     const row = stmt.get(id) as NotificationRow | undefined;
     return row ? this.mapRowToNotification(row) : undefined;
   }
@@ -114,14 +211,7 @@ export class NotificationRepository {
    * Find all notifications for a user
    */
   findByUserId(userId: number, limit?: number): Notification[] {
-    const validatedLimit = this.validateLimit(limit);
-    const limitClause = validatedLimit ? `LIMIT ${validatedLimit}` : '';
-    const stmt = this.db.prepare(`
-      SELECT * FROM notifications
-      WHERE user_id = ?
-      ORDER BY created_at DESC
-      ${limitClause}
-    `);
+    const stmt = prepareCached(this.db, notificationsByUserSql(false, this.validateLimit(limit)));
     const rows = stmt.all(userId) as NotificationRow[];
     return rows.map(row => this.mapRowToNotification(row));
   }
@@ -130,14 +220,7 @@ export class NotificationRepository {
    * Find unread notifications for a user
    */
   findUnreadByUserId(userId: number, limit?: number): Notification[] {
-    const validatedLimit = this.validateLimit(limit);
-    const limitClause = validatedLimit ? `LIMIT ${validatedLimit}` : '';
-    const stmt = this.db.prepare(`
-      SELECT * FROM notifications
-      WHERE user_id = ? AND is_read = 0
-      ORDER BY created_at DESC
-      ${limitClause}
-    `);
+    const stmt = prepareCached(this.db, notificationsByUserSql(true, this.validateLimit(limit)));
     const rows = stmt.all(userId) as NotificationRow[];
     return rows.map(row => this.mapRowToNotification(row));
   }
@@ -146,10 +229,7 @@ export class NotificationRepository {
    * Get unread count for a user
    */
   getUnreadCount(userId: number): number {
-    const stmt = this.db.prepare(`
-      SELECT COUNT(*) as count FROM notifications 
-      WHERE user_id = ? AND is_read = 0
-    `);
+    const stmt = prepareCached(this.db, UNREAD_NOTIFICATION_COUNT_SQL);
     const row = stmt.get(userId) as { count: number };
     return row.count;
   }
@@ -158,7 +238,7 @@ export class NotificationRepository {
    * Mark notification as read
    */
   markAsRead(id: number): boolean {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE notifications 
       SET is_read = 1, read_at = ? 
       WHERE id = ?
@@ -171,7 +251,7 @@ export class NotificationRepository {
    * Mark all notifications as read for a user
    */
   markAllAsRead(userId: number): number {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE notifications 
       SET is_read = 1, read_at = ? 
       WHERE user_id = ? AND is_read = 0
@@ -184,7 +264,7 @@ export class NotificationRepository {
    * Mark notification as unread
    */
   markAsUnread(id: number): boolean {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE notifications 
       SET is_read = 0, read_at = NULL 
       WHERE id = ?
@@ -197,7 +277,7 @@ export class NotificationRepository {
    * Delete notification
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM notifications WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM notifications WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
@@ -206,7 +286,7 @@ export class NotificationRepository {
    * Delete all notifications for a user
    */
   deleteAllByUserId(userId: number): number {
-    const stmt = this.db.prepare('DELETE FROM notifications WHERE user_id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM notifications WHERE user_id = ?');
     const result = stmt.run(userId);
     return result.changes;
   }
@@ -219,7 +299,7 @@ export class NotificationRepository {
     cutoffDate.setDate(cutoffDate.getDate() - daysOld);
     const cutoffISO = cutoffDate.toISOString();
 
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       DELETE FROM notifications 
       WHERE is_read = 1 AND created_at < ?
     `);
@@ -233,7 +313,7 @@ export class NotificationRepository {
   findByType(userId: number, type: NotificationType, limit?: number): Notification[] {
     const validatedLimit = this.validateLimit(limit);
     const limitClause = validatedLimit ? `LIMIT ${validatedLimit}` : '';
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT * FROM notifications
       WHERE user_id = ? AND type = ?
       ORDER BY created_at DESC
@@ -249,7 +329,7 @@ export class NotificationRepository {
   findByProjectId(userId: number, projectId: number, limit?: number): Notification[] {
     const validatedLimit = this.validateLimit(limit);
     const limitClause = validatedLimit ? `LIMIT ${validatedLimit}` : '';
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT * FROM notifications
       WHERE user_id = ? AND related_project_id = ?
       ORDER BY created_at DESC
@@ -265,7 +345,7 @@ export class NotificationRepository {
   findByTaskId(userId: number, taskId: number, limit?: number): Notification[] {
     const validatedLimit = this.validateLimit(limit);
     const limitClause = validatedLimit ? `LIMIT ${validatedLimit}` : '';
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT * FROM notifications
       WHERE user_id = ? AND related_task_id = ?
       ORDER BY created_at DESC
@@ -1,5 +1,6 @@
 import Database from 'better-sqlite3';
 import { Permission, CreatePermissionData } from '../models/Permission';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for permissions table
@@ -17,14 +18,29 @@ interface PermissionRow {
  * Repository for managing permissions
  */
 export class PermissionRepository {
+  private changeListeners: Array<() => void> = [];
+
   constructor(private db: Database.Database) {}
 
+  /**
+   * Subscribe to permission create/delete, e.g. to invalidate a permission cache
+   */
+  onPermissionsChanged(listener: () => void): void {
+    this.changeListeners.push(listener);
+  }
+
+  private notifyPermissionsChanged(): void {
+    for (const listener of this.changeListeners) {
+      listener();
+    }
+  }
+
   /**
    * Create a new permission
    */
   create(data: CreatePermissionData): Permission {
     const now = new Date().toISOString();
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO permissions (name, resource, action, description, created_at)
       VALUES (?, ?, ?, ?, ?)
     `);
@@ -41,6 +57,7 @@ export class PermissionRepository {
     if (!created) {
       throw new Error('Failed to retrieve created permission');
     }
+    this.notifyPermissionsChanged();
     return created;
   }
 
@@ -48,7 +65,7 @@ export class PermissionRepository {
    * Find permission by ID
    */
   findById(id: number): Permission | undefined {
-    const stmt = this.db.prepare('SELECT * FROM permissions WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM permissions WHERE id = ?');
     const row = stmt.get(id) as PermissionRow | undefined;
     return row ? this.mapRowToPermission(row) : undefined;
   }
@@ -57,7 +74,7 @@ export class PermissionRepository {
    * Find permission by name
    */
   findByName(name: string): Permission | undefined {
-    const stmt = this.db.prepare('SELECT * FROM permissions WHERE name = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM permissions WHERE name = ?');
     const row = stmt.get(name) as PermissionRow | undefined;
     return row ? this.mapRowToPermission(row) : undefined;
   }
@@ -66,7 +83,7 @@ export class PermissionRepository {
    * Find all permissions
    */
   findAll(): Permission[] {
-    const stmt = this.db.prepare('SELECT * FROM permissions ORDER BY resource, action');
+    const stmt = prepareCached(this.db, 'SELECT * FROM permissions ORDER BY resource, action');
     const rows = stmt.all() as PermissionRow[];
     return rows.map(row => this.mapRowToPermission(row));
   }
@@ -75,7 +92,7 @@ export class PermissionRepository {
    * Find permissions by resource
    */
   findByResource(resource: string): Permission[] {
-    const stmt = this.db.prepare('SELECT * FROM permissions WHERE resource = ? ORDER BY action');
+    const stmt = prepareCached(this.db, 'SELECT * FROM permissions WHERE resource = ? ORDER BY action');
     const rows = stmt.all(resource) as PermissionRow[];
     return rows.map(row => this.mapRowToPermission(row));
   }
@@ -84,8 +101,9 @@ export class PermissionRepository {
    * Delete permission
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM permissions WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM permissions WHERE id = ?');
     const result = stmt.run(id);
+    if (result.changes > 0) this.notifyPermissionsChanged();
     return result.changes > 0;
   }
 
@@ -2,6 +2,7 @@ import Database from 'better-sqlite3';
 import { ProjectMember, ProjectMemberWithDetails, CreateProjectMemberData } from '../models/ProjectMember';
 import { User } from '../models/User';
 import { Role } from '../models/Role';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for project_members table
@@ -62,14 +63,30 @@ interface CountRow {
  * Repository for managing project members
  */
 export class ProjectMemberRepository {
+  private changeListeners: Array<(projectId: number, userId: number) => void> = [];
+
   constructor(private db: Database.Database) {}
 
+  /**
+   * Subscribe to membership and member role changes, e.g. to invalidate a
+   * permission cache
+   */
+  onMembersChanged(listener: (projectId: number, userId: number) => void): void {
+    this.changeListeners.push(listener);
+  }
+
+  private notifyMembersChanged(projectId: number, userId: number): void {
+    for (const listener of this.changeListeners) {
+      listener(projectId, userId);
+    }
+  }
+
   /**
    * Create a new project member
    */
   create(data: CreateProjectMemberData): ProjectMember {
     const now = new Date().toISOString();
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO project_members (project_id, user_id, role_id, added_at, added_by)
       VALUES (?, ?, ?, ?, ?)
     `);
@@ -86,6 +103,7 @@ export class ProjectMemberRepository {
     if (!created) {
       throw new Error('Failed to retrieve created project member');
     }
+    this.notifyMembersChanged(created.projectId, created.userId);
     return created;
   }
 
@@ -93,7 +111,7 @@ export class ProjectMemberRepository {
    * Find project member by ID
    */
   findById(id: number): ProjectMember | undefined {
-    const stmt = this.db.prepare('SELECT * FROM project_members WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM project_members WHERE id = ?');
     const row = stmt.get(id) as ProjectMemberRow | undefined;
     return row ? this.mapRowToProjectMember(row) : undefined;
   }
@@ -102,7 +120,7 @@ export class ProjectMemberRepository {
    * Find project members by project ID
    */
   findByProjectId(projectId: number): ProjectMember[] {
-    const stmt = this.db.prepare('SELECT * FROM project_members WHERE project_id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM project_members WHERE project_id = ?');
     const rows = stmt.all(projectId) as ProjectMemberRow[];
     return rows.map(this.mapRowToProjectMember);
   }
@@ -111,7 +129,7 @@ export class ProjectMemberRepository {
    * Find project members by user ID
    */
   findByUserId(userId: number): ProjectMember[] {
-    const stmt = this.db.prepare('SELECT * FROM project_members WHERE user_id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM project_members WHERE user_id = ?');
     const rows = stmt.all(userId) as ProjectMemberRow[];
     return rows.map(this.mapRowToProjectMember);
   }
@@ -120,7 +138,7 @@ export class ProjectMemberRepository {
    * Find project member with full details (user, role, added by)
    */
   findByIdWithDetails(id: number): ProjectMemberWithDetails | undefined {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         pm.*,
         u.id as user_id, u.username, u.email, u.display_name, u.avatar_url, u.is_active,
@@ -145,7 +163,7 @@ export class ProjectMemberRepository {
    * Find project members with full details by project ID
    */
   findByProjectIdWithDetails(projectId: number): ProjectMemberWithDetails[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         pm.*,
         u.id as user_id, u.username, u.email, u.display_name, u.avatar_url, u.is_active,
@@ -171,7 +189,7 @@ export class ProjectMemberRepository {
    * Get user's role in a project
    */
   getUserRole(projectId: number, userId: number): Role | undefined {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT r.* FROM roles r
       INNER JOIN project_members pm ON r.id = pm.role_id
       WHERE pm.project_id = ? AND pm.user_id = ?
@@ -184,19 +202,23 @@ export class ProjectMemberRepository {
    * Update project member role
    */
   updateRole(id: number, roleId: number): ProjectMember | undefined {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE project_members SET role_id = ? WHERE id = ?
     `);
     stmt.run(roleId, id);
-    return this.findById(id);
+    const member = this.findById(id);
+    if (member) this.notifyMembersChanged(member.projectId, member.userId);
+    return member;
   }
 
   /**
    * Delete project member
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM project_members WHERE id = ?');
+    const member = this.findById(id);
+    const stmt = prepareCached(this.db, 'DELETE FROM project_members WHERE id = ?');
     const result = stmt.run(id);
+    if (member && result.changes > 0) this.notifyMembersChanged(member.projectId, member.userId);
     return result.changes > 0;
   }
 
@@ -204,11 +226,12 @@ export class ProjectMemberRepository {
    * Remove user from project
    */
   removeUserFromProject(projectId: number, userId: number): boolean {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       DELETE FROM project_members 
       WHERE project_id = ? AND user_id = ?
     `);
     const result = stmt.run(projectId, userId);
+    if (result.changes > 0) this.notifyMembersChanged(projectId, userId);
     return result.changes > 0;
   }
 
@@ -216,7 +239,7 @@ export class ProjectMemberRepository {
    * Check if user is member of project
    */
   isMember(projectId: number, userId: number): boolean {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT COUNT(*) as count FROM project_members
       WHERE project_id = ? AND user_id = ?
     `);
@@ -1,5 +1,7 @@
 import Database from 'better-sqlite3';
-import { Project, CreateProjectData, UpdateProjectData, ProjectStatus } from '../models/Project';
+import { Project, CreateProjectData, UpdateProjectData, ProjectStatus, ProjectColumns } from '../models/Project';
+import { prepareCached } from '../database/StatementCache';
+import { NativeCore } from '../database/nativeCore';
 
 /**
  * Database row interface for projects table
@@ -23,14 +25,44 @@ interface ProjectRow {
   updated_at: string;
 }
 
+/**
+ * Column order of the raw (array-mode) columnar listing query
+ */
+export const COLUMNAR_PROJECT_SQL = `
+  SELECT id, name, description, status, color, icon, created_at, updated_at,
+         concept_what, concept_how, concept_where, concept_with_what, concept_when, concept_why
+  FROM projects ORDER BY updated_at DESC
+`;
+
+// Listing queries below are also planned by database/queryPlanCheck.ts
+export const PROJECTS_SQL = 'SELECT * FROM projects ORDER BY updated_at DESC';
+export const PROJECTS_BY_STATUS_SQL = 'SELECT * FROM projects WHERE status = ? ORDER BY updated_at DESC';
+
 /**
  * Repository for Project CRUD operations
  */
 export class ProjectRepository {
   private db: Database.Database;
+  private readDb: Database.Database;
+  // Owned rather than taken from the shared cache: raw mode is sticky per statement
+  private columnarStmt: Database.Statement | null = null;
+  private native: NativeCore | null = null;
 
-  constructor(db: Database.Database) {
+  /**
+   * @param db Writer connection; also used for read-after-write lookups
+   * @param readDb Optional read-only connection for listing queries
+   */
+  constructor(db: Database.Database, readDb: Database.Database = db) {
     this.db = db;
+    this.readDb = readDb;
+  }
+
+  /**
+   * Serve columnar listings from the devtrack_core addon when it is loaded;
+   * null restores the TypeScript implementation
+   */
+  useNativeCore(native: NativeCore | null): void {
+    this.native = native;
   }
 
   /**
@@ -39,7 +71,7 @@ export class ProjectRepository {
   create(data: CreateProjectData): Project {
     const now = new Date().toISOString();
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO projects (
         name, description, status, color, icon,
         created_at, updated_at,
@@ -75,7 +107,7 @@ export class ProjectRepository {
    * Find project by ID
    */
   findById(id: number): Project | undefined {
-    const stmt = this.db.prepare('SELECT * FROM projects WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM projects WHERE id = ?');
     const row = stmt.get(id) as ProjectRow | undefined;
     return row ? this.mapRowToProject(row) : undefined;
   }
@@ -84,16 +116,71 @@ export class ProjectRepository {
    * Find all projects
    */
   findAll(): Project[] {
-    const stmt = this.db.prepare('SELECT * FROM projects ORDER BY updated_at DESC');
+    const stmt = prepareCached(this.readDb, PROJECTS_SQL);
     const rows = stmt.all() as ProjectRow[];
     return rows.map(row => this.mapRowToProject(row));
   }
 
+  /**
+   * Find all projects as a single column-oriented batch (see TaskRepository)
+   */
+  findAllColumnar(): ProjectColumns {
+    if (this.native) {
+      try {
+        return this.native.findAllProjectsColumnar();
+      } catch (error) {
+        console.error('[ProjectRepository] Native columnar listing failed, using TypeScript:', error);
+      }
+    }
+    if (!this.columnarStmt) {
+      this.columnarStmt = this.readDb.prepare(COLUMNAR_PROJECT_SQL).raw(true);
+    }
+    const rows = this.columnarStmt.all() as unknown[][];
+    const n = rows.length;
+    const columns: ProjectColumns = {
+      length: n,
+      id: new Int32Array(n),
+      name: new Array(n),
+      description: new Array(n),
+      status: new Array(n),
+      color: new Array(n),
+      icon: new Array(n),
+      createdAt: new Array(n),
+      updatedAt: new Array(n),
+      conceptWhat: new Array(n),
+      conceptHow: new Array(n),
+      conceptWhere: new Array(n),
+      conceptWithWhat: new Array(n),
+      conceptWhen: new Array(n),
+      conceptWhy: new Array(n)
+    };
+
+    for (let i = 0; i < n; i++) {
+      const row = rows[i];
+      columns.id[i] = row[0] as number;
+      columns.name[i] = row[1] as string;
+      columns.description[i] = row[2] as string | null;
+      columns.status[i] = row[3] as ProjectStatus;
+      columns.color[i] = row[4] as string | null;
+      columns.icon[i] = row[5] as string | null;
+      columns.createdAt[i] = row[6] as string;
+      columns.updatedAt[i] = row[7] as string;
+      columns.conceptWhat[i] = row[8] as string | null;
+      columns.conceptHow[i] = row[9] as string | null;
+      columns.conceptWhere[i] = row[10] as string | null;
+      columns.conceptWithWhat[i] = row[11] as string | null;
+      columns.conceptWhen[i] = row[12] as string | null;
+      columns.conceptWhy[i] = row[13] as string | null;
+    }
+
+    return columns;
+  }
+
   /**
    * Find projects by status
    */
   findByStatus(status: ProjectStatus): Project[] {
-    const stmt = this.db.prepare('SELECT * FROM projects WHERE status = ? ORDER BY updated_at DESC');
+    const stmt = prepareCached(this.readDb, PROJECTS_BY_STATUS_SQL);
     const rows = stmt.all(status) as ProjectRow[];
     return rows.map(row => this.mapRowToProject(row));
   }
@@ -159,7 +246,7 @@ export class ProjectRepository {
     values.push(now);
     values.push(id);
 
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE projects SET ${updates.join(', ')} WHERE id = ?
     `);
     stmt.run(...values);
@@ -171,7 +258,7 @@ export class ProjectRepository {
    * Delete a project
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM projects WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM projects WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
@@ -4,8 +4,14 @@ import {
   CreateProjectTemplateData,
   UpdateProjectTemplateData,
   ProjectTemplateWithTasks,
+  ProjectTemplateBlueprint,
+  TemplateContent,
+  TaskTemplateLabel,
+  TaskTemplateDependency,
 } from '../models/Template';
 import { TaskTemplateRepository } from './TaskTemplateRepository';
+import { prepareCached } from '../database/StatementCache';
+import { insertRows, nextRowId } from '../database/bulkInsert';
 
 /**
  * Database row interface for project_templates table
@@ -29,6 +35,14 @@ interface ProjectTemplateRow {
   concept_why: string | null;
 }
 
+interface TemplateLabelRow {
+  id: number;
+  project_template_id: number;
+  name: string;
+  color: string;
+  description: string | null;
+}
+
 /**
  * Repository for project templates
  * Handles CRUD operations for reusable project templates
@@ -46,7 +60,7 @@ export class ProjectTemplateRepository {
   create(data: CreateProjectTemplateData): ProjectTemplate {
     const now = new Date().toISOString();
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO project_templates (
         name, description, icon, color, category, is_public,
         created_by, created_at, updated_at,
@@ -84,7 +98,7 @@ export class ProjectTemplateRepository {
    * Find project template by ID
    */
   findById(id: number): ProjectTemplate | null {
-    const stmt = this.db.prepare('SELECT * FROM project_templates WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM project_templates WHERE id = ?');
     const row = stmt.get(id) as ProjectTemplateRow | undefined;
     return row ? this.mapRowToTemplate(row) : null;
   }
@@ -103,11 +117,94 @@ export class ProjectTemplateRepository {
     };
   }
 
+  /**
+   * Find project template by ID with its tasks, labels, task labels and
+   * dependencies (one query each)
+   */
+  findBlueprint(id: number): ProjectTemplateBlueprint | null {
+    const template = this.findByIdWithTasks(id);
+    if (!template) return null;
+
+    const labels = (prepareCached(this.db, `
+      SELECT * FROM template_labels WHERE project_template_id = ? ORDER BY id
+    `).all(id) as TemplateLabelRow[]).map(row => ({
+      id: row.id,
+      projectTemplateId: row.project_template_id,
+      name: row.name,
+      color: row.color,
+      description: row.description,
+    }));
+
+    const taskLabels = prepareCached(this.db, `
+      SELECT ttl.task_template_id AS taskTemplateId, ttl.template_label_id AS templateLabelId
+      FROM task_template_labels ttl
+      JOIN task_templates tt ON tt.id = ttl.task_template_id
+      WHERE tt.project_template_id = ?
+    `).all(id) as TaskTemplateLabel[];
+
+    const dependencies = prepareCached(this.db, `
+      SELECT ttd.task_template_id AS taskTemplateId,
+             ttd.depends_on_task_template_id AS dependsOnTaskTemplateId,
+             ttd.dependency_type AS dependencyType
+      FROM task_template_dependencies ttd
+      JOIN task_templates tt ON tt.id = ttd.task_template_id
+      WHERE tt.project_template_id = ?
+    `).all(id) as TaskTemplateDependency[];
+
+    return { ...template, labels, taskLabels, dependencies };
+  }
+
+  /**
+   * Create a template together with its tasks, labels and dependencies in
+   * one transaction, using multi-row inserts
+   */
+  createWithContent(data: CreateProjectTemplateData, content: TemplateContent): ProjectTemplate {
+    return this.db.transaction(() => {
+      const template = this.create(data);
+
+      // Ids are assigned up front so references can be remapped in memory
+      const taskIds = new Map<number, number>();
+      let nextTaskId = nextRowId(this.db, 'task_templates');
+      for (const task of content.tasks) taskIds.set(task.id, nextTaskId++);
+
+      const labelIds = new Map<number, number>();
+      let nextLabelId = nextRowId(this.db, 'template_labels');
+      for (const label of content.labels) labelIds.set(label.id, nextLabelId++);
+
+      insertRows(this.db, 'task_templates',
+        ['id', 'project_template_id', 'title', 'description', 'priority', 'estimated_hours', 'position'],
+        content.tasks.map(task => [
+          taskIds.get(task.id), template.id, task.title, task.description,
+          task.priority || 'medium', task.estimatedHours, task.position,
+        ])
+      );
+      insertRows(this.db, 'template_labels',
+        ['id', 'project_template_id', 'name', 'color', 'description'],
+        content.labels.map(label => [labelIds.get(label.id), template.id, label.name, label.color, label.description])
+      );
+      insertRows(this.db, 'task_template_labels', ['task_template_id', 'template_label_id'],
+        content.taskLabels
+          .filter(link => taskIds.has(link.taskTemplateId) && labelIds.has(link.templateLabelId))
+          .map(link => [taskIds.get(link.taskTemplateId), labelIds.get(link.templateLabelId)]),
+        'IGNORE'
+      );
+      insertRows(this.db, 'task_template_dependencies',
+        ['task_template_id', 'depends_on_task_template_id', 'dependency_type'],
+        content.dependencies
+          .filter(dep => taskIds.has(dep.taskTemplateId) && taskIds.has(dep.dependsOnTaskTemplateId))
+          .map(dep => [taskIds.get(dep.taskTemplateId), taskIds.get(dep.dependsOnTaskTemplateId), dep.dependencyType]),
+        'IGNORE'
+      );
+
+      return template;
+    }).immediate();
+  }
+
   /**
    * Get all project templates
    */
   findAll(): ProjectTemplate[] {
-    const stmt = this.db.prepare('SELECT * FROM project_templates ORDER BY created_at DESC');
+    const stmt = prepareCached(this.db, 'SELECT * FROM project_templates ORDER BY created_at DESC');
     const rows = stmt.all() as ProjectTemplateRow[];
     return rows.map(row => this.mapRowToTemplate(row));
   }
@@ -116,7 +213,7 @@ export class ProjectTemplateRepository {
    * Get all public project templates
    */
   findPublic(): ProjectTemplate[] {
-    const stmt = this.db.prepare(
+    const stmt = prepareCached(this.db,
       'SELECT * FROM project_templates WHERE is_public = 1 ORDER BY created_at DESC'
     );
     const rows = stmt.all() as ProjectTemplateRow[];
@@ -127,7 +224,7 @@ export class ProjectTemplateRepository {
    * Get templates by category
    */
   findByCategory(category: string): ProjectTemplate[] {
-    const stmt = this.db.prepare(
+    const stmt = prepareCached(this.db,
       'SELECT * FROM project_templates WHERE category = ? ORDER BY created_at DESC'
     );
     const rows = stmt.all(category) as ProjectTemplateRow[];
@@ -138,7 +235,7 @@ export class ProjectTemplateRepository {
    * Get templates created by a specific user
    */
   findByCreator(userId: number): ProjectTemplate[] {
-    const stmt = this.db.prepare(
+    const stmt = prepareCached(this.db,
       'SELECT * FROM project_templates WHERE created_by = ? ORDER BY created_at DESC'
     );
     const rows = stmt.all(userId) as ProjectTemplateRow[];
@@ -206,7 +303,7 @@ export class ProjectTemplateRepository {
     values.push(now);
     values.push(id);
 
-    const stmt = this.db.prepare(
+    const stmt = prepareCached(this.db,
       `UPDATE project_templates SET ${fields.join(', ')} WHERE id = ?`
     );
     stmt.run(...values);
@@ -219,10 +316,10 @@ export class ProjectTemplateRepository {
   }
 
   /**
-   * Delete a project template (cascades to task templates)
+   * Delete a project template (cascades to task templates and labels)
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM project_templates WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM project_templates WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
@@ -231,13 +328,12 @@ export class ProjectTemplateRepository {
    * Duplicate a template
    */
   duplicate(id: number, newName?: string): ProjectTemplate {
-    const original = this.findByIdWithTasks(id);
+    const original = this.findBlueprint(id);
     if (!original) {
       throw new Error('Template not found');
     }
 
-    // Create new template
-    const newTemplate = this.create({
+    return this.createWithContent({
       name: newName || `${original.name} (Copy)`,
       description: original.description || undefined,
       icon: original.icon || undefined,
@@ -250,21 +346,7 @@ export class ProjectTemplateRepository {
       conceptWithWhat: original.conceptWithWhat || undefined,
       conceptWhen: original.conceptWhen || undefined,
       conceptWhy: original.conceptWhy || undefined,
-    });
-
-    // Copy tasks
-    for (const task of original.tasks) {
-      this.taskTemplateRepo.create({
-        projectTemplateId: newTemplate.id,
-        title: task.title,
-        description: task.description || undefined,
-        priority: task.priority,
-        estimatedHours: task.estimatedHours || undefined,
-        position: task.position,
-      });
-    }
-
-    return newTemplate;
+    }, original);
   }
 
   /**
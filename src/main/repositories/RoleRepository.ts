@@ -1,6 +1,7 @@
 import Database from 'better-sqlite3';
 import { Role, CreateRoleData, UpdateRoleData } from '../models/Role';
 import { Permission } from '../models/Permission';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for roles table
@@ -29,14 +30,29 @@ interface PermissionRow {
  * Repository for managing roles
  */
 export class RoleRepository {
+  private changeListeners: Array<() => void> = [];
+
   constructor(private db: Database.Database) {}
 
+  /**
+   * Subscribe to changes to which permissions roles grant, e.g. to invalidate a permission cache
+   */
+  onRolesChanged(listener: () => void): void {
+    this.changeListeners.push(listener);
+  }
+
+  private notifyRolesChanged(): void {
+    for (const listener of this.changeListeners) {
+      listener();
+    }
+  }
+
   /**
    * Create a new role
    */
   create(data: CreateRoleData): Role {
     const now = new Date().toISOString();
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO roles (name, description, is_system, created_at)
       VALUES (?, ?, ?, ?)
     `);
@@ -59,7 +75,7 @@ export class RoleRepository {
    * Find role by ID
    */
   findById(id: number): Role | undefined {
-    const stmt = this.db.prepare('SELECT * FROM roles WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM roles WHERE id = ?');
     const row = stmt.get(id) as RoleRow | undefined;
     return row ? this.mapRowToRole(row) : undefined;
   }
@@ -68,7 +84,7 @@ export class RoleRepository {
    * Find role by name
    */
   findByName(name: string): Role | undefined {
-    const stmt = this.db.prepare('SELECT * FROM roles WHERE name = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM roles WHERE name = ?');
     const row = stmt.get(name) as RoleRow | undefined;
     return row ? this.mapRowToRole(row) : undefined;
   }
@@ -77,7 +93,7 @@ export class RoleRepository {
    * Find all roles
    */
   findAll(): Role[] {
-    const stmt = this.db.prepare('SELECT * FROM roles ORDER BY name ASC');
+    const stmt = prepareCached(this.db, 'SELECT * FROM roles ORDER BY name ASC');
     const rows = stmt.all() as RoleRow[];
     return rows.map(row => this.mapRowToRole(row));
   }
@@ -86,7 +102,7 @@ export class RoleRepository {
    * Get permissions for a role
    */
   getPermissions(roleId: number): Permission[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT p.* FROM permissions p
       INNER JOIN role_permissions rp ON p.id = rp.permission_id
       WHERE rp.role_id = ?
@@ -101,11 +117,12 @@ export class RoleRepository {
    */
   addPermission(roleId: number, permissionId: number): boolean {
     try {
-      const stmt = this.db.prepare(`
+      const stmt = prepareCached(this.db, `
         INSERT INTO role_permissions (role_id, permission_id)
         VALUES (?, ?)
       `);
       stmt.run(roleId, permissionId);
+      this.notifyRolesChanged();
       return true;
     } catch (err) {
       // Ignore duplicate errors
@@ -117,11 +134,12 @@ export class RoleRepository {
    * Remove permission from role
    */
   removePermission(roleId: number, permissionId: number): boolean {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       DELETE FROM role_permissions
       WHERE role_id = ? AND permission_id = ?
     `);
     const result = stmt.run(roleId, permissionId);
+    if (result.changes > 0) this.notifyRolesChanged();
     return result.changes > 0;
   }
 
@@ -147,7 +165,7 @@ export class RoleRepository {
 
     values.push(id);
 
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE roles SET ${updates.join(', ')} WHERE id = ?
     `);
 
@@ -165,8 +183,9 @@ export class RoleRepository {
       throw new Error('Cannot delete system role');
     }
 
-    const stmt = this.db.prepare('DELETE FROM roles WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM roles WHERE id = ?');
     const result = stmt.run(id);
+    if (result.changes > 0) this.notifyRolesChanged();
     return result.changes > 0;
   }
 
@@ -1,5 +1,7 @@
 import Database from 'better-sqlite3';
-import { TaskDependency, CreateTaskDependencyData, DependencyType, TaskDependencyWithDetails } from '../models/TaskDependency';
+import { TaskDependency, CreateTaskDependencyData, DependencyType, TaskDependencyWithDetails, CriticalPath } from '../models/TaskDependency';
+import { prepareCached } from '../database/StatementCache';
+import { DependencyGraphIndex } from '../services/DependencyGraphIndex';
 
 /**
  * Database row interface for task_dependencies table
@@ -26,7 +28,18 @@ interface TaskDependencyWithDetailsRow extends TaskDependencyRow {
  * Repository for task dependency operations
  */
 export class TaskDependencyRepository {
-  constructor(private db: Database.Database) {}
+  private graph: DependencyGraphIndex;
+
+  constructor(private db: Database.Database, graph?: DependencyGraphIndex) {
+    this.graph = graph ?? new DependencyGraphIndex(db);
+  }
+
+  /**
+   * Resident graph index shared with dependency-aware views
+   */
+  getGraph(): DependencyGraphIndex {
+    return this.graph;
+  }
 
   /**
    * Create a new task dependency
@@ -42,7 +55,7 @@ export class TaskDependencyRepository {
       throw new Error('This dependency would create a circular dependency chain');
     }
 
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO task_dependencies (task_id, depends_on_task_id, dependency_type, created_at)
       VALUES (?, ?, ?, datetime('now'))
     `);
@@ -52,6 +65,7 @@ export class TaskDependencyRepository {
     if (!created) {
       throw new Error('Failed to retrieve created task dependency');
     }
+    this.graph.addEdge(created);
     return created;
   }
 
@@ -59,7 +73,7 @@ export class TaskDependencyRepository {
    * Find dependency by ID
    */
   findById(id: number): TaskDependency | undefined {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT * FROM task_dependencies WHERE id = ?
     `);
     const row = stmt.get(id) as TaskDependencyRow | undefined;
@@ -70,7 +84,7 @@ export class TaskDependencyRepository {
    * Find all dependencies for a task (tasks this task depends on)
    */
   findByTaskId(taskId: number): TaskDependency[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT * FROM task_dependencies WHERE task_id = ?
     `);
     const rows = stmt.all(taskId) as TaskDependencyRow[];
@@ -81,7 +95,7 @@ export class TaskDependencyRepository {
    * Find all tasks that depend on a given task (tasks blocked by this task)
    */
   findDependentTasks(taskId: number): TaskDependency[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT * FROM task_dependencies WHERE depends_on_task_id = ?
     `);
     const rows = stmt.all(taskId) as TaskDependencyRow[];
@@ -92,7 +106,7 @@ export class TaskDependencyRepository {
    * Find all dependencies for a project
    */
   findByProjectId(projectId: number): TaskDependency[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT td.*
       FROM task_dependencies td
       JOIN tasks t ON t.id = td.task_id
@@ -106,7 +120,7 @@ export class TaskDependencyRepository {
    * Find dependencies with task details
    */
   findByTaskIdWithDetails(taskId: number): TaskDependencyWithDetails[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         td.*,
         t.title as depends_on_task_title,
@@ -123,7 +137,7 @@ export class TaskDependencyRepository {
    * Find dependent tasks with details
    */
   findDependentTasksWithDetails(taskId: number): TaskDependencyWithDetails[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         td.*,
         t.title as task_title,
@@ -144,10 +158,11 @@ export class TaskDependencyRepository {
    * Delete a dependency
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       DELETE FROM task_dependencies WHERE id = ?
     `);
     const result = stmt.run(id);
+    this.graph.removeEdge(id);
     return result.changes > 0;
   }
 
@@ -155,63 +170,56 @@ export class TaskDependencyRepository {
    * Delete dependency by task IDs
    */
   deleteByTaskIds(taskId: number, dependsOnTaskId: number): boolean {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       DELETE FROM task_dependencies 
       WHERE task_id = ? AND depends_on_task_id = ?
     `);
     const result = stmt.run(taskId, dependsOnTaskId);
+    this.graph.removeEdgesBetween(taskId, dependsOnTaskId);
     return result.changes > 0;
   }
 
   /**
-   * Check if adding a dependency would create a circular dependency
-   * Uses depth-first search to detect cycles
+   * Check if adding a dependency would create a circular dependency.
+   * Answered from the in-memory graph rather than one query per visited task.
    */
   private wouldCreateCircularDependency(taskId: number, dependsOnTaskId: number): boolean {
-    const visited = new Set<number>();
-    const stack = [dependsOnTaskId];
-
-    while (stack.length > 0) {
-      const currentTaskId = stack.pop()!;
-      
-      if (currentTaskId === taskId) {
-        return true; // Circular dependency detected
-      }
-
-      if (visited.has(currentTaskId)) {
-        continue; // Already visited this task
-      }
-
-      visited.add(currentTaskId);
-
-      // Get all tasks that currentTask depends on
-      const dependencies = this.findByTaskId(currentTaskId);
-      for (const dep of dependencies) {
-        stack.push(dep.dependsOnTaskId);
-      }
-    }
-
-    return false; // No circular dependency
+    return this.graph.wouldCreateCycle(taskId, dependsOnTaskId);
   }
 
   /**
    * Get all blocking tasks for a given task (tasks that must be completed first)
    */
   getBlockingTasks(taskId: number): number[] {
-    const dependencies = this.findByTaskId(taskId);
-    return dependencies
-      .filter(dep => dep.dependencyType === DependencyType.Blocks || dep.dependencyType === DependencyType.BlockedBy)
-      .map(dep => dep.dependsOnTaskId);
+    return this.graph.getBlockingTasks(taskId);
   }
 
   /**
    * Get all blocked tasks (tasks waiting for this task to complete)
    */
   getBlockedTasks(taskId: number): number[] {
-    const dependents = this.findDependentTasks(taskId);
-    return dependents
-      .filter(dep => dep.dependencyType === DependencyType.Blocks || dep.dependencyType === DependencyType.BlockedBy)
-      .map(dep => dep.taskId);
+    return this.graph.getBlockedTasks(taskId);
+  }
+
+  /**
+   * Get every task that transitively blocks a given task
+   */
+  getTransitiveBlockers(taskId: number): number[] {
+    return this.graph.getTransitiveBlockers(taskId);
+  }
+
+  /**
+   * Get project task IDs ordered so blockers come before the tasks they block
+   */
+  getTopologicalOrder(projectId: number): number[] {
+    return this.graph.getTopologicalOrder(projectId);
+  }
+
+  /**
+   * Get the longest chain of blocking dependencies in a project
+   */
+  getCriticalPath(projectId: number): CriticalPath {
+    return this.graph.getCriticalPath(projectId);
   }
 
   /**
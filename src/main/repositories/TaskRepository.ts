@@ -1,5 +1,11 @@
 import Database from 'better-sqlite3';
-import { Task, CreateTaskData, UpdateTaskData, TaskStatus, TaskPriority } from '../models/Task';
+import {
+  Task, CreateTaskData, UpdateTaskData, TaskStatus, TaskPriority,
+  TaskColumns, TASK_STATUS_VALUES, TASK_PRIORITY_VALUES, TaskPage, TaskPageOptions,
+  TaskBulkUpdate, TaskMoveOptions, TaskLabelChanges, TaskChange, TaskBulkLabelResult
+} from '../models/Task';
+import { prepareCached } from '../database/StatementCache';
+import { NativeCore } from '../database/nativeCore';
 
 /**
  * Database row interface for tasks table
@@ -21,6 +27,42 @@ interface TaskRow {
   tags: string | null;
 }
 
+/**
+ * Column order of the raw (array-mode) columnar listing query
+ */
+export const COLUMNAR_TASK_SQL = `
+  SELECT id, project_id, position, status, priority, title, description,
+         assigned_to, start_date, due_date, created_at, updated_at, completed_at, tags
+  FROM tasks WHERE project_id = ? ORDER BY position, created_at, id
+`;
+
+// Listing queries below are also planned by database/queryPlanCheck.ts
+export const TASKS_BY_PROJECT_SQL = 'SELECT * FROM tasks WHERE project_id = ? ORDER BY position, created_at, id';
+
+/**
+ * findPageByProjectId's query. Parameters: project id, [status],
+ * [cursor position, created_at, id], limit.
+ */
+export function taskPageSql(filters: { status?: boolean; after?: boolean }): string {
+  let sql = 'SELECT * FROM tasks WHERE project_id = ?';
+  if (filters.status) sql += ' AND status = ?';
+  if (filters.after) sql += ' AND (position, created_at, id) > (?, ?, ?)';
+  return sql + ' ORDER BY position, created_at, id LIMIT ?';
+}
+
+/**
+ * findByStatus's query. Parameters: status, [project id].
+ */
+export function tasksByStatusSql(withProject: boolean): string {
+  return `SELECT * FROM tasks WHERE status = ?${withProject ? ' AND project_id = ?' : ''} ORDER BY position, created_at`;
+}
+
+export const DEFAULT_TASK_PAGE_SIZE = 200;
+export const MAX_TASK_PAGE_SIZE = 1000;
+
+const STATUS_CODES = new Map<string, number>(TASK_STATUS_VALUES.map((value, i) => [value, i]));
+const PRIORITY_CODES = new Map<string, number>(TASK_PRIORITY_VALUES.map((value, i) => [value, i]));
+
 /**
  * Database row interface for task_labels table
  */
@@ -33,9 +75,42 @@ interface TaskLabelRow {
  */
 export class TaskRepository {
   private db: Database.Database;
+  private readDb: Database.Database;
+  // Owned rather than taken from the shared cache: raw mode is sticky per statement
+  private columnarStmt: Database.Statement | null = null;
+  private writeListeners: Array<(tasks: Task[]) => void> = [];
+  private native: NativeCore | null = null;
 
-  constructor(db: Database.Database) {
+  /**
+   * @param db Writer connection; also used for read-after-write lookups
+   * @param readDb Optional read-only connection for listing queries
+   */
+  constructor(db: Database.Database, readDb: Database.Database = db) {
     this.db = db;
+    this.readDb = readDb;
+  }
+
+  /**
+   * Serve columnar listings from the devtrack_core addon when it is loaded;
+   * null restores the TypeScript implementation
+   */
+  useNativeCore(native: NativeCore | null): void {
+    this.native = native;
+  }
+
+  /**
+   * Subscribe to task creates and updates made through this repository,
+   * e.g. to keep the dependency graph index in sync
+   */
+  onTasksWritten(listener: (tasks: Task[]) => void): void {
+    this.writeListeners.push(listener);
+  }
+
+  private notifyTasksWritten(tasks: Task[]): void {
+    if (tasks.length === 0) return;
+    for (const listener of this.writeListeners) {
+      listener(tasks);
+    }
   }
 
   /**
@@ -44,7 +119,7 @@ export class TaskRepository {
   create(data: CreateTaskData): Task {
     const now = new Date().toISOString();
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO tasks (
         project_id, title, description, status, priority,
         assigned_to, start_date, due_date, created_at, updated_at, position, tags
@@ -70,6 +145,7 @@ export class TaskRepository {
     if (!created) {
       throw new Error('Failed to retrieve created task');
     }
+    this.notifyTasksWritten([created]);
     return created;
   }
 
@@ -77,7 +153,7 @@ export class TaskRepository {
    * Find task by ID
    */
   findById(id: number): Task | undefined {
-    const stmt = this.db.prepare('SELECT * FROM tasks WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM tasks WHERE id = ?');
     const row = stmt.get(id) as TaskRow | undefined;
     return row ? this.mapRowToTask(row) : undefined;
   }
@@ -86,26 +162,130 @@ export class TaskRepository {
    * Find all tasks for a project
    */
   findByProjectId(projectId: number): Task[] {
-    const stmt = this.db.prepare('SELECT * FROM tasks WHERE project_id = ? ORDER BY position, created_at');
+    const stmt = prepareCached(this.readDb, TASKS_BY_PROJECT_SQL);
     const rows = stmt.all(projectId) as TaskRow[];
     return rows.map(row => this.mapRowToTask(row));
   }
 
   /**
-   * Find tasks by status
+   * Find one page of a project's tasks using keyset pagination on
+   * (position, created_at, id). Pages stay cheap however deep the cursor is,
+   * since SQLite seeks straight to the cursor via idx_tasks_project_order.
    */
-  findByStatus(status: TaskStatus, projectId?: number): Task[] {
-    let sql = 'SELECT * FROM tasks WHERE status = ?';
-    const params: any[] = [status];
+  findPageByProjectId(projectId: number, options: TaskPageOptions = {}): TaskPage {
+    const limit = Math.min(Math.max(1, options.limit ?? DEFAULT_TASK_PAGE_SIZE), MAX_TASK_PAGE_SIZE);
+    const params: any[] = [projectId];
 
-    if (projectId !== undefined) {
-      sql += ' AND project_id = ?';
-      params.push(projectId);
+    if (options.status) {
+      params.push(options.status);
     }
 
-    sql += ' ORDER BY position, created_at';
+    if (options.after) {
+      const cursor = TaskRepository.decodeCursor(options.after);
+      params.push(cursor.position, cursor.createdAt, cursor.id);
+    }
+
+    // Fetch one extra row to learn whether another page exists
+    params.push(limit + 1);
+
+    const sql = taskPageSql({ status: !!options.status, after: !!options.after });
+    const rows = prepareCached(this.readDb, sql).all(...params) as TaskRow[];
+    const hasMore = rows.length > limit;
+    const tasks = (hasMore ? rows.slice(0, limit) : rows).map(row => this.mapRowToTask(row));
+    const last = tasks[tasks.length - 1];
+
+    return {
+      tasks,
+      nextCursor: hasMore && last ? TaskRepository.encodeCursor(last) : null
+    };
+  }
+
+  /**
+   * Encode the keyset position of a task as an opaque cursor string
+   */
+  static encodeCursor(task: Pick<Task, 'position' | 'createdAt' | 'id'>): string {
+    return Buffer.from(JSON.stringify([task.position, task.createdAt, task.id])).toString('base64url');
+  }
+
+  /**
+   * Decode a cursor produced by encodeCursor
+   */
+  static decodeCursor(cursor: string): { position: number; createdAt: string; id: number } {
+    try {
+      const [position, createdAt, id] = JSON.parse(Buffer.from(cursor, 'base64url').toString('utf8'));
+      if (typeof position === 'number' && typeof createdAt === 'string' && typeof id === 'number') {
+        return { position, createdAt, id };
+      }
+    } catch {
+      // fall through
+    }
+    throw new Error('Invalid task cursor');
+  }
 
-    const stmt = this.db.prepare(sql);
+  /**
+   * Find all tasks for a project as a single column-oriented batch.
+   * Rows are read in array mode and written straight into columns, so no
+   * per-row Task objects are built and IPC clones a handful of flat arrays.
+   * Served by devtrack_core when loaded, falling back to TypeScript if it fails.
+   */
+  findByProjectIdColumnar(projectId: number): TaskColumns {
+    if (this.native) {
+      try {
+        return this.native.findTasksByProjectIdColumnar(projectId);
+      } catch (error) {
+        console.error('[TaskRepository] Native columnar listing failed, using TypeScript:', error);
+      }
+    }
+    if (!this.columnarStmt) {
+      this.columnarStmt = this.readDb.prepare(COLUMNAR_TASK_SQL).raw(true);
+    }
+    const rows = this.columnarStmt.all(projectId) as unknown[][];
+    const n = rows.length;
+    const columns: TaskColumns = {
+      length: n,
+      id: new Int32Array(n),
+      projectId: new Int32Array(n),
+      position: new Float64Array(n),
+      status: new Uint8Array(n),
+      priority: new Uint8Array(n),
+      title: new Array(n),
+      description: new Array(n),
+      assignedTo: new Array(n),
+      startDate: new Array(n),
+      dueDate: new Array(n),
+      createdAt: new Array(n),
+      updatedAt: new Array(n),
+      completedAt: new Array(n),
+      tags: new Array(n)
+    };
+
+    for (let i = 0; i < n; i++) {
+      const row = rows[i];
+      columns.id[i] = row[0] as number;
+      columns.projectId[i] = row[1] as number;
+      columns.position[i] = row[2] as number;
+      columns.status[i] = STATUS_CODES.get(row[3] as string) ?? 0;
+      columns.priority[i] = PRIORITY_CODES.get(row[4] as string) ?? 0;
+      columns.title[i] = row[5] as string;
+      columns.description[i] = row[6] as string | null;
+      columns.assignedTo[i] = row[7] as string | null;
+      columns.startDate[i] = row[8] as string | null;
+      columns.dueDate[i] = row[9] as string | null;
+      columns.createdAt[i] = row[10] as string;
+      columns.updatedAt[i] = row[11] as string;
+      columns.completedAt[i] = row[12] as string | null;
+      columns.tags[i] = row[13] as string | null;
+    }
+
+    return columns;
+  }
+
+  /**
+   * Find tasks by status
+   */
+  findByStatus(status: TaskStatus, projectId?: number): Task[] {
+    const params: any[] = projectId !== undefined ? [status, projectId] : [status];
+    const stmt = prepareCached(this.readDb, tasksByStatusSql(projectId !== undefined));
     const rows = stmt.all(...params) as TaskRow[];
     return rows.map(row => this.mapRowToTask(row));
   }
@@ -114,7 +294,184 @@ export class TaskRepository {
    * Update a task
    */
   update(id: number, data: UpdateTaskData): Task | undefined {
-    const now = new Date().toISOString();
+    const { updates, values } = this.buildUpdate(data, new Date().toISOString());
+
+    if (updates.length === 0) {
+      return this.findById(id);
+    }
+
+    const stmt = prepareCached(this.db, `
+      UPDATE tasks SET ${updates.join(', ')} WHERE id = ?
+    `);
+    stmt.run(...values, id);
+
+    const updated = this.findById(id);
+    if (updated) this.notifyTasksWritten([updated]);
+    return updated;
+  }
+
+  /**
+   * Apply many updates in one transaction. Updates with the same set of
+   * fields share one prepared statement.
+   */
+  bulkUpdate(items: TaskBulkUpdate[]): { changes: TaskChange[]; missing: number[] } {
+    return this.db.transaction(() => {
+      const now = new Date().toISOString();
+      const before = this.findManyById(items.map(item => item.id));
+      const changed: number[] = [];
+      const missing: number[] = [];
+
+      for (const item of items) {
+        if (!before.has(item.id)) {
+          missing.push(item.id);
+          continue;
+        }
+        const { updates, values } = this.buildUpdate(item.data, now);
+        if (updates.length === 0) continue;
+        prepareCached(this.db, `
+          UPDATE tasks SET ${updates.join(', ')} WHERE id = ?
+        `).run(...values, item.id);
+        changed.push(item.id);
+      }
+
+      const changes = this.collectChanges(before, changed);
+      this.notifyTasksWritten(changes.map(change => change.after));
+      return { changes, missing };
+    })();
+  }
+
+  /**
+   * Move tasks (optionally into another status column) and renumber them
+   * in the given order, in one transaction
+   */
+  bulkMove(taskIds: number[], options: TaskMoveOptions = {}): { changes: TaskChange[]; missing: number[] } {
+    const startPosition = options.startPosition ?? 0;
+    return this.db.transaction(() => {
+      // Only tasks changing column get a status write, so reordering within
+      // the Done column doesn't reset completed_at
+      const current = this.findManyById(taskIds);
+      return this.bulkUpdate(taskIds.map((id, index) => ({
+        id,
+        data: options.status !== undefined && current.get(id)?.status !== options.status
+          ? { status: options.status, position: startPosition + index }
+          : { position: startPosition + index },
+      })));
+    })();
+  }
+
+  /**
+   * Add and remove labels on many tasks in one transaction.
+   * Returns the (task, label) pairs that were newly added, for hooks.
+   */
+  bulkLabel(taskIds: number[], labels: TaskLabelChanges): TaskBulkLabelResult & { addedPairs: Array<{ task: Task; labelId: number }> } {
+    const insert = prepareCached(this.db, 'INSERT OR IGNORE INTO task_labels (task_id, label_id) VALUES (?, ?)');
+    const remove = prepareCached(this.db, 'DELETE FROM task_labels WHERE task_id = ? AND label_id = ?');
+
+    return this.db.transaction(() => {
+      const tasks = this.findManyById(taskIds);
+      const missing = taskIds.filter(id => !tasks.has(id));
+      const addedPairs: Array<{ task: Task; labelId: number }> = [];
+      let removed = 0;
+
+      for (const task of tasks.values()) {
+        for (const labelId of labels.add ?? []) {
+          if (insert.run(task.id, labelId).changes > 0) {
+            addedPairs.push({ task, labelId });
+          }
+        }
+        for (const labelId of labels.remove ?? []) {
+          removed += remove.run(task.id, labelId).changes;
+        }
+      }
+
+      return { added: addedPairs.length, removed, missing, addedPairs };
+    })();
+  }
+
+  /**
+   * Delete a task
+   */
+  delete(id: number): boolean {
+    const stmt = prepareCached(this.db, 'DELETE FROM tasks WHERE id = ?');
+    const result = stmt.run(id);
+    return result.changes > 0;
+  }
+
+  /**
+   * Add label to task
+   */
+  addLabel(taskId: number, labelId: number): void {
+    const stmt = prepareCached(this.db, `
+      INSERT OR IGNORE INTO task_labels (task_id, label_id) VALUES (?, ?)
+    `);
+    stmt.run(taskId, labelId);
+  }
+
+  /**
+   * Remove label from task
+   */
+  removeLabel(taskId: number, labelId: number): void {
+    const stmt = prepareCached(this.db, `
+      DELETE FROM task_labels WHERE task_id = ? AND label_id = ?
+    `);
+    stmt.run(taskId, labelId);
+  }
+
+  /**
+   * Get label IDs for a task
+   */
+  getLabelIds(taskId: number): number[] {
+    const stmt = prepareCached(this.db, 'SELECT label_id FROM task_labels WHERE task_id = ?');
+    const rows = stmt.all(taskId) as TaskLabelRow[];
+    return rows.map(row => row.label_id);
+  }
+
+  /**
+   * Every (task, label) link in a project
+   */
+  getLabelLinksByProjectId(projectId: number): Array<{ taskId: number; labelId: number }> {
+    const stmt = prepareCached(this.readDb, `
+      SELECT tl.task_id AS taskId, tl.label_id AS labelId
+      FROM task_labels tl
+      JOIN tasks t ON t.id = tl.task_id
+      WHERE t.project_id = ?
+    `);
+    return stmt.all(projectId) as Array<{ taskId: number; labelId: number }>;
+  }
+
+  /**
+   * Load many tasks by id with one query (writer connection, so it sees
+   * the surrounding transaction's writes)
+   */
+  findManyById(ids: number[]): Map<number, Task> {
+    const result = new Map<number, Task>();
+    if (ids.length === 0) return result;
+    const rows = prepareCached(this.db, `
+      SELECT * FROM tasks WHERE id IN (SELECT value FROM json_each(?))
+    `).all(JSON.stringify(ids)) as TaskRow[];
+    for (const row of rows) {
+      result.set(row.id, this.mapRowToTask(row));
+    }
+    return result;
+  }
+
+  private collectChanges(before: Map<number, Task>, changedIds: number[]): TaskChange[] {
+    const after = this.findManyById(changedIds);
+    const changes: TaskChange[] = [];
+    for (const id of new Set(changedIds)) {
+      const previous = before.get(id);
+      const current = after.get(id);
+      if (previous && current) {
+        changes.push({ before: previous, after: current });
+      }
+    }
+    return changes;
+  }
+
+  /**
+   * SET clauses and values for an update; the caller appends the id
+   */
+  private buildUpdate(data: UpdateTaskData, now: string): { updates: string[]; values: any[] } {
     const updates: string[] = [];
     const values: any[] = [];
 
@@ -161,58 +518,12 @@ export class TaskRepository {
       values.push(data.tags);
     }
 
-    if (updates.length === 0) {
-      return this.findById(id);
+    if (updates.length > 0) {
+      updates.push('updated_at = ?');
+      values.push(now);
     }
 
-    updates.push('updated_at = ?');
-    values.push(now);
-    values.push(id);
-
-    const stmt = this.db.prepare(`
-      UPDATE tasks SET ${updates.join(', ')} WHERE id = ?
-    `);
-    stmt.run(...values);
-
-    return this.findById(id);
-  }
-
-  /**
-   * Delete a task
-   */
-  delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM tasks WHERE id = ?');
-    const result = stmt.run(id);
-    return result.changes > 0;
-  }
-
-  /**
-   * Add label to task
-   */
-  addLabel(taskId: number, labelId: number): void {
-    const stmt = this.db.prepare(`
-      INSERT OR IGNORE INTO task_labels (task_id, label_id) VALUES (?, ?)
-    `);
-    stmt.run(taskId, labelId);
-  }
-
-  /**
-   * Remove label from task
-   */
-  removeLabel(taskId: number, labelId: number): void {
-    const stmt = this.db.prepare(`
-      DELETE FROM task_labels WHERE task_id = ? AND label_id = ?
-    `);
-    stmt.run(taskId, labelId);
-  }
-
-  /**
-   * Get label IDs for a task
-   */
-  getLabelIds(taskId: number): number[] {
-    const stmt = this.db.prepare('SELECT label_id FROM task_labels WHERE task_id = ?');
-    const rows = stmt.all(taskId) as TaskLabelRow[];
-    return rows.map(row => row.label_id);
+    return { updates, values };
   }
 
   /**
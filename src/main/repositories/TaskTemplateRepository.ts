@@ -4,6 +4,7 @@ import {
   CreateTaskTemplateData,
   UpdateTaskTemplateData,
 } from '../models/Template';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for task_templates table
@@ -29,7 +30,7 @@ export class TaskTemplateRepository {
    * Create a new task template
    */
   create(data: CreateTaskTemplateData): TaskTemplate {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO task_templates (
         project_template_id, title, description, priority,
         estimated_hours, position
@@ -56,7 +57,7 @@ export class TaskTemplateRepository {
    * Find task template by ID
    */
   findById(id: number): TaskTemplate | null {
-    const stmt = this.db.prepare('SELECT * FROM task_templates WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM task_templates WHERE id = ?');
     const row = stmt.get(id) as TaskTemplateRow | undefined;
     return row ? this.mapRowToTaskTemplate(row) : null;
   }
@@ -65,7 +66,7 @@ export class TaskTemplateRepository {
    * Get all task templates for a project template
    */
   findByProjectTemplateId(projectTemplateId: number): TaskTemplate[] {
-    const stmt = this.db.prepare(
+    const stmt = prepareCached(this.db,
       'SELECT * FROM task_templates WHERE project_template_id = ? ORDER BY position ASC'
     );
     const rows = stmt.all(projectTemplateId) as TaskTemplateRow[];
@@ -76,7 +77,7 @@ export class TaskTemplateRepository {
    * Get all standalone task templates (not part of a project template)
    */
   findStandalone(): TaskTemplate[] {
-    const stmt = this.db.prepare(
+    const stmt = prepareCached(this.db,
       'SELECT * FROM task_templates WHERE project_template_id IS NULL ORDER BY position ASC'
     );
     const rows = stmt.all() as TaskTemplateRow[];
@@ -113,7 +114,7 @@ export class TaskTemplateRepository {
 
     values.push(id);
 
-    const stmt = this.db.prepare(
+    const stmt = prepareCached(this.db,
       `UPDATE task_templates SET ${fields.join(', ')} WHERE id = ?`
     );
     stmt.run(...values);
@@ -129,7 +130,7 @@ export class TaskTemplateRepository {
    * Delete a task template
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM task_templates WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM task_templates WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
@@ -138,7 +139,7 @@ export class TaskTemplateRepository {
    * Reorder task templates within a project template
    */
   reorder(taskIds: number[]): void {
-    const stmt = this.db.prepare('UPDATE task_templates SET position = ? WHERE id = ?');
+    const stmt = prepareCached(this.db, 'UPDATE task_templates SET position = ? WHERE id = ?');
     
     this.db.transaction(() => {
       taskIds.forEach((taskId, index) => {
@@ -1,4 +1,5 @@
 import Database from 'better-sqlite3';
+import { Writable } from 'stream';
 import {
   TimeEntry,
   CreateTimeEntryData,
@@ -6,6 +7,9 @@ import {
   TimeEntryWithDetails,
   TimeTrackingStats,
 } from '../models/TimeEntry';
+import { ExportResult, TimeEntryExportFilters } from '../models/Export';
+import { prepareCached } from '../database/StatementCache';
+import { StreamExportOptions, exportRows } from '../utils/streamingExport';
 
 /**
  * Database row interface for time_entries table
@@ -22,6 +26,8 @@ interface TimeEntryRow {
   hourly_rate: number | null;
   created_at: string;
   updated_at: string;
+  start_ts: number; // generated from start_time
+  end_ts: number | null; // generated from end_time
 }
 
 /**
@@ -35,6 +41,25 @@ interface TimeEntryWithDetailsRow extends TimeEntryRow {
   project_name: string;
 }
 
+// Listing queries below are also planned by database/queryPlanCheck.ts
+export const TIME_ENTRIES_BY_TASK_SQL = 'SELECT * FROM time_entries WHERE task_id = ? ORDER BY start_time DESC';
+export const TIME_ENTRIES_BY_USER_SQL = 'SELECT * FROM time_entries WHERE user_id = ? ORDER BY start_time DESC';
+export const ACTIVE_TIME_ENTRY_SQL =
+  'SELECT * FROM time_entries WHERE user_id = ? AND end_time IS NULL ORDER BY start_time DESC LIMIT 1';
+
+/**
+ * findByDateRange's query. Parameters: start, end, [user id]. Ordered by
+ * the range column so idx_time_entries_user_start_ts needs no sort.
+ */
+export function timeEntriesByDateRangeSql(withUser: boolean): string {
+  return `
+    SELECT * FROM time_entries
+    WHERE start_ts >= CAST(strftime('%s', ?) AS INTEGER) AND start_ts <= CAST(strftime('%s', ?) AS INTEGER)
+    ${withUser ? 'AND user_id = ?' : ''}
+    ORDER BY start_ts DESC
+  `;
+}
+
 /**
  * Repository for managing time entries
  */
@@ -47,7 +72,7 @@ export class TimeEntryRepository {
   create(data: CreateTimeEntryData): TimeEntry {
     const now = new Date().toISOString();
     
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO time_entries (
         task_id, user_id, description, start_time, end_time,
         duration, is_billable, hourly_rate, created_at, updated_at
@@ -78,7 +103,7 @@ export class TimeEntryRepository {
    * Find time entry by ID
    */
   findById(id: number): TimeEntry | undefined {
-    const stmt = this.db.prepare('SELECT * FROM time_entries WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM time_entries WHERE id = ?');
     const row = stmt.get(id) as TimeEntryRow | undefined;
     return row ? this.mapRowToTimeEntry(row) : undefined;
   }
@@ -87,11 +112,7 @@ export class TimeEntryRepository {
    * Find all time entries for a task
    */
   findByTaskId(taskId: number): TimeEntry[] {
-    const stmt = this.db.prepare(`
-      SELECT * FROM time_entries
-      WHERE task_id = ?
-      ORDER BY start_time DESC
-    `);
+    const stmt = prepareCached(this.db, TIME_ENTRIES_BY_TASK_SQL);
     const rows = stmt.all(taskId) as TimeEntryRow[];
     return rows.map(row => this.mapRowToTimeEntry(row));
   }
@@ -100,11 +121,7 @@ export class TimeEntryRepository {
    * Find all time entries for a user
    */
   findByUserId(userId: number): TimeEntry[] {
-    const stmt = this.db.prepare(`
-      SELECT * FROM time_entries
-      WHERE user_id = ?
-      ORDER BY start_time DESC
-    `);
+    const stmt = prepareCached(this.db, TIME_ENTRIES_BY_USER_SQL);
     const rows = stmt.all(userId) as TimeEntryRow[];
     return rows.map(row => this.mapRowToTimeEntry(row));
   }
@@ -113,7 +130,7 @@ export class TimeEntryRepository {
    * Find time entries by task with details
    */
   findByTaskIdWithDetails(taskId: number): TimeEntryWithDetails[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         te.*,
         t.title as task_title,
@@ -136,7 +153,7 @@ export class TimeEntryRepository {
    * Find time entries by user with details
    */
   findByUserIdWithDetails(userId: number): TimeEntryWithDetails[] {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT
         te.*,
         t.title as task_title,
@@ -159,34 +176,65 @@ export class TimeEntryRepository {
    * Find time entries by date range
    */
   findByDateRange(startDate: string, endDate: string, userId?: number): TimeEntry[] {
+    const params: any[] = userId !== undefined ? [startDate, endDate, userId] : [startDate, endDate];
+    const stmt = prepareCached(this.db, timeEntriesByDateRangeSql(userId !== undefined));
+    const rows = stmt.all(...params) as TimeEntryRow[];
+    return rows.map(row => this.mapRowToTimeEntry(row));
+  }
+
+  /**
+   * Stream time entries with their task, project and user to `destination`,
+   * newest first, reading row by row through `conn` (see openExportConnection)
+   */
+  exportStream(
+    conn: Database.Database,
+    filters: TimeEntryExportFilters | undefined,
+    destination: Writable,
+    options: StreamExportOptions
+  ): Promise<ExportResult> {
     let sql = `
-      SELECT * FROM time_entries
-      WHERE start_time >= ? AND start_time <= ?
+      SELECT
+        te.*,
+        t.title as task_title,
+        t.status as task_status,
+        t.project_id as project_id,
+        u.display_name as user_name,
+        p.name as project_name
+      FROM time_entries te
+      JOIN tasks t ON t.id = te.task_id
+      JOIN users u ON u.id = te.user_id
+      JOIN projects p ON p.id = t.project_id
+      WHERE 1=1
     `;
-    const params: any[] = [startDate, endDate];
+    const params: any[] = [];
 
-    if (userId !== undefined) {
-      sql += ' AND user_id = ?';
-      params.push(userId);
+    if (filters?.startDate) {
+      sql += " AND te.start_ts >= CAST(strftime('%s', ?) AS INTEGER)";
+      params.push(filters.startDate);
     }
+    if (filters?.endDate) {
+      sql += " AND te.start_ts <= CAST(strftime('%s', ?) AS INTEGER)";
+      params.push(filters.endDate);
+    }
+    if (filters?.userId !== undefined) {
+      sql += ' AND te.user_id = ?';
+      params.push(filters.userId);
+    }
+    if (filters?.projectId !== undefined) {
+      sql += ' AND t.project_id = ?';
+      params.push(filters.projectId);
+    }
+    sql += ' ORDER BY te.start_ts DESC';
 
-    sql += ' ORDER BY start_time DESC';
-
-    const stmt = this.db.prepare(sql);
-    const rows = stmt.all(...params) as TimeEntryRow[];
-    return rows.map(row => this.mapRowToTimeEntry(row));
+    const rows = conn.prepare(sql).iterate(...params) as IterableIterator<TimeEntryWithDetailsRow>;
+    return exportRows(rows, { toRecord: row => this.mapRowToTimeEntryWithDetails(row) }, destination, options);
   }
 
   /**
    * Find active (running) time entry for user
    */
   findActiveByUserId(userId: number): TimeEntry | undefined {
-    const stmt = this.db.prepare(`
-      SELECT * FROM time_entries
-      WHERE user_id = ? AND end_time IS NULL
-      ORDER BY start_time DESC
-      LIMIT 1
-    `);
+    const stmt = prepareCached(this.db, ACTIVE_TIME_ENTRY_SQL);
     const row = stmt.get(userId) as TimeEntryRow | undefined;
     return row ? this.mapRowToTimeEntry(row) : undefined;
   }
@@ -232,7 +280,7 @@ export class TimeEntryRepository {
     values.push(now);
     values.push(id);
 
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE time_entries SET ${updates.join(', ')} WHERE id = ?
     `);
     stmt.run(...values);
@@ -262,7 +310,7 @@ export class TimeEntryRepository {
    * Delete a time entry
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM time_entries WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM time_entries WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
@@ -271,7 +319,7 @@ export class TimeEntryRepository {
    * Get time tracking statistics for a task
    */
   getTaskStats(taskId: number): TimeTrackingStats {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT 
         COUNT(*) as entry_count,
         COALESCE(SUM(duration), 0) as total_duration,
@@ -314,11 +362,11 @@ export class TimeEntryRepository {
     const params: any[] = [userId];
     
     if (startDate && endDate) {
-      sql += ' AND start_time >= ? AND start_time <= ?';
+      sql += " AND start_ts >= CAST(strftime('%s', ?) AS INTEGER) AND start_ts <= CAST(strftime('%s', ?) AS INTEGER)";
       params.push(startDate, endDate);
     }
     
-    const stmt = this.db.prepare(sql);
+    const stmt = prepareCached(this.db, sql);
     const row: any = stmt.get(...params);
     
     return {
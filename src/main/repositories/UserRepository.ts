@@ -1,5 +1,6 @@
 import Database from 'better-sqlite3';
 import { User, CreateUserData, UpdateUserData } from '../models/User';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Database row interface for users table
@@ -26,7 +27,7 @@ export class UserRepository {
    */
   create(data: CreateUserData): User {
     const now = new Date().toISOString();
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       INSERT INTO users (username, email, display_name, avatar_url, is_active, created_at, updated_at)
       VALUES (?, ?, ?, ?, ?, ?, ?)
     `);
@@ -52,7 +53,7 @@ export class UserRepository {
    * Find user by ID
    */
   findById(id: number): User | undefined {
-    const stmt = this.db.prepare('SELECT * FROM users WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM users WHERE id = ?');
     const row = stmt.get(id) as UserRow | undefined;
     return row ? this.mapRowToUser(row) : undefined;
   }
@@ -61,7 +62,7 @@ export class UserRepository {
    * Find user by username
    */
   findByUsername(username: string): User | undefined {
-    const stmt = this.db.prepare('SELECT * FROM users WHERE username = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM users WHERE username = ?');
     const row = stmt.get(username) as UserRow | undefined;
     return row ? this.mapRowToUser(row) : undefined;
   }
@@ -70,7 +71,7 @@ export class UserRepository {
    * Find user by email
    */
   findByEmail(email: string): User | undefined {
-    const stmt = this.db.prepare('SELECT * FROM users WHERE email = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM users WHERE email = ?');
     const row = stmt.get(email) as UserRow | undefined;
     return row ? this.mapRowToUser(row) : undefined;
   }
@@ -79,7 +80,7 @@ export class UserRepository {
    * Find all users
    */
   findAll(): User[] {
-    const stmt = this.db.prepare('SELECT * FROM users ORDER BY display_name ASC');
+    const stmt = prepareCached(this.db, 'SELECT * FROM users ORDER BY display_name ASC');
     const rows = stmt.all() as UserRow[];
     return rows.map(row => this.mapRowToUser(row));
   }
@@ -88,7 +89,7 @@ export class UserRepository {
    * Find all active users
    */
   findActive(): User[] {
-    const stmt = this.db.prepare('SELECT * FROM users WHERE is_active = 1 ORDER BY display_name ASC');
+    const stmt = prepareCached(this.db, 'SELECT * FROM users WHERE is_active = 1 ORDER BY display_name ASC');
     const rows = stmt.all() as UserRow[];
     return rows.map(row => this.mapRowToUser(row));
   }
@@ -129,7 +130,7 @@ export class UserRepository {
     values.push(new Date().toISOString());
     values.push(id);
 
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       UPDATE users SET ${updates.join(', ')} WHERE id = ?
     `);
 
@@ -141,7 +142,7 @@ export class UserRepository {
    * Delete user
    */
   delete(id: number): boolean {
-    const stmt = this.db.prepare('DELETE FROM users WHERE id = ?');
+    const stmt = prepareCached(this.db, 'DELETE FROM users WHERE id = ?');
     const result = stmt.run(id);
     return result.changes > 0;
   }
@@ -0,0 +1,562 @@
+#!/usr/bin/env node
+
+/**
+ * bench.ts
+ *
+ * CLI script that generates a synthetic DevTrack dataset in a scratch
+ * database and runs timed scenarios against the real repositories and
+ * services: task listing, analytics reports, dependency checks, audit
+ * query/export, template instantiation, vision board viewports and
+ * directory scanning. Results are written as JSON so runs can be compared
+ * across commits.
+ *
+ * Usage:
+ *   npm run bench -- [options]
+ *
+ * Examples:
+ *   npm run bench
+ *   npm run bench -- --projects 50 --tasks 2000 --out results/main.json
+ *   npm run bench -- --only audit,template --compare results/main.json
+ */
+
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { Writable } from 'stream';
+import { execFileSync } from 'child_process';
+import { DevTrackDatabase } from '../database/Database';
+import { TaskRepository } from '../repositories/TaskRepository';
+import { TaskDependencyRepository } from '../repositories/TaskDependencyRepository';
+import { AnalyticsService } from '../services/AnalyticsService';
+import { AuditLogger } from '../services/AuditLogger';
+import { TemplateService } from '../services/TemplateService';
+import { VisionBoardManager } from '../services/VisionBoardManager';
+import { DirectoryScanner } from '../utils/DirectoryScanner';
+import { openExportConnection } from '../utils/streamingExport';
+import {
+  BenchDataOptions,
+  BenchDataset,
+  DEFAULT_BENCH_DATA_OPTIONS,
+  createRandom,
+  generateBenchData,
+  generateScanTree,
+} from '../utils/benchData';
+import { AuditCategory } from '../models/AuditLog';
+
+// Bumped when the result layout changes, so comparisons can refuse mismatches
+const RESULT_FORMAT_VERSION = 1;
+
+interface CliArgs {
+  data: BenchDataOptions;
+  iterations: number;
+  warmup: number;
+  scanProjects: number;
+  scanFiles: number;
+  workers?: number;
+  only?: string[];
+  out: string;
+  compare?: string;
+  db?: string;
+  keep?: boolean;
+  help?: boolean;
+}
+
+interface Scenario {
+  name: string;
+  group: string;
+  // Returns how many items one run touched (rows, checks, nodes, ...)
+  run: () => number | Promise<number>;
+}
+
+interface ScenarioResult {
+  group: string;
+  iterations: number;
+  items: number;
+  minMs: number;
+  medianMs: number;
+  p95Ms: number;
+  maxMs: number;
+  meanMs: number;
+}
+
+interface BenchResults {
+  formatVersion: number;
+  commit: string | null;
+  startedAt: string;
+  environment: Record<string, string | number>;
+  options: Omit<CliArgs, 'out' | 'compare' | 'db' | 'keep' | 'help'>;
+  dataset: Record<string, number>;
+  generateMs: number;
+  scenarios: Record<string, ScenarioResult>;
+}
+
+function parseArgs(): CliArgs {
+  const args: CliArgs = {
+    data: { ...DEFAULT_BENCH_DATA_OPTIONS },
+    iterations: 5,
+    warmup: 1,
+    scanProjects: 200,
+    scanFiles: 20,
+    out: 'bench-results.json',
+  };
+  const argv = process.argv.slice(2);
+  const int = (value: string | undefined, flag: string): number => {
+    const parsed = Number(value);
+    if (!Number.isInteger(parsed) || parsed < 0) {
+      console.error(`❌ ${flag} expects a non-negative integer`);
+      process.exit(1);
+    }
+    return parsed;
+  };
+
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    const next = argv[i + 1];
+
+    switch (arg) {
+      case '--seed': args.data.seed = int(next, arg); i++; break;
+      case '--users': args.data.users = int(next, arg); i++; break;
+      case '--projects': args.data.projects = int(next, arg); i++; break;
+      case '--tasks': args.data.tasksPerProject = int(next, arg); i++; break;
+      case '--dependencies': args.data.dependenciesPerProject = int(next, arg); i++; break;
+      case '--time-entries': args.data.timeEntries = int(next, arg); i++; break;
+      case '--audit-rows': args.data.auditRows = int(next, arg); i++; break;
+      case '--board-nodes': args.data.boardNodes = int(next, arg); i++; break;
+      case '--template-tasks': args.data.templateTasks = int(next, arg); i++; break;
+      case '--scan-projects': args.scanProjects = int(next, arg); i++; break;
+      case '--scan-files': args.scanFiles = int(next, arg); i++; break;
+      case '--workers': args.workers = int(next, arg); i++; break;
+      case '--iterations':
+      case '-n':
+        args.iterations = Math.max(1, int(next, arg));
+        i++;
+        break;
+      case '--warmup': args.warmup = int(next, arg); i++; break;
+      case '--only':
+        args.only = (next ?? '').split(',').map(part => part.trim()).filter(Boolean);
+        i++;
+        break;
+      case '--out':
+      case '-o':
+        args.out = next;
+        i++;
+        break;
+      case '--compare': args.compare = next; i++; break;
+      case '--db': args.db = next; i++; break;
+      case '--keep': args.keep = true; break;
+      case '--help':
+      case '-h':
+        args.help = true;
+        break;
+    }
+  }
+
+  return args;
+}
+
+function printHelp(): void {
+  const d = DEFAULT_BENCH_DATA_OPTIONS;
+  console.log(`
+DevTrack Benchmarks
+===================
+
+Generate a synthetic dataset in a scratch database, run timed scenarios
+against the repositories and services, and write the results as JSON.
+
+Usage:
+  npm run bench -- [options]
+
+Dataset:
+  --seed <n>              PRNG seed (default: ${d.seed})
+  --users <n>             Users (default: ${d.users})
+  --projects <n>          Projects (default: ${d.projects})
+  --tasks <n>             Tasks per project (default: ${d.tasksPerProject})
+  --dependencies <n>      Dependencies per project (default: ${d.dependenciesPerProject})
+  --time-entries <n>      Time entries (default: ${d.timeEntries})
+  --audit-rows <n>        Audit log entries (default: ${d.auditRows})
+  --board-nodes <n>       Vision board nodes (default: ${d.boardNodes})
+  --template-tasks <n>    Tasks in the benchmark template (default: ${d.templateTasks})
+  --scan-projects <n>     Project directories to scan (default: 200)
+  --scan-files <n>        Files per scanned project (default: 20)
+
+Run:
+  --iterations, -n <n>    Timed runs per scenario (default: 5)
+  --warmup <n>            Untimed runs per scenario first (default: 1)
+  --only <a,b>            Only scenarios whose name or group matches
+  --workers <n>           Scanner worker threads (default: scanner's own)
+  --out, -o <path>        Results file (default: bench-results.json)
+  --compare <path>        Earlier results file to compare medians against
+  --db <path>             Scratch database (default: a temp file); must not exist
+  --keep                  Keep the scratch database and scan tree
+  --help, -h              Show this help message
+`);
+}
+
+/**
+ * Timed scenarios. Each picks its targets from the dataset with its own
+ * seeded PRNG, so two runs with the same options do the same work.
+ */
+function createScenarios(
+  database: DevTrackDatabase,
+  dataset: BenchDataset,
+  auditLogger: AuditLogger,
+  boards: VisionBoardManager,
+  scanRoot: string,
+  args: CliArgs
+): Scenario[] {
+  const db = database.getDb();
+  const readDb = database.getReadDb();
+  const taskRepo = new TaskRepository(db, readDb);
+  const dependencyRepo = new TaskDependencyRepository(db);
+  const analytics = new AnalyticsService(readDb);
+  const templates = new TemplateService(db);
+  const scanner = new DirectoryScanner(db);
+  const random = createRandom(args.data.seed + 1);
+  const pick = <T>(items: T[]): T => items[Math.floor(random() * items.length)];
+  const projectIds = dataset.projectIds;
+  const allTaskIds = Array.from(dataset.taskIdsByProject.values()).flat();
+  const yearAgo = new Date(Date.now() - 365 * 24 * 60 * 60 * 1000).toISOString().slice(0, 10);
+
+  const scenarios: Scenario[] = [
+    {
+      name: 'tasks.findByProjectId',
+      group: 'tasks',
+      run: () => taskRepo.findByProjectId(pick(projectIds)).length,
+    },
+    {
+      name: 'tasks.findPageByProjectId.all',
+      group: 'tasks',
+      run: () => {
+        const projectId = pick(projectIds);
+        let rows = 0;
+        let after: string | null = null;
+        do {
+          const page = taskRepo.findPageByProjectId(projectId, { limit: 100, after });
+          rows += page.tasks.length;
+          after = page.nextCursor;
+        } while (after);
+        return rows;
+      },
+    },
+    {
+      name: 'tasks.findByProjectIdColumnar',
+      group: 'tasks',
+      run: () => taskRepo.findByProjectIdColumnar(pick(projectIds)).id.length,
+    },
+    {
+      name: 'analytics.taskStatusReport',
+      group: 'analytics',
+      run: () => analytics.getTaskStatusReport().length,
+    },
+    {
+      name: 'analytics.projectProgressReport',
+      group: 'analytics',
+      run: () => analytics.getProjectProgressReport().length,
+    },
+    {
+      name: 'analytics.timeTrackingReport.year',
+      group: 'analytics',
+      run: () => analytics.getTimeTrackingReport({ startDate: yearAgo }).length,
+    },
+    {
+      name: 'analytics.projectStatistics',
+      group: 'analytics',
+      run: () => (analytics.getProjectStatistics(), 1),
+    },
+    {
+      name: 'dependencies.wouldCreateCycle.x1000',
+      group: 'dependencies',
+      run: () => {
+        const graph = dependencyRepo.getGraph();
+        for (let i = 0; i < 1000; i++) {
+          const taskIds = dataset.taskIdsByProject.get(pick(projectIds)) ?? [];
+          if (taskIds.length < 2) break;
+          graph.wouldCreateCycle(pick(taskIds), pick(taskIds));
+        }
+        return 1000;
+      },
+    },
+    {
+      name: 'dependencies.criticalPath',
+      group: 'dependencies',
+      run: () => dependencyRepo.getCriticalPath(pick(projectIds)).taskIds.length,
+    },
+    {
+      name: 'dependencies.criticalPath.cold',
+      group: 'dependencies',
+      run: () => {
+        // Drop the resident index so the project graph is reloaded from SQLite
+        dependencyRepo.getGraph().invalidate();
+        return dependencyRepo.getCriticalPath(pick(projectIds)).taskIds.length;
+      },
+    },
+    {
+      name: 'audit.query.latest',
+      group: 'audit',
+      run: () => auditLogger.query({ limit: 100 }).length,
+    },
+    {
+      name: 'audit.query.categoryPage',
+      group: 'audit',
+      run: () => auditLogger.query({ category: AuditCategory.Task, limit: 100, offset: 1000 }).length,
+    },
+    {
+      name: 'audit.query.entity',
+      group: 'audit',
+      run: () => auditLogger.query({ entityType: 'task', entityId: pick(allTaskIds) }).length,
+    },
+    {
+      name: 'audit.exportStream.json',
+      group: 'audit',
+      run: async () => {
+        const conn = openExportConnection(database.getPath());
+        try {
+          const result = await auditLogger.exportStream(conn, undefined, nullSink(), { format: 'json' });
+          return result.rows;
+        } finally {
+          conn.close();
+        }
+      },
+    },
+    {
+      name: 'audit.exportStream.csv.gzip',
+      group: 'audit',
+      run: async () => {
+        const conn = openExportConnection(database.getPath());
+        try {
+          const result = await auditLogger.exportStream(conn, undefined, nullSink(), { format: 'csv', gzip: true });
+          return result.rows;
+        } finally {
+          conn.close();
+        }
+      },
+    },
+    {
+      name: 'template.instantiate',
+      group: 'template',
+      run: () => templates.instantiateTemplate(dataset.templateId, 'Bench instance').tasks.length,
+    },
+    {
+      name: 'visionBoard.viewport',
+      group: 'visionBoard',
+      run: () => {
+        const view = boards.getBoardViewport(dataset.boardId, {
+          x: random() * 18000,
+          y: random() * 18000,
+          width: 1920,
+          height: 1080,
+        });
+        return view?.nodes.length ?? 0;
+      },
+    },
+    {
+      name: 'scan.directory',
+      group: 'scan',
+      run: async () => (await scanner.scanDirectory({
+        basePath: scanRoot,
+        maxDepth: 1,
+        useCache: false,
+        workers: args.workers,
+      })).length,
+    },
+    {
+      name: 'scan.directory.cached',
+      group: 'scan',
+      run: async () => (await scanner.scanDirectory({
+        basePath: scanRoot,
+        maxDepth: 1,
+        useCache: true,
+        workers: args.workers,
+      })).length,
+    },
+  ];
+
+  if (!args.only || args.only.length === 0) return scenarios;
+  return scenarios.filter(scenario =>
+    args.only!.some(filter => scenario.group === filter || scenario.name.startsWith(filter))
+  );
+}
+
+async function runScenario(scenario: Scenario, iterations: number, warmup: number): Promise<ScenarioResult> {
+  for (let i = 0; i < warmup; i++) {
+    await scenario.run();
+  }
+
+  const timings: number[] = [];
+  let items = 0;
+  for (let i = 0; i < iterations; i++) {
+    const started = process.hrtime.bigint();
+    items = await scenario.run();
+    timings.push(Number(process.hrtime.bigint() - started) / 1e6);
+  }
+
+  timings.sort((a, b) => a - b);
+  const round = (ms: number) => Math.round(ms * 1000) / 1000;
+  const quantile = (q: number) => timings[Math.min(timings.length - 1, Math.ceil(q * timings.length) - 1)];
+  return {
+    group: scenario.group,
+    iterations,
+    items,
+    minMs: round(timings[0]),
+    medianMs: round(quantile(0.5)),
+    p95Ms: round(quantile(0.95)),
+    maxMs: round(timings[timings.length - 1]),
+    meanMs: round(timings.reduce((sum, ms) => sum + ms, 0) / timings.length),
+  };
+}
+
+/**
+ * Writable that discards everything, so export scenarios time the
+ * database and serialization work rather than the disk
+ */
+function nullSink(): Writable {
+  return new Writable({
+    write(_chunk, _encoding, callback) {
+      callback();
+    },
+  });
+}
+
+function gitCommit(): string | null {
+  try {
+    return execFileSync('git', ['rev-parse', 'HEAD'], { stdio: ['ignore', 'pipe', 'ignore'] }).toString().trim();
+  } catch {
+    return null;
+  }
+}
+
+function printComparison(results: BenchResults, baselinePath: string): void {
+  let baseline: BenchResults;
+  try {
+    baseline = JSON.parse(fs.readFileSync(baselinePath, 'utf8'));
+  } catch (error) {
+    console.error(`❌ Cannot read ${baselinePath}: ${error instanceof Error ? error.message : error}`);
+    return;
+  }
+  if (baseline.formatVersion !== RESULT_FORMAT_VERSION) {
+    console.error(`❌ ${baselinePath} uses result format ${baseline.formatVersion}, expected ${RESULT_FORMAT_VERSION}`);
+    return;
+  }
+  if (JSON.stringify(baseline.options.data) !== JSON.stringify(results.options.data)) {
+    console.log('⚠️  Dataset options differ from the baseline; ratios compare different workloads');
+  }
+
+  console.log(`\nCompared to ${baseline.commit?.slice(0, 10) ?? baselinePath} (median, lower is better):`);
+  for (const [name, result] of Object.entries(results.scenarios)) {
+    const before = baseline.scenarios[name];
+    if (!before) {
+      console.log(`  ${name.padEnd(40)} new`);
+      continue;
+    }
+    const ratio = before.medianMs > 0 ? result.medianMs / before.medianMs : 1;
+    const sign = ratio <= 1 ? '' : '+';
+    console.log(
+      `  ${name.padEnd(40)} ${before.medianMs.toFixed(3).padStart(10)} -> ${result.medianMs.toFixed(3).padStart(10)} ms` +
+      `  (${sign}${((ratio - 1) * 100).toFixed(1)}%)`
+    );
+  }
+}
+
+async function main(): Promise<void> {
+  const args = parseArgs();
+  if (args.help) {
+    printHelp();
+    process.exit(0);
+  }
+
+  const scratchDir = fs.mkdtempSync(path.join(os.tmpdir(), 'devtrack-bench-'));
+  const dbPath = args.db ? path.resolve(args.db) : path.join(scratchDir, 'bench.db');
+  if (fs.existsSync(dbPath)) {
+    console.error(`❌ ${dbPath} already exists; the benchmark needs a fresh database`);
+    process.exit(1);
+  }
+  const scanRoot = path.join(scratchDir, 'scan');
+
+  // Repository and service logging would drown the report
+  const log = console.log;
+  console.log = () => {};
+
+  const database = new DevTrackDatabase(dbPath);
+  let auditLogger: AuditLogger | null = null;
+  let boards: VisionBoardManager | null = null;
+
+  try {
+    database.initialize();
+    const db = database.getDb();
+    auditLogger = new AuditLogger(db, database.getReadDb(), { mode: 'buffered' }, { enabled: false });
+    boards = new VisionBoardManager(db);
+    boards.initializeTables();
+
+    log(`Generating dataset in ${dbPath} ...`);
+    const generateStarted = Date.now();
+    const dataset = generateBenchData(db, args.data);
+    generateScanTree(scanRoot, args.scanProjects, args.scanFiles, args.data.seed);
+    db.pragma('optimize');
+    const generateMs = Date.now() - generateStarted;
+    log(`Generated ${Object.entries(dataset.counts).map(([key, count]) => `${count} ${key}`).join(', ')} in ${generateMs}ms\n`);
+
+    const results: BenchResults = {
+      formatVersion: RESULT_FORMAT_VERSION,
+      commit: gitCommit(),
+      startedAt: new Date().toISOString(),
+      environment: {
+        node: process.version,
+        sqlite: (db.prepare('SELECT sqlite_version() AS version').get() as { version: string }).version,
+        platform: `${os.platform()} ${os.release()}`,
+        arch: os.arch(),
+        cpu: os.cpus()[0]?.model ?? 'unknown',
+        cpus: os.cpus().length,
+        memoryMb: Math.round(os.totalmem() / 1024 / 1024),
+      },
+      options: {
+        data: args.data,
+        iterations: args.iterations,
+        warmup: args.warmup,
+        scanProjects: args.scanProjects,
+        scanFiles: args.scanFiles,
+        workers: args.workers,
+        only: args.only,
+      },
+      dataset: { ...dataset.counts, scanProjects: args.scanProjects, scanFiles: args.scanProjects * args.scanFiles },
+      generateMs,
+      scenarios: {},
+    };
+
+    for (const scenario of createScenarios(database, dataset, auditLogger, boards, scanRoot, args)) {
+      const result = await runScenario(scenario, args.iterations, args.warmup);
+      results.scenarios[scenario.name] = result;
+      log(
+        `  ${scenario.name.padEnd(40)} median ${result.medianMs.toFixed(3).padStart(10)} ms` +
+        `  p95 ${result.p95Ms.toFixed(3).padStart(10)} ms  (${result.items} items)`
+      );
+    }
+
+    const outPath = path.resolve(args.out);
+    fs.mkdirSync(path.dirname(outPath), { recursive: true });
+    fs.writeFileSync(outPath, JSON.stringify(results, null, 2) + '\n');
+    log(`\n✅ Results written to ${outPath}`);
+
+    if (args.compare) {
+      console.log = log;
+      printComparison(results, path.resolve(args.compare));
+    }
+  } finally {
+    console.log = log;
+    boards?.close();
+    auditLogger?.close();
+    database.close();
+    if (!args.keep) {
+      fs.rmSync(scratchDir, { recursive: true, force: true });
+      if (args.db) {
+        for (const suffix of ['', '-wal', '-shm']) fs.rmSync(dbPath + suffix, { force: true });
+      }
+    } else {
+      console.log(`Kept scratch data in ${scratchDir}${args.db ? ` and ${dbPath}` : ''}`);
+    }
+  }
+}
+
+main().catch(error => {
+  console.error('❌ Benchmark failed:', error);
+  process.exit(1);
+});
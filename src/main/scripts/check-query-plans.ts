@@ -0,0 +1,174 @@
+#!/usr/bin/env node
+
+/**
+ * check-query-plans.ts
+ *
+ * CLI script that runs EXPLAIN QUERY PLAN for the repositories' canonical
+ * queries and fails on full-table scans or temp B-tree sorts, so index
+ * regressions show up before a release. By default the queries are planned
+ * against a freshly migrated scratch database seeded with the benchmark
+ * data generator, so the check runs the same on CI as on a developer machine.
+ *
+ * Usage:
+ *   npm run check-query-plans -- [--db <path>] [--verbose]
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+import * as os from 'os';
+import Database from 'better-sqlite3';
+import { checkQueryPlans, formatQueryPlanReport } from '../database/queryPlanCheck';
+import { DevTrackDatabase } from '../database/Database';
+import { AuditLogger } from '../services/AuditLogger';
+import { VisionBoardManager } from '../services/VisionBoardManager';
+import { DEFAULT_BENCH_DATA_OPTIONS, BenchDataOptions, generateBenchData } from '../utils/benchData';
+
+// Enough rows per table for the planner to prefer indexes, small enough to seed in seconds
+const SEED_DATA: BenchDataOptions = {
+  ...DEFAULT_BENCH_DATA_OPTIONS,
+  projects: 5,
+  tasksPerProject: 200,
+  dependenciesPerProject: 100,
+  timeEntries: 5000,
+  auditRows: 10000,
+  boardNodes: 1000,
+  templateTasks: 20,
+};
+
+interface CliArgs {
+  db?: string;
+  verbose?: boolean;
+  help?: boolean;
+}
+
+function parseArgs(): CliArgs {
+  const args: CliArgs = {};
+  const argv = process.argv.slice(2);
+
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    const next = argv[i + 1];
+
+    switch (arg) {
+      case '--db':
+        args.db = next;
+        i++;
+        break;
+      case '--verbose':
+      case '-v':
+        args.verbose = true;
+        break;
+      case '--help':
+      case '-h':
+        args.help = true;
+        break;
+    }
+  }
+
+  return args;
+}
+
+function printHelp(): void {
+  console.log(`
+DevTrack Query Plan Check
+=========================
+
+Explain the hot repository queries and report full-table scans and
+temp B-tree sorts. Exits with status 1 when anything is found.
+
+Usage:
+  npm run check-query-plans -- [options]
+
+Options:
+  --db <path>      Existing database to check read-only (default: a seeded
+                   scratch database)
+  --verbose, -v    Print every query plan
+  --help, -h       Show this help message
+`);
+}
+
+function main(): void {
+  const args = parseArgs();
+  if (args.help) {
+    printHelp();
+    process.exit(0);
+  }
+
+  let db: Database.Database;
+  let cleanup = () => db.close();
+  if (args.db) {
+    const dbPath = path.resolve(args.db.replace(/^~/, os.homedir()));
+    console.log(`Using database: ${dbPath}`);
+    try {
+      db = new Database(dbPath, { readonly: true, fileMustExist: true });
+    } catch (error) {
+      console.error(`❌ Cannot open database: ${error instanceof Error ? error.message : error}`);
+      process.exit(1);
+    }
+  } else {
+    const scratch = createSeededDatabase();
+    db = scratch.db;
+    cleanup = scratch.close;
+  }
+
+  try {
+    console.log(`Schema version: ${db.pragma('user_version', { simple: true })}\n`);
+    const report = checkQueryPlans(db);
+
+    if (args.verbose) {
+      for (const [name, plan] of Object.entries(report.plans)) {
+        console.log(name);
+        for (const detail of plan) console.log(`  ${detail}`);
+      }
+      console.log('');
+    }
+    if (report.skipped.length > 0) {
+      console.log(`Skipped (tables not created yet): ${report.skipped.join(', ')}`);
+    }
+    console.log(formatQueryPlanReport(report));
+    process.exitCode = report.findings.length > 0 ? 1 : 0;
+  } finally {
+    cleanup();
+  }
+}
+
+/**
+ * Migrate a scratch database and fill it with benchmark data, so every
+ * module's tables and indexes exist and have realistic statistics
+ */
+function createSeededDatabase(): { db: Database.Database; close: () => void } {
+  const scratchDir = fs.mkdtempSync(path.join(os.tmpdir(), 'devtrack-query-plans-'));
+  console.log(`Seeding scratch database in ${scratchDir} ...`);
+
+  // Repository and service logging would drown the report
+  const log = console.log;
+  console.log = () => {};
+  const database = new DevTrackDatabase(path.join(scratchDir, 'query-plans.db'));
+  let auditLogger: AuditLogger | null = null;
+  let boards: VisionBoardManager | null = null;
+
+  const close = () => {
+    boards?.close();
+    auditLogger?.close();
+    database.close();
+    fs.rmSync(scratchDir, { recursive: true, force: true });
+  };
+
+  try {
+    database.initialize();
+    const db = database.getDb();
+    auditLogger = new AuditLogger(db, database.getReadDb(), { mode: 'buffered' }, { enabled: false });
+    boards = new VisionBoardManager(db);
+    boards.initializeTables();
+    generateBenchData(db, SEED_DATA);
+    db.pragma('optimize');
+    return { db, close };
+  } catch (error) {
+    close();
+    throw error;
+  } finally {
+    console.log = log;
+  }
+}
+
+main();
@@ -12,12 +12,16 @@
  *   npm run scan-projects -- --path /run/media/zajferx/Data/dev
  *   npm run scan-projects -- --path /run/media/zajferx/Data/dev/The-No-hands-Company/projects --preview
  *   npm run scan-projects -- --path ~/dev --max-depth 2 --skip-existing
+ *   npm run scan-projects -- --path ~/dev --workers 8 --full
+ *   npm run scan-projects -- --path ~/dev --watch
  */
 
 import * as path from 'path';
 import * as os from 'os';
 import Database from 'better-sqlite3';
 import { DirectoryScanner } from '../utils/DirectoryScanner';
+import { ProjectWatcher, DEFAULT_WATCH_DEBOUNCE_MS } from '../utils/ProjectWatcher';
+import { formatBytes } from '../utils/directoryStats';
 import { ProjectStatus } from '../models/Project';
 
 interface CliArgs {
@@ -27,6 +31,10 @@ interface CliArgs {
   skipExisting?: boolean;
   includeHidden?: boolean;
   status?: string;
+  workers?: number;
+  full?: boolean;
+  watch?: boolean;
+  debounce?: number;
   help?: boolean;
 }
 
@@ -63,6 +71,21 @@ function parseArgs(): CliArgs {
         args.status = next;
         i++;
         break;
+      case '--workers':
+      case '-w':
+        args.workers = parseInt(next, 10);
+        i++;
+        break;
+      case '--full':
+        args.full = true;
+        break;
+      case '--watch':
+        args.watch = true;
+        break;
+      case '--debounce':
+        args.debounce = parseInt(next, 10);
+        i++;
+        break;
       case '--help':
       case '-h':
         args.help = true;
@@ -90,6 +113,11 @@ Options:
   --skip-existing, -s       Skip projects that already exist
   --include-hidden          Include hidden directories (starting with .)
   --status <status>         Default project status (active, on_hold, completed, archived)
+  --workers, -w <number>    Worker threads for size calculation (default: CPUs - 1, max 4; 0 = none)
+  --full                    Ignore the directory cache and re-read every directory
+  --watch                   After importing, keep running and update project size,
+                            file count and last-modified date as files change
+  --debounce <ms>           Quiet period before changes are applied (default: ${DEFAULT_WATCH_DEBOUNCE_MS})
   --help, -h                Show this help message
 
 Examples:
@@ -105,6 +133,12 @@ Examples:
   # Import as archived projects
   npm run scan-projects -- --path /old-projects --status archived
 
+  # Force a full rescan with 8 workers
+  npm run scan-projects -- --path ~/dev --workers 8 --full
+
+  # Import, then keep imported projects up to date until Ctrl+C
+  npm run scan-projects -- --path ~/dev --watch
+
 Detected Project Types:
   - git      (has .git directory)
   - npm      (has package.json)
@@ -120,8 +154,10 @@ The scanner will:
   1. Recursively scan the specified directory
   2. Detect project types based on files present
   3. Extract descriptions from README or package.json
-  4. Calculate project size and file counts
+  4. Calculate project size and file counts in parallel, reusing cached
+     totals for directories whose modification time has not changed
   5. Import projects into DevTrack database
+  6. With --watch, apply filesystem changes to imported projects as they happen
 
 Project metadata will be stored in 5W1H format:
   - What: Project type and file count
@@ -179,6 +215,8 @@ async function main() {
     basePath: args.path,
     maxDepth: args.maxDepth || 3,
     includeHidden: args.includeHidden || false,
+    workers: args.workers !== undefined && !isNaN(args.workers) ? Math.max(0, args.workers) : undefined,
+    useCache: !args.full,
   };
 
   // Determine project status
@@ -193,6 +231,12 @@ async function main() {
     defaultStatus = statusMap[args.status.toLowerCase()] || ProjectStatus.Active;
   }
 
+  if (args.watch && args.preview) {
+    console.error('Error: --watch cannot be combined with --preview');
+    db.close();
+    process.exit(1);
+  }
+
   try {
     if (args.preview) {
       // Preview mode - just show what would be imported
@@ -211,12 +255,20 @@ async function main() {
       console.log(`Projects imported: ${result.imported}`);
       console.log(`Projects skipped: ${result.scanned - result.imported}`);
 
+      const scanStats = scanner.getLastScanStats();
+      console.log(`Directories read: ${scanStats.dirsRead} (reused from cache: ${scanStats.dirsReused})`);
+
       if (result.imported > 0) {
         console.log('\n✅ Projects successfully imported into DevTrack!');
         console.log('   Launch DevTrack to view your projects.');
       }
     }
 
+    if (args.watch) {
+      startWatching(db, args);
+      return;
+    }
+
     db.close();
     process.exit(0);
   } catch (error) {
@@ -226,4 +278,29 @@ async function main() {
   }
 }
 
+/**
+ * Keep imported projects under the scanned path fresh until interrupted
+ */
+function startWatching(db: Database.Database, args: CliArgs): void {
+  const watcher = new ProjectWatcher(db, {
+    basePath: args.path,
+    debounceMs: args.debounce !== undefined && !isNaN(args.debounce) ? args.debounce : undefined,
+    onUpdate: (update) => {
+      console.log(`Updated: ${update.name} (${update.fileCount} files, ${formatBytes(update.size)}, ${update.dirsRead} dirs read)`);
+    },
+  });
+
+  const count = watcher.start();
+  console.log(`\n👀 Watching ${count} projects for changes. Press Ctrl+C to stop.`);
+
+  const shutdown = async () => {
+    watcher.stop();
+    await watcher.idle();
+    db.close();
+    process.exit(0);
+  };
+  process.on('SIGINT', shutdown);
+  process.on('SIGTERM', shutdown);
+}
+
 main();
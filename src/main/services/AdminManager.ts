@@ -34,10 +34,14 @@ import {
   DEFAULT_QUOTA_LIMITS,
   DEFAULT_SYSTEM_SETTINGS
 } from '../models/Admin';
+import { migrateModuleSchema } from '../database/migrations';
+
+// Bump when initializeTables() changes (see database/migrations.ts)
+const SCHEMA_VERSION = 1;
 
 export class AdminManager {
   constructor(private db: Database.Database) {
-    this.initializeTables();
+    migrateModuleSchema(db, 'admin', SCHEMA_VERSION, () => this.initializeTables());
   }
 
   // ==================== Database Initialization ====================
@@ -15,9 +15,16 @@ import {
   ReportFilters
 } from '../models/Report';
 import { TaskStatus, TaskPriority } from '../models/Task';
+import { prepareCached } from '../database/StatementCache';
 
 /**
  * Analytics service for generating reports and statistics
+ *
+ * Count and total based reports read the agg_* tables maintained by
+ * triggers (see DevTrackDatabase.createAggregates), so their cost does not
+ * grow with the number of tasks. Date-relative figures (overdue, completed
+ * this week) still hit tasks, but through range scans on indexed columns.
+ * Time reports over a date range read the daily/weekly time rollups.
  */
 export class AnalyticsService {
   constructor(private db: Database.Database) {}
@@ -26,24 +33,22 @@ export class AnalyticsService {
    * Get task status distribution
    */
   getTaskStatusReport(filters?: ReportFilters): TaskStatusReport[] {
-    let query = `
-      SELECT 
-        status,
-        COUNT(*) as count,
-        ROUND(COUNT(*) * 100.0 / (SELECT COUNT(*) FROM tasks WHERE 1=1 ${this.buildWhereClause(filters)}), 2) as percentage
-      FROM tasks
+    const query = `
+      SELECT status, SUM(task_count) as count
+      FROM agg_project_task_counts
       WHERE 1=1 ${this.buildWhereClause(filters)}
       GROUP BY status
       ORDER BY count DESC
     `;
 
-    const stmt = this.db.prepare(query);
-    const rows = stmt.all(...this.getFilterValues(filters));
+    const stmt = prepareCached(this.db, query);
+    const rows = stmt.all(...this.getFilterValues(filters)) as Array<{ status: string; count: number }>;
+    const total = rows.reduce((sum, row) => sum + row.count, 0);
     
-    return rows.map((row: any) => ({
+    return rows.map((row) => ({
       status: row.status,
       count: row.count,
-      percentage: row.percentage || 0
+      percentage: this.toPercentage(row.count, total)
     }));
   }
 
@@ -51,12 +56,9 @@ export class AnalyticsService {
    * Get task priority distribution
    */
   getTaskPriorityReport(filters?: ReportFilters): TaskPriorityReport[] {
-    let query = `
-      SELECT 
-        priority,
-        COUNT(*) as count,
-        ROUND(COUNT(*) * 100.0 / (SELECT COUNT(*) FROM tasks WHERE 1=1 ${this.buildWhereClause(filters)}), 2) as percentage
-      FROM tasks
+    const query = `
+      SELECT priority, SUM(task_count) as count
+      FROM agg_project_task_counts
       WHERE 1=1 ${this.buildWhereClause(filters)}
       GROUP BY priority
       ORDER BY 
@@ -68,13 +70,14 @@ export class AnalyticsService {
         END
     `;
 
-    const stmt = this.db.prepare(query);
-    const rows = stmt.all(...this.getFilterValues(filters));
+    const stmt = prepareCached(this.db, query);
+    const rows = stmt.all(...this.getFilterValues(filters)) as Array<{ priority: string; count: number }>;
+    const total = rows.reduce((sum, row) => sum + row.count, 0);
     
-    return rows.map((row: any) => ({
+    return rows.map((row) => ({
       priority: row.priority,
       count: row.count,
-      percentage: row.percentage || 0
+      percentage: this.toPercentage(row.count, total)
     }));
   }
 
@@ -86,21 +89,21 @@ export class AnalyticsService {
       SELECT 
         p.id as project_id,
         p.name as project_name,
-        COUNT(t.id) as total_tasks,
-        SUM(CASE WHEN t.status = 'done' THEN 1 ELSE 0 END) as completed_tasks,
-        SUM(CASE WHEN t.status = 'in_progress' THEN 1 ELSE 0 END) as in_progress_tasks,
-        SUM(CASE WHEN t.status = 'todo' THEN 1 ELSE 0 END) as todo_tasks,
-        ROUND(SUM(CASE WHEN t.status = 'done' THEN 1 ELSE 0 END) * 100.0 / COUNT(t.id), 2) as completion_percentage
+        SUM(a.task_count) as total_tasks,
+        SUM(CASE WHEN a.status = 'done' THEN a.task_count ELSE 0 END) as completed_tasks,
+        SUM(CASE WHEN a.status = 'in_progress' THEN a.task_count ELSE 0 END) as in_progress_tasks,
+        SUM(CASE WHEN a.status = 'todo' THEN a.task_count ELSE 0 END) as todo_tasks,
+        ROUND(SUM(CASE WHEN a.status = 'done' THEN a.task_count ELSE 0 END) * 100.0 / SUM(a.task_count), 2) as completion_percentage
       FROM projects p
-      LEFT JOIN tasks t ON p.id = t.project_id
+      JOIN agg_project_task_counts a ON p.id = a.project_id
       WHERE 1=1
       ${projectIds && projectIds.length > 0 ? `AND p.id IN (${projectIds.map(() => '?').join(',')})` : ''}
       GROUP BY p.id, p.name
-      HAVING COUNT(t.id) > 0
+      HAVING SUM(a.task_count) > 0
       ORDER BY p.name
     `;
 
-    const stmt = this.db.prepare(query);
+    const stmt = prepareCached(this.db, query);
     const rows = projectIds && projectIds.length > 0 ? stmt.all(...projectIds) : stmt.all();
     
     return rows.map((row: any) => ({
@@ -118,24 +121,29 @@ export class AnalyticsService {
    * Get user workload report
    */
   getUserWorkloadReport(userIds?: number[]): UserWorkloadReport[] {
+    // Overdue depends on the current date, so it is counted per user with
+    // an (assigned_to, due_date) index range scan rather than materialized
     let query = `
       SELECT 
         u.id as user_id,
         u.display_name as user_name,
-        COUNT(t.id) as assigned_tasks,
-        SUM(CASE WHEN t.status = 'done' THEN 1 ELSE 0 END) as completed_tasks,
-        SUM(CASE WHEN t.status = 'in_progress' THEN 1 ELSE 0 END) as in_progress_tasks,
-        SUM(CASE WHEN t.due_date IS NOT NULL AND t.due_date < date('now') AND t.status != 'done' THEN 1 ELSE 0 END) as overdue_tasks
+        SUM(a.task_count) as assigned_tasks,
+        SUM(CASE WHEN a.status = 'done' THEN a.task_count ELSE 0 END) as completed_tasks,
+        SUM(CASE WHEN a.status = 'in_progress' THEN a.task_count ELSE 0 END) as in_progress_tasks,
+        (SELECT COUNT(*) FROM tasks t
+         WHERE t.assigned_to = CAST(u.id AS TEXT)
+           AND t.due_date < date('now')
+           AND t.status != 'done') as overdue_tasks
       FROM users u
-      LEFT JOIN tasks t ON CAST(u.id AS TEXT) = t.assigned_to
+      JOIN agg_assignee_task_counts a ON CAST(u.id AS TEXT) = a.assigned_to
       WHERE 1=1
       ${userIds && userIds.length > 0 ? `AND u.id IN (${userIds.map(() => '?').join(',')})` : ''}
       GROUP BY u.id, u.display_name
-      HAVING COUNT(t.id) > 0
+      HAVING SUM(a.task_count) > 0
       ORDER BY assigned_tasks DESC
     `;
 
-    const stmt = this.db.prepare(query);
+    const stmt = prepareCached(this.db, query);
     const rows = userIds && userIds.length > 0 ? stmt.all(...userIds) : stmt.all();
     
     return rows.map((row: any) => ({
@@ -152,39 +160,79 @@ export class AnalyticsService {
    * Get time tracking report
    */
   getTimeTrackingReport(dateRange?: DateRange, filters?: ReportFilters): TimeTrackingReport[] {
-    let query = `
+    if (this.isAllTime(dateRange)) {
+      return this.getTimeTrackingReportFromAggregates(filters);
+    }
+
+    const source = this.timeRollupSource(dateRange);
+    const query = `
+      SELECT 
+        a.user_id,
+        u.display_name as user_name,
+        t.project_id,
+        p.name as project_name,
+        SUM(a.total_seconds) / 3600.0 as total_hours,
+        SUM(a.billable_seconds) / 3600.0 as billable_hours,
+        (SUM(a.total_seconds) - SUM(a.billable_seconds)) / 3600.0 as non_billable_hours,
+        SUM(a.earnings) as earnings,
+        SUM(a.entries_count) as entries_count
+      FROM (${source.sql}) a
+      JOIN users u ON a.user_id = u.id
+      JOIN tasks t ON a.task_id = t.id
+      JOIN projects p ON t.project_id = p.id
+      WHERE 1=1
+      ${filters?.projectIds && filters.projectIds.length > 0 ? `AND t.project_id IN (${filters.projectIds.map(() => '?').join(',')})` : ''}
+      ${filters?.userIds && filters.userIds.length > 0 ? `AND a.user_id IN (${filters.userIds.map(() => '?').join(',')})` : ''}
+      GROUP BY a.user_id, u.display_name, t.project_id, p.name
+      HAVING SUM(a.entries_count) > 0
+      ORDER BY total_hours DESC
+    `;
+
+    const params: any[] = [...source.params];
+    if (filters?.projectIds) params.push(...filters.projectIds);
+    if (filters?.userIds) params.push(...filters.userIds);
+
+    const rows = prepareCached(this.db, query).all(...params);
+    return rows.map((row: any) => this.mapTimeTrackingRow(row));
+  }
+
+  /**
+   * All-time time tracking totals from agg_time_task_totals
+   */
+  private getTimeTrackingReportFromAggregates(filters?: ReportFilters): TimeTrackingReport[] {
+    const query = `
       SELECT 
-        te.user_id,
+        a.user_id,
         u.display_name as user_name,
         t.project_id,
         p.name as project_name,
-        SUM(te.duration) / 3600.0 as total_hours,
-        SUM(CASE WHEN te.is_billable = 1 THEN te.duration ELSE 0 END) / 3600.0 as billable_hours,
-        SUM(CASE WHEN te.is_billable = 0 THEN te.duration ELSE 0 END) / 3600.0 as non_billable_hours,
-        SUM(CASE WHEN te.is_billable = 1 THEN (te.duration / 3600.0) * COALESCE(te.hourly_rate, 0) ELSE 0 END) as earnings,
-        COUNT(te.id) as entries_count
-      FROM time_entries te
-      JOIN users u ON te.user_id = u.id
-      JOIN tasks t ON te.task_id = t.id
+        SUM(a.total_seconds) / 3600.0 as total_hours,
+        SUM(a.billable_seconds) / 3600.0 as billable_hours,
+        (SUM(a.total_seconds) - SUM(a.billable_seconds)) / 3600.0 as non_billable_hours,
+        SUM(a.earnings) as earnings,
+        SUM(a.entries_count) as entries_count
+      FROM agg_time_task_totals a
+      JOIN users u ON a.user_id = u.id
+      JOIN tasks t ON a.task_id = t.id
       JOIN projects p ON t.project_id = p.id
-      WHERE te.end_time IS NOT NULL
-      ${this.buildDateRangeClause(dateRange, 'te.start_time')}
+      WHERE 1=1
       ${filters?.projectIds && filters.projectIds.length > 0 ? `AND t.project_id IN (${filters.projectIds.map(() => '?').join(',')})` : ''}
-      ${filters?.userIds && filters.userIds.length > 0 ? `AND te.user_id IN (${filters.userIds.map(() => '?').join(',')})` : ''}
-      GROUP BY te.user_id, u.display_name, t.project_id, p.name
+      ${filters?.userIds && filters.userIds.length > 0 ? `AND a.user_id IN (${filters.userIds.map(() => '?').join(',')})` : ''}
+      GROUP BY a.user_id, u.display_name, t.project_id, p.name
+      HAVING SUM(a.entries_count) > 0
       ORDER BY total_hours DESC
     `;
 
     const params: any[] = [];
-    if (dateRange?.startDate) params.push(dateRange.startDate);
-    if (dateRange?.endDate) params.push(dateRange.endDate);
     if (filters?.projectIds) params.push(...filters.projectIds);
     if (filters?.userIds) params.push(...filters.userIds);
 
-    const stmt = this.db.prepare(query);
-    const rows = stmt.all(...params);
-    
-    return rows.map((row: any) => ({
+    const rows = prepareCached(this.db, query).all(...params);
+    return rows.map((row: any) => this.mapTimeTrackingRow(row));
+  }
+
+  private mapTimeTrackingRow(row: any): TimeTrackingReport {
+    return {
       userId: row.user_id,
       userName: row.user_name,
       projectId: row.project_id,
@@ -194,7 +242,7 @@ export class AnalyticsService {
       nonBillableHours: Number(row.non_billable_hours.toFixed(2)),
       earnings: Number(row.earnings.toFixed(2)),
       entriesCount: row.entries_count
-    }));
+    };
   }
 
   /**
@@ -249,7 +297,7 @@ export class AnalyticsService {
     if (projectId) params.push(projectId);
     if (projectId) params.push(projectId);
 
-    const stmt = this.db.prepare(query);
+    const stmt = prepareCached(this.db, query);
     const rows = stmt.all(...params);
     
     return rows.map((row: any) => ({
@@ -264,20 +312,21 @@ export class AnalyticsService {
    * Get project statistics
    */
   getProjectStatistics(): ProjectStatistics {
-    const stmt = this.db.prepare(`
+    // completed_at is ISO-8601 text, so comparing it to a date string is
+    // equivalent to date(completed_at) >= ... and can use idx_tasks_completed_at
+    const stmt = prepareCached(this.db, `
       SELECT 
         (SELECT COUNT(*) FROM projects) as total_projects,
         (SELECT COUNT(*) FROM projects WHERE status = 'active') as active_projects,
         (SELECT COUNT(*) FROM projects WHERE status = 'completed') as completed_projects,
-        (SELECT COUNT(*) FROM tasks) as total_tasks,
-        (SELECT COUNT(*) FROM tasks WHERE status = 'done') as completed_tasks,
+        (SELECT COALESCE(SUM(task_count), 0) FROM agg_project_task_counts) as total_tasks,
+        (SELECT COALESCE(SUM(task_count), 0) FROM agg_project_task_counts WHERE status = 'done') as completed_tasks,
         (SELECT COUNT(*) FROM tasks WHERE due_date < date('now') AND status != 'done') as overdue_tasks,
-        (SELECT COUNT(*) FROM tasks WHERE status = 'done' AND date(completed_at) >= date('now', '-7 days')) as tasks_completed_this_week,
-        (SELECT COUNT(*) FROM tasks WHERE status = 'done' AND date(completed_at) >= date('now', 'start of month')) as tasks_completed_this_month,
-        (SELECT AVG(julianday(completed_at) - julianday(created_at)) 
-         FROM tasks WHERE completed_at IS NOT NULL) as avg_completion_time,
-        (SELECT CAST(COUNT(*) AS REAL) / COUNT(DISTINCT project_id) 
-         FROM tasks) as avg_tasks_per_project
+        (SELECT COUNT(*) FROM tasks WHERE completed_at >= date('now', '-7 days') AND status = 'done') as tasks_completed_this_week,
+        (SELECT COUNT(*) FROM tasks WHERE completed_at >= date('now', 'start of month') AND status = 'done') as tasks_completed_this_month,
+        (SELECT SUM(completion_days) / SUM(completed_count) FROM agg_project_task_counts) as avg_completion_time,
+        (SELECT CAST(SUM(task_count) AS REAL) / COUNT(DISTINCT project_id) 
+         FROM agg_project_task_counts) as avg_tasks_per_project
     `);
     
     const row: any = stmt.get();
@@ -300,27 +349,26 @@ export class AnalyticsService {
    * Get user statistics
    */
   getUserStatistics(): UserStatistics {
-    const stmt = this.db.prepare(`
+    const stmt = prepareCached(this.db, `
       SELECT 
         (SELECT COUNT(*) FROM users) as total_users,
-        (SELECT COUNT(DISTINCT assigned_to) FROM tasks WHERE assigned_to IS NOT NULL) as active_users,
-        (SELECT COUNT(*) FROM tasks WHERE assigned_to IS NOT NULL) as total_tasks_assigned,
-        (SELECT COUNT(*) FROM tasks WHERE status = 'done' AND assigned_to IS NOT NULL) as total_tasks_completed,
-        (SELECT CAST(COUNT(*) AS REAL) / COUNT(DISTINCT assigned_to) 
-         FROM tasks WHERE assigned_to IS NOT NULL) as avg_tasks_per_user
+        (SELECT COUNT(DISTINCT assigned_to) FROM agg_assignee_task_counts) as active_users,
+        (SELECT COALESCE(SUM(task_count), 0) FROM agg_assignee_task_counts) as total_tasks_assigned,
+        (SELECT COALESCE(SUM(task_count), 0) FROM agg_assignee_task_counts WHERE status = 'done') as total_tasks_completed,
+        (SELECT CAST(SUM(task_count) AS REAL) / COUNT(DISTINCT assigned_to) 
+         FROM agg_assignee_task_counts) as avg_tasks_per_user
     `);
     
     const row: any = stmt.get();
     
-    const topPerformersStmt = this.db.prepare(`
+    const topPerformersStmt = prepareCached(this.db, `
       SELECT 
         u.id as user_id,
         u.display_name as user_name,
-        COUNT(t.id) as completed_tasks
+        a.task_count as completed_tasks
       FROM users u
-      JOIN tasks t ON CAST(u.id AS TEXT) = t.assigned_to
-      WHERE t.status = 'done'
-      GROUP BY u.id, u.display_name
+      JOIN agg_assignee_task_counts a ON CAST(u.id AS TEXT) = a.assigned_to
+      WHERE a.status = 'done'
       ORDER BY completed_tasks DESC
       LIMIT 5
     `);
@@ -346,39 +394,36 @@ export class AnalyticsService {
    */
   getTimeStatistics(dateRange?: DateRange): TimeStatistics {
     const { startDate, endDate } = this.resolveDateRange(dateRange);
-    
-    const stmt = this.db.prepare(`
+    const source = this.timeRollupSource(dateRange);
+
+    const row: any = prepareCached(this.db, `
       SELECT 
-        SUM(duration) / 3600.0 as total_hours,
-        SUM(CASE WHEN is_billable = 1 THEN duration ELSE 0 END) / 3600.0 as billable_hours,
-        SUM(CASE WHEN is_billable = 1 THEN (duration / 3600.0) * COALESCE(hourly_rate, 0) ELSE 0 END) as total_earnings,
-        AVG(duration) / 3600.0 as avg_hours_per_entry
-      FROM time_entries
-      WHERE end_time IS NOT NULL
-        AND date(start_time) BETWEEN ? AND ?
-    `);
-    
-    const row: any = stmt.get(startDate, endDate);
+        SUM(total_seconds) / 3600.0 as total_hours,
+        SUM(billable_seconds) / 3600.0 as billable_hours,
+        SUM(earnings) as total_earnings,
+        SUM(entries_count) as entries_count
+      FROM (${source.sql})
+    `).get(...source.params);
     
     const daysCount = this.getDaysBetween(startDate, endDate);
     const avgHoursPerDay = daysCount > 0 ? (row.total_hours || 0) / daysCount : 0;
+    const avgHoursPerEntry = row.entries_count > 0 ? row.total_hours / row.entries_count : 0;
     
-    const topProjectsStmt = this.db.prepare(`
+    const topProjectsStmt = prepareCached(this.db, `
       SELECT 
         p.id as project_id,
         p.name as project_name,
-        SUM(te.duration) / 3600.0 as hours
-      FROM time_entries te
-      JOIN tasks t ON te.task_id = t.id
+        SUM(a.total_seconds) / 3600.0 as hours
+      FROM (${source.sql}) a
+      JOIN tasks t ON a.task_id = t.id
       JOIN projects p ON t.project_id = p.id
-      WHERE te.end_time IS NOT NULL
-        AND date(te.start_time) BETWEEN ? AND ?
       GROUP BY p.id, p.name
+      HAVING SUM(a.entries_count) > 0
       ORDER BY hours DESC
       LIMIT 5
     `);
     
-    const mostTrackedProjects = topProjectsStmt.all(startDate, endDate).map((r: any) => ({
+    const mostTrackedProjects = topProjectsStmt.all(...source.params).map((r: any) => ({
       projectId: r.project_id,
       projectName: r.project_name,
       hours: Number(r.hours.toFixed(2))
@@ -389,13 +434,21 @@ export class AnalyticsService {
       billableHours: Number((row.billable_hours || 0).toFixed(2)),
       totalEarnings: Number((row.total_earnings || 0).toFixed(2)),
       averageHoursPerDay: Number(avgHoursPerDay.toFixed(2)),
-      averageHoursPerTask: Number((row.avg_hours_per_entry || 0).toFixed(2)),
+      averageHoursPerTask: Number(avgHoursPerEntry.toFixed(2)),
       mostTrackedProjects
     };
   }
 
   // Helper methods
 
+  private toPercentage(count: number, total: number): number {
+    return total > 0 ? Math.round((count * 10000) / total) / 100 : 0;
+  }
+
+  private isAllTime(dateRange?: DateRange): boolean {
+    return !dateRange || (dateRange.period === 'all' && !dateRange.startDate && !dateRange.endDate);
+  }
+
   private buildWhereClause(filters?: ReportFilters): string {
     if (!filters) return '';
     
@@ -426,13 +479,6 @@ export class AnalyticsService {
     return values;
   }
 
-  private buildDateRangeClause(dateRange?: DateRange, column: string = 'created_at'): string {
-    if (!dateRange) return '';
-    
-    const { startDate, endDate } = this.resolveDateRange(dateRange);
-    return `AND date(${column}) BETWEEN '${startDate}' AND '${endDate}'`;
-  }
-
   private resolveDateRange(dateRange?: DateRange): { startDate: string; endDate: string } {
     if (dateRange?.startDate && dateRange?.endDate) {
       return { startDate: dateRange.startDate, endDate: dateRange.endDate };
@@ -464,6 +510,58 @@ export class AnalyticsService {
     return { startDate, endDate };
   }
 
+  /**
+   * Rollup rows covering a date range: whole Monday-Sunday weeks from
+   * agg_time_weekly and the partial weeks at either edge from
+   * agg_time_daily. Entries are bucketed by the UTC day they start on,
+   * matching the date(start_time) filter used before the rollups existed.
+   */
+  private timeRollupSource(dateRange?: DateRange): { sql: string; params: string[] } {
+    const range = this.resolveDateRange(dateRange);
+    const startDate = range.startDate.slice(0, 10);
+    const endDate = range.endDate.slice(0, 10);
+    const columns = 'user_id, task_id, entries_count, total_seconds, billable_seconds, earnings';
+    const parts: string[] = [];
+    const params: string[] = [];
+    const addDays = (from: string, to: string) => {
+      parts.push(`SELECT ${columns} FROM agg_time_daily WHERE day BETWEEN ? AND ?`);
+      params.push(from, to);
+    };
+
+    const first = this.parseDay(startDate);
+    const last = this.parseDay(endDate);
+    // First Monday on or after the start, last Sunday on or before the end
+    const firstWeek = this.shiftDays(first, (8 - first.getUTCDay()) % 7);
+    const lastWeekEnd = this.shiftDays(last, -(last.getUTCDay() % 7));
+
+    if (firstWeek.getTime() > lastWeekEnd.getTime()) {
+      addDays(startDate, endDate);
+    } else {
+      if (firstWeek.getTime() > first.getTime()) {
+        addDays(startDate, this.formatDay(this.shiftDays(firstWeek, -1)));
+      }
+      parts.push(`SELECT ${columns} FROM agg_time_weekly WHERE week BETWEEN ? AND ?`);
+      params.push(this.formatDay(firstWeek), this.formatDay(this.shiftDays(lastWeekEnd, -6)));
+      if (lastWeekEnd.getTime() < last.getTime()) {
+        addDays(this.formatDay(this.shiftDays(lastWeekEnd, 1)), endDate);
+      }
+    }
+
+    return { sql: parts.join(' UNION ALL '), params };
+  }
+
+  private parseDay(date: string): Date {
+    return new Date(`${date}T00:00:00Z`);
+  }
+
+  private shiftDays(date: Date, days: number): Date {
+    return new Date(date.getTime() + days * 24 * 60 * 60 * 1000);
+  }
+
+  private formatDay(date: Date): string {
+    return date.toISOString().slice(0, 10);
+  }
+
   private getDaysBetween(startDate: string, endDate: string): number {
     const start = new Date(startDate);
     const end = new Date(endDate);
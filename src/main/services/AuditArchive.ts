@@ -0,0 +1,507 @@
+import Database from 'better-sqlite3';
+import * as fs from 'fs';
+import * as path from 'path';
+import * as zlib from 'zlib';
+import { promisify } from 'util';
+import { prepareCached } from '../database/StatementCache';
+import {
+  AuditArchiveSettings,
+  AuditArchiveStats,
+  AuditFilters,
+  AuditSummary,
+  DEFAULT_AUDIT_ARCHIVE_SETTINGS,
+} from '../models/AuditLog';
+import { ftsTokens, matchesSearchTerm, toSearchTerms } from '../models/Search';
+
+const gzip = promisify(zlib.gzip);
+
+/**
+ * An audit_logs row as stored, which is also the segment file format
+ */
+export interface AuditLogRow {
+  id: number;
+  timestamp: string;
+  user_id: number | null;
+  username: string | null;
+  action: string;
+  category: string;
+  severity: string;
+  entity_type: string | null;
+  entity_id: number | null;
+  entity_name: string | null;
+  description: string;
+  changes: string | null;
+  metadata: string | null;
+  ip_address: string;
+  user_agent: string;
+  session_id: string | null;
+  success: number;
+  error_message: string | null;
+}
+
+interface SegmentRow {
+  id: number;
+  file: string;
+  min_id: number;
+  max_id: number;
+  min_timestamp: string;
+  max_timestamp: string;
+  entry_count: number;
+  bytes: number;
+  summary: string;
+}
+
+// First background run waits for startup to settle
+const START_DELAY_MS = 30 * 1000;
+// Entries younger than this always stay in audit_logs
+const MIN_ARCHIVE_AFTER_DAYS = 30;
+// Decompressed segments kept for paging through the same history
+const SEGMENT_CACHE_SIZE = 4;
+
+/**
+ * Create the segment manifest and its lookup index. Called from
+ * AuditLogger.initializeTable(), which owns the 'audit' schema version.
+ */
+export function createAuditArchiveTables(db: Database.Database): void {
+  db.exec(`
+    CREATE TABLE IF NOT EXISTS audit_archive_segments (
+      id INTEGER PRIMARY KEY AUTOINCREMENT,
+      file TEXT NOT NULL UNIQUE,
+      min_id INTEGER NOT NULL,
+      max_id INTEGER NOT NULL,
+      min_timestamp TEXT NOT NULL,
+      max_timestamp TEXT NOT NULL,
+      entry_count INTEGER NOT NULL,
+      bytes INTEGER NOT NULL,
+      summary TEXT NOT NULL,
+      created_at DATETIME NOT NULL DEFAULT CURRENT_TIMESTAMP
+    );
+
+    CREATE INDEX IF NOT EXISTS idx_audit_archive_segments_time ON audit_archive_segments(max_timestamp, min_timestamp);
+    CREATE INDEX IF NOT EXISTS idx_audit_archive_segments_ids ON audit_archive_segments(min_id, max_id);
+
+    -- Which segments hold entries for a user (u:<id>), entity type (t:<type>),
+    -- entity (e:<type>:<id>) or category (c:<category>)
+    CREATE TABLE IF NOT EXISTS audit_archive_index (
+      key TEXT NOT NULL,
+      segment_id INTEGER NOT NULL REFERENCES audit_archive_segments(id) ON DELETE CASCADE,
+      PRIMARY KEY (key, segment_id)
+    ) WITHOUT ROWID;
+
+    CREATE INDEX IF NOT EXISTS idx_audit_archive_index_segment ON audit_archive_index(segment_id);
+  `);
+}
+
+/**
+ * AuditArchive - Cold tier for audit history.
+ *
+ * Entries older than archiveAfterDays are moved out of audit_logs in
+ * background chunks of segmentSize rows. Each chunk becomes an immutable,
+ * gzip-compressed JSON segment file next to the database, described by a
+ * row in audit_archive_segments (id and time bounds plus precomputed report
+ * counts) and keyed in audit_archive_index by user, entity and category.
+ * Chunks are taken oldest first, so segments never overlap in time and are
+ * all older than anything left in audit_logs.
+ *
+ * The file is written and synced before the manifest row is inserted and
+ * the rows deleted in one transaction, so a crash leaves at worst an
+ * unreferenced file that the next run overwrites. Only full segments are
+ * written; a trickle of aged entries waits until a segment's worth has
+ * accumulated.
+ *
+ * Moving rows out frees pages that new entries reuse, which stops the
+ * database from growing; shrinking the file itself still takes a VACUUM.
+ */
+export class AuditArchive {
+  private settings: AuditArchiveSettings;
+  private readonly dir: string | null;
+  private timer: NodeJS.Timeout | null = null;
+  private running = false;
+  private closed = false;
+  private cache = new Map<number, AuditLogRow[]>();
+  private lastRunAt: string | null = null;
+  private lastRunArchived = 0;
+
+  constructor(
+    private db: Database.Database,
+    private readDb: Database.Database = db,
+    settings?: Partial<AuditArchiveSettings>
+  ) {
+    this.settings = { ...DEFAULT_AUDIT_ARCHIVE_SETTINGS, ...settings };
+    this.settings.segmentSize = Math.max(100, Math.floor(this.settings.segmentSize));
+    // AdminManager's activity stats read the last 30 days from audit_logs
+    this.settings.archiveAfterDays = Math.max(MIN_ARCHIVE_AFTER_DAYS, this.settings.archiveAfterDays);
+    // In-memory databases have nowhere to put segment files
+    this.dir = db.memory ? null : path.join(path.dirname(db.name), 'audit-archive');
+    // Only the writer moves entries; workers just read segments
+    if (this.settings.enabled && this.dir && !db.readonly) {
+      this.schedule(START_DELAY_MS);
+    }
+  }
+
+  /**
+   * Move up to maxSegmentsPerRun full segments of aged entries out of
+   * audit_logs. Returns the number of entries archived.
+   */
+  async archive(now: number = Date.now()): Promise<number> {
+    if (this.running || !this.dir || this.db.readonly) return 0;
+    this.running = true;
+    let archived = 0;
+    try {
+      await fs.promises.mkdir(this.dir, { recursive: true });
+      const cutoff = new Date(now - this.settings.archiveAfterDays * 24 * 60 * 60 * 1000).toISOString();
+      for (let i = 0; i < this.settings.maxSegmentsPerRun && !this.closed; i++) {
+        const moved = await this.archiveChunk(cutoff);
+        if (moved === 0) break;
+        archived += moved;
+      }
+      if (archived > 0) {
+        console.log(`[AuditArchive] Archived ${archived} entries older than ${cutoff}`);
+      }
+    } finally {
+      this.running = false;
+      this.lastRunAt = new Date().toISOString();
+      this.lastRunArchived = archived;
+    }
+    return archived;
+  }
+
+  /**
+   * Archived rows matching `filters`, newest first, at most `limit` of them.
+   * Segments are read newest first and skipped using the manifest, so a
+   * limited query only decompresses the segments it needs.
+   */
+  query(filters: AuditFilters | undefined, limit: number = Number.POSITIVE_INFINITY): AuditLogRow[] {
+    const results: AuditLogRow[] = [];
+    if (limit <= 0) return results;
+
+    for (const row of this.iterate(filters)) {
+      results.push(row);
+      if (results.length >= limit) break;
+    }
+    return results;
+  }
+
+  /**
+   * Archived rows matching `filters`, newest first, one segment in memory at
+   * a time. The manifest is read now, through `conn`: an export passes its
+   * own connection, inside a transaction that also covers its audit_logs
+   * read, so an archive run in between cannot move rows from one to the
+   * other. Those one-off reads bypass the segment cache.
+   */
+  iterate(filters?: AuditFilters, conn: Database.Database = this.readDb): Iterable<AuditLogRow> {
+    const segments = this.findSegments(filters, conn);
+    return this.rowsIn(segments, filters, conn === this.readDb);
+  }
+
+  private *rowsIn(segments: SegmentRow[], filters: AuditFilters | undefined, cache: boolean): Generator<AuditLogRow> {
+    const terms = searchTerms(filters?.searchQuery);
+    for (const segment of segments) {
+      const rows = this.loadSegment(segment, cache);
+      // Segment files are in (timestamp, id) order
+      for (let i = rows.length - 1; i >= 0; i--) {
+        if (matchesFilters(rows[i], filters, terms)) yield rows[i];
+      }
+    }
+  }
+
+  getById(id: number): AuditLogRow | null {
+    const segments = prepareCached(this.readDb, `
+      SELECT * FROM audit_archive_segments WHERE min_id <= ? AND max_id >= ?
+    `).all(id, id) as SegmentRow[];
+    for (const segment of segments) {
+      const row = this.loadSegment(segment).find(candidate => candidate.id === id);
+      if (row) return row;
+    }
+    return null;
+  }
+
+  /**
+   * Report counts over archived entries in [startDate, endDate]. Segments
+   * wholly inside the range use their stored summary; only the (at most
+   * two) segments straddling a bound are decompressed.
+   */
+  summarize(range?: { startDate?: string; endDate?: string }): AuditSummary {
+    const total = emptySummary();
+    for (const segment of this.findSegments(range)) {
+      const inside = (!range?.startDate || segment.min_timestamp >= range.startDate)
+        && (!range?.endDate || segment.max_timestamp <= range.endDate);
+      if (inside) {
+        mergeSummary(total, JSON.parse(segment.summary) as AuditSummary);
+      } else {
+        const rows = this.loadSegment(segment).filter(row =>
+          (!range?.startDate || row.timestamp >= range.startDate) && (!range?.endDate || row.timestamp <= range.endDate));
+        mergeSummary(total, summarizeRows(rows));
+      }
+    }
+    return total;
+  }
+
+  /**
+   * Drop segments whose newest entry is older than `cutoff`. Segments are
+   * immutable, so one straddling the cutoff is kept whole.
+   */
+  deleteBefore(cutoff: string): number {
+    const segments = prepareCached(this.db, 'SELECT * FROM audit_archive_segments WHERE max_timestamp < ?')
+      .all(cutoff) as SegmentRow[];
+    if (segments.length === 0) return 0;
+
+    this.db.transaction(() => {
+      // audit_archive_index rows go with their segment (ON DELETE CASCADE)
+      const remove = prepareCached(this.db, 'DELETE FROM audit_archive_segments WHERE id = ?');
+      for (const segment of segments) {
+        remove.run(segment.id);
+      }
+    })();
+    for (const segment of segments) {
+      this.cache.delete(segment.id);
+      if (this.dir) fs.rm(path.join(this.dir, segment.file), { force: true }, () => undefined);
+    }
+    return segments.reduce((sum, segment) => sum + segment.entry_count, 0);
+  }
+
+  getStats(): AuditArchiveStats {
+    const row = prepareCached(this.readDb, `
+      SELECT COUNT(*) AS segments, COALESCE(SUM(entry_count), 0) AS entries, COALESCE(SUM(bytes), 0) AS bytes,
+             MIN(min_timestamp) AS oldest, MAX(max_timestamp) AS newest
+      FROM audit_archive_segments
+    `).get() as { segments: number; entries: number; bytes: number; oldest: string | null; newest: string | null };
+    return {
+      enabled: this.settings.enabled && this.dir !== null,
+      directory: this.dir,
+      segments: row.segments,
+      entries: row.entries,
+      bytes: row.bytes,
+      oldestTimestamp: row.oldest,
+      newestTimestamp: row.newest,
+      lastRunAt: this.lastRunAt,
+      lastRunArchived: this.lastRunArchived,
+    };
+  }
+
+  /**
+   * Stop background runs. A chunk being compressed is abandoned before its
+   * rows are deleted.
+   */
+  close(): void {
+    this.closed = true;
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    this.cache.clear();
+  }
+
+  private schedule(delayMs: number): void {
+    if (this.closed) return;
+    this.timer = setTimeout(() => {
+      this.timer = null;
+      this.archive()
+        .catch(error => console.error('[AuditArchive] Archive run failed:', error))
+        .finally(() => this.schedule(this.settings.intervalMs));
+    }, delayMs);
+    this.timer.unref();
+  }
+
+  private async archiveChunk(cutoff: string): Promise<number> {
+    const rows = prepareCached(this.db, `
+      SELECT * FROM audit_logs WHERE timestamp < ? ORDER BY timestamp, id LIMIT ?
+    `).all(cutoff, this.settings.segmentSize) as AuditLogRow[];
+    if (rows.length < this.settings.segmentSize) return 0;
+
+    const ids = rows.map(row => row.id);
+    const minId = Math.min(...ids);
+    const maxId = Math.max(...ids);
+    const file = `segment-${minId}-${maxId}.json.gz`;
+    const target = path.join(this.dir!, file);
+
+    // Compression runs on the libuv pool; the main thread only serializes
+    const data = await gzip(JSON.stringify(rows));
+    const temp = `${target}.tmp`;
+    const handle = await fs.promises.open(temp, 'w');
+    try {
+      await handle.writeFile(data);
+      await handle.sync();
+    } finally {
+      await handle.close();
+    }
+    await fs.promises.rename(temp, target);
+    if (this.closed) return 0;
+
+    const committed = this.db.transaction(() => {
+      // Rows removed meanwhile (retention cleanup) make the segment stale
+      const present = prepareCached(this.db, `
+        SELECT COUNT(*) AS count FROM audit_logs WHERE id IN (SELECT value FROM json_each(?))
+      `).get(JSON.stringify(ids)) as { count: number };
+      if (present.count !== rows.length) return false;
+
+      const segment = prepareCached(this.db, `
+        INSERT INTO audit_archive_segments
+          (file, min_id, max_id, min_timestamp, max_timestamp, entry_count, bytes, summary)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+      `).run(
+        file, minId, maxId, rows[0].timestamp, rows[rows.length - 1].timestamp,
+        rows.length, data.length, JSON.stringify(summarizeRows(rows))
+      );
+      const segmentId = Number(segment.lastInsertRowid);
+      const index = prepareCached(this.db, 'INSERT OR IGNORE INTO audit_archive_index (key, segment_id) VALUES (?, ?)');
+      for (const key of indexKeys(rows)) {
+        index.run(key, segmentId);
+      }
+      prepareCached(this.db, 'DELETE FROM audit_logs WHERE id IN (SELECT value FROM json_each(?))').run(JSON.stringify(ids));
+      return true;
+    })();
+
+    if (!committed) {
+      await fs.promises.rm(target, { force: true });
+      return 0;
+    }
+    return rows.length;
+  }
+
+  /**
+   * Segments that may hold entries matching `filters`, newest first
+   */
+  private findSegments(filters?: AuditFilters, conn: Database.Database = this.readDb): SegmentRow[] {
+    let sql = 'SELECT * FROM audit_archive_segments WHERE 1=1';
+    const params: any[] = [];
+    if (filters?.startDate) {
+      sql += ' AND max_timestamp >= ?';
+      params.push(filters.startDate);
+    }
+    if (filters?.endDate) {
+      sql += ' AND min_timestamp <= ?';
+      params.push(filters.endDate);
+    }
+    for (const key of filterKeys(filters)) {
+      sql += ' AND id IN (SELECT segment_id FROM audit_archive_index WHERE key = ?)';
+      params.push(key);
+    }
+    sql += ' ORDER BY max_timestamp DESC, id DESC';
+    return prepareCached(conn, sql).all(...params) as SegmentRow[];
+  }
+
+  private loadSegment(segment: SegmentRow, cache = true): AuditLogRow[] {
+    const cached = this.cache.get(segment.id);
+    if (cached) {
+      // Refresh its place in the LRU order
+      this.cache.delete(segment.id);
+      this.cache.set(segment.id, cached);
+      return cached;
+    }
+    if (!this.dir) return [];
+
+    let rows: AuditLogRow[];
+    try {
+      rows = JSON.parse(zlib.gunzipSync(fs.readFileSync(path.join(this.dir, segment.file))).toString('utf8'));
+    } catch (error) {
+      // Dropped by retention cleanup after the manifest was read
+      if ((error as NodeJS.ErrnoException).code === 'ENOENT') return [];
+      throw error;
+    }
+    if (!cache) return rows;
+    this.cache.set(segment.id, rows);
+    if (this.cache.size > SEGMENT_CACHE_SIZE) {
+      this.cache.delete(this.cache.keys().next().value!);
+    }
+    return rows;
+  }
+}
+
+/**
+ * Counts for the reports over a set of rows
+ */
+export function summarizeRows(rows: AuditLogRow[]): AuditSummary {
+  const summary = emptySummary();
+  for (const row of rows) {
+    summary.total++;
+    if (row.success === 0) summary.failures++;
+    summary.byCategory[row.category] = (summary.byCategory[row.category] ?? 0) + 1;
+    summary.byAction[row.action] = (summary.byAction[row.action] ?? 0) + 1;
+    summary.bySeverity[row.severity] = (summary.bySeverity[row.severity] ?? 0) + 1;
+    if (row.user_id !== null) {
+      const key = `${row.user_id}:${row.username ?? ''}`;
+      const user = summary.byUser[key] ?? { userId: row.user_id, username: row.username, count: 0 };
+      user.count++;
+      summary.byUser[key] = user;
+    }
+    const hour = String(parseInt(row.timestamp.slice(11, 13), 10));
+    summary.byHour[hour] = (summary.byHour[hour] ?? 0) + 1;
+  }
+  return summary;
+}
+
+export function emptySummary(): AuditSummary {
+  return { total: 0, failures: 0, byCategory: {}, byAction: {}, bySeverity: {}, byUser: {}, byHour: {} };
+}
+
+/**
+ * Add `from` into `into`
+ */
+export function mergeSummary(into: AuditSummary, from: AuditSummary): AuditSummary {
+  into.total += from.total;
+  into.failures += from.failures;
+  for (const field of ['byCategory', 'byAction', 'bySeverity', 'byHour'] as const) {
+    for (const [key, count] of Object.entries(from[field])) {
+      into[field][key] = (into[field][key] ?? 0) + count;
+    }
+  }
+  for (const [key, user] of Object.entries(from.byUser)) {
+    const existing = into.byUser[key];
+    if (existing) existing.count += user.count;
+    else into.byUser[key] = { ...user };
+  }
+  return into;
+}
+
+function indexKeys(rows: AuditLogRow[]): Set<string> {
+  const keys = new Set<string>();
+  for (const row of rows) {
+    keys.add(`c:${row.category}`);
+    if (row.user_id !== null) keys.add(`u:${row.user_id}`);
+    if (row.entity_type !== null) {
+      keys.add(`t:${row.entity_type}`);
+      if (row.entity_id !== null) keys.add(`e:${row.entity_type}:${row.entity_id}`);
+    }
+  }
+  return keys;
+}
+
+function filterKeys(filters?: AuditFilters): string[] {
+  const keys: string[] = [];
+  if (filters?.category) keys.push(`c:${filters.category}`);
+  if (filters?.userId) keys.push(`u:${filters.userId}`);
+  if (filters?.entityType && filters.entityId) keys.push(`e:${filters.entityType}:${filters.entityId}`);
+  else if (filters?.entityType) keys.push(`t:${filters.entityType}`);
+  return keys;
+}
+
+/**
+ * Archived entries have no FTS index; a search matches entries where every
+ * term matches the description, entity name or username, tokenized and
+ * matched the way the FTS query does for audit_logs
+ */
+function searchTerms(query?: string): string[][] {
+  return query ? toSearchTerms(query) : [];
+}
+
+/**
+ * The same filter semantics as AuditLogger.query()
+ */
+function matchesFilters(row: AuditLogRow, filters: AuditFilters | undefined, terms: string[][]): boolean {
+  if (!filters) return true;
+  if (filters.userId && row.user_id !== filters.userId) return false;
+  if (filters.action && row.action !== filters.action) return false;
+  if (filters.category && row.category !== filters.category) return false;
+  if (filters.severity && row.severity !== filters.severity) return false;
+  if (filters.entityType && row.entity_type !== filters.entityType) return false;
+  if (filters.entityId && row.entity_id !== filters.entityId) return false;
+  if (filters.startDate && row.timestamp < filters.startDate) return false;
+  if (filters.endDate && row.timestamp > filters.endDate) return false;
+  if (filters.success !== undefined && row.success !== (filters.success ? 1 : 0)) return false;
+  if (terms.length > 0) {
+    const columns = [row.description, row.entity_name ?? '', row.username ?? ''].map(ftsTokens);
+    if (!terms.every(term => columns.some(tokens => matchesSearchTerm(tokens, term)))) return false;
+  }
+  return true;
+}
@@ -1,4 +1,5 @@
 import Database from 'better-sqlite3';
+import { Writable } from 'stream';
 import {
   AuditLog,
   AuditAction,
@@ -8,16 +9,185 @@ import {
   AuditFilters,
   AuditReport,
   ComplianceReport,
+  AuditWriterSettings,
+  AuditWriterStats,
+  AuditArchiveSettings,
+  AuditArchiveStats,
+  AuditSummary,
+  DEFAULT_AUDIT_WRITER_SETTINGS,
   getActionCategory,
   getActionSeverity,
+  isSeverityAtLeast,
 } from '../models/AuditLog';
+import { toFtsMatchQuery } from '../models/Search';
+import { prepareCached } from '../database/StatementCache';
+import { migrateModuleSchema } from '../database/migrations';
+import { AuditArchive, AuditLogRow, createAuditArchiveTables, mergeSummary } from './AuditArchive';
+import { ExportResult } from '../models/Export';
+import { ExportColumn, StreamExportOptions, exportRows } from '../utils/streamingExport';
+
+// Bump when initializeTable() changes (see database/migrations.ts)
+const SCHEMA_VERSION = 3;
+
+type AuditEntryInput = Omit<AuditLog, 'id' | 'timestamp' | 'category' | 'severity'>;
+
+/**
+ * Audit entry waiting in the write buffer. Category, severity and timestamp
+ * are resolved at log() time; JSON serialization is deferred to the flush.
+ */
+interface PendingAuditEntry {
+  entry: AuditEntryInput;
+  timestamp: string;
+  category: AuditCategory;
+  severity: AuditSeverity;
+}
+
+const INSERT_AUDIT_LOG_SQL = `INSERT INTO audit_logs (
+  timestamp, user_id, username, action, category, severity,
+  entity_type, entity_id, entity_name, description, changes, metadata,
+  ip_address, user_agent, session_id, success, error_message
+) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)`;
+
+// The columns of exportToCsv()
+const AUDIT_CSV_COLUMNS: ExportColumn<AuditLog>[] = [
+  { header: 'ID', value: log => log.id },
+  { header: 'Timestamp', value: log => log.timestamp },
+  { header: 'User ID', value: log => log.userId },
+  { header: 'Username', value: log => log.username },
+  { header: 'Action', value: log => log.action },
+  { header: 'Category', value: log => log.category },
+  { header: 'Severity', value: log => log.severity },
+  { header: 'Entity Type', value: log => log.entityType },
+  { header: 'Entity ID', value: log => log.entityId },
+  { header: 'Entity Name', value: log => log.entityName },
+  { header: 'Description', value: log => log.description },
+  { header: 'Success', value: log => (log.success ? 'Yes' : 'No') },
+  { header: 'IP Address', value: log => log.ipAddress },
+];
+
+// Queries below are also planned by database/queryPlanCheck.ts
+
+/**
+ * SELECT over audit_logs for `filters`, newest first, without a limit
+ */
+export function buildAuditQuery(filters?: AuditFilters): { query: string; params: any[] } {
+  let query = 'SELECT * FROM audit_logs WHERE 1=1';
+  const params: any[] = [];
+
+  if (filters?.userId) {
+    query += ' AND user_id = ?';
+    params.push(filters.userId);
+  }
+  if (filters?.action) {
+    query += ' AND action = ?';
+    params.push(filters.action);
+  }
+  if (filters?.category) {
+    query += ' AND category = ?';
+    params.push(filters.category);
+  }
+  if (filters?.severity) {
+    query += ' AND severity = ?';
+    params.push(filters.severity);
+  }
+  if (filters?.entityType) {
+    query += ' AND entity_type = ?';
+    params.push(filters.entityType);
+  }
+  if (filters?.entityId) {
+    query += ' AND entity_id = ?';
+    params.push(filters.entityId);
+  }
+  if (filters?.startDate) {
+    query += ' AND timestamp >= ?';
+    params.push(filters.startDate);
+  }
+  if (filters?.endDate) {
+    query += ' AND timestamp <= ?';
+    params.push(filters.endDate);
+  }
+  if (filters?.searchQuery) {
+    const match = toFtsMatchQuery(filters.searchQuery);
+    if (match) {
+      query += ' AND id IN (SELECT rowid FROM audit_logs_fts WHERE audit_logs_fts MATCH ?)';
+      params.push(match);
+    }
+  }
+  if (filters?.success !== undefined) {
+    query += ' AND success = ?';
+    params.push(filters.success ? 1 : 0);
+  }
+
+  query += ' ORDER BY timestamp DESC';
+  return { query, params };
+}
+
+/**
+ * WHERE clause for an optional timestamp range; see buildDateParams
+ */
+export function auditDateWhere(filters?: { startDate?: string; endDate?: string }): string {
+  let where = 'WHERE 1=1';
+  if (filters?.startDate) where += ' AND timestamp >= ?';
+  if (filters?.endDate) where += ' AND timestamp <= ?';
+  return where;
+}
+
+/**
+ * Per-`column` entry counts over audit_logs for a date range (see auditDateWhere)
+ */
+export function auditCountBySql(column: string, filters?: { startDate?: string; endDate?: string }): string {
+  return `SELECT ${column} AS key, COUNT(*) as count FROM audit_logs ${auditDateWhere(filters)} GROUP BY key`;
+}
+
+export const AUDIT_ENTITY_HISTORY_SQL =
+  'SELECT * FROM audit_logs WHERE entity_type = ? AND entity_id = ? ORDER BY timestamp DESC LIMIT ?';
+export const AUDIT_USER_ACTIVITY_SQL = 'SELECT * FROM audit_logs WHERE user_id = ? ORDER BY timestamp DESC LIMIT ?';
 
 /**
  * AuditLogger - Comprehensive audit trail system
+ *
+ * In buffered mode entries are collected in a fixed-size ring buffer and
+ * written in a single transaction (group commit) when the buffer fills, the
+ * flush interval elapses, an entry meets the flushOnSeverity policy, or
+ * close() is called. Queries flush first so reads always see every entry.
+ *
+ * Entries older than the archive threshold move to compressed segment
+ * files (see AuditArchive). Queries, lookups and reports read both tiers:
+ * audit_logs first, topped up from the archive when a limit is not met.
  */
 export class AuditLogger {
-  constructor(private db: Database.Database) {
-    this.initializeTable();
+  private settings: AuditWriterSettings;
+  private ring: (PendingAuditEntry | undefined)[];
+  private ringHead = 0;
+  private ringCount = 0;
+  private flushTimer: NodeJS.Timeout | null = null;
+  private archive: AuditArchive;
+  private stats = {
+    flushes: 0,
+    entriesWritten: 0,
+    backPressureFlushes: 0,
+    failedFlushes: 0,
+    lastFlushAt: null as string | null,
+  };
+
+  /**
+   * @param db Writer connection used for inserts, deletes and DDL
+   * @param readDb Optional read-only connection for queries and reports
+   * @param settings Write mode and durability policy
+   * @param archiveSettings When and how entries move to the archive tier
+   */
+  constructor(
+    private db: Database.Database,
+    private readDb: Database.Database = db,
+    settings?: Partial<AuditWriterSettings>,
+    archiveSettings?: Partial<AuditArchiveSettings>
+  ) {
+    this.settings = { ...DEFAULT_AUDIT_WRITER_SETTINGS, ...settings };
+    this.settings.bufferSize = Math.max(1, Math.floor(this.settings.bufferSize));
+    this.ring = new Array(this.settings.bufferSize);
+    // Read-only connections (query workers) rely on the writer's schema
+    migrateModuleSchema(db, 'audit', SCHEMA_VERSION, () => this.initializeTable());
+    this.archive = new AuditArchive(db, readDb, archiveSettings);
   }
 
   private initializeTable(): void {
@@ -44,53 +214,233 @@ export class AuditLogger {
         FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE SET NULL
       );
 
-      CREATE INDEX IF NOT EXISTS idx_audit_logs_timestamp ON audit_logs(timestamp);
-      CREATE INDEX IF NOT EXISTS idx_audit_logs_user_id ON audit_logs(user_id);
       CREATE INDEX IF NOT EXISTS idx_audit_logs_action ON audit_logs(action);
-      CREATE INDEX IF NOT EXISTS idx_audit_logs_category ON audit_logs(category);
       CREATE INDEX IF NOT EXISTS idx_audit_logs_severity ON audit_logs(severity);
-      CREATE INDEX IF NOT EXISTS idx_audit_logs_entity ON audit_logs(entity_type, entity_id);
       CREATE INDEX IF NOT EXISTS idx_audit_logs_success ON audit_logs(success);
+
+      -- Every listing is newest first, so filters lead and timestamp follows.
+      -- (timestamp, category) also covers the by-category statistics.
+      CREATE INDEX IF NOT EXISTS idx_audit_logs_timestamp_category ON audit_logs(timestamp, category);
+      CREATE INDEX IF NOT EXISTS idx_audit_logs_category_timestamp ON audit_logs(category, timestamp);
+      CREATE INDEX IF NOT EXISTS idx_audit_logs_user_timestamp ON audit_logs(user_id, timestamp);
+      CREATE INDEX IF NOT EXISTS idx_audit_logs_entity_timestamp ON audit_logs(entity_type, entity_id, timestamp);
+
+      DROP INDEX IF EXISTS idx_audit_logs_timestamp;
+      DROP INDEX IF EXISTS idx_audit_logs_user_id;
+      DROP INDEX IF EXISTS idx_audit_logs_category;
+      DROP INDEX IF EXISTS idx_audit_logs_entity;
     `);
+    this.initializeSearchIndex();
+    createAuditArchiveTables(this.db);
   }
 
   /**
-   * Log an audit entry
+   * FTS5 index over description, entity name and username, kept in sync by
+   * triggers. Audit rows are append-mostly, so only insert and delete (from
+   * retention cleanup) need handling.
    */
-  log(entry: Omit<AuditLog, 'id' | 'timestamp' | 'category' | 'severity'>): number {
-    const timestamp = new Date().toISOString();
-    const category = getActionCategory(entry.action);
-    const severity = getActionSeverity(entry.action);
-
-    const result = this.db
-      .prepare(
-        `INSERT INTO audit_logs (
-          timestamp, user_id, username, action, category, severity,
-          entity_type, entity_id, entity_name, description, changes, metadata,
-          ip_address, user_agent, session_id, success, error_message
-        ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)`
-      )
-      .run(
-        timestamp,
-        entry.userId || null,
-        entry.username || null,
-        entry.action,
-        category,
-        severity,
-        entry.entityType || null,
-        entry.entityId || null,
-        entry.entityName || null,
-        entry.description,
-        entry.changes ? JSON.stringify(entry.changes) : null,
-        entry.metadata ? JSON.stringify(entry.metadata) : null,
-        entry.ipAddress,
-        entry.userAgent,
-        entry.sessionId || null,
-        entry.success ? 1 : 0,
-        entry.errorMessage || null
+  private initializeSearchIndex(): void {
+    const needsBackfill = !this.db
+      .prepare("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'audit_logs_fts'")
+      .get();
+
+    this.db.exec(`
+      CREATE VIRTUAL TABLE IF NOT EXISTS audit_logs_fts USING fts5(
+        description, entity_name, username,
+        content = 'audit_logs', content_rowid = 'id',
+        tokenize = 'unicode61 remove_diacritics 2'
       );
 
-    return result.lastInsertRowid as number;
+      CREATE TRIGGER IF NOT EXISTS trg_audit_logs_fts_insert AFTER INSERT ON audit_logs BEGIN
+        INSERT INTO audit_logs_fts(rowid, description, entity_name, username)
+        VALUES (NEW.id, NEW.description, NEW.entity_name, NEW.username);
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_audit_logs_fts_delete AFTER DELETE ON audit_logs BEGIN
+        INSERT INTO audit_logs_fts(audit_logs_fts, rowid, description, entity_name, username)
+        VALUES ('delete', OLD.id, OLD.description, OLD.entity_name, OLD.username);
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_audit_logs_fts_update
+      AFTER UPDATE OF description, entity_name, username ON audit_logs BEGIN
+        INSERT INTO audit_logs_fts(audit_logs_fts, rowid, description, entity_name, username)
+        VALUES ('delete', OLD.id, OLD.description, OLD.entity_name, OLD.username);
+        INSERT INTO audit_logs_fts(rowid, description, entity_name, username)
+        VALUES (NEW.id, NEW.description, NEW.entity_name, NEW.username);
+      END;
+    `);
+
+    if (needsBackfill) {
+      console.log('[AuditLogger] Building search index...');
+      this.db.exec("INSERT INTO audit_logs_fts(audit_logs_fts) VALUES ('rebuild')");
+    }
+  }
+
+  /**
+   * Log an audit entry
+   *
+   * Returns the new row id when the entry is written immediately, or 0 when
+   * it was buffered. Buffered entries are serialized at flush time, so callers
+   * must not mutate `changes`/`metadata` after logging.
+   */
+  log(entry: AuditEntryInput): number {
+    const pending: PendingAuditEntry = {
+      entry,
+      timestamp: new Date().toISOString(),
+      category: getActionCategory(entry.action),
+      severity: getActionSeverity(entry.action),
+    };
+
+    if (this.settings.mode === 'immediate') {
+      return this.writeEntries([pending]);
+    }
+
+    // Back-pressure: never drop audit entries, write the full buffer out
+    // first. If that write fails the entry is refused with the error.
+    if (this.ringCount === this.settings.bufferSize) {
+      this.stats.backPressureFlushes++;
+      this.flush();
+    }
+
+    this.ring[(this.ringHead + this.ringCount) % this.settings.bufferSize] = pending;
+    this.ringCount++;
+
+    const { flushOnSeverity } = this.settings;
+    if (flushOnSeverity && isSeverityAtLeast(pending.severity, flushOnSeverity)) {
+      return this.flush();
+    }
+    if (this.ringCount === this.settings.bufferSize) {
+      // The entry is already buffered, so a failed write is retried later
+      try {
+        this.flush();
+      } catch (error) {
+        console.error('[AuditLogger] Flush failed, keeping entries buffered:', error);
+        this.scheduleFlush();
+      }
+    } else {
+      this.scheduleFlush();
+    }
+    return 0;
+  }
+
+  /**
+   * Write all buffered entries in one transaction.
+   * Returns the row id of the last entry written, or 0 if nothing was pending.
+   * Entries leave the buffer only once the transaction commits; on failure
+   * they stay buffered and the error is rethrown.
+   */
+  flush(): number {
+    if (this.flushTimer) {
+      clearTimeout(this.flushTimer);
+      this.flushTimer = null;
+    }
+    if (this.ringCount === 0) {
+      return 0;
+    }
+
+    const batch: PendingAuditEntry[] = [];
+    for (let i = 0; i < this.ringCount; i++) {
+      batch.push(this.ring[(this.ringHead + i) % this.settings.bufferSize]!);
+    }
+
+    let lastId: number;
+    try {
+      lastId = this.writeEntries(batch);
+    } catch (error) {
+      this.stats.failedFlushes++;
+      throw error;
+    }
+
+    for (let i = 0; i < batch.length; i++) {
+      this.ring[(this.ringHead + i) % this.settings.bufferSize] = undefined;
+    }
+    this.ringHead = 0;
+    this.ringCount = 0;
+    return lastId;
+  }
+
+  /**
+   * Flush pending entries and stop the background timers (call on shutdown)
+   */
+  close(): void {
+    this.archive.close();
+    this.flush();
+  }
+
+  /**
+   * Move aged entries to the archive now instead of waiting for the next
+   * background run. Returns the number of entries archived.
+   */
+  archiveNow(): Promise<number> {
+    this.flush();
+    return this.archive.archive();
+  }
+
+  getArchiveStats(): AuditArchiveStats {
+    return this.archive.getStats();
+  }
+
+  /**
+   * Get buffered writer counters
+   */
+  getWriterStats(): AuditWriterStats {
+    return {
+      mode: this.settings.mode,
+      buffered: this.ringCount,
+      ...this.stats,
+    };
+  }
+
+  private scheduleFlush(): void {
+    if (this.flushTimer) return;
+    this.flushTimer = setTimeout(() => {
+      this.flushTimer = null;
+      try {
+        this.flush();
+      } catch (error) {
+        // Entries are still buffered; try again after the next interval
+        console.error('[AuditLogger] Background flush failed:', error);
+        this.scheduleFlush();
+      }
+    }, this.settings.flushIntervalMs);
+    // Do not keep the process alive just for a pending flush
+    this.flushTimer.unref();
+  }
+
+  private writeEntries(batch: PendingAuditEntry[]): number {
+    const stmt = prepareCached(this.db, INSERT_AUDIT_LOG_SQL);
+    let lastId = 0;
+
+    const insertAll = this.db.transaction((entries: PendingAuditEntry[]) => {
+      for (const { entry, timestamp, category, severity } of entries) {
+        const result = stmt.run(
+          timestamp,
+          entry.userId || null,
+          entry.username || null,
+          entry.action,
+          category,
+          severity,
+          entry.entityType || null,
+          entry.entityId || null,
+          entry.entityName || null,
+          entry.description,
+          entry.changes ? JSON.stringify(entry.changes) : null,
+          entry.metadata ? JSON.stringify(entry.metadata) : null,
+          entry.ipAddress,
+          entry.userAgent,
+          entry.sessionId || null,
+          entry.success ? 1 : 0,
+          entry.errorMessage || null
+        );
+        lastId = result.lastInsertRowid as number;
+      }
+    });
+    insertAll(batch);
+
+    this.stats.flushes++;
+    this.stats.entriesWritten += batch.length;
+    this.stats.lastFlushAt = new Date().toISOString();
+    return lastId;
   }
 
   /**
@@ -167,71 +517,84 @@ export class AuditLogger {
    * Query audit logs with filters
    */
   query(filters?: AuditFilters): AuditLog[] {
-    let query = 'SELECT * FROM audit_logs WHERE 1=1';
-    const params: any[] = [];
+    this.flush();
+    let { query, params } = buildAuditQuery(filters);
 
-    if (filters?.userId) {
-      query += ' AND user_id = ?';
-      params.push(filters.userId);
-    }
-    if (filters?.action) {
-      query += ' AND action = ?';
-      params.push(filters.action);
-    }
-    if (filters?.category) {
-      query += ' AND category = ?';
-      params.push(filters.category);
-    }
-    if (filters?.severity) {
-      query += ' AND severity = ?';
-      params.push(filters.severity);
-    }
-    if (filters?.entityType) {
-      query += ' AND entity_type = ?';
-      params.push(filters.entityType);
-    }
-    if (filters?.entityId) {
-      query += ' AND entity_id = ?';
-      params.push(filters.entityId);
-    }
-    if (filters?.startDate) {
-      query += ' AND timestamp >= ?';
-      params.push(filters.startDate);
-    }
-    if (filters?.endDate) {
-      query += ' AND timestamp <= ?';
-      params.push(filters.endDate);
-    }
-    if (filters?.searchQuery) {
-      query += ' AND (description LIKE ? OR entity_name LIKE ? OR username LIKE ?)';
-      const searchPattern = `%${filters.searchQuery}%`;
-      params.push(searchPattern, searchPattern, searchPattern);
-    }
-    if (filters?.success !== undefined) {
-      query += ' AND success = ?';
-      params.push(filters.success ? 1 : 0);
+    // The offset is applied after merging in archived entries, so each tier
+    // is asked for offset + limit rows
+    const wanted = filters?.limit ? filters.limit + (filters.offset ?? 0) : Number.POSITIVE_INFINITY;
+    if (filters?.limit) {
+      query += ' LIMIT ?';
+      params.push(wanted);
     }
 
-    query += ' ORDER BY timestamp DESC';
+    const rows = prepareCached(this.readDb, query).all(...params) as AuditLogRow[];
+    const merged = this.withArchived(rows, filters, wanted);
+    const page = filters?.limit ? merged.slice(filters.offset ?? 0, wanted) : merged;
+    return page.map(this.mapRowToAuditLog);
+  }
 
-    if (filters?.limit) {
-      query += ' LIMIT ?';
-      params.push(filters.limit);
-      if (filters.offset) {
-        query += ' OFFSET ?';
-        params.push(filters.offset);
+  /**
+   * Stream the entries query() would return to `destination`, reading
+   * audit_logs row by row through `conn` (see openExportConnection) and then
+   * the archive segment by segment
+   */
+  exportStream(
+    conn: Database.Database,
+    filters: AuditFilters | undefined,
+    destination: Writable,
+    options: StreamExportOptions
+  ): Promise<ExportResult> {
+    this.flush();
+    return exportRows(this.exportRows(conn, filters), {
+      toRecord: this.mapRowToAuditLog,
+      columns: AUDIT_CSV_COLUMNS,
+    }, destination, options);
+  }
+
+  private *exportRows(conn: Database.Database, filters: AuditFilters | undefined): Generator<AuditLogRow> {
+    const { query, params } = buildAuditQuery(filters);
+    let skip = filters?.offset ?? 0;
+    let remaining = filters?.limit ?? Number.POSITIVE_INFINITY;
+
+    // One read transaction over both tiers; the archive manifest is its first read
+    conn.exec('BEGIN');
+    try {
+      const archived = this.archive.iterate(filters, conn);
+      const hot = conn.prepare(query).iterate(...params) as IterableIterator<AuditLogRow>;
+      for (const tier of [hot, archived]) {
+        for (const row of tier) {
+          if (skip > 0) {
+            skip--;
+            continue;
+          }
+          yield row;
+          if (--remaining <= 0) return;
+        }
       }
+    } finally {
+      if (conn.inTransaction) conn.exec('COMMIT');
     }
+  }
 
-    const rows = this.db.prepare(query).all(...params) as any[];
-    return rows.map(this.mapRowToAuditLog);
+  /**
+   * Top `rows` (newest first, at most `wanted`) up with archived entries
+   */
+  private withArchived(rows: AuditLogRow[], filters: AuditFilters | undefined, wanted: number): AuditLogRow[] {
+    if (rows.length >= wanted) return rows;
+    const archived = this.archive.query(filters, wanted - rows.length);
+    if (archived.length === 0) return rows;
+    // Archived entries are older than everything left in audit_logs
+    return rows.concat(archived);
   }
 
   /**
    * Get audit log by ID
    */
   getById(id: number): AuditLog | null {
-    const row = this.db.prepare('SELECT * FROM audit_logs WHERE id = ?').get(id) as any;
+    this.flush();
+    const row = (prepareCached(this.readDb, 'SELECT * FROM audit_logs WHERE id = ?').get(id) as AuditLogRow | undefined)
+      ?? this.archive.getById(id);
     return row ? this.mapRowToAuditLog(row) : null;
   }
 
@@ -239,99 +602,43 @@ export class AuditLogger {
    * Get audit logs for a specific entity
    */
   getEntityHistory(entityType: string, entityId: number, limit = 50): AuditLog[] {
-    const rows = this.db
-      .prepare(
-        `SELECT * FROM audit_logs 
-         WHERE entity_type = ? AND entity_id = ? 
-         ORDER BY timestamp DESC 
-         LIMIT ?`
-      )
-      .all(entityType, entityId, limit) as any[];
+    this.flush();
+    const rows = prepareCached(this.readDb, AUDIT_ENTITY_HISTORY_SQL)
+      .all(entityType, entityId, limit) as AuditLogRow[];
 
-    return rows.map(this.mapRowToAuditLog);
+    return this.withArchived(rows, { entityType, entityId }, limit).map(this.mapRowToAuditLog);
   }
 
   /**
    * Get user activity log
    */
   getUserActivity(userId: number, limit = 100): AuditLog[] {
-    const rows = this.db
-      .prepare(
-        `SELECT * FROM audit_logs 
-         WHERE user_id = ? 
-         ORDER BY timestamp DESC 
-         LIMIT ?`
-      )
-      .all(userId, limit) as any[];
+    this.flush();
+    const rows = prepareCached(this.readDb, AUDIT_USER_ACTIVITY_SQL)
+      .all(userId, limit) as AuditLogRow[];
 
-    return rows.map(this.mapRowToAuditLog);
+    return this.withArchived(rows, { userId }, limit).map(this.mapRowToAuditLog);
   }
 
   /**
    * Generate audit report
    */
   generateReport(filters?: { startDate?: string; endDate?: string }): AuditReport {
-    const where = this.buildDateWhere(filters);
-    const params = this.buildDateParams(filters);
-
-    // Total entries
-    const totalRow = this.db
-      .prepare(`SELECT COUNT(*) as count FROM audit_logs ${where}`)
-      .get(...params) as any;
-    const totalEntries = totalRow.count;
-
-    // By category
-    const categoryRows = this.db
-      .prepare(
-        `SELECT category, COUNT(*) as count FROM audit_logs ${where} GROUP BY category`
-      )
-      .all(...params) as any[];
-    const byCategory = Object.fromEntries(
-      categoryRows.map((r) => [r.category, r.count])
-    ) as Record<AuditCategory, number>;
-
-    // By action
-    const actionRows = this.db
-      .prepare(`SELECT action, COUNT(*) as count FROM audit_logs ${where} GROUP BY action`)
-      .all(...params) as any[];
-    const byAction = Object.fromEntries(actionRows.map((r) => [r.action, r.count]));
+    this.flush();
+    const summary = this.summarize(filters);
 
-    // By severity
-    const severityRows = this.db
-      .prepare(
-        `SELECT severity, COUNT(*) as count FROM audit_logs ${where} GROUP BY severity`
-      )
-      .all(...params) as any[];
-    const bySeverity = Object.fromEntries(
-      severityRows.map((r) => [r.severity, r.count])
-    ) as Record<AuditSeverity, number>;
-
-    // By user
-    const userRows = this.db
-      .prepare(
-        `SELECT user_id, username, COUNT(*) as count 
-         FROM audit_logs ${where} AND user_id IS NOT NULL
-         GROUP BY user_id, username
-         ORDER BY count DESC`
-      )
-      .all(...params) as any[];
-    const byUser = userRows.map((r) => ({
-      userId: r.user_id,
-      username: r.username || 'Unknown',
-      count: r.count,
-    }));
+    const byUser = Object.values(summary.byUser)
+      .sort((a, b) => b.count - a.count)
+      .map((u) => ({ userId: u.userId, username: u.username || 'Unknown', count: u.count }));
 
     // Top actions
-    const topActions = actionRows
-      .sort((a, b) => b.count - a.count)
+    const topActions = Object.entries(summary.byAction)
+      .sort((a, b) => b[1] - a[1])
       .slice(0, 10)
-      .map((r) => ({ action: r.action as AuditAction, count: r.count }));
+      .map(([action, count]) => ({ action: action as AuditAction, count }));
 
     // Failure rate
-    const failureRow = this.db
-      .prepare(`SELECT COUNT(*) as count FROM audit_logs ${where} AND success = 0`)
-      .get(...params) as any;
-    const failureRate = totalEntries > 0 ? (failureRow.count / totalEntries) * 100 : 0;
+    const failureRate = summary.total > 0 ? (summary.failures / summary.total) * 100 : 0;
 
     // Most active users
     const mostActiveUsers = byUser.slice(0, 10).map((u) => ({
@@ -341,25 +648,19 @@ export class AuditLogger {
     }));
 
     // Most active hours
-    const hourRows = this.db
-      .prepare(
-        `SELECT CAST(strftime('%H', timestamp) AS INTEGER) as hour, COUNT(*) as count
-         FROM audit_logs ${where}
-         GROUP BY hour
-         ORDER BY count DESC`
-      )
-      .all(...params) as any[];
-    const mostActiveHours = hourRows.map((r) => ({ hour: r.hour, count: r.count }));
+    const mostActiveHours = Object.entries(summary.byHour)
+      .map(([hour, count]) => ({ hour: Number(hour), count }))
+      .sort((a, b) => b.count - a.count);
 
     return {
-      totalEntries,
+      totalEntries: summary.total,
       dateRange: {
         start: filters?.startDate || 'all time',
         end: filters?.endDate || 'now',
       },
-      byCategory,
-      byAction,
-      bySeverity,
+      byCategory: summary.byCategory as Record<AuditCategory, number>,
+      byAction: summary.byAction,
+      bySeverity: summary.bySeverity as Record<AuditSeverity, number>,
       byUser,
       topActions,
       failureRate,
@@ -369,65 +670,69 @@ export class AuditLogger {
   }
 
   /**
-   * Generate compliance report
+   * Report counts over both tiers
    */
-  generateComplianceReport(period?: { start?: string; end?: string }): ComplianceReport {
-    const dateFilters = period ? {
-      startDate: period.start,
-      endDate: period.end
-    } : undefined;
-    
-    const where = this.buildDateWhere(dateFilters);
-    const params = this.buildDateParams(dateFilters);
+  private summarize(filters?: { startDate?: string; endDate?: string }): AuditSummary {
+    const where = auditDateWhere(filters);
+    const params = this.buildDateParams(filters);
 
-    const totalRow = this.db
-      .prepare(`SELECT COUNT(*) as count FROM audit_logs ${where}`)
+    const totalRow = prepareCached(this.readDb, `SELECT COUNT(*) as count FROM audit_logs ${where}`)
       .get(...params) as any;
-
-    const securityRow = this.db
-      .prepare(`SELECT COUNT(*) as count FROM audit_logs ${where} AND category = 'security'`)
+    const failureRow = prepareCached(this.readDb, `SELECT COUNT(*) as count FROM audit_logs ${where} AND success = 0`)
       .get(...params) as any;
+    const countBy = (column: string) => Object.fromEntries(
+      (prepareCached(this.readDb, auditCountBySql(column, filters))
+        .all(...params) as any[]).map((r) => [r.key, r.count])
+    );
 
-    const dataAccessRow = this.db
-      .prepare(
-        `SELECT COUNT(*) as count FROM audit_logs ${where} AND action LIKE '%downloaded%'`
+    const userRows = prepareCached(this.readDb,
+        `SELECT user_id, username, COUNT(*) as count
+         FROM audit_logs ${where} AND user_id IS NOT NULL
+         GROUP BY user_id, username`
       )
-      .get(...params) as any;
+      .all(...params) as any[];
 
-    const dataModRow = this.db
-      .prepare(
-        `SELECT COUNT(*) as count FROM audit_logs ${where} AND (action LIKE '%updated%' OR action LIKE '%deleted%' OR action LIKE '%created%')`
-      )
-      .get(...params) as any;
+    const hot: AuditSummary = {
+      total: totalRow.count,
+      failures: failureRow.count,
+      byCategory: countBy('category'),
+      byAction: countBy('action'),
+      bySeverity: countBy('severity'),
+      byUser: Object.fromEntries(userRows.map((r) => [
+        `${r.user_id}:${r.username ?? ''}`,
+        { userId: r.user_id, username: r.username, count: r.count },
+      ])),
+      byHour: countBy("CAST(strftime('%H', timestamp) AS INTEGER)"),
+    };
+    return mergeSummary(hot, this.archive.summarize(filters));
+  }
 
-    const loginRow = this.db
-      .prepare(
-        `SELECT COUNT(*) as count FROM audit_logs ${where} AND action = 'user_logged_in'`
-      )
-      .get(...params) as any;
+  /**
+   * Generate compliance report
+   */
+  generateComplianceReport(period?: { start?: string; end?: string }): ComplianceReport {
+    this.flush();
+    const dateFilters = period ? {
+      startDate: period.start,
+      endDate: period.end
+    } : undefined;
 
-    const failedLoginRow = this.db
-      .prepare(
-        `SELECT COUNT(*) as count FROM security_events ${where.replace('audit_logs', 'security_events')} AND event_type = 'login_failed'`
-      )
-      .get(...params) as any;
+    const where = auditDateWhere(dateFilters);
+    const params = this.buildDateParams(dateFilters);
+    const summary = this.summarize(dateFilters);
+    const countActions = (match: (action: string) => boolean) => Object.entries(summary.byAction)
+      .reduce((sum, [action, count]) => sum + (match(action) ? count : 0), 0);
 
-    const permRow = this.db
-      .prepare(
-        `SELECT COUNT(*) as count FROM audit_logs ${where} AND (action LIKE '%permission%' OR action LIKE '%role%')`
-      )
-      .get(...params) as any;
+    const totalEntries = summary.total;
+    const securityEvents = summary.byCategory[AuditCategory.Security] ?? 0;
+    const criticalEvents = summary.bySeverity[AuditSeverity.Critical] ?? 0;
+    const dataExports = countActions(action => action === 'data_exported');
 
-    const exportRow = this.db
-      .prepare(
-        `SELECT COUNT(*) as count FROM audit_logs ${where} AND action = 'data_exported'`
+    const failedLoginRow = prepareCached(this.readDb,
+        `SELECT COUNT(*) as count FROM security_events ${where.replace('audit_logs', 'security_events')} AND event_type = 'login_failed'`
       )
       .get(...params) as any;
 
-    const criticalRow = this.db
-      .prepare(`SELECT COUNT(*) as count FROM audit_logs ${where} AND severity = 'critical'`)
-      .get(...params) as any;
-
     // Calculate compliance score (0-100)
     let score = 100;
     const recommendations: string[] = [];
@@ -437,15 +742,15 @@ export class AuditLogger {
       score -= 10;
       recommendations.push('High number of failed login attempts detected');
     }
-    if (criticalRow.count > totalRow.count * 0.05) {
+    if (criticalEvents > totalEntries * 0.05) {
       score -= 15;
       recommendations.push('High percentage of critical events');
     }
-    if (exportRow.count > 50) {
+    if (dataExports > 50) {
       score -= 5;
       recommendations.push('Consider reviewing data export patterns');
     }
-    if (securityRow.count < totalRow.count * 0.01) {
+    if (securityEvents < totalEntries * 0.01) {
       recommendations.push('Good security event coverage');
     }
 
@@ -455,44 +760,46 @@ export class AuditLogger {
         start: period?.start || 'all time',
         end: period?.end || 'now',
       },
-      totalAuditEntries: totalRow.count,
-      securityEvents: securityRow.count,
-      dataAccessEvents: dataAccessRow.count,
-      dataModificationEvents: dataModRow.count,
-      userLoginEvents: loginRow.count,
+      totalAuditEntries: totalEntries,
+      securityEvents,
+      dataAccessEvents: countActions(action => action.includes('downloaded')),
+      dataModificationEvents: countActions(action =>
+        action.includes('updated') || action.includes('deleted') || action.includes('created')),
+      userLoginEvents: countActions(action => action === 'user_logged_in'),
       failedLoginAttempts: failedLoginRow.count || 0,
-      permissionChanges: permRow.count,
-      dataExports: exportRow.count,
-      criticalEvents: criticalRow.count,
+      permissionChanges: countActions(action => action.includes('permission') || action.includes('role')),
+      dataExports,
+      criticalEvents,
       complianceScore: Math.max(0, score),
       recommendations,
     };
   }
 
   /**
-   * Delete old audit logs (for retention policy)
+   * Delete old audit logs (for retention policy). Archive segments are
+   * dropped whole once their newest entry is past the cutoff.
    */
   deleteOldLogs(retentionDays: number): number {
+    this.flush();
     const cutoffDate = new Date();
     cutoffDate.setDate(cutoffDate.getDate() - retentionDays);
+    const cutoff = cutoffDate.toISOString();
 
-    const result = this.db
-      .prepare('DELETE FROM audit_logs WHERE timestamp < ?')
-      .run(cutoffDate.toISOString());
-
-    return result.changes;
+    const result = prepareCached(this.db, 'DELETE FROM audit_logs WHERE timestamp < ?').run(cutoff);
+    return result.changes + this.archive.deleteBefore(cutoff);
   }
 
   /**
-   * Export audit logs to JSON
+   * Export audit logs to JSON. Builds the whole export in memory; use
+   * exportStream() for anything beyond a limited page.
    */
   exportToJson(filters?: AuditFilters): string {
     const logs = this.query(filters);
-    return JSON.stringify(logs, null, 2);
+    return JSON.stringify(logs);
   }
 
   /**
-   * Export audit logs to CSV
+   * Export audit logs to CSV (in memory, like exportToJson())
    */
   exportToCsv(filters?: AuditFilters): string {
     const logs = this.query(filters);
@@ -556,13 +863,6 @@ export class AuditLogger {
     };
   }
 
-  private buildDateWhere(filters?: { startDate?: string; endDate?: string }): string {
-    let where = 'WHERE 1=1';
-    if (filters?.startDate) where += ' AND timestamp >= ?';
-    if (filters?.endDate) where += ' AND timestamp <= ?';
-    return where;
-  }
-
   private buildDateParams(filters?: { startDate?: string; endDate?: string }): any[] {
     const params: any[] = [];
     if (filters?.startDate) params.push(filters.startDate);
@@ -3,8 +3,6 @@ import {
   AutomationRule,
   TriggerType,
   ActionType,
-  TriggerConfig,
-  ActionConfig,
   StatusChangeTrigger,
   FieldUpdateTrigger,
   PriorityChangeTrigger,
@@ -17,28 +15,89 @@ import {
   AddCommentAction,
   UpdateStatusAction,
   UpdatePriorityAction,
-  SetDueDateAction
+  SetDueDateAction,
+  CreateAutomationLogData,
+  AutomationEngineSettings,
+  DEFAULT_AUTOMATION_ENGINE_SETTINGS
 } from '../models/AutomationRule';
 import { AutomationRuleRepository } from '../repositories/AutomationRuleRepository';
 import { TaskRepository } from '../repositories/TaskRepository';
-import { NotificationRepository } from '../repositories/NotificationRepository';
 import { CommentRepository } from '../repositories/CommentRepository';
 import { LabelRepository } from '../repositories/LabelRepository';
-import { Task, TaskStatus, TaskPriority } from '../models/Task';
+import { Task, TaskStatus, TaskPriority, TaskChange, UpdateTaskData } from '../models/Task';
 import { NotificationType } from '../models/Notification';
+import { NotificationPipeline } from './NotificationPipeline';
+import { prepareCached } from '../database/StatementCache';
+
+type TriggerPredicate = (data: Record<string, any>) => boolean;
+
+/**
+ * Rule with its trigger config compiled into a predicate
+ */
+interface CompiledRule {
+  rule: AutomationRule;
+  order: number; // position in created_at DESC order, so dispatch order is stable
+  matches: TriggerPredicate;
+}
+
+// triggerType -> project (null = global) -> index key -> rules
+type RuleIndex = Map<TriggerType, Map<number | null, Map<string, CompiledRule[]>>>;
+
+/**
+ * One automation trigger occurrence
+ */
+export interface AutomationEvent {
+  triggerType: TriggerType;
+  triggerData: Record<string, any>;
+  projectId?: number;
+}
+
+// Index key for rules that match any value of the indexed field
+const ANY_KEY = '*';
+
+// Task fields reported as FieldUpdate triggers (names match UpdateTaskData)
+const FIELD_UPDATE_FIELDS: Array<keyof UpdateTaskData & keyof Task> = [
+  'title', 'description', 'status', 'priority', 'assignedTo', 'startDate', 'dueDate', 'position', 'tags',
+];
+
+const NEVER: TriggerPredicate = () => false;
+const ALWAYS: TriggerPredicate = () => true;
 
 /**
  * Automation engine for executing automation rules
+ *
+ * Active rules are loaded once and compiled into predicates indexed by
+ * trigger type, project and the trigger's primary value (target status,
+ * target priority, field name, label id), so an event only evaluates rules
+ * that can match it. The cache is rebuilt after any rule create, update or
+ * delete. Log rows and execution counters for one event are written in a
+ * single transaction.
  */
 export class AutomationEngine {
+  private settings: AutomationEngineSettings;
+  private index: RuleIndex | null = null;
+  private activeRules: CompiledRule[] = [];
+
   constructor(
     private db: Database.Database,
     private automationRepo: AutomationRuleRepository,
     private taskRepo: TaskRepository,
-    private notificationRepo: NotificationRepository,
+    private notifications: NotificationPipeline,
     private commentRepo: CommentRepository,
-    private labelRepo: LabelRepository
-  ) {}
+    private labelRepo: LabelRepository,
+    settings?: Partial<AutomationEngineSettings>
+  ) {
+    this.settings = { ...DEFAULT_AUTOMATION_ENGINE_SETTINGS, ...settings };
+    this.automationRepo.onRulesChanged(() => this.invalidateRuleCache());
+  }
+
+  /**
+   * Drop compiled rules; they are rebuilt on the next event
+   */
+  invalidateRuleCache(): void {
+    this.index = null;
+    this.activeRules = [];
+  }
 
   /**
    * Execute automation rules for a specific trigger
@@ -48,110 +107,225 @@ export class AutomationEngine {
     triggerData: Record<string, any>,
     projectId?: number
   ): Promise<void> {
-    const rules = this.automationRepo.findActiveByTriggerType(triggerType, projectId);
-    
-    for (const rule of rules) {
-      try {
-        // Check if trigger conditions match
-        if (this.evaluateTrigger(rule, triggerData)) {
-          // Execute the action
-          await this.executeAction(rule, triggerData);
-          
-          // Record successful execution
-          this.automationRepo.recordExecution(rule.id);
-          this.automationRepo.createLog({
-            ruleId: rule.id,
-            triggerData,
-            actionData: rule.actionConfig,
-            status: 'success'
-          });
-        } else {
-          // Record skipped execution
-          this.automationRepo.createLog({
+    await this.executeRulesForEvents([{ triggerType, triggerData, projectId }]);
+  }
+
+  /**
+   * Execute automation rules for a batch of events (e.g. one bulk task
+   * mutation). Logs and execution counters for the whole batch are written
+   * in a single transaction.
+   */
+  async executeRulesForEvents(events: AutomationEvent[]): Promise<void> {
+    const logs: CreateAutomationLogData[] = [];
+    const executed: number[] = [];
+
+    for (const { triggerType, triggerData, projectId } of events) {
+      const candidates = this.findCandidateRules(triggerType, triggerData, projectId);
+      const evaluated = new Set<number>();
+
+      for (const { rule, matches } of candidates) {
+        evaluated.add(rule.id);
+        try {
+          // Check if trigger conditions match
+          if (matches(triggerData)) {
+            // Execute the action
+            await this.executeAction(rule, triggerData);
+            
+            // Record successful execution
+            executed.push(rule.id);
+            logs.push({
+              ruleId: rule.id,
+              triggerData,
+              actionData: rule.actionConfig,
+              status: 'success'
+            });
+          } else if (this.settings.logSkipped) {
+            logs.push({
+              ruleId: rule.id,
+              triggerData,
+              actionData: rule.actionConfig,
+              status: 'skipped'
+            });
+          }
+        } catch (error) {
+          // Record error
+          logs.push({
             ruleId: rule.id,
             triggerData,
             actionData: rule.actionConfig,
-            status: 'skipped'
+            status: 'error',
+            errorMessage: error instanceof Error ? error.message : 'Unknown error'
           });
+          console.error(`Error executing automation rule ${rule.id}:`, error);
         }
-      } catch (error) {
-        // Record error
-        this.automationRepo.createLog({
-          ruleId: rule.id,
-          triggerData,
-          actionData: rule.actionConfig,
-          status: 'error',
-          errorMessage: error instanceof Error ? error.message : 'Unknown error'
-        });
-        console.error(`Error executing automation rule ${rule.id}:`, error);
       }
+
+      // Rules filtered out by the index were never evaluated; log them too if asked
+      if (this.settings.logSkipped) {
+        for (const { rule } of this.activeRules) {
+          if (
+            rule.triggerType === triggerType &&
+            !evaluated.has(rule.id) &&
+            (projectId === undefined || rule.projectId === null || rule.projectId === projectId)
+          ) {
+            logs.push({
+              ruleId: rule.id,
+              triggerData,
+              actionData: rule.actionConfig,
+              status: 'skipped'
+            });
+          }
+        }
+      }
+    }
+
+    if (logs.length > 0) {
+      this.db.transaction(() => {
+        this.automationRepo.recordExecutions(executed);
+        this.automationRepo.createLogs(logs);
+      })();
+    }
+  }
+
+  /**
+   * Rules in scope for an event whose index key matches, in dispatch order.
+   * Without a projectId every project's rules are in scope, as before.
+   */
+  private findCandidateRules(
+    triggerType: TriggerType,
+    triggerData: Record<string, any>,
+    projectId?: number
+  ): CompiledRule[] {
+    const byProject = this.getRuleIndex().get(triggerType);
+    if (!byProject) return [];
+
+    const key = this.eventIndexKey(triggerType, triggerData);
+    const scopes = projectId !== undefined
+      ? [byProject.get(projectId), byProject.get(null)]
+      : Array.from(byProject.values());
+
+    const result: CompiledRule[] = [];
+    for (const buckets of scopes) {
+      if (!buckets) continue;
+      if (key !== ANY_KEY) {
+        result.push(...(buckets.get(key) ?? []));
+      }
+      result.push(...(buckets.get(ANY_KEY) ?? []));
     }
+
+    return result.sort((a, b) => a.order - b.order);
+  }
+
+  private getRuleIndex(): RuleIndex {
+    if (this.index) return this.index;
+
+    const index: RuleIndex = new Map();
+    const activeRules: CompiledRule[] = [];
+    const rules = this.automationRepo.findAll().filter(rule => rule.isActive);
+
+    rules.forEach((rule, order) => {
+      const { key, matches } = this.compileTrigger(rule);
+      const compiled: CompiledRule = { rule, order, matches };
+      activeRules.push(compiled);
+
+      let byProject = index.get(rule.triggerType);
+      if (!byProject) {
+        byProject = new Map();
+        index.set(rule.triggerType, byProject);
+      }
+      let buckets = byProject.get(rule.projectId);
+      if (!buckets) {
+        buckets = new Map();
+        byProject.set(rule.projectId, buckets);
+      }
+      let bucket = buckets.get(key);
+      if (!bucket) {
+        bucket = [];
+        buckets.set(key, bucket);
+      }
+      bucket.push(compiled);
+    });
+
+    this.index = index;
+    this.activeRules = activeRules;
+    return index;
   }
 
   /**
-   * Evaluate if trigger conditions match
+   * Compile a rule's trigger config into its index key and a predicate
+   * over the trigger data
    */
-  private evaluateTrigger(rule: AutomationRule, triggerData: Record<string, any>): boolean {
+  private compileTrigger(rule: AutomationRule): { key: string; matches: TriggerPredicate } {
     switch (rule.triggerType) {
-      case TriggerType.StatusChange:
-        return this.evaluateStatusChangeTrigger(rule.triggerConfig as StatusChangeTrigger, triggerData);
+      case TriggerType.StatusChange: {
+        const { fromStatus, toStatus } = rule.triggerConfig as StatusChangeTrigger;
+        return {
+          key: String(toStatus),
+          matches: fromStatus
+            ? data => data.oldStatus === fromStatus && data.newStatus === toStatus
+            : data => data.newStatus === toStatus,
+        };
+      }
       
-      case TriggerType.FieldUpdate:
-        return this.evaluateFieldUpdateTrigger(rule.triggerConfig as FieldUpdateTrigger, triggerData);
+      case TriggerType.FieldUpdate: {
+        const { fieldName, oldValue, newValue } = rule.triggerConfig as FieldUpdateTrigger;
+        return {
+          key: String(fieldName),
+          matches: data =>
+            data.fieldName === fieldName &&
+            (oldValue === undefined || data.oldValue === oldValue) &&
+            (newValue === undefined || data.newValue === newValue),
+        };
+      }
       
-      case TriggerType.PriorityChange:
-        return this.evaluatePriorityChangeTrigger(rule.triggerConfig as PriorityChangeTrigger, triggerData);
+      case TriggerType.PriorityChange: {
+        const { fromPriority, toPriority } = rule.triggerConfig as PriorityChangeTrigger;
+        return {
+          key: String(toPriority),
+          matches: fromPriority
+            ? data => data.oldPriority === fromPriority && data.newPriority === toPriority
+            : data => data.newPriority === toPriority,
+        };
+      }
       
-      case TriggerType.LabelAdded:
-        return this.evaluateLabelAddedTrigger(rule.triggerConfig as LabelAddedTrigger, triggerData);
+      case TriggerType.LabelAdded: {
+        const { labelId, labelName } = rule.triggerConfig as LabelAddedTrigger;
+        return {
+          key: labelId ? String(labelId) : ANY_KEY,
+          matches: data =>
+            (!labelId || data.labelId === labelId) &&
+            (!labelName || data.labelName === labelName),
+        };
+      }
       
       case TriggerType.TaskCreated:
       case TriggerType.TaskAssigned:
       case TriggerType.CommentAdded:
       case TriggerType.AttachmentAdded:
         // These triggers don't need additional condition checking
-        return true;
+        return { key: ANY_KEY, matches: ALWAYS };
       
       default:
-        return false;
-    }
-  }
-
-  private evaluateStatusChangeTrigger(config: StatusChangeTrigger, data: Record<string, any>): boolean {
-    if (config.fromStatus && data.oldStatus !== config.fromStatus) {
-      return false;
-    }
-    return data.newStatus === config.toStatus;
-  }
-
-  private evaluateFieldUpdateTrigger(config: FieldUpdateTrigger, data: Record<string, any>): boolean {
-    if (data.fieldName !== config.fieldName) {
-      return false;
-    }
-    if (config.oldValue !== undefined && data.oldValue !== config.oldValue) {
-      return false;
-    }
-    if (config.newValue !== undefined && data.newValue !== config.newValue) {
-      return false;
-    }
-    return true;
-  }
-
-  private evaluatePriorityChangeTrigger(config: PriorityChangeTrigger, data: Record<string, any>): boolean {
-    if (config.fromPriority && data.oldPriority !== config.fromPriority) {
-      return false;
+        return { key: ANY_KEY, matches: NEVER };
     }
-    return data.newPriority === config.toPriority;
   }
 
-  private evaluateLabelAddedTrigger(config: LabelAddedTrigger, data: Record<string, any>): boolean {
-    if (config.labelId && data.labelId !== config.labelId) {
-      return false;
-    }
-    if (config.labelName && data.labelName !== config.labelName) {
-      return false;
+  /**
+   * Index key an event is looked up by; must mirror compileTrigger
+   */
+  private eventIndexKey(triggerType: TriggerType, data: Record<string, any>): string {
+    switch (triggerType) {
+      case TriggerType.StatusChange:
+        return String(data.newStatus);
+      case TriggerType.FieldUpdate:
+        return String(data.fieldName);
+      case TriggerType.PriorityChange:
+        return String(data.newPriority);
+      case TriggerType.LabelAdded:
+        return data.labelId ? String(data.labelId) : ANY_KEY;
+      default:
+        return ANY_KEY;
     }
-    return true;
   }
 
   /**
@@ -217,21 +391,22 @@ export class AutomationEngine {
         userIds = [data.assignedTo];
       } else if (config.userRole === 'creator' && data.createdBy) {
         userIds = [data.createdBy];
+      } else if (config.userRole === 'project_members' && data.projectId) {
+        userIds = (prepareCached(this.db, `
+          SELECT DISTINCT user_id FROM project_members WHERE project_id = ?
+        `).all(data.projectId) as Array<{ user_id: number }>).map(row => row.user_id);
       }
-      // Add project_members logic here if needed
     }
     
-    // Create notification for each user
-    for (const userId of userIds) {
-      this.notificationRepo.create({
-        userId,
-        type: NotificationType.System,
-        title: config.title,
-        message: config.message,
-        relatedProjectId: data.projectId,
-        relatedTaskId: data.taskId
-      });
-    }
+    // Queued for the next batch: one multi-row insert however many recipients
+    this.notifications.enqueue(userIds.map(userId => ({
+      userId,
+      type: NotificationType.System,
+      title: config.title,
+      message: config.message,
+      relatedProjectId: data.projectId,
+      relatedTaskId: data.taskId
+    })));
   }
 
   private async executeCreateTaskAction(config: CreateTaskAction, data: Record<string, any>): Promise<void> {
@@ -446,4 +621,89 @@ export class AutomationEngine {
       task.projectId
     );
   }
+
+  /**
+   * Fire status, priority, assignment and field-update triggers for a batch
+   * of task changes in one pass
+   */
+  async onTasksChanged(changes: TaskChange[]): Promise<void> {
+    const events: AutomationEvent[] = [];
+
+    for (const { before, after } of changes) {
+      const base = { taskId: after.id, projectId: after.projectId, assignedTo: after.assignedTo };
+
+      if (before.status !== after.status) {
+        events.push({
+          triggerType: TriggerType.StatusChange,
+          triggerData: { ...base, oldStatus: before.status, newStatus: after.status, createdBy: 1 },
+          projectId: after.projectId,
+        });
+      }
+      if (before.priority !== after.priority) {
+        events.push({
+          triggerType: TriggerType.PriorityChange,
+          triggerData: { ...base, oldPriority: before.priority, newPriority: after.priority },
+          projectId: after.projectId,
+        });
+      }
+      if (after.assignedTo && before.assignedTo !== after.assignedTo) {
+        events.push({ triggerType: TriggerType.TaskAssigned, triggerData: base, projectId: after.projectId });
+      }
+      for (const fieldName of FIELD_UPDATE_FIELDS) {
+        if (before[fieldName] !== after[fieldName]) {
+          events.push({
+            triggerType: TriggerType.FieldUpdate,
+            triggerData: { ...base, fieldName, oldValue: before[fieldName], newValue: after[fieldName] },
+            projectId: after.projectId,
+          });
+        }
+      }
+    }
+
+    if (events.length > 0) {
+      await this.executeRulesForEvents(events);
+    }
+  }
+
+  /**
+   * Fire task-created triggers for a batch of new tasks (e.g. a project
+   * instantiated from a template), plus label-added triggers for labels they
+   * were created with, in a single rule pass
+   */
+  async onTasksCreated(tasks: Task[], labelPairs: Array<{ task: Task; labelId: number }> = []): Promise<void> {
+    const events: AutomationEvent[] = tasks.map(task => ({
+      triggerType: TriggerType.TaskCreated,
+      triggerData: { taskId: task.id, projectId: task.projectId, assignedTo: task.assignedTo },
+      projectId: task.projectId,
+    }));
+    events.push(...this.labelAddedEvents(labelPairs));
+
+    if (events.length > 0) {
+      await this.executeRulesForEvents(events);
+    }
+  }
+
+  /**
+   * Fire label-added triggers for a batch of (task, label) pairs
+   */
+  async onLabelsAdded(pairs: Array<{ task: Task; labelId: number }>): Promise<void> {
+    const events = this.labelAddedEvents(pairs);
+    if (events.length > 0) {
+      await this.executeRulesForEvents(events);
+    }
+  }
+
+  private labelAddedEvents(pairs: Array<{ task: Task; labelId: number }>): AutomationEvent[] {
+    const labelNames = new Map<number, string | undefined>();
+    return pairs.map(({ task, labelId }) => {
+      if (!labelNames.has(labelId)) {
+        labelNames.set(labelId, this.labelRepo.findById(labelId)?.name);
+      }
+      return {
+        triggerType: TriggerType.LabelAdded,
+        triggerData: { taskId: task.id, projectId: task.projectId, labelId, labelName: labelNames.get(labelId) },
+        projectId: task.projectId,
+      };
+    });
+  }
 }
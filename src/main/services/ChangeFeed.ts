@@ -0,0 +1,207 @@
+import Database from 'better-sqlite3';
+import { prepareCached } from '../database/StatementCache';
+import { ProjectRepository } from '../repositories/ProjectRepository';
+import { TaskRepository } from '../repositories/TaskRepository';
+import { LabelRepository } from '../repositories/LabelRepository';
+import { CommentRepository } from '../repositories/CommentRepository';
+import { ProjectMemberRepository } from '../repositories/ProjectMemberRepository';
+import {
+  ChangeBatch,
+  ChangeEntityType,
+  ChangeFeedSettings,
+  ChangesSinceResult,
+  DEFAULT_CHANGE_FEED_SETTINGS,
+  EntityChange,
+} from '../models/ChangeFeed';
+
+interface ChangeLogRow {
+  version: number;
+  entity: ChangeEntityType;
+  entity_id: number;
+  project_id: number | null;
+  op: 'upsert' | 'delete';
+}
+
+export interface ChangeFeedRepositories {
+  projectRepo: ProjectRepository;
+  taskRepo: TaskRepository;
+  labelRepo: LabelRepository;
+  commentRepo: CommentRepository;
+  projectMemberRepo: ProjectMemberRepository;
+}
+
+export type ChangeBatchListener = (batch: ChangeBatch) => void;
+
+// Log rows read per poll; a larger backlog is picked up on the next tick
+const MAX_CHANGES_PER_BATCH = 5000;
+
+/**
+ * ChangeFeed - Publishes entity mutations recorded in change_log (see
+ * Database.createChangeLog) as versioned batches.
+ *
+ * While anyone is subscribed the log is polled on a short timer; each poll
+ * collapses repeated changes to one entry per entity with its current row,
+ * so a bulk move of 500 tasks is one batch of 500 task upserts. Renderers
+ * apply batches to their local store and call since() to catch up after a
+ * gap.
+ */
+export class ChangeFeed {
+  private settings: ChangeFeedSettings;
+  private listeners = new Set<ChangeBatchListener>();
+  private timer: NodeJS.Timeout | null = null;
+  private version: number;
+  private polls = 0;
+
+  constructor(
+    private db: Database.Database,
+    private repos: ChangeFeedRepositories,
+    settings?: Partial<ChangeFeedSettings>
+  ) {
+    this.settings = { ...DEFAULT_CHANGE_FEED_SETTINGS, ...settings };
+    this.version = this.getLatestVersion();
+  }
+
+  /**
+   * Latest version recorded in the log
+   */
+  getLatestVersion(): number {
+    const row = prepareCached(this.db, 'SELECT MAX(version) AS version FROM change_log').get() as { version: number | null };
+    return row.version ?? 0;
+  }
+
+  /**
+   * Subscribe to batches. Returns an unsubscribe function.
+   */
+  subscribe(listener: ChangeBatchListener): () => void {
+    this.listeners.add(listener);
+    if (!this.timer) {
+      this.version = this.getLatestVersion();
+      this.timer = setInterval(() => this.poll(), this.settings.pollMs);
+    }
+    return () => {
+      this.listeners.delete(listener);
+      if (this.listeners.size === 0 && this.timer) {
+        clearInterval(this.timer);
+        this.timer = null;
+      }
+    };
+  }
+
+  /**
+   * Changes after `version`, for a client that missed batches
+   */
+  since(version: number, projectId?: number): ChangesSinceResult {
+    const oldest = prepareCached(this.db, 'SELECT MIN(version) AS version FROM change_log').get() as { version: number | null };
+    const latest = this.getLatestVersion();
+    // Versions up to `version` must still be in the log (or the log is empty after it)
+    if (oldest.version !== null && version < oldest.version - 1) {
+      return { fromVersion: version, toVersion: latest, changes: [], reset: true };
+    }
+
+    const rows = prepareCached(this.db, `
+      SELECT * FROM change_log WHERE version > ? ORDER BY version LIMIT ?
+    `).all(version, MAX_CHANGES_PER_BATCH + 1) as ChangeLogRow[];
+    if (rows.length > MAX_CHANGES_PER_BATCH) {
+      return { fromVersion: version, toVersion: latest, changes: [], reset: true };
+    }
+
+    const toVersion = rows.length > 0 ? rows[rows.length - 1].version : version;
+    const changes = this.resolve(rows).filter(change => projectId === undefined || change.projectId === projectId);
+    return { fromVersion: version, toVersion, changes, reset: false };
+  }
+
+  /**
+   * Stop polling and drop subscribers
+   */
+  close(): void {
+    if (this.timer) {
+      clearInterval(this.timer);
+      this.timer = null;
+    }
+    this.listeners.clear();
+  }
+
+  private poll(): void {
+    try {
+      const rows = prepareCached(this.db, `
+        SELECT * FROM change_log WHERE version > ? ORDER BY version LIMIT ?
+      `).all(this.version, MAX_CHANGES_PER_BATCH) as ChangeLogRow[];
+      if (rows.length === 0) return;
+
+      const batch: ChangeBatch = {
+        fromVersion: this.version,
+        toVersion: rows[rows.length - 1].version,
+        changes: this.resolve(rows),
+      };
+      this.version = batch.toVersion;
+
+      for (const listener of this.listeners) {
+        try {
+          listener(batch);
+        } catch (error) {
+          console.error('[ChangeFeed] Batch listener failed:', error);
+        }
+      }
+
+      // Trim the log occasionally rather than on every write
+      if (++this.polls % 100 === 0) {
+        this.prune();
+      }
+    } catch (error) {
+      console.error('[ChangeFeed] Poll failed:', error);
+    }
+  }
+
+  private prune(): void {
+    prepareCached(this.db, 'DELETE FROM change_log WHERE version <= ?')
+      .run(this.version - this.settings.retainVersions);
+  }
+
+  /**
+   * Collapse log rows to the latest op per entity and attach current rows.
+   * An upsert whose row is gone by now is reported as a delete.
+   */
+  private resolve(rows: ChangeLogRow[]): EntityChange[] {
+    const latest = new Map<string, ChangeLogRow>();
+    for (const row of rows) {
+      const key = `${row.entity}:${row.entity_id}`;
+      latest.delete(key);
+      latest.set(key, row);
+    }
+
+    const upsertIds = (entity: ChangeEntityType) => Array.from(latest.values())
+      .filter(row => row.entity === entity && row.op === 'upsert')
+      .map(row => row.entity_id);
+    const tasks = this.repos.taskRepo.findManyById(upsertIds('task'));
+    const labelSets = new Map(upsertIds('taskLabels').map(id => [id, this.repos.taskRepo.getLabelIds(id)]));
+
+    const changes: EntityChange[] = [];
+    for (const row of latest.values()) {
+      const base = { version: row.version, id: row.entity_id, projectId: row.project_id };
+      const data = row.op === 'upsert' ? this.load(row, tasks, labelSets) : undefined;
+      if (data === undefined) {
+        changes.push({ ...base, entity: row.entity, op: 'delete' } as EntityChange);
+      } else {
+        changes.push({ ...base, entity: row.entity, op: 'upsert', data } as EntityChange);
+      }
+    }
+    return changes;
+  }
+
+  private load(row: ChangeLogRow, tasks: Map<number, unknown>, labelSets: Map<number, number[]>): unknown {
+    switch (row.entity) {
+      case 'project':
+        return this.repos.projectRepo.findById(row.entity_id);
+      case 'task':
+        return tasks.get(row.entity_id);
+      case 'label':
+        return this.repos.labelRepo.findById(row.entity_id);
+      case 'comment':
+        return this.repos.commentRepo.findById(row.entity_id);
+      case 'projectMember':
+        return this.repos.projectMemberRepo.findByIdWithDetails(row.entity_id);
+      case 'taskLabels':
+        return labelSets.get(row.entity_id);
+    }
+  }
+}
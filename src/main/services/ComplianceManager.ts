@@ -7,6 +7,7 @@
 
 import Database from 'better-sqlite3';
 import * as crypto from 'crypto';
+import { Writable } from 'stream';
 import {
   DataSubjectRequest,
   CreateDataSubjectRequestData,
@@ -43,10 +44,17 @@ import {
   ComplianceDashboardStats,
   DEFAULT_DSR_RESPONSE_TIME
 } from '../models/Compliance';
+import { ComplianceExportDataset, ExportResult } from '../models/Export';
+import { migrateModuleSchema } from '../database/migrations';
+import { StreamExportOptions, exportRows } from '../utils/streamingExport';
+
+// Bump when initializeTables() changes (see database/migrations.ts)
+const SCHEMA_VERSION = 1;
 
 export class ComplianceManager {
   constructor(private db: Database.Database) {
-    this.initializeTables();
+    // Read-only connections (query workers) rely on the writer's schema
+    migrateModuleSchema(db, 'compliance', SCHEMA_VERSION, () => this.initializeTables());
   }
 
   // ==================== Database Initialization ====================
@@ -1095,6 +1103,38 @@ export class ComplianceManager {
     };
   }
 
+  // ==================== Export ====================
+
+  /**
+   * Stream one compliance table to `destination` in insertion order,
+   * reading row by row through `conn` (see openExportConnection).
+   * Verification tokens are left out of data subject request exports.
+   */
+  exportStream(
+    conn: Database.Database,
+    dataset: ComplianceExportDataset,
+    destination: Writable,
+    options: StreamExportOptions
+  ): Promise<ExportResult> {
+    const sources: Record<ComplianceExportDataset, { table: string; toRecord: (row: any) => object }> = {
+      dataSubjectRequests: {
+        table: 'data_subject_requests',
+        toRecord: row => {
+          const { verificationToken: _token, ...request } = this.mapRowToDataSubjectRequest(row);
+          return request;
+        }
+      },
+      userConsents: { table: 'user_consents', toRecord: row => this.mapRowToUserConsent(row) },
+      retentionLogs: { table: 'retention_execution_logs', toRecord: row => this.mapRowToRetentionExecutionLog(row) },
+      legalHolds: { table: 'legal_holds', toRecord: row => this.mapRowToLegalHold(row) }
+    };
+    const source = sources[dataset];
+    if (!source) throw new Error(`Unknown compliance dataset: ${dataset}`);
+
+    const rows = conn.prepare(`SELECT * FROM ${source.table} ORDER BY id`).iterate();
+    return exportRows(rows, { toRecord: source.toRecord }, destination, options);
+  }
+
   // ==================== Helper Methods ====================
 
   private mapRowToDataSubjectRequest(row: any): DataSubjectRequest {
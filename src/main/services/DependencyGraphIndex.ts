@@ -0,0 +1,407 @@
+import Database from 'better-sqlite3';
+import { TaskDependency, DependencyType, CriticalPath } from '../models/TaskDependency';
+import { Task } from '../models/Task';
+import { prepareCached } from '../database/StatementCache';
+
+/**
+ * Edge in the dependency graph: `taskId` depends on `dependsOnTaskId`
+ */
+interface GraphEdge {
+  id: number;
+  taskId: number;
+  dependsOnTaskId: number;
+  dependencyType: DependencyType;
+}
+
+/**
+ * Per-task metadata needed for ordering and critical path queries
+ */
+interface GraphNode {
+  projectId: number;
+  durationDays: number;
+}
+
+interface DependencyEdgeRow {
+  id: number;
+  task_id: number;
+  depends_on_task_id: number;
+  dependency_type: string;
+}
+
+interface TaskNodeRow {
+  id: number;
+  start_date: string | null;
+  due_date: string | null;
+}
+
+const DAY_MS = 24 * 60 * 60 * 1000;
+
+/**
+ * Blocks and BlockedBy both mean "taskId waits for dependsOnTaskId";
+ * RelatesTo is informational and never orders tasks.
+ */
+function isBlockingType(type: DependencyType): boolean {
+  return type === DependencyType.Blocks || type === DependencyType.BlockedBy;
+}
+
+/**
+ * Inclusive duration of a task in days, defaulting to one day when the
+ * task has no complete date range
+ */
+function taskDurationDays(startDate: string | null, dueDate: string | null): number {
+  if (!startDate || !dueDate) return 1;
+  const start = Date.parse(startDate);
+  const due = Date.parse(dueDate);
+  if (isNaN(start) || isNaN(due)) return 1;
+  return Math.max(1, Math.round((due - start) / DAY_MS) + 1);
+}
+
+/**
+ * Resident adjacency-list index over task_dependencies.
+ *
+ * Projects are loaded on first use with two queries (tasks and every edge
+ * touching them), after which cycle checks, blocker lookups, topological
+ * order and critical path are answered from memory. The repository keeps
+ * the index in sync on insert/delete; task mutations are reported through
+ * upsertTask/removeTask.
+ */
+export class DependencyGraphIndex {
+  private outgoing = new Map<number, Map<number, GraphEdge>>();
+  private incoming = new Map<number, Map<number, GraphEdge>>();
+  private edgesById = new Map<number, GraphEdge>();
+  private nodes = new Map<number, GraphNode>();
+  private projectTasks = new Map<number, Set<number>>();
+
+  constructor(private db: Database.Database) {}
+
+  /**
+   * Record a newly inserted dependency
+   */
+  addEdge(dep: TaskDependency): void {
+    if (this.edgesById.has(dep.id)) return;
+    const edge: GraphEdge = {
+      id: dep.id,
+      taskId: dep.taskId,
+      dependsOnTaskId: dep.dependsOnTaskId,
+      dependencyType: dep.dependencyType,
+    };
+    this.edgesById.set(edge.id, edge);
+    this.adjacency(this.outgoing, edge.taskId).set(edge.id, edge);
+    this.adjacency(this.incoming, edge.dependsOnTaskId).set(edge.id, edge);
+  }
+
+  /**
+   * Forget a deleted dependency
+   */
+  removeEdge(id: number): void {
+    const edge = this.edgesById.get(id);
+    if (!edge) return;
+    this.edgesById.delete(id);
+    this.outgoing.get(edge.taskId)?.delete(id);
+    this.incoming.get(edge.dependsOnTaskId)?.delete(id);
+  }
+
+  /**
+   * Forget every dependency between a pair of tasks
+   */
+  removeEdgesBetween(taskId: number, dependsOnTaskId: number): void {
+    const edges = this.outgoing.get(taskId);
+    if (!edges) return;
+    for (const edge of Array.from(edges.values())) {
+      if (edge.dependsOnTaskId === dependsOnTaskId) {
+        this.removeEdge(edge.id);
+      }
+    }
+  }
+
+  /**
+   * Refresh a task's project membership and duration after create/update
+   */
+  upsertTask(task: Task): void {
+    const existing = this.nodes.get(task.id);
+    if (existing && existing.projectId !== task.projectId) {
+      this.projectTasks.get(existing.projectId)?.delete(task.id);
+      this.nodes.delete(task.id);
+    }
+
+    // Tasks in projects that were never loaded are picked up lazily
+    const members = this.projectTasks.get(task.projectId);
+    if (!members) return;
+
+    members.add(task.id);
+    this.nodes.set(task.id, {
+      projectId: task.projectId,
+      durationDays: taskDurationDays(task.startDate, task.dueDate),
+    });
+  }
+
+  /**
+   * Drop a deleted task together with its (cascaded) dependencies
+   */
+  removeTask(taskId: number): void {
+    for (const map of [this.outgoing.get(taskId), this.incoming.get(taskId)]) {
+      if (!map) continue;
+      for (const id of Array.from(map.keys())) {
+        this.removeEdge(id);
+      }
+    }
+    this.outgoing.delete(taskId);
+    this.incoming.delete(taskId);
+
+    const node = this.nodes.get(taskId);
+    if (node) {
+      this.projectTasks.get(node.projectId)?.delete(taskId);
+      this.nodes.delete(taskId);
+    }
+  }
+
+  /**
+   * Drop a deleted project and all of its tasks
+   */
+  removeProject(projectId: number): void {
+    const members = this.projectTasks.get(projectId);
+    if (!members) {
+      // Cross-project edges into an unloaded project can't be enumerated
+      this.invalidate();
+      return;
+    }
+    for (const taskId of Array.from(members)) {
+      this.removeTask(taskId);
+    }
+    this.projectTasks.delete(projectId);
+  }
+
+  /**
+   * Discard everything; projects reload on next access
+   */
+  invalidate(): void {
+    this.outgoing.clear();
+    this.incoming.clear();
+    this.edgesById.clear();
+    this.nodes.clear();
+    this.projectTasks.clear();
+  }
+
+  /**
+   * Check whether adding "taskId depends on dependsOnTaskId" closes a cycle.
+   * Every dependency type is followed, matching the repository's validation.
+   */
+  wouldCreateCycle(taskId: number, dependsOnTaskId: number): boolean {
+    const visited = new Set<number>();
+    const stack = [dependsOnTaskId];
+
+    while (stack.length > 0) {
+      const current = stack.pop()!;
+      if (current === taskId) return true;
+      if (visited.has(current)) continue;
+      visited.add(current);
+
+      this.ensureTaskLoaded(current);
+      const edges = this.outgoing.get(current);
+      if (!edges) continue;
+      for (const edge of edges.values()) {
+        stack.push(edge.dependsOnTaskId);
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Direct blockers of a task (tasks that must be completed first)
+   */
+  getBlockingTasks(taskId: number): number[] {
+    this.ensureTaskLoaded(taskId);
+    return this.blockingNeighbours(this.outgoing.get(taskId), edge => edge.dependsOnTaskId);
+  }
+
+  /**
+   * Tasks directly waiting for this task to complete
+   */
+  getBlockedTasks(taskId: number): number[] {
+    this.ensureTaskLoaded(taskId);
+    return this.blockingNeighbours(this.incoming.get(taskId), edge => edge.taskId);
+  }
+
+  /**
+   * Every task that must finish before this one can start, nearest first
+   */
+  getTransitiveBlockers(taskId: number): number[] {
+    const result: number[] = [];
+    const visited = new Set<number>([taskId]);
+    const queue = [taskId];
+
+    for (let i = 0; i < queue.length; i++) {
+      for (const blocker of this.getBlockingTasks(queue[i])) {
+        if (visited.has(blocker)) continue;
+        visited.add(blocker);
+        result.push(blocker);
+        queue.push(blocker);
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Project tasks ordered so that every blocker precedes the tasks it blocks.
+   * Edges leaving the project are ignored; any tasks left on a cycle (legacy
+   * data predating validation) are appended in id order.
+   */
+  getTopologicalOrder(projectId: number): number[] {
+    const members = this.ensureProjectLoaded(projectId);
+    const taskIds = Array.from(members).sort((a, b) => a - b);
+    const inDegree = new Map<number, number>();
+
+    for (const taskId of taskIds) {
+      inDegree.set(taskId, this.projectBlockers(taskId, members).length);
+    }
+
+    const order: number[] = [];
+    const queue = taskIds.filter(taskId => inDegree.get(taskId) === 0);
+
+    for (let i = 0; i < queue.length; i++) {
+      const taskId = queue[i];
+      order.push(taskId);
+      for (const blocked of this.projectBlocked(taskId, members)) {
+        const remaining = inDegree.get(blocked)! - 1;
+        inDegree.set(blocked, remaining);
+        if (remaining === 0) queue.push(blocked);
+      }
+    }
+
+    if (order.length < taskIds.length) {
+      const placed = new Set(order);
+      order.push(...taskIds.filter(taskId => !placed.has(taskId)));
+    }
+
+    return order;
+  }
+
+  /**
+   * Longest duration-weighted chain of blocking dependencies in a project
+   */
+  getCriticalPath(projectId: number): CriticalPath {
+    const members = this.ensureProjectLoaded(projectId);
+    const order = this.getTopologicalOrder(projectId);
+    const finish = new Map<number, number>();
+    const previous = new Map<number, number>();
+    let lastTaskId: number | null = null;
+    let longest = 0;
+
+    for (const taskId of order) {
+      let start = 0;
+      for (const blocker of this.projectBlockers(taskId, members)) {
+        const blockerFinish = finish.get(blocker);
+        if (blockerFinish !== undefined && blockerFinish > start) {
+          start = blockerFinish;
+          previous.set(taskId, blocker);
+        }
+      }
+
+      const end = start + (this.nodes.get(taskId)?.durationDays ?? 1);
+      finish.set(taskId, end);
+      if (end > longest) {
+        longest = end;
+        lastTaskId = taskId;
+      }
+    }
+
+    const taskIds: number[] = [];
+    for (let current = lastTaskId; current !== null; current = previous.get(current) ?? null) {
+      taskIds.push(current);
+    }
+
+    return { taskIds: taskIds.reverse(), durationDays: longest };
+  }
+
+  /**
+   * Load a project's tasks and every edge touching them, once
+   */
+  private ensureProjectLoaded(projectId: number): Set<number> {
+    const loaded = this.projectTasks.get(projectId);
+    if (loaded) return loaded;
+
+    const members = new Set<number>();
+    const taskRows = prepareCached(this.db, `
+      SELECT id, start_date, due_date FROM tasks WHERE project_id = ?
+    `).all(projectId) as TaskNodeRow[];
+
+    for (const row of taskRows) {
+      members.add(row.id);
+      this.nodes.set(row.id, {
+        projectId,
+        durationDays: taskDurationDays(row.start_date, row.due_date),
+      });
+    }
+
+    const edgeRows = prepareCached(this.db, `
+      SELECT td.id, td.task_id, td.depends_on_task_id, td.dependency_type
+      FROM task_dependencies td
+      JOIN tasks t ON t.id = td.task_id
+      WHERE t.project_id = ?
+      UNION
+      SELECT td.id, td.task_id, td.depends_on_task_id, td.dependency_type
+      FROM task_dependencies td
+      JOIN tasks t ON t.id = td.depends_on_task_id
+      WHERE t.project_id = ?
+      ORDER BY 1
+    `).all(projectId, projectId) as DependencyEdgeRow[];
+
+    for (const row of edgeRows) {
+      this.addEdge({
+        id: row.id,
+        taskId: row.task_id,
+        dependsOnTaskId: row.depends_on_task_id,
+        dependencyType: row.dependency_type as DependencyType,
+        createdAt: '',
+      });
+    }
+
+    this.projectTasks.set(projectId, members);
+    return members;
+  }
+
+  /**
+   * Make sure the project owning a task is resident
+   */
+  private ensureTaskLoaded(taskId: number): void {
+    if (this.nodes.has(taskId)) return;
+    const row = prepareCached(this.db, `
+      SELECT project_id FROM tasks WHERE id = ?
+    `).get(taskId) as { project_id: number } | undefined;
+    if (row) {
+      this.ensureProjectLoaded(row.project_id);
+    }
+  }
+
+  private adjacency(index: Map<number, Map<number, GraphEdge>>, taskId: number): Map<number, GraphEdge> {
+    let edges = index.get(taskId);
+    if (!edges) {
+      edges = new Map();
+      index.set(taskId, edges);
+    }
+    return edges;
+  }
+
+  private blockingNeighbours(edges: Map<number, GraphEdge> | undefined, pick: (edge: GraphEdge) => number): number[] {
+    if (!edges) return [];
+    const result: number[] = [];
+    for (const edge of edges.values()) {
+      if (isBlockingType(edge.dependencyType)) {
+        result.push(pick(edge));
+      }
+    }
+    return result;
+  }
+
+  private projectBlockers(taskId: number, members: Set<number>): number[] {
+    return this.blockingNeighbours(this.outgoing.get(taskId), edge => edge.dependsOnTaskId)
+      .filter(id => members.has(id));
+  }
+
+  private projectBlocked(taskId: number, members: Set<number>): number[] {
+    return this.blockingNeighbours(this.incoming.get(taskId), edge => edge.taskId)
+      .filter(id => members.has(id));
+  }
+}
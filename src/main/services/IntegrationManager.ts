@@ -24,7 +24,8 @@ import {
   SyncStatus,
   RateLimitConfig,
   CreateRateLimitData,
-  RateLimitState,
+  RateLimitResult,
+  RateLimiterSettings,
   RateLimitStrategy,
   ImportExportJob,
   CreateImportExportJobData,
@@ -33,12 +34,40 @@ import {
   ExternalService,
   IntegrationEvent,
   DEFAULT_WEBHOOK_CONFIG,
-  DEFAULT_RATE_LIMIT_CONFIG
+  DEFAULT_RATE_LIMIT_CONFIG,
+  DEFAULT_RATE_LIMITER_SETTINGS
 } from '../models/Integration';
+import { prepareCached } from '../database/StatementCache';
+import { migrateModuleSchema } from '../database/migrations';
+import { RateLimiter } from './RateLimiter';
+
+// Bump when initializeTables() changes (see database/migrations.ts)
+const SCHEMA_VERSION = 1;
+
+interface CachedRateLimitConfig {
+  config: RateLimitConfig | null;
+  loadedAt: number;
+}
 
 export class IntegrationManager {
-  constructor(private db: Database.Database) {
-    this.initializeTables();
+  private rateLimiter: RateLimiter;
+  private rateLimiterSettings: RateLimiterSettings;
+  // Config lookups by 'id:', 'key:' or 'user:' key, including misses
+  private rateLimitConfigs = new Map<string, CachedRateLimitConfig>();
+  // Active webhooks by subscribed event ('*' for all), built on first use
+  private webhookIndex: Map<string, Webhook[]> | null = null;
+
+  constructor(private db: Database.Database, rateLimiterSettings?: Partial<RateLimiterSettings>) {
+    migrateModuleSchema(db, 'integrations', SCHEMA_VERSION, () => this.initializeTables());
+    this.rateLimiterSettings = { ...DEFAULT_RATE_LIMITER_SETTINGS, ...rateLimiterSettings };
+    this.rateLimiter = new RateLimiter(db, this.rateLimiterSettings.checkpointMs);
+  }
+
+  /**
+   * Checkpoint rate limit state and stop background timers
+   */
+  close(): void {
+    this.rateLimiter.close();
   }
 
   // ==================== Database Initialization ====================
@@ -111,6 +140,23 @@ export class IntegrationManager {
       CREATE INDEX IF NOT EXISTS idx_webhook_deliveries_delivered_at ON webhook_deliveries(delivered_at);
     `);
 
+    // Outbound webhook queue (drained by WebhookDispatcher)
+    this.db.exec(`
+      CREATE TABLE IF NOT EXISTS webhook_queue (
+        id INTEGER PRIMARY KEY AUTOINCREMENT,
+        webhook_id INTEGER NOT NULL,
+        event TEXT NOT NULL,
+        payload TEXT NOT NULL,
+        attempt INTEGER NOT NULL DEFAULT 1,
+        next_attempt_at INTEGER NOT NULL,
+        last_error TEXT,
+        created_at TEXT NOT NULL DEFAULT (datetime('now')),
+        FOREIGN KEY (webhook_id) REFERENCES webhooks(id) ON DELETE CASCADE
+      );
+      CREATE INDEX IF NOT EXISTS idx_webhook_queue_next_attempt ON webhook_queue(next_attempt_at);
+      CREATE INDEX IF NOT EXISTS idx_webhook_queue_webhook ON webhook_queue(webhook_id);
+    `);
+
     // Sync jobs table
     this.db.exec(`
       CREATE TABLE IF NOT EXISTS sync_jobs (
@@ -156,7 +202,7 @@ export class IntegrationManager {
       CREATE INDEX IF NOT EXISTS idx_rate_limit_org ON rate_limit_configs(organization_id);
     `);
 
-    // Rate limit state table (in-memory tracking)
+    // Rate limit state table (checkpoints of the in-memory RateLimiter)
     this.db.exec(`
       CREATE TABLE IF NOT EXISTS rate_limit_state (
         id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -367,6 +413,7 @@ export class IntegrationManager {
       createdBy
     );
 
+    this.webhookIndex = null;
     return this.getWebhook(result.lastInsertRowid as number)!;
   }
 
@@ -388,14 +435,40 @@ export class IntegrationManager {
     return rows.map(row => this.mapRowToWebhook(row));
   }
 
+  /**
+   * Active webhooks subscribed to `event`, from the in-memory subscription
+   * index (rebuilt after any webhook is created, updated or deleted)
+   */
   getWebhooksByEvent(event: WebhookEvent): Webhook[] {
-    const stmt = this.db.prepare(`
-      SELECT * FROM webhooks 
-      WHERE active = 1 
-      AND (events LIKE ? OR events LIKE ?)
-    `);
-    const rows = stmt.all(`%"${event}"%`, `%"*"%`);
-    return rows.map(row => this.mapRowToWebhook(row));
+    const index = this.getWebhookIndex();
+    const direct = index.get(event) ?? [];
+    const wildcard = event === WebhookEvent.All ? [] : index.get(WebhookEvent.All) ?? [];
+    if (wildcard.length === 0) return direct;
+    const ids = new Set(direct.map(webhook => webhook.id));
+    return [...direct, ...wildcard.filter(webhook => !ids.has(webhook.id))];
+  }
+
+  /**
+   * Whether any active webhook receives `event`; cheap enough for hot paths
+   */
+  hasWebhookSubscribers(event: WebhookEvent): boolean {
+    const index = this.getWebhookIndex();
+    return index.has(event) || index.has(WebhookEvent.All);
+  }
+
+  private getWebhookIndex(): Map<string, Webhook[]> {
+    if (!this.webhookIndex) {
+      const index = new Map<string, Webhook[]>();
+      for (const webhook of this.getAllWebhooks(true)) {
+        for (const event of new Set(webhook.events)) {
+          const list = index.get(event) ?? [];
+          list.push(webhook);
+          index.set(event, list);
+        }
+      }
+      this.webhookIndex = index;
+    }
+    return this.webhookIndex;
   }
 
   updateWebhook(id: number, data: UpdateWebhookData): Webhook | null {
@@ -446,6 +519,7 @@ export class IntegrationManager {
 
     const stmt = this.db.prepare(`UPDATE webhooks SET ${updates.join(', ')} WHERE id = ?`);
     stmt.run(...values);
+    this.webhookIndex = null;
 
     return this.getWebhook(id);
   }
@@ -453,34 +527,51 @@ export class IntegrationManager {
   deleteWebhook(id: number): boolean {
     const stmt = this.db.prepare('DELETE FROM webhooks WHERE id = ?');
     const result = stmt.run(id);
+    this.webhookIndex = null;
     return result.changes > 0;
   }
 
   recordWebhookDelivery(delivery: Omit<WebhookDelivery, 'id' | 'deliveredAt'>): void {
-    const stmt = this.db.prepare(`
+    this.recordWebhookDeliveries([delivery]);
+  }
+
+  /**
+   * Record delivery attempts in one transaction; each webhook's last
+   * triggered info is updated once, from its latest attempt
+   */
+  recordWebhookDeliveries(deliveries: Array<Omit<WebhookDelivery, 'id' | 'deliveredAt'>>): void {
+    if (deliveries.length === 0) return;
+
+    const insertStmt = prepareCached(this.db, `
       INSERT INTO webhook_deliveries (
         webhook_id, event, payload, status, duration, attempt, response, error
       ) VALUES (?, ?, ?, ?, ?, ?, ?, ?)
     `);
-
-    stmt.run(
-      delivery.webhookId,
-      delivery.event,
-      JSON.stringify(delivery.payload),
-      delivery.status,
-      delivery.duration,
-      delivery.attempt,
-      delivery.response,
-      delivery.error
-    );
-
-    // Update webhook last triggered info
-    const updateStmt = this.db.prepare(`
+    const updateStmt = prepareCached(this.db, `
       UPDATE webhooks 
       SET last_triggered_at = datetime('now'), last_status = ?, last_error = ?
       WHERE id = ?
     `);
-    updateStmt.run(delivery.status, delivery.error, delivery.webhookId);
+
+    this.db.transaction(() => {
+      const latest = new Map<number, Omit<WebhookDelivery, 'id' | 'deliveredAt'>>();
+      for (const delivery of deliveries) {
+        insertStmt.run(
+          delivery.webhookId,
+          delivery.event,
+          JSON.stringify(delivery.payload),
+          delivery.status,
+          delivery.duration,
+          delivery.attempt,
+          delivery.response,
+          delivery.error
+        );
+        latest.set(delivery.webhookId, delivery);
+      }
+      for (const delivery of latest.values()) {
+        updateStmt.run(delivery.status, delivery.error, delivery.webhookId);
+      }
+    })();
   }
 
   getWebhookDeliveries(webhookId: number, limit: number = 100): WebhookDelivery[] {
@@ -600,87 +691,75 @@ export class IntegrationManager {
       data.refillRate || null
     );
 
+    // A new config may change which limit applies to a key or user
+    this.rateLimitConfigs.clear();
     return this.getRateLimitConfig(result.lastInsertRowid as number)!;
   }
 
   getRateLimitConfig(id: number): RateLimitConfig | null {
-    const stmt = this.db.prepare('SELECT * FROM rate_limit_configs WHERE id = ?');
+    const stmt = prepareCached(this.db, 'SELECT * FROM rate_limit_configs WHERE id = ?');
     const row = stmt.get(id);
     return row ? this.mapRowToRateLimitConfig(row) : null;
   }
 
   getRateLimitByApiKey(apiKeyId: number): RateLimitConfig | null {
-    const stmt = this.db.prepare('SELECT * FROM rate_limit_configs WHERE api_key_id = ? AND enabled = 1');
+    const stmt = prepareCached(this.db, 'SELECT * FROM rate_limit_configs WHERE api_key_id = ? AND enabled = 1');
     const row = stmt.get(apiKeyId);
     return row ? this.mapRowToRateLimitConfig(row) : null;
   }
 
-  checkRateLimit(configId: number): { allowed: boolean; resetAt: Date; remaining: number } {
-    const config = this.getRateLimitConfig(configId);
-    if (!config || !config.enabled) {
-      return { allowed: true, resetAt: new Date(), remaining: -1 };
-    }
-
-    const state = this.getRateLimitState(configId);
-    const now = new Date();
-
-    if (config.strategy === RateLimitStrategy.FixedWindow) {
-      if (now >= state.resetAt) {
-        // Window expired, reset
-        this.resetRateLimitState(configId, config.windowSize);
-        return { allowed: true, resetAt: new Date(now.getTime() + config.windowSize * 1000), remaining: config.maxRequests - 1 };
-      }
-
-      if (state.requests >= config.maxRequests) {
-        return { allowed: false, resetAt: state.resetAt, remaining: 0 };
-      }
-
-      this.incrementRateLimitState(configId);
-      return { allowed: true, resetAt: state.resetAt, remaining: config.maxRequests - state.requests - 1 };
-    }
-
-    // Simplified - other strategies would be implemented similarly
-    return { allowed: true, resetAt: new Date(), remaining: -1 };
+  getRateLimitByUser(userId: number): RateLimitConfig | null {
+    const stmt = prepareCached(this.db, `
+      SELECT * FROM rate_limit_configs
+      WHERE user_id = ? AND api_key_id IS NULL AND enabled = 1
+      ORDER BY id DESC LIMIT 1
+    `);
+    const row = stmt.get(userId);
+    return row ? this.mapRowToRateLimitConfig(row) : null;
   }
 
-  private getRateLimitState(configId: number): RateLimitState {
-    const stmt = this.db.prepare('SELECT * FROM rate_limit_state WHERE config_id = ?');
-    let row = stmt.get(configId) as any;
-
-    if (!row) {
-      // Initialize state
-      const insertStmt = this.db.prepare(`
-        INSERT INTO rate_limit_state (config_id, requests, reset_at)
-        VALUES (?, 0, datetime('now', '+1 hour'))
-      `);
-      insertStmt.run(configId);
-      row = stmt.get(configId) as any;
+  /**
+   * Count one request against a config. State is kept in memory (see
+   * RateLimiter), so this does not touch the database on the hot path.
+   */
+  checkRateLimit(configId: number): RateLimitResult {
+    const config = this.getCachedRateLimitConfig(`id:${configId}`, () => this.getRateLimitConfig(configId));
+    return this.consumeRateLimit(config);
+  }
+
+  /**
+   * Count one API request: the API key's limit applies when the request
+   * used one, otherwise the user's
+   */
+  checkRequestRateLimit(principal: { apiKeyId?: number; userId?: number }): RateLimitResult {
+    let config: RateLimitConfig | null = null;
+    if (principal.apiKeyId !== undefined) {
+      const apiKeyId = principal.apiKeyId;
+      config = this.getCachedRateLimitConfig(`key:${apiKeyId}`, () => this.getRateLimitByApiKey(apiKeyId));
     }
-
-    return {
-      requests: row.requests,
-      resetAt: new Date(row.reset_at),
-      tokens: row.tokens,
-      lastRefill: row.last_refill ? new Date(row.last_refill) : null
-    };
+    if (!config && principal.userId !== undefined) {
+      const userId = principal.userId;
+      config = this.getCachedRateLimitConfig(`user:${userId}`, () => this.getRateLimitByUser(userId));
+    }
+    return this.consumeRateLimit(config);
   }
 
-  private resetRateLimitState(configId: number, windowSize: number): void {
-    const stmt = this.db.prepare(`
-      UPDATE rate_limit_state 
-      SET requests = 0, reset_at = datetime('now', '+' || ? || ' seconds')
-      WHERE config_id = ?
-    `);
-    stmt.run(windowSize, configId);
+  private consumeRateLimit(config: RateLimitConfig | null): RateLimitResult {
+    if (!config || !config.enabled) {
+      return { allowed: true, resetAt: new Date(), remaining: -1, limit: -1 };
+    }
+    return this.rateLimiter.consume(config);
   }
 
-  private incrementRateLimitState(configId: number): void {
-    const stmt = this.db.prepare(`
-      UPDATE rate_limit_state 
-      SET requests = requests + 1
-      WHERE config_id = ?
-    `);
-    stmt.run(configId);
+  private getCachedRateLimitConfig(key: string, load: () => RateLimitConfig | null): RateLimitConfig | null {
+    const now = Date.now();
+    const cached = this.rateLimitConfigs.get(key);
+    if (cached && now - cached.loadedAt < this.rateLimiterSettings.configCacheMs) {
+      return cached.config;
+    }
+    const config = load();
+    this.rateLimitConfigs.set(key, { config, loadedAt: now });
+    return config;
   }
 
   // ==================== Import/Export ====================
@@ -0,0 +1,389 @@
+import type { IpcMain } from 'electron';
+import { monitorEventLoopDelay, performance, IntervalHistogram } from 'perf_hooks';
+import { StatementObserver, setStatementObserver } from '../database/StatementCache';
+import {
+  DiagnosticsSettings,
+  DiagnosticsSnapshot,
+  DEFAULT_DIAGNOSTICS_SETTINGS,
+  EventLoopSummary,
+  MetricSummary,
+  TraceEvent,
+} from '../models/Diagnostics';
+
+// Histogram bucket upper bounds in milliseconds (exported in seconds)
+const BUCKETS_MS = [0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000];
+
+// Distinct SQL texts tracked before the rest are counted as '(other)'
+const MAX_SQL_SERIES = 500;
+const MAX_SQL_LABEL_LENGTH = 200;
+
+type SpanKind = TraceEvent['cat'];
+
+class LatencyHistogram {
+  readonly buckets = new Array<number>(BUCKETS_MS.length + 1).fill(0);
+  count = 0;
+  errors = 0;
+  rows = 0;
+  sumMs = 0;
+  maxMs = 0;
+
+  observe(ms: number): void {
+    let i = 0;
+    while (i < BUCKETS_MS.length && ms > BUCKETS_MS[i]) i++;
+    this.buckets[i]++;
+    this.count++;
+    this.sumMs += ms;
+    if (ms > this.maxMs) this.maxMs = ms;
+  }
+
+  /**
+   * Quantile estimate, interpolated linearly within the bucket it falls in
+   */
+  quantile(q: number): number {
+    if (this.count === 0) return 0;
+    const rank = q * this.count;
+    let seen = 0;
+    for (let i = 0; i < this.buckets.length; i++) {
+      if (this.buckets[i] === 0) continue;
+      if (seen + this.buckets[i] >= rank) {
+        const lower = i === 0 ? 0 : BUCKETS_MS[i - 1];
+        const upper = i < BUCKETS_MS.length ? Math.min(BUCKETS_MS[i], this.maxMs) : this.maxMs;
+        return lower + (upper - lower) * ((rank - seen) / this.buckets[i]);
+      }
+      seen += this.buckets[i];
+    }
+    return this.maxMs;
+  }
+
+  summarize(name: string, withRows: boolean): MetricSummary {
+    const round = (ms: number) => Math.round(ms * 1000) / 1000;
+    return {
+      name,
+      count: this.count,
+      errors: this.errors,
+      ...(withRows ? { rows: this.rows } : {}),
+      totalMs: round(this.sumMs),
+      meanMs: round(this.count > 0 ? this.sumMs / this.count : 0),
+      p50Ms: round(this.quantile(0.5)),
+      p95Ms: round(this.quantile(0.95)),
+      maxMs: round(this.maxMs),
+    };
+  }
+}
+
+/**
+ * In-process metrics for the main process: latency histograms per IPC
+ * channel, API route and SQL statement, event loop delay, and a ring
+ * buffer of recent spans for Chrome trace dumps.
+ *
+ * Timing is sampled. sampleRate applies to IPC calls and API requests,
+ * sqlSampleRate to statement executions through prepareCached (the
+ * registry installs itself as the statement observer). Counts therefore
+ * describe the sampled calls; the rates are exported alongside.
+ */
+export class MetricsRegistry implements StatementObserver {
+  private settings: DiagnosticsSettings = { ...DEFAULT_DIAGNOSTICS_SETTINGS };
+  private ipc = new Map<string, LatencyHistogram>();
+  private http = new Map<string, LatencyHistogram>();
+  private sql = new Map<string, LatencyHistogram>();
+  private sqlKeys = new Map<string, string>(); // raw SQL -> normalized label
+  private trace: TraceEvent[] = [];
+  private traceNext = 0;
+  private eventLoop: IntervalHistogram | null = null;
+  private since = new Date();
+
+  constructor(settings?: Partial<DiagnosticsSettings>) {
+    this.configure(settings ?? {});
+  }
+
+  /**
+   * Apply new settings; takes effect immediately
+   */
+  configure(settings: Partial<DiagnosticsSettings>): void {
+    const next = { ...this.settings, ...settings };
+    next.sampleRate = clampRate(next.sampleRate);
+    next.sqlSampleRate = clampRate(next.sqlSampleRate);
+    next.traceBufferSize = Math.max(0, Math.floor(next.traceBufferSize));
+    next.eventLoopResolutionMs = Math.max(1, Math.floor(next.eventLoopResolutionMs));
+
+    const resolutionChanged = next.eventLoopResolutionMs !== this.settings.eventLoopResolutionMs;
+    if (next.traceBufferSize !== this.settings.traceBufferSize) {
+      // slice(-0) would keep everything
+      this.trace = next.traceBufferSize === 0 ? [] : this.orderedTrace().slice(-next.traceBufferSize);
+      this.traceNext = this.trace.length % Math.max(1, next.traceBufferSize);
+    }
+    this.settings = next;
+
+    setStatementObserver(next.enabled && next.sqlSampleRate > 0 ? this : null);
+
+    if (!next.enabled || resolutionChanged) {
+      this.eventLoop?.disable();
+      this.eventLoop = null;
+    }
+    if (next.enabled && !this.eventLoop) {
+      this.eventLoop = monitorEventLoopDelay({ resolution: next.eventLoopResolutionMs });
+      this.eventLoop.enable();
+    }
+  }
+
+  getSettings(): DiagnosticsSettings {
+    return { ...this.settings };
+  }
+
+  /**
+   * Time `fn` as an IPC call or API request when sampled. Promises are timed
+   * until they settle; a rejection or throw counts as an error.
+   */
+  time<T>(kind: 'ipc' | 'http', name: string, fn: () => T): T {
+    if (!this.sampleRequest()) return fn();
+
+    const started = performance.now();
+    let result: T;
+    try {
+      result = fn();
+    } catch (error) {
+      this.observe(kind, name, started, performance.now() - started, true);
+      throw error;
+    }
+    if (result && typeof (result as any).then === 'function') {
+      return (result as any).then(
+        (value: unknown) => {
+          this.observe(kind, name, started, performance.now() - started, false);
+          return value;
+        },
+        (error: unknown) => {
+          this.observe(kind, name, started, performance.now() - started, true);
+          throw error;
+        }
+      ) as T;
+    }
+    this.observe(kind, name, started, performance.now() - started, false);
+    return result;
+  }
+
+  /**
+   * Whether to time the next IPC call or API request
+   */
+  sampleRequest(): boolean {
+    const { enabled, sampleRate } = this.settings;
+    return enabled && (sampleRate >= 1 || (sampleRate > 0 && Math.random() < sampleRate));
+  }
+
+  /**
+   * Record a finished IPC call or API request timed by the caller
+   * (`startedAt` from performance.now())
+   */
+  observe(kind: 'ipc' | 'http', name: string, startedAt: number, durationMs: number, error: boolean, args?: Record<string, unknown>): void {
+    const histogram = series(kind === 'ipc' ? this.ipc : this.http, name);
+    histogram.observe(durationMs);
+    if (error) histogram.errors++;
+    this.addSpan(kind, name, startedAt, durationMs, error ? { ...args, error: true } : args);
+  }
+
+  // StatementObserver
+  sample(): boolean {
+    const { enabled, sqlSampleRate } = this.settings;
+    return enabled && (sqlSampleRate >= 1 || Math.random() < sqlSampleRate);
+  }
+
+  // StatementObserver
+  record(sql: string, startedAt: number, durationMs: number, rows: number): void {
+    let key = this.sqlKeys.get(sql);
+    if (key === undefined) {
+      const normalized = normalizeSql(sql);
+      key = this.sql.has(normalized) || this.sql.size < MAX_SQL_SERIES ? normalized : '(other)';
+      // Statements built per call (IN lists, batch sizes) would grow this without bound
+      if (this.sqlKeys.size < MAX_SQL_SERIES * 4) this.sqlKeys.set(sql, key);
+    }
+    const histogram = series(this.sql, key);
+    histogram.observe(durationMs);
+    histogram.rows += rows;
+    this.addSpan('sql', key, startedAt, durationMs, { rows });
+  }
+
+  /**
+   * Summaries for the diagnostics view, slowest (by total time) first
+   */
+  getSnapshot(limit = 50): DiagnosticsSnapshot {
+    const top = (map: Map<string, LatencyHistogram>, withRows: boolean) =>
+      Array.from(map, ([name, histogram]) => histogram.summarize(name, withRows))
+        .sort((a, b) => b.totalMs - a.totalMs)
+        .slice(0, limit);
+
+    return {
+      settings: this.getSettings(),
+      since: this.since.toISOString(),
+      eventLoop: this.eventLoopSummary(),
+      ipc: top(this.ipc, false),
+      http: top(this.http, false),
+      sql: top(this.sql, true),
+      traceEvents: this.trace.length,
+    };
+  }
+
+  /**
+   * Buffered spans, oldest first, as a Chrome trace (JSON object format)
+   */
+  getTrace(): { traceEvents: TraceEvent[]; displayTimeUnit: 'ms'; otherData: Record<string, unknown> } {
+    return {
+      traceEvents: this.orderedTrace(),
+      displayTimeUnit: 'ms',
+      otherData: {
+        app: 'DevTrack',
+        sampleRate: this.settings.sampleRate,
+        sqlSampleRate: this.settings.sqlSampleRate,
+        timeOrigin: performance.timeOrigin,
+      },
+    };
+  }
+
+  /**
+   * Prometheus text exposition format (version 0.0.4)
+   */
+  toPrometheus(): string {
+    const lines: string[] = [];
+
+    const histogram = (metric: string, help: string, label: string, map: Map<string, LatencyHistogram>) => {
+      lines.push(`# HELP ${metric} ${help}`, `# TYPE ${metric} histogram`);
+      for (const [name, h] of map) {
+        const labels = labelPairs(label, name);
+        let cumulative = 0;
+        BUCKETS_MS.forEach((bound, i) => {
+          cumulative += h.buckets[i];
+          lines.push(`${metric}_bucket{${labels},le="${bound / 1000}"} ${cumulative}`);
+        });
+        lines.push(`${metric}_bucket{${labels},le="+Inf"} ${h.count}`);
+        lines.push(`${metric}_sum{${labels}} ${h.sumMs / 1000}`);
+        lines.push(`${metric}_count{${labels}} ${h.count}`);
+      }
+    };
+    const counter = (metric: string, help: string, label: string, map: Map<string, LatencyHistogram>, value: (h: LatencyHistogram) => number) => {
+      lines.push(`# HELP ${metric} ${help}`, `# TYPE ${metric} counter`);
+      for (const [name, h] of map) lines.push(`${metric}{${labelPairs(label, name)}} ${value(h)}`);
+    };
+    const gauge = (metric: string, help: string, samples: Array<[string, number]>) => {
+      lines.push(`# HELP ${metric} ${help}`, `# TYPE ${metric} gauge`);
+      for (const [labels, value] of samples) lines.push(`${metric}${labels} ${value}`);
+    };
+
+    gauge('devtrack_metrics_sample_rate', 'Fraction of calls timed', [
+      ['{kind="requests"}', this.settings.sampleRate],
+      ['{kind="sql"}', this.settings.sqlSampleRate],
+    ]);
+    histogram('devtrack_ipc_request_duration_seconds', 'IPC handler latency (sampled)', 'channel', this.ipc);
+    counter('devtrack_ipc_request_errors_total', 'IPC handlers that threw (sampled)', 'channel', this.ipc, h => h.errors);
+    histogram('devtrack_http_request_duration_seconds', 'REST API request latency (sampled)', 'route', this.http);
+    counter('devtrack_http_request_errors_total', 'REST API 5xx responses (sampled)', 'route', this.http, h => h.errors);
+    histogram('devtrack_sql_statement_duration_seconds', 'SQL statement execution time (sampled)', 'statement', this.sql);
+    counter('devtrack_sql_rows_total', 'Rows returned or changed by sampled statements', 'statement', this.sql, h => h.rows);
+
+    const loop = this.eventLoopSummary();
+    if (loop) {
+      gauge('devtrack_event_loop_lag_seconds', 'Event loop delay since the last reset', [
+        ['{quantile="0.5"}', loop.p50Ms / 1000],
+        ['{quantile="0.99"}', loop.p99Ms / 1000],
+        ['{quantile="1"}', loop.maxMs / 1000],
+      ]);
+    }
+    const memory = process.memoryUsage();
+    gauge('devtrack_process_resident_memory_bytes', 'Main process resident set size', [['', memory.rss]]);
+    gauge('devtrack_process_heap_used_bytes', 'Main process V8 heap in use', [['', memory.heapUsed]]);
+
+    return lines.join('\n') + '\n';
+  }
+
+  /**
+   * Clear all counters, histograms and buffered spans
+   */
+  reset(): void {
+    this.ipc.clear();
+    this.http.clear();
+    this.sql.clear();
+    this.sqlKeys.clear();
+    this.trace = [];
+    this.traceNext = 0;
+    this.eventLoop?.reset();
+    this.since = new Date();
+  }
+
+  close(): void {
+    setStatementObserver(null);
+    this.eventLoop?.disable();
+    this.eventLoop = null;
+  }
+
+  private addSpan(cat: SpanKind, name: string, startedAt: number, durationMs: number, args?: Record<string, unknown>): void {
+    const size = this.settings.traceBufferSize;
+    if (size === 0) return;
+    const event: TraceEvent = {
+      name,
+      cat,
+      ph: 'X',
+      ts: Math.round(startedAt * 1000),
+      dur: Math.max(1, Math.round(durationMs * 1000)),
+      pid: process.pid,
+      tid: 0,
+      ...(args ? { args } : {}),
+    };
+    if (this.trace.length < size) {
+      this.trace.push(event);
+    } else {
+      this.trace[this.traceNext] = event;
+    }
+    this.traceNext = (this.traceNext + 1) % size;
+  }
+
+  private orderedTrace(): TraceEvent[] {
+    if (this.trace.length < this.settings.traceBufferSize) return this.trace.slice();
+    return this.trace.slice(this.traceNext).concat(this.trace.slice(0, this.traceNext));
+  }
+
+  private eventLoopSummary(): EventLoopSummary | null {
+    const loop = this.eventLoop;
+    if (!loop || loop.count === 0) return null;
+    const ms = (ns: number) => Math.round(ns / 1e3) / 1e3;
+    return {
+      meanMs: ms(loop.mean),
+      p50Ms: ms(loop.percentile(50)),
+      p99Ms: ms(loop.percentile(99)),
+      maxMs: ms(loop.max),
+    };
+  }
+}
+
+/**
+ * Route every ipcMain.handle registration made after this call through
+ * metrics.time, keyed by channel
+ */
+export function instrumentIpcMain(ipc: IpcMain, metrics: MetricsRegistry): void {
+  const handle = ipc.handle.bind(ipc);
+  ipc.handle = (channel, listener) =>
+    handle(channel, (event, ...args) => metrics.time('ipc', channel, () => listener(event, ...args)));
+}
+
+function series(map: Map<string, LatencyHistogram>, name: string): LatencyHistogram {
+  let histogram = map.get(name);
+  if (!histogram) {
+    histogram = new LatencyHistogram();
+    map.set(name, histogram);
+  }
+  return histogram;
+}
+
+/**
+ * One label per statement shape: whitespace collapsed, repeated VALUES
+ * tuples folded (multi-row inserts of any size share a series), and capped
+ */
+function normalizeSql(sql: string): string {
+  const text = sql.replace(/\s+/g, ' ').trim().replace(/(\([^()]*\))(?:, ?\1)+/g, '$1, ...');
+  return text.length > MAX_SQL_LABEL_LENGTH ? `${text.slice(0, MAX_SQL_LABEL_LENGTH - 3)}...` : text;
+}
+
+function labelPairs(label: string, value: string): string {
+  const escaped = value.replace(/\\/g, '\\\\').replace(/"/g, '\\"').replace(/\n/g, '\\n');
+  return `${label}="${escaped}"`;
+}
+
+function clampRate(rate: number): number {
+  return Number.isFinite(rate) ? Math.min(1, Math.max(0, rate)) : 0;
+}
@@ -0,0 +1,230 @@
+import { NotificationRepository } from '../repositories/NotificationRepository';
+import {
+  Notification,
+  CreateNotificationData,
+  NotificationDelta,
+  NotificationPipelineSettings,
+  DEFAULT_NOTIFICATION_PIPELINE_SETTINGS,
+  notificationCoalesceKey,
+} from '../models/Notification';
+
+export type NotificationDeltaListener = (delta: NotificationDelta) => void;
+
+interface RecentNotification {
+  id: number;
+  at: number; // ms timestamp of the last write
+}
+
+/**
+ * NotificationPipeline - Single entry point for creating notifications.
+ *
+ * Notifications are queued and written together: one transaction with
+ * multi-row INSERTs per batch, however many recipients a fan-out has.
+ * Duplicates (same user, type, related project/task and title) are
+ * coalesced, both within a batch and against unread notifications written
+ * during the coalesce window, by refreshing the existing row.
+ *
+ * Every change is published as a per-user NotificationDelta so renderers
+ * can patch their state instead of polling.
+ */
+export class NotificationPipeline {
+  private settings: NotificationPipelineSettings;
+  private queue: CreateNotificationData[] = [];
+  private timer: NodeJS.Timeout | null = null;
+  private recent = new Map<string, RecentNotification>();
+  private listeners = new Set<NotificationDeltaListener>();
+
+  constructor(private notificationRepo: NotificationRepository, settings?: Partial<NotificationPipelineSettings>) {
+    this.settings = { ...DEFAULT_NOTIFICATION_PIPELINE_SETTINGS, ...settings };
+  }
+
+  /**
+   * Subscribe to deltas. Returns an unsubscribe function.
+   */
+  subscribe(listener: NotificationDeltaListener): () => void {
+    this.listeners.add(listener);
+    return () => {
+      this.listeners.delete(listener);
+    };
+  }
+
+  /**
+   * Queue notifications for the next batch
+   */
+  enqueue(notifications: CreateNotificationData | CreateNotificationData[]): void {
+    const items = Array.isArray(notifications) ? notifications : [notifications];
+    if (items.length === 0) return;
+
+    this.queue.push(...items);
+    if (!this.timer) {
+      this.timer = setTimeout(() => {
+        this.timer = null;
+        this.flush();
+      }, this.settings.batchMs);
+    }
+  }
+
+  /**
+   * Write queued notifications plus `notifications` now, returning the rows
+   * written for `notifications` (coalesced duplicates share a row)
+   */
+  deliver(notifications: CreateNotificationData[]): Notification[] {
+    this.queue.push(...notifications);
+    const written = this.flush();
+    const byKey = new Map(written.map(notification => [this.keyOf(notification), notification]));
+    return notifications
+      .map(data => byKey.get(notificationCoalesceKey(data)))
+      .filter((notification): notification is Notification => !!notification);
+  }
+
+  /**
+   * Write everything queued and publish the resulting deltas
+   */
+  flush(): Notification[] {
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    if (this.queue.length === 0) return [];
+
+    const batch = this.queue;
+    this.queue = [];
+    const now = Date.now();
+    this.pruneRecent(now);
+
+    // Last duplicate in the batch wins
+    const merged = new Map<string, CreateNotificationData>();
+    for (const data of batch) {
+      const key = notificationCoalesceKey(data);
+      merged.delete(key);
+      merged.set(key, data);
+    }
+
+    const inserts: CreateNotificationData[] = [];
+    const refreshes: Array<{ id: number; data: CreateNotificationData }> = [];
+    for (const [key, data] of merged) {
+      const recent = this.recent.get(key);
+      if (recent) {
+        refreshes.push({ id: recent.id, data });
+      } else {
+        inserts.push(data);
+      }
+    }
+
+    const written = this.notificationRepo.writeBatch(inserts, refreshes);
+    for (const notification of written) {
+      this.recent.set(this.keyOf(notification), { id: notification.id, at: now });
+    }
+
+    const byUser = new Map<number, Notification[]>();
+    for (const notification of written) {
+      const list = byUser.get(notification.userId) ?? [];
+      list.push(notification);
+      byUser.set(notification.userId, list);
+    }
+    this.publish(Array.from(byUser, ([userId, upserted]) => ({ userId, upserted })));
+
+    return written;
+  }
+
+  /**
+   * Mark one notification read and publish the change
+   */
+  markAsRead(id: number): boolean {
+    const notification = this.notificationRepo.findById(id);
+    if (!notification || !this.notificationRepo.markAsRead(id)) return false;
+    this.forgetId(id);
+    this.publish([{ userId: notification.userId, readIds: [id] }]);
+    return true;
+  }
+
+  /**
+   * Mark one notification unread and publish the change
+   */
+  markAsUnread(id: number): boolean {
+    const notification = this.notificationRepo.findById(id);
+    if (!notification || !this.notificationRepo.markAsUnread(id)) return false;
+    this.publish([{ userId: notification.userId, unreadIds: [id] }]);
+    return true;
+  }
+
+  /**
+   * Mark all of a user's notifications read and publish the change
+   */
+  markAllAsRead(userId: number): number {
+    const changed = this.notificationRepo.markAllAsRead(userId);
+    for (const [key] of this.recent) {
+      if (key.startsWith(`${userId}|`)) this.recent.delete(key);
+    }
+    if (changed > 0) {
+      this.publish([{ userId, allRead: true }]);
+    }
+    return changed;
+  }
+
+  /**
+   * Delete one notification and publish the change
+   */
+  delete(id: number): boolean {
+    const notification = this.notificationRepo.findById(id);
+    if (!notification || !this.notificationRepo.delete(id)) return false;
+    this.forgetId(id);
+    this.publish([{ userId: notification.userId, removedIds: [id] }]);
+    return true;
+  }
+
+  /**
+   * Write anything still queued and drop subscribers
+   */
+  close(): void {
+    this.flush();
+    this.listeners.clear();
+  }
+
+  private publish(changes: Array<Partial<NotificationDelta> & { userId: number }>): void {
+    if (changes.length === 0 || this.listeners.size === 0) return;
+
+    const counts = this.notificationRepo.getUnreadCounts(changes.map(change => change.userId));
+    for (const change of changes) {
+      const delta: NotificationDelta = {
+        upserted: [],
+        readIds: [],
+        unreadIds: [],
+        removedIds: [],
+        allRead: false,
+        ...change,
+        unreadCount: counts.get(change.userId) ?? 0,
+      };
+      for (const listener of this.listeners) {
+        try {
+          listener(delta);
+        } catch (error) {
+          console.error('[NotificationPipeline] Delta listener failed:', error);
+        }
+      }
+    }
+  }
+
+  private keyOf(notification: Notification): string {
+    return notificationCoalesceKey({
+      userId: notification.userId,
+      type: notification.type,
+      title: notification.title,
+      message: notification.message,
+      relatedProjectId: notification.relatedProjectId ?? undefined,
+      relatedTaskId: notification.relatedTaskId ?? undefined,
+    });
+  }
+
+  private forgetId(id: number): void {
+    for (const [key, recent] of this.recent) {
+      if (recent.id === id) this.recent.delete(key);
+    }
+  }
+
+  private pruneRecent(now: number): void {
+    for (const [key, recent] of this.recent) {
+      if (now - recent.at > this.settings.coalesceWindowMs) this.recent.delete(key);
+    }
+  }
+}
@@ -0,0 +1,127 @@
+import * as bcrypt from 'bcryptjs';
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as path from 'path';
+import { Worker } from 'worker_threads';
+import type { PasswordWorkerJob, PasswordWorkerReply } from './passwordWorker';
+
+// OWASP's scrypt baseline for 32 MiB of memory per hash
+const SCRYPT_LOG_N = 15;
+const SCRYPT_R = 8;
+const SCRYPT_P = 3;
+const SCRYPT_MAXMEM = 64 * 1024 * 1024;
+const KEY_BYTES = 32;
+const SALT_BYTES = 16;
+
+const SCRYPT_PREFIX = '$scrypt$';
+const CURRENT_PARAMS = `ln=${SCRYPT_LOG_N},r=${SCRYPT_R},p=${SCRYPT_P}`;
+const BCRYPT_HASH = /^\$2[abxy]?\$/;
+
+const WORKER_SCRIPT = path.join(__dirname, 'passwordWorker.js');
+
+export interface PasswordHash {
+  hash: string; // $scrypt$ln=..,r=..,p=..$<salt>$<key>, base64 parts
+  salt: string;
+}
+
+/**
+ * Password hashing that keeps the main thread free. New hashes use Node's
+ * native scrypt, which runs on the libuv thread pool. bcrypt hashes written
+ * by earlier versions are verified on a worker thread; callers replace them
+ * after a successful login (see needsRehash()).
+ */
+export class PasswordHasher {
+  private worker: Worker | null = null;
+  private pending = new Map<number, { resolve: (valid: boolean) => void; reject: (error: Error) => void }>();
+  private nextJobId = 1;
+
+  async hash(password: string): Promise<PasswordHash> {
+    const salt = crypto.randomBytes(SALT_BYTES);
+    const key = await scrypt(password, salt, KEY_BYTES, SCRYPT_LOG_N, SCRYPT_R, SCRYPT_P);
+    return {
+      hash: `${SCRYPT_PREFIX}${CURRENT_PARAMS}$${salt.toString('base64')}$${key.toString('base64')}`,
+      salt: salt.toString('base64'),
+    };
+  }
+
+  async verify(password: string, stored: string): Promise<boolean> {
+    if (stored.startsWith(SCRYPT_PREFIX)) {
+      const match = /^\$scrypt\$ln=(\d+),r=(\d+),p=(\d+)\$([^$]+)\$([^$]+)$/.exec(stored);
+      if (!match) return false;
+      const expected = Buffer.from(match[5], 'base64');
+      const key = await scrypt(
+        password, Buffer.from(match[4], 'base64'), expected.length, Number(match[1]), Number(match[2]), Number(match[3])
+      );
+      return crypto.timingSafeEqual(key, expected);
+    }
+    if (BCRYPT_HASH.test(stored)) {
+      return this.verifyBcrypt(password, stored);
+    }
+    return false;
+  }
+
+  /**
+   * Whether `stored` uses an older scheme or weaker parameters than hash()
+   */
+  needsRehash(stored: string): boolean {
+    return !stored.startsWith(`${SCRYPT_PREFIX}${CURRENT_PARAMS}$`);
+  }
+
+  close(): void {
+    this.stopWorker(new Error('Password hasher closed'));
+  }
+
+  private verifyBcrypt(password: string, hash: string): Promise<boolean> {
+    const worker = this.getWorker();
+    if (!worker) {
+      // No compiled worker (e.g. running from source): bcryptjs's async API
+      // at least yields between rounds
+      return bcrypt.compare(password, hash);
+    }
+
+    return new Promise((resolve, reject) => {
+      const id = this.nextJobId++;
+      this.pending.set(id, { resolve, reject });
+      worker.postMessage({ id, password, hash } as PasswordWorkerJob);
+    });
+  }
+
+  private getWorker(): Worker | null {
+    if (this.worker) return this.worker;
+    if (!fs.existsSync(WORKER_SCRIPT)) return null;
+
+    const worker = new Worker(WORKER_SCRIPT);
+    worker.on('message', (reply: PasswordWorkerReply) => {
+      const job = this.pending.get(reply.id);
+      if (!job) return;
+      this.pending.delete(reply.id);
+      if (reply.error !== undefined) job.reject(new Error(reply.error));
+      else job.resolve(reply.valid === true);
+    });
+    worker.on('error', error => this.stopWorker(error));
+    worker.on('exit', () => {
+      if (this.worker === worker) this.stopWorker(new Error('Password worker exited'));
+    });
+    // Legacy hashes are rare; an idle worker must not keep the app alive
+    worker.unref();
+    this.worker = worker;
+    return worker;
+  }
+
+  private stopWorker(error: Error): void {
+    const worker = this.worker;
+    this.worker = null;
+    for (const job of this.pending.values()) job.reject(error);
+    this.pending.clear();
+    void worker?.terminate();
+  }
+}
+
+function scrypt(password: string, salt: Buffer, keyLength: number, logN: number, r: number, p: number): Promise<Buffer> {
+  return new Promise((resolve, reject) => {
+    crypto.scrypt(password, salt, keyLength, { N: 2 ** logN, r, p, maxmem: SCRYPT_MAXMEM }, (error, key) => {
+      if (error) reject(error);
+      else resolve(key);
+    });
+  });
+}
@@ -0,0 +1,157 @@
+import Database from 'better-sqlite3';
+import { prepareCached } from '../database/StatementCache';
+
+export const DEFAULT_PERMISSION_CACHE_ENTRIES = 10000;
+
+/**
+ * Permission cache counters, exposed for diagnostics
+ */
+export interface PermissionCacheStats {
+  entries: number;
+  maxEntries: number;
+  roles: number;
+  permissions: number;
+  hits: number;
+  misses: number;
+}
+
+/**
+ * Effective permissions per (user, project), kept as bitsets over the
+ * permissions table: bit i is set when the user's project role grants the
+ * i-th permission (by id). The first check for a pair costs one membership
+ * lookup, plus one role_permissions read per role; later checks are a Map
+ * lookup and a bit test. Members sharing a role share its bitset.
+ *
+ * The cache does not watch the database. Owners call the invalidate
+ * methods when roles, permissions or memberships change (see the
+ * repositories' change listeners).
+ */
+export class PermissionCache {
+  private bitByName: Map<string, number> | null = null;
+  private names: string[] = [];
+  private roleMasks = new Map<number, Uint32Array>();
+  // `${userId}:${projectId}` -> mask, or null for non-members; LRU order
+  private entries = new Map<string, Uint32Array | null>();
+  private hits = 0;
+  private misses = 0;
+
+  constructor(private db: Database.Database, private maxEntries = DEFAULT_PERMISSION_CACHE_ENTRIES) {}
+
+  /**
+   * Whether the user's role in the project grants `permission` (e.g. 'task:update')
+   */
+  can(userId: number, projectId: number, permission: string): boolean {
+    const bit = this.permissionBits().get(permission);
+    if (bit === undefined) return false;
+    const mask = this.getMask(userId, projectId);
+    return mask !== null && (mask[bit >>> 5] & (1 << (bit & 31))) !== 0;
+  }
+
+  /**
+   * Names of every permission the user has in the project
+   */
+  getPermissions(userId: number, projectId: number): string[] {
+    this.permissionBits();
+    const mask = this.getMask(userId, projectId);
+    if (!mask) return [];
+    return this.names.filter((_, bit) => (mask[bit >>> 5] & (1 << (bit & 31))) !== 0);
+  }
+
+  /**
+   * Drop everything, e.g. after a role's permissions or the permission list changed
+   */
+  invalidateAll(): void {
+    this.bitByName = null;
+    this.names = [];
+    this.roleMasks.clear();
+    this.entries.clear();
+  }
+
+  invalidateMember(projectId: number, userId: number): void {
+    this.entries.delete(`${userId}:${projectId}`);
+  }
+
+  /**
+   * Drop a project's entries, e.g. after it was deleted with its members
+   */
+  invalidateProject(projectId: number): void {
+    const suffix = `:${projectId}`;
+    for (const key of this.entries.keys()) {
+      if (key.endsWith(suffix)) this.entries.delete(key);
+    }
+  }
+
+  /**
+   * Drop a user's entries, e.g. after the user was deleted
+   */
+  invalidateUser(userId: number): void {
+    const prefix = `${userId}:`;
+    for (const key of this.entries.keys()) {
+      if (key.startsWith(prefix)) this.entries.delete(key);
+    }
+  }
+
+  getStats(): PermissionCacheStats {
+    return {
+      entries: this.entries.size,
+      maxEntries: this.maxEntries,
+      roles: this.roleMasks.size,
+      permissions: this.names.length,
+      hits: this.hits,
+      misses: this.misses,
+    };
+  }
+
+  private getMask(userId: number, projectId: number): Uint32Array | null {
+    const key = `${userId}:${projectId}`;
+    const cached = this.entries.get(key);
+    if (cached !== undefined) {
+      this.hits++;
+      // Re-insert to mark as most recently used
+      this.entries.delete(key);
+      this.entries.set(key, cached);
+      return cached;
+    }
+
+    this.misses++;
+    const member = prepareCached(this.db, `
+      SELECT role_id FROM project_members WHERE project_id = ? AND user_id = ?
+    `).get(projectId, userId) as { role_id: number } | undefined;
+    const mask = member ? this.roleMask(member.role_id) : null;
+
+    this.entries.set(key, mask);
+    if (this.entries.size > this.maxEntries) {
+      this.entries.delete(this.entries.keys().next().value as string);
+    }
+    return mask;
+  }
+
+  private roleMask(roleId: number): Uint32Array {
+    let mask = this.roleMasks.get(roleId);
+    if (mask) return mask;
+
+    const bits = this.permissionBits();
+    mask = new Uint32Array(Math.ceil(this.names.length / 32));
+    const rows = prepareCached(this.db, `
+      SELECT p.name FROM role_permissions rp
+      JOIN permissions p ON p.id = rp.permission_id
+      WHERE rp.role_id = ?
+    `).all(roleId) as Array<{ name: string }>;
+    for (const row of rows) {
+      const bit = bits.get(row.name)!;
+      mask[bit >>> 5] |= 1 << (bit & 31);
+    }
+
+    this.roleMasks.set(roleId, mask);
+    return mask;
+  }
+
+  private permissionBits(): Map<string, number> {
+    if (!this.bitByName) {
+      const rows = prepareCached(this.db, 'SELECT name FROM permissions ORDER BY id').all() as Array<{ name: string }>;
+      this.names = rows.map(row => row.name);
+      this.bitByName = new Map(this.names.map((name, bit) => [name, bit]));
+    }
+    return this.bitByName;
+  }
+}
@@ -0,0 +1,244 @@
+import Database from 'better-sqlite3';
+import { prepareCached } from '../database/StatementCache';
+import { RateLimitConfig, RateLimitResult, RateLimitStrategy } from '../models/Integration';
+
+interface BucketState {
+  configId: number;
+  requests: number; // fixed/sliding window: requests in the current window
+  previousRequests: number; // sliding window: requests in the previous window
+  windowStart: number; // ms
+  windowMs: number;
+  level: number; // token bucket: tokens left; leaky bucket: queued requests
+  updatedAt: number; // ms of the last refill/leak
+  dirty: boolean;
+}
+
+interface RateLimitStateRow {
+  requests: number;
+  reset_at: string;
+  tokens: number | null;
+  last_refill: string | null;
+}
+
+/**
+ * RateLimiter - In-memory rate limit state per rate_limit_configs row.
+ *
+ * Every check is pure arithmetic on the bucket held in memory; the SQLite
+ * state table is only read when a bucket is first used and written by a
+ * periodic checkpoint, so limits survive restarts (give or take one
+ * checkpoint interval) without a query per request.
+ *
+ * - FixedWindow: counter reset windowSize seconds after the window opened.
+ * - SlidingWindow: counter per aligned window, with the previous window's
+ *   count weighted by how much of it still overlaps the sliding window.
+ * - TokenBucket: burstSize tokens (default maxRequests), refilled at
+ *   refillRate per second (default maxRequests / windowSize).
+ * - LeakyBucket: a queue of burstSize requests drained at the same rate;
+ *   requests that would overflow it are rejected.
+ */
+export class RateLimiter {
+  private buckets = new Map<number, BucketState>();
+  private timer: NodeJS.Timeout | null = null;
+
+  constructor(private db: Database.Database, checkpointMs: number) {
+    this.timer = setInterval(() => this.checkpoint(), checkpointMs);
+    this.timer.unref();
+  }
+
+  /**
+   * Count one request against `config`
+   */
+  consume(config: RateLimitConfig, now: number = Date.now()): RateLimitResult {
+    const bucket = this.getBucket(config, now);
+    bucket.windowMs = config.windowSize * 1000;
+    bucket.dirty = true;
+
+    switch (config.strategy) {
+      case RateLimitStrategy.SlidingWindow:
+        return this.consumeSlidingWindow(config, bucket, now);
+      case RateLimitStrategy.TokenBucket:
+        return this.consumeTokenBucket(config, bucket, now);
+      case RateLimitStrategy.LeakyBucket:
+        return this.consumeLeakyBucket(config, bucket, now);
+      case RateLimitStrategy.FixedWindow:
+      default:
+        return this.consumeFixedWindow(config, bucket, now);
+    }
+  }
+
+  /**
+   * Drop the state for a config (e.g. after its limits changed)
+   */
+  forget(configId: number): void {
+    this.buckets.delete(configId);
+  }
+
+  /**
+   * Write changed buckets to rate_limit_state in one transaction
+   */
+  checkpoint(): void {
+    const dirty = Array.from(this.buckets.values()).filter(bucket => bucket.dirty);
+    if (dirty.length === 0) return;
+
+    try {
+      const upsert = prepareCached(this.db, `
+        INSERT INTO rate_limit_state (config_id, requests, reset_at, tokens, last_refill)
+        SELECT ?, ?, ?, ?, ? WHERE EXISTS (SELECT 1 FROM rate_limit_configs WHERE id = ?)
+        ON CONFLICT(config_id) DO UPDATE SET
+          requests = excluded.requests,
+          reset_at = excluded.reset_at,
+          tokens = excluded.tokens,
+          last_refill = excluded.last_refill
+      `);
+      this.db.transaction(() => {
+        for (const bucket of dirty) {
+          upsert.run(
+            bucket.configId,
+            bucket.requests,
+            new Date(bucket.windowStart + bucket.windowMs).toISOString(),
+            bucket.level,
+            new Date(bucket.updatedAt).toISOString(),
+            bucket.configId
+          );
+          bucket.dirty = false;
+        }
+      })();
+    } catch (error) {
+      console.error('[RateLimiter] Checkpoint failed:', error);
+    }
+  }
+
+  /**
+   * Stop the checkpoint timer after a final checkpoint
+   */
+  close(): void {
+    if (this.timer) {
+      clearInterval(this.timer);
+      this.timer = null;
+    }
+    this.checkpoint();
+  }
+
+  private consumeFixedWindow(config: RateLimitConfig, bucket: BucketState, now: number): RateLimitResult {
+    const windowMs = config.windowSize * 1000;
+    if (now >= bucket.windowStart + windowMs) {
+      bucket.windowStart = now;
+      bucket.requests = 0;
+    }
+    const resetAt = new Date(bucket.windowStart + windowMs);
+    if (bucket.requests >= config.maxRequests) {
+      return { allowed: false, resetAt, remaining: 0, limit: config.maxRequests };
+    }
+    bucket.requests++;
+    return { allowed: true, resetAt, remaining: config.maxRequests - bucket.requests, limit: config.maxRequests };
+  }
+
+  private consumeSlidingWindow(config: RateLimitConfig, bucket: BucketState, now: number): RateLimitResult {
+    const windowMs = config.windowSize * 1000;
+    const current = Math.floor(now / windowMs) * windowMs;
+    if (bucket.windowStart !== current) {
+      bucket.previousRequests = bucket.windowStart === current - windowMs ? bucket.requests : 0;
+      bucket.requests = 0;
+      bucket.windowStart = current;
+    }
+
+    const overlap = 1 - (now - current) / windowMs;
+    const estimated = bucket.previousRequests * overlap + bucket.requests;
+    const resetAt = new Date(current + windowMs);
+    if (estimated + 1 > config.maxRequests) {
+      return { allowed: false, resetAt, remaining: 0, limit: config.maxRequests };
+    }
+    bucket.requests++;
+    return {
+      allowed: true,
+      resetAt,
+      remaining: Math.max(0, Math.floor(config.maxRequests - estimated - 1)),
+      limit: config.maxRequests,
+    };
+  }
+
+  private consumeTokenBucket(config: RateLimitConfig, bucket: BucketState, now: number): RateLimitResult {
+    const { capacity, ratePerMs } = this.bucketShape(config);
+    bucket.level = Math.min(capacity, bucket.level + (now - bucket.updatedAt) * ratePerMs);
+    bucket.updatedAt = now;
+
+    if (bucket.level < 1) {
+      return { allowed: false, resetAt: new Date(now + (1 - bucket.level) / ratePerMs), remaining: 0, limit: capacity };
+    }
+    bucket.level -= 1;
+    return {
+      allowed: true,
+      resetAt: new Date(now + (capacity - bucket.level) / ratePerMs),
+      remaining: Math.floor(bucket.level),
+      limit: capacity,
+    };
+  }
+
+  private consumeLeakyBucket(config: RateLimitConfig, bucket: BucketState, now: number): RateLimitResult {
+    const { capacity, ratePerMs } = this.bucketShape(config);
+    bucket.level = Math.max(0, bucket.level - (now - bucket.updatedAt) * ratePerMs);
+    bucket.updatedAt = now;
+
+    if (bucket.level + 1 > capacity) {
+      return { allowed: false, resetAt: new Date(now + (bucket.level + 1 - capacity) / ratePerMs), remaining: 0, limit: capacity };
+    }
+    bucket.level += 1;
+    return {
+      allowed: true,
+      resetAt: new Date(now + bucket.level / ratePerMs),
+      remaining: Math.floor(capacity - bucket.level),
+      limit: capacity,
+    };
+  }
+
+  private bucketShape(config: RateLimitConfig): { capacity: number; ratePerMs: number } {
+    const capacity = Math.max(1, config.burstSize ?? config.maxRequests);
+    const ratePerSecond = config.refillRate ?? config.maxRequests / Math.max(1, config.windowSize);
+    return { capacity, ratePerMs: Math.max(ratePerSecond, Number.EPSILON) / 1000 };
+  }
+
+  /**
+   * Bucket for a config, restored from the last checkpoint on first use
+   */
+  private getBucket(config: RateLimitConfig, now: number): BucketState {
+    let bucket = this.buckets.get(config.id);
+    if (bucket) return bucket;
+
+    const isBucket = config.strategy === RateLimitStrategy.TokenBucket || config.strategy === RateLimitStrategy.LeakyBucket;
+    bucket = {
+      configId: config.id,
+      requests: 0,
+      previousRequests: 0,
+      windowStart: config.strategy === RateLimitStrategy.FixedWindow ? now : 0,
+      windowMs: config.windowSize * 1000,
+      // A new token bucket starts full, a new leaky bucket empty
+      level: config.strategy === RateLimitStrategy.TokenBucket ? this.bucketShape(config).capacity : 0,
+      updatedAt: now,
+      dirty: false,
+    };
+
+    const row = prepareCached(this.db, 'SELECT requests, reset_at, tokens, last_refill FROM rate_limit_state WHERE config_id = ?')
+      .get(config.id) as RateLimitStateRow | undefined;
+    if (row) {
+      const resetAt = parseStateTime(row.reset_at);
+      const updatedAt = row.last_refill ? parseStateTime(row.last_refill) : NaN;
+      if (isBucket && row.tokens !== null && !Number.isNaN(updatedAt)) {
+        bucket.level = row.tokens;
+        bucket.updatedAt = Math.min(updatedAt, now);
+      } else if (!isBucket && !Number.isNaN(resetAt)) {
+        bucket.requests = row.requests;
+        bucket.windowStart = resetAt - bucket.windowMs;
+      }
+    }
+
+    this.buckets.set(config.id, bucket);
+    return bucket;
+  }
+}
+
+/**
+ * Parse an ISO timestamp or a SQLite datetime() value (UTC without zone)
+ */
+function parseStateTime(value: string): number {
+  return Date.parse(value.includes('T') ? value : `${value.replace(' ', 'T')}Z`);
+}
@@ -0,0 +1,150 @@
+import Database from 'better-sqlite3';
+import {
+  SearchEntityType,
+  SearchOptions,
+  SearchResult,
+  SearchResultPage,
+  SEARCH_ENTITY_TYPES,
+  DEFAULT_SEARCH_LIMIT,
+  MAX_SEARCH_LIMIT,
+  toFtsMatchQuery,
+} from '../models/Search';
+import { prepareCached } from '../database/StatementCache';
+
+interface SearchRow {
+  type: SearchEntityType;
+  id: number;
+  task_id: number | null;
+  project_id: number | null;
+  title: string;
+  snippet: string | null;
+  rank: number;
+  timestamp: string;
+}
+
+// snippet(): highlight hits with [ ], ellipsis for cut text, ~12 tokens
+const SNIPPET_ARGS = `'[', ']', '…', 12`;
+
+/**
+ * SearchService - Ranked full-text search across tasks, comments and audit
+ * logs, backed by the FTS5 indexes created by Database and AuditLogger.
+ *
+ * Each entity type is matched against its own index and the results are
+ * merged by bm25 rank. Task titles and audit entity names are weighted
+ * above free-text bodies.
+ */
+export class SearchService {
+  private hasAuditIndex = false;
+
+  /**
+   * @param db Connection holding the FTS indexes (a reader is fine)
+   * @param flushAudit Called before audit searches so buffered audit entries are found
+   */
+  constructor(private db: Database.Database, private flushAudit?: () => void) {}
+
+  /**
+   * Search, best matches first. Pages are offset-based since rank order
+   * has no stable keyset.
+   */
+  search(options: SearchOptions): SearchResultPage {
+    const match = toFtsMatchQuery(options.query || '');
+    if (!match) {
+      return { results: [], nextOffset: null };
+    }
+
+    const limit = Math.min(Math.max(1, Math.floor(options.limit ?? DEFAULT_SEARCH_LIMIT)), MAX_SEARCH_LIMIT);
+    const offset = Math.max(0, Math.floor(options.offset ?? 0));
+    const types = (options.types && options.types.length > 0 ? options.types : SEARCH_ENTITY_TYPES)
+      .filter(type => SEARCH_ENTITY_TYPES.includes(type));
+    const projectId = options.projectId;
+
+    const selects: string[] = [];
+    const params: any[] = [];
+
+    if (types.includes('task')) {
+      selects.push(`
+        SELECT 'task' AS type, t.id, t.id AS task_id, t.project_id, t.title,
+          snippet(tasks_fts, -1, ${SNIPPET_ARGS}) AS snippet,
+          bm25(tasks_fts, 10.0, 1.0) AS rank,
+          t.updated_at AS timestamp
+        FROM tasks_fts
+        JOIN tasks t ON t.id = tasks_fts.rowid
+        WHERE tasks_fts MATCH ?${projectId ? ' AND t.project_id = ?' : ''}
+      `);
+      params.push(match);
+      if (projectId) params.push(projectId);
+    }
+
+    if (types.includes('comment')) {
+      selects.push(`
+        SELECT 'comment' AS type, c.id, c.task_id, t.project_id, t.title,
+          snippet(comments_fts, 0, ${SNIPPET_ARGS}) AS snippet,
+          bm25(comments_fts) AS rank,
+          c.created_at AS timestamp
+        FROM comments_fts
+        JOIN comments c ON c.id = comments_fts.rowid
+        JOIN tasks t ON t.id = c.task_id
+        WHERE comments_fts MATCH ?${projectId ? ' AND t.project_id = ?' : ''}
+      `);
+      params.push(match);
+      if (projectId) params.push(projectId);
+    }
+
+    // Audit entries are not project-scoped, so a project filter excludes them
+    if (types.includes('audit_log') && !projectId && this.ensureAuditIndex()) {
+      this.flushAudit?.();
+      selects.push(`
+        SELECT 'audit_log' AS type, a.id, NULL AS task_id, NULL AS project_id,
+          COALESCE(a.entity_name, a.action) AS title,
+          snippet(audit_logs_fts, -1, ${SNIPPET_ARGS}) AS snippet,
+          bm25(audit_logs_fts, 1.0, 5.0, 2.0) AS rank,
+          a.timestamp
+        FROM audit_logs_fts
+        JOIN audit_logs a ON a.id = audit_logs_fts.rowid
+        WHERE audit_logs_fts MATCH ?
+      `);
+      params.push(match);
+    }
+
+    if (selects.length === 0) {
+      return { results: [], nextOffset: null };
+    }
+
+    // Fetch one extra row to know whether another page exists
+    const rows = prepareCached(this.db, `
+      ${selects.join(' UNION ALL ')}
+      ORDER BY rank, timestamp DESC
+      LIMIT ? OFFSET ?
+    `).all(...params, limit + 1, offset) as SearchRow[];
+
+    const hasMore = rows.length > limit;
+    const results = rows.slice(0, limit).map(row => this.mapRow(row));
+    return { results, nextOffset: hasMore ? offset + limit : null };
+  }
+
+  /**
+   * audit_logs_fts is created by AuditLogger, which may not exist in every
+   * process (e.g. a standalone API server)
+   */
+  private ensureAuditIndex(): boolean {
+    if (!this.hasAuditIndex) {
+      this.hasAuditIndex = !!prepareCached(this.db, `
+        SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'audit_logs_fts'
+      `).get();
+    }
+    return this.hasAuditIndex;
+  }
+
+  private mapRow(row: SearchRow): SearchResult {
+    return {
+      type: row.type,
+      id: row.id,
+      taskId: row.task_id,
+      projectId: row.project_id,
+      title: row.title,
+      snippet: row.snippet || '',
+      rank: row.rank,
+      timestamp: row.timestamp,
+    };
+  }
+}
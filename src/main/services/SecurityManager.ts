@@ -1,5 +1,4 @@
 import Database from 'better-sqlite3';
-import * as bcrypt from 'bcryptjs';
 import * as crypto from 'crypto';
 import {
   UserCredentials,
@@ -15,13 +14,34 @@ import {
   SecurityEventType,
   DEFAULT_PASSWORD_POLICY,
 } from '../models/Security';
+import { migrateModuleSchema } from '../database/migrations';
+import { prepareCached } from '../database/StatementCache';
+import { PasswordHasher } from './PasswordHasher';
+
+// Bump when initializeTables() changes (see database/migrations.ts)
+const SCHEMA_VERSION = 1;
+
+// Verified API keys are served from memory this long before being re-read;
+// last_used_at is written at most once per key per period
+const API_KEY_CACHE_TTL_MS = 60 * 1000;
 
 /**
  * SecurityManager - Comprehensive security and authentication service
  */
 export class SecurityManager {
+  private hasher = new PasswordHasher();
+  // key_hash -> verified key; dropped on revoke, otherwise re-read after the TTL
+  private verifiedKeys = new Map<string, { apiKey: APIKey; cachedUntil: number }>();
+
   constructor(private db: Database.Database) {
-    this.initializeTables();
+    migrateModuleSchema(db, 'security', SCHEMA_VERSION, () => this.initializeTables());
+  }
+
+  /**
+   * Stop the password hashing worker
+   */
+  close(): void {
+    this.hasher.close();
   }
 
   private initializeTables(): void {
@@ -208,8 +228,7 @@ export class SecurityManager {
     const policy = this.getPasswordPolicy();
     this.validatePassword(password, policy);
 
-    const salt = await bcrypt.genSalt(12);
-    const hash = await bcrypt.hash(password, salt);
+    const { hash, salt } = await this.hasher.hash(password);
     const now = new Date().toISOString();
 
     const existing = this.db
@@ -265,7 +284,7 @@ export class SecurityManager {
       }
     }
 
-    const isValid = await bcrypt.compare(password, creds.password_hash);
+    const isValid = await this.hasher.verify(password, creds.password_hash);
 
     if (!isValid) {
       this.handleFailedLogin(userId);
@@ -277,6 +296,15 @@ export class SecurityManager {
       .prepare('UPDATE user_credentials SET failed_login_attempts = 0 WHERE user_id = ?')
       .run(userId);
 
+    // Move bcrypt hashes from earlier versions to the current scheme while
+    // the plain password is at hand
+    if (this.hasher.needsRehash(creds.password_hash)) {
+      const { hash, salt } = await this.hasher.hash(password);
+      this.db
+        .prepare('UPDATE user_credentials SET password_hash = ?, password_salt = ?, updated_at = ? WHERE user_id = ? AND password_hash = ?')
+        .run(hash, salt, new Date().toISOString(), userId, creds.password_hash);
+    }
+
     return true;
   }
 
@@ -483,21 +511,40 @@ export class SecurityManager {
     return { key, apiKey };
   }
 
+  /**
+   * Resolve an API key to its record, or null if it is unknown, revoked or
+   * expired. Hits are cached for API_KEY_CACHE_TTL_MS, so authenticating a
+   * request normally costs no query.
+   */
   verifyAPIKey(key: string): APIKey | null {
     const keyHash = crypto.createHash('sha256').update(key).digest('hex');
-    const row = this.db
-      .prepare('SELECT * FROM api_keys WHERE key_hash = ? AND is_active = 1')
-      .get(keyHash) as any;
+    const now = Date.now();
+    let cached = this.verifiedKeys.get(keyHash);
+
+    if (!cached || cached.cachedUntil <= now) {
+      const row = prepareCached(this.db, 'SELECT * FROM api_keys WHERE key_hash = ? AND is_active = 1')
+        .get(keyHash) as any;
+      if (!row) {
+        this.verifiedKeys.delete(keyHash);
+        return null;
+      }
 
-    if (!row) {
-      return null;
+      // Once per cache period rather than on every request
+      const lastUsedAt = new Date(now).toISOString();
+      prepareCached(this.db, 'UPDATE api_keys SET last_used_at = ? WHERE id = ?').run(lastUsedAt, row.id);
+
+      cached = { apiKey: { ...this.mapAPIKeyRow(row), lastUsedAt }, cachedUntil: now + API_KEY_CACHE_TTL_MS };
+      this.verifiedKeys.set(keyHash, cached);
     }
 
-    // Update last used
-    this.db
-      .prepare('UPDATE api_keys SET last_used_at = ? WHERE id = ?')
-      .run(new Date().toISOString(), row.id);
+    const { expiresAt } = cached.apiKey;
+    if (expiresAt && Date.parse(expiresAt) <= now) {
+      return null;
+    }
+    return cached.apiKey;
+  }
 
+  private mapAPIKeyRow(row: any): APIKey {
     return {
       id: row.id,
       userId: row.user_id,
@@ -520,6 +567,11 @@ export class SecurityManager {
     this.db
       .prepare('UPDATE api_keys SET is_active = 0, revoked_at = ?, revoked_by = ? WHERE id = ?')
       .run(now, revokedBy, keyId);
+    for (const [keyHash, cached] of this.verifiedKeys) {
+      if (cached.apiKey.id === keyId) {
+        this.verifiedKeys.delete(keyHash);
+      }
+    }
 
     this.logSecurityEvent({
       userId: revokedBy,
@@ -3,8 +3,13 @@ import { ProjectTemplateRepository } from '../repositories/ProjectTemplateReposi
 import { TaskTemplateRepository } from '../repositories/TaskTemplateRepository';
 import { ProjectRepository } from '../repositories/ProjectRepository';
 import { TaskRepository } from '../repositories/TaskRepository';
+import { LabelRepository } from '../repositories/LabelRepository';
+import { TaskDependencyRepository } from '../repositories/TaskDependencyRepository';
+import { insertRows, nextRowId } from '../database/bulkInsert';
+import { prepareCached } from '../database/StatementCache';
 import { Project, ProjectStatus } from '../models/Project';
 import { Task, TaskStatus, TaskPriority } from '../models/Task';
+import { TemplateInstantiation } from '../models/Template';
 
 /**
  * Service for creating projects and tasks from templates
@@ -14,12 +19,16 @@ export class TemplateService {
   private taskTemplateRepo: TaskTemplateRepository;
   private projectRepo: ProjectRepository;
   private taskRepo: TaskRepository;
+  private labelRepo: LabelRepository;
+  private dependencyRepo: TaskDependencyRepository;
 
   constructor(private db: Database.Database) {
     this.projectTemplateRepo = new ProjectTemplateRepository(db);
     this.taskTemplateRepo = new TaskTemplateRepository(db);
     this.projectRepo = new ProjectRepository(db);
     this.taskRepo = new TaskRepository(db);
+    this.labelRepo = new LabelRepository(db);
+    this.dependencyRepo = new TaskDependencyRepository(db);
   }
 
   /**
@@ -30,39 +39,85 @@ export class TemplateService {
     customName?: string,
     customDescription?: string
   ): Project {
-    const template = this.projectTemplateRepo.findByIdWithTasks(templateId);
+    return this.instantiateTemplate(templateId, customName, customDescription).project;
+  }
+
+  /**
+   * Create a project with the template's tasks, labels, task labels and
+   * dependencies in one transaction. Rows go in with multi-row inserts and
+   * pre-assigned ids, so template ids are remapped in memory rather than
+   * read back row by row. No hooks run here: the caller fires automation
+   * and webhooks once for the returned batch.
+   */
+  instantiateTemplate(
+    templateId: number,
+    customName?: string,
+    customDescription?: string
+  ): TemplateInstantiation {
+    const template = this.projectTemplateRepo.findBlueprint(templateId);
     if (!template) {
       throw new Error('Template not found');
     }
 
-    // Create the project
-    const project = this.projectRepo.create({
-      name: customName || template.name,
-      description: customDescription || template.description || undefined,
-      status: ProjectStatus.Active,
-      color: template.color || undefined,
-      icon: template.icon || undefined,
-      conceptWhat: template.conceptWhat || undefined,
-      conceptHow: template.conceptHow || undefined,
-      conceptWhere: template.conceptWhere || undefined,
-      conceptWithWhat: template.conceptWithWhat || undefined,
-      conceptWhen: template.conceptWhen || undefined,
-      conceptWhy: template.conceptWhy || undefined,
-    });
-
-    // Create tasks from template
-    for (const taskTemplate of template.tasks) {
-      this.taskRepo.create({
-        projectId: project.id,
-        title: taskTemplate.title,
-        description: taskTemplate.description || undefined,
-        priority: taskTemplate.priority as TaskPriority,
-        status: TaskStatus.Todo,
-        position: taskTemplate.position,
+    return this.db.transaction((): TemplateInstantiation => {
+      const project = this.projectRepo.create({
+        name: customName || template.name,
+        description: customDescription || template.description || undefined,
+        status: ProjectStatus.Active,
+        color: template.color || undefined,
+        icon: template.icon || undefined,
+        conceptWhat: template.conceptWhat || undefined,
+        conceptHow: template.conceptHow || undefined,
+        conceptWhere: template.conceptWhere || undefined,
+        conceptWithWhat: template.conceptWithWhat || undefined,
+        conceptWhen: template.conceptWhen || undefined,
+        conceptWhy: template.conceptWhy || undefined,
       });
-    }
-
-    return project;
+      const now = new Date().toISOString();
+
+      // Template id -> new row id
+      const labelIds = new Map<number, number>();
+      let nextLabelId = nextRowId(this.db, 'labels');
+      for (const label of template.labels) labelIds.set(label.id, nextLabelId++);
+
+      const taskIds = new Map<number, number>();
+      let nextTaskId = nextRowId(this.db, 'tasks');
+      for (const task of template.tasks) taskIds.set(task.id, nextTaskId++);
+
+      insertRows(this.db, 'labels',
+        ['id', 'project_id', 'name', 'color', 'description', 'created_at'],
+        template.labels.map(label => [labelIds.get(label.id), project.id, label.name, label.color, label.description, now])
+      );
+      insertRows(this.db, 'tasks',
+        ['id', 'project_id', 'title', 'description', 'status', 'priority', 'position', 'created_at', 'updated_at'],
+        template.tasks.map(task => [
+          taskIds.get(task.id), project.id, task.title, task.description,
+          TaskStatus.Todo, task.priority || TaskPriority.Medium, task.position, now, now,
+        ])
+      );
+
+      const links = template.taskLabels
+        .filter(link => taskIds.has(link.taskTemplateId) && labelIds.has(link.templateLabelId))
+        .map(link => [taskIds.get(link.taskTemplateId)!, labelIds.get(link.templateLabelId)!]);
+      insertRows(this.db, 'task_labels', ['task_id', 'label_id'], links, 'IGNORE');
+
+      // Same timestamp format as TaskDependencyRepository.create
+      const { createdAt } = prepareCached(this.db, "SELECT datetime('now') AS createdAt").get() as { createdAt: string };
+      const dependencyCount = insertRows(this.db, 'task_dependencies',
+        ['task_id', 'depends_on_task_id', 'dependency_type', 'created_at'],
+        template.dependencies
+          .filter(dep => taskIds.has(dep.taskTemplateId) && taskIds.has(dep.dependsOnTaskTemplateId))
+          .filter(dep => dep.taskTemplateId !== dep.dependsOnTaskTemplateId)
+          .map(dep => [taskIds.get(dep.taskTemplateId), taskIds.get(dep.dependsOnTaskTemplateId), dep.dependencyType, createdAt]),
+        'IGNORE'
+      );
+
+      const tasks = this.taskRepo.findByProjectId(project.id);
+      const tasksById = new Map(tasks.map(task => [task.id, task]));
+      const labelPairs = links.map(([taskId, labelId]) => ({ task: tasksById.get(taskId)!, labelId }));
+
+      return { project, tasks, labelPairs, dependencyCount };
+    }).immediate();
   }
 
   /**
@@ -104,9 +159,11 @@ export class TemplateService {
     }
 
     const tasks = this.taskRepo.findByProjectId(projectId);
+    const labels = this.labelRepo.findByProjectId(projectId);
+    const taskIds = new Set(tasks.map(task => task.id));
 
-    // Create the template
-    const template = this.projectTemplateRepo.create({
+    // Existing ids serve as keys; createWithContent assigns fresh template ids
+    const template = this.projectTemplateRepo.createWithContent({
       name: templateName,
       description: project.description || undefined,
       icon: project.icon || undefined,
@@ -120,18 +177,34 @@ export class TemplateService {
       conceptWithWhat: project.conceptWithWhat || undefined,
       conceptWhen: project.conceptWhen || undefined,
       conceptWhy: project.conceptWhy || undefined,
-    });
-
-    // Create task templates
-    for (const task of tasks) {
-      this.taskTemplateRepo.create({
-        projectTemplateId: template.id,
+    }, {
+      tasks: tasks.map(task => ({
+        id: task.id,
         title: task.title,
-        description: task.description || undefined,
+        description: task.description,
         priority: task.priority as any, // Type conversion for template priority
+        estimatedHours: null,
         position: task.position,
-      });
-    }
+      })),
+      labels: labels.map(label => ({
+        id: label.id,
+        name: label.name,
+        color: label.color,
+        description: label.description,
+      })),
+      taskLabels: this.taskRepo.getLabelLinksByProjectId(projectId).map(link => ({
+        taskTemplateId: link.taskId,
+        templateLabelId: link.labelId,
+      })),
+      // Cross-project dependencies have no counterpart in the template
+      dependencies: this.dependencyRepo.findByProjectId(projectId)
+        .filter(dep => taskIds.has(dep.dependsOnTaskId))
+        .map(dep => ({
+          taskTemplateId: dep.taskId,
+          dependsOnTaskTemplateId: dep.dependsOnTaskId,
+          dependencyType: dep.dependencyType,
+        })),
+    });
 
     return template.id;
   }
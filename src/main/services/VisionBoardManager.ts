@@ -6,6 +6,11 @@
  */
 
 import Database from 'better-sqlite3';
+import { Writable } from 'stream';
+import { prepareCached } from '../database/StatementCache';
+import { migrateModuleSchema } from '../database/migrations';
+import { ExportResult } from '../models/Export';
+import { StreamExportOptions, writeExport } from '../utils/streamingExport';
 import {
   VisionBoard,
   VisionBoardNode,
@@ -25,6 +30,9 @@ import {
   CreateVisionBoardGroupData,
   UpdateVisionBoardGroupData,
   VisionBoardTemplate,
+  VisionBoardViewport,
+  VisionBoardViewportData,
+  VisionBoardOperation,
   DEFAULT_CANVAS_WIDTH,
   DEFAULT_CANVAS_HEIGHT,
   DEFAULT_GRID_SIZE,
@@ -35,18 +43,72 @@ import {
   DEFAULT_FONT_SIZE,
   DEFAULT_FONT_FAMILY,
   DEFAULT_BORDER_WIDTH,
-  DEFAULT_BORDER_RADIUS
+  DEFAULT_BORDER_RADIUS,
+  VIEWPORT_MARGIN,
+  OP_LOG_COMPACT_MS,
+  OP_LOG_COMPACT_NODES
 } from '../models/VisionBoard';
 
+// Bump when createTables() changes (see database/migrations.ts)
+const SCHEMA_VERSION = 2;
+
+// Merged delta for one node; null once the node is deleted
+type NodeDelta = UpdateVisionBoardNodeData | null;
+
+/**
+ * Bounding box of a node row (NEW or OLD) for the spatial index. Rotated
+ * nodes get a box of radius width + height around their origin, which
+ * contains the rotated rectangle whatever the pivot. The board is a third,
+ * zero-width dimension so a query on one board only visits its nodes.
+ */
+function nodeBoundsSql(row: string): string {
+  return `${nodeBounds(row).join(', ')}, ${row}.board_id, ${row}.board_id`;
+}
+
+/**
+ * min_x, max_x, min_y, max_y expressions of nodeBoundsSql
+ */
+function nodeBounds(row: string): [string, string, string, string] {
+  const reach = `(ABS(${row}.width) + ABS(${row}.height))`;
+  return [
+    `CASE WHEN ${row}.rotation = 0 THEN ${row}.x ELSE ${row}.x - ${reach} END`,
+    `CASE WHEN ${row}.rotation = 0 THEN ${row}.x + ${row}.width ELSE ${row}.x + ${reach} END`,
+    `CASE WHEN ${row}.rotation = 0 THEN ${row}.y ELSE ${row}.y - ${reach} END`,
+    `CASE WHEN ${row}.rotation = 0 THEN ${row}.y + ${row}.height ELSE ${row}.y + ${reach} END`,
+  ];
+}
+
+/**
+ * VisionBoardManager
+ *
+ * Large boards are read by viewport: an R*Tree over node bounds (kept in
+ * sync by triggers) answers which nodes intersect a rectangle. Editor
+ * changes arrive as operation batches, appended to vision_board_ops and
+ * merged per node in memory; compaction folds the merged deltas into the
+ * node rows and truncates the log. Reads of a board compact it first, and
+ * leftover log entries are replayed on startup. Each board's node extent is
+ * cached until a write to its nodes.
+ */
 export class VisionBoardManager {
-  constructor(private db: Database.Database) {
+  private pending = new Map<number, Map<number, NodeDelta>>(); // boardId -> nodeId -> delta
+  private lastOpId = new Map<number, number>(); // boardId -> newest log row merged
+  private compactTimer: NodeJS.Timeout | null = null;
+  private extents = new Map<number, VisionBoardViewport | null>(); // boardId -> bounds of its nodes
+
+  constructor(private db: Database.Database, private compactMs: number = OP_LOG_COMPACT_MS) {
     // Tables will be initialized explicitly after main database initialization
   }
 
   /**
    * Initialize database tables (call this after main database is initialized)
+   * and apply any operation log entries left from the last run
    */
   public initializeTables(): void {
+    migrateModuleSchema(this.db, 'vision_boards', SCHEMA_VERSION, () => this.createTables());
+    this.replayOperationLog();
+  }
+
+  private createTables(): void {
     // Vision boards table
     this.db.exec(`
       CREATE TABLE IF NOT EXISTS vision_boards (
@@ -170,8 +232,93 @@ export class VisionBoardManager {
       CREATE INDEX IF NOT EXISTS idx_vision_board_nodes_board ON vision_board_nodes(board_id);
       CREATE INDEX IF NOT EXISTS idx_vision_board_nodes_task ON vision_board_nodes(task_id);
       CREATE INDEX IF NOT EXISTS idx_vision_board_connections_board ON vision_board_connections(board_id);
+      CREATE INDEX IF NOT EXISTS idx_vision_board_connections_from ON vision_board_connections(from_node_id);
+      CREATE INDEX IF NOT EXISTS idx_vision_board_connections_to ON vision_board_connections(to_node_id);
       CREATE INDEX IF NOT EXISTS idx_vision_board_groups_board ON vision_board_groups(board_id);
     `);
+
+    // Operation log: one row per applied batch, removed by compaction
+    this.db.exec(`
+      CREATE TABLE IF NOT EXISTS vision_board_ops (
+        id INTEGER PRIMARY KEY AUTOINCREMENT,
+        board_id INTEGER NOT NULL,
+        ops TEXT NOT NULL,  -- JSON array of VisionBoardOperation
+        created_at DATETIME NOT NULL DEFAULT CURRENT_TIMESTAMP,
+
+        FOREIGN KEY (board_id) REFERENCES vision_boards(id) ON DELETE CASCADE
+      );
+      CREATE INDEX IF NOT EXISTS idx_vision_board_ops_board ON vision_board_ops(board_id, id);
+    `);
+
+    this.createSpatialIndex();
+  }
+
+  /**
+   * R*Tree of node bounds, maintained by triggers and backfilled when new
+   */
+  private createSpatialIndex(): void {
+    const columns = this.db.prepare("SELECT name FROM pragma_table_info('vision_board_nodes_rtree')").all() as Array<{ name: string }>;
+    let exists = columns.length > 0;
+
+    // Schema 1 kept board_id as an auxiliary column, which can't be searched
+    if (exists && !columns.some(column => column.name === 'min_b')) {
+      this.db.exec(`
+        DROP TRIGGER IF EXISTS trg_vision_board_nodes_rtree_insert;
+        DROP TRIGGER IF EXISTS trg_vision_board_nodes_rtree_update;
+        DROP TRIGGER IF EXISTS trg_vision_board_nodes_rtree_delete;
+        DROP TABLE vision_board_nodes_rtree;
+      `);
+      exists = false;
+    }
+
+    this.db.exec(`
+      CREATE VIRTUAL TABLE IF NOT EXISTS vision_board_nodes_rtree USING rtree(
+        id, min_x, max_x, min_y, max_y, min_b, max_b
+      );
+
+      CREATE TRIGGER IF NOT EXISTS trg_vision_board_nodes_rtree_insert
+      AFTER INSERT ON vision_board_nodes BEGIN
+        INSERT INTO vision_board_nodes_rtree (id, min_x, max_x, min_y, max_y, min_b, max_b)
+        VALUES (NEW.id, ${nodeBoundsSql('NEW')});
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_vision_board_nodes_rtree_update
+      AFTER UPDATE OF x, y, width, height, rotation, board_id ON vision_board_nodes BEGIN
+        INSERT OR REPLACE INTO vision_board_nodes_rtree (id, min_x, max_x, min_y, max_y, min_b, max_b)
+        VALUES (NEW.id, ${nodeBoundsSql('NEW')});
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS trg_vision_board_nodes_rtree_delete
+      AFTER DELETE ON vision_board_nodes BEGIN
+        DELETE FROM vision_board_nodes_rtree WHERE id = OLD.id;
+      END;
+    `);
+
+    if (!exists) {
+      this.db.exec(`
+        INSERT INTO vision_board_nodes_rtree (id, min_x, max_x, min_y, max_y, min_b, max_b)
+        SELECT n.id, ${nodeBoundsSql('n')} FROM vision_board_nodes n
+      `);
+    }
+  }
+
+  /**
+   * Apply log entries left by an unclean shutdown
+   */
+  private replayOperationLog(): void {
+    const rows = this.db.prepare('SELECT id, board_id, ops FROM vision_board_ops ORDER BY id').all() as Array<{
+      id: number;
+      board_id: number;
+      ops: string;
+    }>;
+    if (rows.length === 0) return;
+
+    for (const row of rows) {
+      this.mergeOperations(row.board_id, JSON.parse(row.ops));
+      this.lastOpId.set(row.board_id, row.id);
+    }
+    this.compact();
+    console.log(`[VisionBoardManager] Replayed ${rows.length} operation log entries`);
   }
 
   // ==================== Vision Boards ====================
@@ -402,8 +549,10 @@ export class VisionBoardManager {
    * Delete vision board
    */
   deleteBoard(id: number): boolean {
+    this.settle(id);
     const stmt = this.db.prepare('DELETE FROM vision_boards WHERE id = ?');
     const result = stmt.run(id);
+    this.extents.delete(id);
     return result.changes > 0;
   }
 
@@ -541,6 +690,7 @@ export class VisionBoardManager {
       data.metadata ? JSON.stringify(data.metadata) : null
     );
 
+    this.extents.delete(data.boardId);
     return this.getNodeById(result.lastInsertRowid as number)!;
   }
 
@@ -548,6 +698,7 @@ export class VisionBoardManager {
    * Get node by ID
    */
   getNodeById(id: number): VisionBoardNode | null {
+    this.settle();
     const stmt = this.db.prepare('SELECT * FROM vision_board_nodes WHERE id = ?');
     const row = stmt.get(id);
     return row ? this.mapRowToNode(row) : null;
@@ -557,6 +708,7 @@ export class VisionBoardManager {
    * Get all nodes for a board
    */
   getNodesByBoard(boardId: number): VisionBoardNode[] {
+    this.settle(boardId);
     const stmt = this.db.prepare('SELECT * FROM vision_board_nodes WHERE board_id = ? ORDER BY z_index ASC');
     const rows = stmt.all(boardId);
     return rows.map(row => this.mapRowToNode(row));
@@ -566,6 +718,24 @@ export class VisionBoardManager {
    * Update node
    */
   updateNode(id: number, data: UpdateVisionBoardNodeData): VisionBoardNode | null {
+    this.settle();
+    const { updates, params } = this.nodeUpdateColumns(data);
+
+    if (updates.length === 0) {
+      return this.getNodeById(id);
+    }
+
+    updates.push('updated_at = CURRENT_TIMESTAMP');
+    params.push(id);
+
+    const stmt = this.db.prepare(`UPDATE vision_board_nodes SET ${updates.join(', ')} WHERE id = ?`);
+    stmt.run(...params);
+    this.extents.clear();
+
+    return this.getNodeById(id);
+  }
+
+  private nodeUpdateColumns(data: UpdateVisionBoardNodeData): { updates: string[]; params: any[] } {
     const updates: string[] = [];
     const params: any[] = [];
 
@@ -595,41 +765,187 @@ export class VisionBoardManager {
     if (data.taskId !== undefined) { updates.push('task_id = ?'); params.push(data.taskId); }
     if (data.metadata !== undefined) { updates.push('metadata = ?'); params.push(JSON.stringify(data.metadata)); }
 
-    if (updates.length === 0) {
-      return this.getNodeById(id);
-    }
-
-    updates.push('updated_at = CURRENT_TIMESTAMP');
-    params.push(id);
-
-    const stmt = this.db.prepare(`UPDATE vision_board_nodes SET ${updates.join(', ')} WHERE id = ?`);
-    stmt.run(...params);
-
-    return this.getNodeById(id);
+    return { updates, params };
   }
 
   /**
    * Delete node
    */
   deleteNode(id: number): boolean {
+    this.settle();
     const stmt = this.db.prepare('DELETE FROM vision_board_nodes WHERE id = ?');
     const result = stmt.run(id);
+    this.extents.clear();
     return result.changes > 0;
   }
 
   /**
-   * Bulk update node positions
+   * Bulk update node positions. `updates` may be a coalesced drag stream
+   * listing a node more than once; only its last position is written.
    */
   bulkUpdateNodePositions(updates: Array<{ id: number; x: number; y: number }>): void {
-    const stmt = this.db.prepare('UPDATE vision_board_nodes SET x = ?, y = ?, updated_at = CURRENT_TIMESTAMP WHERE id = ?');
-    
+    this.settle();
+    const latest = new Map<number, { x: number; y: number }>();
+    for (const update of updates) {
+      latest.set(update.id, { x: update.x, y: update.y });
+    }
+
+    const stmt = prepareCached(this.db, 'UPDATE vision_board_nodes SET x = ?, y = ?, updated_at = CURRENT_TIMESTAMP WHERE id = ?');
     const transaction = this.db.transaction(() => {
-      for (const update of updates) {
-        stmt.run(update.x, update.y, update.id);
+      for (const [id, position] of latest) {
+        stmt.run(position.x, position.y, id);
       }
     });
-    
+
     transaction();
+    this.extents.clear();
+  }
+
+  // ==================== Operation Log ====================
+
+  /**
+   * Apply a batch of node deltas to a board. The batch is appended to the
+   * log in one insert and merged in memory; node rows are rewritten by the
+   * next compaction, one UPDATE per changed node however many deltas it got.
+   * Returns the number of nodes with pending changes on the board.
+   */
+  applyOperations(boardId: number, ops: VisionBoardOperation[]): number {
+    if (!Array.isArray(ops)) {
+      throw new Error('Operations must be an array');
+    }
+    for (const op of ops) {
+      if (!op || !Number.isInteger(op.nodeId) || !['move', 'update', 'delete'].includes(op.type)) {
+        throw new Error('Invalid vision board operation');
+      }
+      if (op.type === 'move' && (!Number.isFinite(op.x) || !Number.isFinite(op.y))) {
+        throw new Error('Invalid vision board move');
+      }
+    }
+    if (ops.length === 0) return this.pending.get(boardId)?.size ?? 0;
+
+    const result = prepareCached(this.db, 'INSERT INTO vision_board_ops (board_id, ops) VALUES (?, ?)')
+      .run(boardId, JSON.stringify(ops));
+    this.lastOpId.set(boardId, result.lastInsertRowid as number);
+    const pendingNodes = this.mergeOperations(boardId, ops);
+
+    if (pendingNodes >= OP_LOG_COMPACT_NODES) {
+      this.compact(boardId);
+      return 0;
+    }
+    this.scheduleCompaction();
+    return pendingNodes;
+  }
+
+  /**
+   * Fold pending deltas into the node rows and truncate the log, for one
+   * board or all of them
+   */
+  compact(boardId?: number): void {
+    const boardIds = boardId !== undefined ? [boardId] : Array.from(this.pending.keys());
+    if (boardIds.length === 0) return;
+
+    const deleteNode = prepareCached(this.db, 'DELETE FROM vision_board_nodes WHERE id = ? AND board_id = ?');
+    const truncate = prepareCached(this.db, 'DELETE FROM vision_board_ops WHERE board_id = ? AND id <= ?');
+    const touchBoard = prepareCached(this.db, 'UPDATE vision_boards SET updated_at = CURRENT_TIMESTAMP WHERE id = ?');
+
+    this.db.transaction(() => {
+      for (const id of boardIds) {
+        const deltas = this.pending.get(id);
+        if (deltas) {
+          for (const [nodeId, delta] of deltas) {
+            if (delta === null) {
+              deleteNode.run(nodeId, id);
+              continue;
+            }
+            const { updates, params } = this.nodeUpdateColumns(delta);
+            if (updates.length === 0) continue;
+            // Column sets repeat (a drag is always x, y), so the cache stays small
+            prepareCached(this.db, `
+              UPDATE vision_board_nodes SET ${updates.join(', ')}, updated_at = CURRENT_TIMESTAMP
+              WHERE id = ? AND board_id = ?
+            `).run(...params, nodeId, id);
+          }
+          touchBoard.run(id);
+        }
+        const lastOpId = this.lastOpId.get(id);
+        if (lastOpId !== undefined) truncate.run(id, lastOpId);
+      }
+    })();
+
+    for (const id of boardIds) {
+      if (this.pending.has(id)) this.extents.delete(id);
+      this.pending.delete(id);
+      this.lastOpId.delete(id);
+    }
+  }
+
+  /**
+   * Compact everything and stop the compaction timer
+   */
+  close(): void {
+    if (this.compactTimer) {
+      clearTimeout(this.compactTimer);
+      this.compactTimer = null;
+    }
+    try {
+      this.compact();
+    } catch (error) {
+      console.error('[VisionBoardManager] Final compaction failed:', error);
+    }
+  }
+
+  /**
+   * Merge operations into the board's pending deltas; returns how many
+   * nodes have pending changes
+   */
+  private mergeOperations(boardId: number, ops: VisionBoardOperation[]): number {
+    let deltas = this.pending.get(boardId);
+    if (!deltas) {
+      deltas = new Map();
+      this.pending.set(boardId, deltas);
+    }
+
+    for (const op of ops) {
+      const current = deltas.get(op.nodeId);
+      if (current === null) continue; // deleted; later deltas are moot
+      switch (op.type) {
+        case 'move':
+          deltas.set(op.nodeId, { ...current, x: op.x, y: op.y });
+          break;
+        case 'update':
+          deltas.set(op.nodeId, { ...current, ...op.changes });
+          break;
+        case 'delete':
+          deltas.set(op.nodeId, null);
+          break;
+      }
+    }
+    return deltas.size;
+  }
+
+  private scheduleCompaction(): void {
+    if (this.compactTimer) return;
+    this.compactTimer = setTimeout(() => {
+      this.compactTimer = null;
+      try {
+        this.compact();
+      } catch (error) {
+        console.error('[VisionBoardManager] Compaction failed:', error);
+      }
+    }, this.compactMs);
+    this.compactTimer.unref();
+  }
+
+  /**
+   * Make rows current before reading or writing them directly
+   */
+  private settle(boardId?: number): void {
+    if (this.pending.size === 0) return;
+    if (boardId === undefined) {
+      this.compact();
+    } else if (this.pending.has(boardId)) {
+      this.compact(boardId);
+    }
   }
 
   // ==================== Connections ====================
@@ -672,6 +988,7 @@ export class VisionBoardManager {
    * Get all connections for a board
    */
   getConnectionsByBoard(boardId: number): VisionBoardConnection[] {
+    this.settle(boardId);
     const stmt = this.db.prepare('SELECT * FROM vision_board_connections WHERE board_id = ?');
     const rows = stmt.all(boardId);
     return rows.map(row => this.mapRowToConnection(row));
@@ -812,12 +1129,124 @@ export class VisionBoardManager {
   }
 
   /**
-   * Export board to JSON
+   * Get the part of a board around `viewport`: nodes intersecting it plus
+   * `margin` of its size on each side, the connections touching those
+   * nodes, and the board's groups
+   */
+  getBoardViewport(boardId: number, viewport: VisionBoardViewport, margin: number = VIEWPORT_MARGIN): VisionBoardViewportData | null {
+    this.settle(boardId);
+    const board = this.getBoardById(boardId);
+    if (!board) return null;
+
+    const region: VisionBoardViewport = {
+      x: viewport.x - viewport.width * margin,
+      y: viewport.y - viewport.height * margin,
+      width: viewport.width * (1 + 2 * margin),
+      height: viewport.height * (1 + 2 * margin),
+    };
+
+    // R*Tree bounds are float32, so the exact board check stays on the row
+    const rows = prepareCached(this.db, `
+      SELECT n.* FROM vision_board_nodes_rtree r
+      JOIN vision_board_nodes n ON n.id = r.id
+      WHERE r.max_x >= ? AND r.min_x <= ? AND r.max_y >= ? AND r.min_y <= ?
+        AND r.min_b <= ? AND r.max_b >= ?
+        AND n.board_id = ?
+      ORDER BY n.z_index ASC
+    `).all(region.x, region.x + region.width, region.y, region.y + region.height, boardId, boardId, boardId);
+    const nodes = rows.map(row => this.mapRowToNode(row));
+
+    const nodeIds = JSON.stringify(nodes.map(node => node.id));
+    const connections = nodes.length === 0 ? [] : prepareCached(this.db, `
+      SELECT * FROM vision_board_connections
+      WHERE from_node_id IN (SELECT value FROM json_each(?))
+      UNION
+      SELECT * FROM vision_board_connections
+      WHERE to_node_id IN (SELECT value FROM json_each(?))
+    `).all(nodeIds, nodeIds).map(row => this.mapRowToConnection(row));
+
+    return {
+      board,
+      region,
+      extent: this.getBoardExtent(boardId),
+      nodes,
+      connections,
+      groups: this.getGroupsByBoard(boardId),
+    };
+  }
+  /**
+   * Bounds of every node on a board, computed exactly from the board's own
+   * rows (R*Tree bounds are rounded outward) and cached until a node write
+   */
+  private getBoardExtent(boardId: number): VisionBoardViewport | null {
+    const cached = this.extents.get(boardId);
+    if (cached !== undefined) return cached;
+
+    const [minX, maxX, minY, maxY] = nodeBounds('n');
+    const row = prepareCached(this.db, `
+      SELECT MIN(${minX}) AS min_x, MAX(${maxX}) AS max_x, MIN(${minY}) AS min_y, MAX(${maxY}) AS max_y
+      FROM vision_board_nodes n WHERE n.board_id = ?
+    `).get(boardId) as { min_x: number | null; max_x: number; min_y: number; max_y: number };
+
+    const extent = row.min_x === null ? null : {
+      x: row.min_x,
+      y: row.min_y,
+      width: row.max_x - row.min_x,
+      height: row.max_y - row.min_y,
+    };
+    this.extents.set(boardId, extent);
+    return extent;
+  }
+
+  /**
+   * Export board to JSON. Compact output: boards with thousands of nodes
+   * would otherwise spend much of the file on indentation.
    */
   exportBoardToJSON(boardId: number): string | null {
     const data = this.getBoardData(boardId);
     if (!data) return null;
-    return JSON.stringify(data, null, 2);
+    return JSON.stringify(data);
+  }
+
+  /**
+   * Stream a board in the exportBoardToJSON() format to `destination`,
+   * reading nodes, connections and groups row by row through `conn` (see
+   * openExportConnection). Resolves with null if the board does not exist.
+   */
+  async exportBoardStream(
+    conn: Database.Database,
+    boardId: number,
+    destination: Writable,
+    options: StreamExportOptions
+  ): Promise<ExportResult | null> {
+    // Pending edits are written through this.db; conn only sees committed rows
+    this.settle(boardId);
+    const board = this.getBoardById(boardId);
+    if (!board) return null;
+
+    return writeExport(destination, options, async writer => {
+      conn.exec('BEGIN');
+      try {
+        await writer.write(`{"board":${JSON.stringify(board)},"nodes":`);
+        await writer.jsonArray(
+          conn.prepare('SELECT * FROM vision_board_nodes WHERE board_id = ? ORDER BY z_index ASC').iterate(boardId),
+          row => this.mapRowToNode(row)
+        );
+        await writer.write(',"connections":');
+        await writer.jsonArray(
+          conn.prepare('SELECT * FROM vision_board_connections WHERE board_id = ?').iterate(boardId),
+          row => this.mapRowToConnection(row)
+        );
+        await writer.write(',"groups":');
+        await writer.jsonArray(
+          conn.prepare('SELECT * FROM vision_board_groups WHERE board_id = ?').iterate(boardId),
+          row => this.mapRowToGroup(row)
+        );
+        await writer.write('}');
+      } finally {
+        if (conn.inTransaction) conn.exec('COMMIT');
+      }
+    });
   }
 
   /**
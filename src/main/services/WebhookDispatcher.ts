@@ -0,0 +1,375 @@
+import Database from 'better-sqlite3';
+import * as crypto from 'crypto';
+import * as http from 'http';
+import * as https from 'https';
+import { prepareCached } from '../database/StatementCache';
+import { IntegrationManager } from './IntegrationManager';
+import {
+  Webhook,
+  WebhookDelivery,
+  WebhookEvent,
+  WebhookQueueSettings,
+  WebhookQueueStats,
+  DEFAULT_WEBHOOK_QUEUE_SETTINGS,
+} from '../models/Integration';
+
+interface QueueRow {
+  id: number;
+  webhook_id: number;
+  event: WebhookEvent;
+  payload: string;
+  attempt: number;
+}
+
+interface AttemptResult {
+  row: QueueRow;
+  status: number; // 0 when no response was received
+  duration: number;
+  response: string | null;
+  error: string | null;
+}
+
+// Rows read per scan of the queue; the rest are picked up by the next one
+const SCAN_LIMIT = 500;
+// Response bodies are kept for debugging, not in full
+const MAX_RESPONSE_LENGTH = 1000;
+
+/**
+ * WebhookDispatcher - Persistent outbound webhook queue.
+ *
+ * publish() only looks up subscribers in IntegrationManager's in-memory
+ * index and inserts queue rows, so the mutation that raised the event
+ * never waits on the network. A worker drains the queue in the background:
+ *
+ * - due deliveries are claimed in batches per endpoint, at most
+ *   maxConcurrentPerEndpoint requests in flight for any one webhook;
+ * - requests reuse keep-alive agents per origin;
+ * - a batch's outcomes are recorded in one transaction;
+ * - failures are retried up to the webhook's retryAttempts with
+ *   exponential backoff (retryDelay * 2^n, capped) and jitter.
+ *
+ * Queue rows survive restarts, so delivery is at least once.
+ */
+export class WebhookDispatcher {
+  private settings: WebhookQueueSettings;
+  private agents = new Map<string, http.Agent>();
+  private busy = new Set<number>(); // webhooks with a batch in flight
+  private inFlight = 0;
+  private timer: NodeJS.Timeout | null = null;
+  private scanning = false;
+  private closed = false;
+  private delivered = 0;
+  private failed = 0;
+  private dropped = 0;
+
+  constructor(
+    private db: Database.Database,
+    private integrations: IntegrationManager,
+    settings?: Partial<WebhookQueueSettings>
+  ) {
+    this.settings = { ...DEFAULT_WEBHOOK_QUEUE_SETTINGS, ...settings };
+    // Deliveries left over from the last run are due now
+    this.schedule(0);
+  }
+
+  /**
+   * Queue `event` for every subscribed webhook. Returns the number of
+   * deliveries queued.
+   */
+  publish(event: WebhookEvent, data: Record<string, any>): number {
+    return this.publishMany([{ event, data }]);
+  }
+
+  /**
+   * Queue a batch of events (e.g. one per task of a bulk update) in a single
+   * transaction. Returns the number of deliveries queued.
+   */
+  publishMany(events: { event: WebhookEvent; data: Record<string, any> }[]): number {
+    if (this.closed) return 0;
+    const subscribers = new Map<WebhookEvent, Webhook[]>();
+    for (const { event } of events) {
+      if (!subscribers.has(event)) {
+        subscribers.set(event, this.integrations.hasWebhookSubscribers(event)
+          ? this.integrations.getWebhooksByEvent(event)
+          : []);
+      }
+    }
+    if (!Array.from(subscribers.values()).some(webhooks => webhooks.length > 0)) return 0;
+
+    const timestamp = new Date().toISOString();
+    const now = Date.now();
+    const insert = prepareCached(this.db, `
+      INSERT INTO webhook_queue (webhook_id, event, payload, attempt, next_attempt_at)
+      VALUES (?, ?, ?, 1, ?)
+    `);
+    let queued = 0;
+    this.db.transaction(() => {
+      for (const { event, data } of events) {
+        const webhooks = subscribers.get(event)!;
+        if (webhooks.length === 0) continue;
+        // The body is fixed at publish time so retries send identical payloads
+        const payload = JSON.stringify({ event, timestamp, data });
+        for (const webhook of webhooks) {
+          insert.run(webhook.id, event, payload, now);
+        }
+        queued += webhooks.length;
+      }
+    })();
+
+    this.schedule(0);
+    return queued;
+  }
+
+  /**
+   * Whether publishing `event` would queue anything
+   */
+  hasSubscribers(event: WebhookEvent): boolean {
+    return this.integrations.hasWebhookSubscribers(event);
+  }
+
+  getStats(): WebhookQueueStats {
+    const row = prepareCached(this.db, `
+      SELECT COUNT(*) AS queued, COALESCE(SUM(CASE WHEN next_attempt_at <= ? THEN 1 ELSE 0 END), 0) AS due
+      FROM webhook_queue
+    `).get(Date.now()) as { queued: number; due: number };
+    return {
+      queued: row.queued,
+      due: row.due,
+      inFlight: this.inFlight,
+      delivered: this.delivered,
+      failed: this.failed,
+      dropped: this.dropped,
+    };
+  }
+
+  /**
+   * Stop claiming deliveries and close idle connections. Requests already
+   * in flight finish; anything unsent stays queued for the next run.
+   */
+  close(): void {
+    this.closed = true;
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    for (const agent of this.agents.values()) {
+      agent.destroy();
+    }
+    this.agents.clear();
+  }
+
+  private schedule(delayMs: number): void {
+    if (this.closed) return;
+    if (this.timer) {
+      if (delayMs > 0) return; // a scan is already pending
+      clearTimeout(this.timer);
+    }
+    this.timer = setTimeout(() => {
+      this.timer = null;
+      this.scan();
+    }, delayMs);
+    this.timer.unref();
+  }
+
+  /**
+   * Claim due deliveries for every idle endpoint and start their batches
+   */
+  private scan(): void {
+    if (this.closed || this.scanning) return;
+    this.scanning = true;
+    try {
+      const rows = prepareCached(this.db, `
+        SELECT id, webhook_id, event, payload, attempt FROM webhook_queue
+        WHERE next_attempt_at <= ?
+        ORDER BY next_attempt_at, id
+        LIMIT ?
+      `).all(Date.now(), SCAN_LIMIT) as QueueRow[];
+
+      const batches = new Map<number, QueueRow[]>();
+      for (const row of rows) {
+        if (this.busy.has(row.webhook_id)) continue;
+        const batch = batches.get(row.webhook_id) ?? [];
+        if (batch.length < this.settings.batchSize) batch.push(row);
+        batches.set(row.webhook_id, batch);
+      }
+
+      for (const [webhookId, batch] of batches) {
+        this.busy.add(webhookId);
+        this.deliverBatch(webhookId, batch)
+          .catch(error => console.error('[WebhookDispatcher] Batch failed:', error))
+          .finally(() => {
+            this.busy.delete(webhookId);
+            this.schedule(0);
+          });
+      }
+      // Wake up for the next retry; nothing polls an empty queue
+      const next = prepareCached(this.db, 'SELECT MIN(next_attempt_at) AS at FROM webhook_queue')
+        .get() as { at: number | null };
+      if (next.at !== null) {
+        this.schedule(Math.max(this.settings.pollMs, next.at - Date.now()));
+      }
+    } catch (error) {
+      console.error('[WebhookDispatcher] Queue scan failed:', error);
+      this.schedule(this.settings.pollMs);
+    } finally {
+      this.scanning = false;
+    }
+  }
+
+  private async deliverBatch(webhookId: number, rows: QueueRow[]): Promise<void> {
+    const webhook = this.integrations.getWebhook(webhookId);
+    if (!webhook || !webhook.active) {
+      this.deleteRows(rows.map(row => row.id));
+      return;
+    }
+
+    // Up to maxConcurrentPerEndpoint lanes pull from the batch in order
+    const results: AttemptResult[] = [];
+    let next = 0;
+    const lane = async () => {
+      while (next < rows.length && !this.closed) {
+        const row = rows[next++];
+        results.push(await this.send(webhook, row));
+      }
+    };
+    const lanes = Math.max(1, Math.min(this.settings.maxConcurrentPerEndpoint, rows.length));
+    await Promise.all(Array.from({ length: lanes }, lane));
+
+    // After close() the database may be gone; unrecorded rows are resent next run
+    if (!this.closed) this.recordResults(webhook, results);
+  }
+
+  private recordResults(webhook: Webhook, results: AttemptResult[]): void {
+    if (results.length === 0) return;
+
+    const now = Date.now();
+    const done: number[] = [];
+    const retry = prepareCached(this.db, `
+      UPDATE webhook_queue SET attempt = attempt + 1, next_attempt_at = ?, last_error = ? WHERE id = ?
+    `);
+    const deliveries: Array<Omit<WebhookDelivery, 'id' | 'deliveredAt'>> = [];
+
+    this.db.transaction(() => {
+      for (const result of results) {
+        const ok = result.status >= 200 && result.status < 300;
+        deliveries.push({
+          webhookId: webhook.id,
+          event: result.row.event,
+          payload: JSON.parse(result.row.payload),
+          status: result.status,
+          duration: result.duration,
+          attempt: result.row.attempt,
+          response: result.response,
+          error: result.error,
+        });
+
+        if (ok) {
+          this.delivered++;
+          done.push(result.row.id);
+        } else if (result.row.attempt > webhook.retryAttempts) {
+          this.failed++;
+          this.dropped++;
+          done.push(result.row.id);
+        } else {
+          this.failed++;
+          retry.run(now + this.backoffMs(webhook, result.row.attempt), result.error, result.row.id);
+        }
+      }
+      this.deleteRows(done);
+      this.integrations.recordWebhookDeliveries(deliveries);
+    })();
+  }
+
+  /**
+   * retryDelay * 2^(attempt - 1), capped, with the upper half jittered so
+   * endpoints recovering from an outage are not hit in lockstep
+   */
+  private backoffMs(webhook: Webhook, attempt: number): number {
+    const base = Math.max(1, webhook.retryDelay) * 1000 * Math.pow(2, attempt - 1);
+    const capped = Math.min(base, this.settings.maxBackoffSeconds * 1000);
+    return capped / 2 + Math.random() * (capped / 2);
+  }
+
+  private deleteRows(ids: number[]): void {
+    if (ids.length === 0) return;
+    prepareCached(this.db, 'DELETE FROM webhook_queue WHERE id IN (SELECT value FROM json_each(?))')
+      .run(JSON.stringify(ids));
+  }
+
+  private send(webhook: Webhook, row: QueueRow): Promise<AttemptResult> {
+    const started = Date.now();
+    this.inFlight++;
+
+    return new Promise<AttemptResult>(resolve => {
+      let settled = false;
+      const finish = (status: number, response: string | null, error: string | null) => {
+        if (settled) return;
+        settled = true;
+        this.inFlight--;
+        resolve({ row, status, duration: Date.now() - started, response, error });
+      };
+
+      let url: URL;
+      try {
+        url = new URL(webhook.url);
+      } catch {
+        finish(0, null, `Invalid webhook URL: ${webhook.url}`);
+        return;
+      }
+
+      const body = Buffer.from(row.payload);
+      const headers: Record<string, string> = {
+        ...(webhook.headers ?? {}),
+        'Content-Type': 'application/json',
+        'Content-Length': String(body.length),
+        'User-Agent': 'DevTrack-Webhooks/1.0',
+        'X-DevTrack-Event': row.event,
+        'X-DevTrack-Delivery': String(row.id),
+        'X-DevTrack-Attempt': String(row.attempt),
+      };
+      if (webhook.secret) {
+        headers['X-DevTrack-Signature'] =
+          'sha256=' + crypto.createHmac('sha256', webhook.secret).update(body).digest('hex');
+      }
+
+      const transport = url.protocol === 'https:' ? https : http;
+      const request = transport.request(url, {
+        method: 'POST',
+        headers,
+        agent: this.agentFor(url),
+        timeout: webhook.timeout * 1000,
+      }, response => {
+        const chunks: Buffer[] = [];
+        let length = 0;
+        response.on('data', (chunk: Buffer) => {
+          // Drain the whole body so the socket can be reused
+          if (length < MAX_RESPONSE_LENGTH) chunks.push(chunk);
+          length += chunk.length;
+        });
+        response.on('end', () => {
+          const text = Buffer.concat(chunks).toString('utf8').slice(0, MAX_RESPONSE_LENGTH);
+          const status = response.statusCode ?? 0;
+          finish(status, text || null, status >= 200 && status < 300 ? null : `HTTP ${status}`);
+        });
+        response.on('error', error => finish(response.statusCode ?? 0, null, error.message));
+      });
+
+      request.on('timeout', () => request.destroy(new Error(`Timed out after ${webhook.timeout}s`)));
+      request.on('error', error => finish(0, null, error.message));
+      request.end(body);
+    });
+  }
+
+  /**
+   * One keep-alive agent per origin, sized to the per-endpoint limit
+   */
+  private agentFor(url: URL): http.Agent {
+    let agent = this.agents.get(url.origin);
+    if (!agent) {
+      const options = { keepAlive: true, maxSockets: this.settings.maxConcurrentPerEndpoint };
+      agent = url.protocol === 'https:' ? new https.Agent(options) : new http.Agent(options);
+      this.agents.set(url.origin, agent);
+    }
+    return agent;
+  }
+}
@@ -35,10 +35,14 @@ import {
   EMAIL_TEMPLATE_VARIABLES,
   DEFAULT_EMAIL_TEMPLATES
 } from '../models/WhiteLabel';
+import { migrateModuleSchema } from '../database/migrations';
+
+// Bump when initializeTables() changes (see database/migrations.ts)
+const SCHEMA_VERSION = 1;
 
 export class WhiteLabelManager {
   constructor(private db: Database.Database) {
-    this.initializeTables();
+    migrateModuleSchema(db, 'white_label', SCHEMA_VERSION, () => this.initializeTables());
   }
 
   // ==================== Database Initialization ====================
@@ -0,0 +1,35 @@
+/**
+ * passwordWorker.ts
+ *
+ * worker_threads entry point for PasswordHasher. Verifies bcrypt hashes
+ * from before the switch to scrypt; bcryptjs is pure JavaScript, so a
+ * cost-12 comparison would otherwise hold the main thread for the whole run.
+ */
+
+import { parentPort } from 'worker_threads';
+import * as bcrypt from 'bcryptjs';
+
+export interface PasswordWorkerJob {
+  id: number;
+  password: string;
+  hash: string;
+}
+
+export interface PasswordWorkerReply {
+  id: number;
+  valid?: boolean;
+  error?: string;
+}
+
+if (parentPort) {
+  const port = parentPort;
+
+  port.on('message', (job: PasswordWorkerJob) => {
+    try {
+      const valid = bcrypt.compareSync(job.password, job.hash);
+      port.postMessage({ id: job.id, valid } as PasswordWorkerReply);
+    } catch (error) {
+      port.postMessage({ id: job.id, error: error instanceof Error ? error.message : String(error) } as PasswordWorkerReply);
+    }
+  });
+}
@@ -7,10 +7,23 @@
  * NOT FOR PRODUCTION - Personal development tool
  */
 
+import { promises as fsp } from 'fs';
 import * as fs from 'fs';
+import * as os from 'os';
 import * as path from 'path';
+import { Worker } from 'worker_threads';
 import Database from 'better-sqlite3';
 import { ProjectStatus, CreateProjectData } from '../models/Project';
+import {
+  computeDirectoryStats,
+  hasAtLeastFiles,
+  mapWithConcurrency,
+  DirCacheEntry,
+  DirectoryStatsResult,
+  DEFAULT_FS_CONCURRENCY,
+  formatBytes,
+} from './directoryStats';
+import type { ScanWorkerData, ScanWorkerJob, ScanWorkerReply } from './scanWorker';
 
 export interface ScanOptions {
   basePath: string;
@@ -19,6 +32,9 @@ export interface ScanOptions {
   fileTypesFilter?: string[]; // e.g., ['.js', '.ts', '.md']
   excludeDirs?: string[]; // e.g., ['node_modules', '.git']
   detectProjectType?: boolean; // Detect by package.json, Cargo.toml, etc.
+  workers?: number; // Worker threads for size/file-count walks (0 = in-process)
+  concurrency?: number; // Concurrent fs operations per walker
+  useCache?: boolean; // Reuse per-directory totals whose mtime is unchanged
 }
 
 export interface ScannedProject {
@@ -34,65 +50,126 @@ export interface ScannedProject {
   readmeContent?: string;
 }
 
+/**
+ * Walk counters from the last scan, for progress/diagnostics output
+ */
+export interface ScanStats {
+  dirsRead: number;
+  dirsReused: number;
+  workers: number;
+}
+
+type ProjectCandidate = Omit<ScannedProject, 'size' | 'fileCount'>;
+
+const WORKER_SCRIPT = path.join(__dirname, 'scanWorker.js');
+
 export class DirectoryScanner {
-  constructor(private db: Database.Database) {}
+  private lastScanStats: ScanStats = { dirsRead: 0, dirsReused: 0, workers: 0 };
+
+  constructor(private db: Database.Database) {
+    this.db.exec(`
+      CREATE TABLE IF NOT EXISTS directory_scan_cache (
+        path TEXT PRIMARY KEY,
+        mtime_ms REAL NOT NULL,
+        size INTEGER NOT NULL,
+        file_count INTEGER NOT NULL,
+        subdirs TEXT NOT NULL
+      )
+    `);
+  }
 
   /**
    * Scan a directory and return potential projects
    */
   async scanDirectory(options: ScanOptions): Promise<ScannedProject[]> {
     const {
-      basePath,
       maxDepth = 3,
       includeHidden = false,
       excludeDirs = ['node_modules', '.git', 'dist', 'build', 'target', '__pycache__', '.venv', 'venv'],
       detectProjectType = true,
+      workers = Math.max(1, Math.min(4, os.cpus().length - 1)),
+      concurrency = DEFAULT_FS_CONCURRENCY,
+      useCache = true,
     } = options;
+    // Cache keys are absolute; resolve once so relative paths (e.g. scan-projects --path) hit them
+    const basePath = path.resolve(options.basePath);
 
-    const projects: ScannedProject[] = [];
-
-    const scanRecursive = (currentPath: string, depth: number): void => {
-      if (depth > maxDepth) return;
+    // Pass 1: find project directories (cheap: only top-level listings).
+    // Walked one depth at a time so `concurrency` bounds open handles
+    // however wide the tree is.
+    const candidates: ProjectCandidate[] = [];
+    let frontier = [basePath];
 
-      try {
-        const entries = fs.readdirSync(currentPath, { withFileTypes: true });
-
-        for (const entry of entries) {
-          if (!includeHidden && entry.name.startsWith('.')) continue;
-          if (!entry.isDirectory()) continue;
-          if (excludeDirs.includes(entry.name)) continue;
-
-          const fullPath = path.join(currentPath, entry.name);
-
-          // Check if this looks like a project directory
-          const projectInfo = this.analyzeDirectory(fullPath, detectProjectType);
-
-          if (projectInfo) {
-            projects.push({
-              path: fullPath,
-              name: entry.name,
-              ...projectInfo,
-            });
-          } else {
-            // Recurse into subdirectories
-            scanRecursive(fullPath, depth + 1);
-          }
+    for (let depth = 0; depth <= maxDepth && frontier.length > 0; depth++) {
+      const listings = await mapWithConcurrency(frontier, concurrency, async (currentPath) => {
+        try {
+          const entries = await fsp.readdir(currentPath, { withFileTypes: true });
+          return entries
+            .filter(entry =>
+              entry.isDirectory() &&
+              (includeHidden || !entry.name.startsWith('.')) &&
+              !excludeDirs.includes(entry.name)
+            )
+            .map(entry => ({ path: path.join(currentPath, entry.name), name: entry.name }));
+        } catch (error) {
+          console.error(`Error scanning ${currentPath}:`, error);
+          return [];
         }
-      } catch (error) {
-        console.error(`Error scanning ${currentPath}:`, error);
-      }
-    };
+      });
+
+      const nextFrontier: string[] = [];
+      await mapWithConcurrency(listings.flat(), concurrency, async (subdir) => {
+        // Check if this looks like a project directory
+        const projectInfo = await this.analyzeDirectory(subdir.path, detectProjectType);
+
+        if (projectInfo) {
+          candidates.push({ ...subdir, ...projectInfo });
+        } else {
+          // Recurse into subdirectories
+          nextFrontier.push(subdir.path);
+        }
+      });
+      frontier = nextFrontier;
+    }
+    candidates.sort((a, b) => a.path.localeCompare(b.path));
+
+    // Pass 2: size/file-count walks on the worker pool
+    const cache = useCache ? this.loadScanCache(basePath) : new Map<string, DirCacheEntry>();
+    const stats = await this.computeStats(candidates.map(c => c.path), cache, workers, concurrency);
+
+    const updates: Array<[string, DirCacheEntry]> = [];
+    this.lastScanStats = { dirsRead: 0, dirsReused: 0, workers: Math.min(workers, candidates.length) };
+    for (const result of stats.values()) {
+      this.lastScanStats.dirsRead += result.dirsRead;
+      this.lastScanStats.dirsReused += result.dirsReused;
+      updates.push(...result.cacheUpdates);
+    }
+    this.saveScanCache(updates);
 
-    scanRecursive(basePath, 0);
-    return projects;
+    return candidates.map(candidate => {
+      const result = stats.get(candidate.path);
+      return {
+        ...candidate,
+        size: result?.size ?? 0,
+        fileCount: result?.fileCount ?? 0,
+      };
+    });
   }
 
   /**
-   * Analyze a directory to determine if it's a project
+   * Walk counters from the most recent scanDirectory call
    */
-  private analyzeDirectory(dirPath: string, detectType: boolean): Omit<ScannedProject, 'path' | 'name'> | null {
+  getLastScanStats(): ScanStats {
+    return { ...this.lastScanStats };
+  }
+
+  /**
+   * Analyze a directory to determine if it's a project.
+   * Size and file count are filled in later by the stats pass.
+   */
+  private async analyzeDirectory(dirPath: string, detectType: boolean): Promise<Omit<ProjectCandidate, 'path' | 'name'> | null> {
     try {
-      const files = fs.readdirSync(dirPath);
+      const files = await fsp.readdir(dirPath);
 
       // Project type detection
       let type = 'folder';
@@ -155,7 +232,7 @@ export class DirectoryScanner {
         hasReadme = true;
         const readmePath = path.join(dirPath, readmeFile);
         try {
-          readmeContent = fs.readFileSync(readmePath, 'utf-8');
+          readmeContent = await fsp.readFile(readmePath, 'utf-8');
           // Limit to first 500 chars
           if (readmeContent.length > 500) {
             readmeContent = readmeContent.substring(0, 500) + '...';
@@ -165,11 +242,8 @@ export class DirectoryScanner {
         }
       }
 
-      // Calculate directory size and file count
-      const stats = this.getDirectoryStats(dirPath);
-
       // Only consider it a project if it has some substance
-      if (stats.fileCount < 2 && !hasReadme && type === 'folder') {
+      if (!hasReadme && type === 'folder' && !(await hasAtLeastFiles(dirPath, 2))) {
         return null; // Skip trivial directories
       }
 
@@ -183,19 +257,17 @@ export class DirectoryScanner {
         }
       } else if (type === 'npm') {
         try {
-          const packageJson = JSON.parse(fs.readFileSync(path.join(dirPath, 'package.json'), 'utf-8'));
+          const packageJson = JSON.parse(await fsp.readFile(path.join(dirPath, 'package.json'), 'utf-8'));
           description = packageJson.description || description;
         } catch {
           // Ignore parse errors
         }
       }
 
-      const lastModified = fs.statSync(dirPath).mtime;
+      const lastModified = (await fsp.stat(dirPath)).mtime;
 
       return {
         type,
-        size: stats.size,
-        fileCount: stats.fileCount,
         lastModified,
         description,
         detectedLanguages,
@@ -209,44 +281,126 @@ export class DirectoryScanner {
   }
 
   /**
-   * Calculate total size and file count for a directory
+   * Compute stats for each project directory, fanned out over a pool of
+   * worker threads. Falls back to walking in-process when workers are
+   * disabled or the compiled worker script is unavailable (e.g. ts-node).
    */
-  private getDirectoryStats(dirPath: string): { size: number; fileCount: number } {
-    let size = 0;
-    let fileCount = 0;
-
-    const traverse = (currentPath: string, depth: number): void => {
-      if (depth > 5) return; // Prevent deep recursion
+  private async computeStats(
+    dirPaths: string[],
+    cache: Map<string, DirCacheEntry>,
+    workers: number,
+    concurrency: number
+  ): Promise<Map<string, DirectoryStatsResult>> {
+    const results = new Map<string, DirectoryStatsResult>();
+    const poolSize = Math.min(workers, dirPaths.length);
+
+    if (poolSize <= 0 || !fs.existsSync(WORKER_SCRIPT)) {
+      for (const dirPath of dirPaths) {
+        results.set(dirPath, await computeDirectoryStats(dirPath, cache, concurrency));
+      }
+      return results;
+    }
 
-      try {
-        const entries = fs.readdirSync(currentPath, { withFileTypes: true });
+    const workerData: ScanWorkerData = { cache: Array.from(cache.entries()), concurrency };
+    const pool = Array.from({ length: poolSize }, () => new Worker(WORKER_SCRIPT, { workerData }));
+    let next = 0;
 
-        for (const entry of entries) {
-          const fullPath = path.join(currentPath, entry.name);
+    try {
+      await Promise.all(pool.map(worker => new Promise<void>((resolve, reject) => {
+        const dispatch = () => {
+          if (next >= dirPaths.length) {
+            resolve();
+            return;
+          }
+          const id = next++;
+          worker.postMessage({ id, dirPath: dirPaths[id] } as ScanWorkerJob);
+        };
 
-          if (entry.isDirectory()) {
-            // Skip common large directories
-            if (['node_modules', '.git', 'dist', 'build', 'target'].includes(entry.name)) {
-              continue;
-            }
-            traverse(fullPath, depth + 1);
+        worker.on('message', (reply: ScanWorkerReply) => {
+          if (reply.result) {
+            results.set(dirPaths[reply.id], reply.result);
           } else {
-            try {
-              const stats = fs.statSync(fullPath);
-              size += stats.size;
-              fileCount++;
-            } catch {
-              // Ignore stat errors
-            }
+            console.error(`Error computing stats for ${dirPaths[reply.id]}: ${reply.error}`);
           }
-        }
-      } catch (error) {
-        // Ignore directory read errors
+          dispatch();
+        });
+        worker.on('error', reject);
+        dispatch();
+      })));
+    } catch (error) {
+      console.error('Scan worker failed, finishing in-process:', error);
+    } finally {
+      await Promise.all(pool.map(worker => worker.terminate()));
+    }
+
+    // Anything a crashed worker didn't get to
+    for (const dirPath of dirPaths) {
+      if (!results.has(dirPath)) {
+        results.set(dirPath, await computeDirectoryStats(dirPath, cache, concurrency));
+      }
+    }
+
+    return results;
+  }
+
+  /**
+   * Load cached per-directory totals under basePath
+   */
+  loadScanCache(basePath: string): Map<string, DirCacheEntry> {
+    const root = path.resolve(basePath);
+    const prefix = root.endsWith(path.sep) ? root : root + path.sep;
+    const rows = this.db.prepare(`
+      SELECT path, mtime_ms, size, file_count, subdirs
+      FROM directory_scan_cache
+      WHERE path = ? OR substr(path, 1, ?) = ?
+    `).all(root, prefix.length, prefix) as Array<{
+      path: string;
+      mtime_ms: number;
+      size: number;
+      file_count: number;
+      subdirs: string;
+    }>;
+
+    const cache = new Map<string, DirCacheEntry>();
+    for (const row of rows) {
+      cache.set(row.path, {
+        mtimeMs: row.mtime_ms,
+        size: row.size,
+        fileCount: row.file_count,
+        subdirs: JSON.parse(row.subdirs),
+      });
+    }
+    return cache;
+  }
+
+  /**
+   * Persist updated per-directory totals in one transaction
+   */
+  saveScanCache(updates: Array<[string, DirCacheEntry]>): void {
+    if (updates.length === 0) return;
+
+    const stmt = this.db.prepare(`
+      INSERT INTO directory_scan_cache (path, mtime_ms, size, file_count, subdirs)
+      VALUES (?, ?, ?, ?, ?)
+      ON CONFLICT(path) DO UPDATE SET
+        mtime_ms = excluded.mtime_ms,
+        size = excluded.size,
+        file_count = excluded.file_count,
+        subdirs = excluded.subdirs
+    `);
+
+    this.db.transaction(() => {
+      for (const [dirPath, entry] of updates) {
+        stmt.run(dirPath, entry.mtimeMs, entry.size, entry.fileCount, JSON.stringify(entry.subdirs));
       }
-    };
+    })();
+  }
 
-    traverse(dirPath, 0);
-    return { size, fileCount };
+  /**
+   * Drop all cached directory totals, forcing the next scan to read everything
+   */
+  clearScanCache(): void {
+    this.db.prepare('DELETE FROM directory_scan_cache').run();
   }
 
   /**
@@ -258,20 +412,31 @@ export class DirectoryScanner {
   }): number {
     const { defaultStatus = ProjectStatus.Active, skipExisting = true } = options || {};
 
+    // One lookup for all known paths instead of one query per project
+    const existingPaths = new Set(
+      skipExisting
+        ? (this.db.prepare('SELECT concept_where FROM projects WHERE concept_where IS NOT NULL').all() as Array<{ concept_where: string }>)
+            .map(row => row.concept_where)
+        : []
+    );
+
+    const stmt = this.db.prepare(`
+      INSERT INTO projects (
+        name, description, status, 
+        concept_what, concept_how, concept_where, 
+        concept_with_what, concept_when, concept_why
+      ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
+    `);
+
     let imported = 0;
 
-    for (const project of scannedProjects) {
-      try {
+    // Single transaction: one fsync for the whole batch
+    this.db.transaction(() => {
+      for (const project of scannedProjects) {
         // Check if project already exists by path
-        if (skipExisting) {
-          const existing = this.db.prepare(
-            'SELECT id FROM projects WHERE concept_where = ?'
-          ).get(project.path);
-
-          if (existing) {
-            console.log(`Skipping existing project: ${project.name}`);
-            continue;
-          }
+        if (existingPaths.has(project.path)) {
+          console.log(`Skipping existing project: ${project.name}`);
+          continue;
         }
 
         // Create project
@@ -284,37 +449,32 @@ export class DirectoryScanner {
             ? `Built with ${project.detectedLanguages.join(', ')}`
             : 'Development project',
           conceptWhere: project.path,
-          conceptWithWhat: `${this.formatBytes(project.size)} total size`,
+          conceptWithWhat: `${formatBytes(project.size)} total size`,
           conceptWhen: `Last modified: ${project.lastModified.toLocaleDateString()}`,
           conceptWhy: project.readmeContent || `${project.type} development project`,
         };
 
-        const stmt = this.db.prepare(`
-          INSERT INTO projects (
-            name, description, status, 
-            concept_what, concept_how, concept_where, 
-            concept_with_what, concept_when, concept_why
-          ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
-        `);
-
-        stmt.run(
-          projectData.name,
-          projectData.description,
-          projectData.status,
-          projectData.conceptWhat,
-          projectData.conceptHow,
-          projectData.conceptWhere,
-          projectData.conceptWithWhat,
-          projectData.conceptWhen,
-          projectData.conceptWhy
-        );
-
-        imported++;
-        console.log(`Imported: ${project.name} (${project.type})`);
-      } catch (error) {
-        console.error(`Error importing ${project.name}:`, error);
+        try {
+          stmt.run(
+            projectData.name,
+            projectData.description,
+            projectData.status,
+            projectData.conceptWhat,
+            projectData.conceptHow,
+            projectData.conceptWhere,
+            projectData.conceptWithWhat,
+            projectData.conceptWhen,
+            projectData.conceptWhy
+          );
+
+          if (skipExisting) existingPaths.add(project.path);
+          imported++;
+          console.log(`Imported: ${project.name} (${project.type})`);
+        } catch (error) {
+          console.error(`Error importing ${project.name}:`, error);
+        }
       }
-    }
+    })();
 
     return imported;
   }
@@ -340,17 +500,6 @@ export class DirectoryScanner {
     return { scanned: scanned.length, imported };
   }
 
-  /**
-   * Format bytes to human-readable string
-   */
-  private formatBytes(bytes: number): string {
-    if (bytes === 0) return '0 Bytes';
-    const k = 1024;
-    const sizes = ['Bytes', 'KB', 'MB', 'GB'];
-    const i = Math.floor(Math.log(bytes) / Math.log(k));
-    return Math.round(bytes / Math.pow(k, i) * 100) / 100 + ' ' + sizes[i];
-  }
-
   /**
    * Preview scan results without importing
    */
@@ -365,7 +514,7 @@ export class DirectoryScanner {
       console.log(`   Type: ${project.type}`);
       console.log(`   Path: ${project.path}`);
       console.log(`   Files: ${project.fileCount}`);
-      console.log(`   Size: ${this.formatBytes(project.size)}`);
+      console.log(`   Size: ${formatBytes(project.size)}`);
       if (project.detectedLanguages.length > 0) {
         console.log(`   Languages: ${project.detectedLanguages.join(', ')}`);
       }
@@ -1,19 +1,21 @@
-import { NotificationRepository } from '../repositories/NotificationRepository';
+import { NotificationPipeline } from '../services/NotificationPipeline';
 import { NotificationType } from '../models/Notification';
 import { Task } from '../models/Task';
 import { Project } from '../models/Project';
 
 /**
- * Helper class for creating notifications for common events
+ * Helper class for creating notifications for common events.
+ * Notifications are queued on the pipeline, which batches and coalesces
+ * them and pushes deltas to subscribed renderers.
  */
 export class NotificationHelper {
-  constructor(private notificationRepo: NotificationRepository) {}
+  constructor(private pipeline: NotificationPipeline) {}
 
   /**
    * Notify when a task is assigned
    */
   async notifyTaskAssigned(task: Task, assignedToUserId: number, assignedByUserId?: number): Promise<void> {
-    await this.notificationRepo.create({
+    this.pipeline.enqueue({
       userId: assignedToUserId,
       type: NotificationType.TaskAssigned,
       title: 'New task assigned',
@@ -41,7 +43,7 @@ export class NotificationHelper {
       }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
@@ -62,7 +64,7 @@ export class NotificationHelper {
       }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
@@ -84,7 +86,7 @@ export class NotificationHelper {
     }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
@@ -103,7 +105,7 @@ export class NotificationHelper {
     }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
@@ -122,7 +124,7 @@ export class NotificationHelper {
     }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
@@ -141,7 +143,7 @@ export class NotificationHelper {
     }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
@@ -149,7 +151,7 @@ export class NotificationHelper {
    * Notify when a user is invited to a project
    */
   async notifyProjectInvite(project: Project, invitedUserId: number, invitedByUser: string): Promise<void> {
-    await this.notificationRepo.create({
+    this.pipeline.enqueue({
       userId: invitedUserId,
       type: NotificationType.ProjectInvite,
       title: 'Project invitation',
@@ -175,7 +177,7 @@ export class NotificationHelper {
       }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
@@ -194,7 +196,7 @@ export class NotificationHelper {
     }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
@@ -213,7 +215,7 @@ export class NotificationHelper {
     }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
@@ -229,7 +231,7 @@ export class NotificationHelper {
     }));
 
     if (notifications.length > 0) {
-      await this.notificationRepo.createBulk(notifications);
+      this.pipeline.enqueue(notifications);
     }
   }
 
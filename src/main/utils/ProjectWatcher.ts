@@ -0,0 +1,332 @@
+import * as fs from 'fs';
+import * as path from 'path';
+import Database from 'better-sqlite3';
+import { DirectoryScanner } from './DirectoryScanner';
+import {
+  computeDirectoryStats,
+  formatBytes,
+  DirCacheEntry,
+  STATS_EXCLUDED_DIRS,
+  STATS_MAX_DEPTH,
+  DEFAULT_FS_CONCURRENCY,
+} from './directoryStats';
+
+export interface ProjectWatcherOptions {
+  basePath?: string; // Only watch imported projects under this path
+  debounceMs?: number; // Quiet period before changed projects are recomputed
+  concurrency?: number; // Concurrent fs operations per recompute
+  onUpdate?: (update: ProjectStatsUpdate) => void;
+}
+
+/**
+ * Fresh totals written back for one project
+ */
+export interface ProjectStatsUpdate {
+  projectId: number;
+  name: string;
+  path: string;
+  size: number;
+  fileCount: number;
+  lastModified: Date;
+  dirsRead: number;
+}
+
+interface WatchedProject {
+  id: number;
+  name: string;
+}
+
+interface PendingChange {
+  dirs: Set<string>; // directories whose own totals must be re-read
+  full: boolean; // event without a filename: re-read the whole tree
+  lastEvent: Date;
+}
+
+interface ProjectConceptRow {
+  concept_what: string | null;
+  concept_with_what: string | null;
+  concept_when: string | null;
+}
+
+export const DEFAULT_WATCH_DEBOUNCE_MS = 1000;
+
+// Formats written by DirectoryScanner.importProjects; fields the user has
+// rewritten no longer match and are left alone
+const WHAT_PATTERN = /^(.*) project with \d+ files$/;
+const WITH_WHAT_PATTERN = / total size$/;
+const WHEN_PATTERN = /^Last modified: /;
+
+/**
+ * Keeps imported projects' size, file count and last-modified fields fresh
+ * from filesystem change notifications instead of periodic full rescans.
+ *
+ * Events are coalesced per project over a debounce window. Only directories
+ * that saw events are re-read; everything else comes from the scanner's
+ * mtime cache, so a recompute costs one stat per directory.
+ */
+export class ProjectWatcher {
+  private scanner: DirectoryScanner;
+  private projects = new Map<string, WatchedProject>();
+  private watchers = new Map<string, fs.FSWatcher>();
+  private pending = new Map<string, PendingChange>();
+  private cache = new Map<string, DirCacheEntry>();
+  private timer: NodeJS.Timeout | null = null;
+  private flushing: Promise<void> | null = null;
+  private recursive = true;
+
+  constructor(private db: Database.Database, private options: ProjectWatcherOptions = {}) {
+    this.scanner = new DirectoryScanner(db);
+  }
+
+  /**
+   * Start watching every imported project that still exists on disk.
+   * Returns the number of projects being watched.
+   */
+  start(): number {
+    const basePath = this.options.basePath ? path.resolve(this.options.basePath) : null;
+    const rows = this.db.prepare(`
+      SELECT id, name, concept_where FROM projects WHERE concept_where IS NOT NULL
+    `).all() as Array<{ id: number; name: string; concept_where: string }>;
+
+    for (const row of rows) {
+      const root = path.resolve(row.concept_where);
+      if (basePath && root !== basePath && !root.startsWith(basePath + path.sep)) continue;
+      if (this.projects.has(root) || !this.isDirectory(root)) continue;
+
+      this.projects.set(root, { id: row.id, name: row.name });
+      for (const [dirPath, entry] of this.scanner.loadScanCache(root)) {
+        this.cache.set(dirPath, entry);
+      }
+      this.watchProject(root);
+    }
+
+    console.log(`[ProjectWatcher] Watching ${this.projects.size} projects${this.recursive ? '' : ' (per-directory watchers)'}`);
+    return this.projects.size;
+  }
+
+  /**
+   * Stop all watchers and drop pending changes
+   */
+  stop(): void {
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    for (const watcher of this.watchers.values()) {
+      watcher.close();
+    }
+    this.watchers.clear();
+    this.pending.clear();
+    this.projects.clear();
+  }
+
+  /**
+   * Resolves once any in-flight recompute has been written
+   */
+  async idle(): Promise<void> {
+    while (this.flushing) {
+      await this.flushing;
+    }
+  }
+
+  private watchProject(root: string): void {
+    if (this.recursive) {
+      try {
+        this.addWatcher(root, root, true);
+        return;
+      } catch (error) {
+        // Recursive watches need Node 20+ on Linux
+        if ((error as NodeJS.ErrnoException).code !== 'ERR_FEATURE_UNAVAILABLE_ON_PLATFORM') throw error;
+        this.recursive = false;
+      }
+    }
+    this.syncDirectoryWatchers(root);
+  }
+
+  private addWatcher(root: string, dirPath: string, recursive: boolean): void {
+    const watcher = fs.watch(dirPath, { recursive, persistent: true }, (_event, filename) => {
+      const name = filename ? filename.toString() : null;
+      this.onChange(root, name ? path.join(dirPath, name) : null);
+    });
+    watcher.on('error', () => {
+      // Directory was removed; the next recompute drops or re-adds watchers
+      watcher.close();
+      this.watchers.delete(dirPath);
+    });
+    this.watchers.set(dirPath, watcher);
+  }
+
+  /**
+   * Without recursive watches, keep one watcher per directory in the tree,
+   * following the subdirectory lists in the cache
+   */
+  private syncDirectoryWatchers(root: string): void {
+    const wanted = new Set<string>();
+    let frontier = [root];
+    for (let depth = 0; depth <= STATS_MAX_DEPTH && frontier.length > 0; depth++) {
+      const next: string[] = [];
+      for (const dirPath of frontier) {
+        wanted.add(dirPath);
+        for (const name of this.cache.get(dirPath)?.subdirs ?? []) {
+          next.push(path.join(dirPath, name));
+        }
+      }
+      frontier = next;
+    }
+
+    for (const [dirPath, watcher] of this.watchers) {
+      if (this.isUnder(root, dirPath) && !wanted.has(dirPath)) {
+        watcher.close();
+        this.watchers.delete(dirPath);
+      }
+    }
+    for (const dirPath of wanted) {
+      if (this.watchers.has(dirPath)) continue;
+      try {
+        this.addWatcher(root, dirPath, false);
+      } catch {
+        // Vanished between listing and watching
+      }
+    }
+  }
+
+  private onChange(root: string, changedPath: string | null): void {
+    let change = this.pending.get(root);
+    if (!change) {
+      change = { dirs: new Set(), full: false, lastEvent: new Date() };
+      this.pending.set(root, change);
+    }
+    change.lastEvent = new Date();
+
+    if (changedPath === null) {
+      change.full = true;
+    } else {
+      const relative = path.relative(root, changedPath).split(path.sep);
+      // Excluded or too-deep paths never contribute to the totals
+      if (relative.some(segment => STATS_EXCLUDED_DIRS.includes(segment)) || relative.length - 1 > STATS_MAX_DEPTH) {
+        if (change.dirs.size === 0 && !change.full) this.pending.delete(root);
+        return;
+      }
+      change.dirs.add(path.dirname(changedPath));
+    }
+
+    this.scheduleFlush();
+  }
+
+  private scheduleFlush(): void {
+    if (this.timer) clearTimeout(this.timer);
+    this.timer = setTimeout(() => {
+      this.timer = null;
+      if (this.flushing) {
+        // Pick up whatever arrives during the current recompute afterwards
+        this.flushing.then(() => this.scheduleFlush());
+        return;
+      }
+      this.flushing = this.flush().finally(() => {
+        this.flushing = null;
+      });
+    }, this.options.debounceMs ?? DEFAULT_WATCH_DEBOUNCE_MS);
+  }
+
+  /**
+   * Recompute every project with pending changes and write the results in
+   * one transaction
+   */
+  private async flush(): Promise<void> {
+    const batch = Array.from(this.pending.entries());
+    this.pending.clear();
+
+    const updates: ProjectStatsUpdate[] = [];
+    const cacheUpdates: Array<[string, DirCacheEntry]> = [];
+
+    for (const [root, change] of batch) {
+      const project = this.projects.get(root);
+      if (!project) continue;
+
+      // Drop cached totals for changed directories so in-place edits count
+      for (const dirPath of Array.from(this.cache.keys())) {
+        if (change.full ? this.isUnder(root, dirPath) : change.dirs.has(dirPath)) {
+          this.cache.delete(dirPath);
+        }
+      }
+
+      try {
+        const result = await computeDirectoryStats(root, this.cache, this.options.concurrency ?? DEFAULT_FS_CONCURRENCY);
+        for (const [dirPath, entry] of result.cacheUpdates) {
+          this.cache.set(dirPath, entry);
+        }
+        cacheUpdates.push(...result.cacheUpdates);
+        updates.push({
+          projectId: project.id,
+          name: project.name,
+          path: root,
+          size: result.size,
+          fileCount: result.fileCount,
+          lastModified: change.lastEvent,
+          dirsRead: result.dirsRead,
+        });
+      } catch (error) {
+        console.error(`[ProjectWatcher] Error recomputing ${root}:`, error);
+      }
+
+      if (!this.recursive && this.projects.has(root)) {
+        this.syncDirectoryWatchers(root);
+      }
+    }
+
+    this.scanner.saveScanCache(cacheUpdates);
+    this.writeUpdates(updates);
+
+    for (const update of updates) {
+      this.options.onUpdate?.(update);
+    }
+  }
+
+  private writeUpdates(updates: ProjectStatsUpdate[]): void {
+    if (updates.length === 0) return;
+
+    const select = this.db.prepare(`
+      SELECT concept_what, concept_with_what, concept_when FROM projects WHERE id = ?
+    `);
+    const update = this.db.prepare(`
+      UPDATE projects SET concept_what = ?, concept_with_what = ?, concept_when = ?, updated_at = ?
+      WHERE id = ?
+    `);
+
+    this.db.transaction(() => {
+      for (const stats of updates) {
+        const row = select.get(stats.projectId) as ProjectConceptRow | undefined;
+        if (!row) {
+          // Project was deleted while being watched
+          this.projects.delete(stats.path);
+          continue;
+        }
+
+        const what = row.concept_what?.match(WHAT_PATTERN);
+        update.run(
+          what ? `${what[1]} project with ${stats.fileCount} files` : row.concept_what,
+          row.concept_with_what && WITH_WHAT_PATTERN.test(row.concept_with_what)
+            ? `${formatBytes(stats.size)} total size`
+            : row.concept_with_what,
+          row.concept_when && WHEN_PATTERN.test(row.concept_when)
+            ? `Last modified: ${stats.lastModified.toLocaleDateString()}`
+            : row.concept_when,
+          new Date().toISOString(),
+          stats.projectId
+        );
+      }
+    })();
+  }
+
+  private isUnder(root: string, dirPath: string): boolean {
+    return dirPath === root || dirPath.startsWith(root + path.sep);
+  }
+
+  private isDirectory(dirPath: string): boolean {
+    try {
+      return fs.statSync(dirPath).isDirectory();
+    } catch {
+      return false;
+    }
+  }
+}
@@ -0,0 +1,271 @@
+import Database from 'better-sqlite3';
+import * as fs from 'fs';
+import * as path from 'path';
+import { insertRows, nextRowId } from '../database/bulkInsert';
+import { ProjectTemplateRepository } from '../repositories/ProjectTemplateRepository';
+import { VisionBoardManager } from '../services/VisionBoardManager';
+import { AuditAction, getActionCategory, getActionSeverity } from '../models/AuditLog';
+import { ProjectStatus } from '../models/Project';
+import { TaskStatus, TaskPriority } from '../models/Task';
+import { NodeType, VisionBoardType } from '../models/VisionBoard';
+
+const DAY_MS = 24 * 60 * 60 * 1000;
+
+/**
+ * Sizes of a synthetic benchmark dataset. The same options and seed always
+ * produce the same rows.
+ */
+export interface BenchDataOptions {
+  seed: number;
+  users: number;
+  projects: number;
+  tasksPerProject: number;
+  dependenciesPerProject: number;
+  timeEntries: number;
+  auditRows: number;
+  boardNodes: number;
+  templateTasks: number;
+}
+
+export const DEFAULT_BENCH_DATA_OPTIONS: BenchDataOptions = {
+  seed: 1,
+  users: 25,
+  projects: 20,
+  tasksPerProject: 500,
+  dependenciesPerProject: 400,
+  timeEntries: 100000,
+  auditRows: 200000,
+  boardNodes: 20000,
+  templateTasks: 300,
+};
+
+/**
+ * Ids of what generateBenchData created, for scenarios to aim at
+ */
+export interface BenchDataset {
+  userIds: number[];
+  projectIds: number[];
+  taskIdsByProject: Map<number, number[]>;
+  templateId: number;
+  boardId: number;
+  counts: Record<string, number>;
+}
+
+/**
+ * Small deterministic PRNG (mulberry32), so datasets are reproducible
+ * across runs and machines
+ */
+export function createRandom(seed: number): () => number {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/**
+ * Fill a migrated DevTrack database with synthetic data. Rows are written
+ * with multi-row inserts in one transaction per table, so triggers
+ * (aggregates, search index, change log) run exactly as they do for app
+ * writes. The audit and vision board modules must already be initialized.
+ */
+export function generateBenchData(db: Database.Database, options: BenchDataOptions): BenchDataset {
+  const random = createRandom(options.seed);
+  const pick = <T>(items: readonly T[]): T => items[Math.floor(random() * items.length)];
+  const now = Date.now();
+  const isoDaysAgo = (days: number) => new Date(now - days * DAY_MS).toISOString();
+
+  const statuses = Object.values(TaskStatus);
+  const priorities = Object.values(TaskPriority);
+  const actions = Object.values(AuditAction);
+  const templatePriorities = ['low', 'medium', 'high', 'critical'] as const;
+
+  const userIds = db.transaction(() => {
+    const first = nextRowId(db, 'users');
+    const ids = Array.from({ length: options.users }, (_, i) => first + i);
+    const created = new Date(now).toISOString();
+    insertRows(db, 'users', ['id', 'username', 'email', 'display_name', 'created_at', 'updated_at'],
+      ids.map(id => [id, `bench_user_${id}`, `bench_user_${id}@example.com`, `Bench User ${id}`, created, created])
+    );
+    return ids;
+  })();
+
+  const projectIds: number[] = [];
+  const taskIdsByProject = new Map<number, number[]>();
+  let dependencyCount = 0;
+
+  db.transaction(() => {
+    let nextProjectId = nextRowId(db, 'projects');
+    let nextTaskId = nextRowId(db, 'tasks');
+    const projects: unknown[][] = [];
+    const tasks: unknown[][] = [];
+
+    for (let p = 0; p < options.projects; p++) {
+      const projectId = nextProjectId++;
+      const created = isoDaysAgo(365 * random());
+      projectIds.push(projectId);
+      projects.push([projectId, `Bench Project ${p + 1}`, 'Generated benchmark project', ProjectStatus.Active, created, created]);
+
+      const taskIds: number[] = [];
+      for (let t = 0; t < options.tasksPerProject; t++) {
+        const taskId = nextTaskId++;
+        const status = pick(statuses);
+        const startDaysAgo = 180 * random();
+        const updated = isoDaysAgo(startDaysAgo * random());
+        taskIds.push(taskId);
+        tasks.push([
+          taskId, projectId, `Task ${t + 1} of project ${p + 1}`, `Generated task ${taskId}`,
+          status, pick(priorities), userIds.length > 0 ? pick(userIds) : null,
+          isoDaysAgo(startDaysAgo).slice(0, 10), isoDaysAgo(startDaysAgo - 30 * random()).slice(0, 10),
+          isoDaysAgo(startDaysAgo), updated, status === TaskStatus.Done ? updated : null, t,
+        ]);
+      }
+      taskIdsByProject.set(projectId, taskIds);
+    }
+
+    insertRows(db, 'projects', ['id', 'name', 'description', 'status', 'created_at', 'updated_at'], projects);
+    insertRows(db, 'tasks', [
+      'id', 'project_id', 'title', 'description', 'status', 'priority', 'assigned_to',
+      'start_date', 'due_date', 'created_at', 'updated_at', 'completed_at', 'position',
+    ], tasks);
+
+    // Later tasks depend on earlier ones only, so the graph stays acyclic
+    const dependencies: unknown[][] = [];
+    const created = new Date(now).toISOString().replace('T', ' ').slice(0, 19);
+    for (const taskIds of taskIdsByProject.values()) {
+      if (taskIds.length < 2) continue;
+      for (let d = 0; d < options.dependenciesPerProject; d++) {
+        const a = 1 + Math.floor(random() * (taskIds.length - 1));
+        const b = Math.floor(random() * a);
+        dependencies.push([taskIds[a], taskIds[b], 'blocks', created]);
+      }
+    }
+    dependencyCount = insertRows(db, 'task_dependencies',
+      ['task_id', 'depends_on_task_id', 'dependency_type', 'created_at'], dependencies, 'IGNORE');
+  })();
+
+  const allTaskIds = Array.from(taskIdsByProject.values()).flat();
+
+  db.transaction(() => {
+    if (allTaskIds.length === 0 || userIds.length === 0) return;
+    const entries: unknown[][] = [];
+    for (let i = 0; i < options.timeEntries; i++) {
+      const start = now - 365 * DAY_MS * random();
+      const duration = 300 + Math.floor(random() * 4 * 3600);
+      const startTime = new Date(start).toISOString();
+      entries.push([
+        pick(allTaskIds), pick(userIds), startTime, new Date(start + duration * 1000).toISOString(),
+        duration, random() < 0.5 ? 1 : 0, startTime, startTime,
+      ]);
+    }
+    insertRows(db, 'time_entries', [
+      'task_id', 'user_id', 'start_time', 'end_time', 'duration', 'is_billable', 'created_at', 'updated_at',
+    ], entries);
+  })();
+
+  db.transaction(() => {
+    const rows: unknown[][] = [];
+    for (let i = 0; i < options.auditRows; i++) {
+      const action = pick(actions);
+      const userId = userIds.length > 0 ? pick(userIds) : null;
+      rows.push([
+        isoDaysAgo(90 * random()), userId, userId ? `bench_user_${userId}` : null,
+        action, getActionCategory(action), getActionSeverity(action),
+        'task', allTaskIds.length > 0 ? pick(allTaskIds) : null, `Generated ${action} entry`,
+        '127.0.0.1', 'devtrack-bench', 1,
+      ]);
+    }
+    insertRows(db, 'audit_logs', [
+      'timestamp', 'user_id', 'username', 'action', 'category', 'severity',
+      'entity_type', 'entity_id', 'description', 'ip_address', 'user_agent', 'success',
+    ], rows);
+  })();
+
+  const boards = new VisionBoardManager(db);
+  const board = boards.createBoard({
+    name: 'Bench Board',
+    type: VisionBoardType.Canvas,
+    projectId: projectIds[0] ?? null,
+    canvasWidth: 20000,
+    canvasHeight: 20000,
+  }, userIds[0] ?? 1);
+  boards.close();
+
+  db.transaction(() => {
+    const types = Object.values(NodeType);
+    const nodes: unknown[][] = [];
+    for (let i = 0; i < options.boardNodes; i++) {
+      nodes.push([board.id, pick(types), 20000 * random(), 20000 * random(), 200, 100, `Node ${i + 1}`, i]);
+    }
+    insertRows(db, 'vision_board_nodes', ['board_id', 'type', 'x', 'y', 'width', 'height', 'text', 'z_index'], nodes);
+  })();
+
+  // Labels on every fifth task and a dependency on the previous task for
+  // every third, roughly what a real 300-task template carries
+  const labelCount = 8;
+  const template = new ProjectTemplateRepository(db).createWithContent({ name: 'Bench Template' }, {
+    tasks: Array.from({ length: options.templateTasks }, (_, i) => ({
+      id: i + 1,
+      title: `Template task ${i + 1}`,
+      description: 'Generated template task',
+      priority: pick(templatePriorities),
+      estimatedHours: 1 + Math.floor(random() * 16),
+      position: i,
+    })),
+    labels: Array.from({ length: labelCount }, (_, i) => ({
+      id: i + 1,
+      name: `Label ${i + 1}`,
+      color: '#607D8B',
+      description: null,
+    })),
+    taskLabels: Array.from({ length: Math.ceil(options.templateTasks / 5) }, (_, i) => ({
+      taskTemplateId: i * 5 + 1,
+      templateLabelId: (i % labelCount) + 1,
+    })),
+    dependencies: Array.from({ length: Math.floor(options.templateTasks / 3) }, (_, i) => ({
+      taskTemplateId: (i + 1) * 3,
+      dependsOnTaskTemplateId: (i + 1) * 3 - 1,
+      dependencyType: 'blocks',
+    })),
+  });
+
+  return {
+    userIds,
+    projectIds,
+    taskIdsByProject,
+    templateId: template.id,
+    boardId: board.id,
+    counts: {
+      users: userIds.length,
+      projects: projectIds.length,
+      tasks: allTaskIds.length,
+      dependencies: dependencyCount,
+      timeEntries: allTaskIds.length > 0 && userIds.length > 0 ? options.timeEntries : 0,
+      auditRows: options.auditRows,
+      boardNodes: options.boardNodes,
+      templateTasks: options.templateTasks,
+    },
+  };
+}
+
+/**
+ * Lay out `projects` project directories (each with a package.json, a .git
+ * directory and `filesPerProject` source files) under `root` for directory
+ * scan benchmarks
+ */
+export function generateScanTree(root: string, projects: number, filesPerProject: number, seed: number): void {
+  const random = createRandom(seed);
+  for (let p = 0; p < projects; p++) {
+    const dir = path.join(root, `bench-project-${p + 1}`);
+    fs.mkdirSync(path.join(dir, '.git'), { recursive: true });
+    fs.mkdirSync(path.join(dir, 'src', 'lib'), { recursive: true });
+    fs.writeFileSync(path.join(dir, 'package.json'), JSON.stringify({ name: `bench-project-${p + 1}`, version: '1.0.0' }));
+    for (let f = 0; f < filesPerProject; f++) {
+      const sub = f % 2 === 0 ? 'src' : path.join('src', 'lib');
+      fs.writeFileSync(path.join(dir, sub, `file${f}.ts`), 'x'.repeat(256 + Math.floor(random() * 4096)));
+    }
+  }
+}
@@ -0,0 +1,175 @@
+/**
+ * directoryStats.ts
+ *
+ * Async size/file-count walker shared by DirectoryScanner and its worker
+ * threads. Each directory's own totals are cached by mtime: a directory's
+ * mtime changes whenever entries are added, removed or renamed in it, so an
+ * unchanged mtime lets us reuse its file totals and subdirectory list
+ * without reading or stat-ing its files. Subdirectories are still visited,
+ * since changes deeper down do not touch the parent's mtime.
+ *
+ * In-place edits that change a file's size without touching its directory
+ * are not picked up until the directory itself changes (or a full rescan).
+ */
+
+import { promises as fsp } from 'fs';
+import * as path from 'path';
+
+export interface DirCacheEntry {
+  mtimeMs: number;
+  size: number;      // bytes in files directly inside this directory
+  fileCount: number; // files directly inside this directory
+  subdirs: string[]; // names of non-excluded subdirectories
+}
+
+export interface DirectoryStatsResult {
+  size: number;
+  fileCount: number;
+  dirsRead: number;
+  dirsReused: number;
+  cacheUpdates: Array<[string, DirCacheEntry]>;
+}
+
+export const STATS_EXCLUDED_DIRS = ['node_modules', '.git', 'dist', 'build', 'target'];
+export const STATS_MAX_DEPTH = 5;
+export const DEFAULT_FS_CONCURRENCY = 32;
+
+/**
+ * Run `fn` over `items` with at most `limit` calls in flight
+ */
+export async function mapWithConcurrency<T, R>(items: T[], limit: number, fn: (item: T) => Promise<R>): Promise<R[]> {
+  const results = new Array<R>(items.length);
+  let next = 0;
+
+  const run = async (): Promise<void> => {
+    while (next < items.length) {
+      const index = next++;
+      results[index] = await fn(items[index]);
+    }
+  };
+
+  await Promise.all(Array.from({ length: Math.min(limit, items.length) }, run));
+  return results;
+}
+
+/**
+ * Read one directory's own files and subdirectories
+ */
+async function readDirectory(dirPath: string, mtimeMs: number, concurrency: number): Promise<DirCacheEntry> {
+  const files: string[] = [];
+  const subdirs: string[] = [];
+
+  const dir = await fsp.opendir(dirPath);
+  for await (const entry of dir) {
+    if (entry.isDirectory()) {
+      if (!STATS_EXCLUDED_DIRS.includes(entry.name)) {
+        subdirs.push(entry.name);
+      }
+    } else {
+      files.push(path.join(dirPath, entry.name));
+    }
+  }
+
+  let size = 0;
+  let fileCount = 0;
+  await mapWithConcurrency(files, concurrency, async (file) => {
+    try {
+      const stats = await fsp.stat(file);
+      size += stats.size;
+      fileCount++;
+    } catch {
+      // Ignore stat errors (broken symlinks, races with deletes)
+    }
+  });
+
+  return { mtimeMs, size, fileCount, subdirs };
+}
+
+/**
+ * Calculate total size and file count for a directory tree, reusing cached
+ * totals for directories whose mtime has not changed
+ */
+export async function computeDirectoryStats(
+  rootPath: string,
+  cache: Map<string, DirCacheEntry>,
+  concurrency = DEFAULT_FS_CONCURRENCY
+): Promise<DirectoryStatsResult> {
+  const result: DirectoryStatsResult = { size: 0, fileCount: 0, dirsRead: 0, dirsReused: 0, cacheUpdates: [] };
+  let frontier = [rootPath];
+
+  for (let depth = 0; depth <= STATS_MAX_DEPTH && frontier.length > 0; depth++) {
+    const entries = await mapWithConcurrency(frontier, concurrency, async (dirPath) => {
+      try {
+        const { mtimeMs } = await fsp.stat(dirPath);
+        const cached = cache.get(dirPath);
+        if (cached && cached.mtimeMs === mtimeMs) {
+          result.dirsReused++;
+          return { dirPath, entry: cached };
+        }
+
+        const entry = await readDirectory(dirPath, mtimeMs, concurrency);
+        result.dirsRead++;
+        result.cacheUpdates.push([dirPath, entry]);
+        return { dirPath, entry };
+      } catch {
+        // Ignore directory read errors
+        return null;
+      }
+    });
+
+    frontier = [];
+    for (const item of entries) {
+      if (!item) continue;
+      result.size += item.entry.size;
+      result.fileCount += item.entry.fileCount;
+      for (const name of item.entry.subdirs) {
+        frontier.push(path.join(item.dirPath, name));
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Check whether a tree holds at least `minFiles` files, stopping as soon as
+ * it does. Used to reject trivial folders without a full stats walk.
+ */
+export async function hasAtLeastFiles(rootPath: string, minFiles: number): Promise<boolean> {
+  let found = 0;
+  let frontier = [rootPath];
+
+  for (let depth = 0; depth <= STATS_MAX_DEPTH && frontier.length > 0; depth++) {
+    const nextFrontier: string[] = [];
+    for (const dirPath of frontier) {
+      try {
+        const dir = await fsp.opendir(dirPath);
+        for await (const entry of dir) {
+          if (entry.isDirectory()) {
+            if (!STATS_EXCLUDED_DIRS.includes(entry.name)) {
+              nextFrontier.push(path.join(dirPath, entry.name));
+            }
+          } else if (++found >= minFiles) {
+            return true; // leaving the loop closes the handle
+          }
+        }
+      } catch {
+        // Ignore directory read errors
+      }
+    }
+    frontier = nextFrontier;
+  }
+
+  return false;
+}
+
+/**
+ * Format bytes to human-readable string
+ */
+export function formatBytes(bytes: number): string {
+  if (bytes === 0) return '0 Bytes';
+  const k = 1024;
+  const sizes = ['Bytes', 'KB', 'MB', 'GB'];
+  const i = Math.floor(Math.log(bytes) / Math.log(k));
+  return Math.round(bytes / Math.pow(k, i) * 100) / 100 + ' ' + sizes[i];
+}
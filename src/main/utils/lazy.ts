@@ -0,0 +1,22 @@
+/**
+ * A service built on first call. peek() returns it only if it already
+ * exists, for flush and shutdown paths that should not create it.
+ */
+export interface Lazy<T> {
+  (): T;
+  peek(): T | null;
+}
+
+export function lazy<T>(name: string, create: () => T): Lazy<T> {
+  let instance: T | null = null;
+  const get = (() => {
+    if (instance === null) {
+      const started = Date.now();
+      instance = create();
+      console.log(`[Startup] ${name} initialized in ${Date.now() - started}ms`);
+    }
+    return instance;
+  }) as Lazy<T>;
+  get.peek = () => instance;
+  return get;
+}
@@ -0,0 +1,41 @@
+/**
+ * scanWorker.ts
+ *
+ * worker_threads entry point for DirectoryScanner. Receives project
+ * directories one at a time and replies with their stats, so the heavy
+ * filesystem walk runs off the main thread.
+ */
+
+import { parentPort, workerData } from 'worker_threads';
+import { computeDirectoryStats, DirCacheEntry, DirectoryStatsResult } from './directoryStats';
+
+export interface ScanWorkerData {
+  cache: Array<[string, DirCacheEntry]>;
+  concurrency: number;
+}
+
+export interface ScanWorkerJob {
+  id: number;
+  dirPath: string;
+}
+
+export interface ScanWorkerReply {
+  id: number;
+  result?: DirectoryStatsResult;
+  error?: string;
+}
+
+if (parentPort) {
+  const port = parentPort;
+  const { cache, concurrency } = workerData as ScanWorkerData;
+  const cacheMap = new Map(cache);
+
+  port.on('message', async (job: ScanWorkerJob) => {
+    try {
+      const result = await computeDirectoryStats(job.dirPath, cacheMap, concurrency);
+      port.postMessage({ id: job.id, result } as ScanWorkerReply);
+    } catch (error) {
+      port.postMessage({ id: job.id, error: error instanceof Error ? error.message : String(error) } as ScanWorkerReply);
+    }
+  });
+}
@@ -0,0 +1,229 @@
+import Database from 'better-sqlite3';
+import * as fs from 'fs';
+import * as zlib from 'zlib';
+import { once } from 'events';
+import { Transform, Writable } from 'stream';
+import { pipeline } from 'stream/promises';
+import { ExportFormat, ExportResult } from '../models/Export';
+
+// Output is batched into chunks of about this many characters
+const CHUNK_CHARS = 64 * 1024;
+const PROGRESS_INTERVAL_MS = 250;
+
+export interface StreamExportOptions {
+  format: ExportFormat;
+  gzip?: boolean;
+  signal?: AbortSignal;
+  onProgress?: (progress: { rows: number; bytes: number }) => void;
+}
+
+/**
+ * One CSV column, computed from an exported record
+ */
+export interface ExportColumn<R> {
+  header: string;
+  value: (record: R) => unknown;
+}
+
+/**
+ * How rows of type T become exported records. Without `columns`, CSV
+ * headers are the keys of the first record.
+ */
+export interface ExportSpec<T, R extends object> {
+  toRecord: (row: T) => R;
+  columns?: ExportColumn<R>[];
+}
+
+/**
+ * Error raised when an export's signal is aborted
+ */
+export class ExportCancelledError extends Error {
+  constructor() {
+    super('Export cancelled');
+    this.name = 'ExportCancelledError';
+  }
+}
+
+/**
+ * Buffered text writer over a destination stream, optionally gzipped.
+ * Waits for 'drain' when the destination falls behind and yields to the
+ * event loop between chunks, so memory stays bounded by the chunk size and
+ * the main process keeps serving IPC (including cancellation) during an
+ * export.
+ */
+export class ExportWriter {
+  rows = 0;
+  bytes = 0;
+  private chunks: string[] = [];
+  private buffered = 0;
+  private head: Writable;
+  private finished: Promise<void>;
+  private lastProgressAt = 0;
+
+  constructor(destination: Writable, private options: StreamExportOptions) {
+    const counter = new Transform({
+      transform: (chunk: Buffer, _encoding, callback) => {
+        this.bytes += chunk.length;
+        callback(null, chunk);
+      },
+    });
+    if (options.gzip) {
+      const gzip = zlib.createGzip();
+      this.head = gzip;
+      this.finished = pipeline(gzip, counter, destination);
+    } else {
+      this.head = counter;
+      this.finished = pipeline(counter, destination);
+    }
+    // Awaited in drain() and end(); a failure before then must not go unhandled
+    this.finished.catch(() => {});
+  }
+
+  async write(text: string): Promise<void> {
+    this.chunks.push(text);
+    this.buffered += text.length;
+    if (this.buffered >= CHUNK_CHARS) await this.drain();
+  }
+
+  /**
+   * Write the rows as a JSON array, one compact record per line
+   */
+  async jsonArray<T>(rows: Iterable<T>, toRecord: (row: T) => unknown): Promise<void> {
+    let first = true;
+    await this.write('[');
+    for (const row of rows) {
+      await this.write(`${first ? '\n' : ',\n'}${JSON.stringify(toRecord(row))}`);
+      first = false;
+      this.rows++;
+    }
+    await this.write(first ? ']' : '\n]');
+  }
+
+  /**
+   * Write the rows as RFC 4180 CSV with a header line
+   */
+  async csv<T, R extends object>(rows: Iterable<T>, spec: ExportSpec<T, R>): Promise<void> {
+    let columns = spec.columns;
+    for (const row of rows) {
+      const record = spec.toRecord(row);
+      if (!columns) {
+        columns = Object.keys(record).map(key => ({ header: key, value: (r: R) => (r as any)[key] }));
+      }
+      if (this.rows === 0) await this.write(columns.map(column => csvField(column.header)).join(','));
+      await this.write('\n' + columns.map(column => csvField(column.value(record))).join(','));
+      this.rows++;
+    }
+    if (this.rows === 0 && columns) await this.write(columns.map(column => csvField(column.header)).join(','));
+  }
+
+  async end(): Promise<void> {
+    await this.drain();
+    this.head.end();
+    await this.finished;
+    this.options.onProgress?.({ rows: this.rows, bytes: this.bytes });
+  }
+
+  /**
+   * Tear the pipeline down, destroying the destination
+   */
+  async destroy(error: Error): Promise<void> {
+    this.chunks = [];
+    this.head.destroy(error);
+    await this.finished.catch(() => {});
+  }
+
+  private async drain(): Promise<void> {
+    if (this.options.signal?.aborted) throw new ExportCancelledError();
+    if (this.buffered > 0) {
+      const text = this.chunks.join('');
+      this.chunks = [];
+      this.buffered = 0;
+      if (!this.head.write(text)) {
+        await Promise.race([once(this.head, 'drain'), this.finished]);
+      } else {
+        await new Promise(resolve => setImmediate(resolve));
+      }
+    }
+
+    const now = Date.now();
+    if (this.options.onProgress && now - this.lastProgressAt >= PROGRESS_INTERVAL_MS) {
+      this.lastProgressAt = now;
+      this.options.onProgress({ rows: this.rows, bytes: this.bytes });
+    }
+  }
+}
+
+/**
+ * Run `body` against a writer over `destination` and finish the stream. On
+ * failure or cancellation the destination is destroyed, and iterators the
+ * body was in the middle of are closed by their for..of loops.
+ */
+export async function writeExport(
+  destination: Writable,
+  options: StreamExportOptions,
+  body: (writer: ExportWriter) => Promise<void>
+): Promise<ExportResult> {
+  const startedAt = Date.now();
+  const writer = new ExportWriter(destination, options);
+  try {
+    await body(writer);
+    await writer.end();
+  } catch (error) {
+    await writer.destroy(error instanceof Error ? error : new Error(String(error)));
+    throw error;
+  }
+  return { rows: writer.rows, bytes: writer.bytes, durationMs: Date.now() - startedAt };
+}
+
+/**
+ * Export `rows` as CSV or JSON, per options.format
+ */
+export function exportRows<T, R extends object>(
+  rows: Iterable<T>,
+  spec: ExportSpec<T, R>,
+  destination: Writable,
+  options: StreamExportOptions
+): Promise<ExportResult> {
+  return writeExport(destination, options, writer =>
+    options.format === 'csv' ? writer.csv(rows, spec) : writer.jsonArray(rows, spec.toRecord)
+  );
+}
+
+/**
+ * Run an export into `filePath`. The data goes to a `.partial` file that is
+ * renamed into place on success and removed on failure, so a cancelled
+ * export never leaves a truncated file behind.
+ */
+export async function exportToFile(
+  filePath: string,
+  run: (destination: Writable) => Promise<ExportResult>
+): Promise<ExportResult> {
+  const partialPath = `${filePath}.partial`;
+  try {
+    const result = await run(fs.createWriteStream(partialPath));
+    await fs.promises.rename(partialPath, filePath);
+    return { ...result, filePath };
+  } catch (error) {
+    await fs.promises.unlink(partialPath).catch(() => {});
+    throw error;
+  }
+}
+
+/**
+ * Open a read-only connection for one export. A better-sqlite3 connection
+ * is busy for as long as one of its iterators is open, so an export cannot
+ * share the connections other requests use; in WAL mode it also reads a
+ * consistent snapshot while writes carry on.
+ */
+export function openExportConnection(dbPath: string): Database.Database {
+  return new Database(dbPath, { readonly: true, fileMustExist: true });
+}
+
+function csvField(value: unknown): string {
+  if (value === null || value === undefined) return '';
+  let text: string;
+  if (value instanceof Date) text = value.toISOString();
+  else if (typeof value === 'object') text = JSON.stringify(value);
+  else text = String(value);
+  return /[",\r\n]/.test(text) ? `"${text.replace(/"/g, '""')}"` : text;
+}
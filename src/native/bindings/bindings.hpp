@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+
+#include "bindings/napi_helpers.hpp"
+#include "database/project_repository.hpp"
+#include "database/sqlite_connection.hpp"
+#include "database/task_repository.hpp"
+
+namespace devtrack {
+
+/**
+ * Per-environment addon state (one per Electron main process or worker)
+ */
+struct CoreState {
+    std::unique_ptr<SqliteConnection> connection;
+    std::unique_ptr<TaskRepository> tasks;
+    std::unique_ptr<ProjectRepository> projects;
+};
+
+/** State of an open module; throws if open() has not been called */
+CoreState& openState(napi_env env);
+
+napi_value FindTasksByProjectIdColumnar(napi_env env, napi_callback_info info);
+napi_value FindAllProjectsColumnar(napi_env env, napi_callback_info info);
+
+}  // namespace devtrack
@@ -0,0 +1,95 @@
+#include "bindings/bindings.hpp"
+
+/**
+ * devtrack_core: native read paths for the Electron main process.
+ *
+ *   open(dbPath, { taskStatuses, taskPriorities })  open a read-only connection
+ *   close()                                          release it
+ *   findTasksByProjectIdColumnar(projectId)          TaskColumns
+ *   findAllProjectsColumnar()                        ProjectColumns
+ *
+ * Loaded by src/main/database/nativeCore.ts, which falls back to the
+ * TypeScript repositories when the addon is missing or fails to open.
+ */
+
+namespace devtrack {
+
+// Bump when the exported functions or column layouts change
+constexpr int kApiVersion = 1;
+
+CoreState& openState(napi_env env) {
+    CoreState* state = nullptr;
+    napi::check(env, napi_get_instance_data(env, reinterpret_cast<void**>(&state)));
+    if (!state || !state->connection) {
+        throw std::logic_error("devtrack_core is not open");
+    }
+    return *state;
+}
+
+namespace {
+
+CoreState& instanceState(napi_env env) {
+    CoreState* state = nullptr;
+    napi::check(env, napi_get_instance_data(env, reinterpret_cast<void**>(&state)));
+    return *state;
+}
+
+napi_value Open(napi_env env, napi_callback_info info) {
+    return napi::guard(env, [&] {
+        const auto argv = napi::arguments(env, info, 2);
+        const std::string path = napi::toString(env, argv[0]);
+        const auto statuses = napi::toStringArray(env, napi::namedProperty(env, argv[1], "taskStatuses"));
+        const auto priorities = napi::toStringArray(env, napi::namedProperty(env, argv[1], "taskPriorities"));
+
+        // Build everything first so a failure leaves the previous state intact
+        auto connection = std::make_unique<SqliteConnection>(path);
+        auto tasks = std::make_unique<TaskRepository>(*connection, statuses, priorities);
+        auto projects = std::make_unique<ProjectRepository>(*connection);
+
+        CoreState& state = instanceState(env);
+        state.tasks.reset();
+        state.projects.reset();
+        state.connection = std::move(connection);
+        state.tasks = std::move(tasks);
+        state.projects = std::move(projects);
+        return napi::undefined(env);
+    });
+}
+
+napi_value Close(napi_env env, napi_callback_info) {
+    return napi::guard(env, [&] {
+        CoreState& state = instanceState(env);
+        // Statements are finalized before their connection closes
+        state.tasks.reset();
+        state.projects.reset();
+        state.connection.reset();
+        return napi::undefined(env);
+    });
+}
+
+void exportFunction(napi_env env, napi_value exports, const char* name, napi_callback callback) {
+    napi_value fn = nullptr;
+    napi::check(env, napi_create_function(env, name, NAPI_AUTO_LENGTH, callback, nullptr, &fn));
+    napi::setNamed(env, exports, name, fn);
+}
+
+}  // namespace
+
+}  // namespace devtrack
+
+NAPI_MODULE_INIT() {
+    using namespace devtrack;
+    return napi::guard(env, [&] {
+        auto* state = new CoreState();
+        napi::check(env, napi_set_instance_data(env, state, [](napi_env, void* data, void*) {
+            delete static_cast<CoreState*>(data);
+        }, nullptr));
+
+        napi::setNamed(env, exports, "apiVersion", napi::number(env, kApiVersion));
+        exportFunction(env, exports, "open", Open);
+        exportFunction(env, exports, "close", Close);
+        exportFunction(env, exports, "findTasksByProjectIdColumnar", FindTasksByProjectIdColumnar);
+        exportFunction(env, exports, "findAllProjectsColumnar", FindAllProjectsColumnar);
+        return exports;
+    });
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#define NAPI_VERSION 8
+#include <node_api.h>
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "models/columns.hpp"
+
+/**
+ * Thin C++ layer over the C Node-API. Failures are C++ exceptions inside
+ * the addon; guard() turns them into a JS exception at each entry point.
+ */
+namespace devtrack::napi {
+
+// A JS exception is already pending; nothing more to throw
+struct PendingException {};
+
+inline void check(napi_env env, napi_status status) {
+    if (status == napi_ok) {
+        return;
+    }
+    bool pending = false;
+    napi_is_exception_pending(env, &pending);
+    if (pending) {
+        throw PendingException{};
+    }
+    const napi_extended_error_info* info = nullptr;
+    napi_get_last_error_info(env, &info);
+    throw std::runtime_error(info && info->error_message ? info->error_message : "Node-API call failed");
+}
+
+/**
+ * Run `body` for a JS entry point, converting C++ exceptions to JS errors
+ */
+template <typename Body>
+napi_value guard(napi_env env, Body&& body) noexcept {
+    try {
+        return body();
+    } catch (const PendingException&) {
+        return nullptr;
+    } catch (const std::exception& error) {
+        napi_throw_error(env, nullptr, error.what());
+        return nullptr;
+    } catch (...) {
+        napi_throw_error(env, nullptr, "Unknown native error");
+        return nullptr;
+    }
+}
+
+inline std::vector<napi_value> arguments(napi_env env, napi_callback_info info, std::size_t expected) {
+    std::size_t argc = expected;
+    std::vector<napi_value> argv(expected);
+    check(env, napi_get_cb_info(env, info, &argc, argv.data(), nullptr, nullptr));
+    if (argc < expected) {
+        throw std::invalid_argument("Expected " + std::to_string(expected) + " argument(s)");
+    }
+    return argv;
+}
+
+inline void expectType(napi_env env, napi_value value, napi_valuetype expected, const char* what) {
+    napi_valuetype actual = napi_undefined;
+    check(env, napi_typeof(env, value, &actual));
+    if (actual != expected) {
+        throw std::invalid_argument(std::string("Expected ") + what);
+    }
+}
+
+inline std::string toString(napi_env env, napi_value value) {
+    expectType(env, value, napi_string, "a string");
+    std::size_t length = 0;
+    check(env, napi_get_value_string_utf8(env, value, nullptr, 0, &length));
+    std::string result(length, '\0');
+    check(env, napi_get_value_string_utf8(env, value, result.data(), length + 1, &length));
+    return result;
+}
+
+inline std::int64_t toInt64(napi_env env, napi_value value) {
+    expectType(env, value, napi_number, "a number");
+    std::int64_t result = 0;
+    check(env, napi_get_value_int64(env, value, &result));
+    return result;
+}
+
+inline std::vector<std::string> toStringArray(napi_env env, napi_value value) {
+    bool isArray = false;
+    check(env, napi_is_array(env, value, &isArray));
+    if (!isArray) {
+        throw std::invalid_argument("Expected an array of strings");
+    }
+    std::uint32_t length = 0;
+    check(env, napi_get_array_length(env, value, &length));
+    std::vector<std::string> result;
+    result.reserve(length);
+    for (std::uint32_t i = 0; i < length; ++i) {
+        napi_value element = nullptr;
+        check(env, napi_get_element(env, value, i, &element));
+        result.push_back(toString(env, element));
+    }
+    return result;
+}
+
+inline napi_value namedProperty(napi_env env, napi_value object, const char* name) {
+    napi_value value = nullptr;
+    check(env, napi_get_named_property(env, object, name, &value));
+    return value;
+}
+
+inline void setNamed(napi_env env, napi_value object, const char* name, napi_value value) {
+    check(env, napi_set_named_property(env, object, name, value));
+}
+
+inline napi_value object(napi_env env) {
+    napi_value result = nullptr;
+    check(env, napi_create_object(env, &result));
+    return result;
+}
+
+inline napi_value number(napi_env env, double value) {
+    napi_value result = nullptr;
+    check(env, napi_create_double(env, value, &result));
+    return result;
+}
+
+inline napi_value undefined(napi_env env) {
+    napi_value result = nullptr;
+    check(env, napi_get_undefined(env, &result));
+    return result;
+}
+
+inline napi_value string(napi_env env, const std::string& value) {
+    napi_value result = nullptr;
+    check(env, napi_create_string_utf8(env, value.data(), value.size(), &result));
+    return result;
+}
+
+/**
+ * Copy a numeric column into a new typed array. The buffer is allocated
+ * by V8: Electron does not allow external (addon-owned) ArrayBuffers.
+ */
+template <typename T>
+napi_value typedArray(napi_env env, const std::vector<T>& values, napi_typedarray_type type) {
+    void* data = nullptr;
+    napi_value buffer = nullptr;
+    check(env, napi_create_arraybuffer(env, values.size() * sizeof(T), &data, &buffer));
+    if (!values.empty()) {
+        std::memcpy(data, values.data(), values.size() * sizeof(T));
+    }
+    napi_value result = nullptr;
+    check(env, napi_create_typedarray(env, type, values.size(), buffer, 0, &result));
+    return result;
+}
+
+/**
+ * A TEXT column as a JS array of strings and nulls
+ */
+inline napi_value textArray(napi_env env, const TextColumn& values) {
+    napi_value result = nullptr;
+    napi_value null = nullptr;
+    check(env, napi_create_array_with_length(env, values.size(), &result));
+    check(env, napi_get_null(env, &null));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        napi_value element = values[i] ? string(env, *values[i]) : null;
+        check(env, napi_set_element(env, result, static_cast<std::uint32_t>(i), element));
+    }
+    return result;
+}
+
+}  // namespace devtrack::napi
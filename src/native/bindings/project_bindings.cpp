@@ -0,0 +1,39 @@
+#include "bindings/bindings.hpp"
+
+namespace devtrack {
+
+namespace {
+
+napi_value projectColumnsToJs(napi_env env, const ProjectColumns& columns) {
+    using namespace napi;
+    napi_value result = object(env);
+    setNamed(env, result, "length", number(env, static_cast<double>(columns.size())));
+    setNamed(env, result, "id", typedArray(env, columns.id, napi_int32_array));
+    setNamed(env, result, "name", textArray(env, columns.name));
+    setNamed(env, result, "description", textArray(env, columns.description));
+    setNamed(env, result, "status", textArray(env, columns.status));
+    setNamed(env, result, "color", textArray(env, columns.color));
+    setNamed(env, result, "icon", textArray(env, columns.icon));
+    setNamed(env, result, "createdAt", textArray(env, columns.createdAt));
+    setNamed(env, result, "updatedAt", textArray(env, columns.updatedAt));
+    setNamed(env, result, "conceptWhat", textArray(env, columns.conceptWhat));
+    setNamed(env, result, "conceptHow", textArray(env, columns.conceptHow));
+    setNamed(env, result, "conceptWhere", textArray(env, columns.conceptWhere));
+    setNamed(env, result, "conceptWithWhat", textArray(env, columns.conceptWithWhat));
+    setNamed(env, result, "conceptWhen", textArray(env, columns.conceptWhen));
+    setNamed(env, result, "conceptWhy", textArray(env, columns.conceptWhy));
+    return result;
+}
+
+}  // namespace
+
+/**
+ * findAllProjectsColumnar(): ProjectColumns
+ */
+napi_value FindAllProjectsColumnar(napi_env env, napi_callback_info) {
+    return napi::guard(env, [&] {
+        return projectColumnsToJs(env, openState(env).projects->findAllColumnar());
+    });
+}
+
+}  // namespace devtrack
@@ -0,0 +1,41 @@
+#include "bindings/bindings.hpp"
+
+namespace devtrack {
+
+namespace {
+
+napi_value taskColumnsToJs(napi_env env, const TaskColumns& columns) {
+    using namespace napi;
+    napi_value result = object(env);
+    setNamed(env, result, "length", number(env, static_cast<double>(columns.size())));
+    setNamed(env, result, "id", typedArray(env, columns.id, napi_int32_array));
+    setNamed(env, result, "projectId", typedArray(env, columns.projectId, napi_int32_array));
+    setNamed(env, result, "position", typedArray(env, columns.position, napi_float64_array));
+    setNamed(env, result, "status", typedArray(env, columns.status, napi_uint8_array));
+    setNamed(env, result, "priority", typedArray(env, columns.priority, napi_uint8_array));
+    setNamed(env, result, "title", textArray(env, columns.title));
+    setNamed(env, result, "description", textArray(env, columns.description));
+    setNamed(env, result, "assignedTo", textArray(env, columns.assignedTo));
+    setNamed(env, result, "startDate", textArray(env, columns.startDate));
+    setNamed(env, result, "dueDate", textArray(env, columns.dueDate));
+    setNamed(env, result, "createdAt", textArray(env, columns.createdAt));
+    setNamed(env, result, "updatedAt", textArray(env, columns.updatedAt));
+    setNamed(env, result, "completedAt", textArray(env, columns.completedAt));
+    setNamed(env, result, "tags", textArray(env, columns.tags));
+    return result;
+}
+
+}  // namespace
+
+/**
+ * findTasksByProjectIdColumnar(projectId: number): TaskColumns
+ */
+napi_value FindTasksByProjectIdColumnar(napi_env env, napi_callback_info info) {
+    return napi::guard(env, [&] {
+        const auto argv = napi::arguments(env, info, 1);
+        const std::int64_t projectId = napi::toInt64(env, argv[0]);
+        return taskColumnsToJs(env, openState(env).tasks->findByProjectIdColumnar(projectId));
+    });
+}
+
+}  // namespace devtrack
@@ -0,0 +1,43 @@
+#include "database/project_repository.hpp"
+
+namespace devtrack {
+
+namespace {
+
+// Keep in sync with COLUMNAR_PROJECT_SQL in src/main/repositories/ProjectRepository.ts
+constexpr const char* kAllProjectsSql = R"sql(
+  SELECT id, name, description, status, color, icon, created_at, updated_at,
+         concept_what, concept_how, concept_where, concept_with_what, concept_when, concept_why
+  FROM projects ORDER BY updated_at DESC
+)sql";
+
+}  // namespace
+
+ProjectRepository::ProjectRepository(const SqliteConnection& connection)
+    : all_(connection.prepare(kAllProjectsSql)) {}
+
+ProjectColumns ProjectRepository::findAllColumnar() {
+    ProjectColumns columns;
+    all_.reset();
+
+    while (all_.step()) {
+        columns.id.push_back(static_cast<std::int32_t>(all_.columnInt(0)));
+        columns.name.push_back(all_.columnText(1));
+        columns.description.push_back(all_.columnText(2));
+        columns.status.push_back(all_.columnText(3));
+        columns.color.push_back(all_.columnText(4));
+        columns.icon.push_back(all_.columnText(5));
+        columns.createdAt.push_back(all_.columnText(6));
+        columns.updatedAt.push_back(all_.columnText(7));
+        columns.conceptWhat.push_back(all_.columnText(8));
+        columns.conceptHow.push_back(all_.columnText(9));
+        columns.conceptWhere.push_back(all_.columnText(10));
+        columns.conceptWithWhat.push_back(all_.columnText(11));
+        columns.conceptWhen.push_back(all_.columnText(12));
+        columns.conceptWhy.push_back(all_.columnText(13));
+    }
+    all_.reset();
+    return columns;
+}
+
+}  // namespace devtrack
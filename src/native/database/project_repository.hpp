@@ -0,0 +1,21 @@
+#pragma once
+
+#include "database/sqlite_connection.hpp"
+#include "models/columns.hpp"
+
+namespace devtrack {
+
+/**
+ * Native counterpart of ProjectRepository.findAllColumnar
+ */
+class ProjectRepository {
+public:
+    explicit ProjectRepository(const SqliteConnection& connection);
+
+    [[nodiscard]] ProjectColumns findAllColumnar();
+
+private:
+    Statement all_;
+};
+
+}  // namespace devtrack
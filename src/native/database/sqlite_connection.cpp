@@ -0,0 +1,89 @@
+#include "database/sqlite_connection.hpp"
+
+#include <utility>
+
+namespace devtrack {
+
+namespace {
+
+[[noreturn]] void throwSqlite(sqlite3* db, int code) {
+    std::string message = db ? sqlite3_errmsg(db) : sqlite3_errstr(code);
+    throw SqliteError(code, "SQLite error " + std::to_string(code) + ": " + message);
+}
+
+}  // namespace
+
+Statement::Statement(sqlite3* db, std::string_view sql) : db_(db) {
+    const int rc = sqlite3_prepare_v3(db_, sql.data(), static_cast<int>(sql.size()),
+                                      SQLITE_PREPARE_PERSISTENT, &stmt_, nullptr);
+    if (rc != SQLITE_OK) {
+        throwSqlite(db_, rc);
+    }
+}
+
+Statement::~Statement() {
+    sqlite3_finalize(stmt_);
+}
+
+Statement::Statement(Statement&& other) noexcept
+    : db_(other.db_), stmt_(std::exchange(other.stmt_, nullptr)) {}
+
+void Statement::reset() {
+    sqlite3_reset(stmt_);
+    sqlite3_clear_bindings(stmt_);
+}
+
+void Statement::bind(int index, std::int64_t value) {
+    const int rc = sqlite3_bind_int64(stmt_, index, value);
+    if (rc != SQLITE_OK) {
+        throwSqlite(db_, rc);
+    }
+}
+
+bool Statement::step() {
+    const int rc = sqlite3_step(stmt_);
+    if (rc == SQLITE_ROW) {
+        return true;
+    }
+    if (rc == SQLITE_DONE) {
+        return false;
+    }
+    throwSqlite(db_, rc);
+}
+
+std::int64_t Statement::columnInt(int index) const {
+    return sqlite3_column_int64(stmt_, index);
+}
+
+double Statement::columnDouble(int index) const {
+    return sqlite3_column_double(stmt_, index);
+}
+
+std::optional<std::string> Statement::columnText(int index) const {
+    if (sqlite3_column_type(stmt_, index) == SQLITE_NULL) {
+        return std::nullopt;
+    }
+    const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt_, index));
+    return std::string(text, static_cast<std::size_t>(sqlite3_column_bytes(stmt_, index)));
+}
+
+SqliteConnection::SqliteConnection(const std::string& path, int busyTimeoutMs) {
+    const int rc = sqlite3_open_v2(path.c_str(), &db_, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr);
+    if (rc != SQLITE_OK) {
+        std::string message = db_ ? sqlite3_errmsg(db_) : sqlite3_errstr(rc);
+        sqlite3_close(db_);
+        db_ = nullptr;
+        throw SqliteError(rc, "Cannot open " + path + ": " + message);
+    }
+    sqlite3_busy_timeout(db_, busyTimeoutMs);
+}
+
+SqliteConnection::~SqliteConnection() {
+    sqlite3_close_v2(db_);
+}
+
+Statement SqliteConnection::prepare(std::string_view sql) const {
+    return Statement(db_, sql);
+}
+
+}  // namespace devtrack
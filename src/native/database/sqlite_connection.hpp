@@ -0,0 +1,74 @@
+#pragma once
+
+#include <sqlite3.h>
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace devtrack {
+
+/**
+ * A failed SQLite call; the bindings rethrow it as a JS Error
+ */
+class SqliteError : public std::runtime_error {
+public:
+    SqliteError(int code, const std::string& message) : std::runtime_error(message), code_(code) {}
+
+    [[nodiscard]] int code() const noexcept { return code_; }
+
+private:
+    int code_;
+};
+
+/**
+ * Prepared statement, reset and reused across calls
+ */
+class Statement {
+public:
+    Statement(sqlite3* db, std::string_view sql);
+    ~Statement();
+
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
+    Statement(Statement&& other) noexcept;
+    Statement& operator=(Statement&&) = delete;
+
+    /** Clear bindings and rewind, ready for the next execution */
+    void reset();
+    void bind(int index, std::int64_t value);
+
+    /** Advance to the next row; false once the statement is done */
+    bool step();
+
+    [[nodiscard]] std::int64_t columnInt(int index) const;
+    [[nodiscard]] double columnDouble(int index) const;
+    [[nodiscard]] std::optional<std::string> columnText(int index) const;
+
+private:
+    sqlite3* db_;
+    sqlite3_stmt* stmt_ = nullptr;
+};
+
+/**
+ * Read-only connection to the DevTrack database file. The TypeScript side
+ * keeps the only writer; in WAL mode this reads alongside it like the
+ * better-sqlite3 read pool.
+ */
+class SqliteConnection {
+public:
+    explicit SqliteConnection(const std::string& path, int busyTimeoutMs = 5000);
+    ~SqliteConnection();
+
+    SqliteConnection(const SqliteConnection&) = delete;
+    SqliteConnection& operator=(const SqliteConnection&) = delete;
+
+    [[nodiscard]] Statement prepare(std::string_view sql) const;
+
+private:
+    sqlite3* db_ = nullptr;
+};
+
+}  // namespace devtrack
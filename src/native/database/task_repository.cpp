@@ -0,0 +1,69 @@
+#include "database/task_repository.hpp"
+
+#include <optional>
+
+namespace devtrack {
+
+namespace {
+
+// Keep in sync with COLUMNAR_TASK_SQL in src/main/repositories/TaskRepository.ts
+constexpr const char* kTasksByProjectSql = R"sql(
+  SELECT id, project_id, position, status, priority, title, description,
+         assigned_to, start_date, due_date, created_at, updated_at, completed_at, tags
+  FROM tasks WHERE project_id = ? ORDER BY position, created_at, id
+)sql";
+
+std::unordered_map<std::string, std::uint8_t> dictionary(const std::vector<std::string>& values) {
+    std::unordered_map<std::string, std::uint8_t> codes;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        codes.emplace(values[i], static_cast<std::uint8_t>(i));
+    }
+    return codes;
+}
+
+// Unknown values decode as the first entry, like the TypeScript fallback
+std::uint8_t encode(const std::unordered_map<std::string, std::uint8_t>& codes,
+                    const std::optional<std::string>& value) {
+    if (!value) {
+        return 0;
+    }
+    const auto it = codes.find(*value);
+    return it == codes.end() ? 0 : it->second;
+}
+
+}  // namespace
+
+TaskRepository::TaskRepository(const SqliteConnection& connection,
+                               const std::vector<std::string>& statuses,
+                               const std::vector<std::string>& priorities)
+    : byProject_(connection.prepare(kTasksByProjectSql)),
+      statusCodes_(dictionary(statuses)),
+      priorityCodes_(dictionary(priorities)) {}
+
+TaskColumns TaskRepository::findByProjectIdColumnar(std::int64_t projectId) {
+    TaskColumns columns;
+    byProject_.reset();
+    byProject_.bind(1, projectId);
+
+    while (byProject_.step()) {
+        columns.id.push_back(static_cast<std::int32_t>(byProject_.columnInt(0)));
+        columns.projectId.push_back(static_cast<std::int32_t>(byProject_.columnInt(1)));
+        columns.position.push_back(byProject_.columnDouble(2));
+        columns.status.push_back(encode(statusCodes_, byProject_.columnText(3)));
+        columns.priority.push_back(encode(priorityCodes_, byProject_.columnText(4)));
+        columns.title.push_back(byProject_.columnText(5));
+        columns.description.push_back(byProject_.columnText(6));
+        columns.assignedTo.push_back(byProject_.columnText(7));
+        columns.startDate.push_back(byProject_.columnText(8));
+        columns.dueDate.push_back(byProject_.columnText(9));
+        columns.createdAt.push_back(byProject_.columnText(10));
+        columns.updatedAt.push_back(byProject_.columnText(11));
+        columns.completedAt.push_back(byProject_.columnText(12));
+        columns.tags.push_back(byProject_.columnText(13));
+    }
+    // Release the read snapshot so the writer can checkpoint past it
+    byProject_.reset();
+    return columns;
+}
+
+}  // namespace devtrack
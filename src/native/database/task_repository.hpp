@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "database/sqlite_connection.hpp"
+#include "models/columns.hpp"
+
+namespace devtrack {
+
+/**
+ * Native counterpart of TaskRepository.findByProjectIdColumnar: same
+ * query, same ordering, same column layout
+ */
+class TaskRepository {
+public:
+    /**
+     * @param statuses TASK_STATUS_VALUES, in dictionary order
+     * @param priorities TASK_PRIORITY_VALUES, in dictionary order
+     */
+    TaskRepository(const SqliteConnection& connection,
+                   const std::vector<std::string>& statuses,
+                   const std::vector<std::string>& priorities);
+
+    [[nodiscard]] TaskColumns findByProjectIdColumnar(std::int64_t projectId);
+
+private:
+    Statement byProject_;
+    std::unordered_map<std::string, std::uint8_t> statusCodes_;
+    std::unordered_map<std::string, std::uint8_t> priorityCodes_;
+};
+
+}  // namespace devtrack
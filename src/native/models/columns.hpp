@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace devtrack {
+
+// Nullable TEXT column
+using TextColumn = std::vector<std::optional<std::string>>;
+
+/**
+ * Column-oriented batch of tasks, laid out like TaskColumns in
+ * src/main/models/Task.ts. status/priority are indexes into the
+ * dictionaries passed to TaskRepository.
+ */
+struct TaskColumns {
+    std::vector<std::int32_t> id;
+    std::vector<std::int32_t> projectId;
+    std::vector<double> position;
+    std::vector<std::uint8_t> status;
+    std::vector<std::uint8_t> priority;
+    TextColumn title;
+    TextColumn description;
+    TextColumn assignedTo;
+    TextColumn startDate;
+    TextColumn dueDate;
+    TextColumn createdAt;
+    TextColumn updatedAt;
+    TextColumn completedAt;
+    TextColumn tags;
+
+    [[nodiscard]] std::size_t size() const noexcept { return id.size(); }
+};
+
+/**
+ * Column-oriented batch of projects, laid out like ProjectColumns in
+ * src/main/models/Project.ts
+ */
+struct ProjectColumns {
+    std::vector<std::int32_t> id;
+    TextColumn name;
+    TextColumn description;
+    TextColumn status;
+    TextColumn color;
+    TextColumn icon;
+    TextColumn createdAt;
+    TextColumn updatedAt;
+    TextColumn conceptWhat;
+    TextColumn conceptHow;
+    TextColumn conceptWhere;
+    TextColumn conceptWithWhat;
+    TextColumn conceptWhen;
+    TextColumn conceptWhy;
+
+    [[nodiscard]] std::size_t size() const noexcept { return id.size(); }
+};
+
+}  // namespace devtrack
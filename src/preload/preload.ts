@@ -1,19 +1,21 @@
-import { contextBridge, ipcRenderer } from 'electron';
+import { contextBridge, ipcRenderer, IpcRendererEvent } from 'electron';
 
 // Import types from main process models
 import type { 
-  Project, CreateProjectData, UpdateProjectData,
-  Task, CreateTaskData, UpdateTaskData,
+  Project, CreateProjectData, UpdateProjectData, ProjectColumns,
+  Task, CreateTaskData, UpdateTaskData, TaskColumns, TaskPage, TaskPageOptions, TaskStreamChunk, TaskStreamHandle,
+  TaskBulkUpdate, TaskMoveOptions, TaskLabelChanges, TaskBulkResult, TaskBulkLabelResult,
   Comment, CreateCommentData, UpdateCommentData,
   Label, CreateLabelData, UpdateLabelData,
   Attachment, CreateAttachmentData,
   CustomField, CreateCustomFieldData, UpdateCustomFieldData, TaskCustomValue,
-  TaskDependency, CreateTaskDependencyData, TaskDependencyWithDetails,
+  TaskDependency, CreateTaskDependencyData, TaskDependencyWithDetails, CriticalPath,
   User, CreateUserData, UpdateUserData,
   Role, CreateRoleData, UpdateRoleData,
   Permission, CreatePermissionData,
   ProjectMember, CreateProjectMemberData, ProjectMemberWithDetails,
-  Notification, CreateNotificationData, NotificationType,
+  Notification, CreateNotificationData, NotificationType, NotificationDelta,
+  ChangeBatch, ChangesSinceResult,
   ProjectTemplate, CreateProjectTemplateData, UpdateProjectTemplateData, ProjectTemplateWithTasks,
   TaskTemplate, CreateTaskTemplateData, UpdateTaskTemplateData,
   TimeEntry, CreateTimeEntryData, UpdateTimeEntryData, TimeEntryWithDetails, TimeTrackingStats,
@@ -21,15 +23,32 @@ import type {
   AutomationLog, TriggerType, ActionType,
   TaskStatusReport, TaskPriorityReport, ProjectProgressReport, UserWorkloadReport,
   TimeTrackingReport, TaskCompletionTrend, ProjectStatistics, UserStatistics, TimeStatistics,
-  DateRange, ReportFilters,
+  DateRange, ReportFilters, ReportRequestOptions,
+  SearchOptions, SearchResultPage,
   AppSettings,
   VisionBoard, VisionBoardNode, VisionBoardConnection, VisionBoardGroup,
   CreateVisionBoardData, UpdateVisionBoardData,
   CreateVisionBoardNodeData, UpdateVisionBoardNodeData,
   CreateVisionBoardConnectionData, UpdateVisionBoardConnectionData,
   CreateVisionBoardGroupData, UpdateVisionBoardGroupData,
-  VisionBoardTemplate, VisionBoardType, VisionBoardStatus
+  VisionBoardTemplate, VisionBoardType, VisionBoardStatus,
+  VisionBoardViewport, VisionBoardViewportData, VisionBoardOperation,
+  ExportRequest, ExportOptions, ExportProgress, ExportResult,
+  DiagnosticsSettings, DiagnosticsSnapshot
 } from '../main/models';
+import type { QueryPlanReport } from '../main/database/queryPlanCheck';
+import type { PermissionCacheStats } from '../main/services/PermissionCache';
+
+// 'task:streamChunk' listeners of running streams, so cancelStream can
+// stop delivering chunks immediately
+const taskStreamListeners = new Map<string, (event: IpcRendererEvent, chunk: TaskStreamChunk) => void>();
+
+function stopTaskStreamListener(streamId: string): void {
+  const listener = taskStreamListeners.get(streamId);
+  if (!listener) return;
+  ipcRenderer.removeListener('task:streamChunk', listener);
+  taskStreamListeners.delete(streamId);
+}
 
 // Expose protected methods that allow the renderer process to use
 // the ipcRenderer without exposing the entire object
@@ -49,6 +68,7 @@ contextBridge.exposeInMainWorld('electronAPI', {
     create: (data: CreateProjectData) => ipcRenderer.invoke('project:create', data),
     findById: (id: number) => ipcRenderer.invoke('project:findById', id),
     findAll: () => ipcRenderer.invoke('project:findAll'),
+    findAllColumnar: () => ipcRenderer.invoke('project:findAll', { columnar: true }),
     update: (id: number, data: UpdateProjectData) => ipcRenderer.invoke('project:update', id, data),
     delete: (id: number) => ipcRenderer.invoke('project:delete', id),
   },
@@ -58,7 +78,33 @@ contextBridge.exposeInMainWorld('electronAPI', {
     create: (data: CreateTaskData) => ipcRenderer.invoke('task:create', data),
     findById: (id: number) => ipcRenderer.invoke('task:findById', id),
     findByProjectId: (projectId: number) => ipcRenderer.invoke('task:findByProjectId', projectId),
+    findByProjectIdColumnar: (projectId: number) => ipcRenderer.invoke('task:findByProjectId', projectId, { columnar: true }),
+    findPageByProjectId: (projectId: number, options?: TaskPageOptions) =>
+      ipcRenderer.invoke('task:findPageByProjectId', projectId, options),
+    streamByProjectId: (projectId: number, onChunk: (chunk: TaskStreamChunk) => void, chunkSize?: number): TaskStreamHandle => {
+      const streamId = `${Date.now()}-${Math.random().toString(36).slice(2)}`;
+      const listener = (_event: IpcRendererEvent, chunk: TaskStreamChunk) => {
+        if (chunk.streamId !== streamId) return;
+        if (chunk.done) stopTaskStreamListener(streamId);
+        onChunk(chunk);
+      };
+      taskStreamListeners.set(streamId, listener);
+      ipcRenderer.on('task:streamChunk', listener);
+      const done = ipcRenderer.invoke('task:streamByProjectId', streamId, projectId, chunkSize)
+        .catch((error) => {
+          stopTaskStreamListener(streamId);
+          throw error;
+        });
+      return { streamId, done };
+    },
+    cancelStream: (streamId: string) => {
+      stopTaskStreamListener(streamId);
+      return ipcRenderer.invoke('task:cancelStream', streamId);
+    },
     update: (id: number, data: UpdateTaskData) => ipcRenderer.invoke('task:update', id, data),
+    bulkUpdate: (items: TaskBulkUpdate[]) => ipcRenderer.invoke('task:bulkUpdate', items),
+    bulkMove: (taskIds: number[], options?: TaskMoveOptions) => ipcRenderer.invoke('task:bulkMove', taskIds, options),
+    bulkLabel: (taskIds: number[], labels: TaskLabelChanges) => ipcRenderer.invoke('task:bulkLabel', taskIds, labels),
     delete: (id: number) => ipcRenderer.invoke('task:delete', id),
     addLabel: (taskId: number, labelId: number) => ipcRenderer.invoke('task:addLabel', taskId, labelId),
     removeLabel: (taskId: number, labelId: number) => ipcRenderer.invoke('task:removeLabel', taskId, labelId),
@@ -127,6 +173,9 @@ contextBridge.exposeInMainWorld('electronAPI', {
     getBlockingTasks: (taskId: number) => ipcRenderer.invoke('dependency:getBlockingTasks', taskId),
     getBlockedTasks: (taskId: number) => ipcRenderer.invoke('dependency:getBlockedTasks', taskId),
     hasBlockingDependencies: (taskId: number) => ipcRenderer.invoke('dependency:hasBlockingDependencies', taskId),
+    getTransitiveBlockers: (taskId: number) => ipcRenderer.invoke('dependency:getTransitiveBlockers', taskId),
+    getTopologicalOrder: (projectId: number) => ipcRenderer.invoke('dependency:getTopologicalOrder', projectId),
+    getCriticalPath: (projectId: number) => ipcRenderer.invoke('dependency:getCriticalPath', projectId),
   },
 
   // User operations
@@ -162,6 +211,10 @@ contextBridge.exposeInMainWorld('electronAPI', {
     findAll: () => ipcRenderer.invoke('permission:findAll'),
     findByResource: (resource: string) => ipcRenderer.invoke('permission:findByResource', resource),
     delete: (id: number) => ipcRenderer.invoke('permission:delete', id),
+    getEffective: (userId: number, projectId: number) => ipcRenderer.invoke('permission:getEffective', userId, projectId),
+    check: (userId: number, projectId: number, permission: string) =>
+      ipcRenderer.invoke('permission:check', userId, projectId, permission),
+    getCacheStats: () => ipcRenderer.invoke('permission:getCacheStats'),
   },
 
   // Project member operations
@@ -196,6 +249,17 @@ contextBridge.exposeInMainWorld('electronAPI', {
     findByType: (userId: number, type: NotificationType, limit?: number) => ipcRenderer.invoke('notification:findByType', userId, type, limit),
     findByProjectId: (userId: number, projectId: number, limit?: number) => ipcRenderer.invoke('notification:findByProjectId', userId, projectId, limit),
     findByTaskId: (userId: number, taskId: number, limit?: number) => ipcRenderer.invoke('notification:findByTaskId', userId, taskId, limit),
+    subscribe: (userId: number, onDelta: (delta: NotificationDelta) => void) => {
+      const listener = (_event: IpcRendererEvent, delta: NotificationDelta) => {
+        if (delta.userId === userId) onDelta(delta);
+      };
+      ipcRenderer.on('notification:delta', listener);
+      ipcRenderer.invoke('notification:subscribe', userId);
+      return () => {
+        ipcRenderer.removeListener('notification:delta', listener);
+        ipcRenderer.invoke('notification:unsubscribe');
+      };
+    },
   },
 
   // Time entry operations
@@ -235,15 +299,43 @@ contextBridge.exposeInMainWorld('electronAPI', {
 
   // Analytics operations
   analytics: {
-    getTaskStatusReport: (filters?: ReportFilters) => ipcRenderer.invoke('analytics:getTaskStatusReport', filters),
-    getTaskPriorityReport: (filters?: ReportFilters) => ipcRenderer.invoke('analytics:getTaskPriorityReport', filters),
-    getProjectProgressReport: (projectIds?: number[]) => ipcRenderer.invoke('analytics:getProjectProgressReport', projectIds),
-    getUserWorkloadReport: (userIds?: number[]) => ipcRenderer.invoke('analytics:getUserWorkloadReport', userIds),
-    getTimeTrackingReport: (dateRange?: DateRange, filters?: ReportFilters) => ipcRenderer.invoke('analytics:getTimeTrackingReport', dateRange, filters),
-    getTaskCompletionTrend: (dateRange?: DateRange, projectId?: number) => ipcRenderer.invoke('analytics:getTaskCompletionTrend', dateRange, projectId),
-    getProjectStatistics: () => ipcRenderer.invoke('analytics:getProjectStatistics'),
-    getUserStatistics: () => ipcRenderer.invoke('analytics:getUserStatistics'),
-    getTimeStatistics: (dateRange?: DateRange) => ipcRenderer.invoke('analytics:getTimeStatistics', dateRange),
+    getTaskStatusReport: (filters?: ReportFilters, options?: ReportRequestOptions) => ipcRenderer.invoke('analytics:getTaskStatusReport', filters, options),
+    getTaskPriorityReport: (filters?: ReportFilters, options?: ReportRequestOptions) => ipcRenderer.invoke('analytics:getTaskPriorityReport', filters, options),
+    getProjectProgressReport: (projectIds?: number[], options?: ReportRequestOptions) => ipcRenderer.invoke('analytics:getProjectProgressReport', projectIds, options),
+    getUserWorkloadReport: (userIds?: number[], options?: ReportRequestOptions) => ipcRenderer.invoke('analytics:getUserWorkloadReport', userIds, options),
+    getTimeTrackingReport: (dateRange?: DateRange, filters?: ReportFilters, options?: ReportRequestOptions) => ipcRenderer.invoke('analytics:getTimeTrackingReport', dateRange, filters, options),
+    getTaskCompletionTrend: (dateRange?: DateRange, projectId?: number, options?: ReportRequestOptions) => ipcRenderer.invoke('analytics:getTaskCompletionTrend', dateRange, projectId, options),
+    getProjectStatistics: (options?: ReportRequestOptions) => ipcRenderer.invoke('analytics:getProjectStatistics', options),
+    getUserStatistics: (options?: ReportRequestOptions) => ipcRenderer.invoke('analytics:getUserStatistics', options),
+    getTimeStatistics: (dateRange?: DateRange, options?: ReportRequestOptions) => ipcRenderer.invoke('analytics:getTimeStatistics', dateRange, options),
+    cancel: (requestId: string) => ipcRenderer.invoke('report:cancel', requestId),
+  },
+
+  // Entity change feed
+  changes: {
+    subscribe: (onBatch: (batch: ChangeBatch) => void) => {
+      const listener = (_event: IpcRendererEvent, batch: ChangeBatch) => onBatch(batch);
+      ipcRenderer.on('changes:batch', listener);
+      return {
+        version: ipcRenderer.invoke('changes:subscribe') as Promise<number>,
+        unsubscribe: () => {
+          ipcRenderer.removeListener('changes:batch', listener);
+          ipcRenderer.invoke('changes:unsubscribe');
+        },
+      };
+    },
+    since: (version: number, projectId?: number) => ipcRenderer.invoke('changes:since', version, projectId),
+  },
+
+  // Full-text search operations
+  search: {
+    query: (options: SearchOptions) => ipcRenderer.invoke('search:query', options),
+    rebuildIndex: () => ipcRenderer.invoke('search:rebuildIndex'),
+  },
+
+  // Database diagnostics
+  database: {
+    checkQueryPlans: () => ipcRenderer.invoke('database:checkQueryPlans'),
   },
 
   // Settings operations
@@ -316,6 +408,8 @@ contextBridge.exposeInMainWorld('electronAPI', {
     deleteNode: (id: number) => ipcRenderer.invoke('visionBoard:deleteNode', id),
     bulkUpdateNodePositions: (updates: Array<{ id: number; x: number; y: number }>) => 
       ipcRenderer.invoke('visionBoard:bulkUpdateNodePositions', updates),
+    applyOperations: (boardId: number, ops: VisionBoardOperation[]) =>
+      ipcRenderer.invoke('visionBoard:applyOperations', boardId, ops),
     
     // Connections
     createConnection: (data: CreateVisionBoardConnectionData) => ipcRenderer.invoke('visionBoard:createConnection', data),
@@ -334,10 +428,36 @@ contextBridge.exposeInMainWorld('electronAPI', {
     
     // Helpers
     getBoardData: (boardId: number) => ipcRenderer.invoke('visionBoard:getBoardData', boardId),
+    getViewport: (boardId: number, viewport: VisionBoardViewport, margin?: number) =>
+      ipcRenderer.invoke('visionBoard:getViewport', boardId, viewport, margin),
     exportToJSON: (boardId: number) => ipcRenderer.invoke('visionBoard:exportToJSON', boardId),
     importFromJSON: (json: string, userId: number, newName?: string) => 
       ipcRenderer.invoke('visionBoard:importFromJSON', json, userId, newName),
   },
+
+  // Streaming exports (audit logs, time entries, compliance data, vision boards)
+  export: {
+    toFile: (request: ExportRequest, options: ExportOptions, onProgress?: (progress: ExportProgress) => void) => {
+      if (!onProgress) return ipcRenderer.invoke('export:toFile', request, options);
+      const exportId = options.exportId ?? `${Date.now()}-${Math.random().toString(36).slice(2)}`;
+      const listener = (_event: IpcRendererEvent, progress: ExportProgress) => {
+        if (progress.exportId === exportId) onProgress(progress);
+      };
+      ipcRenderer.on('export:progress', listener);
+      return ipcRenderer.invoke('export:toFile', request, { ...options, exportId })
+        .finally(() => ipcRenderer.removeListener('export:progress', listener));
+    },
+    cancel: (exportId: string) => ipcRenderer.invoke('export:cancel', exportId),
+  },
+
+  // Latency metrics and trace export
+  diagnostics: {
+    getSnapshot: (limit?: number) => ipcRenderer.invoke('diagnostics:getSnapshot', limit),
+    configure: (changes: Partial<DiagnosticsSettings>) => ipcRenderer.invoke('diagnostics:configure', changes),
+    reset: () => ipcRenderer.invoke('diagnostics:reset'),
+    getPrometheus: () => ipcRenderer.invoke('diagnostics:getPrometheus'),
+    exportTrace: () => ipcRenderer.invoke('diagnostics:exportTrace'),
+  },
 });
 
 
@@ -358,6 +478,7 @@ export interface ElectronAPI {
     create: (data: CreateProjectData) => Promise<Project>;
     findById: (id: number) => Promise<Project | undefined>;
     findAll: () => Promise<Project[]>;
+    findAllColumnar: () => Promise<ProjectColumns>;
     update: (id: number, data: UpdateProjectData) => Promise<Project | undefined>;
     delete: (id: number) => Promise<boolean>;
   };
@@ -367,7 +488,14 @@ export interface ElectronAPI {
     create: (data: CreateTaskData) => Promise<Task>;
     findById: (id: number) => Promise<Task | undefined>;
     findByProjectId: (projectId: number) => Promise<Task[]>;
+    findByProjectIdColumnar: (projectId: number) => Promise<TaskColumns>;
+    findPageByProjectId: (projectId: number, options?: TaskPageOptions) => Promise<TaskPage>;
+    streamByProjectId: (projectId: number, onChunk: (chunk: TaskStreamChunk) => void, chunkSize?: number) => TaskStreamHandle;
+    cancelStream: (streamId: string) => Promise<boolean>;
     update: (id: number, data: UpdateTaskData) => Promise<Task | undefined>;
+    bulkUpdate: (items: TaskBulkUpdate[]) => Promise<TaskBulkResult>;
+    bulkMove: (taskIds: number[], options?: TaskMoveOptions) => Promise<TaskBulkResult>;
+    bulkLabel: (taskIds: number[], labels: TaskLabelChanges) => Promise<TaskBulkLabelResult>;
     delete: (id: number) => Promise<boolean>;
     addLabel: (taskId: number, labelId: number) => Promise<void>;
     removeLabel: (taskId: number, labelId: number) => Promise<void>;
@@ -432,6 +560,9 @@ export interface ElectronAPI {
     getBlockingTasks: (taskId: number) => Promise<number[]>;
     getBlockedTasks: (taskId: number) => Promise<number[]>;
     hasBlockingDependencies: (taskId: number) => Promise<boolean>;
+    getTransitiveBlockers: (taskId: number) => Promise<number[]>;
+    getTopologicalOrder: (projectId: number) => Promise<number[]>;
+    getCriticalPath: (projectId: number) => Promise<CriticalPath>;
   };
 
   // User operations
@@ -467,6 +598,9 @@ export interface ElectronAPI {
     findAll: () => Promise<Permission[]>;
     findByResource: (resource: string) => Promise<Permission[]>;
     delete: (id: number) => Promise<boolean>;
+    getEffective: (userId: number, projectId: number) => Promise<string[]>;
+    check: (userId: number, projectId: number, permission: string) => Promise<boolean>;
+    getCacheStats: () => Promise<PermissionCacheStats>;
   };
 
   // Project member operations
@@ -501,6 +635,8 @@ export interface ElectronAPI {
     findByType: (userId: number, type: NotificationType, limit?: number) => Promise<Notification[]>;
     findByProjectId: (userId: number, projectId: number, limit?: number) => Promise<Notification[]>;
     findByTaskId: (userId: number, taskId: number) => Promise<Notification[]>;
+    /** Receive the user's notification changes as they happen; returns an unsubscribe function */
+    subscribe: (userId: number, onDelta: (delta: NotificationDelta) => void) => () => void;
   };
 
   // Project Template operations
@@ -579,15 +715,35 @@ export interface ElectronAPI {
 
   // Analytics operations
   analytics: {
-    getTaskStatusReport: (filters?: ReportFilters) => Promise<TaskStatusReport[]>;
-    getTaskPriorityReport: (filters?: ReportFilters) => Promise<TaskPriorityReport[]>;
-    getProjectProgressReport: (projectIds?: number[]) => Promise<ProjectProgressReport[]>;
-    getUserWorkloadReport: (userIds?: number[]) => Promise<UserWorkloadReport[]>;
-    getTimeTrackingReport: (dateRange?: DateRange, filters?: ReportFilters) => Promise<TimeTrackingReport[]>;
-    getTaskCompletionTrend: (dateRange?: DateRange, projectId?: number) => Promise<TaskCompletionTrend[]>;
-    getProjectStatistics: () => Promise<ProjectStatistics>;
-    getUserStatistics: () => Promise<UserStatistics>;
-    getTimeStatistics: (dateRange?: DateRange) => Promise<TimeStatistics>;
+    getTaskStatusReport: (filters?: ReportFilters, options?: ReportRequestOptions) => Promise<TaskStatusReport[]>;
+    getTaskPriorityReport: (filters?: ReportFilters, options?: ReportRequestOptions) => Promise<TaskPriorityReport[]>;
+    getProjectProgressReport: (projectIds?: number[], options?: ReportRequestOptions) => Promise<ProjectProgressReport[]>;
+    getUserWorkloadReport: (userIds?: number[], options?: ReportRequestOptions) => Promise<UserWorkloadReport[]>;
+    getTimeTrackingReport: (dateRange?: DateRange, filters?: ReportFilters, options?: ReportRequestOptions) => Promise<TimeTrackingReport[]>;
+    getTaskCompletionTrend: (dateRange?: DateRange, projectId?: number, options?: ReportRequestOptions) => Promise<TaskCompletionTrend[]>;
+    getProjectStatistics: (options?: ReportRequestOptions) => Promise<ProjectStatistics>;
+    getUserStatistics: (options?: ReportRequestOptions) => Promise<UserStatistics>;
+    getTimeStatistics: (dateRange?: DateRange, options?: ReportRequestOptions) => Promise<TimeStatistics>;
+    /** Cancel requests started with options.requestId; resolves with the number cancelled */
+    cancel: (requestId: string) => Promise<number>;
+  };
+
+  // Entity change feed
+  changes: {
+    /** Receive entity changes as batches; `version` resolves with the version batches continue from */
+    subscribe: (onBatch: (batch: ChangeBatch) => void) => { version: Promise<number>; unsubscribe: () => void };
+    since: (version: number, projectId?: number) => Promise<ChangesSinceResult>;
+  };
+
+  // Full-text search operations
+  search: {
+    query: (options: SearchOptions) => Promise<SearchResultPage>;
+    rebuildIndex: () => Promise<void>;
+  };
+
+  // Database diagnostics
+  database: {
+    checkQueryPlans: () => Promise<QueryPlanReport>;
   };
 
   // Settings operations
@@ -622,6 +778,7 @@ export interface ElectronAPI {
     updateNode: (id: number, data: UpdateVisionBoardNodeData) => Promise<VisionBoardNode | null>;
     deleteNode: (id: number) => Promise<boolean>;
     bulkUpdateNodePositions: (updates: Array<{ id: number; x: number; y: number }>) => Promise<void>;
+    applyOperations: (boardId: number, ops: VisionBoardOperation[]) => Promise<number>;
     
     // Connections
     createConnection: (data: CreateVisionBoardConnectionData) => Promise<VisionBoardConnection>;
@@ -644,7 +801,25 @@ export interface ElectronAPI {
       connections: VisionBoardConnection[];
       groups: VisionBoardGroup[];
     } | null>;
+    getViewport: (boardId: number, viewport: VisionBoardViewport, margin?: number) =>
+      Promise<VisionBoardViewportData | null>;
     exportToJSON: (boardId: number) => Promise<string | null>;
     importFromJSON: (json: string, userId: number, newName?: string) => Promise<VisionBoard | null>;
   };
+
+  // Streaming exports; resolve with null if the save dialog is dismissed
+  export: {
+    toFile: (request: ExportRequest, options: ExportOptions, onProgress?: (progress: ExportProgress) => void) =>
+      Promise<ExportResult | null>;
+    cancel: (exportId: string) => Promise<boolean>;
+  };
+
+  // Latency metrics; exportTrace resolves with null if the save dialog is dismissed
+  diagnostics: {
+    getSnapshot: (limit?: number) => Promise<DiagnosticsSnapshot>;
+    configure: (changes: Partial<DiagnosticsSettings>) => Promise<DiagnosticsSettings>;
+    reset: () => Promise<void>;
+    getPrometheus: () => Promise<string>;
+    exportTrace: () => Promise<{ filePath: string; events: number } | null>;
+  };
 }
@@ -38,6 +38,7 @@ interface DependencyManagerProps {
 
 export default function DependencyManager({ open, onClose, taskId, projectId }: DependencyManagerProps) {
   const [dependencies, setDependencies] = useState<TaskDependencyWithDetails[]>([]);
+  const [transitiveBlockers, setTransitiveBlockers] = useState<number[]>([]);
   const [availableTasks, setAvailableTasks] = useState<Task[]>([]);
   const [selectedTask, setSelectedTask] = useState<Task | null>(null);
   const [dependencyType, setDependencyType] = useState<DependencyType>(DependencyType.Blocks);
@@ -54,8 +55,12 @@ export default function DependencyManager({ open, onClose, taskId, projectId }:
 
   const loadDependencies = async () => {
     try {
-      const deps = await window.electronAPI.dependency.findByTaskIdWithDetails(taskId);
+      const [deps, blockers] = await Promise.all([
+        window.electronAPI.dependency.findByTaskIdWithDetails(taskId),
+        window.electronAPI.dependency.getTransitiveBlockers(taskId),
+      ]);
       setDependencies(deps);
+      setTransitiveBlockers(blockers);
     } catch (err) {
       console.error('Failed to load dependencies:', err);
       setError('Failed to load dependencies');
@@ -223,9 +228,19 @@ export default function DependencyManager({ open, onClose, taskId, projectId }:
 
         {/* Existing dependencies */}
         <Box>
-          <Typography variant="subtitle2" gutterBottom>
-            Current Dependencies ({dependencies.length})
-          </Typography>
+          <Box sx={{ display: 'flex', alignItems: 'center', gap: 1, mb: 1 }}>
+            <Typography variant="subtitle2">
+              Current Dependencies ({dependencies.length})
+            </Typography>
+            {transitiveBlockers.length > 0 && (
+              <Chip
+                icon={<BlockIcon fontSize="small" />}
+                label={`Waits on ${transitiveBlockers.length} task${transitiveBlockers.length === 1 ? '' : 's'} in total`}
+                size="small"
+                variant="outlined"
+              />
+            )}
+          </Box>
           {dependencies.length === 0 ? (
             <Typography variant="body2" color="text.secondary" sx={{ py: 2, textAlign: 'center' }}>
               No dependencies yet. Add dependencies to link related tasks.
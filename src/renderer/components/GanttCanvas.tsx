@@ -0,0 +1,594 @@
+import React, { forwardRef, useCallback, useEffect, useImperativeHandle, useMemo, useRef } from 'react';
+import { Box } from '@mui/material';
+import { addDays, addMonths, differenceInDays, format, startOfDay, startOfMonth } from 'date-fns';
+import {
+  GanttTask,
+  ViewMode,
+  ROW_HEIGHT,
+  HEADER_HEIGHT,
+  TASK_BAR_HEIGHT,
+  LABEL_WIDTH,
+  MIN_BAR_WIDTH,
+  getDayWidth,
+  getTaskColor,
+  getTaskLabel,
+} from './ganttModel';
+
+interface GanttCanvasProps {
+  tasks: GanttTask[]; // in row order
+  taskIndex: Map<number, number>; // task id -> row
+  origin: Date; // day 0 of the timeline
+  totalDays: number;
+  viewMode: ViewMode;
+  criticalPath: Set<number>;
+  onTaskClick?: (taskId: number) => void;
+  onTaskMove?: (taskId: number, deltaDays: number) => void;
+}
+
+export interface GanttCanvasHandle {
+  zoomBy: (factor: number) => void;
+  scrollToDate: (date: Date) => void;
+}
+
+interface Column {
+  startDay: number;
+  endDay: number;
+  label?: string;
+  subLabel?: string;
+}
+
+type Drag =
+  | { kind: 'pan'; startX: number; startY: number; scrollX: number; scrollY: number; moved: boolean; row: number; onLabel: boolean }
+  | { kind: 'task'; startX: number; row: number; deltaDays: number; moved: boolean };
+
+const TILE_WIDTH = 512; // header tiles, CSS px
+const MAX_TILES = 64;
+const ROWS_PER_ARROW_TILE = 64;
+const MIN_ZOOM = 0.1;
+const MAX_ZOOM = 8;
+const DRAG_THRESHOLD = 3;
+
+/**
+ * Header columns overlapping [fromDay, toDay). Labels are only formatted
+ * when asked for; grid lines need just the boundaries.
+ */
+function columnsInRange(viewMode: ViewMode, origin: Date, fromDay: number, toDay: number, withLabels: boolean): Column[] {
+  const columns: Column[] = [];
+  if (viewMode === 'month') {
+    let month = startOfMonth(addDays(origin, fromDay));
+    let startDay = differenceInDays(month, origin);
+    while (startDay < toDay) {
+      const next = addMonths(month, 1);
+      const endDay = differenceInDays(next, origin);
+      columns.push({ startDay, endDay, label: withLabels ? format(month, 'MMM yyyy') : undefined });
+      month = next;
+      startDay = endDay;
+    }
+    return columns;
+  }
+
+  // origin is a week start, so weeks are every 7 days from day 0
+  const step = viewMode === 'day' ? 1 : 7;
+  for (let day = Math.floor(fromDay / step) * step; day < toDay; day += step) {
+    const column: Column = { startDay: day, endDay: day + step };
+    if (withLabels) {
+      const date = addDays(origin, day);
+      column.label = format(date, 'MMM d');
+      column.subLabel = viewMode === 'day' ? format(date, 'EEE') : `Week ${format(date, 'w')}`;
+    }
+    columns.push(column);
+  }
+  return columns;
+}
+
+function fillRoundRect(ctx: CanvasRenderingContext2D, x: number, y: number, width: number, height: number, radius: number) {
+  const r = Math.min(radius, width / 2, height / 2);
+  ctx.beginPath();
+  ctx.moveTo(x + r, y);
+  ctx.arcTo(x + width, y, x + width, y + height, r);
+  ctx.arcTo(x + width, y + height, x, y + height, r);
+  ctx.arcTo(x, y + height, x, y, r);
+  ctx.arcTo(x, y, x + width, y, r);
+  ctx.closePath();
+  ctx.fill();
+}
+
+/**
+ * Canvas Gantt renderer for large charts.
+ *
+ * Every frame draws only the rows and days in view, so cost does not grow
+ * with the number of tasks. Bar extents and dependency arrows are laid out
+ * once per data change: arrows are indexed by the row tiles they cross,
+ * and header columns are pre-rendered into fixed-width tiles that are
+ * blitted while panning. Scroll and zoom live in refs and are drawn on the
+ * next animation frame, so panning never re-renders React.
+ *
+ * Wheel scrolls (shift+wheel horizontally), ctrl/cmd+wheel zooms around
+ * the cursor, dragging the background pans and dragging a bar moves the
+ * task.
+ */
+const GanttCanvas = forwardRef<GanttCanvasHandle, GanttCanvasProps>(({
+  tasks,
+  taskIndex,
+  origin,
+  totalDays,
+  viewMode,
+  criticalPath,
+  onTaskClick,
+  onTaskMove,
+}, ref) => {
+  const containerRef = useRef<HTMLDivElement>(null);
+  const canvasRef = useRef<HTMLCanvasElement>(null);
+  const view = useRef({ scrollX: 0, scrollY: 0, zoom: 1, width: 0, height: 0, dpr: 1 });
+  const dragRef = useRef<Drag | null>(null);
+  const frameRef = useRef<number | null>(null);
+  const tilesRef = useRef<{ key: string; tiles: Map<number, HTMLCanvasElement> }>({ key: '', tiles: new Map() });
+
+  // Bar extents in days from origin (end exclusive) and the arrow index
+  const layout = useMemo(() => {
+    const count = tasks.length;
+    const startDays = new Int32Array(count);
+    const endDays = new Int32Array(count);
+    tasks.forEach((task, row) => {
+      startDays[row] = differenceInDays(task.startDate, origin);
+      endDays[row] = differenceInDays(task.dueDate, origin) + 1;
+    });
+
+    const arrows: Array<{ from: number; to: number; critical: boolean }> = [];
+    const arrowTiles = new Map<number, number[]>();
+    tasks.forEach((task, row) => {
+      for (const depId of task.dependsOn) {
+        const from = taskIndex.get(depId);
+        if (from === undefined) continue;
+        const id = arrows.length;
+        arrows.push({ from, to: row, critical: criticalPath.has(task.id) && criticalPath.has(depId) });
+        const lastTile = Math.floor(Math.max(from, row) / ROWS_PER_ARROW_TILE);
+        for (let tile = Math.floor(Math.min(from, row) / ROWS_PER_ARROW_TILE); tile <= lastTile; tile++) {
+          const list = arrowTiles.get(tile);
+          if (list) list.push(id);
+          else arrowTiles.set(tile, [id]);
+        }
+      }
+    });
+
+    return { startDays, endDays, arrows, arrowTiles };
+  }, [tasks, taskIndex, origin, criticalPath]);
+
+  // Latest props for the draw and event handlers, which are not re-created per render
+  const state = useRef({ tasks, layout, origin, totalDays, viewMode, criticalPath, onTaskClick, onTaskMove });
+  state.current = { tasks, layout, origin, totalDays, viewMode, criticalPath, onTaskClick, onTaskMove };
+
+  const dayWidth = () => getDayWidth(state.current.viewMode) * view.current.zoom;
+
+  const clampScroll = () => {
+    const v = view.current;
+    const maxX = Math.max(0, state.current.totalDays * dayWidth() - (v.width - LABEL_WIDTH));
+    const maxY = Math.max(0, state.current.tasks.length * ROW_HEIGHT - (v.height - HEADER_HEIGHT));
+    v.scrollX = Math.min(Math.max(0, v.scrollX), maxX);
+    v.scrollY = Math.min(Math.max(0, v.scrollY), maxY);
+  };
+
+  const barExtent = (row: number, dw: number) => {
+    const { startDays, endDays } = state.current.layout;
+    const x = startDays[row] * dw;
+    return { x, width: Math.max((endDays[row] - startDays[row]) * dw, MIN_BAR_WIDTH) };
+  };
+
+  const getHeaderTile = (tile: number, dw: number): HTMLCanvasElement => {
+    const { viewMode: mode, origin: start } = state.current;
+    const dpr = view.current.dpr;
+    const key = `${mode}:${dw}:${dpr}:${start.getTime()}`;
+    const cache = tilesRef.current;
+    if (cache.key !== key) {
+      cache.key = key;
+      cache.tiles.clear();
+    }
+    const cached = cache.tiles.get(tile);
+    if (cached) return cached;
+
+    const canvas = document.createElement('canvas');
+    canvas.width = Math.ceil(TILE_WIDTH * dpr);
+    canvas.height = Math.ceil(HEADER_HEIGHT * dpr);
+    const ctx = canvas.getContext('2d')!;
+    ctx.scale(dpr, dpr);
+    ctx.fillStyle = '#f5f5f5';
+    ctx.fillRect(0, 0, TILE_WIDTH, HEADER_HEIGHT);
+
+    const left = tile * TILE_WIDTH;
+    const todayDay = differenceInDays(startOfDay(new Date()), start);
+    const columns = columnsInRange(mode, start, Math.floor(left / dw), Math.ceil((left + TILE_WIDTH) / dw), true);
+    ctx.textAlign = 'center';
+    ctx.strokeStyle = '#ddd';
+    ctx.lineWidth = 1;
+    for (const column of columns) {
+      const x = column.startDay * dw - left;
+      const width = (column.endDay - column.startDay) * dw;
+      const isCurrent = todayDay >= column.startDay && todayDay < column.endDay;
+      if (isCurrent) {
+        ctx.fillStyle = '#e3f2fd';
+        ctx.fillRect(x, 0, width, HEADER_HEIGHT);
+      }
+      ctx.strokeRect(x + 0.5, 0.5, width, HEADER_HEIGHT - 1);
+      // Labels of columns too narrow to read are skipped
+      if (width < 36 || !column.label) continue;
+      ctx.font = `${isCurrent ? 'bold ' : ''}12px sans-serif`;
+      ctx.fillStyle = isCurrent ? '#2196f3' : '#333';
+      ctx.fillText(column.label, x + width / 2, HEADER_HEIGHT / 2 - 4);
+      if (column.subLabel) {
+        ctx.font = '10px sans-serif';
+        ctx.fillStyle = '#666';
+        ctx.fillText(column.subLabel, x + width / 2, HEADER_HEIGHT / 2 + 12);
+      }
+    }
+
+    if (cache.tiles.size >= MAX_TILES) {
+      cache.tiles.delete(cache.tiles.keys().next().value as number);
+    }
+    cache.tiles.set(tile, canvas);
+    return canvas;
+  };
+
+  const draw = () => {
+    frameRef.current = null;
+    const canvas = canvasRef.current;
+    const ctx = canvas?.getContext('2d');
+    if (!canvas || !ctx) return;
+
+    const { tasks: rows, layout: currentLayout, origin: start, criticalPath: critical } = state.current;
+    const v = view.current;
+    const dw = dayWidth();
+    const drag = dragRef.current;
+    const bodyTop = HEADER_HEIGHT;
+    const timelineWidth = v.width - LABEL_WIDTH;
+
+    ctx.setTransform(v.dpr, 0, 0, v.dpr, 0, 0);
+    ctx.clearRect(0, 0, v.width, v.height);
+
+    // Visible window
+    const firstRow = Math.max(0, Math.floor(v.scrollY / ROW_HEIGHT));
+    const lastRow = Math.min(rows.length, Math.ceil((v.scrollY + v.height - bodyTop) / ROW_HEIGHT));
+    const firstDay = Math.floor(v.scrollX / dw);
+    const lastDay = Math.ceil((v.scrollX + timelineWidth) / dw);
+    const rowY = (row: number) => bodyTop + row * ROW_HEIGHT - v.scrollY;
+    const dayX = (dayPx: number) => LABEL_WIDTH + dayPx - v.scrollX;
+
+    // Timeline body, clipped to the right of the label column
+    ctx.save();
+    ctx.beginPath();
+    ctx.rect(LABEL_WIDTH, bodyTop, timelineWidth, v.height - bodyTop);
+    ctx.clip();
+
+    ctx.strokeStyle = '#f0f0f0';
+    ctx.lineWidth = 1;
+    ctx.beginPath();
+    for (const column of columnsInRange(state.current.viewMode, start, firstDay, lastDay, false)) {
+      const x = Math.round(dayX(column.startDay * dw)) + 0.5;
+      ctx.moveTo(x, bodyTop);
+      ctx.lineTo(x, v.height);
+    }
+    ctx.stroke();
+
+    const todayDay = differenceInDays(new Date(), start);
+    if (todayDay >= firstDay && todayDay <= lastDay) {
+      const x = dayX(todayDay * dw);
+      ctx.save();
+      ctx.strokeStyle = 'rgba(33, 150, 243, 0.5)';
+      ctx.lineWidth = 2;
+      ctx.setLineDash([4, 4]);
+      ctx.beginPath();
+      ctx.moveTo(x, bodyTop);
+      ctx.lineTo(x, Math.min(v.height, rowY(rows.length)));
+      ctx.stroke();
+      ctx.restore();
+    }
+
+    // Dependency arrows crossing the visible rows
+    const seen = new Set<number>();
+    const minX = v.scrollX - 20;
+    const maxX = v.scrollX + timelineWidth + 20;
+    for (let tile = Math.floor(firstRow / ROWS_PER_ARROW_TILE); tile <= Math.floor(Math.max(firstRow, lastRow - 1) / ROWS_PER_ARROW_TILE); tile++) {
+      for (const id of currentLayout.arrowTiles.get(tile) ?? []) {
+        if (seen.has(id)) continue;
+        seen.add(id);
+        const arrow = currentLayout.arrows[id];
+        if (Math.max(arrow.from, arrow.to) < firstRow || Math.min(arrow.from, arrow.to) >= lastRow) continue;
+        const fromBar = barExtent(arrow.from, dw);
+        const toBar = barExtent(arrow.to, dw);
+        const x1 = fromBar.x + fromBar.width;
+        const x2 = toBar.x;
+        if (Math.max(x1, x2) < minX || Math.min(x1, x2) > maxX) continue;
+
+        const sx = dayX(x1);
+        const sy = rowY(arrow.from) + ROW_HEIGHT / 2;
+        const ex = dayX(x2);
+        const ey = rowY(arrow.to) + ROW_HEIGHT / 2;
+        const color = arrow.critical ? '#f44336' : '#666';
+        ctx.strokeStyle = color;
+        ctx.fillStyle = color;
+        ctx.lineWidth = arrow.critical ? 2 : 1;
+        ctx.setLineDash(arrow.critical ? [] : [4, 4]);
+        ctx.beginPath();
+        ctx.moveTo(sx, sy);
+        ctx.lineTo(ex, ey);
+        ctx.stroke();
+
+        const angle = Math.atan2(ey - sy, ex - sx);
+        ctx.beginPath();
+        ctx.moveTo(ex, ey);
+        ctx.lineTo(ex - 9 * Math.cos(angle - 0.4), ey - 9 * Math.sin(angle - 0.4));
+        ctx.lineTo(ex - 9 * Math.cos(angle + 0.4), ey - 9 * Math.sin(angle + 0.4));
+        ctx.closePath();
+        ctx.fill();
+      }
+    }
+    ctx.setLineDash([]);
+
+    // Task bars
+    ctx.textAlign = 'center';
+    ctx.font = 'bold 10px sans-serif';
+    for (let row = firstRow; row < lastRow; row++) {
+      const task = rows[row];
+      const bar = barExtent(row, dw);
+      const isDragging = drag?.kind === 'task' && drag.row === row;
+      const x = bar.x + (isDragging ? drag.deltaDays * dw : 0);
+      if (x + bar.width < v.scrollX || x > v.scrollX + timelineWidth) continue;
+
+      const left = dayX(x);
+      const top = rowY(row) + (ROW_HEIGHT - TASK_BAR_HEIGHT) / 2;
+      const isCritical = critical.has(task.id);
+
+      ctx.globalAlpha = isDragging ? 0.6 : task.status === 'done' ? 0.7 : 1;
+      ctx.fillStyle = getTaskColor(task);
+      fillRoundRect(ctx, left, top, bar.width, TASK_BAR_HEIGHT, 4);
+      if (task.status === 'in_progress') {
+        ctx.globalAlpha = 0.2;
+        ctx.fillStyle = '#000';
+        fillRoundRect(ctx, left, top, bar.width * 0.5, TASK_BAR_HEIGHT, 4);
+      }
+      ctx.globalAlpha = 1;
+      if (isCritical) {
+        ctx.strokeStyle = '#f44336';
+        ctx.lineWidth = 2;
+        ctx.strokeRect(left, top, bar.width, TASK_BAR_HEIGHT);
+        if (bar.width > 60) {
+          ctx.fillStyle = 'white';
+          ctx.fillText('CRITICAL', left + bar.width / 2, top + TASK_BAR_HEIGHT / 2 + 4);
+        }
+      }
+    }
+    ctx.restore();
+
+    // Label column
+    ctx.fillStyle = '#fafafa';
+    ctx.fillRect(0, bodyTop, LABEL_WIDTH, v.height - bodyTop);
+    ctx.save();
+    ctx.beginPath();
+    ctx.rect(0, bodyTop, v.width, v.height - bodyTop);
+    ctx.clip();
+    ctx.strokeStyle = '#eee';
+    ctx.lineWidth = 1;
+    ctx.beginPath();
+    for (let row = firstRow; row <= lastRow; row++) {
+      const y = Math.round(rowY(row)) + 0.5;
+      ctx.moveTo(0, y);
+      ctx.lineTo(v.width, y);
+    }
+    ctx.stroke();
+    ctx.textAlign = 'left';
+    ctx.font = '12px sans-serif';
+    ctx.fillStyle = '#333';
+    for (let row = firstRow; row < lastRow; row++) {
+      ctx.fillText(getTaskLabel(rows[row]), 10, rowY(row) + ROW_HEIGHT / 2 + 4);
+    }
+    ctx.restore();
+    ctx.strokeStyle = '#ddd';
+    ctx.beginPath();
+    ctx.moveTo(LABEL_WIDTH + 0.5, bodyTop);
+    ctx.lineTo(LABEL_WIDTH + 0.5, v.height);
+    ctx.stroke();
+
+    // Header from cached tiles
+    ctx.save();
+    ctx.beginPath();
+    ctx.rect(LABEL_WIDTH, 0, timelineWidth, HEADER_HEIGHT);
+    ctx.clip();
+    const firstTile = Math.floor(v.scrollX / TILE_WIDTH);
+    const lastTile = Math.floor((v.scrollX + timelineWidth) / TILE_WIDTH);
+    for (let tile = firstTile; tile <= lastTile; tile++) {
+      ctx.drawImage(getHeaderTile(tile, dw), dayX(tile * TILE_WIDTH), 0, TILE_WIDTH, HEADER_HEIGHT);
+    }
+    ctx.restore();
+    ctx.fillStyle = '#f5f5f5';
+    ctx.fillRect(0, 0, LABEL_WIDTH, HEADER_HEIGHT);
+  };
+
+  const requestDraw = useCallback(() => {
+    if (frameRef.current === null) {
+      frameRef.current = requestAnimationFrame(draw);
+    }
+    // draw only reads refs, so the first render's closure stays valid
+  }, []);
+
+  const zoomAt = (factor: number, anchorX: number) => {
+    const v = view.current;
+    const before = dayWidth();
+    const anchorDay = (v.scrollX + anchorX) / before;
+    v.zoom = Math.min(MAX_ZOOM, Math.max(MIN_ZOOM, v.zoom * factor));
+    v.scrollX = anchorDay * dayWidth() - anchorX;
+    clampScroll();
+    requestDraw();
+  };
+
+  useImperativeHandle(ref, () => ({
+    zoomBy: factor => zoomAt(factor, (view.current.width - LABEL_WIDTH) / 2),
+    scrollToDate: date => {
+      const v = view.current;
+      v.scrollX = differenceInDays(date, state.current.origin) * dayWidth() - (v.width - LABEL_WIDTH) / 3;
+      clampScroll();
+      requestDraw();
+    },
+  }));
+
+  // Keep the date at the centre in view across scale changes
+  const previousMode = useRef(viewMode);
+  useEffect(() => {
+    if (previousMode.current !== viewMode) {
+      const v = view.current;
+      const centre = (v.scrollX + (v.width - LABEL_WIDTH) / 2) / (getDayWidth(previousMode.current) * v.zoom);
+      previousMode.current = viewMode;
+      v.zoom = 1;
+      v.scrollX = centre * dayWidth() - (v.width - LABEL_WIDTH) / 2;
+    }
+    clampScroll();
+    requestDraw();
+  });
+
+  // Size the backing store to the container
+  useEffect(() => {
+    const container = containerRef.current;
+    const canvas = canvasRef.current;
+    if (!container || !canvas) return;
+
+    const resize = () => {
+      const v = view.current;
+      v.width = container.clientWidth;
+      v.height = container.clientHeight;
+      v.dpr = window.devicePixelRatio || 1;
+      canvas.width = Math.floor(v.width * v.dpr);
+      canvas.height = Math.floor(v.height * v.dpr);
+      canvas.style.width = `${v.width}px`;
+      canvas.style.height = `${v.height}px`;
+      clampScroll();
+      draw();
+    };
+    resize();
+    const observer = new ResizeObserver(resize);
+    observer.observe(container);
+    return () => {
+      observer.disconnect();
+      if (frameRef.current !== null) cancelAnimationFrame(frameRef.current);
+      frameRef.current = null;
+    };
+  }, []);
+
+  // Wheel needs a non-passive listener to keep the page from scrolling
+  useEffect(() => {
+    const canvas = canvasRef.current;
+    if (!canvas) return;
+    const onWheel = (e: WheelEvent) => {
+      e.preventDefault();
+      const v = view.current;
+      if (e.ctrlKey || e.metaKey) {
+        const anchorX = e.offsetX - LABEL_WIDTH;
+        zoomAt(Math.exp(-e.deltaY * 0.002), Math.max(0, anchorX));
+        return;
+      }
+      if (e.shiftKey) {
+        v.scrollX += e.deltaY;
+      } else {
+        v.scrollX += e.deltaX;
+        v.scrollY += e.deltaY;
+      }
+      clampScroll();
+      requestDraw();
+    };
+    canvas.addEventListener('wheel', onWheel, { passive: false });
+    return () => canvas.removeEventListener('wheel', onWheel);
+  }, []);
+
+  const hitTest = (x: number, y: number): { row: number; area: 'label' | 'bar' | 'body' } | null => {
+    if (y < HEADER_HEIGHT) return null;
+    const v = view.current;
+    const row = Math.floor((y - HEADER_HEIGHT + v.scrollY) / ROW_HEIGHT);
+    if (row < 0 || row >= state.current.tasks.length) return { row: -1, area: 'body' };
+    if (x < LABEL_WIDTH) return { row, area: 'label' };
+
+    const bar = barExtent(row, dayWidth());
+    const px = x - LABEL_WIDTH + v.scrollX;
+    const top = HEADER_HEIGHT + row * ROW_HEIGHT - v.scrollY + (ROW_HEIGHT - TASK_BAR_HEIGHT) / 2;
+    const onBar = px >= bar.x && px <= bar.x + bar.width && y >= top && y <= top + TASK_BAR_HEIGHT;
+    return { row, area: onBar ? 'bar' : 'body' };
+  };
+
+  const handlePointerDown = (e: React.PointerEvent<HTMLCanvasElement>) => {
+    const { offsetX: x, offsetY: y } = e.nativeEvent;
+    const hit = hitTest(x, y);
+    e.currentTarget.setPointerCapture(e.pointerId);
+    if (hit?.area === 'bar' && state.current.onTaskMove) {
+      dragRef.current = { kind: 'task', startX: x, row: hit.row, deltaDays: 0, moved: false };
+    } else {
+      const v = view.current;
+      dragRef.current = {
+        kind: 'pan', startX: x, startY: y, scrollX: v.scrollX, scrollY: v.scrollY,
+        moved: false, row: hit?.row ?? -1, onLabel: hit?.area === 'label' || hit?.area === 'bar',
+      };
+    }
+  };
+
+  const handlePointerMove = (e: React.PointerEvent<HTMLCanvasElement>) => {
+    const { offsetX: x, offsetY: y } = e.nativeEvent;
+    const drag = dragRef.current;
+    const canvas = e.currentTarget;
+
+    if (!drag) {
+      const hit = hitTest(x, y);
+      canvas.style.cursor = hit?.area === 'bar' ? 'move' : hit?.area === 'label' ? 'pointer' : 'grab';
+      return;
+    }
+
+    if (drag.kind === 'task') {
+      drag.moved = drag.moved || Math.abs(x - drag.startX) > DRAG_THRESHOLD;
+      const deltaDays = Math.round((x - drag.startX) / dayWidth());
+      if (deltaDays !== drag.deltaDays) {
+        drag.deltaDays = deltaDays;
+        requestDraw();
+      }
+      return;
+    }
+
+    drag.moved = drag.moved || Math.abs(x - drag.startX) > DRAG_THRESHOLD || Math.abs(y - drag.startY) > DRAG_THRESHOLD;
+    if (drag.moved) {
+      canvas.style.cursor = 'grabbing';
+      const v = view.current;
+      v.scrollX = drag.scrollX - (x - drag.startX);
+      v.scrollY = drag.scrollY - (y - drag.startY);
+      clampScroll();
+      requestDraw();
+    }
+  };
+
+  const handlePointerUp = () => {
+    const drag = dragRef.current;
+    dragRef.current = null;
+    if (!drag) return;
+
+    const task = drag.row >= 0 ? state.current.tasks[drag.row] : undefined;
+    if (drag.kind === 'task') {
+      if (task && drag.deltaDays !== 0) {
+        state.current.onTaskMove?.(task.id, drag.deltaDays);
+      } else if (task && !drag.moved) {
+        state.current.onTaskClick?.(task.id);
+      }
+      requestDraw();
+    } else if (!drag.moved && drag.onLabel && task) {
+      state.current.onTaskClick?.(task.id);
+    }
+  };
+
+  return (
+    <Box ref={containerRef} sx={{ position: 'absolute', inset: 0, overflow: 'hidden' }}>
+      <canvas
+        ref={canvasRef}
+        style={{ display: 'block', touchAction: 'none' }}
+        onPointerDown={handlePointerDown}
+        onPointerMove={handlePointerMove}
+        onPointerUp={handlePointerUp}
+        onPointerCancel={handlePointerUp}
+      />
+    </Box>
+  );
+});
+
+GanttCanvas.displayName = 'GanttCanvas';
+
+export default GanttCanvas;
@@ -1,4 +1,4 @@
-import React, { useState, useMemo } from 'react';
+import React, { useState, useMemo, useEffect, useRef } from 'react';
 import {
   Box,
   Paper,
@@ -18,9 +18,22 @@ import {
   ChevronRight as ChevronRightIcon,
 } from '@mui/icons-material';
 import { format, addDays, startOfWeek, endOfWeek, eachDayOfInterval, differenceInDays, addWeeks, addMonths, startOfMonth, endOfMonth, eachWeekOfInterval, eachMonthOfInterval, isToday, isSameDay } from 'date-fns';
-import { Task, TaskDependency } from '../types';
-
-type ViewMode = 'day' | 'week' | 'month';
+import { Task, TaskDependency, toTask } from '../types';
+import GanttCanvas, { GanttCanvasHandle } from './GanttCanvas';
+import {
+  GanttTask,
+  GanttRenderer,
+  ViewMode,
+  ROW_HEIGHT,
+  HEADER_HEIGHT,
+  TASK_BAR_HEIGHT,
+  LABEL_WIDTH,
+  MIN_BAR_WIDTH,
+  CANVAS_TASK_THRESHOLD,
+  getDayWidth,
+  getTaskColor,
+  getTaskLabel,
+} from './ganttModel';
 
 interface GanttChartProps {
   tasks: Task[];
@@ -30,68 +43,51 @@ interface GanttChartProps {
   projectId?: number;
 }
 
-interface GanttTask {
-  id: number;
-  projectId: number;
-  title: string;
-  description: string | null;
-  status: string;
-  priority: string;
-  assignedTo: string | null;
-  startDate: Date;
-  dueDate: Date;
-  createdAt: string;
-  updatedAt: string;
-  completedAt: string | null;
-  position: number;
-  level: number;
-  dependsOn: number[];
-  blocks: number[];
-}
-
 const GanttChart: React.FC<GanttChartProps> = ({
   tasks,
   dependencies,
   onTaskClick,
   onTaskUpdate,
+  projectId,
 }) => {
   const [viewMode, setViewMode] = useState<ViewMode>('week');
   const [currentDate, setCurrentDate] = useState(new Date());
   const [draggedTask, setDraggedTask] = useState<number | null>(null);
   const [dragStartX, setDragStartX] = useState<number | null>(null);
   const [dragStartDate, setDragStartDate] = useState<Date | null>(null);
-
-  // Constants
-  const ROW_HEIGHT = 40;
-  const HEADER_HEIGHT = 80;
-  const TASK_BAR_HEIGHT = 28;
-  const LABEL_WIDTH = 250;
-  const DAY_WIDTH = viewMode === 'day' ? 80 : viewMode === 'week' ? 40 : 20;
+  const [rendererChoice, setRendererChoice] = useState<GanttRenderer | null>(null);
+  const canvasRef = useRef<GanttCanvasHandle>(null);
+
+  const DAY_WIDTH = getDayWidth(viewMode);
+
+  // Index blocking edges once instead of scanning all dependencies per task
+  const blockingEdges = useMemo(() => {
+    const dependsOn = new Map<number, number[]>();
+    const blocks = new Map<number, number[]>();
+    dependencies.forEach(dep => {
+      if (dep.dependencyType !== 'blocks') return;
+      if (!dependsOn.has(dep.taskId)) dependsOn.set(dep.taskId, []);
+      dependsOn.get(dep.taskId)!.push(dep.dependsOnTaskId);
+      if (!blocks.has(dep.dependsOnTaskId)) blocks.set(dep.dependsOnTaskId, []);
+      blocks.get(dep.dependsOnTaskId)!.push(dep.taskId);
+    });
+    return { dependsOn, blocks };
+  }, [dependencies]);
 
   // Prepare tasks with dates
   const ganttTasks: GanttTask[] = useMemo(() => {
     return tasks
       .filter(task => task.startDate && task.dueDate)
-      .map((task, index) => {
-        const dependsOn = dependencies
-          .filter(dep => dep.taskId === task.id && dep.dependencyType === 'blocks')
-          .map(dep => dep.dependsOnTaskId);
-        
-        const blocks = dependencies
-          .filter(dep => dep.dependsOnTaskId === task.id && dep.dependencyType === 'blocks')
-          .map(dep => dep.taskId);
-
-        return {
-          ...task,
-          startDate: new Date(task.startDate!),
-          dueDate: new Date(task.dueDate!),
-          level: 0,
-          dependsOn,
-          blocks,
-        };
-      })
+      .map((task) => ({
+        ...toTask(task),
+        startDate: new Date(task.startDate!),
+        dueDate: new Date(task.dueDate!),
+        level: 0,
+        dependsOn: blockingEdges.dependsOn.get(task.id) ?? [],
+        blocks: blockingEdges.blocks.get(task.id) ?? [],
+      }))
       .sort((a, b) => a.startDate.getTime() - b.startDate.getTime());
-  }, [tasks, dependencies]);
+  }, [tasks, blockingEdges]);
 
   // Calculate date range
   const dateRange = useMemo(() => {
@@ -101,9 +97,15 @@ const GanttChart: React.FC<GanttChartProps> = ({
       return { start, end };
     }
 
-    const taskDates = ganttTasks.flatMap(t => [t.startDate, t.dueDate]);
-    const minDate = new Date(Math.min(...taskDates.map(d => d.getTime())));
-    const maxDate = new Date(Math.max(...taskDates.map(d => d.getTime())));
+    // One pass; spreading thousands of dates into Math.min/max is slow and can overflow the stack
+    let min = Infinity;
+    let max = -Infinity;
+    for (const task of ganttTasks) {
+      min = Math.min(min, task.startDate.getTime(), task.dueDate.getTime());
+      max = Math.max(max, task.startDate.getTime(), task.dueDate.getTime());
+    }
+    const minDate = new Date(min);
+    const maxDate = new Date(max);
 
     // Add padding
     const start = startOfWeek(addWeeks(minDate, -1));
@@ -112,8 +114,12 @@ const GanttChart: React.FC<GanttChartProps> = ({
     return { start, end };
   }, [ganttTasks, currentDate]);
 
-  // Generate time columns
+  // Large charts default to the canvas renderer; the toolbar toggle overrides
+  const renderer: GanttRenderer = rendererChoice ?? (ganttTasks.length > CANVAS_TASK_THRESHOLD ? 'canvas' : 'svg');
+
+  // Generate time columns (SVG renderer only; the canvas draws visible columns itself)
   const timeColumns = useMemo(() => {
+    if (renderer === 'canvas') return [];
     if (viewMode === 'day') {
       return eachDayOfInterval(dateRange).map(date => ({
         date,
@@ -135,7 +141,7 @@ const GanttChart: React.FC<GanttChartProps> = ({
         subLabel: '',
       }));
     }
-  }, [dateRange, viewMode]);
+  }, [dateRange, viewMode, renderer]);
 
   // Calculate task position
   const getTaskPosition = (task: GanttTask) => {
@@ -144,19 +150,10 @@ const GanttChart: React.FC<GanttChartProps> = ({
     
     return {
       x: startOffset * DAY_WIDTH,
-      width: Math.max(duration * DAY_WIDTH, 20),
+      width: Math.max(duration * DAY_WIDTH, MIN_BAR_WIDTH),
     };
   };
 
-  // Get task color based on status
-  const getTaskColor = (task: GanttTask) => {
-    if (task.status === 'done') return '#4caf50';
-    if (task.status === 'in_progress') return '#2196f3';
-    if (task.priority === 'critical') return '#f44336';
-    if (task.priority === 'high') return '#ff9800';
-    return '#9e9e9e';
-  };
-
   // Handle drag start
   const handleDragStart = (taskId: number, e: React.MouseEvent) => {
     setDraggedTask(taskId);
@@ -225,19 +222,50 @@ const GanttChart: React.FC<GanttChartProps> = ({
     setCurrentDate(new Date());
   };
 
-  // Calculate critical path (simplified)
-  const criticalPath = useMemo(() => {
-    // Simple algorithm: tasks with dependencies that form the longest chain
-    const taskIds = new Set<number>();
-    
-    ganttTasks.forEach(task => {
-      if (task.blocks.length > 0) {
-        taskIds.add(task.id);
-        task.blocks.forEach(id => taskIds.add(id));
-      }
-    });
-    
-    return taskIds;
+  // The canvas renderer scrolls to the navigated date
+  useEffect(() => {
+    if (renderer === 'canvas') canvasRef.current?.scrollToDate(currentDate);
+  }, [currentDate, renderer]);
+
+  const handleCanvasTaskClick = (taskId: number) => {
+    const originalTask = tasks.find(t => t.id === taskId);
+    if (originalTask) onTaskClick?.(originalTask);
+  };
+
+  const handleCanvasTaskMove = (taskId: number, deltaDays: number) => {
+    const index = ganttTaskIndex.get(taskId);
+    if (index === undefined || !onTaskUpdate) return;
+    const task = ganttTasks[index];
+    const duration = differenceInDays(task.dueDate, task.startDate);
+    const newStartDate = addDays(task.startDate, deltaDays);
+    onTaskUpdate(taskId, newStartDate, addDays(newStartDate, duration));
+  };
+
+  // Critical path comes from the main-process dependency graph index
+  const [criticalPath, setCriticalPath] = useState<Set<number>>(new Set());
+
+  useEffect(() => {
+    if (!projectId) {
+      setCriticalPath(new Set());
+      return;
+    }
+
+    let isMounted = true;
+    window.electronAPI.dependency.getCriticalPath(projectId)
+      .then(path => {
+        if (isMounted) setCriticalPath(new Set(path.taskIds));
+      })
+      .catch(err => console.error('Failed to load critical path:', err));
+
+    return () => {
+      isMounted = false;
+    };
+  }, [projectId, tasks, dependencies]);
+
+  const ganttTaskIndex = useMemo(() => {
+    const index = new Map<number, number>();
+    ganttTasks.forEach((task, i) => index.set(task.id, i));
+    return index;
   }, [ganttTasks]);
 
   // Render dependency arrows
@@ -246,10 +274,9 @@ const GanttChart: React.FC<GanttChartProps> = ({
     
     ganttTasks.forEach((task, taskIndex) => {
       task.dependsOn.forEach(depId => {
-        const depTask = ganttTasks.find(t => t.id === depId);
-        if (!depTask) return;
-        
-        const depIndex = ganttTasks.findIndex(t => t.id === depId);
+        const depIndex = ganttTaskIndex.get(depId);
+        if (depIndex === undefined) return;
+        const depTask = ganttTasks[depIndex];
         const depPos = getTaskPosition(depTask);
         const taskPos = getTaskPosition(task);
         
@@ -325,6 +352,31 @@ const GanttChart: React.FC<GanttChartProps> = ({
           </IconButton>
         </Stack>
 
+        {renderer === 'canvas' && (
+          <Stack direction="row" spacing={1} alignItems="center">
+            <Tooltip title="Zoom out (Ctrl + scroll)">
+              <IconButton size="small" onClick={() => canvasRef.current?.zoomBy(1 / 1.5)}>
+                <ZoomOutIcon />
+              </IconButton>
+            </Tooltip>
+            <Tooltip title="Zoom in (Ctrl + scroll)">
+              <IconButton size="small" onClick={() => canvasRef.current?.zoomBy(1.5)}>
+                <ZoomInIcon />
+              </IconButton>
+            </Tooltip>
+          </Stack>
+        )}
+
+        <ToggleButtonGroup
+          value={renderer}
+          exclusive
+          onChange={(_, newRenderer) => newRenderer && setRendererChoice(newRenderer)}
+          size="small"
+        >
+          <ToggleButton value="svg">SVG</ToggleButton>
+          <ToggleButton value="canvas">Canvas</ToggleButton>
+        </ToggleButtonGroup>
+
         <ToggleButtonGroup
           value={viewMode}
           exclusive
@@ -345,7 +397,7 @@ const GanttChart: React.FC<GanttChartProps> = ({
       </Paper>
 
       {/* Gantt Chart */}
-      <Paper sx={{ flexGrow: 1, overflow: 'auto', position: 'relative' }}>
+      <Paper sx={{ flexGrow: 1, overflow: renderer === 'canvas' ? 'hidden' : 'auto', position: 'relative', minHeight: 400 }}>
         {ganttTasks.length === 0 ? (
           <Box sx={{ p: 4, textAlign: 'center' }}>
             <Typography variant="body1" color="text.secondary">
@@ -355,6 +407,18 @@ const GanttChart: React.FC<GanttChartProps> = ({
               Add start and due dates to tasks to see them on the timeline.
             </Typography>
           </Box>
+        ) : renderer === 'canvas' ? (
+          <GanttCanvas
+            ref={canvasRef}
+            tasks={ganttTasks}
+            taskIndex={ganttTaskIndex}
+            origin={dateRange.start}
+            totalDays={differenceInDays(dateRange.end, dateRange.start) + 1}
+            viewMode={viewMode}
+            criticalPath={criticalPath}
+            onTaskClick={handleCanvasTaskClick}
+            onTaskMove={onTaskUpdate ? handleCanvasTaskMove : undefined}
+          />
         ) : (
           <svg
             width={chartWidth}
@@ -480,7 +544,7 @@ const GanttChart: React.FC<GanttChartProps> = ({
                       if (originalTask) onTaskClick?.(originalTask);
                     }}
                   >
-                    {task.title.length > 30 ? `${task.title.substring(0, 30)}...` : task.title}
+                    {getTaskLabel(task)}
                   </text>
 
                   {/* Task bar */}
@@ -17,6 +17,9 @@ import AddIcon from '@mui/icons-material/Add';
 import EditIcon from '@mui/icons-material/Edit';
 import DeleteIcon from '@mui/icons-material/Delete';
 import { Label, CreateLabelData } from '../types';
+import { selectProjectLabels } from '../services/entityStore';
+import { loadProjectLabels } from '../services/entityCache';
+import { useEntitySelector } from '../hooks/useEntityStore';
 
 interface LabelManagerProps {
   open: boolean;
@@ -35,7 +38,7 @@ export default function LabelManager({
   taskLabels = [],
   onLabelsChange,
 }: LabelManagerProps) {
-  const [allLabels, setAllLabels] = useState<Label[]>([]);
+  const allLabels = useEntitySelector(state => selectProjectLabels(state, projectId), [projectId]);
   const [creating, setCreating] = useState(false);
   const [editing, setEditing] = useState<Label | null>(null);
   const [newLabel, setNewLabel] = useState<CreateLabelData>({
@@ -51,9 +54,9 @@ export default function LabelManager({
     }
   }, [open, projectId]);
 
+  // Cached per project; edits come back through the change feed
   const loadLabels = async () => {
-    const labels = await window.electronAPI.label.findByProjectId(projectId);
-    setAllLabels(labels);
+    await loadProjectLabels(projectId);
   };
 
   const handleCreateLabel = async () => {
@@ -66,7 +69,6 @@ export default function LabelManager({
 
     setNewLabel({ projectId, name: '', color: '#2196F3', description: '' });
     setCreating(false);
-    loadLabels();
     onLabelsChange?.();
   };
 
@@ -80,7 +82,6 @@ export default function LabelManager({
     });
 
     setEditing(null);
-    loadLabels();
     onLabelsChange?.();
   };
 
@@ -88,7 +89,6 @@ export default function LabelManager({
     if (!confirm('Delete this label? It will be removed from all tasks.')) return;
 
     await window.electronAPI.label.delete(labelId);
-    loadLabels();
     onLabelsChange?.();
   };
 
@@ -27,25 +27,52 @@ import {
   AlternateEmail as MentionIcon,
   GroupAdd as GroupAddIcon,
 } from '@mui/icons-material';
-import { Notification, NotificationType } from '../types';
+import { Notification, NotificationType, NotificationDelta } from '../types';
 import { useNavigate } from 'react-router-dom';
 
 interface NotificationCenterProps {
   userId: number;
 }
 
+const NOTIFICATION_LIST_LIMIT = 20;
+
+// Patch the loaded list with a delta from the main process
+function applyDelta(list: Notification[], delta: NotificationDelta): Notification[] {
+  const replaced = new Set(delta.upserted.map(n => n.id));
+  const removed = new Set(delta.removedIds);
+  const read = new Set(delta.readIds);
+  const unread = new Set(delta.unreadIds);
+
+  const kept = list
+    .filter(n => !replaced.has(n.id) && !removed.has(n.id))
+    .map(n => {
+      if (delta.allRead || read.has(n.id)) return n.isRead ? n : { ...n, isRead: true };
+      if (unread.has(n.id)) return { ...n, isRead: false, readAt: null };
+      return n;
+    });
+
+  // Upserted notifications are the newest ones
+  const upserted = [...delta.upserted].sort((a, b) => b.createdAt.localeCompare(a.createdAt));
+  return [...upserted, ...kept].slice(0, NOTIFICATION_LIST_LIMIT);
+}
+
 export default function NotificationCenter({ userId }: NotificationCenterProps) {
   const navigate = useNavigate();
   const [anchorEl, setAnchorEl] = useState<HTMLButtonElement | null>(null);
   const [notifications, setNotifications] = useState<Notification[]>([]);
   const [unreadCount, setUnreadCount] = useState(0);
   const [loading, setLoading] = useState(false);
+  const [loaded, setLoaded] = useState(false);
 
   useEffect(() => {
+    setLoaded(false);
+    setNotifications([]);
     loadUnreadCount();
-    // Poll for new notifications every 30 seconds
-    const interval = setInterval(loadUnreadCount, 30000);
-    return () => clearInterval(interval);
+    // Changes are pushed by the main process; no polling
+    return window.electronAPI.notification.subscribe(userId, (delta) => {
+      setUnreadCount(delta.unreadCount);
+      setNotifications(list => applyDelta(list, delta));
+    });
   }, [userId]);
 
   const loadUnreadCount = async () => {
@@ -60,8 +87,9 @@ export default function NotificationCenter({ userId }: NotificationCenterProps)
   const loadNotifications = async () => {
     setLoading(true);
     try {
-      const data = await window.electronAPI.notification.findByUserId(userId, 20);
+      const data = await window.electronAPI.notification.findByUserId(userId, NOTIFICATION_LIST_LIMIT);
       setNotifications(data);
+      setLoaded(true);
     } catch (err) {
       console.error('Failed to load notifications:', err);
     } finally {
@@ -71,7 +99,10 @@ export default function NotificationCenter({ userId }: NotificationCenterProps)
 
   const handleOpen = async (event: React.MouseEvent<HTMLButtonElement>) => {
     setAnchorEl(event.currentTarget);
-    await loadNotifications();
+    // Later changes arrive as deltas, so the list is fetched once
+    if (!loaded) {
+      await loadNotifications();
+    }
   };
 
   const handleClose = () => {
@@ -81,8 +112,6 @@ export default function NotificationCenter({ userId }: NotificationCenterProps)
   const handleMarkAsRead = async (notificationId: number) => {
     try {
       await window.electronAPI.notification.markAsRead(notificationId);
-      await loadNotifications();
-      await loadUnreadCount();
     } catch (err) {
       console.error('Failed to mark as read:', err);
     }
@@ -91,8 +120,6 @@ export default function NotificationCenter({ userId }: NotificationCenterProps)
   const handleMarkAllAsRead = async () => {
     try {
       await window.electronAPI.notification.markAllAsRead(userId);
-      await loadNotifications();
-      await loadUnreadCount();
     } catch (err) {
       console.error('Failed to mark all as read:', err);
     }
@@ -35,14 +35,17 @@ import {
   Visibility as ViewIcon,
 } from '@mui/icons-material';
 import { User, Role, ProjectMemberWithDetails } from '../types';
+import { selectProjectMembers, selectActiveUsers } from '../services/entityStore';
+import { loadProjectMembers, loadActiveUsers } from '../services/entityCache';
+import { useEntitySelector } from '../hooks/useEntityStore';
 
 interface ProjectMembersProps {
   projectId: number;
 }
 
 export default function ProjectMembers({ projectId }: ProjectMembersProps) {
-  const [members, setMembers] = useState<ProjectMemberWithDetails[]>([]);
-  const [users, setUsers] = useState<User[]>([]);
+  const members = useEntitySelector(state => selectProjectMembers(state, projectId), [projectId]);
+  const users = useEntitySelector(selectActiveUsers, []);
   const [roles, setRoles] = useState<Role[]>([]);
   const [loading, setLoading] = useState(true);
   const [dialogOpen, setDialogOpen] = useState(false);
@@ -58,13 +61,13 @@ export default function ProjectMembers({ projectId }: ProjectMembersProps) {
   const loadData = async () => {
     setLoading(true);
     try {
-      const [membersData, usersData, rolesData] = await Promise.all([
-        window.electronAPI.projectMember.findByProjectIdWithDetails(projectId),
-        window.electronAPI.user.findActive(),
+      // Members and users are shared with other views through the cache;
+      // membership changes arrive through the change feed
+      const [, , rolesData] = await Promise.all([
+        loadProjectMembers(projectId),
+        loadActiveUsers(),
         window.electronAPI.role.findAll(),
       ]);
-      setMembers(membersData);
-      setUsers(usersData);
       setRoles(rolesData);
     } catch (err) {
       console.error('Failed to load project members:', err);
@@ -125,7 +128,6 @@ export default function ProjectMembers({ projectId }: ProjectMembersProps) {
           roleId: selectedRole,
         });
       }
-      await loadData();
       handleCloseDialog();
     } catch (err) {
       console.error('Failed to save member:', err);
@@ -140,7 +142,6 @@ export default function ProjectMembers({ projectId }: ProjectMembersProps) {
 
     try {
       await window.electronAPI.projectMember.delete(memberId);
-      await loadData();
     } catch (err) {
       console.error('Failed to delete member:', err);
       setError('Failed to remove member');
@@ -0,0 +1,48 @@
+import React, { useCallback } from 'react';
+import { Box, SxProps, Theme } from '@mui/material';
+import { useVirtualWindow } from '../hooks/useVirtualWindow';
+
+interface VirtualListProps<T> {
+  items: T[];
+  getKey: (item: T) => string | number;
+  renderItem: (item: T) => React.ReactNode;
+  /** Estimated row height in pixels; rows are measured once rendered */
+  rowHeight: number;
+  overscan?: number;
+  sx?: SxProps<Theme>;
+}
+
+/**
+ * Scrollable list that mounts only the visible (plus overscan) items.
+ * The container needs a bounded height, e.g. sx={{ maxHeight: 400 }}.
+ */
+export default function VirtualList<T>({
+  items,
+  getKey,
+  renderItem,
+  rowHeight,
+  overscan,
+  sx,
+}: VirtualListProps<T>) {
+  const getRowKey = useCallback((index: number) => getKey(items[index]), [items, getKey]);
+  const virtual = useVirtualWindow({
+    count: items.length,
+    rowHeight,
+    measure: true,
+    getRowKey,
+    overscan,
+  });
+
+  return (
+    <Box ref={virtual.scrollRef} sx={[{ overflowY: 'auto' }, ...(Array.isArray(sx) ? sx : [sx])]}>
+      <Box sx={{ height: virtual.paddingTop }} />
+      {items.slice(virtual.startIndex, virtual.endIndex).map((item, offset) => (
+        // flow-root keeps child margins inside the measured box
+        <div key={getKey(item)} ref={virtual.measureRow(virtual.startIndex + offset)} style={{ display: 'flow-root' }}>
+          {renderItem(item)}
+        </div>
+      ))}
+      <Box sx={{ height: virtual.paddingBottom }} />
+    </Box>
+  );
+}
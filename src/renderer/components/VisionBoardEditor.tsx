@@ -43,6 +43,8 @@ import {
   VisionBoard,
   VisionBoardNode,
   VisionBoardConnection,
+  VisionBoardOperation,
+  VisionBoardViewport,
   NodeType,
   ShapeType,
   LineType,
@@ -58,11 +60,48 @@ interface VisionBoardEditorProps {
 
 type Tool = 'select' | 'text' | 'shape' | 'sticky' | 'image' | 'line';
 
+// Queued node deltas are sent at most this often while dragging
+const FLUSH_INTERVAL_MS = 100;
+const MIN_ZOOM = 0.1;
+const MAX_ZOOM = 3;
+
+const containsRect = (outer: VisionBoardViewport, inner: VisionBoardViewport) =>
+  inner.x >= outer.x &&
+  inner.y >= outer.y &&
+  inner.x + inner.width <= outer.x + outer.width &&
+  inner.y + inner.height <= outer.y + outer.height;
+
+/**
+ * Fold a later operation on the same node into an earlier one, so a drag
+ * stream becomes one move per node per flush
+ */
+const coalesce = (earlier: VisionBoardOperation, later: VisionBoardOperation): VisionBoardOperation => {
+  if (earlier.type === 'delete' || later.type === 'delete') return { type: 'delete', nodeId: later.nodeId };
+  const changes = earlier.type === 'update' ? { ...earlier.changes } : { x: earlier.x, y: earlier.y };
+  if (later.type === 'move') {
+    if (earlier.type === 'move') return later;
+    return { type: 'update', nodeId: later.nodeId, changes: { ...changes, x: later.x, y: later.y } };
+  }
+  return { type: 'update', nodeId: later.nodeId, changes: { ...changes, ...later.changes } };
+};
+
+/**
+ * Editor for one board. Only the nodes around the viewport are turned into
+ * fabric objects; panning or zooming past the loaded region fetches the next
+ * one and drops objects that left it. Edits are queued as deltas, coalesced
+ * per node and sent through the board's operation log.
+ */
 export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, onSave }) => {
   const canvasRef = useRef<HTMLCanvasElement>(null);
   const fabricCanvasRef = useRef<fabric.Canvas | null>(null);
+  const objectsRef = useRef(new Map<number, fabric.Object>()); // nodeId -> object on canvas
+  const gridLinesRef = useRef<fabric.Line[]>([]);
+  const regionRef = useRef<VisionBoardViewport | null>(null); // area currently loaded
+  const loadSeqRef = useRef(0);
+  const viewportFrameRef = useRef<number | null>(null);
+  const queuedOpsRef = useRef(new Map<number, VisionBoardOperation>());
+  const flushTimerRef = useRef<ReturnType<typeof setTimeout> | null>(null);
   const [board, setBoard] = useState<VisionBoard | null>(null);
-  const [nodes, setNodes] = useState<VisionBoardNode[]>([]);
   const [connections, setConnections] = useState<VisionBoardConnection[]>([]);
   const [currentTool, setCurrentTool] = useState<Tool>('select');
   const [zoom, setZoom] = useState(1.0);
@@ -77,23 +116,25 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
 
   // Load board data
   useEffect(() => {
-    loadBoardData();
+    loadBoard();
   }, [boardId]);
 
-  // Initialize Fabric canvas
+  // Initialize Fabric canvas once the board is known
   useEffect(() => {
-    if (!canvasRef.current || fabricCanvasRef.current) return;
+    if (!canvasRef.current || !board) return;
 
     const canvas = new fabric.Canvas(canvasRef.current, {
       width: 1200,
       height: 800,
-      backgroundColor: board?.backgroundColor || '#ffffff',
+      backgroundColor: board.backgroundColor || '#ffffff',
+      renderOnAddRemove: false,
     });
 
     fabricCanvasRef.current = canvas;
+    canvas.setViewportTransform([board.zoom, 0, 0, board.zoom, board.viewportX, board.viewportY]);
 
     // Setup grid if enabled
-    if (gridEnabled) {
+    if (board.gridEnabled) {
       drawGrid(canvas);
     }
 
@@ -110,47 +151,121 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
       setSelectedObject(null);
     });
 
-    // Handle object modifications for auto-save
-    canvas.on('object:modified', () => {
+    // Stream positions while dragging; the full geometry once the edit ends
+    canvas.on('object:moving', (e: any) => {
+      queueGeometry(e.target, false);
+    });
+
+    canvas.on('object:modified', (e: any) => {
+      queueGeometry(e.target, true);
       saveCanvasState();
     });
 
+    // Wheel pans, ctrl/cmd + wheel zooms around the cursor
+    canvas.on('mouse:wheel', (opt: any) => {
+      const event = opt.e as WheelEvent;
+      event.preventDefault();
+      if (event.ctrlKey || event.metaKey) {
+        const next = Math.min(MAX_ZOOM, Math.max(MIN_ZOOM, canvas.getZoom() * Math.pow(0.999, event.deltaY)));
+        canvas.zoomToPoint(new fabric.Point(event.offsetX, event.offsetY), next);
+        setZoom(next);
+      } else {
+        canvas.relativePan(new fabric.Point(-event.deltaX, -event.deltaY));
+      }
+      scheduleViewportCheck();
+    });
+
+    loadViewport();
+
     return () => {
+      flushOperations();
+      if (viewportFrameRef.current !== null) cancelAnimationFrame(viewportFrameRef.current);
+      viewportFrameRef.current = null;
+      loadSeqRef.current++;
+      objectsRef.current.clear();
+      gridLinesRef.current = [];
+      regionRef.current = null;
       canvas.dispose();
       fabricCanvasRef.current = null;
     };
-  }, [canvasRef.current, board]);
+  }, [board?.id]);
 
-  // Load board data from database
-  const loadBoardData = async () => {
+  // Load board settings from database
+  const loadBoard = async () => {
     try {
-      const data = await window.electronAPI.visionBoard.getBoardData(boardId);
+      const data = await window.electronAPI.visionBoard.getById(boardId);
       if (data) {
-        setBoard(data.board);
-        setNodes(data.nodes);
-        setConnections(data.connections);
-        setZoom(data.board.zoom);
-        setGridEnabled(data.board.gridEnabled);
-        
-        // Load nodes onto canvas
-        if (fabricCanvasRef.current) {
-          loadNodesToCanvas(data.nodes);
-        }
+        setBoard(data);
+        setZoom(data.zoom);
+        setGridEnabled(data.gridEnabled);
       }
     } catch (error) {
       console.error('Failed to load board data:', error);
     }
   };
 
-  // Load nodes to canvas
-  const loadNodesToCanvas = (nodesToLoad: VisionBoardNode[]) => {
+  // Visible area in board coordinates
+  const getVisibleRect = (canvas: fabric.Canvas): VisionBoardViewport => {
+    const vpt = canvas.viewportTransform || [1, 0, 0, 1, 0, 0];
+    const scale = vpt[0] || 1;
+    return {
+      x: -vpt[4] / scale,
+      y: -vpt[5] / scale,
+      width: canvas.getWidth() / scale,
+      height: canvas.getHeight() / scale,
+    };
+  };
+
+  // Re-check the loaded region at most once per frame while panning/zooming
+  const scheduleViewportCheck = () => {
     const canvas = fabricCanvasRef.current;
     if (!canvas) return;
+    canvas.requestRenderAll();
+    if (viewportFrameRef.current !== null) return;
+    viewportFrameRef.current = requestAnimationFrame(() => {
+      viewportFrameRef.current = null;
+      const region = regionRef.current;
+      if (!region || !containsRect(region, getVisibleRect(canvas))) {
+        loadViewport();
+      }
+    });
+  };
 
-    canvas.clear();
-    if (gridEnabled) {
-      drawGrid(canvas);
+  // Fetch the nodes around the viewport and sync the canvas with them
+  const loadViewport = async () => {
+    const canvas = fabricCanvasRef.current;
+    if (!canvas) return;
+
+    // Queued edits go first so the query sees them
+    flushOperations();
+    const seq = ++loadSeqRef.current;
+    try {
+      const data = await window.electronAPI.visionBoard.getViewport(boardId, getVisibleRect(canvas));
+      if (!data || seq !== loadSeqRef.current || fabricCanvasRef.current !== canvas) return;
+
+      regionRef.current = data.region;
+      setConnections(data.connections);
+
+      // Objects outside the region are dropped unless selected or still queued
+      const inRegion = new Set(data.nodes.map(node => node.id));
+      const active = new Set(canvas.getActiveObjects());
+      for (const [nodeId, obj] of objectsRef.current) {
+        if (!inRegion.has(nodeId) && !active.has(obj) && !queuedOpsRef.current.has(nodeId)) {
+          canvas.remove(obj);
+          objectsRef.current.delete(nodeId);
+        }
+      }
+
+      addNodesToCanvas(data.nodes.filter(node => !objectsRef.current.has(node.id)));
+    } catch (error) {
+      console.error('Failed to load board viewport:', error);
     }
+  };
+
+  // Add nodes to canvas
+  const addNodesToCanvas = (nodesToLoad: VisionBoardNode[]) => {
+    const canvas = fabricCanvasRef.current;
+    if (!canvas) return;
 
     nodesToLoad.forEach(node => {
       let fabricObject: fabric.Object | null = null;
@@ -189,14 +304,23 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
 
         case NodeType.Image:
           if (node.imageUrl) {
-            fabric.Image.fromURL(node.imageUrl, {}, (img: any) => {
+            fabric.Image.fromURL(node.imageUrl).then((img: fabric.Image) => {
+              // The region may have moved on while the image loaded
+              if (fabricCanvasRef.current !== canvas || objectsRef.current.has(node.id)) return;
               img.set({
                 left: node.x,
                 top: node.y,
                 scaleX: node.width / (img.width || 1),
                 scaleY: node.height / (img.height || 1),
+                angle: node.rotation,
+                opacity: node.opacity,
+                selectable: !node.locked,
+                visible: node.visible,
               });
+              (img as any).nodeId = node.id;
+              objectsRef.current.set(node.id, img);
               canvas.add(img);
+              canvas.requestRenderAll();
             });
           }
           break;
@@ -210,11 +334,12 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
           visible: node.visible,
         });
         (fabricObject as any).nodeId = node.id;
+        objectsRef.current.set(node.id, fabricObject);
         canvas.add(fabricObject);
       }
     });
 
-    canvas.renderAll();
+    canvas.requestRenderAll();
   };
 
   // Create shape based on type
@@ -274,9 +399,10 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
     const gridSize = board?.gridSize || 20;
     const width = canvas.getWidth();
     const height = canvas.getHeight();
+    const lines: fabric.Line[] = [];
 
     for (let i = 0; i < width / gridSize; i++) {
-      canvas.add(new fabric.Line([i * gridSize, 0, i * gridSize, height], {
+      lines.push(new fabric.Line([i * gridSize, 0, i * gridSize, height], {
         stroke: '#e5e7eb',
         strokeWidth: 1,
         selectable: false,
@@ -285,13 +411,77 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
     }
 
     for (let i = 0; i < height / gridSize; i++) {
-      canvas.add(new fabric.Line([0, i * gridSize, width, i * gridSize], {
+      lines.push(new fabric.Line([0, i * gridSize, width, i * gridSize], {
         stroke: '#e5e7eb',
         strokeWidth: 1,
         selectable: false,
         evented: false,
       }));
     }
+
+    lines.forEach(line => {
+      canvas.add(line);
+      canvas.sendObjectToBack(line);
+    });
+    gridLinesRef.current = lines;
+    canvas.requestRenderAll();
+  };
+
+  // Queue an operation, merged with anything already queued for the node
+  const queueOperation = (op: VisionBoardOperation) => {
+    const queued = queuedOpsRef.current.get(op.nodeId);
+    queuedOpsRef.current.set(op.nodeId, queued ? coalesce(queued, op) : op);
+    if (!flushTimerRef.current) {
+      flushTimerRef.current = setTimeout(flushOperations, FLUSH_INTERVAL_MS);
+    }
+  };
+
+  // Send queued operations in one batch
+  const flushOperations = () => {
+    if (flushTimerRef.current) {
+      clearTimeout(flushTimerRef.current);
+      flushTimerRef.current = null;
+    }
+    if (queuedOpsRef.current.size === 0) return;
+
+    const ops = Array.from(queuedOpsRef.current.values());
+    queuedOpsRef.current.clear();
+    window.electronAPI.visionBoard.applyOperations(boardId, ops).catch(error => {
+      console.error('Failed to save board changes:', error);
+    });
+  };
+
+  // Queue the geometry of a moved/modified object (or each object in a selection)
+  const queueGeometry = (target: fabric.Object | undefined, final: boolean) => {
+    if (!target) return;
+    const objects = target instanceof fabric.ActiveSelection ? target.getObjects() : [target];
+
+    for (const obj of objects) {
+      const nodeId = (obj as any).nodeId;
+      if (!nodeId) continue;
+
+      // Children of a selection are positioned relative to it
+      const group = obj.group;
+      const position = group
+        ? fabric.util.transformPoint(new fabric.Point(obj.left || 0, obj.top || 0), group.calcTransformMatrix())
+        : new fabric.Point(obj.left || 0, obj.top || 0);
+
+      if (!final) {
+        queueOperation({ type: 'move', nodeId, x: position.x, y: position.y });
+        continue;
+      }
+      queueOperation({
+        type: 'update',
+        nodeId,
+        changes: {
+          x: position.x,
+          y: position.y,
+          width: (obj.width || DEFAULT_NODE_WIDTH) * (obj.scaleX || 1) * (group?.scaleX || 1),
+          height: (obj.height || DEFAULT_NODE_HEIGHT) * (obj.scaleY || 1) * (group?.scaleY || 1),
+          rotation: ((obj.angle || 0) + (group?.angle || 0)) % 360,
+        },
+      });
+    }
   };
 
   // Add text
@@ -309,6 +499,7 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
 
     canvas.add(text);
     canvas.setActiveObject(text);
+    canvas.requestRenderAll();
     saveNodeToDatabase(text, NodeType.Text);
   };
 
@@ -320,6 +511,7 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
     const shape = createShapeByType(shapeType);
     canvas.add(shape);
     canvas.setActiveObject(shape);
+    canvas.requestRenderAll();
     saveNodeToDatabase(shape, NodeType.Shape, shapeType);
     setShapeMenuAnchor(null);
   };
@@ -370,6 +562,7 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
 
     canvas.add(sticky);
     canvas.setActiveObject(sticky);
+    canvas.requestRenderAll();
     saveNodeToDatabase(sticky, NodeType.StickyNote);
   };
 
@@ -394,7 +587,7 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
       });
 
       (obj as any).nodeId = node.id;
-      setNodes(prev => [...prev, node]);
+      objectsRef.current.set(node.id, obj);
     } catch (error) {
       console.error('Failed to save node:', error);
     }
@@ -405,11 +598,32 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
     const canvas = fabricCanvasRef.current;
     if (!canvas) return;
 
-    const state = JSON.stringify(canvas.toJSON());
+    const state = JSON.stringify(canvas.toObject(['nodeId']));
     setUndoStack(prev => [...prev.slice(-19), state]); // Keep last 20 states
     setRedoStack([]); // Clear redo stack
   };
 
+  // Restore a saved state and queue the restored geometry
+  const restoreCanvasState = (state: string) => {
+    const canvas = fabricCanvasRef.current;
+    if (!canvas) return;
+
+    canvas.loadFromJSON(state).then(() => {
+      objectsRef.current.clear();
+      gridLinesRef.current = [];
+      for (const obj of canvas.getObjects()) {
+        const nodeId = (obj as any).nodeId;
+        if (nodeId) {
+          objectsRef.current.set(nodeId, obj);
+          queueGeometry(obj, true);
+        } else if (obj instanceof fabric.Line && !obj.evented) {
+          gridLinesRef.current.push(obj);
+        }
+      }
+      canvas.requestRenderAll();
+    });
+  };
+
   // Undo
   const handleUndo = () => {
     if (undoStack.length === 0) return;
@@ -417,15 +631,12 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
     const canvas = fabricCanvasRef.current;
     if (!canvas) return;
 
-    const currentState = JSON.stringify(canvas.toJSON());
+    const currentState = JSON.stringify(canvas.toObject(['nodeId']));
     const previousState = undoStack[undoStack.length - 1];
     
     setRedoStack(prev => [...prev, currentState]);
     setUndoStack(prev => prev.slice(0, -1));
-    
-    canvas.loadFromJSON(previousState, () => {
-      canvas.renderAll();
-    });
+    restoreCanvasState(previousState);
   };
 
   // Redo
@@ -435,15 +646,12 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
     const canvas = fabricCanvasRef.current;
     if (!canvas) return;
 
-    const currentState = JSON.stringify(canvas.toJSON());
+    const currentState = JSON.stringify(canvas.toObject(['nodeId']));
     const nextState = redoStack[redoStack.length - 1];
     
     setUndoStack(prev => [...prev, currentState]);
     setRedoStack(prev => prev.slice(0, -1));
-    
-    canvas.loadFromJSON(nextState, () => {
-      canvas.renderAll();
-    });
+    restoreCanvasState(nextState);
   };
 
   // Delete selected object
@@ -453,11 +661,12 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
 
     const nodeId = (selectedObject as any).nodeId;
     if (nodeId) {
-      window.electronAPI.visionBoard.deleteNode(nodeId);
-      setNodes(prev => prev.filter(n => n.id !== nodeId));
+      queueOperation({ type: 'delete', nodeId });
+      objectsRef.current.delete(nodeId);
     }
 
     canvas.remove(selectedObject);
+    canvas.requestRenderAll();
     setSelectedObject(null);
     saveCanvasState();
   };
@@ -470,7 +679,7 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
     const canvas = fabricCanvasRef.current;
     if (canvas) {
       canvas.setZoom(newZoom);
-      canvas.renderAll();
+      scheduleViewportCheck();
     }
   };
 
@@ -479,11 +688,13 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
     setGridEnabled(!gridEnabled);
     const canvas = fabricCanvasRef.current;
     if (canvas) {
-      canvas.clear();
-      if (!gridEnabled) {
+      if (gridEnabled) {
+        gridLinesRef.current.forEach(line => canvas.remove(line));
+        gridLinesRef.current = [];
+        canvas.requestRenderAll();
+      } else {
         drawGrid(canvas);
       }
-      loadNodesToCanvas(nodes);
     }
   };
 
@@ -493,6 +704,9 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
     if (!canvas) return;
 
     try {
+      // Node changes are already queued as deltas; send what is left
+      flushOperations();
+
       // Update board with current viewport and zoom
       await window.electronAPI.visionBoard.update(boardId, {
         zoom,
@@ -501,23 +715,6 @@ export const VisionBoardEditor: React.FC<VisionBoardEditorProps> = ({ boardId, o
         thumbnail: canvas.toDataURL({ format: 'png', quality: 0.5, multiplier: 1 }),
       });
 
-      // Update all nodes
-      const objects = canvas.getObjects();
-      const updatePromises = objects
-        .filter((obj: any) => (obj as any).nodeId)
-        .map((obj: any) => {
-          const nodeId = (obj as any).nodeId;
-          return window.electronAPI.visionBoard.updateNode(nodeId, {
-            x: obj.left || 0,
-            y: obj.top || 0,
-            width: obj.width || DEFAULT_NODE_WIDTH,
-            height: obj.height || DEFAULT_NODE_HEIGHT,
-            rotation: obj.angle || 0,
-          });
-        });
-
-      await Promise.all(updatePromises);
-      
       if (onSave) onSave();
     } catch (error) {
       console.error('Failed to save board:', error);
@@ -0,0 +1,51 @@
+/**
+ * Shared layout model for the SVG and canvas Gantt renderers
+ */
+
+export type ViewMode = 'day' | 'week' | 'month';
+
+export type GanttRenderer = 'svg' | 'canvas';
+
+export interface GanttTask {
+  id: number;
+  projectId: number;
+  title: string;
+  description: string | null;
+  status: string;
+  priority: string;
+  assignedTo: string | null;
+  startDate: Date;
+  dueDate: Date;
+  createdAt: string;
+  updatedAt: string;
+  completedAt: string | null;
+  position: number;
+  level: number;
+  dependsOn: number[];
+  blocks: number[];
+}
+
+export const ROW_HEIGHT = 40;
+export const HEADER_HEIGHT = 80;
+export const TASK_BAR_HEIGHT = 28;
+export const LABEL_WIDTH = 250;
+export const MIN_BAR_WIDTH = 20;
+
+// Charts above this size default to the canvas renderer
+export const CANVAS_TASK_THRESHOLD = 200;
+
+export function getDayWidth(viewMode: ViewMode): number {
+  return viewMode === 'day' ? 80 : viewMode === 'week' ? 40 : 20;
+}
+
+export function getTaskColor(task: GanttTask): string {
+  if (task.status === 'done') return '#4caf50';
+  if (task.status === 'in_progress') return '#2196f3';
+  if (task.priority === 'critical') return '#f44336';
+  if (task.priority === 'high') return '#ff9800';
+  return '#9e9e9e';
+}
+
+export function getTaskLabel(task: GanttTask): string {
+  return task.title.length > 30 ? `${task.title.substring(0, 30)}...` : task.title;
+}
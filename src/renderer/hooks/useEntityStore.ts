@@ -0,0 +1,60 @@
+import { DependencyList, useCallback, useEffect, useMemo, useState, useSyncExternalStore } from 'react';
+import { entityStore, EntityState } from '../services/entityStore';
+
+/**
+ * Read derived data from the entity store. The selector is re-run only
+ * when the store changes (or `deps` do), and the previous result is kept
+ * while the state is unchanged, so it is safe to return new arrays.
+ */
+export function useEntitySelector<T>(selector: (state: EntityState) => T, deps: DependencyList): T {
+  const memoized = useMemo(() => {
+    let lastState: EntityState | null = null;
+    let lastResult: T;
+    return (state: EntityState): T => {
+      if (state !== lastState) {
+        lastState = state;
+        lastResult = selector(state);
+      }
+      return lastResult;
+    };
+    // eslint-disable-next-line react-hooks/exhaustive-deps
+  }, deps);
+
+  return useSyncExternalStore(entityStore.subscribe, () => memoized(entityStore.getState()));
+}
+
+/**
+ * Load data into the entity store once per `deps`, after the change feed
+ * is subscribed. Later changes arrive through the feed; the load only
+ * re-runs if the store had to be cleared.
+ */
+export function useEntityLoad(load: () => Promise<void>, deps: DependencyList) {
+  const [loading, setLoading] = useState(true);
+  const [error, setError] = useState<unknown>(null);
+  const epoch = useSyncExternalStore(entityStore.subscribe, entityStore.getEpoch);
+  // eslint-disable-next-line react-hooks/exhaustive-deps
+  const run = useCallback(load, deps);
+
+  useEffect(() => {
+    let isMounted = true;
+    setLoading(true);
+    entityStore.start()
+      .then(run)
+      .then(
+        () => {
+          if (isMounted) setError(null);
+        },
+        (err) => {
+          if (isMounted) setError(err);
+        }
+      )
+      .finally(() => {
+        if (isMounted) setLoading(false);
+      });
+    return () => {
+      isMounted = false;
+    };
+  }, [run, epoch]);
+
+  return { loading, error };
+}
@@ -0,0 +1,126 @@
+import { useCallback, useLayoutEffect, useMemo, useRef, useState } from 'react';
+
+export interface VirtualWindowOptions {
+  /** Total number of rows */
+  count: number;
+  /** Fixed row height, or the estimate used until a row has been measured */
+  rowHeight: number;
+  /** Measure rendered rows instead of assuming every row is rowHeight tall */
+  measure?: boolean;
+  /** Stable key per row so measurements survive re-sorting (defaults to index) */
+  getRowKey?: (index: number) => string | number;
+  /** Rows rendered above and below the viewport */
+  overscan?: number;
+}
+
+export interface VirtualWindow {
+  /** Ref callback for the scrollable element that contains the rows */
+  scrollRef: (el: HTMLElement | null) => void;
+  /** First rendered row (inclusive) */
+  startIndex: number;
+  /** Last rendered row (exclusive) */
+  endIndex: number;
+  /** Spacer heights standing in for the rows that are not mounted */
+  paddingTop: number;
+  paddingBottom: number;
+  totalHeight: number;
+  /** Ref callback for measured rows: ref={measureRow(index)} */
+  measureRow: (index: number) => (el: HTMLElement | null) => void;
+}
+
+/**
+ * Windowed rendering for long lists and tables: only the rows inside the
+ * viewport, plus `overscan` rows either side, are mounted.
+ */
+export function useVirtualWindow({
+  count,
+  rowHeight,
+  measure = false,
+  getRowKey,
+  overscan = 8,
+}: VirtualWindowOptions): VirtualWindow {
+  const [scrollElement, setScrollElement] = useState<HTMLElement | null>(null);
+  const [scrollTop, setScrollTop] = useState(0);
+  const [viewportHeight, setViewportHeight] = useState(0);
+  const [measureVersion, setMeasureVersion] = useState(0);
+  const heights = useRef(new Map<string | number, number>());
+
+  // Track scroll position (once per frame) and viewport size
+  useLayoutEffect(() => {
+    const el = scrollElement;
+    if (!el) return;
+
+    let frame = 0;
+    const onScroll = () => {
+      if (frame) return;
+      frame = requestAnimationFrame(() => {
+        frame = 0;
+        setScrollTop(el.scrollTop);
+      });
+    };
+
+    setScrollTop(el.scrollTop);
+    setViewportHeight(el.clientHeight);
+    el.addEventListener('scroll', onScroll, { passive: true });
+    const observer = new ResizeObserver(() => setViewportHeight(el.clientHeight));
+    observer.observe(el);
+
+    return () => {
+      el.removeEventListener('scroll', onScroll);
+      observer.disconnect();
+      if (frame) cancelAnimationFrame(frame);
+    };
+  }, [scrollElement]);
+
+  const keyOf = useCallback((index: number) => (getRowKey ? getRowKey(index) : index), [getRowKey]);
+
+  // Prefix sums of row heights; only needed when rows are measured
+  const offsets = useMemo(() => {
+    if (!measure) return null;
+    const result = new Float64Array(count + 1);
+    for (let i = 0; i < count; i++) {
+      result[i + 1] = result[i] + (heights.current.get(keyOf(i)) ?? rowHeight);
+    }
+    return result;
+  }, [measure, count, rowHeight, keyOf, measureVersion]);
+
+  const offsetOf = (index: number) => (offsets ? offsets[index] : index * rowHeight);
+  const totalHeight = offsetOf(count);
+
+  // First row whose bottom edge is below `y`
+  const rowAt = (y: number): number => {
+    if (!offsets) return Math.min(count, Math.max(0, Math.floor(y / rowHeight)));
+    let lo = 0;
+    let hi = count;
+    while (lo < hi) {
+      const mid = (lo + hi) >>> 1;
+      if (offsets[mid + 1] <= y) lo = mid + 1;
+      else hi = mid;
+    }
+    return lo;
+  };
+
+  const startIndex = Math.max(0, rowAt(scrollTop) - overscan);
+  const endIndex = Math.min(count, rowAt(scrollTop + viewportHeight) + 1 + overscan);
+
+  const measureRow = useCallback((index: number) => (el: HTMLElement | null) => {
+    if (!el || !measure) return;
+    const key = keyOf(index);
+    const height = el.getBoundingClientRect().height;
+    const previous = heights.current.get(key);
+    if (previous === undefined || Math.abs(previous - height) > 0.5) {
+      heights.current.set(key, height);
+      setMeasureVersion(v => v + 1);
+    }
+  }, [measure, keyOf]);
+
+  return {
+    scrollRef: setScrollElement,
+    startIndex,
+    endIndex,
+    paddingTop: offsetOf(startIndex),
+    paddingBottom: totalHeight - offsetOf(endIndex),
+    totalHeight,
+    measureRow,
+  };
+}
@@ -1,12 +1,14 @@
 import type { 
   Project, CreateProjectData, UpdateProjectData,
   Task, CreateTaskData, UpdateTaskData,
+  TaskBulkUpdate, TaskMoveOptions, TaskLabelChanges, TaskBulkResult, TaskBulkLabelResult,
   Comment, CreateCommentData, UpdateCommentData,
   Label, CreateLabelData, UpdateLabelData,
   Attachment, CreateAttachmentData,
   CustomField, CreateCustomFieldData, UpdateCustomFieldData,
   TaskCustomValue
 } from '../types';
+import { projectRows, taskRows } from '../types';
 
 /**
  * API Service using Electron IPC instead of HTTP
@@ -22,7 +24,7 @@ class ApiService {
 
   // Project APIs
   async getAllProjects(): Promise<Project[]> {
-    return this.api.project.findAll();
+    return projectRows(await this.api.project.findAllColumnar());
   }
 
   async getProject(id: number): Promise<Project | undefined> {
@@ -43,7 +45,7 @@ class ApiService {
 
   // Task APIs
   async getTasksByProject(projectId: number): Promise<Task[]> {
-    return this.api.task.findByProjectId(projectId);
+    return taskRows(await this.api.task.findByProjectIdColumnar(projectId));
   }
 
   async getTask(id: number): Promise<Task | undefined> {
@@ -58,6 +60,18 @@ class ApiService {
     return this.api.task.update(id, data);
   }
 
+  async bulkUpdateTasks(items: TaskBulkUpdate[]): Promise<TaskBulkResult> {
+    return this.api.task.bulkUpdate(items);
+  }
+
+  async moveTasks(taskIds: number[], options?: TaskMoveOptions): Promise<TaskBulkResult> {
+    return this.api.task.bulkMove(taskIds, options);
+  }
+
+  async labelTasks(taskIds: number[], labels: TaskLabelChanges): Promise<TaskBulkLabelResult> {
+    return this.api.task.bulkLabel(taskIds, labels);
+  }
+
   async deleteTask(id: number): Promise<boolean> {
     return this.api.task.delete(id);
   }
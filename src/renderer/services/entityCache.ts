@@ -0,0 +1,155 @@
+import type { Project, Task, Label, Comment, ProjectMemberWithDetails, User } from '../types';
+import { projectRows, taskRows } from '../types';
+import { entityStore } from './entityStore';
+
+interface CacheEntry {
+  fetchedAt: number; // 0 until the first fetch completes
+  inFlight: Promise<unknown> | null;
+  value?: unknown;
+}
+
+// Collections covered by the change feed stay current once loaded
+const FEED_BACKED = Number.POSITIVE_INFINITY;
+// Users are not in the feed; serve cached data, refresh in the background after this
+const USER_STALE_MS = 60 * 1000;
+
+/**
+ * Request cache in front of the IPC API. Results are written into the
+ * normalized entityStore, so every view reading the same project, task,
+ * label or user sees one copy.
+ *
+ * - Identical requests in flight share one IPC call.
+ * - Fresh results are served without IPC. Feed-backed collections never
+ *   go stale; the change feed patches them in place.
+ * - Stale results are returned at once and revalidated in the background.
+ */
+class EntityCache {
+  private entries = new Map<string, CacheEntry>();
+  private epoch = entityStore.getEpoch();
+
+  /**
+   * Run `fetcher` for `key` unless a fresh or in-flight result exists.
+   * `commit` stores the result in the entity store.
+   */
+  fetch<T>(key: string, fetcher: () => Promise<T>, commit: (value: T) => void, staleMs = FEED_BACKED): Promise<T> {
+    this.checkEpoch();
+    let entry = this.entries.get(key);
+    if (!entry) {
+      entry = { fetchedAt: 0, inFlight: null };
+      this.entries.set(key, entry);
+    }
+
+    if (entry.inFlight && entry.fetchedAt === 0) {
+      return entry.inFlight as Promise<T>;
+    }
+    if (entry.fetchedAt > 0) {
+      if (Date.now() - entry.fetchedAt >= staleMs && !entry.inFlight) {
+        // Stale-while-revalidate: errors keep the old value
+        this.revalidate(key, entry, fetcher, commit).catch(error => {
+          console.error(`Failed to refresh ${key}:`, error);
+        });
+      }
+      return Promise.resolve(entry.value as T);
+    }
+    return this.revalidate(key, entry, fetcher, commit);
+  }
+
+  /**
+   * Forget cached results whose key starts with `prefix` (all when omitted)
+   */
+  invalidate(prefix = ''): void {
+    for (const key of Array.from(this.entries.keys())) {
+      if (key.startsWith(prefix)) this.entries.delete(key);
+    }
+  }
+
+  private revalidate<T>(key: string, entry: CacheEntry, fetcher: () => Promise<T>, commit: (value: T) => void): Promise<T> {
+    const request = entityStore.start()
+      .then(fetcher)
+      .then(value => {
+        // Dropped by invalidate() while in flight: the result is not cached
+        if (this.entries.get(key) === entry) {
+          entry.value = value;
+          entry.fetchedAt = Date.now();
+          commit(value);
+        }
+        return value;
+      })
+      .finally(() => {
+        entry.inFlight = null;
+      });
+    entry.inFlight = request;
+    return request;
+  }
+
+  /**
+   * A cleared store (change feed reset) means cached keys no longer
+   * describe its contents
+   */
+  private checkEpoch(): void {
+    const epoch = entityStore.getEpoch();
+    if (epoch !== this.epoch) {
+      this.epoch = epoch;
+      this.entries.clear();
+    }
+  }
+}
+
+export const entityCache = new EntityCache();
+
+// Cached loaders. Views read the results through entityStore selectors.
+
+export function loadProjects(): Promise<Project[]> {
+  return entityCache.fetch('projects',
+    async () => projectRows(await window.electronAPI.project.findAllColumnar()),
+    projects => entityStore.load('project', projects, () => true));
+}
+
+export function loadProject(id: number): Promise<Project | undefined> {
+  const known = entityStore.get('project', id);
+  if (known) return Promise.resolve(known);
+  return entityCache.fetch(`project:${id}`, () => window.electronAPI.project.findById(id),
+    project => project && entityStore.load('project', [project]));
+}
+
+export function loadProjectTasks(projectId: number): Promise<Task[]> {
+  return entityCache.fetch(`tasks:project:${projectId}`,
+    async () => taskRows(await window.electronAPI.task.findByProjectIdColumnar(projectId)),
+    tasks => entityStore.load('task', tasks, task => task.projectId === projectId));
+}
+
+export function loadTask(id: number): Promise<Task | undefined> {
+  const known = entityStore.get('task', id);
+  if (known) return Promise.resolve(known);
+  return entityCache.fetch(`task:${id}`, () => window.electronAPI.task.findById(id),
+    task => task && entityStore.load('task', [task]));
+}
+
+export function loadTaskComments(taskId: number): Promise<Comment[]> {
+  return entityCache.fetch(`comments:task:${taskId}`, () => window.electronAPI.comment.findByTaskId(taskId),
+    comments => entityStore.load('comment', comments, comment => comment.taskId === taskId));
+}
+
+export function loadTaskLabels(taskId: number): Promise<Label[]> {
+  return entityCache.fetch(`labels:task:${taskId}`, () => window.electronAPI.label.findByTaskId(taskId),
+    labels => {
+      entityStore.load('label', labels);
+      entityStore.put('taskLabels', taskId, labels.map(label => label.id));
+    });
+}
+
+export function loadProjectLabels(projectId: number): Promise<Label[]> {
+  return entityCache.fetch(`labels:project:${projectId}`, () => window.electronAPI.label.findByProjectId(projectId),
+    labels => entityStore.load('label', labels, label => label.projectId === projectId));
+}
+
+export function loadProjectMembers(projectId: number): Promise<ProjectMemberWithDetails[]> {
+  return entityCache.fetch(`members:project:${projectId}`,
+    () => window.electronAPI.projectMember.findByProjectIdWithDetails(projectId),
+    members => entityStore.load('projectMember', members, member => member.projectId === projectId));
+}
+
+export function loadActiveUsers(): Promise<User[]> {
+  return entityCache.fetch('users:active', () => window.electronAPI.user.findActive(),
+    users => entityStore.load('user', users, user => user.isActive), USER_STALE_MS);
+}
@@ -0,0 +1,304 @@
+import type {
+  ChangeBatch, ChangeEntityMap, ChangeEntityType, EntityChange, Task, Label, Comment, ProjectMemberWithDetails, User
+} from '../types';
+
+/**
+ * Entity types held by the store: everything the change feed carries,
+ * plus users, which are cached with a time-based refresh instead
+ */
+export interface EntityTypeMap extends ChangeEntityMap {
+  user: User;
+}
+
+export type EntityType = keyof EntityTypeMap;
+
+/**
+ * Normalized entities by type and id. Tables are replaced, never mutated,
+ * whenever they change, so identity comparison tells a view whether
+ * anything it reads is new.
+ */
+export type EntityState = {
+  readonly [K in EntityType]: ReadonlyMap<number, EntityTypeMap[K]>;
+};
+
+type Listener = () => void;
+
+function emptyState(): EntityState {
+  return {
+    project: new Map(),
+    task: new Map(),
+    label: new Map(),
+    comment: new Map(),
+    projectMember: new Map(),
+    taskLabels: new Map(),
+    user: new Map(),
+  };
+}
+
+/**
+ * Client-side store kept current by the main process change feed.
+ *
+ * Views load collections once with load() and then read from the store;
+ * mutations made anywhere (this view, another window, automation rules,
+ * the REST API) arrive as change batches and are patched in, so views do
+ * not refetch after their own writes.
+ */
+class EntityStore {
+  private state: EntityState = emptyState();
+  private version = 0;
+  private epoch = 0; // bumped when the store is cleared and views must reload
+  private listeners = new Set<Listener>();
+  private started: Promise<void> | null = null;
+  private catchingUp = false;
+
+  /**
+   * Subscribe to the change feed (once per renderer). Resolves when
+   * batches will be delivered; data loaded after that is never stale.
+   */
+  start(): Promise<void> {
+    if (!this.started) {
+      const { version, unsubscribe } = window.electronAPI.changes.subscribe(batch => this.onBatch(batch));
+      this.started = version.then(
+        current => {
+          this.version = Math.max(this.version, current);
+        },
+        error => {
+          unsubscribe();
+          this.started = null;
+          throw error;
+        }
+      );
+    }
+    return this.started;
+  }
+
+  getState = (): EntityState => this.state;
+
+  getEpoch = (): number => this.epoch;
+
+  subscribe = (listener: Listener): (() => void) => {
+    this.listeners.add(listener);
+    return () => {
+      this.listeners.delete(listener);
+    };
+  };
+
+  get<K extends EntityType>(entity: K, id: number): EntityTypeMap[K] | undefined {
+    return (this.state[entity] as ReadonlyMap<number, EntityTypeMap[K]>).get(id);
+  }
+
+  /**
+   * Store freshly fetched entities. Existing entries matching `scope` that
+   * are not in `items` are dropped, so a reloaded collection replaces the
+   * previous one (e.g. scope = task => task.projectId === 7).
+   */
+  load<K extends EntityType>(
+    entity: K,
+    items: Array<{ id: number } & EntityTypeMap[K]>,
+    scope?: (item: EntityTypeMap[K]) => boolean
+  ): void {
+    const table = new Map(this.state[entity] as ReadonlyMap<number, EntityTypeMap[K]>);
+    if (scope) {
+      for (const [id, item] of table) {
+        if (scope(item)) table.delete(id);
+      }
+    }
+    for (const item of items) {
+      table.set(item.id, item);
+    }
+    this.replace(entity, table);
+  }
+
+  /**
+   * Store one value under an explicit id (e.g. a task's label id list)
+   */
+  put<K extends EntityType>(entity: K, id: number, value: EntityTypeMap[K]): void {
+    const table = new Map(this.state[entity] as ReadonlyMap<number, EntityTypeMap[K]>);
+    table.set(id, value);
+    this.replace(entity, table);
+  }
+
+  private onBatch(batch: ChangeBatch): void {
+    if (batch.fromVersion > this.version) {
+      // Missed batches (e.g. renderer was busy); fetch the gap first
+      this.catchUp();
+      return;
+    }
+    this.apply(batch.changes);
+    this.version = Math.max(this.version, batch.toVersion);
+  }
+
+  private async catchUp(): Promise<void> {
+    if (this.catchingUp) return;
+    this.catchingUp = true;
+    try {
+      const result = await window.electronAPI.changes.since(this.version);
+      if (result.reset) {
+        // Too far behind for the log; views reload what they need
+        this.state = emptyState();
+        this.epoch++;
+      } else {
+        this.apply(result.changes);
+      }
+      this.version = Math.max(this.version, result.toVersion);
+      this.emit();
+    } catch (error) {
+      console.error('Failed to catch up with change feed:', error);
+    } finally {
+      this.catchingUp = false;
+    }
+  }
+
+  /**
+   * Changes carry current rows, so applying them is idempotent and
+   * overlapping batches are harmless
+   */
+  private apply(changes: EntityChange[]): void {
+    if (changes.length === 0) return;
+
+    const tables = new Map<ChangeEntityType, Map<number, unknown>>();
+    const tableFor = (entity: ChangeEntityType) => {
+      let table = tables.get(entity);
+      if (!table) {
+        table = new Map(this.state[entity] as ReadonlyMap<number, unknown>);
+        tables.set(entity, table);
+      }
+      return table;
+    };
+
+    for (const change of changes) {
+      const current = this.state[change.entity] as ReadonlyMap<number, unknown>;
+      if (change.op === 'delete') {
+        if (current.has(change.id)) tableFor(change.entity).delete(change.id);
+      } else if (current.has(change.id) || change.entity !== 'taskLabels') {
+        // Label lists are only tracked for tasks a view has loaded them for
+        tableFor(change.entity).set(change.id, change.data);
+      }
+    }
+
+    if (tables.size === 0) return;
+    this.state = { ...this.state, ...Object.fromEntries(tables) } as EntityState;
+    this.emit();
+  }
+
+  private replace<K extends EntityType>(entity: K, table: Map<number, EntityTypeMap[K]>): void {
+    this.state = { ...this.state, [entity]: table };
+    this.emit();
+  }
+
+  private emit(): void {
+    for (const listener of this.listeners) {
+      listener();
+    }
+  }
+}
+
+export const entityStore = new EntityStore();
+
+/**
+ * Memoize a per-key selector on one table: results are reused until that
+ * table is replaced, so e.g. a label change never re-sorts task lists and
+ * views reading tasks keep the same array (and skip re-rendering).
+ */
+function memoizeOnTable<V, R>(compute: (table: ReadonlyMap<number, V>, key: number) => R) {
+  const cache = new WeakMap<ReadonlyMap<number, V>, Map<number, R>>();
+  return (table: ReadonlyMap<number, V>, key: number): R => {
+    let byKey = cache.get(table);
+    if (!byKey) {
+      byKey = new Map();
+      cache.set(table, byKey);
+    }
+    if (!byKey.has(key)) {
+      byKey.set(key, compute(table, key));
+    }
+    return byKey.get(key)!;
+  };
+}
+
+// Selectors returning collections in the order the main process lists them
+
+const ALL = 0; // key for selectors without a parameter
+
+const projectTasks = memoizeOnTable<Task, Task[]>((table, projectId) =>
+  Array.from(table.values())
+    .filter(task => projectId === ALL || task.projectId === projectId)
+    .sort((a, b) => a.position - b.position || a.createdAt.localeCompare(b.createdAt) || a.id - b.id)
+);
+
+const projectLabels = memoizeOnTable<Label, Label[]>((table, projectId) =>
+  Array.from(table.values())
+    .filter(label => label.projectId === projectId)
+    .sort((a, b) => a.name.localeCompare(b.name))
+);
+
+const projectMembers = memoizeOnTable<ProjectMemberWithDetails, ProjectMemberWithDetails[]>((table, projectId) =>
+  Array.from(table.values())
+    .filter(member => member.projectId === projectId)
+    .sort((a, b) => b.addedAt.localeCompare(a.addedAt))
+);
+
+const taskComments = memoizeOnTable<Comment, Comment[]>((table, taskId) =>
+  Array.from(table.values())
+    .filter(comment => comment.taskId === taskId)
+    .sort((a, b) => b.createdAt.localeCompare(a.createdAt) || b.id - a.id)
+);
+
+const allProjects = memoizeOnTable<EntityTypeMap['project'], EntityTypeMap['project'][]>(table =>
+  Array.from(table.values()).sort((a, b) => b.updatedAt.localeCompare(a.updatedAt))
+);
+
+const activeUsers = memoizeOnTable<User, User[]>(table =>
+  Array.from(table.values())
+    .filter(user => user.isActive)
+    .sort((a, b) => a.displayName.localeCompare(b.displayName))
+);
+
+export function selectProjects(state: EntityState) {
+  return allProjects(state.project, ALL);
+}
+
+export function selectAllTasks(state: EntityState): Task[] {
+  return projectTasks(state.task, ALL);
+}
+
+export function selectProjectTasks(state: EntityState, projectId: number): Task[] {
+  return projectTasks(state.task, projectId);
+}
+
+export function selectProjectLabels(state: EntityState, projectId: number): Label[] {
+  return projectLabels(state.label, projectId);
+}
+
+export function selectProjectMembers(state: EntityState, projectId: number): ProjectMemberWithDetails[] {
+  return projectMembers(state.projectMember, projectId);
+}
+
+export function selectTaskComments(state: EntityState, taskId: number): Comment[] {
+  return taskComments(state.comment, taskId);
+}
+
+const EMPTY_LABELS: Label[] = [];
+const taskLabelCache = new WeakMap<readonly number[], WeakMap<ReadonlyMap<number, Label>, Label[]>>();
+
+export function selectTaskLabels(state: EntityState, taskId: number): Label[] {
+  const ids = state.taskLabels.get(taskId);
+  if (!ids) return EMPTY_LABELS;
+  let byTable = taskLabelCache.get(ids);
+  if (!byTable) {
+    byTable = new WeakMap();
+    taskLabelCache.set(ids, byTable);
+  }
+  let labels = byTable.get(state.label);
+  if (!labels) {
+    labels = ids
+      .map(id => state.label.get(id))
+      .filter((label): label is Label => !!label)
+      .sort((a, b) => a.name.localeCompare(b.name));
+    byTable.set(state.label, labels);
+  }
+  return labels;
+}
+
+export function selectActiveUsers(state: EntityState): User[] {
+  return activeUsers(state.user, ALL);
+}
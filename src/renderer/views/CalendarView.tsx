@@ -1,4 +1,4 @@
-import React, { useState, useEffect } from 'react';
+import React, { useState, useEffect, useMemo } from 'react';
 import { useParams } from 'react-router-dom';
 import {
   Box,
@@ -21,7 +21,8 @@ import {
   CalendarViewWeek as WeekIcon,
   CalendarViewDay as DayIcon,
 } from '@mui/icons-material';
-import { Task, TaskStatus, TaskPriority } from '../types';
+import { Task, TaskStatus, TaskPriority, taskRows } from '../types';
+import VirtualList from '../components/VirtualList';
 
 type CalendarMode = 'month' | 'week' | 'day';
 
@@ -44,7 +45,7 @@ export const CalendarView: React.FC = () => {
 
     const loadTasks = async () => {
       try {
-        const allTasks = await window.electronAPI.task.findByProjectId(projectId);
+        const allTasks = taskRows(await window.electronAPI.task.findByProjectIdColumnar(projectId));
         if (isMounted) {
           setTasks(allTasks);
         }
@@ -64,13 +65,26 @@ export const CalendarView: React.FC = () => {
 
   const loadTasks = async () => {
     try {
-      const allTasks = await window.electronAPI.task.findByProjectId(projectId);
+      const allTasks = taskRows(await window.electronAPI.task.findByProjectIdColumnar(projectId));
       setTasks(allTasks);
     } catch (error) {
       console.error('Failed to load tasks:', error);
     }
   };
 
+  // Bucket tasks by due day once instead of filtering every task per cell
+  const tasksByDay = useMemo(() => {
+    const index = new Map<string, Task[]>();
+    for (const task of tasks) {
+      if (!task.dueDate) continue;
+      const key = new Date(task.dueDate).toISOString().split('T')[0];
+      const bucket = index.get(key);
+      if (bucket) bucket.push(task);
+      else index.set(key, [task]);
+    }
+    return index;
+  }, [tasks]);
+
   const navigateDate = (direction: 'prev' | 'next') => {
     const newDate = new Date(currentDate);
     if (mode === 'month') {
@@ -103,11 +117,7 @@ export const CalendarView: React.FC = () => {
     
     for (let d = new Date(startDate); d <= endDate; d.setDate(d.getDate() + 1)) {
       const dateStr = d.toISOString().split('T')[0];
-      const dayTasks = tasks.filter(task => {
-        if (!task.dueDate) return false;
-        const taskDate = new Date(task.dueDate).toISOString().split('T')[0];
-        return taskDate === dateStr;
-      });
+      const dayTasks = tasksByDay.get(dateStr) ?? [];
       
       currentWeek.push({
         date: new Date(d),
@@ -134,11 +144,7 @@ export const CalendarView: React.FC = () => {
       date.setDate(date.getDate() + i);
       const dateStr = date.toISOString().split('T')[0];
       
-      const dayTasks = tasks.filter(task => {
-        if (!task.dueDate) return false;
-        const taskDate = new Date(task.dueDate).toISOString().split('T')[0];
-        return taskDate === dateStr;
-      });
+      const dayTasks = tasksByDay.get(dateStr) ?? [];
       
       days.push({
         date,
@@ -152,11 +158,7 @@ export const CalendarView: React.FC = () => {
 
   const getDayTasks = (): Task[] => {
     const dateStr = currentDate.toISOString().split('T')[0];
-    return tasks.filter(task => {
-      if (!task.dueDate) return false;
-      const taskDate = new Date(task.dueDate).toISOString().split('T')[0];
-      return taskDate === dateStr;
-    });
+    return tasksByDay.get(dateStr) ?? [];
   };
 
   const getPriorityColor = (priority: TaskPriority): string => {
@@ -277,9 +279,13 @@ export const CalendarView: React.FC = () => {
               <Typography variant="body2" color="text.secondary" gutterBottom>
                 {day.date.toLocaleDateString('en-US', { month: 'short', day: 'numeric' })}
               </Typography>
-              <Box sx={{ mt: 2 }}>
-                {day.tasks.map(task => (
-                  <Card key={task.id} sx={{ mb: 1, cursor: 'pointer' }} onClick={() => setSelectedTask(task)}>
+              <VirtualList
+                items={day.tasks}
+                getKey={task => task.id}
+                rowHeight={72}
+                sx={{ mt: 2, maxHeight: 'calc(100vh - 360px)' }}
+                renderItem={task => (
+                  <Card sx={{ mb: 1, cursor: 'pointer' }} onClick={() => setSelectedTask(task)}>
                     <CardContent sx={{ p: 1.5, '&:last-child': { pb: 1.5 } }}>
                       <Typography variant="body2" fontWeight="bold">
                         {task.title}
@@ -298,8 +304,8 @@ export const CalendarView: React.FC = () => {
                       </Box>
                     </CardContent>
                   </Card>
-                ))}
-              </Box>
+                )}
+              />
             </Paper>
           </Grid>
         ))}
@@ -322,9 +328,13 @@ export const CalendarView: React.FC = () => {
             No tasks scheduled for this day
           </Typography>
         ) : (
-          <Box sx={{ mt: 2 }}>
-            {dayTasks.map(task => (
-              <Card key={task.id} sx={{ mb: 2, cursor: 'pointer' }} onClick={() => setSelectedTask(task)}>
+          <VirtualList
+            items={dayTasks}
+            getKey={task => task.id}
+            rowHeight={120}
+            sx={{ mt: 2, maxHeight: 'calc(100vh - 320px)' }}
+            renderItem={task => (
+              <Card sx={{ mb: 2, cursor: 'pointer' }} onClick={() => setSelectedTask(task)}>
                 <CardContent>
                   <Typography variant="h6">{task.title}</Typography>
                   {task.description && (
@@ -346,8 +356,8 @@ export const CalendarView: React.FC = () => {
                   </Box>
                 </CardContent>
               </Card>
-            ))}
-          </Box>
+            )}
+          />
         )}
       </Paper>
     );
@@ -1,4 +1,4 @@
-import { useState, useEffect, useMemo } from 'react';
+import { useState, useMemo } from 'react';
 import {
   Box,
   Typography,
@@ -25,8 +25,11 @@ import {
   TaskAlt as TaskAltIcon,
   BarChart as BarChartIcon,
 } from '@mui/icons-material';
-import { Project, Task, TaskStatus, TaskPriority } from '../types';
+import { TaskStatus, TaskPriority } from '../types';
 import { ERROR_MESSAGES } from '../constants/errorMessages';
+import { selectProjects, selectAllTasks } from '../services/entityStore';
+import { loadProjects, loadProjectTasks } from '../services/entityCache';
+import { useEntityLoad, useEntitySelector } from '../hooks/useEntityStore';
 
 interface TaskMetrics {
   total: number;
@@ -54,70 +57,21 @@ interface ProjectMetrics {
 }
 
 export default function Dashboard() {
-  const [projects, setProjects] = useState<Project[]>([]);
-  const [tasks, setTasks] = useState<Task[]>([]);
   const [selectedProject, setSelectedProject] = useState<number>(0);
-  const [loading, setLoading] = useState(true);
-
-  useEffect(() => {
-    let isMounted = true;
-
-    const loadData = async () => {
-      if (isMounted) {
-        setLoading(true);
-      }
-      try {
-        const projectsData = await window.electronAPI.project.findAll();
-        if (!isMounted) return;
-        setProjects(projectsData);
-
-        // Load all tasks in parallel using Promise.all (performance optimization)
-        const taskPromises = projectsData.map(project =>
-          window.electronAPI.task.findByProjectId(project.id)
-        );
-        const taskArrays = await Promise.all(taskPromises);
-        if (!isMounted) return;
-        const allTasks = taskArrays.flat();
-
-        setTasks(allTasks);
-      } catch (err) {
-        if (isMounted) {
-          console.error(ERROR_MESSAGES.LOAD_DASHBOARD_DATA_FAILED, err);
-        }
-      } finally {
-        if (isMounted) {
-          setLoading(false);
-        }
-      }
-    };
-
-    loadData();
-
-    return () => {
-      isMounted = false;
-    };
-  }, []);
 
-  const loadData = async () => {
-    setLoading(true);
+  // Projects and tasks are shared with other views through the cache, so
+  // returning to the dashboard issues no IPC calls
+  const { loading } = useEntityLoad(async () => {
     try {
-      const projectsData = await window.electronAPI.project.findAll();
-      setProjects(projectsData);
-
-      // Load all tasks in parallel using Promise.all (performance optimization)
-      const taskPromises = projectsData.map(project =>
-        window.electronAPI.task.findByProjectId(project.id)
-      );
-      const taskArrays = await Promise.all(taskPromises);
-      const allTasks = taskArrays.flat();
-
-      setTasks(allTasks);
+      const projectsData = await loadProjects();
+      await Promise.all(projectsData.map(project => loadProjectTasks(project.id)));
     } catch (err) {
       console.error(ERROR_MESSAGES.LOAD_DASHBOARD_DATA_FAILED, err);
-    } finally {
-      setLoading(false);
     }
-  };
+  }, []);
+
+  const projects = useEntitySelector(selectProjects, []);
+  const tasks = useEntitySelector(selectAllTasks, []);
 
   // Memoize task metrics calculation to avoid unnecessary recalculations
   const taskMetrics = useMemo<TaskMetrics>(() => {
@@ -23,17 +23,21 @@ import {
   AttachFile as AttachFileIcon,
   Comment as CommentIcon,
 } from '@mui/icons-material';
-import { Task, TaskStatus, TaskPriority, Attachment } from '../types';
+import { Task, TaskStatus, TaskPriority, Attachment, taskRows } from '../types';
 
-interface TaskWithAttachments extends Task {
-  attachments?: Attachment[];
-  commentCount?: number;
+/**
+ * Per-card data loaded alongside the task rows, keyed by task id
+ */
+interface TaskCardExtras {
+  attachments: Attachment[];
+  commentCount: number;
 }
 
 export const GalleryView: React.FC = () => {
   const { id } = useParams<{ id: string }>();
   const projectId = parseInt(id || '0', 10);
-  const [tasks, setTasks] = useState<TaskWithAttachments[]>([]);
+  const [tasks, setTasks] = useState<Task[]>([]);
+  const [extras, setExtras] = useState<Map<number, TaskCardExtras>>(new Map());
   const [anchorEl, setAnchorEl] = useState<null | HTMLElement>(null);
   const [selectedTask, setSelectedTask] = useState<Task | null>(null);
 
@@ -42,25 +46,22 @@ export const GalleryView: React.FC = () => {
 
     const loadTasks = async () => {
       try {
-        const allTasks = await window.electronAPI.task.findByProjectId(projectId);
+        const allTasks = taskRows(await window.electronAPI.task.findByProjectIdColumnar(projectId));
         if (!isMounted) return;
 
         // Load attachments and comment counts for each task
-        const tasksWithExtras = await Promise.all(
-          allTasks.map(async (task) => {
+        const taskExtras = await Promise.all(
+          allTasks.map(async (task): Promise<[number, TaskCardExtras]> => {
             const attachments = await window.electronAPI.attachment.findByTaskId(task.id);
             const comments = await window.electronAPI.comment.findByTaskId(task.id);
 
-            return {
-              ...task,
-              attachments,
-              commentCount: comments.length,
-            };
+            return [task.id, { attachments, commentCount: comments.length }];
           })
         );
 
         if (isMounted) {
-          setTasks(tasksWithExtras);
+          setTasks(allTasks);
+          setExtras(new Map(taskExtras));
         }
       } catch (error) {
         if (isMounted) {
@@ -78,23 +79,20 @@ export const GalleryView: React.FC = () => {
 
   const loadTasks = async () => {
     try {
-      const allTasks = await window.electronAPI.task.findByProjectId(projectId);
+      const allTasks = taskRows(await window.electronAPI.task.findByProjectIdColumnar(projectId));
 
       // Load attachments and comment counts for each task
-      const tasksWithExtras = await Promise.all(
-        allTasks.map(async (task) => {
+      const taskExtras = await Promise.all(
+        allTasks.map(async (task): Promise<[number, TaskCardExtras]> => {
           const attachments = await window.electronAPI.attachment.findByTaskId(task.id);
           const comments = await window.electronAPI.comment.findByTaskId(task.id);
 
-          return {
-            ...task,
-            attachments,
-            commentCount: comments.length,
-          };
+          return [task.id, { attachments, commentCount: comments.length }];
         })
       );
 
-      setTasks(tasksWithExtras);
+      setTasks(allTasks);
+      setExtras(new Map(taskExtras));
     } catch (error) {
       console.error('Failed to load tasks:', error);
     }
@@ -162,11 +160,11 @@ export const GalleryView: React.FC = () => {
     }
   };
 
-  const getCardImage = (task: TaskWithAttachments): string | null => {
-    if (!task.attachments || task.attachments.length === 0) return null;
+  const getCardImage = (cardExtras: TaskCardExtras | undefined): string | null => {
+    if (!cardExtras || cardExtras.attachments.length === 0) return null;
     
     // Find first image attachment
-    const imageAttachment = task.attachments.find(att =>
+    const imageAttachment = cardExtras.attachments.find(att =>
       att.mimeType.startsWith('image/')
     );
     
@@ -191,7 +189,8 @@ export const GalleryView: React.FC = () => {
 
       <Grid container spacing={3}>
         {tasks.map((task) => {
-          const cardImage = getCardImage(task);
+          const cardExtras = extras.get(task.id);
+          const cardImage = getCardImage(cardExtras);
           
           return (
             <Grid item xs={12} sm={6} md={4} lg={3} key={task.id}>
@@ -315,23 +314,23 @@ export const GalleryView: React.FC = () => {
                 
                 <CardActions sx={{ pt: 0, px: 2, pb: 1.5 }}>
                   <Box sx={{ display: 'flex', gap: 2, width: '100%' }}>
-                    {task.attachments && task.attachments.length > 0 && (
-                      <Tooltip title={`${task.attachments.length} attachment(s)`}>
+                    {cardExtras && cardExtras.attachments.length > 0 && (
+                      <Tooltip title={`${cardExtras.attachments.length} attachment(s)`}>
                         <Box sx={{ display: 'flex', alignItems: 'center', gap: 0.5 }}>
                           <AttachFileIcon fontSize="small" color="action" />
                           <Typography variant="caption" color="text.secondary">
-                            {task.attachments.length}
+                            {cardExtras.attachments.length}
                           </Typography>
                         </Box>
                       </Tooltip>
                     )}
                     
-                    {task.commentCount && task.commentCount > 0 && (
-                      <Tooltip title={`${task.commentCount} comment(s)`}>
+                    {cardExtras && cardExtras.commentCount > 0 && (
+                      <Tooltip title={`${cardExtras.commentCount} comment(s)`}>
                         <Box sx={{ display: 'flex', alignItems: 'center', gap: 0.5 }}>
                           <CommentIcon fontSize="small" color="action" />
                           <Typography variant="caption" color="text.secondary">
-                            {task.commentCount}
+                            {cardExtras.commentCount}
                           </Typography>
                         </Box>
                       </Tooltip>
@@ -34,69 +34,33 @@ import {
   TableChart as TableIcon,
   ViewComfy as GalleryIcon,
 } from '@mui/icons-material';
-import { useState, useEffect } from 'react';
-import { ProjectStatus, TaskStatus, TaskPriority, Project, Task } from '../types';
+import { useState } from 'react';
+import { ProjectStatus, TaskStatus, TaskPriority } from '../types';
 import CustomFieldManager from '../components/CustomFieldManager';
 import { ERROR_MESSAGES } from '../constants/errorMessages';
+import { selectProjectTasks } from '../services/entityStore';
+import { loadProject, loadProjectTasks } from '../services/entityCache';
+import { useEntityLoad, useEntitySelector } from '../hooks/useEntityStore';
 
 export default function ProjectDetail() {
   const { id } = useParams();
   const navigate = useNavigate();
   const [activeTab, setActiveTab] = useState(0);
   const [customFieldsOpen, setCustomFieldsOpen] = useState(false);
-  const [project, setProject] = useState<Project | null>(null);
-  const [tasks, setTasks] = useState<Task[]>([]);
-  const [loading, setLoading] = useState(true);
+  const projectId = id ? parseInt(id) : NaN;
 
-  useEffect(() => {
-    let isMounted = true;
-
-    const loadProjectData = async () => {
-      if (!id) return;
-
-      if (isMounted) {
-        setLoading(true);
-      }
-      try {
-        const projectData = await window.electronAPI.project.findById(parseInt(id));
-        const taskData = await window.electronAPI.task.findByProjectId(parseInt(id));
-        if (isMounted) {
-          setProject(projectData || null);
-          setTasks(taskData);
-        }
-      } catch (error) {
-        if (isMounted) {
-          console.error(ERROR_MESSAGES.LOAD_PROJECT_FAILED, error);
-        }
-      } finally {
-        if (isMounted) {
-          setLoading(false);
-        }
-      }
-    };
-
-    loadProjectData();
-
-    return () => {
-      isMounted = false;
-    };
-  }, [id]);
-
-  const loadProjectData = async () => {
+  // Served from the shared cache; later changes are patched in by the change feed
+  const { loading } = useEntityLoad(async () => {
     if (!id) return;
-
-    setLoading(true);
     try {
-      const projectData = await window.electronAPI.project.findById(parseInt(id));
-      const taskData = await window.electronAPI.task.findByProjectId(parseInt(id));
-      setProject(projectData || null);
-      setTasks(taskData);
+      await Promise.all([loadProject(projectId), loadProjectTasks(projectId)]);
     } catch (error) {
       console.error(ERROR_MESSAGES.LOAD_PROJECT_FAILED, error);
-    } finally {
-      setLoading(false);
     }
-  };
+  }, [id]);
+
+  const project = useEntitySelector(state => state.project.get(projectId) ?? null, [projectId]);
+  const tasks = useEntitySelector(state => selectProjectTasks(state, projectId), [projectId]);
 
   if (loading) {
     return (
@@ -29,6 +29,12 @@ import {
   Alert,
   Chip,
   Stack,
+  Table,
+  TableBody,
+  TableCell,
+  TableContainer,
+  TableHead,
+  TableRow,
 } from '@mui/material';
 import {
   Settings as SettingsIcon,
@@ -43,8 +49,9 @@ import {
   Edit as EditIcon,
   Delete as DeleteIcon,
   Add as AddIcon,
+  Speed as DiagnosticsIcon,
 } from '@mui/icons-material';
-import type { AppSettings, KeyboardShortcut } from '../types';
+import type { AppSettings, KeyboardShortcut, DiagnosticsSettings, DiagnosticsSnapshot, MetricSummary } from '../types';
 import { ERROR_MESSAGES } from '../constants/errorMessages';
 
 interface TabPanelProps {
@@ -68,12 +75,63 @@ function TabPanel(props: TabPanelProps) {
   );
 }
 
+const formatMs = (ms: number) => (ms < 10 ? ms.toFixed(2) : ms.toFixed(0));
+
+function MetricTable({ title, rows, showRows }: { title: string; rows: MetricSummary[]; showRows?: boolean }) {
+  return (
+    <Box sx={{ mb: 3 }}>
+      <Typography variant="subtitle1" gutterBottom>
+        {title}
+      </Typography>
+      {rows.length === 0 ? (
+        <Typography variant="body2" color="text.secondary">
+          No samples yet
+        </Typography>
+      ) : (
+        <TableContainer component={Paper} variant="outlined">
+          <Table size="small">
+            <TableHead>
+              <TableRow>
+                <TableCell>Name</TableCell>
+                <TableCell align="right">Count</TableCell>
+                <TableCell align="right">Errors</TableCell>
+                {showRows && <TableCell align="right">Rows</TableCell>}
+                <TableCell align="right">p50 (ms)</TableCell>
+                <TableCell align="right">p95 (ms)</TableCell>
+                <TableCell align="right">Max (ms)</TableCell>
+                <TableCell align="right">Total (ms)</TableCell>
+              </TableRow>
+            </TableHead>
+            <TableBody>
+              {rows.map((row) => (
+                <TableRow key={row.name}>
+                  <TableCell sx={{ fontFamily: 'monospace', maxWidth: 420, overflow: 'hidden', textOverflow: 'ellipsis', whiteSpace: 'nowrap' }} title={row.name}>
+                    {row.name}
+                  </TableCell>
+                  <TableCell align="right">{row.count}</TableCell>
+                  <TableCell align="right">{row.errors}</TableCell>
+                  {showRows && <TableCell align="right">{row.rows ?? 0}</TableCell>}
+                  <TableCell align="right">{formatMs(row.p50Ms)}</TableCell>
+                  <TableCell align="right">{formatMs(row.p95Ms)}</TableCell>
+                  <TableCell align="right">{formatMs(row.maxMs)}</TableCell>
+                  <TableCell align="right">{formatMs(row.totalMs)}</TableCell>
+                </TableRow>
+              ))}
+            </TableBody>
+          </Table>
+        </TableContainer>
+      )}
+    </Box>
+  );
+}
+
 export default function SettingsView() {
   const [tabValue, setTabValue] = useState(0);
   const [settings, setSettings] = useState<AppSettings | null>(null);
   const [editingShortcut, setEditingShortcut] = useState<KeyboardShortcut | null>(null);
   const [shortcutDialogOpen, setShortcutDialogOpen] = useState(false);
   const [snackbar, setSnackbar] = useState({ open: false, message: '', severity: 'success' as 'success' | 'error' | 'info' });
+  const [diagnostics, setDiagnostics] = useState<DiagnosticsSnapshot | null>(null);
 
   // Load settings on mount
   useEffect(() => {
@@ -118,6 +176,58 @@ export default function SettingsView() {
     setTabValue(newValue);
   };
 
+  const loadDiagnostics = async () => {
+    try {
+      setDiagnostics(await window.electronAPI.diagnostics.getSnapshot(20));
+    } catch (error) {
+      console.error('Failed to load diagnostics:', error);
+      showSnackbar('Failed to load diagnostics', 'error');
+    }
+  };
+
+  // Refresh diagnostics while their tab is open
+  useEffect(() => {
+    if (tabValue !== 4) return;
+    loadDiagnostics();
+    const timer = setInterval(loadDiagnostics, 5000);
+    return () => clearInterval(timer);
+  }, [tabValue]);
+
+  const handleDiagnosticsChange = async (field: keyof DiagnosticsSettings, value: boolean | number) => {
+    if (!settings) return;
+    try {
+      const updated = await window.electronAPI.diagnostics.configure({ [field]: value });
+      setSettings({ ...settings, diagnostics: updated });
+      setDiagnostics((prev) => (prev ? { ...prev, settings: updated } : prev));
+    } catch (error) {
+      console.error('Failed to update diagnostics settings:', error);
+      showSnackbar('Failed to update diagnostics settings', 'error');
+    }
+  };
+
+  const handleResetDiagnostics = async () => {
+    try {
+      await window.electronAPI.diagnostics.reset();
+      await loadDiagnostics();
+      showSnackbar('Diagnostics counters reset', 'success');
+    } catch (error) {
+      console.error('Failed to reset diagnostics:', error);
+      showSnackbar('Failed to reset diagnostics', 'error');
+    }
+  };
+
+  const handleExportTrace = async () => {
+    try {
+      const result = await window.electronAPI.diagnostics.exportTrace();
+      if (result) {
+        showSnackbar(`Exported ${result.events} trace events`, 'success');
+      }
+    } catch (error) {
+      console.error('Failed to export trace:', error);
+      showSnackbar('Failed to export trace', 'error');
+    }
+  };
+
   const handleThemeChange = async (field: string, value: any) => {
     if (!settings) return;
     
@@ -294,6 +404,7 @@ export default function SettingsView() {
           <Tab icon={<BusinessIcon />} label="Branding" />
           <Tab icon={<KeyboardIcon />} label="Keyboard Shortcuts" />
           <Tab icon={<WorkspaceIcon />} label="Workspace" />
+          <Tab icon={<DiagnosticsIcon />} label="Diagnostics" />
         </Tabs>
 
         {/* Theme Tab */}
@@ -618,6 +729,79 @@ export default function SettingsView() {
             </Grid>
           </Grid>
         </TabPanel>
+
+        {/* Diagnostics Tab */}
+        <TabPanel value={tabValue} index={4}>
+          <Box sx={{ display: 'flex', justifyContent: 'space-between', alignItems: 'center', mb: 2 }}>
+            <Typography variant="h6">
+              Diagnostics
+            </Typography>
+            <Stack direction="row" spacing={1}>
+              <Button variant="outlined" startIcon={<RefreshIcon />} onClick={loadDiagnostics}>
+                Refresh
+              </Button>
+              <Button variant="outlined" onClick={handleResetDiagnostics}>
+                Reset Counters
+              </Button>
+              <Button variant="outlined" startIcon={<DownloadIcon />} onClick={handleExportTrace}>
+                Export Trace
+              </Button>
+            </Stack>
+          </Box>
+
+          <Grid container spacing={3} sx={{ mb: 3 }}>
+            <Grid item xs={12}>
+              <FormControlLabel
+                control={
+                  <Switch
+                    checked={settings.diagnostics.enabled}
+                    onChange={(e) => handleDiagnosticsChange('enabled', e.target.checked)}
+                  />
+                }
+                label="Collect Metrics"
+              />
+            </Grid>
+
+            <Grid item xs={12} md={6}>
+              <TextField
+                fullWidth
+                label="IPC / API Sample Rate"
+                type="number"
+                value={settings.diagnostics.sampleRate}
+                onChange={(e) => handleDiagnosticsChange('sampleRate', Number(e.target.value))}
+                inputProps={{ min: 0, max: 1, step: 0.05 }}
+                helperText="Fraction of calls timed (0 to 1)"
+              />
+            </Grid>
+
+            <Grid item xs={12} md={6}>
+              <TextField
+                fullWidth
+                label="SQL Sample Rate"
+                type="number"
+                value={settings.diagnostics.sqlSampleRate}
+                onChange={(e) => handleDiagnosticsChange('sqlSampleRate', Number(e.target.value))}
+                inputProps={{ min: 0, max: 1, step: 0.01 }}
+                helperText="Fraction of statement executions timed (0 to 1)"
+              />
+            </Grid>
+          </Grid>
+
+          {diagnostics && (
+            <>
+              <Typography variant="body2" color="text.secondary" sx={{ mb: 2 }}>
+                Since {new Date(diagnostics.since).toLocaleString()} | {diagnostics.traceEvents} trace events buffered
+                {diagnostics.eventLoop && (
+                  <> | Event loop lag p50 {formatMs(diagnostics.eventLoop.p50Ms)} ms,
+                    p99 {formatMs(diagnostics.eventLoop.p99Ms)} ms, max {formatMs(diagnostics.eventLoop.maxMs)} ms</>
+                )}
+              </Typography>
+              <MetricTable title="IPC Channels" rows={diagnostics.ipc} />
+              <MetricTable title="API Routes" rows={diagnostics.http} />
+              <MetricTable title="SQL Statements" rows={diagnostics.sql} showRows />
+            </>
+          )}
+        </TabPanel>
       </Paper>
 
       {/* Action Buttons */}
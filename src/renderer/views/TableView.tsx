@@ -1,4 +1,4 @@
-import React, { useState, useEffect } from 'react';
+import React, { useState, useEffect, useMemo, useCallback, useRef } from 'react';
 import { useParams } from 'react-router-dom';
 import {
   Box,
@@ -27,6 +27,10 @@ import {
   Cancel as CancelIcon,
 } from '@mui/icons-material';
 import { Task, TaskStatus, TaskPriority, CreateTaskData } from '../types';
+import { useVirtualWindow } from '../hooks/useVirtualWindow';
+
+const ROW_HEIGHT = 53;
+const COLUMN_COUNT = 9;
 
 type SortField = 'title' | 'status' | 'priority' | 'assignedTo' | 'dueDate' | 'createdAt';
 type SortOrder = 'asc' | 'desc';
@@ -50,37 +54,56 @@ export const TableView: React.FC = () => {
   const [selectedTasks, setSelectedTasks] = useState<Set<number>>(new Set());
   const [editingTask, setEditingTask] = useState<EditingTask | null>(null);
 
-  useEffect(() => {
-    let isMounted = true;
+  // Id of the only stream whose chunks may reach state
+  const currentStream = useRef<string | null>(null);
 
-    const loadTasks = async () => {
-      try {
-        const allTasks = await window.electronAPI.task.findByProjectId(projectId);
-        if (isMounted) {
-          setTasks(allTasks);
-        }
-      } catch (error) {
-        if (isMounted) {
-          console.error('Failed to load tasks:', error);
-        }
-      }
-    };
+  const cancelCurrentStream = useCallback(() => {
+    if (currentStream.current) {
+      window.electronAPI.task.cancelStream(currentStream.current);
+      currentStream.current = null;
+    }
+  }, []);
 
-    loadTasks();
+  /**
+   * Stream the project's tasks, replacing any stream still running.
+   * Progressive loads render each chunk as it arrives; reloads swap the
+   * list once complete so it does not flash empty.
+   */
+  const streamTasks = useCallback(async (progressive: boolean) => {
+    cancelCurrentStream();
+    const loaded: Task[] = [];
+    if (progressive) setTasks([]);
 
-    return () => {
-      isMounted = false;
-    };
-  }, [projectId]);
+    const stream = window.electronAPI.task.streamByProjectId(projectId, (chunk) => {
+      if (currentStream.current !== chunk.streamId || chunk.tasks.length === 0) return;
+      if (progressive) {
+        setTasks(prev => prev.concat(chunk.tasks));
+      } else {
+        loaded.push(...chunk.tasks);
+      }
+    });
+    currentStream.current = stream.streamId;
 
-  const loadTasks = async () => {
     try {
-      const allTasks = await window.electronAPI.task.findByProjectId(projectId);
-      setTasks(allTasks);
+      await stream.done;
+      if (currentStream.current !== stream.streamId) return;
+      currentStream.current = null;
+      if (!progressive) setTasks(loaded);
     } catch (error) {
-      console.error('Failed to load tasks:', error);
+      if (currentStream.current === stream.streamId) {
+        currentStream.current = null;
+        console.error('Failed to load tasks:', error);
+      }
     }
-  };
+  }, [projectId, cancelCurrentStream]);
+
+  useEffect(() => {
+    // Stream in chunks so large projects render progressively
+    streamTasks(true);
+    return cancelCurrentStream;
+  }, [streamTasks, cancelCurrentStream]);
+
+  const loadTasks = () => streamTasks(false);
 
   const handleSort = (field: SortField) => {
     if (sortField === field) {
@@ -91,7 +114,7 @@ export const TableView: React.FC = () => {
     }
   };
 
-  const getSortedTasks = (): Task[] => {
+  const sortedTasks = useMemo(() => {
     return [...tasks].sort((a, b) => {
       let aVal: any = a[sortField];
       let bVal: any = b[sortField];
@@ -108,7 +131,17 @@ export const TableView: React.FC = () => {
       if (aVal > bVal) return sortOrder === 'asc' ? 1 : -1;
       return 0;
     });
-  };
+  }, [tasks, sortField, sortOrder]);
+
+  // Only rows in (or near) the viewport are mounted
+  const getRowKey = useCallback((index: number) => sortedTasks[index].id, [sortedTasks]);
+  const virtual = useVirtualWindow({
+    count: sortedTasks.length,
+    rowHeight: ROW_HEIGHT,
+    measure: true,
+    getRowKey,
+  });
+  const visibleTasks = sortedTasks.slice(virtual.startIndex, virtual.endIndex);
 
   const handleSelectAll = (checked: boolean) => {
     if (checked) {
@@ -215,8 +248,6 @@ export const TableView: React.FC = () => {
     return new Date(dateStr).toLocaleDateString();
   };
 
-  const sortedTasks = getSortedTasks();
-
   return (
     <Box sx={{ p: 3 }}>
       <Box sx={{ display: 'flex', justifyContent: 'space-between', alignItems: 'center', mb: 3 }}>
@@ -239,8 +270,8 @@ export const TableView: React.FC = () => {
         )}
       </Box>
 
-      <TableContainer component={Paper}>
-        <Table size="small" sx={{ minWidth: 1000 }}>
+      <TableContainer component={Paper} ref={virtual.scrollRef} sx={{ maxHeight: 'calc(100vh - 180px)' }}>
+        <Table size="small" stickyHeader sx={{ minWidth: 1000 }}>
           <TableHead>
             <TableRow>
               <TableCell padding="checkbox">
@@ -309,9 +340,15 @@ export const TableView: React.FC = () => {
             </TableRow>
           </TableHead>
           <TableBody>
-            {sortedTasks.map((task) => (
+            {virtual.paddingTop > 0 && (
+              <TableRow aria-hidden>
+                <TableCell colSpan={COLUMN_COUNT} sx={{ height: virtual.paddingTop, p: 0, border: 0 }} />
+              </TableRow>
+            )}
+            {visibleTasks.map((task, offset) => (
               <TableRow
                 key={task.id}
+                ref={virtual.measureRow(virtual.startIndex + offset)}
                 hover
                 sx={{ '&:last-child td, &:last-child th': { border: 0 } }}
               >
@@ -460,6 +497,11 @@ export const TableView: React.FC = () => {
                 )}
               </TableRow>
             ))}
+            {virtual.paddingBottom > 0 && (
+              <TableRow aria-hidden>
+                <TableCell colSpan={COLUMN_COUNT} sx={{ height: virtual.paddingBottom, p: 0, border: 0 }} />
+              </TableRow>
+            )}
           </TableBody>
         </Table>
       </TableContainer>
@@ -33,18 +33,22 @@ import {
   OpenInNew as OpenIcon,
   Link as LinkIcon,
 } from '@mui/icons-material';
-import { Task, Comment, TaskPriority, Label, Attachment, TaskDependencyWithDetails } from '../types';
+import { TaskPriority, Attachment, TaskDependencyWithDetails } from '../types';
 import LabelManager from '../components/LabelManager';
 import DependencyManager from '../components/DependencyManager';
 import TimeTracker from '../components/TimeTracker';
 import { ERROR_MESSAGES } from '../constants/errorMessages';
+import { selectTaskComments, selectTaskLabels } from '../services/entityStore';
+import { loadTask, loadTaskComments, loadTaskLabels } from '../services/entityCache';
+import { useEntitySelector } from '../hooks/useEntityStore';
 
 export default function TaskDetail() {
   const { id } = useParams<{ id: string }>();
   const navigate = useNavigate();
-  const [task, setTask] = useState<Task | null>(null);
-  const [comments, setComments] = useState<Comment[]>([]);
-  const [labels, setLabels] = useState<Label[]>([]);
+  const taskId = id ? parseInt(id) : NaN;
+  const task = useEntitySelector(state => state.task.get(taskId) ?? null, [taskId]);
+  const comments = useEntitySelector(state => selectTaskComments(state, taskId), [taskId]);
+  const labels = useEntitySelector(state => selectTaskLabels(state, taskId), [taskId]);
   const [attachments, setAttachments] = useState<Attachment[]>([]);
   const [dependencies, setDependencies] = useState<TaskDependencyWithDetails[]>([]);
   const [loading, setLoading] = useState(true);
@@ -59,36 +63,28 @@ export default function TaskDetail() {
   useEffect(() => {
     let isMounted = true;
 
-    const loadTaskAndComments = async () => {
+    // Task, comments and labels come from the shared cache and are kept
+    // current by the change feed; attachments and dependencies are local
+    const loadTaskDetails = async () => {
       if (isMounted) {
         setLoading(true);
         setError(null);
       }
       try {
-        const taskId = parseInt(id!);
-        const taskData = await window.electronAPI.task.findById(taskId);
+        const [taskData, , , attachmentsData, dependenciesData] = await Promise.all([
+          loadTask(taskId),
+          loadTaskComments(taskId),
+          loadTaskLabels(taskId),
+          window.electronAPI.attachment.findByTaskId(taskId),
+          window.electronAPI.dependency.findByTaskIdWithDetails(taskId),
+        ]);
         if (!isMounted) return;
 
         if (!taskData) {
           setError(ERROR_MESSAGES.TASK_NOT_FOUND);
           return;
         }
-        setTask(taskData);
-
-        const commentsData = await window.electronAPI.comment.findByTaskId(taskId);
-        if (!isMounted) return;
-        setComments(commentsData);
-
-        const labelsData = await window.electronAPI.label.findByTaskId(taskId);
-        if (!isMounted) return;
-        setLabels(labelsData);
-
-        const attachmentsData = await window.electronAPI.attachment.findByTaskId(taskId);
-        if (!isMounted) return;
         setAttachments(attachmentsData);
-
-        const dependenciesData = await window.electronAPI.dependency.findByTaskIdWithDetails(taskId);
-        if (!isMounted) return;
         setDependencies(dependenciesData);
       } catch (err) {
         if (isMounted) {
@@ -103,7 +99,7 @@ export default function TaskDetail() {
     };
 
     if (id) {
-      loadTaskAndComments();
+      loadTaskDetails();
     }
 
     return () => {
@@ -111,34 +107,19 @@ export default function TaskDetail() {
     };
   }, [id]);
 
-  const loadTaskAndComments = async () => {
-    setLoading(true);
-    setError(null);
+  const loadAttachments = async () => {
     try {
-      const taskId = parseInt(id!);
-      const taskData = await window.electronAPI.task.findById(taskId);
-      if (!taskData) {
-        setError(ERROR_MESSAGES.TASK_NOT_FOUND);
-        return;
-      }
-      setTask(taskData);
-
-      const commentsData = await window.electronAPI.comment.findByTaskId(taskId);
-      setComments(commentsData);
-
-      const labelsData = await window.electronAPI.label.findByTaskId(taskId);
-      setLabels(labelsData);
-
-      const attachmentsData = await window.electronAPI.attachment.findByTaskId(taskId);
-      setAttachments(attachmentsData);
+      setAttachments(await window.electronAPI.attachment.findByTaskId(taskId));
+    } catch (err) {
+      console.error(ERROR_MESSAGES.LOAD_TASK_FAILED, err);
+    }
+  };
 
-      const dependenciesData = await window.electronAPI.dependency.findByTaskIdWithDetails(taskId);
-      setDependencies(dependenciesData);
+  const loadDependencies = async () => {
+    try {
+      setDependencies(await window.electronAPI.dependency.findByTaskIdWithDetails(taskId));
     } catch (err) {
-      setError(err instanceof Error ? err.message : ERROR_MESSAGES.LOAD_TASK_FAILED);
       console.error(ERROR_MESSAGES.LOAD_TASK_FAILED, err);
-    } finally {
-      setLoading(false);
     }
   };
 
@@ -153,7 +134,6 @@ export default function TaskDetail() {
       });
 
       setNewComment('');
-      loadTaskAndComments();
     } catch (err) {
       console.error(ERROR_MESSAGES.CREATE_COMMENT_FAILED, err);
       setError(ERROR_MESSAGES.CREATE_COMMENT_FAILED);
@@ -170,7 +150,6 @@ export default function TaskDetail() {
 
       setEditingComment(null);
       setEditCommentText('');
-      loadTaskAndComments();
     } catch (err) {
       console.error(ERROR_MESSAGES.UPDATE_COMMENT_FAILED, err);
       setError(ERROR_MESSAGES.UPDATE_COMMENT_FAILED);
@@ -182,7 +161,6 @@ export default function TaskDetail() {
 
     try {
       await window.electronAPI.comment.delete(commentId);
-      loadTaskAndComments();
     } catch (err) {
       console.error(ERROR_MESSAGES.DELETE_COMMENT_FAILED, err);
       setError(ERROR_MESSAGES.DELETE_COMMENT_FAILED);
@@ -196,7 +174,7 @@ export default function TaskDetail() {
     try {
       const uploadedFiles = await window.electronAPI.file.upload(task.id);
       if (uploadedFiles.length > 0) {
-        loadTaskAndComments();
+        loadAttachments();
       }
     } catch (err) {
       console.error(ERROR_MESSAGES.UPLOAD_FILE_FAILED, err);
@@ -220,7 +198,7 @@ export default function TaskDetail() {
     
     try {
       await window.electronAPI.file.deleteWithCleanup(attachmentId);
-      loadTaskAndComments();
+      loadAttachments();
     } catch (err) {
       console.error(ERROR_MESSAGES.DELETE_FILE_FAILED, err);
       setError(ERROR_MESSAGES.DELETE_FILE_FAILED);
@@ -611,7 +589,6 @@ export default function TaskDetail() {
           projectId={task.projectId}
           taskId={task.id}
           taskLabels={labels}
-          onLabelsChange={loadTaskAndComments}
         />
       )}
 
@@ -621,7 +598,7 @@ export default function TaskDetail() {
           open={dependencyManagerOpen}
           onClose={() => {
             setDependencyManagerOpen(false);
-            loadTaskAndComments();
+            loadDependencies();
           }}
           taskId={task.id}
           projectId={task.projectId}
@@ -1,4 +1,4 @@
-import { useState, useEffect } from 'react';
+import { useState, useEffect, useMemo, useCallback } from 'react';
 import { useNavigate } from 'react-router-dom';
 import {
   Box,
@@ -42,9 +42,13 @@ import {
   Delete as DeleteIcon,
 } from '@mui/icons-material';
 import { DragDropContext, Droppable, Draggable, DropResult } from 'react-beautiful-dnd';
-import { Task, TaskStatus, TaskPriority, Project, Label, CustomField } from '../types';
+import { Task, TaskStatus, TaskPriority, Project, Label, CustomField, projectRows, taskRows, toTask } from '../types';
 import CustomFieldInput from '../components/CustomFieldInput';
 import { ERROR_MESSAGES } from '../constants/errorMessages';
+import { useVirtualWindow } from '../hooks/useVirtualWindow';
+
+const LIST_ROW_HEIGHT = 73;
+const LIST_COLUMN_COUNT = 5;
 
 export default function Tasks() {
   const navigate = useNavigate();
@@ -83,7 +87,7 @@ export default function Tasks() {
       }
       try {
         // Load projects
-        const projectsData = await window.electronAPI.project.findAll();
+        const projectsData = projectRows(await window.electronAPI.project.findAllColumnar());
         if (!isMounted) return;
         setProjects(projectsData);
 
@@ -92,12 +96,12 @@ export default function Tasks() {
         if (selectedProject === 'all') {
           // Load tasks from all projects
           for (const project of projectsData) {
-            const projectTasks = await window.electronAPI.task.findByProjectId(project.id);
+            const projectTasks = taskRows(await window.electronAPI.task.findByProjectIdColumnar(project.id));
             if (!isMounted) return;
             tasksData = [...tasksData, ...projectTasks];
           }
         } else {
-          tasksData = await window.electronAPI.task.findByProjectId(selectedProject);
+          tasksData = taskRows(await window.electronAPI.task.findByProjectIdColumnar(selectedProject));
           if (!isMounted) return;
         }
         setTasks(tasksData);
@@ -216,7 +220,7 @@ export default function Tasks() {
     setError(null);
     try {
       // Load projects
-      const projectsData = await window.electronAPI.project.findAll();
+      const projectsData = projectRows(await window.electronAPI.project.findAllColumnar());
       setProjects(projectsData);
 
       // Load tasks for selected project or all tasks
@@ -224,11 +228,11 @@ export default function Tasks() {
       if (selectedProject === 'all') {
         // Load tasks from all projects
         for (const project of projectsData) {
-          const projectTasks = await window.electronAPI.task.findByProjectId(project.id);
+          const projectTasks = taskRows(await window.electronAPI.task.findByProjectIdColumnar(project.id));
           tasksData = [...tasksData, ...projectTasks];
         }
       } else {
-        tasksData = await window.electronAPI.task.findByProjectId(selectedProject);
+        tasksData = taskRows(await window.electronAPI.task.findByProjectIdColumnar(selectedProject));
       }
       setTasks(tasksData);
 
@@ -265,23 +269,39 @@ export default function Tasks() {
     if (!result.destination) return;
 
     const { source, destination, draggableId } = result;
-    
-    // If dropped in the same column, do nothing
-    if (source.droppableId === destination.droppableId) return;
+    if (source.droppableId === destination.droppableId && source.index === destination.index) return;
 
-    // Update task status
     const taskId = parseInt(draggableId.replace('task-', ''));
     const newStatus = destination.droppableId as TaskStatus;
 
+    // New order of the whole destination column. Indexes are relative to the
+    // visible (search-filtered) cards, so anchor on the card we dropped before.
+    const visible = getTasksByStatus(newStatus).filter(task => task.id !== taskId);
+    const columnIds = tasks.filter(task => task.status === newStatus && task.id !== taskId).map(task => task.id);
+    const anchor = visible[destination.index];
+    const insertAt = anchor
+      ? columnIds.indexOf(anchor.id)
+      : visible.length > 0 ? columnIds.indexOf(visible[visible.length - 1].id) + 1 : columnIds.length;
+    columnIds.splice(insertAt, 0, taskId);
+
     try {
-      await window.electronAPI.task.update(taskId, { status: newStatus });
-      
-      // Optimistically update local state
-      setTasks(prevTasks =>
-        prevTasks.map(task =>
-          task.id === taskId ? { ...task, status: newStatus } : task
-        )
-      );
+      // One call renumbers the column and moves the task across columns
+      const { diffs } = await window.electronAPI.task.bulkMove(columnIds, { status: newStatus });
+      const changesById = new Map(diffs.map(diff => [diff.id, diff.changes]));
+      const order = new Map(columnIds.map((id, index) => [id, index]));
+
+      setTasks(prevTasks => {
+        const patched = prevTasks.map(task => {
+          const changes = changesById.get(task.id);
+          return changes ? { ...toTask(task), ...changes } : task;
+        });
+        // Refill the column's slots in the new order; other tasks keep their place
+        const column = patched
+          .filter(task => order.has(task.id))
+          .sort((a, b) => order.get(a.id)! - order.get(b.id)!);
+        let next = 0;
+        return patched.map(task => (order.has(task.id) ? column[next++] : task));
+      });
     } catch (err) {
       console.error(ERROR_MESSAGES.UPDATE_TASK_STATUS_FAILED, err);
       setError(ERROR_MESSAGES.UPDATE_TASK_STATUS_FAILED);
@@ -372,7 +392,7 @@ export default function Tasks() {
   };
 
   const openEditDialog = (task: Task) => {
-    setEditingTask({ ...task });
+    setEditingTask(toTask(task));
     setEditDialogOpen(true);
   };
 
@@ -452,6 +472,19 @@ export default function Tasks() {
     }
   };
 
+  // List view mounts only the rows in (or near) the viewport
+  const listTasks = useMemo(
+    () => (viewMode === 'list' ? getFilteredAndSortedTasks() : []),
+    [viewMode, tasks, searchQuery, selectedLabel, taskLabels, sortBy, sortOrder]
+  );
+  const getListRowKey = useCallback((index: number) => listTasks[index].id, [listTasks]);
+  const listWindow = useVirtualWindow({
+    count: listTasks.length,
+    rowHeight: LIST_ROW_HEIGHT,
+    measure: true,
+    getRowKey: getListRowKey,
+  });
+
   const columns = [
     { id: TaskStatus.Todo, title: 'To Do', color: '#6b7280' },
     { id: TaskStatus.InProgress, title: 'In Progress', color: '#3b82f6' },
@@ -718,8 +751,8 @@ export default function Tasks() {
         </DragDropContext>
       ) : (
         /* List View */
-        <TableContainer component={Paper}>
-          <Table>
+        <TableContainer component={Paper} ref={listWindow.scrollRef} sx={{ maxHeight: 'calc(100vh - 300px)' }}>
+          <Table stickyHeader>
             <TableHead>
               <TableRow>
                 <TableCell>
@@ -762,9 +795,15 @@ export default function Tasks() {
               </TableRow>
             </TableHead>
             <TableBody>
-              {getFilteredAndSortedTasks().map((task) => (
+              {listWindow.paddingTop > 0 && (
+                <TableRow aria-hidden>
+                  <TableCell colSpan={LIST_COLUMN_COUNT} sx={{ height: listWindow.paddingTop, p: 0, border: 0 }} />
+                </TableRow>
+              )}
+              {listTasks.slice(listWindow.startIndex, listWindow.endIndex).map((task, offset) => (
                 <TableRow 
                   key={task.id} 
+                  ref={listWindow.measureRow(listWindow.startIndex + offset)}
                   hover 
                   onClick={() => navigate(`/tasks/${task.id}`)}
                   sx={{ cursor: 'pointer' }}
@@ -836,6 +875,11 @@ export default function Tasks() {
                   </TableCell>
                 </TableRow>
               ))}
+              {listWindow.paddingBottom > 0 && (
+                <TableRow aria-hidden>
+                  <TableCell colSpan={LIST_COLUMN_COUNT} sx={{ height: listWindow.paddingBottom, p: 0, border: 0 }} />
+                </TableRow>
+              )}
             </TableBody>
           </Table>
         </TableContainer>
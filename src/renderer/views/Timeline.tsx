@@ -19,13 +19,16 @@ import {
 } from '@mui/material';
 import { format } from 'date-fns';
 import GanttChart from '../components/GanttChart';
-import { Project, Task, TaskDependency } from '../types';
+import { Task, TaskDependency } from '../types';
 import { ERROR_MESSAGES } from '../constants/errorMessages';
+import { selectProjects, selectProjectTasks } from '../services/entityStore';
+import { loadProjects, loadProjectTasks } from '../services/entityCache';
+import { useEntitySelector } from '../hooks/useEntityStore';
+
+const NO_TASKS: Task[] = [];
 
 const Timeline: React.FC = () => {
-  const [projects, setProjects] = useState<Project[]>([]);
   const [selectedProjectId, setSelectedProjectId] = useState<number | null>(null);
-  const [tasks, setTasks] = useState<Task[]>([]);
   const [dependencies, setDependencies] = useState<TaskDependency[]>([]);
   const [loading, setLoading] = useState(true);
   const [error, setError] = useState<string | null>(null);
@@ -36,20 +39,26 @@ const Timeline: React.FC = () => {
   const [newStartDate, setNewStartDate] = useState<string>('');
   const [newDueDate, setNewDueDate] = useState<string>('');
 
+  // Projects and tasks come from the shared cache and stay current through
+  // the change feed; dependencies are loaded per project here
+  const projects = useEntitySelector(selectProjects, []);
+  const tasks = useEntitySelector(
+    state => (selectedProjectId ? selectProjectTasks(state, selectedProjectId) : NO_TASKS),
+    [selectedProjectId]
+  );
+
   // Load projects
   useEffect(() => {
     let isMounted = true;
 
-    const loadProjects = async () => {
+    const loadProjectList = async () => {
       try {
         if (isMounted) {
           setLoading(true);
         }
-        const projectList = await window.electronAPI.project.findAll();
+        const projectList = await loadProjects();
         if (!isMounted) return;
 
-        setProjects(projectList);
-
         // Auto-select first active project
         const activeProject = projectList.find(p => p.status === 'active');
         if (activeProject) {
@@ -71,7 +80,7 @@ const Timeline: React.FC = () => {
       }
     };
 
-    loadProjects();
+    loadProjectList();
 
     return () => {
       isMounted = false;
@@ -87,13 +96,12 @@ const Timeline: React.FC = () => {
         if (isMounted) {
           setLoading(true);
         }
-        const [taskList, depList] = await Promise.all([
-          window.electronAPI.task.findByProjectId(projectId),
+        const [, depList] = await Promise.all([
+          loadProjectTasks(projectId),
           window.electronAPI.dependency.findByProjectId(projectId),
         ]);
         if (!isMounted) return;
 
-        setTasks(taskList);
         setDependencies(depList);
         setError(null);
       } catch (err) {
@@ -111,7 +119,6 @@ const Timeline: React.FC = () => {
     if (selectedProjectId) {
       loadTasksAndDependencies(selectedProjectId);
     } else {
-      setTasks([]);
       setDependencies([]);
     }
 
@@ -120,48 +127,6 @@ const Timeline: React.FC = () => {
     };
   }, [selectedProjectId]);
 
-  const loadProjects = async () => {
-    try {
-      setLoading(true);
-      const projectList = await window.electronAPI.project.findAll();
-      setProjects(projectList);
-
-      // Auto-select first active project
-      const activeProject = projectList.find(p => p.status === 'active');
-      if (activeProject) {
-        setSelectedProjectId(activeProject.id);
-      } else if (projectList.length > 0) {
-        setSelectedProjectId(projectList[0].id);
-      }
-
-      setError(null);
-    } catch (err) {
-      console.error(ERROR_MESSAGES.LOAD_PROJECTS_FAILED, err);
-      setError(ERROR_MESSAGES.LOAD_PROJECTS_FAILED);
-    } finally {
-      setLoading(false);
-    }
-  };
-
-  const loadTasksAndDependencies = async (projectId: number) => {
-    try {
-      setLoading(true);
-      const [taskList, depList] = await Promise.all([
-        window.electronAPI.task.findByProjectId(projectId),
-        window.electronAPI.dependency.findByProjectId(projectId),
-      ]);
-
-      setTasks(taskList);
-      setDependencies(depList);
-      setError(null);
-    } catch (err) {
-      console.error(ERROR_MESSAGES.LOAD_TASKS_AND_DEPENDENCIES_FAILED, err);
-      setError(ERROR_MESSAGES.LOAD_TASKS_AND_DEPENDENCIES_FAILED);
-    } finally {
-      setLoading(false);
-    }
-  };
-
   const handleTaskClick = (task: Task) => {
     setSelectedTask(task);
     setNewStartDate(task.startDate ? format(new Date(task.startDate), 'yyyy-MM-dd') : '');
@@ -175,11 +140,7 @@ const Timeline: React.FC = () => {
         startDate: startDate.toISOString(),
         dueDate: dueDate.toISOString(),
       });
-      
-      // Reload tasks
-      if (selectedProjectId) {
-        await loadTasksAndDependencies(selectedProjectId);
-      }
+      // The updated task arrives through the change feed
     } catch (err) {
       console.error(ERROR_MESSAGES.UPDATE_TASK_FAILED, err);
       setError(ERROR_MESSAGES.UPDATE_TASK_DATES_FAILED);